@@ -0,0 +1,443 @@
+/** @file rgb565_image.h
+*
+* @brief  RGB565 image container read by lcd_image_from_sd(). The file keeps the .BMP header
+*         layout so the firmware can find the data offset the same way for both formats. Only
+*         the signature and the bits per pixel field change. Pixel data is 16-bit RGB565, high
+*         byte first, in the same order as the .BMP pixels and without row padding.
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#ifndef RGB565_IMAGE_H
+#define RGB565_IMAGE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define RGB565_SIGNATURE_0 'R'          //LCD_RGB565_SIGNATURE_0 in lcd_sd_stream.h
+#define RGB565_SIGNATURE_1 '5'          //LCD_RGB565_SIGNATURE_1 in lcd_sd_stream.h
+#define RGB565_BMP_OFFSET_LOCATION 0x0A //Data offset, little endian uint32
+#define RGB565_BMP_WIDTH_LOCATION 0x12
+#define RGB565_BMP_HEIGHT_LOCATION 0x16
+#define RGB565_BMP_BPP_LOCATION 0x1C
+#define RGB565_BMP_COMPRESSION_LOCATION 0x1E
+#define RGB565_BMP_IMAGE_SIZE_LOCATION 0x22
+
+//Compressed container, see LCD_RGB565Q_* in lcd_rgb565q.h for the ops
+#define RGB565Q_SIGNATURE_0 'R'
+#define RGB565Q_SIGNATURE_1 'Q'
+#define RGB565Q_OP_INDEX 0x00
+#define RGB565Q_OP_DIFF 0x40
+#define RGB565Q_OP_LUMA 0x80
+#define RGB565Q_OP_RUN 0xC0
+#define RGB565Q_OP_PIXEL 0xFE
+#define RGB565Q_INDEX_LENGTH 64
+#define RGB565Q_MAX_RUN 62
+#define RGB565Q_WORST_CASE_BYTES(pixels) ((pixels) * 3) //Every pixel a literal
+
+//Interlaced container, see LCD_RGB565I_* in lcd_sd_stream.h for the row order
+#define RGB565I_SIGNATURE_0 'R'
+#define RGB565I_SIGNATURE_1 'I'
+#define RGB565I_PASSES 4
+
+//Delta animation, see LCD_ANIMATION_* in lcd_sd_stream.h for the layout
+#define RGB565A_SIGNATURE_0 'R'
+#define RGB565A_SIGNATURE_1 'A'
+#define RGB565A_PICTURES_LOCATION 0x1E    //The BMP compression field
+#define RGB565A_MAX_PICTURES 30           //LCD_ANIMATION_MAX_PICTURES in struct_lcd_animation.h
+#define RGB565A_RECTANGLE_BYTES 8
+#define RGB565A_MERGE_PIXELS 64           //Unchanged pixels sent rather than starting another rectangle, which
+                                          //costs its header, 11 bytes of window commands and a new bus transfer
+#define RGB565A_TABLE_BYTES(pictures) (((uint32_t)(pictures) + 2) * 4)
+#define RGB565A_WORST_CASE_BYTES(pictures, width, height) \
+   (RGB565A_TABLE_BYTES(pictures) + (((uint32_t)(pictures) + 1) * (2 + ((uint32_t)(width) * (height) * (2 + RGB565A_RECTANGLE_BYTES)))))
+
+/*!
+* @brief Converts one 24-bit .BMP pixel exactly the way lcd_image_from_sd() does on the fly
+* @param[in] blue
+* @param[in] green
+* @param[in] red
+* @return RGB565 pixel
+*/
+static inline uint16_t
+rgb565_from_bgr(uint8_t blue, uint8_t green, uint8_t red)
+{
+   uint8_t byte_high = (uint8_t)((red & 0xF8) | (green >> 5));
+   uint8_t byte_low = (uint8_t)(((green & 0x1C) << 3) | (blue >> 3));
+
+   return((uint16_t)((byte_high << 8) | byte_low));
+}
+
+
+/*!
+* @brief Table slot of a pixel in the compressed container
+* @param[in] pixel_value
+* @return 0 to RGB565Q_INDEX_LENGTH - 1
+*/
+static inline uint8_t
+rgb565q_hash(uint16_t pixel_value)
+{
+   return((uint8_t)((((pixel_value >> 11) * 3) + (((pixel_value >> 5) & 0x3F) * 5) + ((pixel_value & 0x1F) * 7)) % RGB565Q_INDEX_LENGTH));
+}
+
+
+/*!
+* @brief Signed difference of two channel values that wrap at 2^bits
+* @param[in] value
+* @param[in] previous
+* @param[in] bits
+* @return -(2^(bits - 1)) to 2^(bits - 1) - 1
+*/
+static inline int16_t
+rgb565q_wrap_diff(uint16_t value, uint16_t previous, uint8_t bits)
+{
+   uint16_t range = (uint16_t)(1u << bits);
+
+   return((int16_t)((uint16_t)(value - previous + (range / 2)) & (range - 1)) - (int16_t)(range / 2));
+}
+
+
+/*!
+* @brief Compresses RGB565 pixels into the ops lcd_image_from_sd() decodes
+* @param[in] p_pixels Pixels in BMP order
+* @param[in] total_pixels
+* @param[in] p_output Room for RGB565Q_WORST_CASE_BYTES(total_pixels)
+* @return Bytes written
+*/
+static inline uint32_t
+rgb565q_compress(const uint16_t *p_pixels, uint32_t total_pixels, uint8_t *p_output)
+{
+   uint16_t index[RGB565Q_INDEX_LENGTH] = {0};
+   uint16_t previous = 0;
+   uint32_t output_bytes = 0;
+   uint8_t run = 0;
+
+   for(uint32_t current_pixel = 0; current_pixel < total_pixels; current_pixel++)
+   {
+      uint16_t pixel_value = p_pixels[current_pixel];
+
+      if(pixel_value == previous)
+      {
+         run++;
+
+         if((RGB565Q_MAX_RUN == run) || ((total_pixels - 1) == current_pixel))
+         {
+            p_output[output_bytes++] = (uint8_t)(RGB565Q_OP_RUN | (run - 1));
+            run = 0;
+         }
+
+         continue;
+      }
+
+      if(0 != run)
+      {
+         p_output[output_bytes++] = (uint8_t)(RGB565Q_OP_RUN | (run - 1));
+         run = 0;
+      }
+
+      uint8_t slot = rgb565q_hash(pixel_value);
+      int16_t red_diff = rgb565q_wrap_diff(pixel_value >> 11, previous >> 11, 5);
+      int16_t green_diff = rgb565q_wrap_diff((pixel_value >> 5) & 0x3F, (previous >> 5) & 0x3F, 6);
+      int16_t blue_diff = rgb565q_wrap_diff(pixel_value & 0x1F, previous & 0x1F, 5);
+      int16_t green_half = (int16_t)(((green_diff + 32) / 2) - 16);
+
+      if(pixel_value == index[slot])
+      {
+         p_output[output_bytes++] = (uint8_t)(RGB565Q_OP_INDEX | slot);
+      }
+
+      else if((-2 <= red_diff) && (1 >= red_diff) && (-2 <= green_diff) && (1 >= green_diff) &&
+              (-2 <= blue_diff) && (1 >= blue_diff))
+      {
+         p_output[output_bytes++] = (uint8_t)(RGB565Q_OP_DIFF | ((red_diff + 2) << 4) | ((green_diff + 2) << 2) | (blue_diff + 2));
+      }
+
+      else if((-8 <= (red_diff - green_half)) && (7 >= (red_diff - green_half)) &&
+              (-8 <= (blue_diff - green_half)) && (7 >= (blue_diff - green_half)))
+      {
+         p_output[output_bytes++] = (uint8_t)(RGB565Q_OP_LUMA | (green_diff + 32));
+         p_output[output_bytes++] = (uint8_t)(((red_diff - green_half + 8) << 4) | (blue_diff - green_half + 8));
+      }
+
+      else
+      {
+         p_output[output_bytes++] = RGB565Q_OP_PIXEL;
+         p_output[output_bytes++] = (uint8_t)(pixel_value >> 8);
+         p_output[output_bytes++] = (uint8_t)pixel_value;
+      }
+
+      index[slot] = pixel_value;
+      previous = pixel_value;
+   }
+
+   return(output_bytes);
+}
+
+
+/*!
+* @brief Writes RGB565 pixels with their rows in the order of the interlaced container
+* @param[in] p_pixels Pixels in BMP order
+* @param[in] width
+* @param[in] height
+* @param[in] p_output Room for width * height * 2 bytes
+* @return Bytes written
+*/
+static inline uint32_t
+rgb565i_interlace(const uint16_t *p_pixels, uint32_t width, uint32_t height, uint8_t *p_output)
+{
+   static const uint8_t first_row[RGB565I_PASSES] = {0, 4, 2, 1};
+   static const uint8_t row_step[RGB565I_PASSES] = {8, 8, 4, 2};
+   uint32_t output_bytes = 0;
+
+   for(uint8_t pass = 0; pass < RGB565I_PASSES; pass++)
+   {
+      for(uint32_t row = first_row[pass]; row < height; row += row_step[pass])
+      {
+         for(uint32_t column = 0; column < width; column++)
+         {
+            uint16_t pixel_value = p_pixels[(row * width) + column];
+
+            p_output[output_bytes++] = (uint8_t)(pixel_value >> 8);
+            p_output[output_bytes++] = (uint8_t)pixel_value;
+         }
+      }
+   }
+
+   return(output_bytes);
+}
+
+
+
+static inline void
+rgb565a_write_u16(uint8_t *p_output, uint16_t value)
+{
+   p_output[0] = (uint8_t)value;
+   p_output[1] = (uint8_t)(value >> 8);
+}
+
+
+/*!
+* @brief Finds the changed pixels of one row between two pictures
+* @param[in] p_previous NULL when everything counts as changed
+* @param[in] p_current
+* @param[in] width
+* @param[in] row
+* @param[out] p_first First changed column
+* @param[out] p_last Last changed column
+* @return 1 if anything in the row changed
+*/
+static inline uint8_t
+rgb565a_row_changes(const uint16_t *p_previous, const uint16_t *p_current, uint16_t width, uint16_t row,
+                    uint16_t *p_first, uint16_t *p_last)
+{
+   uint8_t is_changed = 0;
+
+   for(uint16_t column = 0; column < width; column++)
+   {
+      uint32_t pixel = ((uint32_t)row * width) + column;
+
+      if((NULL == p_previous) || (p_previous[pixel] != p_current[pixel]))
+      {
+         if(!is_changed)
+         {
+            *p_first = column;
+         }
+
+         *p_last = column;
+         is_changed = 1;
+      }
+   }
+
+   return(is_changed);
+}
+
+
+/*!
+* @brief Checks one column of a band of rows for changed pixels
+*/
+static inline uint8_t
+rgb565a_column_changed(const uint16_t *p_previous, const uint16_t *p_current, uint16_t width, uint16_t column,
+                       uint16_t row_initial, uint16_t row_final)
+{
+   for(uint16_t row = row_initial; row < row_final; row++)
+   {
+      uint32_t pixel = ((uint32_t)row * width) + column;
+
+      if((NULL == p_previous) || (p_previous[pixel] != p_current[pixel]))
+      {
+         return(1);
+      }
+   }
+
+   return(0);
+}
+
+
+/*!
+* @brief Codes the rectangles that turn one picture into the next
+* @param[in] p_previous Picture on the screen before, NULL to code p_current whole
+* @param[in] p_current
+* @param[in] width
+* @param[in] height
+* @param[in] p_output Room for 2 + (width * height * (2 + RGB565A_RECTANGLE_BYTES)) bytes
+* @return Bytes written
+*
+* @note Rows with changes are grouped into bands, and each band is split into runs of columns
+*       with changes. Gaps of up to RGB565A_MERGE_PIXELS unchanged pixels are sent along
+*       instead of splitting a band or a run.
+*/
+static inline uint32_t
+rgb565a_encode_entry(const uint16_t *p_previous, const uint16_t *p_current, uint16_t width, uint16_t height,
+                     uint8_t *p_output)
+{
+   uint32_t output_bytes = 2;
+   uint16_t rectangles = 0;
+   uint16_t row = 0;
+
+   while(row < height)
+   {
+      uint16_t first = 0;
+      uint16_t last = 0;
+
+      if(!rgb565a_row_changes(p_previous, p_current, width, row, &first, &last))
+      {
+         row++;
+         continue;
+      }
+
+      uint16_t band_top = row;
+      uint16_t band_bottom = row + 1;
+      uint16_t band_first = first;
+      uint16_t band_last = last;
+
+      //Grow the band while the unchanged rows in between are cheaper to send than a new band
+      for(row++; row < height; row++)
+      {
+         if(rgb565a_row_changes(p_previous, p_current, width, row, &first, &last))
+         {
+            band_bottom = row + 1;
+            band_first = (first < band_first) ? first : band_first;
+            band_last = (last > band_last) ? last : band_last;
+         }
+
+         else if(((uint32_t)(row + 1 - band_bottom) * (band_last - band_first + 1)) > RGB565A_MERGE_PIXELS)
+         {
+            break;
+         }
+      }
+
+      row = band_bottom;
+
+      uint16_t band_height = band_bottom - band_top;
+      uint16_t column = band_first;
+
+      while(column <= band_last)
+      {
+         if(!rgb565a_column_changed(p_previous, p_current, width, column, band_top, band_bottom))
+         {
+            column++;
+            continue;
+         }
+
+         uint16_t run_start = column;
+         uint16_t run_end = column + 1;
+
+         for(column++; column <= band_last; column++)
+         {
+            if(rgb565a_column_changed(p_previous, p_current, width, column, band_top, band_bottom))
+            {
+               run_end = column + 1;
+            }
+
+            else if(((uint32_t)(column + 1 - run_end) * band_height) > RGB565A_MERGE_PIXELS)
+            {
+               break;
+            }
+         }
+
+         column = run_end;
+
+         rgb565a_write_u16(&p_output[output_bytes], run_start);
+         rgb565a_write_u16(&p_output[output_bytes + 2], band_top);
+         rgb565a_write_u16(&p_output[output_bytes + 4], (uint16_t)(run_end - run_start));
+         rgb565a_write_u16(&p_output[output_bytes + 6], band_height);
+         output_bytes += RGB565A_RECTANGLE_BYTES;
+         rectangles++;
+
+         for(uint16_t band_row = band_top; band_row < band_bottom; band_row++)
+         {
+            for(uint16_t run_column = run_start; run_column < run_end; run_column++)
+            {
+               uint16_t pixel_value = p_current[((uint32_t)band_row * width) + run_column];
+
+               p_output[output_bytes++] = (uint8_t)(pixel_value >> 8);
+               p_output[output_bytes++] = (uint8_t)pixel_value;
+            }
+         }
+      }
+   }
+
+   rgb565a_write_u16(p_output, rectangles);
+
+   return(output_bytes);
+}
+
+
+/*!
+* @brief Codes a looping animation as its first picture and the changes between pictures
+* @param[in] p_pictures Each width * height RGB565 pixels in the order they are drawn
+* @param[in] pictures 1 to RGB565A_MAX_PICTURES
+* @param[in] width
+* @param[in] height
+* @param[in] data_offset File offset of p_output, the entry table holds file offsets
+* @param[in] p_output Room for RGB565A_WORST_CASE_BYTES(pictures, width, height)
+* @return Bytes written, entry table included
+*/
+static inline uint32_t
+rgb565a_encode(const uint16_t *const *p_pictures, uint8_t pictures, uint16_t width, uint16_t height,
+               uint32_t data_offset, uint8_t *p_output)
+{
+   uint32_t output_bytes = RGB565A_TABLE_BYTES(pictures);
+
+   //Entry 0 is the first picture whole, the last one leads back to it
+   for(uint8_t current_entry = 0; current_entry <= pictures; current_entry++)
+   {
+      const uint16_t *p_previous = (0 == current_entry) ? NULL : p_pictures[current_entry - 1];
+      const uint16_t *p_current = p_pictures[(current_entry < pictures) ? current_entry : 0];
+      uint32_t entry_offset = data_offset + output_bytes;
+
+      rgb565a_write_u16(&p_output[current_entry * 4], (uint16_t)entry_offset);
+      rgb565a_write_u16(&p_output[(current_entry * 4) + 2], (uint16_t)(entry_offset >> 16));
+      output_bytes += rgb565a_encode_entry(p_previous, p_current, width, height, &p_output[output_bytes]);
+   }
+
+   uint32_t end_offset = data_offset + output_bytes;
+   rgb565a_write_u16(&p_output[(pictures + 1) * 4], (uint16_t)end_offset);
+   rgb565a_write_u16(&p_output[((pictures + 1) * 4) + 2], (uint16_t)(end_offset >> 16));
+
+   return(output_bytes);
+}
+
+#endif /* RGB565_IMAGE_H */
+
+/*** end of file ***/
@@ -0,0 +1,228 @@
+/** @file sim.h
+*
+* @brief  Interface of the host-side peripheral simulator. The simulator owns a single cycle
+*         counter for the 100MHz core, charges every register access to the bus it lives on,
+*         advances peripheral models through an event queue and dispatches their interrupts
+*         into the firmware's own IRQ handlers.
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include "stm32f410rx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+****************************************************
+************** Timing Model Constants **************
+****************************************************
+*/
+#define SIM_CPU_HZ 100000000ull          //SYSCLK = HCLK after system_clock_init()
+#define SIM_CYCLES_PER_US (SIM_CPU_HZ / 1000000ull)
+#define SIM_CYCLES_PER_MS (SIM_CPU_HZ / 1000ull)
+
+#define SIM_BUS_CORE_CYCLES 1            //SCB, SysTick, NVIC (private peripheral bus)
+#define SIM_BUS_AHB1_CYCLES 2            //GPIO, DMA, RCC, FLASH interface
+#define SIM_BUS_APB1_CYCLES 4            //SPI2, TIM5, DAC, RTC, PWR. PCLK1 = HCLK/2
+#define SIM_BUS_APB2_CYCLES 3            //USART1, ADC1, SYSCFG, EXTI, TIM1, TIM11
+
+#define SIM_LOOP_CYCLES 2                //Compare and branch of one while() iteration
+#define SIM_DELAY_LOOP_CYCLES 8          //One iteration of the empty for() in timers_delay() at -O0
+#define SIM_ISR_ENTRY_CYCLES 12          //Cortex-M4 exception entry (stacking)
+#define SIM_ISR_EXIT_CYCLES 12           //Cortex-M4 exception return (unstacking)
+
+#define SIM_LCD_WIDTH 320
+#define SIM_LCD_HEIGHT 480
+
+/*
+****************************************************
+************* Buses and Statistics *****************
+****************************************************
+*/
+typedef enum e_sim_bus
+{
+   sim_bus_core,
+   sim_bus_ahb1,
+   sim_bus_apb1,
+   sim_bus_apb2,
+   sim_bus_dma,
+   sim_total_buses
+
+} e_sim_bus;
+
+typedef struct t_sim_stats
+{
+   uint64_t bus_reads[sim_total_buses];
+   uint64_t bus_writes[sim_total_buses];
+   uint64_t cycles_bus;                    //Cycles spent on register loads and stores
+   uint64_t cycles_loop;                   //Cycles charged to while() iterations
+   uint64_t cycles_delay;                  //Cycles spent inside timers_delay()/timers_delay_mini()
+   uint64_t cycles_isr;                    //Cycles spent in exception entry/exit and handler bodies
+   uint64_t cycles_cpu;                    //Cycles charged explicitly with sim_cpu_cycles()
+   uint64_t isr_count[SIM_IRQ_COUNT];
+
+   uint64_t lcd_commands;
+   uint64_t lcd_command_count[256];
+   uint64_t lcd_data_bytes;
+   uint64_t lcd_pixels;
+   uint64_t lcd_dropped_bytes;             //Data bytes strobed outside of a memory write
+   uint64_t lcd_read_bytes;
+
+   uint64_t spi_bytes;
+   uint64_t spi_busy_cycles;               //Cycles during which the SPI2 shifter was active
+   uint64_t spi_overruns;
+
+   uint64_t sd_commands;
+   uint64_t sd_command_count[64];
+   uint64_t sd_blocks_read;
+   uint64_t sd_blocks_written;
+
+   uint64_t dma_transfers;
+   uint64_t uart_bytes;
+
+} t_sim_stats;
+
+typedef struct t_sim_device
+{
+   const char *name;
+   void *base;
+   size_t size;
+   e_sim_bus bus;
+   uint32_t (*read)(uint32_t offset, sim_reg *p_reg);          //NULL reads return raw
+   void (*write)(uint32_t offset, sim_reg *p_reg, uint32_t value); //NULL writes store raw
+   uint64_t reads;
+   uint64_t writes;
+
+} t_sim_device;
+
+extern uint64_t sim_now;
+extern t_sim_stats sim_stats;
+
+/*
+****************************************************
+**************** Core Simulator API ****************
+****************************************************
+*/
+void sim_init(void);
+void sim_register_device(const char *name, void *base, size_t size, e_sim_bus bus,
+                         uint32_t (*read)(uint32_t, sim_reg *),
+                         void (*write)(uint32_t, sim_reg *, uint32_t));
+t_sim_device *sim_find_device(const void *address);
+void sim_advance(uint64_t cycles);
+void sim_loop_tick(void);
+void sim_set_time_limit(uint64_t cycles);
+void sim_finish(const char *reason);
+void sim_set_finish_hook(void (*hook)(const char *reason));
+void sim_run_firmware(void (*entry)(void));
+
+/* Busy-wait replacements for timers.c, renamed out of the firmware object by the Makefile */
+void timers_delay(uint32_t delay_time);
+void timers_delay_mini(uint32_t delay_time);
+
+/* Event scheduler. Each model owns one or more fixed slots */
+typedef void (*sim_event_handler)(uint64_t when);
+int  sim_event_register(const char *name, sim_event_handler handler);
+void sim_event_schedule(int slot, uint64_t when);
+void sim_event_cancel(int slot);
+uint8_t sim_event_pending(int slot);
+
+/* Interrupts */
+void sim_irq_raise(int irq_number);
+uint8_t sim_in_isr(void);
+
+/* Memory accesses made by DMA through a 32-bit bus address */
+uint8_t sim_dma_read(uint32_t address, uint32_t size, uint32_t *p_value);
+uint8_t sim_dma_write(uint32_t address, uint32_t size, uint32_t value);
+
+/* Statistics */
+void sim_stats_reset(void);
+void sim_stats_print(FILE *p_out);
+
+/* Function profiler, fed by -finstrument-functions in the firmware objects */
+void sim_profile_enable(uint8_t enable);
+void sim_profile_reset(void);
+void sim_profile_print(FILE *p_out, uint32_t max_entries);
+
+/*
+****************************************************
+*************** Peripheral Model API ***************
+****************************************************
+*/
+void sim_gpio_init(void);
+void sim_gpio_set_input(GPIO_TypeDef *p_port, uint8_t pin, uint8_t level);
+uint32_t sim_gpio_get_odr(GPIO_TypeDef *p_port);
+void sim_gpio_alternate_output(GPIO_TypeDef *p_port, uint8_t pin, uint8_t level);
+
+void sim_lcd_init(void);
+void sim_lcd_strobe(uint8_t rs, uint8_t byte);
+uint16_t sim_lcd_get_pixel(uint16_t x, uint16_t y);
+void sim_lcd_fill(uint16_t color);
+uint8_t sim_lcd_write_ppm(const char *p_path);
+uint64_t sim_lcd_hash(void);
+void sim_lcd_watch_area(uint16_t x_initial, uint16_t y_initial, uint16_t x_final, uint16_t y_final);
+uint64_t sim_lcd_watch_filled(void);
+
+void sim_spi_init(void);
+void sim_sd_init(void);
+uint8_t sim_sd_exchange(uint8_t mosi, uint8_t cs_active);
+
+void sim_card_init(uint8_t first_boot);
+void sim_card_set_rgb565_images(uint8_t enable);
+void sim_card_set_compressed_images(uint8_t enable);
+void sim_card_set_interlaced_images(uint8_t enable);
+void sim_card_set_packed_files(uint8_t enable);
+void sim_card_set_fat32_volume(uint8_t enable);
+void sim_card_set_address_only_table(uint8_t enable);
+void sim_card_set_blank_table(uint8_t enable);
+void sim_card_set_capacity(uint32_t blocks);
+uint8_t sim_card_has_block(uint32_t block);
+void sim_card_read(uint32_t block, uint8_t *p_buffer);
+void sim_card_write(uint32_t block, const uint8_t *p_buffer);
+uint32_t sim_card_asset_address(uint32_t asset);
+const uint8_t *sim_card_asset_identifier(uint32_t asset);
+
+void sim_peripherals_init(void);
+void sim_touch_press(uint16_t x, uint16_t y, uint32_t duration_ms);
+void sim_power_button_press(uint32_t duration_ms);
+void sim_set_headphones(uint8_t inserted);
+void sim_set_usb(uint8_t connected);
+void sim_set_battery_adc(uint16_t value);
+void sim_uart_set_log(FILE *p_log);
+void sim_dma_request(uint8_t controller, uint8_t stream);
+void sim_exti_input_changed(uint8_t port_index, uint8_t pin, uint8_t level);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_H */
+
+/*** end of file ***/
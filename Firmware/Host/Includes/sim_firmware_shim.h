@@ -0,0 +1,89 @@
+/** @file sim_firmware_shim.h
+*
+* @brief  Force-included (-include) at the top of every firmware translation unit in the host
+*         build. Driver sources are compiled as C++ (inside extern "C") so that register accesses
+*         can be routed through sim_reg; this header papers over the few C idioms C++ rejects and
+*         hooks while() so that loops spinning on interrupt flags let simulated time advance.
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#ifndef SIM_FIRMWARE_SHIM_H
+#define SIM_FIRMWARE_SHIM_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <math.h>
+#include "stm32f410rx.h"
+
+#ifdef __cplusplus
+#include <type_traits>
+
+/*
+****************************************************
+*************** C Idioms Under C++ *****************
+****************************************************
+*/
+
+/* The state machines step through enums with ++ and --, which C allows and C++ does not */
+template <typename T, typename = typename std::enable_if<std::is_enum<T>::value>::type>
+inline T &operator++(T &value) { value = (T)((int)value + 1); return(value); }
+
+template <typename T, typename = typename std::enable_if<std::is_enum<T>::value>::type>
+inline T operator++(T &value, int) { T previous = value; value = (T)((int)value + 1); return(previous); }
+
+template <typename T, typename = typename std::enable_if<std::is_enum<T>::value>::type>
+inline T &operator--(T &value) { value = (T)((int)value - 1); return(value); }
+
+template <typename T, typename = typename std::enable_if<std::is_enum<T>::value>::type>
+inline T operator--(T &value, int) { T previous = value; value = (T)((int)value - 1); return(previous); }
+
+/* C11 compile-time checks */
+#define _Static_assert static_assert
+
+extern "C" void sim_loop_tick(void);
+
+#else
+
+void sim_loop_tick(void);
+
+#endif /* __cplusplus */
+
+/*
+****************************************************
+**************** Loop Time Keeping *****************
+****************************************************
+*/
+/*!
+* @brief Every while() condition charges one loop iteration to the simulated clock. Loops that
+*        poll registers already advance time through the bus, but loops that spin on a RAM flag
+*        set by an ISR (dac.c) would otherwise never see the interrupt fire.
+*/
+#define while(condition) while((sim_loop_tick(), (condition)))
+
+#endif /* SIM_FIRMWARE_SHIM_H */
+
+/*** end of file ***/
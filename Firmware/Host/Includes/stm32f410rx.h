@@ -0,0 +1,746 @@
+/** @file stm32f410rx.h
+*
+* @brief  Host stand-in for the CMSIS STM32F410Rx device header. Every peripheral register is
+*         a sim_reg, which forwards each load and store to the simulated peripheral layer, so the
+*         unmodified drivers in Firmware/Source compile for x86 and drive the models in sim_*.cpp.
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @note Register layouts, bit positions and IRQ numbers follow the ST reference manual (RM0401)
+*       so that firmware arithmetic on them behaves exactly as it does on the target. Only the
+*       peripherals and bits this project touches are declared.
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#ifndef STM32F410RX_H
+#define STM32F410RX_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+****************************************************
+************* Simulated Register Type **************
+****************************************************
+*/
+#ifdef __cplusplus
+
+class sim_reg;
+
+extern "C" uint32_t sim_bus_read(sim_reg *p_reg);
+extern "C" void     sim_bus_write(sim_reg *p_reg, uint32_t value);
+
+/*!
+* @brief A single 32-bit memory-mapped register. Loads and stores are routed through the
+*        simulated bus so they cost time, are counted, and trigger peripheral side effects.
+* @note Read-modify-write operators perform one load and one store, the same as LDR/ORR/STR.
+*/
+class sim_reg
+{
+public:
+   uint32_t raw; //Backing storage, only touched by the peripheral models
+
+   operator uint32_t() { return(sim_bus_read(this)); }
+   sim_reg &operator=(uint32_t value) { sim_bus_write(this, value); return(*this); }
+   sim_reg &operator=(sim_reg &other) { sim_bus_write(this, sim_bus_read(&other)); return(*this); }
+   sim_reg &operator|=(uint32_t value) { sim_bus_write(this, sim_bus_read(this) | value); return(*this); }
+   sim_reg &operator&=(uint32_t value) { sim_bus_write(this, sim_bus_read(this) & value); return(*this); }
+   sim_reg &operator^=(uint32_t value) { sim_bus_write(this, sim_bus_read(this) ^ value); return(*this); }
+   sim_reg &operator+=(uint32_t value) { sim_bus_write(this, sim_bus_read(this) + value); return(*this); }
+   sim_reg &operator-=(uint32_t value) { sim_bus_write(this, sim_bus_read(this) - value); return(*this); }
+};
+
+#else
+
+/* Sources that use C-only initializers (states.c and the data tables) are built as plain C.
+   Their few register accesses go straight to the backing store without bus timing. */
+typedef volatile uint32_t sim_reg;
+
+#endif
+
+#define __IO
+#define __I
+#define __O
+
+/*
+****************************************************
+*************** Interrupt Numbers ******************
+****************************************************
+*/
+typedef enum
+{
+   WWDG_IRQn                   = 0,
+   EXTI0_IRQn                  = 6,
+   EXTI1_IRQn                  = 7,
+   EXTI2_IRQn                  = 8,
+   EXTI3_IRQn                  = 9,
+   EXTI4_IRQn                  = 10,
+   DMA1_Stream0_IRQn           = 11,
+   DMA1_Stream1_IRQn           = 12,
+   DMA1_Stream2_IRQn           = 13,
+   DMA1_Stream3_IRQn           = 14,
+   DMA1_Stream4_IRQn           = 15,
+   DMA1_Stream5_IRQn           = 16,
+   DMA1_Stream6_IRQn           = 17,
+   ADC_IRQn                    = 18,
+   TIM1_UP_IRQn                = 25,
+   TIM1_TRG_COM_TIM11_IRQn     = 26,
+   SPI2_IRQn                   = 36,
+   USART1_IRQn                 = 37,
+   DMA1_Stream7_IRQn           = 47,
+   TIM5_IRQn                   = 50,
+   TIM6_DAC_IRQn               = 54,
+   DMA2_Stream0_IRQn           = 56,
+   DMA2_Stream1_IRQn           = 57,
+   DMA2_Stream2_IRQn           = 58,
+   DMA2_Stream3_IRQn           = 59,
+   DMA2_Stream4_IRQn           = 60,
+   DMA2_Stream5_IRQn           = 68,
+   DMA2_Stream6_IRQn           = 69,
+   DMA2_Stream7_IRQn           = 70,
+   SysTick_IRQn                = 71, //-1 on the part. System exceptions get their own slot after the IRQs here
+   SIM_IRQ_COUNT               = 72
+
+} IRQn_Type;
+
+/*
+****************************************************
+************* Peripheral Register Maps *************
+****************************************************
+*/
+typedef struct
+{
+   __IO sim_reg MODER;
+   __IO sim_reg OTYPER;
+   __IO sim_reg OSPEEDR;
+   __IO sim_reg PUPDR;
+   __IO sim_reg IDR;
+   __IO sim_reg ODR;
+   __IO sim_reg BSRR;
+   __IO sim_reg LCKR;
+   __IO sim_reg AFR[2];
+} GPIO_TypeDef;
+
+typedef struct
+{
+   __IO sim_reg CR1;
+   __IO sim_reg CR2;
+   __IO sim_reg SR;
+   __IO sim_reg DR;
+   __IO sim_reg CRCPR;
+   __IO sim_reg RXCRCR;
+   __IO sim_reg TXCRCR;
+   __IO sim_reg I2SCFGR;
+   __IO sim_reg I2SPR;
+} SPI_TypeDef;
+
+typedef struct
+{
+   __IO sim_reg CR;
+   __IO sim_reg NDTR;
+   __IO sim_reg PAR;
+   __IO sim_reg M0AR;
+   __IO sim_reg M1AR;
+   __IO sim_reg FCR;
+} DMA_Stream_TypeDef;
+
+typedef struct
+{
+   __IO sim_reg LISR;
+   __IO sim_reg HISR;
+   __IO sim_reg LIFCR;
+   __IO sim_reg HIFCR;
+} DMA_TypeDef;
+
+typedef struct
+{
+   __IO sim_reg CR;
+   __IO sim_reg SWTRIGR;
+   __IO sim_reg DHR12R1;
+   __IO sim_reg DHR12L1;
+   __IO sim_reg DHR8R1;
+   __IO sim_reg DHR12R2;
+   __IO sim_reg DHR12L2;
+   __IO sim_reg DHR8R2;
+   __IO sim_reg DHR12RD;
+   __IO sim_reg DHR12LD;
+   __IO sim_reg DHR8RD;
+   __IO sim_reg DOR1;
+   __IO sim_reg DOR2;
+   __IO sim_reg SR;
+} DAC_TypeDef;
+
+typedef struct
+{
+   __IO sim_reg SR;
+   __IO sim_reg CR1;
+   __IO sim_reg CR2;
+   __IO sim_reg SMPR1;
+   __IO sim_reg SMPR2;
+   __IO sim_reg JOFR1;
+   __IO sim_reg JOFR2;
+   __IO sim_reg JOFR3;
+   __IO sim_reg JOFR4;
+   __IO sim_reg HTR;
+   __IO sim_reg LTR;
+   __IO sim_reg SQR1;
+   __IO sim_reg SQR2;
+   __IO sim_reg SQR3;
+   __IO sim_reg JSQR;
+   __IO sim_reg JDR1;
+   __IO sim_reg JDR2;
+   __IO sim_reg JDR3;
+   __IO sim_reg JDR4;
+   __IO sim_reg DR;
+} ADC_TypeDef;
+
+typedef struct
+{
+   __IO sim_reg CSR;
+   __IO sim_reg CCR;
+   __IO sim_reg CDR;
+} ADC_Common_TypeDef;
+
+typedef struct
+{
+   __IO sim_reg CR1;
+   __IO sim_reg CR2;
+   __IO sim_reg SMCR;
+   __IO sim_reg DIER;
+   __IO sim_reg SR;
+   __IO sim_reg EGR;
+   __IO sim_reg CCMR1;
+   __IO sim_reg CCMR2;
+   __IO sim_reg CCER;
+   __IO sim_reg CNT;
+   __IO sim_reg PSC;
+   __IO sim_reg ARR;
+   __IO sim_reg RCR;
+   __IO sim_reg CCR1;
+   __IO sim_reg CCR2;
+   __IO sim_reg CCR3;
+   __IO sim_reg CCR4;
+   __IO sim_reg BDTR;
+   __IO sim_reg DCR;
+   __IO sim_reg DMAR;
+   __IO sim_reg OR;
+} TIM_TypeDef;
+
+typedef struct
+{
+   __IO sim_reg TR;
+   __IO sim_reg DR;
+   __IO sim_reg CR;
+   __IO sim_reg ISR;
+   __IO sim_reg PRER;
+   __IO sim_reg WUTR;
+   __IO sim_reg CALIBR;
+   __IO sim_reg ALRMAR;
+   __IO sim_reg ALRMBR;
+   __IO sim_reg WPR;
+   __IO sim_reg SSR;
+   __IO sim_reg SHIFTR;
+   __IO sim_reg TSTR;
+   __IO sim_reg TSDR;
+   __IO sim_reg TSSSR;
+   __IO sim_reg CALR;
+   __IO sim_reg TAFCR;
+   __IO sim_reg ALRMASSR;
+   __IO sim_reg ALRMBSSR;
+   __IO sim_reg RESERVED7;
+   __IO sim_reg BKPR[20];
+} RTC_TypeDef;
+
+typedef struct
+{
+   __IO sim_reg SR;
+   __IO sim_reg DR;
+   __IO sim_reg BRR;
+   __IO sim_reg CR1;
+   __IO sim_reg CR2;
+   __IO sim_reg CR3;
+   __IO sim_reg GTPR;
+} USART_TypeDef;
+
+typedef struct
+{
+   __IO sim_reg IMR;
+   __IO sim_reg EMR;
+   __IO sim_reg RTSR;
+   __IO sim_reg FTSR;
+   __IO sim_reg SWIER;
+   __IO sim_reg PR;
+} EXTI_TypeDef;
+
+typedef struct
+{
+   __IO sim_reg CR;
+   __IO sim_reg PLLCFGR;
+   __IO sim_reg CFGR;
+   __IO sim_reg CIR;
+   __IO sim_reg AHB1RSTR;
+   __IO sim_reg AHB2RSTR;
+   __IO sim_reg AHB3RSTR;
+   sim_reg      RESERVED0;
+   __IO sim_reg APB1RSTR;
+   __IO sim_reg APB2RSTR;
+   sim_reg      RESERVED1[2];
+   __IO sim_reg AHB1ENR;
+   __IO sim_reg AHB2ENR;
+   __IO sim_reg AHB3ENR;
+   sim_reg      RESERVED2;
+   __IO sim_reg APB1ENR;
+   __IO sim_reg APB2ENR;
+   sim_reg      RESERVED3[2];
+   __IO sim_reg AHB1LPENR;
+   __IO sim_reg AHB2LPENR;
+   __IO sim_reg AHB3LPENR;
+   sim_reg      RESERVED4;
+   __IO sim_reg APB1LPENR;
+   __IO sim_reg APB2LPENR;
+   sim_reg      RESERVED5[2];
+   __IO sim_reg BDCR;
+   __IO sim_reg CSR;
+   sim_reg      RESERVED6[2];
+   __IO sim_reg SSCGR;
+   __IO sim_reg PLLI2SCFGR;
+   __IO sim_reg PLLSAICFGR;
+   __IO sim_reg DCKCFGR;
+   __IO sim_reg CKGATENR;
+   __IO sim_reg DCKCFGR2;
+} RCC_TypeDef;
+
+typedef struct
+{
+   __IO sim_reg CR;
+   __IO sim_reg CSR;
+} PWR_TypeDef;
+
+typedef struct
+{
+   __IO sim_reg ACR;
+   __IO sim_reg KEYR;
+   __IO sim_reg OPTKEYR;
+   __IO sim_reg SR;
+   __IO sim_reg CR;
+   __IO sim_reg OPTCR;
+} FLASH_TypeDef;
+
+typedef struct
+{
+   __IO sim_reg MEMRMP;
+   __IO sim_reg PMC;
+   __IO sim_reg EXTICR[4];
+   sim_reg      RESERVED[2];
+   __IO sim_reg CMPCR;
+   __IO sim_reg CFGR;
+} SYSCFG_TypeDef;
+
+typedef struct
+{
+   __I  sim_reg CPUID;
+   __IO sim_reg ICSR;
+   __IO sim_reg VTOR;
+   __IO sim_reg AIRCR;
+   __IO sim_reg SCR;
+   __IO sim_reg CCR;
+   __IO sim_reg SHP[3];
+   __IO sim_reg SHCSR;
+} SCB_Type;
+
+typedef struct
+{
+   __IO sim_reg CTRL;
+   __IO sim_reg LOAD;
+   __IO sim_reg VAL;
+   __I  sim_reg CALIB;
+} SysTick_Type;
+
+/*
+****************************************************
+************* Peripheral Instances *****************
+****************************************************
+*/
+extern GPIO_TypeDef sim_gpioa, sim_gpiob, sim_gpioc, sim_gpioh;
+extern SPI_TypeDef sim_spi1, sim_spi2, sim_spi5;
+extern DMA_TypeDef sim_dma1, sim_dma2;
+extern DMA_Stream_TypeDef sim_dma1_stream[8], sim_dma2_stream[8];
+extern DAC_TypeDef sim_dac;
+extern ADC_TypeDef sim_adc1;
+extern ADC_Common_TypeDef sim_adc_common;
+extern TIM_TypeDef sim_tim1, sim_tim5, sim_tim6, sim_tim9, sim_tim11;
+extern RTC_TypeDef sim_rtc;
+extern USART_TypeDef sim_usart1, sim_usart2, sim_usart6;
+extern EXTI_TypeDef sim_exti;
+extern RCC_TypeDef sim_rcc;
+extern PWR_TypeDef sim_pwr;
+extern FLASH_TypeDef sim_flash;
+extern SYSCFG_TypeDef sim_syscfg;
+extern SCB_Type sim_scb;
+extern SysTick_Type sim_systick;
+
+#define GPIOA (&sim_gpioa)
+#define GPIOB (&sim_gpiob)
+#define GPIOC (&sim_gpioc)
+#define GPIOH (&sim_gpioh)
+#define SPI1 (&sim_spi1)
+#define SPI2 (&sim_spi2)
+#define SPI5 (&sim_spi5)
+#define DMA1 (&sim_dma1)
+#define DMA2 (&sim_dma2)
+#define DMA1_Stream0 (&sim_dma1_stream[0])
+#define DMA1_Stream1 (&sim_dma1_stream[1])
+#define DMA1_Stream2 (&sim_dma1_stream[2])
+#define DMA1_Stream3 (&sim_dma1_stream[3])
+#define DMA1_Stream4 (&sim_dma1_stream[4])
+#define DMA1_Stream5 (&sim_dma1_stream[5])
+#define DMA1_Stream6 (&sim_dma1_stream[6])
+#define DMA1_Stream7 (&sim_dma1_stream[7])
+#define DMA2_Stream0 (&sim_dma2_stream[0])
+#define DMA2_Stream1 (&sim_dma2_stream[1])
+#define DMA2_Stream2 (&sim_dma2_stream[2])
+#define DMA2_Stream3 (&sim_dma2_stream[3])
+#define DMA2_Stream4 (&sim_dma2_stream[4])
+#define DMA2_Stream5 (&sim_dma2_stream[5])
+#define DMA2_Stream6 (&sim_dma2_stream[6])
+#define DMA2_Stream7 (&sim_dma2_stream[7])
+#define DAC1 (&sim_dac)
+#define DAC DAC1
+#define ADC1 (&sim_adc1)
+#define ADC1_COMMON (&sim_adc_common)
+#define ADC (&sim_adc_common)
+#define TIM1 (&sim_tim1)
+#define TIM5 (&sim_tim5)
+#define TIM6 (&sim_tim6)
+#define TIM9 (&sim_tim9)
+#define TIM11 (&sim_tim11)
+#define RTC (&sim_rtc)
+#define USART1 (&sim_usart1)
+#define USART2 (&sim_usart2)
+#define USART6 (&sim_usart6)
+#define EXTI (&sim_exti)
+#define RCC (&sim_rcc)
+#define PWR (&sim_pwr)
+#define FLASH (&sim_flash)
+#define SYSCFG (&sim_syscfg)
+#define SCB (&sim_scb)
+#define SysTick (&sim_systick)
+
+/*
+****************************************************
+********* Core Intrinsics and NVIC Access **********
+****************************************************
+*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void sim_nvic_enable(int irq_number);
+void sim_nvic_disable(int irq_number);
+void sim_nvic_set_priority(int irq_number, uint32_t priority);
+void sim_nvic_clear_pending(int irq_number);
+void sim_nvic_set_pending(int irq_number);
+void sim_cpu_wfi(void);
+void sim_cpu_irq_mask(uint8_t masked);
+void sim_cpu_cycles(uint32_t cycles);
+
+#ifdef __cplusplus
+}
+#endif
+
+static inline void NVIC_EnableIRQ(IRQn_Type irq) { sim_nvic_enable((int)irq); }
+static inline void NVIC_DisableIRQ(IRQn_Type irq) { sim_nvic_disable((int)irq); }
+static inline void NVIC_SetPriority(IRQn_Type irq, uint32_t priority) { sim_nvic_set_priority((int)irq, priority); }
+static inline void NVIC_ClearPendingIRQ(IRQn_Type irq) { sim_nvic_clear_pending((int)irq); }
+static inline void NVIC_SetPendingIRQ(IRQn_Type irq) { sim_nvic_set_pending((int)irq); }
+
+#define __WFI() sim_cpu_wfi()
+#define __NOP() sim_cpu_cycles(1)
+#define __disable_irq() sim_cpu_irq_mask(1)
+#define __enable_irq() sim_cpu_irq_mask(0)
+#define __DSB() sim_cpu_cycles(1)
+#define __ISB() sim_cpu_cycles(1)
+
+/*
+****************************************************
+************** Register Bit Definitions ************
+****************************************************
+*/
+
+//Unsigned int, not unsigned long: unsigned long is 64 bits on the host but 32 on the target,
+//and ~MASK has to fit the 32 bit registers the same way it does there.
+
+/* RCC */
+#define RCC_CR_HSION                (1u << 0)
+#define RCC_CR_HSIRDY               (1u << 1)
+#define RCC_CR_HSEON                (1u << 16)
+#define RCC_CR_HSERDY               (1u << 17)
+#define RCC_CR_PLLON                (1u << 24)
+#define RCC_CR_PLLRDY               (1u << 25)
+#define RCC_PLLCFGR_PLLM_Pos        0
+#define RCC_PLLCFGR_PLLM_Msk        (0x3Fu << RCC_PLLCFGR_PLLM_Pos)
+#define RCC_PLLCFGR_PLLN_Pos        6
+#define RCC_PLLCFGR_PLLN_Msk        (0x1FFu << RCC_PLLCFGR_PLLN_Pos)
+#define RCC_PLLCFGR_PLLP_Pos        16
+#define RCC_PLLCFGR_PLLP_Msk        (0x3u << RCC_PLLCFGR_PLLP_Pos)
+#define RCC_PLLCFGR_PLLSRC_Pos      22
+#define RCC_PLLCFGR_PLLSRC_Msk      (0x1u << RCC_PLLCFGR_PLLSRC_Pos)
+#define RCC_CFGR_SW_Pos             0
+#define RCC_CFGR_SW_Msk             (0x3u << RCC_CFGR_SW_Pos)
+#define RCC_CFGR_SW_PLL             (0x2u)
+#define RCC_CFGR_SWS_Pos            2
+#define RCC_CFGR_SWS_Msk            (0x3u << RCC_CFGR_SWS_Pos)
+#define RCC_CFGR_HPRE_Pos           4
+#define RCC_CFGR_HPRE_Msk           (0xFu << RCC_CFGR_HPRE_Pos)
+#define RCC_CFGR_MCO1EN             (1u << 8)
+#define RCC_CFGR_MCO2EN             (1u << 9)
+#define RCC_CFGR_PPRE1_Pos          10
+#define RCC_CFGR_PPRE1_Msk          (0x7u << RCC_CFGR_PPRE1_Pos)
+#define RCC_CFGR_PPRE1_DIV2         (0x4u << RCC_CFGR_PPRE1_Pos)
+#define RCC_CFGR_PPRE2_Pos          13
+#define RCC_CFGR_PPRE2_Msk          (0x7u << RCC_CFGR_PPRE2_Pos)
+#define RCC_AHB1ENR_GPIOAEN         (1u << 0)
+#define RCC_AHB1ENR_GPIOBEN         (1u << 1)
+#define RCC_AHB1ENR_GPIOCEN         (1u << 2)
+#define RCC_AHB1ENR_GPIOHEN         (1u << 7)
+#define RCC_AHB1ENR_DMA1EN          (1u << 21)
+#define RCC_AHB1ENR_DMA2EN          (1u << 22)
+#define RCC_APB1ENR_TIM5EN          (1u << 3)
+#define RCC_APB1ENR_TIM6EN          (1u << 4)
+#define RCC_APB1ENR_SPI2EN          (1u << 14)
+#define RCC_APB1ENR_PWREN           (1u << 28)
+#define RCC_APB2ENR_TIM1EN          (1u << 0)
+#define RCC_APB2ENR_USART1EN        (1u << 4)
+#define RCC_APB2ENR_ADC1EN          (1u << 8)
+#define RCC_APB2ENR_SPI1EN          (1u << 12)
+#define RCC_APB2ENR_SYSCFGEN        (1u << 14)
+#define RCC_APB2ENR_TIM9EN          (1u << 16)
+#define RCC_APB2ENR_TIM11EN         (1u << 18)
+#define RCC_BDCR_LSEON              (1u << 0)
+#define RCC_BDCR_LSERDY             (1u << 1)
+#define RCC_BDCR_RTCSEL_0           (1u << 8)
+#define RCC_BDCR_RTCSEL_1           (1u << 9)
+#define RCC_BDCR_RTCEN              (1u << 15)
+#define RCC_BDCR_BDRST              (1u << 16)
+
+/* FLASH */
+#define FLASH_ACR_LATENCY_Msk       (0xFu)
+#define FLASH_ACR_LATENCY_3WS       (0x3u)
+#define FLASH_ACR_PRFTEN            (1u << 8)
+#define FLASH_ACR_ICEN              (1u << 9)
+#define FLASH_ACR_DCEN              (1u << 10)
+
+/* PWR */
+#define PWR_CR_PDDS                 (1u << 1)
+#define PWR_CR_CWUF                 (1u << 2)
+#define PWR_CR_DBP                  (1u << 8)
+#define PWR_CSR_WUF                 (1u << 0)
+#define PWR_CSR_EWUP1               (1u << 8)
+
+/* Cortex-M4 core */
+#define SCB_SCR_SLEEPONEXIT_Msk     (1u << 1)
+#define SCB_SCR_SLEEPDEEP_Msk       (1u << 2)
+#define SysTick_CTRL_ENABLE_Msk     (1u << 0)
+#define SysTick_CTRL_TICKINT_Msk    (1u << 1)
+#define SysTick_CTRL_CLKSOURCE_Msk  (1u << 2)
+#define SysTick_CTRL_COUNTFLAG_Msk  (1u << 16)
+
+/* SPI */
+#define SPI_CR1_CPHA                (1u << 0)
+#define SPI_CR1_CPOL                (1u << 1)
+#define SPI_CR1_MSTR                (1u << 2)
+#define SPI_CR1_BR_Pos              3
+#define SPI_CR1_BR_Msk              (0x7u << SPI_CR1_BR_Pos)
+#define SPI_CR1_SPE                 (1u << 6)
+#define SPI_CR1_LSBFIRST            (1u << 7)
+#define SPI_CR1_SSI                 (1u << 8)
+#define SPI_CR1_SSM                 (1u << 9)
+#define SPI_CR1_RXONLY              (1u << 10)
+#define SPI_CR1_DFF                 (1u << 11)
+#define SPI_CR2_RXDMAEN             (1u << 0)
+#define SPI_CR2_TXDMAEN             (1u << 1)
+#define SPI_CR2_FRF                 (1u << 4)
+#define SPI_SR_RXNE                 (1u << 0)
+#define SPI_SR_TXE                  (1u << 1)
+#define SPI_SR_OVR                  (1u << 6)
+#define SPI_SR_BSY                  (1u << 7)
+#define SPI_I2SCFGR_I2SMOD          (1u << 11)
+
+/* TIM */
+#define TIM_CR1_CEN                 (1u << 0)
+#define TIM_CR1_UDIS                (1u << 1)
+#define TIM_CR1_URS                 (1u << 2)
+#define TIM_CR1_OPM                 (1u << 3)
+#define TIM_CR1_ARPE                (1u << 7)
+#define TIM_CR2_MMS_0               (1u << 4)
+#define TIM_CR2_MMS_1               (1u << 5)
+#define TIM_CR2_MMS_2               (1u << 6)
+#define TIM_DIER_UIE                (1u << 0)
+#define TIM_DIER_UDE                (1u << 8)
+#define TIM_DIER_CC1DE              (1u << 9)
+#define TIM_DIER_CC2DE              (1u << 10)
+#define TIM_SR_UIF                  (1u << 0)
+#define TIM_SR_CC1IF                (1u << 1)
+#define TIM_SR_CC2IF                (1u << 2)
+#define TIM_EGR_UG                  (1u << 0)
+#define TIM_CCMR1_OC1PE             (1u << 3)
+#define TIM_CCMR1_OC1M_Pos          4
+#define TIM_CCMR1_OC1M_Msk          (0x7u << TIM_CCMR1_OC1M_Pos)
+#define TIM_CCMR1_OC1M_0            (1u << 4)
+#define TIM_CCMR1_OC1M_1            (1u << 5)
+#define TIM_CCMR1_OC1M_2            (1u << 6)
+#define TIM_CCER_CC1E               (1u << 0)
+#define TIM_BDTR_MOE                (1u << 15)
+
+/* DMA */
+#define DMA_SxCR_EN                 (1u << 0)
+#define DMA_SxCR_DMEIE              (1u << 1)
+#define DMA_SxCR_TEIE               (1u << 2)
+#define DMA_SxCR_HTIE               (1u << 3)
+#define DMA_SxCR_TCIE               (1u << 4)
+#define DMA_SxCR_PFCTRL             (1u << 5)
+#define DMA_SxCR_DIR_Pos            6
+#define DMA_SxCR_DIR_Msk            (0x3u << DMA_SxCR_DIR_Pos)
+#define DMA_SxCR_DIR_0              (1u << 6)
+#define DMA_SxCR_DIR_1              (1u << 7)
+#define DMA_SxCR_CIRC               (1u << 8)
+#define DMA_SxCR_PINC               (1u << 9)
+#define DMA_SxCR_MINC               (1u << 10)
+#define DMA_SxCR_PSIZE_Pos          11
+#define DMA_SxCR_PSIZE_Msk          (0x3u << DMA_SxCR_PSIZE_Pos)
+#define DMA_SxCR_PSIZE_0            (1u << 11)
+#define DMA_SxCR_PSIZE_1            (1u << 12)
+#define DMA_SxCR_MSIZE_Pos          13
+#define DMA_SxCR_MSIZE_Msk          (0x3u << DMA_SxCR_MSIZE_Pos)
+#define DMA_SxCR_MSIZE_0            (1u << 13)
+#define DMA_SxCR_MSIZE_1            (1u << 14)
+#define DMA_SxCR_PL_Pos             16
+#define DMA_SxCR_PL_Msk             (0x3u << DMA_SxCR_PL_Pos)
+#define DMA_SxCR_DBM                (1u << 18)
+#define DMA_SxCR_CT                 (1u << 19)
+#define DMA_SxCR_CHSEL_Pos          25
+#define DMA_SxCR_CHSEL_Msk          (0x7u << DMA_SxCR_CHSEL_Pos)
+#define DMA_LISR_TCIF0              (1u << 5)
+#define DMA_LISR_TCIF1              (1u << 11)
+#define DMA_LISR_TCIF2              (1u << 21)
+#define DMA_LISR_TCIF3              (1u << 27)
+#define DMA_HISR_TCIF4              (1u << 5)
+#define DMA_HISR_TCIF5              (1u << 11)
+#define DMA_HISR_TCIF6              (1u << 21)
+#define DMA_HISR_TCIF7              (1u << 27)
+#define DMA_LIFCR_CTCIF0            (1u << 5)
+#define DMA_LIFCR_CTCIF1            (1u << 11)
+#define DMA_LIFCR_CTCIF2            (1u << 21)
+#define DMA_LIFCR_CTCIF3            (1u << 27)
+#define DMA_HIFCR_CTCIF4            (1u << 5)
+#define DMA_HIFCR_CTCIF5            (1u << 11)
+#define DMA_HIFCR_CTCIF6            (1u << 21)
+#define DMA_HIFCR_CTCIF7            (1u << 27)
+
+/* DAC */
+#define DAC_CR_EN1                  (1u << 0)
+#define DAC_CR_BOFF1                (1u << 1)
+#define DAC_CR_TEN1                 (1u << 2)
+#define DAC_CR_DMAEN1               (1u << 12)
+
+/* ADC */
+#define ADC_SR_EOC_Pos              1
+#define ADC_SR_EOC                  (1u << ADC_SR_EOC_Pos)
+#define ADC_SR_STRT                 (1u << 4)
+#define ADC_SR_OVR                  (1u << 5)
+#define ADC_CR1_SCAN                (1u << 8)
+#define ADC_CR2_ADON                (1u << 0)
+#define ADC_CR2_CONT                (1u << 1)
+#define ADC_CR2_EOCS                (1u << 10)
+#define ADC_CR2_SWSTART             (1u << 30)
+
+/* EXTI and SYSCFG */
+#define EXTI_IMR_IM0                (1u << 0)
+#define EXTI_IMR_IM1                (1u << 1)
+#define EXTI_IMR_IM3                (1u << 3)
+#define EXTI_RTSR_TR0               (1u << 0)
+#define EXTI_RTSR_TR1               (1u << 1)
+#define EXTI_RTSR_TR3               (1u << 3)
+#define EXTI_FTSR_TR0               (1u << 0)
+#define EXTI_FTSR_TR1               (1u << 1)
+#define EXTI_FTSR_TR3               (1u << 3)
+#define EXTI_PR_PR0                 (1u << 0)
+#define EXTI_PR_PR1                 (1u << 1)
+#define EXTI_PR_PR3                 (1u << 3)
+#define SYSCFG_EXTICR1_EXTI0_PA     (0x0u)
+#define SYSCFG_EXTICR1_EXTI1_PA     (0x0u)
+#define SYSCFG_EXTICR1_EXTI3_PA     (0x0u)
+
+/* RTC */
+#define RTC_TR_SU_Pos               0
+#define RTC_TR_SU_Msk               (0xFu << RTC_TR_SU_Pos)
+#define RTC_TR_ST_Pos               4
+#define RTC_TR_ST_Msk               (0x7u << RTC_TR_ST_Pos)
+#define RTC_TR_MNU_Pos              8
+#define RTC_TR_MNU_Msk              (0xFu << RTC_TR_MNU_Pos)
+#define RTC_TR_MNT_Pos              12
+#define RTC_TR_MNT_Msk              (0x7u << RTC_TR_MNT_Pos)
+#define RTC_TR_HU_Pos               16
+#define RTC_TR_HU_Msk               (0xFu << RTC_TR_HU_Pos)
+#define RTC_TR_HT_Pos               20
+#define RTC_TR_HT_Msk               (0x3u << RTC_TR_HT_Pos)
+#define RTC_TR_PM                   (1u << 22)
+#define RTC_CR_FMT                  (1u << 6)
+#define RTC_CR_ALRAE                (1u << 8)
+#define RTC_CR_ALRAIE               (1u << 12)
+#define RTC_ISR_ALRAWF              (1u << 0)
+#define RTC_ISR_INITS               (1u << 4)
+#define RTC_ISR_RSF                 (1u << 5)
+#define RTC_ISR_INITF               (1u << 6)
+#define RTC_ISR_INIT                (1u << 7)
+#define RTC_ISR_ALRAF               (1u << 8)
+#define RTC_PRER_PREDIV_S_Pos       0
+#define RTC_PRER_PREDIV_S_Msk       (0x7FFFu << RTC_PRER_PREDIV_S_Pos)
+#define RTC_PRER_PREDIV_A_Pos       16
+#define RTC_PRER_PREDIV_A_Msk       (0x7Fu << RTC_PRER_PREDIV_A_Pos)
+#define RTC_ALRMAR_SU_Pos           0
+#define RTC_ALRMAR_SU_Msk           (0xFu << RTC_ALRMAR_SU_Pos)
+#define RTC_ALRMAR_ST_Pos           4
+#define RTC_ALRMAR_ST_Msk           (0x7u << RTC_ALRMAR_ST_Pos)
+#define RTC_ALRMAR_MSK1             (1u << 7)
+#define RTC_ALRMAR_MSK2             (1u << 15)
+#define RTC_ALRMAR_MSK3             (1u << 23)
+#define RTC_ALRMAR_MSK4             (1u << 31)
+
+/* USART */
+#define USART_SR_TC                 (1u << 6)
+#define USART_SR_TXE                (1u << 7)
+#define USART_CR1_RE                (1u << 2)
+#define USART_CR1_TE                (1u << 3)
+#define USART_CR1_UE                (1u << 13)
+#define USART_CR2_CLKEN_Msk         (1u << 11)
+#define USART_CR2_STOP_Msk          (0x3u << 12)
+#define USART_CR2_LINEN_Msk         (1u << 14)
+#define USART_CR3_IREN_Msk          (1u << 1)
+#define USART_CR3_HDSEL_Msk         (1u << 3)
+#define USART_CR3_SCEN_Msk          (1u << 5)
+#define USART_CR3_RTSE_Msk          (1u << 8)
+#define USART_CR3_CTSE_Msk          (1u << 9)
+
+#endif /* STM32F410RX_H */
+
+/*** end of file ***/
@@ -0,0 +1,36 @@
+/** @file stm32f4xx.h
+*
+* @brief  Host stand-in for the CMSIS device family header. The firmware includes this
+*         file before stm32f410rx.h, so it simply forwards to the simulated device header.
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#ifndef STM32F4XX_H
+#define STM32F4XX_H
+
+#include "stm32f410rx.h"
+
+#endif /* STM32F4XX_H */
+
+/*** end of file ***/
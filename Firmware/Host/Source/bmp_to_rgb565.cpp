@@ -0,0 +1,395 @@
+/** @file bmp_to_rgb565.cpp
+*
+* @brief  Converts 24-bit .BMP images into the RGB565 container that lcd_image_from_sd()
+*         streams without per-pixel work. The header, including any file identifier stored
+*         before the data offset, is copied unchanged apart from the signature, bits per pixel,
+*         compression and size fields, so sd_search_file_addresses() finds the converted file
+*         exactly like the original. --compress and --interlace write the compressed and
+*         interlaced containers instead (see LCD_RGB565Q_* in lcd_rgb565q.h and LCD_RGB565I_*
+*         in lcd_sd_stream.h). --animation codes a series of frames as a delta animation (see
+*         LCD_ANIMATION_* in lcd_sd_stream.h), which needs an identifier of its own.
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#include "rgb565_image.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#define CONVERT_BMP_HEADER_BYTES 54
+#define CONVERT_ANIMATION_ID_LOCATION 54   //Identifier right after the BMP header, like the card images
+#define CONVERT_ANIMATION_DATA_OFFSET 64
+#define CONVERT_LAYOUT_RAW 0               //Rows in BMP order
+#define CONVERT_LAYOUT_COMPRESSED 1
+#define CONVERT_LAYOUT_INTERLACED 2
+
+/*
+****************************************************
+********** Private Function Prototypes *************
+****************************************************
+*/
+static uint32_t convert_read_u32(const std::vector<uint8_t> &file, uint32_t location);
+static void convert_write_u32(std::vector<uint8_t> &file, uint32_t location, uint32_t value);
+static uint8_t convert_load_bmp(const char *p_input_path, std::vector<uint8_t> &input, std::vector<uint16_t> &pixels,
+                                uint32_t *p_width, uint32_t *p_height);
+static uint8_t convert_save(const char *p_output_path, const std::vector<uint8_t> &output);
+static uint8_t convert_file(const char *p_input_path, const char *p_output_path, uint8_t layout);
+static uint8_t convert_animation(const char *p_identifier, const char *p_output_path, char **p_frame_paths, int frames);
+
+/*
+****************************************************
+********** Public Function Definitions *************
+****************************************************
+*/
+int
+main(int argc, char **argv)
+{
+   if((2 <= argc) && (0 == strcmp(argv[1], "--animation")))
+   {
+      if((5 > argc) || ((argc - 4) > RGB565A_MAX_PICTURES))
+      {
+         fprintf(stderr, "usage: %s --animation IDENTIFIER OUTPUT.r565a FRAME.bmp ...\n"
+                         "       IDENTIFIER is 10 hex digits, up to %d frames\n", argv[0], RGB565A_MAX_PICTURES);
+         return(1);
+      }
+
+      return(convert_animation(argv[2], argv[3], &argv[4], argc - 4) ? 0 : 1);
+   }
+
+   uint8_t layout = CONVERT_LAYOUT_RAW;
+
+   if((4 == argc) && (0 == strcmp(argv[1], "--compress")))
+   {
+      layout = CONVERT_LAYOUT_COMPRESSED;
+   }
+
+   else if((4 == argc) && (0 == strcmp(argv[1], "--interlace")))
+   {
+      layout = CONVERT_LAYOUT_INTERLACED;
+   }
+
+   else if(3 != argc)
+   {
+      fprintf(stderr, "usage: %s [--compress | --interlace] INPUT.bmp OUTPUT.r565\n"
+                      "       %s --animation IDENTIFIER OUTPUT.r565a FRAME.bmp ...\n", argv[0], argv[0]);
+      return(1);
+   }
+
+   return(convert_file(argv[argc - 2], argv[argc - 1], layout) ? 0 : 1);
+}
+
+
+/*
+****************************************************
+********** Private Function Definitions ************
+****************************************************
+*/
+static uint32_t
+convert_read_u32(const std::vector<uint8_t> &file, uint32_t location)
+{
+   return((uint32_t)file[location] | ((uint32_t)file[location + 1] << 8) |
+          ((uint32_t)file[location + 2] << 16) | ((uint32_t)file[location + 3] << 24));
+}
+
+
+static void
+convert_write_u32(std::vector<uint8_t> &file, uint32_t location, uint32_t value)
+{
+   file[location] = (uint8_t)value;
+   file[location + 1] = (uint8_t)(value >> 8);
+   file[location + 2] = (uint8_t)(value >> 16);
+   file[location + 3] = (uint8_t)(value >> 24);
+}
+
+
+/*!
+* @brief Reads a .BMP and converts its pixels
+* @param[in] p_input_path 24-bit uncompressed .BMP
+* @param[out] input The whole file
+* @param[out] pixels RGB565, in file order
+* @param[out] p_width
+* @param[out] p_height
+* @return 1 on success
+*
+* @note .BMP rows are padded to 4 bytes, the firmware streams the window without gaps, so the
+*       padding is dropped. Widths used on the device are multiples of 4 and have none.
+*/
+static uint8_t
+convert_load_bmp(const char *p_input_path, std::vector<uint8_t> &input, std::vector<uint16_t> &pixels,
+                 uint32_t *p_width, uint32_t *p_height)
+{
+   FILE *p_input = fopen(p_input_path, "rb");
+
+   if(NULL == p_input)
+   {
+      fprintf(stderr, "bmp_to_rgb565: cannot open %s\n", p_input_path);
+      return(0);
+   }
+
+   uint8_t chunk[4096];
+   size_t chunk_bytes = 0;
+
+   input.clear();
+
+   while(0 != (chunk_bytes = fread(chunk, 1, sizeof(chunk), p_input)))
+   {
+      input.insert(input.end(), chunk, chunk + chunk_bytes);
+   }
+
+   fclose(p_input);
+
+   if((CONVERT_BMP_HEADER_BYTES > input.size()) || ('B' != input[0]) || ('M' != input[1]))
+   {
+      fprintf(stderr, "bmp_to_rgb565: %s is not a .BMP\n", p_input_path);
+      return(0);
+   }
+
+   uint32_t data_offset = convert_read_u32(input, RGB565_BMP_OFFSET_LOCATION);
+   uint32_t width = convert_read_u32(input, RGB565_BMP_WIDTH_LOCATION);
+   int32_t height = (int32_t)convert_read_u32(input, RGB565_BMP_HEIGHT_LOCATION);
+   uint16_t bits_per_pixel = (uint16_t)(input[RGB565_BMP_BPP_LOCATION] | (input[RGB565_BMP_BPP_LOCATION + 1] << 8));
+   uint32_t compression = convert_read_u32(input, RGB565_BMP_COMPRESSION_LOCATION);
+
+   if(0 > height)
+   {
+      height = -height;
+   }
+
+   uint32_t row_bytes = ((width * 3) + 3) & ~3u;
+
+   if((24 != bits_per_pixel) || (0 != compression) || (255 < data_offset) ||
+      (input.size() < (data_offset + (row_bytes * (uint32_t)height))))
+   {
+      //lcd_skip_bmp_header() only reads the low byte of the data offset
+      fprintf(stderr, "bmp_to_rgb565: %s must be an uncompressed 24-bit .BMP with a header under 256 bytes\n", p_input_path);
+      return(0);
+   }
+
+   pixels.clear();
+
+   for(uint32_t row = 0; row < (uint32_t)height; row++)
+   {
+      const uint8_t *p_row = &input[data_offset + (row * row_bytes)];
+
+      for(uint32_t column = 0; column < width; column++)
+      {
+         pixels.push_back(rgb565_from_bgr(p_row[column * 3], p_row[(column * 3) + 1], p_row[(column * 3) + 2]));
+      }
+   }
+
+   *p_width = width;
+   *p_height = (uint32_t)height;
+   return(1);
+}
+
+
+static uint8_t
+convert_save(const char *p_output_path, const std::vector<uint8_t> &output)
+{
+   FILE *p_output = fopen(p_output_path, "wb");
+
+   if((NULL == p_output) || (output.size() != fwrite(output.data(), 1, output.size(), p_output)))
+   {
+      fprintf(stderr, "bmp_to_rgb565: cannot write %s\n", p_output_path);
+
+      if(NULL != p_output)
+      {
+         fclose(p_output);
+      }
+
+      return(0);
+   }
+
+   fclose(p_output);
+   return(1);
+}
+
+
+/*!
+* @brief Converts one file
+* @param[in] p_input_path 24-bit uncompressed .BMP
+* @param[in] p_output_path
+* @param[in] layout CONVERT_LAYOUT_COMPRESSED or CONVERT_LAYOUT_INTERLACED for those containers,
+*                   see LCD_RGB565Q_* in lcd_rgb565q.h and LCD_RGB565I_* in lcd_sd_stream.h
+* @return 1 on success
+*/
+static uint8_t
+convert_file(const char *p_input_path, const char *p_output_path, uint8_t layout)
+{
+   std::vector<uint8_t> input;
+   std::vector<uint16_t> pixels;
+   uint32_t width = 0;
+   uint32_t height = 0;
+
+   if(!convert_load_bmp(p_input_path, input, pixels, &width, &height))
+   {
+      return(0);
+   }
+
+   uint32_t data_offset = convert_read_u32(input, RGB565_BMP_OFFSET_LOCATION);
+   uint32_t total_pixels = width * height;
+   std::vector<uint8_t> output(input.begin(), input.begin() + data_offset);
+
+   if(CONVERT_LAYOUT_COMPRESSED == layout)
+   {
+      output.resize(data_offset + RGB565Q_WORST_CASE_BYTES(total_pixels));
+      output.resize(data_offset + rgb565q_compress(pixels.data(), total_pixels, &output[data_offset]));
+      output[0] = RGB565Q_SIGNATURE_0;
+      output[1] = RGB565Q_SIGNATURE_1;
+   }
+
+   else if(CONVERT_LAYOUT_INTERLACED == layout)
+   {
+      //The firmware needs the number of rows to find the passes. It is stored positive
+      output.resize(data_offset + (total_pixels * 2));
+      rgb565i_interlace(pixels.data(), width, height, &output[data_offset]);
+      convert_write_u32(output, RGB565_BMP_HEIGHT_LOCATION, height);
+      output[0] = RGB565I_SIGNATURE_0;
+      output[1] = RGB565I_SIGNATURE_1;
+   }
+
+   else
+   {
+      for(uint32_t current_pixel = 0; current_pixel < total_pixels; current_pixel++)
+      {
+         output.push_back((uint8_t)(pixels[current_pixel] >> 8));
+         output.push_back((uint8_t)pixels[current_pixel]);
+      }
+
+      output[0] = RGB565_SIGNATURE_0;
+      output[1] = RGB565_SIGNATURE_1;
+   }
+
+   output[RGB565_BMP_BPP_LOCATION] = 16;
+   output[RGB565_BMP_BPP_LOCATION + 1] = 0;
+   convert_write_u32(output, 2, (uint32_t)output.size());
+   convert_write_u32(output, RGB565_BMP_IMAGE_SIZE_LOCATION, (uint32_t)(output.size() - data_offset));
+
+   if(!convert_save(p_output_path, output))
+   {
+      return(0);
+   }
+
+   fprintf(stdout, "%s: %ux%u, %zu bytes -> %s: %zu bytes\n", p_input_path, width, height, input.size(),
+           p_output_path, output.size());
+   return(1);
+}
+
+
+/*!
+* @brief Codes frames of equal size as a delta animation
+* @param[in] p_identifier 10 hex digits, stored after the header for sd_search_file_addresses()
+* @param[in] p_output_path
+* @param[in] p_frame_paths 24-bit uncompressed .BMPs, in the order they are played
+* @param[in] frames
+* @return 1 on success
+*
+* @note The header is built from the one of the first frame without what was stored in its
+*       gap, an identifier left there would let the search find the animation for that frame
+*/
+static uint8_t
+convert_animation(const char *p_identifier, const char *p_output_path, char **p_frame_paths, int frames)
+{
+   uint8_t identifier[5] = {0};
+   uint8_t is_valid = (10 == strlen(p_identifier));
+
+   for(uint8_t current_byte = 0; is_valid && (current_byte < 5); current_byte++)
+   {
+      char digits[3] = {p_identifier[current_byte * 2], p_identifier[(current_byte * 2) + 1], '\0'};
+      char *p_end = NULL;
+
+      identifier[current_byte] = (uint8_t)strtoul(digits, &p_end, 16);
+      is_valid = ('\0' == *p_end);
+   }
+
+   if(!is_valid)
+   {
+      fprintf(stderr, "bmp_to_rgb565: the identifier must be 10 hex digits\n");
+      return(0);
+   }
+
+   std::vector<uint8_t> first_input;
+   std::vector<std::vector<uint16_t>> pictures(frames);
+   std::vector<const uint16_t *> p_pictures(frames);
+   uint32_t width = 0;
+   uint32_t height = 0;
+
+   for(int current_frame = 0; current_frame < frames; current_frame++)
+   {
+      std::vector<uint8_t> input;
+      uint32_t frame_width = 0;
+      uint32_t frame_height = 0;
+
+      if(!convert_load_bmp(p_frame_paths[current_frame], input, pictures[current_frame], &frame_width, &frame_height))
+      {
+         return(0);
+      }
+
+      if(0 == current_frame)
+      {
+         first_input = input;
+         width = frame_width;
+         height = frame_height;
+      }
+
+      else if((frame_width != width) || (frame_height != height))
+      {
+         fprintf(stderr, "bmp_to_rgb565: %s is not %ux%u like the first frame\n", p_frame_paths[current_frame], width, height);
+         return(0);
+      }
+
+      p_pictures[current_frame] = pictures[current_frame].data();
+   }
+
+   std::vector<uint8_t> output(CONVERT_ANIMATION_DATA_OFFSET + RGB565A_WORST_CASE_BYTES(frames, width, height), 0);
+
+   memcpy(output.data(), first_input.data(), CONVERT_BMP_HEADER_BYTES);
+   memcpy(&output[CONVERT_ANIMATION_ID_LOCATION], identifier, 5);
+
+   uint32_t data_bytes = rgb565a_encode(p_pictures.data(), (uint8_t)frames, (uint16_t)width, (uint16_t)height,
+                                        CONVERT_ANIMATION_DATA_OFFSET, &output[CONVERT_ANIMATION_DATA_OFFSET]);
+   output.resize(CONVERT_ANIMATION_DATA_OFFSET + data_bytes);
+
+   output[0] = RGB565A_SIGNATURE_0;
+   output[1] = RGB565A_SIGNATURE_1;
+   output[RGB565_BMP_BPP_LOCATION] = 16;
+   output[RGB565_BMP_BPP_LOCATION + 1] = 0;
+   convert_write_u32(output, 2, (uint32_t)output.size());
+   convert_write_u32(output, RGB565_BMP_OFFSET_LOCATION, CONVERT_ANIMATION_DATA_OFFSET);
+   convert_write_u32(output, RGB565_BMP_HEIGHT_LOCATION, height);
+   convert_write_u32(output, RGB565A_PICTURES_LOCATION, (uint32_t)frames);
+   convert_write_u32(output, RGB565_BMP_IMAGE_SIZE_LOCATION, data_bytes);
+
+   if(!convert_save(p_output_path, output))
+   {
+      return(0);
+   }
+
+   fprintf(stdout, "%d frames of %ux%u, %u bytes whole -> %s: %zu bytes\n", frames, width, height,
+           (unsigned)(frames * width * height * 2), p_output_path, output.size());
+   return(1);
+}
+
+/* end of file */
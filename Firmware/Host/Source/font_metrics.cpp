@@ -0,0 +1,216 @@
+/** @file font_metrics.cpp
+*
+* @brief  Generates Source/font_metrics.c from the glyph bitmaps in font.c: the ink box of
+*         every glyph and the distance from each character to the next. Run by the Makefile
+*         whenever font.c changes, the output is kept in the tree for the firmware build.
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+
+extern "C"
+{
+#include "font.h"
+}
+
+#define METRICS_CELL_WIDTH 16
+#define METRICS_BACKGROUND_CODE 1 //Pixel code drawn in the background color, see lcd_get_font_color_table()
+#define METRICS_FIRST_CHAR 32
+#define METRICS_TOTAL_GLYPHS 91
+
+/*
+****************************************************
+***** Private Types and Structure Definitions ******
+****************************************************
+*/
+typedef struct t_metrics_spacing
+{
+   char glyph;
+   uint8_t advance;
+
+} t_metrics_spacing;
+
+typedef struct t_metrics_font
+{
+   const char *name;
+   const uint8_t *bitmaps;
+   uint8_t glyph_height;
+   uint8_t advance;                   //The fonts are monospaced
+   const t_metrics_spacing *spacing;  //Narrow punctuation set tighter than the cell
+   uint8_t spacing_length;
+
+} t_metrics_font;
+
+
+/*
+****************************************************
+************* File-Static Variables ****************
+****************************************************
+*/
+static const t_metrics_spacing jet_font_spacing[] =
+{
+   {'\'', 7},
+};
+
+static const t_metrics_spacing jet_font_small_spacing[] =
+{
+   {'\'', 5},
+   {'.', 5},
+   {':', 8},
+};
+
+static const t_metrics_font metrics_fonts[] =
+{
+   {"jet_font_metrics", &jet_font[0][0], 20, 13, jet_font_spacing, sizeof(jet_font_spacing) / sizeof(jet_font_spacing[0])},
+   {"jet_font_small_metrics", &jet_font_small[0][0], 16, 11, jet_font_small_spacing,
+    sizeof(jet_font_small_spacing) / sizeof(jet_font_small_spacing[0])},
+};
+
+
+/*
+****************************************************
+********** Private Function Prototypes *************
+****************************************************
+*/
+static void metrics_print_header(void);
+static void metrics_print_font(const t_metrics_font *p_font);
+
+
+/*
+****************************************************
+********** Public Function Definitions *************
+****************************************************
+*/
+int
+main(void)
+{
+   metrics_print_header();
+
+   for(size_t current_font = 0; current_font < (sizeof(metrics_fonts) / sizeof(metrics_fonts[0])); current_font++)
+   {
+      metrics_print_font(&metrics_fonts[current_font]);
+   }
+
+   fprintf(stdout, "\n/* end of file */\n");
+
+   return(0);
+}
+
+
+
+
+/*
+****************************************************
+********** Private Function Definitions ************
+****************************************************
+*/
+
+/*!
+* @brief Print the file comment and includes of the generated file
+* @param[in] NONE
+* @return NONE
+*/
+static void
+metrics_print_header(void)
+{
+   fprintf(stdout,
+           "/** @file font_metrics.c\n"
+           "*\n"
+           "* @brief  Ink boxes and advances of every glyph in font.c. Generated by Host/build/font_metrics,\n"
+           "*         do not edit. See font.h for the license of the font the data is taken from.\n"
+           "* @author Aaron Vorse\n"
+           "* @date   10/17/2026\n"
+           "* @contact aaron.vorse@embeddedresume.com\n"
+           "*/\n"
+           "\n"
+           "#include \"font.h\"\n");
+}
+
+
+/*!
+* @brief Print one metrics table, one glyph per line
+* @param[in] p_font
+* @return NONE
+*/
+static void
+metrics_print_font(const t_metrics_font *p_font)
+{
+   uint16_t glyph_bytes = p_font->glyph_height * (METRICS_CELL_WIDTH / 4);
+
+   fprintf(stdout, "\n//Advance, ink x initial, ink x final, ink y initial, ink y final\n");
+   fprintf(stdout, "const t_font_glyph_metrics %s[%d] = {\n", p_font->name, METRICS_TOTAL_GLYPHS);
+
+   for(uint8_t current_glyph = 0; current_glyph < METRICS_TOTAL_GLYPHS; current_glyph++)
+   {
+      const uint8_t *p_glyph = p_font->bitmaps + (current_glyph * glyph_bytes);
+      char glyph = (char)(current_glyph + METRICS_FIRST_CHAR);
+      uint8_t advance = p_font->advance;
+      uint8_t x_initial = METRICS_CELL_WIDTH;
+      uint8_t x_final = 0;
+      uint8_t y_initial = p_font->glyph_height;
+      uint8_t y_final = 0;
+
+      for(uint8_t row = 0; row < p_font->glyph_height; row++)
+      {
+         for(uint8_t column = 0; column < METRICS_CELL_WIDTH; column++)
+         {
+            uint8_t code = (p_glyph[(row * (METRICS_CELL_WIDTH / 4)) + (column >> 2)] >> (6 - ((column & 0x03) << 1))) & 0x03;
+
+            if(METRICS_BACKGROUND_CODE == code)
+            {
+               continue;
+            }
+
+            x_initial = (column < x_initial) ? column : x_initial;
+            x_final = (column >= x_final) ? (column + 1) : x_final;
+            y_initial = (row < y_initial) ? row : y_initial;
+            y_final = (row >= y_final) ? (row + 1) : y_final;
+         }
+      }
+
+      //Blank glyph
+      if(0 == x_final)
+      {
+         x_initial = 0;
+         y_initial = 0;
+      }
+
+      for(uint8_t current_spacing = 0; current_spacing < p_font->spacing_length; current_spacing++)
+      {
+         if(glyph == p_font->spacing[current_spacing].glyph)
+         {
+            advance = p_font->spacing[current_spacing].advance;
+         }
+      }
+
+      fprintf(stdout, "   {%2u, %2u, %2u, %2u, %2u}, //'%s%c'\n", advance, x_initial, x_final, y_initial, y_final,
+              (('\\' == glyph) || ('\'' == glyph)) ? "\\" : "", glyph);
+   }
+
+   fprintf(stdout, "};\n");
+}
+
+
+/* end of file */
@@ -0,0 +1,1415 @@
+/** @file host_bench.cpp
+*
+* @brief  Drawing benchmarks for the host build. Initializes the firmware peripherals against
+*         the simulator, then calls individual driver functions in a loop and reports how many
+*         pixels they deliver per second of simulated time and per second of host time.
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#include "sim.h"
+#include "enum_sd_file_list.h"
+#include "struct_buttons.h"
+#include "struct_lcd_animation.h"
+#include "struct_lcd_image_blit.h"
+#include "struct_gui_animation.h"
+#include "struct_sd_block_cache.h"
+#include "struct_font_metrics.h"
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+//Firmware entry points, compiled with C linkage
+extern "C"
+{
+   void system_clock_init(void);
+   void main_peripherals_init(void);
+
+   void lcd_dma_wait(void);
+   void sd_read_block(uint8_t *p_read_buffer, uint32_t block_address);
+   uint8_t microsd_init(void);
+   void sd_get_file_addresses(uint32_t *tmp_file_list);
+   uint32_t sd_get_wav_size(uint8_t tmp_file);
+   uint32_t sd_find_file_address(const uint8_t *file_identifier);
+   void sd_write_block(uint8_t *tmp_write_buffer, uint32_t block_address);
+   uint8_t sd_write_multiple_block(const uint8_t *tmp_write_buffer, uint32_t block_address, uint32_t tmp_blocks, uint8_t tmp_pre_erase);
+   void sd_append_file_addresses(e_sd_address start_address, e_sd_address stop_address);
+   void sd_block_cache_get_stats(t_sd_block_cache_stats *tmp_stats);
+   uint16_t sd_scan_file_addresses(e_sd_address start_address, e_sd_address stop_address);
+   uint8_t states_read_startup_flag(void);
+   void states_write_startup_flag(uint8_t startup_flag_status);
+   void lcd_draw_rectangle(uint16_t color, uint16_t x_in, uint16_t y_in, uint16_t x_fin, uint16_t y_fin);
+   void lcd_print_string(char *tmp_string, uint16_t x, uint16_t y, uint16_t font_color, uint16_t background_color);
+   void lcd_print_string_small(char *tmp_string, uint16_t x, uint16_t y, uint16_t font_color, uint16_t background_color);
+   void lcd_print_string_over(char *tmp_string, uint16_t x, uint16_t y, uint16_t font_color);
+   void lcd_display_list_begin(void);
+   void lcd_display_list_end(void);
+   void lcd_send_bitmap(const uint8_t *tmp_bmp, uint16_t x, uint16_t y, uint16_t main_color, uint16_t background_color);
+   void lcd_image_from_sd(uint16_t x_in ,uint16_t y_in,uint16_t x_fin ,uint16_t y_fin, uint32_t memory_starting_address);
+   void lcd_image_region_from_sd(uint16_t x_in, uint16_t y_in, uint16_t x_fin, uint16_t y_fin,
+                                 uint16_t image_x, uint16_t image_y, uint32_t memory_starting_address);
+   uint8_t lcd_save_under(uint16_t x_in, uint16_t y_in, uint16_t x_fin, uint16_t y_fin, uint16_t tmp_bytes);
+   uint8_t lcd_restore_under(void);
+   void lcd_images_from_sd(const t_lcd_image_blit *tmp_images, uint8_t image_count);
+   uint8_t lcd_animation_open(t_lcd_animation *tmp_animation, uint16_t x, uint16_t y, uint32_t memory_starting_address);
+   uint8_t lcd_animation_draw_next(t_lcd_animation *tmp_animation);
+   void gui_boot_animation(t_gui_animation *tmp_animation, const uint32_t *animation_frames, size_t number_of_frames, uint32_t delta_address);
+   void gui_animation_update(void);
+   uint8_t gui_animation_is_running(const t_gui_animation *tmp_animation);
+   void lcd_load_expansion_table(uint16_t font_color, uint16_t background_color);
+   void lcd_expand_2bpp(const uint8_t *tmp_source, uint16_t source_bytes, uint16_t *tmp_pixels);
+   void lcd_background_squares(void);
+   void lcd_get_font_color_table(uint16_t *tmp_table, uint16_t tmp_font_color, uint16_t tmp_background_color);
+   void lcd_glyph_cache_start_pass(void);
+   const uint16_t *lcd_glyph_cache_get(const uint8_t *tmp_font, uint8_t glyph_height, char tmp_char,
+                                       const t_font_glyph_metrics *tmp_metrics, const uint16_t *tmp_palette);
+   void lcd_raster_glyph_row(uint16_t *tmp_line, const uint8_t *tmp_glyph, const uint16_t *tmp_glyph_pixels,
+                             const t_font_glyph_metrics *tmp_metrics, uint8_t row, uint8_t column_final,
+                             const uint16_t *tmp_palette);
+
+   void gui_create_aboutme_main_menu(uint32_t *tmp_button_images);
+   void gui_create_aboutme_education_menu(void);
+   void gui_create_settings_menu(void);
+   void gui_create_intro_menu(uint8_t tmp_startup_status_flag);
+   void gui_create_menu_skills(const t_light_button *tmp_button_list, size_t length);
+   void gui_scroll_menu_skills(int8_t tmp_rows);
+
+   extern const uint8_t jet_font[91][80];
+   extern const t_font_glyph_metrics jet_font_metrics[91];
+   extern const uint8_t job_icon_bmp[304];
+   extern const uint8_t home_button_bmp[220];
+}
+
+/*
+****************************************************
+************* File-Static Variables ****************
+****************************************************
+*/
+#define BENCH_TEXT_COLOR 0x2945      //THEME_TEXT
+#define BENCH_BACKGROUND_COLOR 0xFFFF //THEME_WHITE
+#define BENCH_SLIDE_TOP 28            //SB_OFFSET
+#define BENCH_SLIDE_BOTTOM 359        //MENU3_UTILITIES_BAR_OFFSET
+#define BENCH_SLIDE_ASSET slide_portfolio_acq_adc
+#define BENCH_HOME_BOTTOM 442         //FOOTER_OFFSET + 1
+#define BENCH_POPUP_TOP 95            //MENU_WARNING_BACKGROUND_OFFSET
+#define BENCH_POPUP_BOTTOM 345        //MENU_WARNING_BACKGROUND_HEIGHT
+#define BENCH_EDUCATION_UNDER_BYTES 6263 //Education menu under the popup area, as lcd_save_under() encodes it
+#define BENCH_SKILLS_LENGTH 14
+#define BENCH_BOOT_X 92               //Boot animation position in gui_boot_animation()
+#define BENCH_BOOT_Y 150
+#define BENCH_BOOT_FRAMES 12          //startup_animation_0 to startup_animation_11
+#define BENCH_ENGINE_BLOCKS 64        //Slide blocks cycled through by boot_engine between frames
+#define BENCH_CAPTION_X 12            //Caption over the bottom of the slide
+#define BENCH_CAPTION_Y 330
+#define BENCH_CAPTION_BOX_TOP 326
+#define BENCH_CAPTION_COLOR 0xFFFF
+#define BENCH_CAPTION_BOX_COLOR 0x2945
+#define BENCH_ICONS 6                 //skills_arm to skills_solder, drawn in a column like the Skills list
+#define BENCH_ICON_X 22               //PROFILE_BAR_ICON_X_OFFSET
+#define BENCH_ICON_Y 92               //MENU_SKILLS_PICTURE_Y_OFFSET
+#define BENCH_ICON_SPACING 48         //MENU_SKILLS_TEXT_SPACING
+#define BENCH_WRITE_BLOCKS 64         //Blocks written by the write_* cases, like a log or table rebuild
+#define BENCH_WRITE_ADDRESS 3000000   //Past every slot, before the cheat sheet
+#define BENCH_SEARCH_FILES 4          //Files after null_address searched for by search_each and search_once
+#define BENCH_FLAG_ADDRESS 4005000    //STATES_ADDRESS_STARTUP_FLAG
+#define BENCH_FLAG_READS 100          //Startup flag reads by flag_card and flag_cached
+
+static t_light_button bench_skills_list[BENCH_SKILLS_LENGTH];
+
+typedef struct t_bench_case
+{
+   const char *name;
+   const char *description;
+   uint8_t simulated;                //Runs on the firmware stack against the simulated bus
+   uint64_t (*run)(void);            //Returns the number of pixels produced
+
+} t_bench_case;
+
+static uint64_t bench_font_medium(void);
+static uint64_t bench_font_small(void);
+static uint64_t bench_bitmap(void);
+static uint64_t bench_slide_bmp(void);
+static uint64_t bench_slide_rgb565(void);
+static uint64_t bench_slide_compressed(void);
+static uint64_t bench_slide_interlaced(void);
+static uint64_t bench_slide_timed(const char *p_name);
+static uint64_t bench_caption_boxed(void);
+static uint64_t bench_caption_over(void);
+static uint64_t bench_popup_close_full(void);
+static uint64_t bench_popup_close_region(void);
+static uint64_t bench_popup_close_compressed(void);
+static uint64_t bench_popup_save_under(void);
+static uint64_t bench_menu_squares(void);
+static uint64_t bench_menu_about_me(void);
+static uint64_t bench_menu_education(void);
+static uint64_t bench_menu_settings(void);
+static uint64_t bench_menu_intro(void);
+static uint64_t bench_menu_skills(void);
+static uint64_t bench_icons_single(void);
+static uint64_t bench_icons_batched(void);
+static uint64_t bench_skills_scroll(void);
+static uint64_t bench_fill_screen(void);
+static uint64_t bench_boot_frames(void);
+static uint64_t bench_boot_delta(void);
+static uint64_t bench_boot_engine(void);
+static uint64_t bench_lookup_table(void);
+static uint64_t bench_lookup_fat32(void);
+static uint64_t bench_lookup_addresses(void);
+static uint64_t bench_lookup(const char *p_name, uint8_t fat32_volume);
+static uint64_t bench_search_each(void);
+static uint64_t bench_write_single(void);
+static uint64_t bench_write_multiple(void);
+static uint64_t bench_write_erased(void);
+static uint64_t bench_write(const char *p_name, uint8_t mode);
+static uint64_t bench_search_once(void);
+static uint64_t bench_search_end(void);
+static uint64_t bench_flag_card(void);
+static uint64_t bench_flag_cached(void);
+static void bench_skills_list_init(void);
+static uint64_t bench_expand_table(void);
+static uint64_t bench_expand_reference(void);
+static uint64_t bench_glyph_cache(void);
+static uint64_t bench_glyph_expand(void);
+
+static const t_bench_case bench_cases[] =
+{
+   {"font_medium",       "lcd_print_string, 24 characters",             1, bench_font_medium},
+   {"font_small",        "lcd_print_string_small, 28 characters",       1, bench_font_small},
+   {"bitmap",            "lcd_send_bitmap, 38x30 and 34x26 icons",      1, bench_bitmap},
+   {"slide_bmp",         "lcd_image_from_sd, 320x331 24-bit BMP slide", 1, bench_slide_bmp},
+   {"slide_rgb565",      "lcd_image_from_sd, 320x331 RGB565 slide",     1, bench_slide_rgb565},
+   {"slide_compressed",  "lcd_image_from_sd, 320x331 compressed slide", 1, bench_slide_compressed},
+   {"slide_interlaced",  "lcd_image_from_sd, 320x331 interlaced slide", 1, bench_slide_interlaced},
+   {"caption_boxed",     "Slide, then a box, then a caption on the box", 1, bench_caption_boxed},
+   {"caption_over",      "Same caption composited over the slide in one pass", 1, bench_caption_over},
+   {"popup_full",        "Popup closed by redrawing the whole homescreen", 1, bench_popup_close_full},
+   {"popup_region",      "Same, only the 300x250 popup area",           1, bench_popup_close_region},
+   {"popup_compressed",  "Same from a compressed homescreen",           1, bench_popup_close_compressed},
+   {"popup_save_under",  "Menu under the popup read back and put back",   1, bench_popup_save_under},
+   {"menu_squares",      "lcd_background_squares, full screen",         1, bench_menu_squares},
+   {"menu_about_me",     "About Me main menu, buttons and 5 SD images", 1, bench_menu_about_me},
+   {"menu_education",    "About Me education page, text on black",      1, bench_menu_education},
+   {"menu_settings",     "Settings popup",                              1, bench_menu_settings},
+   {"menu_intro",        "Introduction popup with rounded buttons",     1, bench_menu_intro},
+   {"menu_skills",       "Skills list, 14 entries, drawn whole 14 times", 1, bench_menu_skills},
+   {"skills_scroll",     "Same list scrolled 14 times by one row",      1, bench_skills_scroll},
+   {"icons_single",      "6 packed skills icons, one read each",        1, bench_icons_single},
+   {"icons_batched",     "Same icons from one lcd_images_from_sd read", 1, bench_icons_batched},
+   {"fill_screen",       "lcd_draw_rectangle, full screen",             1, bench_fill_screen},
+   {"boot_frames",       "Boot animation, 3 spins of 12 whole 136x200 frames", 1, bench_boot_frames},
+   {"boot_delta",        "Same from the delta animation",               1, bench_boot_delta},
+   {"boot_engine",       "Whole boot sequence from gui_animation_update, SD reads in between", 1, bench_boot_engine},
+   {"lookup_addresses",  "microsd_init, cheat sheet without WAV sizes",  1, bench_lookup_addresses},
+   {"lookup_table",      "Same with the sizes stored in the cheat sheet", 1, bench_lookup_table},
+   {"lookup_fat32",      "No cheat sheet, files found by name in /assets", 1, bench_lookup_fat32},
+   {"search_each",       "sd_find_file_address, card read once per file", 1, bench_search_each},
+   {"search_once",       "sd_append_file_addresses, one CMD18 pass",    1, bench_search_once},
+   {"search_end",        "Same pass on a card that ends before the last file", 1, bench_search_end},
+   {"write_single",      "64 blocks, one CMD24 each",                  1, bench_write_single},
+   {"write_multiple",    "Same blocks with one CMD25",                  1, bench_write_multiple},
+   {"write_erased",      "Same, ACMD23 pre-erase before the CMD25",     1, bench_write_erased},
+   {"flag_card",         "Startup flag block read from the card 100 times", 1, bench_flag_card},
+   {"flag_cached",       "Same flag from states_read_startup_flag, cached", 1, bench_flag_cached},
+   {"expand_table",      "lcd_expand_2bpp over the medium font",        0, bench_expand_table},
+   {"expand_reference",  "per-pixel mask and color map decode",         0, bench_expand_reference},
+   {"glyph_cache",       "24 character rows built from cached ink boxes", 0, bench_glyph_cache},
+   {"glyph_expand",      "Same rows decoded from the font every time",   0, bench_glyph_expand},
+};
+
+static const size_t total_bench_cases = sizeof(bench_cases) / sizeof(bench_cases[0]);
+
+static uint8_t bench_selected[sizeof(bench_cases) / sizeof(bench_cases[0])];
+static volatile uint16_t bench_sink = 0; //Keeps host-only kernels from being optimized away
+static uint8_t bench_block[512];
+
+/*
+****************************************************
+********** Private Function Prototypes *************
+****************************************************
+*/
+static void bench_usage(const char *p_program);
+static void bench_run_case(const t_bench_case *p_case);
+static void bench_firmware_entry(void);
+
+/*
+****************************************************
+********** Public Function Definitions *************
+****************************************************
+*/
+int
+main(int argc, char **argv)
+{
+   uint8_t any_selected = 0;
+
+   for(int current_argument = 1; current_argument < argc; current_argument++)
+   {
+      uint8_t found = 0;
+
+      for(size_t current_case = 0; current_case < total_bench_cases; current_case++)
+      {
+         if(0 == strcmp(argv[current_argument], bench_cases[current_case].name))
+         {
+            bench_selected[current_case] = 1;
+            any_selected = 1;
+            found = 1;
+         }
+      }
+
+      if(!found)
+      {
+         bench_usage(argv[0]);
+         return(1);
+      }
+   }
+
+   //No arguments runs every case
+   if(!any_selected)
+   {
+      memset(bench_selected, 1, sizeof(bench_selected));
+   }
+
+   sim_init();
+   sim_card_init(0);
+   sim_profile_enable(0);
+
+   fprintf(stdout, "%-18s %10s %10s %11s %12s %7s %9s %11s\n",
+           "case", "pixels", "sim ms", "sim Mpx/s", "bus writes", "SPI %", "host ms", "host Mpx/s");
+
+   //Host-only kernels do not touch the simulator and run straight away
+   for(size_t current_case = 0; current_case < total_bench_cases; current_case++)
+   {
+      if(bench_selected[current_case] && !bench_cases[current_case].simulated)
+      {
+         bench_run_case(&bench_cases[current_case]);
+      }
+   }
+
+   sim_run_firmware(bench_firmware_entry);
+
+   return(0);
+}
+
+
+/*
+****************************************************
+********** Private Function Definitions ************
+****************************************************
+*/
+static void
+bench_usage(const char *p_program)
+{
+   fprintf(stderr, "usage: %s [case ...]\n", p_program);
+
+   for(size_t current_case = 0; current_case < total_bench_cases; current_case++)
+   {
+      fprintf(stderr, "  %-18s %s\n", bench_cases[current_case].name, bench_cases[current_case].description);
+   }
+}
+
+
+/*!
+* @brief Runs one case and prints a result line
+* @param[in] p_case
+* @return NONE
+*/
+static void
+bench_run_case(const t_bench_case *p_case)
+{
+   uint64_t start_cycles = sim_now;
+   uint64_t start_spi_busy = sim_stats.spi_busy_cycles;
+   uint64_t start_writes = 0;
+
+   for(uint32_t current_bus = 0; current_bus < sim_total_buses; current_bus++)
+   {
+      start_writes += sim_stats.bus_writes[current_bus];
+   }
+
+   auto start_time = std::chrono::steady_clock::now();
+   uint64_t pixels = p_case->run();
+
+   //Pixels still going out in the background belong to this case
+   if(p_case->simulated)
+   {
+      uint64_t queued_pixels = sim_stats.lcd_pixels;
+      lcd_dma_wait();
+      pixels += sim_stats.lcd_pixels - queued_pixels;
+   }
+
+   auto end_time = std::chrono::steady_clock::now();
+
+   uint64_t bus_writes = 0;
+
+   for(uint32_t current_bus = 0; current_bus < sim_total_buses; current_bus++)
+   {
+      bus_writes += sim_stats.bus_writes[current_bus];
+   }
+
+   bus_writes -= start_writes;
+
+   double host_ms = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+   double sim_ms = (double)(sim_now - start_cycles) / SIM_CYCLES_PER_MS;
+   double spi_busy = (sim_now > start_cycles) ? ((100.0 * (double)(sim_stats.spi_busy_cycles - start_spi_busy)) / (double)(sim_now - start_cycles)) : 0.0;
+
+   if(p_case->simulated)
+   {
+      fprintf(stdout, "%-18s %10llu %10.3f %11.3f %12llu %7.1f %9.1f %11.2f\n", p_case->name,
+              (unsigned long long)pixels, sim_ms, (sim_ms > 0.0) ? ((double)pixels / (sim_ms * 1000.0)) : 0.0,
+              (unsigned long long)bus_writes, spi_busy, host_ms, (double)pixels / (host_ms * 1000.0));
+   }
+
+   else
+   {
+      fprintf(stdout, "%-18s %10llu %10s %11s %12s %7s %9.1f %11.2f\n", p_case->name,
+              (unsigned long long)pixels, "-", "-", "-", "-", host_ms, (double)pixels / (host_ms * 1000.0));
+   }
+
+   fflush(stdout);
+}
+
+
+static uint64_t
+bench_font_medium(void)
+{
+   char text[] = "The quick brown fox jump";
+   uint64_t start_pixels = sim_stats.lcd_pixels;
+
+   for(uint32_t repeat = 0; repeat < 200; repeat++)
+   {
+      lcd_print_string(text, 2, (uint16_t)(40 + ((repeat % 20) * 20)), BENCH_TEXT_COLOR, BENCH_BACKGROUND_COLOR);
+   }
+
+   return(sim_stats.lcd_pixels - start_pixels);
+}
+
+
+static uint64_t
+bench_font_small(void)
+{
+   char text[] = "Sphinx of black quartz judge";
+   uint64_t start_pixels = sim_stats.lcd_pixels;
+
+   for(uint32_t repeat = 0; repeat < 200; repeat++)
+   {
+      lcd_print_string_small(text, 2, (uint16_t)(40 + ((repeat % 25) * 16)), BENCH_TEXT_COLOR, BENCH_BACKGROUND_COLOR);
+   }
+
+   return(sim_stats.lcd_pixels - start_pixels);
+}
+
+
+static uint64_t
+bench_bitmap(void)
+{
+   uint64_t start_pixels = sim_stats.lcd_pixels;
+
+   for(uint32_t repeat = 0; repeat < 200; repeat++)
+   {
+      uint16_t x = (uint16_t)((repeat % 6) * 50);
+      uint16_t y = (uint16_t)(40 + ((repeat / 6) % 10) * 40);
+
+      lcd_send_bitmap(job_icon_bmp, x, y, BENCH_TEXT_COLOR, BENCH_BACKGROUND_COLOR);
+      lcd_send_bitmap(home_button_bmp, x, y + 200, BENCH_TEXT_COLOR, BENCH_BACKGROUND_COLOR);
+   }
+
+   return(sim_stats.lcd_pixels - start_pixels);
+}
+
+
+/*!
+* @brief Portfolio/Device app slide switch, drawn from each card image format
+*/
+static uint64_t
+bench_slide_bmp(void)
+{
+   sim_card_set_rgb565_images(0);
+   uint64_t pixels = bench_slide_timed("slide_bmp");
+   sim_card_set_rgb565_images(1);
+
+   return(pixels);
+}
+
+
+static uint64_t
+bench_slide_rgb565(void)
+{
+   sim_card_set_rgb565_images(1);
+
+   return(bench_slide_timed("slide_rgb565"));
+}
+
+
+static uint64_t
+bench_slide_compressed(void)
+{
+   sim_card_set_compressed_images(1);
+   uint64_t pixels = bench_slide_timed("slide_compressed");
+   sim_card_set_compressed_images(0);
+
+   return(pixels);
+}
+
+
+static uint64_t
+bench_slide_interlaced(void)
+{
+   sim_card_set_interlaced_images(1);
+   uint64_t pixels = bench_slide_timed("slide_interlaced");
+   sim_card_set_interlaced_images(0);
+
+   return(pixels);
+}
+
+
+/*!
+* @brief Draws the slide 10 times and prints how long it took on average until every pixel of
+*        it had been written once, the first full frame, and until it was done
+*/
+static uint64_t
+bench_slide_timed(const char *p_name)
+{
+   uint64_t start_pixels = sim_stats.lcd_pixels;
+   uint64_t first_frame_cycles = 0;
+   uint64_t total_cycles = 0;
+
+   for(uint32_t repeat = 0; repeat < 10; repeat++)
+   {
+      uint64_t start_cycles = sim_now;
+
+      sim_lcd_watch_area(0, BENCH_SLIDE_TOP, 320, BENCH_SLIDE_BOTTOM);
+      lcd_image_from_sd(0, BENCH_SLIDE_TOP, 320, BENCH_SLIDE_BOTTOM, sim_card_asset_address(BENCH_SLIDE_ASSET));
+      lcd_dma_wait();
+
+      first_frame_cycles += sim_lcd_watch_filled() - start_cycles;
+      total_cycles += sim_now - start_cycles;
+   }
+
+   fprintf(stdout, "%s: first full frame after %.1f ms, finished after %.1f ms\n", p_name,
+           (double)first_frame_cycles / (10 * SIM_CYCLES_PER_MS), (double)total_cycles / (10 * SIM_CYCLES_PER_MS));
+
+   return(sim_stats.lcd_pixels - start_pixels);
+}
+
+
+/*!
+* @brief Slide with a caption, over a solid box or blended with the slide itself
+*/
+static uint64_t
+bench_caption_boxed(void)
+{
+   uint64_t start_pixels = sim_stats.lcd_pixels;
+   char caption[] = "ADC acquisition board";
+
+   for(uint32_t repeat = 0; repeat < 10; repeat++)
+   {
+      lcd_image_from_sd(0, BENCH_SLIDE_TOP, 320, BENCH_SLIDE_BOTTOM, sim_card_asset_address(BENCH_SLIDE_ASSET));
+      lcd_draw_rectangle(BENCH_CAPTION_BOX_COLOR, 0, BENCH_CAPTION_BOX_TOP, 320, BENCH_SLIDE_BOTTOM);
+      lcd_print_string(caption, BENCH_CAPTION_X, BENCH_CAPTION_Y, BENCH_CAPTION_COLOR, BENCH_CAPTION_BOX_COLOR);
+   }
+
+   return(sim_stats.lcd_pixels - start_pixels);
+}
+
+
+static uint64_t
+bench_caption_over(void)
+{
+   uint64_t start_pixels = sim_stats.lcd_pixels;
+   char caption[] = "ADC acquisition board";
+
+   for(uint32_t repeat = 0; repeat < 10; repeat++)
+   {
+      lcd_display_list_begin();
+      lcd_image_from_sd(0, BENCH_SLIDE_TOP, 320, BENCH_SLIDE_BOTTOM, sim_card_asset_address(BENCH_SLIDE_ASSET));
+      lcd_print_string_over(caption, BENCH_CAPTION_X, BENCH_CAPTION_Y, BENCH_CAPTION_COLOR);
+      lcd_display_list_end();
+   }
+
+   return(sim_stats.lcd_pixels - start_pixels);
+}
+
+
+/*!
+* @brief Homescreen put back after a popup closes, whole or only under the popup
+*/
+static uint64_t
+bench_popup_close_full(void)
+{
+   uint64_t start_pixels = sim_stats.lcd_pixels;
+
+   for(uint32_t repeat = 0; repeat < 10; repeat++)
+   {
+      lcd_image_from_sd(0, BENCH_SLIDE_TOP, 320, BENCH_HOME_BOTTOM, sim_card_asset_address(homescreen_bmp));
+   }
+
+   return(sim_stats.lcd_pixels - start_pixels);
+}
+
+
+static uint64_t
+bench_popup_close_region(void)
+{
+   uint64_t start_pixels = sim_stats.lcd_pixels;
+
+   for(uint32_t repeat = 0; repeat < 10; repeat++)
+   {
+      lcd_image_region_from_sd(10, BENCH_POPUP_TOP, 310, BENCH_POPUP_BOTTOM, 0, BENCH_SLIDE_TOP,
+                               sim_card_asset_address(homescreen_bmp));
+   }
+
+   return(sim_stats.lcd_pixels - start_pixels);
+}
+
+
+static uint64_t
+bench_popup_close_compressed(void)
+{
+   uint64_t start_pixels = sim_stats.lcd_pixels;
+
+   sim_card_set_compressed_images(1);
+
+   for(uint32_t repeat = 0; repeat < 10; repeat++)
+   {
+      lcd_image_region_from_sd(10, BENCH_POPUP_TOP, 310, BENCH_POPUP_BOTTOM, 0, BENCH_SLIDE_TOP,
+                               sim_card_asset_address(homescreen_bmp));
+   }
+
+   sim_card_set_compressed_images(0);
+   return(sim_stats.lcd_pixels - start_pixels);
+}
+
+
+/*!
+* @brief Popup area read back from the LCD before the popup opens and written again when it closes
+*/
+static uint64_t
+bench_popup_save_under(void)
+{
+   uint64_t start_pixels = sim_stats.lcd_pixels;
+
+   //The education menu leaves parts of the screen alone, clear what earlier cases drew there
+   lcd_draw_rectangle(0x0000, 0, 0, 320, 480);
+   gui_create_aboutme_education_menu();
+
+   //Only the save and the restore are timed, like popup_full only times the redraw
+   for(uint32_t repeat = 0; repeat < 10; repeat++)
+   {
+      if(!lcd_save_under(10, BENCH_POPUP_TOP, 310, BENCH_POPUP_BOTTOM, BENCH_EDUCATION_UNDER_BYTES))
+      {
+         fprintf(stderr, "popup_save_under: the menu does not fit in the save-under buffer\n");
+      }
+
+      lcd_restore_under();
+   }
+
+   return(sim_stats.lcd_pixels - start_pixels);
+}
+
+
+/*!
+* @brief Whole screens built by gui.c, bus writes are the number to compare
+*/
+static uint64_t
+bench_menu_squares(void)
+{
+   uint64_t start_pixels = sim_stats.lcd_pixels;
+
+   for(uint32_t repeat = 0; repeat < 10; repeat++)
+   {
+      lcd_background_squares();
+   }
+
+   return(sim_stats.lcd_pixels - start_pixels);
+}
+
+
+static uint64_t
+bench_menu_about_me(void)
+{
+   uint64_t start_pixels = sim_stats.lcd_pixels;
+   uint32_t button_images[5] = {0};
+
+   for(uint32_t current_image = 0; current_image < 5; current_image++)
+   {
+      button_images[current_image] = sim_card_asset_address(about_me_main_education + current_image);
+   }
+
+   for(uint32_t repeat = 0; repeat < 10; repeat++)
+   {
+      gui_create_aboutme_main_menu(button_images);
+   }
+
+   return(sim_stats.lcd_pixels - start_pixels);
+}
+
+
+static uint64_t
+bench_menu_education(void)
+{
+   uint64_t start_pixels = sim_stats.lcd_pixels;
+
+   for(uint32_t repeat = 0; repeat < 10; repeat++)
+   {
+      gui_create_aboutme_education_menu();
+   }
+
+   return(sim_stats.lcd_pixels - start_pixels);
+}
+
+
+static uint64_t
+bench_menu_settings(void)
+{
+   uint64_t start_pixels = sim_stats.lcd_pixels;
+
+   for(uint32_t repeat = 0; repeat < 10; repeat++)
+   {
+      gui_create_settings_menu();
+   }
+
+   return(sim_stats.lcd_pixels - start_pixels);
+}
+
+
+static uint64_t
+bench_menu_intro(void)
+{
+   uint64_t start_pixels = sim_stats.lcd_pixels;
+
+   for(uint32_t repeat = 0; repeat < 10; repeat++)
+   {
+      gui_create_intro_menu(1);
+   }
+
+   return(sim_stats.lcd_pixels - start_pixels);
+}
+
+
+/*!
+* @brief Skills list twice as long as the screen. Each case redraws or scrolls it 14 times so
+*        the bus writes can be compared directly
+*/
+static uint64_t
+bench_menu_skills(void)
+{
+   uint64_t start_pixels = sim_stats.lcd_pixels;
+
+   bench_skills_list_init();
+
+   for(uint32_t repeat = 0; repeat < 14; repeat++)
+   {
+      gui_create_menu_skills(bench_skills_list, BENCH_SKILLS_LENGTH);
+   }
+
+   return(sim_stats.lcd_pixels - start_pixels);
+}
+
+
+static uint64_t
+bench_skills_scroll(void)
+{
+   bench_skills_list_init();
+   gui_create_menu_skills(bench_skills_list, BENCH_SKILLS_LENGTH);
+
+   uint64_t start_pixels = sim_stats.lcd_pixels;
+
+   for(uint32_t repeat = 0; repeat < 14; repeat++)
+   {
+      gui_scroll_menu_skills((7 > repeat) ? 1 : -1);
+   }
+
+   return(sim_stats.lcd_pixels - start_pixels);
+}
+
+
+/*!
+* @brief Whole screen fills, sent by the CPU loop in lcd_draw_rectangle()
+*/
+static uint64_t
+bench_fill_screen(void)
+{
+   uint64_t start_pixels = sim_stats.lcd_pixels;
+
+   for(uint32_t repeat = 0; repeat < 10; repeat++)
+   {
+      lcd_draw_rectangle((repeat & 1) ? 0x0000 : 0xFFFF, 0, 0, 320, 480);
+   }
+
+   return(sim_stats.lcd_pixels - start_pixels);
+}
+
+
+/*!
+* @brief The frames of gui_boot_animation() without its delays, whole or as deltas
+*/
+static uint64_t
+bench_boot_frames(void)
+{
+   uint64_t start_pixels = sim_stats.lcd_pixels;
+
+   for(uint32_t rotation = 0; rotation < 3; rotation++)
+   {
+      for(uint32_t current_frame = 0; current_frame < BENCH_BOOT_FRAMES; current_frame++)
+      {
+         lcd_image_from_sd(BENCH_BOOT_X, BENCH_BOOT_Y, BENCH_BOOT_X + 136, BENCH_BOOT_Y + 200,
+                           sim_card_asset_address(startup_animation_0 + current_frame));
+      }
+   }
+
+   return(sim_stats.lcd_pixels - start_pixels);
+}
+
+
+static uint64_t
+bench_boot_delta(void)
+{
+   uint64_t start_pixels = sim_stats.lcd_pixels;
+   t_lcd_animation animation;
+
+   if(BENCH_BOOT_FRAMES != lcd_animation_open(&animation, BENCH_BOOT_X, BENCH_BOOT_Y, sim_card_asset_address(startup_animation_delta)))
+   {
+      fprintf(stderr, "boot_delta: the card has no delta animation of the boot frames\n");
+   }
+
+   for(uint32_t current_frame = 0; current_frame < (3 * BENCH_BOOT_FRAMES); current_frame++)
+   {
+      lcd_animation_draw_next(&animation);
+   }
+
+   return(sim_stats.lcd_pixels - start_pixels);
+}
+
+
+/*!
+* @brief The boot sequence as the main loop plays it, with an SD block read standing in for the
+*        rest of the loop between updates. Reports how much was read and how late the frames were
+*/
+static uint64_t
+bench_boot_engine(void)
+{
+   uint64_t start_pixels = sim_stats.lcd_pixels;
+   uint64_t start_cycles = sim_now;
+   uint32_t frames[BENCH_BOOT_FRAMES + 1];
+   uint32_t address = sim_card_asset_address(BENCH_SLIDE_ASSET);
+   uint32_t blocks = 0;
+   static t_gui_animation animation;
+
+   for(uint32_t current_frame = 0; current_frame <= BENCH_BOOT_FRAMES; current_frame++)
+   {
+      frames[current_frame] = sim_card_asset_address(startup_animation_0 + current_frame); //startup_animation_12 is the title
+   }
+
+   gui_boot_animation(&animation, frames, BENCH_BOOT_FRAMES + 1, sim_card_asset_address(startup_animation_delta));
+
+   while(gui_animation_is_running(&animation))
+   {
+      gui_animation_update();
+      sd_read_block(bench_block, address + (blocks % BENCH_ENGINE_BLOCKS));
+      blocks++;
+   }
+
+   fprintf(stdout, "boot_engine: %u frames over %.1f ms, %u SD blocks read in between, frames late by %.1f us on average and %u us at most\n",
+           animation.frame, (double)(sim_now - start_cycles) / SIM_CYCLES_PER_MS, blocks,
+           (double)animation.late_total_us / animation.frame, animation.late_max_us);
+
+   return(sim_stats.lcd_pixels - start_pixels);
+}
+
+
+/*!
+* @brief The six skills icons with the files packed back to back on the card, drawn one read
+*        at a time or as one batch
+*/
+static uint64_t
+bench_icons_single(void)
+{
+   uint64_t start_pixels = sim_stats.lcd_pixels;
+   uint64_t start_commands = sim_stats.sd_commands;
+
+   sim_card_set_packed_files(1);
+
+   for(uint32_t repeat = 0; repeat < 10; repeat++)
+   {
+      for(uint32_t current_icon = 0; current_icon < BENCH_ICONS; current_icon++)
+      {
+         uint16_t y = BENCH_ICON_Y + (current_icon * BENCH_ICON_SPACING);
+
+         lcd_image_from_sd(BENCH_ICON_X, y, BENCH_ICON_X + 32, y + 40, sim_card_asset_address(skills_arm + current_icon));
+      }
+   }
+
+   sim_card_set_packed_files(0);
+
+   fprintf(stdout, "icons_single: %llu SD commands\n", (unsigned long long)(sim_stats.sd_commands - start_commands));
+   return(sim_stats.lcd_pixels - start_pixels);
+}
+
+
+static uint64_t
+bench_icons_batched(void)
+{
+   uint64_t start_pixels = sim_stats.lcd_pixels;
+   uint64_t start_commands = sim_stats.sd_commands;
+   t_lcd_image_blit icons[BENCH_ICONS];
+
+   sim_card_set_packed_files(1);
+
+   for(uint32_t current_icon = 0; current_icon < BENCH_ICONS; current_icon++)
+   {
+      icons[current_icon].x_initial = BENCH_ICON_X;
+      icons[current_icon].y_initial = BENCH_ICON_Y + (current_icon * BENCH_ICON_SPACING);
+      icons[current_icon].x_final = BENCH_ICON_X + 32;
+      icons[current_icon].y_final = icons[current_icon].y_initial + 40;
+      icons[current_icon].address = sim_card_asset_address(skills_arm + current_icon);
+   }
+
+   for(uint32_t repeat = 0; repeat < 10; repeat++)
+   {
+      lcd_images_from_sd(icons, BENCH_ICONS);
+   }
+
+   sim_card_set_packed_files(0);
+
+   fprintf(stdout, "icons_batched: %llu SD commands\n", (unsigned long long)(sim_stats.sd_commands - start_commands));
+   return(sim_stats.lcd_pixels - start_pixels);
+}
+
+
+/*!
+* @brief Times microsd_init() with the addresses in the cheat sheet only, every WAV header read
+*/
+static uint64_t
+bench_lookup_addresses(void)
+{
+   uint64_t pixels = 0;
+
+   sim_card_set_address_only_table(1);
+   pixels = bench_lookup("lookup_addresses", 0);
+   sim_card_set_address_only_table(0);
+
+   return(pixels);
+}
+
+
+/*!
+* @brief Times microsd_init() with the addresses and sizes in the cheat sheet
+*/
+static uint64_t
+bench_lookup_table(void)
+{
+   return(bench_lookup("lookup_table", 0));
+}
+
+
+/*!
+* @brief Same on a card that lists the files in /assets of a FAT32 volume and was never
+*        indexed, so microsd_init() has to walk the volume
+*/
+static uint64_t
+bench_lookup_fat32(void)
+{
+   uint64_t pixels = 0;
+
+   sim_card_set_blank_table(1);
+   pixels = bench_lookup("lookup_fat32", 1);
+   sim_card_set_blank_table(0);
+
+   return(pixels);
+}
+
+
+static uint64_t
+bench_lookup(const char *p_name, uint8_t fat32_volume)
+{
+   uint64_t start_commands = sim_stats.sd_commands;
+   uint64_t start_blocks = sim_stats.sd_blocks_read;
+   uint64_t start_cycles = sim_now;
+   uint32_t addresses[max_total_addresses];
+   uint32_t wrong_addresses = 0;
+   uint32_t wrong_sizes = 0;
+
+   sim_card_set_fat32_volume(fat32_volume);
+   microsd_init();
+   sim_card_set_fat32_volume(0);
+
+   //microsd_init() leaves SPI2 at the handshake speed, main_peripherals_init() raises it after
+   SPI2->CR1 &= ~(0x07 << SPI_CR1_BR_Pos);
+
+   sd_get_file_addresses(addresses);
+
+   for(uint32_t current_file = 1; current_file < max_total_addresses; current_file++)
+   {
+      uint8_t header[512];
+
+      if(sim_card_asset_address(current_file) != addresses[current_file])
+      {
+         wrong_addresses++;
+      }
+
+      //WAV sizes against the RIFF size in the header, taken straight from the card
+      sim_card_read(sim_card_asset_address(current_file), header);
+
+      if((0 == memcmp(header, "RIFF", 4)) &&
+         (((header[4] | (header[5] << 8) | (header[6] << 16) | ((uint32_t)header[7] << 24)) / 512) != sd_get_wav_size(current_file)))
+      {
+         wrong_sizes++;
+      }
+   }
+
+   fprintf(stdout, "%s: %.2f ms, %llu SD commands, %llu blocks read, %u wrong addresses, %u wrong WAV sizes\n",
+           p_name, (double)(sim_now - start_cycles) / SIM_CYCLES_PER_MS,
+           (unsigned long long)(sim_stats.sd_commands - start_commands),
+           (unsigned long long)(sim_stats.sd_blocks_read - start_blocks), wrong_addresses, wrong_sizes);
+
+   return(0);
+}
+
+
+/*!
+* @brief Finds the first files the way sd_search_file_addresses() used to, one scan from the
+*        start of the search per file with single block reads
+*/
+static uint64_t
+bench_search_each(void)
+{
+   uint64_t start_blocks = sim_stats.sd_blocks_read;
+   uint64_t start_cycles = sim_now;
+   uint32_t wrong_addresses = 0;
+
+   for(uint32_t current_file = 1; current_file <= BENCH_SEARCH_FILES; current_file++)
+   {
+      if(sim_card_asset_address(current_file) != sd_find_file_address(sim_card_asset_identifier(current_file)))
+      {
+         wrong_addresses++;
+      }
+   }
+
+   double elapsed_ms = (double)(sim_now - start_cycles) / SIM_CYCLES_PER_MS;
+   uint64_t blocks = sim_stats.sd_blocks_read - start_blocks;
+
+   fprintf(stdout, "search_each: %llu blocks read in %.1f ms, %.0f blocks/s, %u wrong addresses\n",
+           (unsigned long long)blocks, elapsed_ms, (blocks * 1000.0) / elapsed_ms, wrong_addresses);
+
+   return(0);
+}
+
+
+/*!
+* @brief Same files found in one pass, then written to the cheat sheet
+*/
+static uint64_t
+bench_search_once(void)
+{
+   uint64_t start_blocks = sim_stats.sd_blocks_read;
+   uint64_t start_cycles = sim_now;
+   uint32_t addresses[max_total_addresses];
+   uint32_t wrong_addresses = 0;
+
+   sd_append_file_addresses((e_sd_address)1, (e_sd_address)(BENCH_SEARCH_FILES + 1));
+   sd_get_file_addresses(addresses);
+
+   for(uint32_t current_file = 1; current_file <= BENCH_SEARCH_FILES; current_file++)
+   {
+      if(sim_card_asset_address(current_file) != addresses[current_file])
+      {
+         wrong_addresses++;
+      }
+   }
+
+   double elapsed_ms = (double)(sim_now - start_cycles) / SIM_CYCLES_PER_MS;
+   uint64_t blocks = sim_stats.sd_blocks_read - start_blocks;
+
+   fprintf(stdout, "search_once: %llu blocks read in %.1f ms, %.0f blocks/s, %u wrong addresses\n",
+           (unsigned long long)blocks, elapsed_ms, (blocks * 1000.0) / elapsed_ms, wrong_addresses);
+
+   return(0);
+}
+
+/*!
+* @brief Writes BENCH_WRITE_BLOCKS blocks one CMD24 at a time
+*/
+static uint64_t
+bench_write_single(void)
+{
+   return(bench_write("write_single", 0));
+}
+
+
+/*!
+* @brief Same blocks with sd_write_multiple_block()
+*/
+static uint64_t
+bench_write_multiple(void)
+{
+   return(bench_write("write_multiple", 1));
+}
+
+
+/*!
+* @brief Same blocks with sd_write_multiple_block(), erased ahead with ACMD23
+*/
+static uint64_t
+bench_write_erased(void)
+{
+   return(bench_write("write_erased", 2));
+}
+
+
+static uint64_t
+bench_write(const char *p_name, uint8_t mode)
+{
+   static uint8_t data[BENCH_WRITE_BLOCKS * 512];
+   uint8_t read_back[512];
+   uint32_t wrong_blocks = 0;
+   uint8_t write_success = 1;
+
+   //Different data each case, so a block left from the case before does not pass
+   for(uint32_t current_byte = 0; current_byte < sizeof(data); current_byte++)
+   {
+      data[current_byte] = (uint8_t)((current_byte * 7) + (current_byte >> 9) + mode);
+   }
+
+   uint64_t start_cycles = sim_now;
+
+   if(0 == mode)
+   {
+      for(uint32_t current_block = 0; current_block < BENCH_WRITE_BLOCKS; current_block++)
+      {
+         sd_write_block(&data[current_block * 512], BENCH_WRITE_ADDRESS + current_block);
+      }
+   }
+
+   else
+   {
+      write_success = sd_write_multiple_block(data, BENCH_WRITE_ADDRESS, BENCH_WRITE_BLOCKS, (2 == mode));
+   }
+
+   double elapsed_ms = (double)(sim_now - start_cycles) / SIM_CYCLES_PER_MS;
+
+   //Straight from the card, the write is what is being checked
+   for(uint32_t current_block = 0; current_block < BENCH_WRITE_BLOCKS; current_block++)
+   {
+      sim_card_read(BENCH_WRITE_ADDRESS + current_block, read_back);
+
+      if(0 != memcmp(read_back, &data[current_block * 512], 512))
+      {
+         wrong_blocks++;
+      }
+   }
+
+   fprintf(stdout, "%s: %u blocks in %.2f ms, %.0f KB/s, %s, %u wrong blocks\n",
+           p_name, BENCH_WRITE_BLOCKS, elapsed_ms, (BENCH_WRITE_BLOCKS * 0.5) / (elapsed_ms / 1000.0),
+           write_success ? "accepted" : "failed", wrong_blocks);
+
+   return(0);
+}
+
+
+/*!
+* @brief Searches for one file more than search_once on a card that ends where that file would
+*        start, so the pass has to stop at the end of the card
+*/
+static uint64_t
+bench_search_end(void)
+{
+   uint64_t start_blocks = sim_stats.sd_blocks_read;
+   uint64_t start_cycles = sim_now;
+   e_sd_address stop_address = (e_sd_address)(BENCH_SEARCH_FILES + 2);
+
+   sim_card_set_capacity(sim_card_asset_address(BENCH_SEARCH_FILES + 1));
+   uint16_t files_found = sd_scan_file_addresses((e_sd_address)1, stop_address);
+   sim_card_set_capacity(0);
+
+   fprintf(stdout, "search_end: %llu blocks read in %.1f ms, %u of %u files found\n",
+           (unsigned long long)(sim_stats.sd_blocks_read - start_blocks),
+           (double)(sim_now - start_cycles) / SIM_CYCLES_PER_MS, files_found, BENCH_SEARCH_FILES + 1);
+
+   //Take the addresses of the files that were looked for back from the cheat sheet
+   microsd_init();
+   SPI2->CR1 &= ~(0x07 << SPI_CR1_BR_Pos);
+
+   return(0);
+}
+
+
+/*!
+* @brief Reads the startup flag the way states_read_startup_flag() used to, a whole block from
+*        the card every time
+*/
+static uint64_t
+bench_flag_card(void)
+{
+   uint64_t start_blocks = sim_stats.sd_blocks_read;
+   uint64_t start_cycles = sim_now;
+   uint8_t flag = bench_block[0];
+
+   for(uint32_t current_read = 0; current_read < BENCH_FLAG_READS; current_read++)
+   {
+      sd_read_block(bench_block, BENCH_FLAG_ADDRESS);
+      flag = (uint8_t)(flag + bench_block[0]);
+   }
+
+   bench_sink = (uint16_t)(bench_sink + flag);
+
+   fprintf(stdout, "flag_card: %u reads in %.2f ms, %llu blocks read\n", BENCH_FLAG_READS,
+           (double)(sim_now - start_cycles) / SIM_CYCLES_PER_MS,
+           (unsigned long long)(sim_stats.sd_blocks_read - start_blocks));
+
+   return(0);
+}
+
+
+/*!
+* @brief Same reads through the block cache. The flag is then written through the cache and
+*        straight to the card, and each read after a write has to see the new value
+*/
+static uint64_t
+bench_flag_cached(void)
+{
+   t_sd_block_cache_stats start_stats = {};
+   t_sd_block_cache_stats end_stats = {};
+   uint64_t start_blocks = sim_stats.sd_blocks_read;
+   uint64_t start_cycles = sim_now;
+   uint32_t wrong_reads = 0;
+
+   sd_block_cache_get_stats(&start_stats);
+
+   //The first read is the only one that goes to the card
+   uint8_t original_flag = states_read_startup_flag();
+
+   for(uint32_t current_read = 0; current_read < BENCH_FLAG_READS; current_read++)
+   {
+      wrong_reads += (original_flag != states_read_startup_flag());
+   }
+
+   double elapsed_ms = (double)(sim_now - start_cycles) / SIM_CYCLES_PER_MS;
+   uint64_t blocks = sim_stats.sd_blocks_read - start_blocks;
+
+   sd_block_cache_get_stats(&end_stats);
+
+   //Write-through keeps the cached copy
+   states_write_startup_flag(!original_flag);
+   wrong_reads += ((uint8_t)!original_flag != states_read_startup_flag());
+
+   //A write that skips the cache drops the cached copy
+   memset(bench_block, 0, sizeof(bench_block));
+   bench_block[0] = original_flag;
+   sd_write_block(bench_block, BENCH_FLAG_ADDRESS);
+   wrong_reads += (original_flag != states_read_startup_flag());
+
+   fprintf(stdout, "flag_cached: %u reads in %.2f ms, %llu blocks read, %u hits, %u misses, %u wrong reads\n",
+           BENCH_FLAG_READS, elapsed_ms, (unsigned long long)blocks,
+           (unsigned)(end_stats.hits - start_stats.hits), (unsigned)(end_stats.misses - start_stats.misses), wrong_reads);
+
+   return(0);
+}
+
+
+static void
+bench_skills_list_init(void)
+{
+   static char major_text[BENCH_SKILLS_LENGTH][12];
+
+   for(uint32_t current_skill = 0; current_skill < BENCH_SKILLS_LENGTH; current_skill++)
+   {
+      snprintf(major_text[current_skill], sizeof(major_text[current_skill]), "Skill %u", current_skill + 1);
+      bench_skills_list[current_skill].major_text = major_text[current_skill];
+      bench_skills_list[current_skill].minor_text = (char *)"Details";
+      bench_skills_list[current_skill].image[0] = sim_card_asset_address(skills_arm + (current_skill % 6));
+   }
+}
+
+
+/*!
+* @brief Expands every glyph of the medium font with the firmware's lookup table
+*/
+static uint64_t
+bench_expand_table(void)
+{
+   static uint16_t pixels[sizeof(jet_font) * 4];
+   uint64_t total_pixels = 0;
+
+   for(uint32_t repeat = 0; repeat < 2000; repeat++)
+   {
+      //Alternate two palettes so every pass includes a table rebuild
+      lcd_load_expansion_table(BENCH_TEXT_COLOR, ((repeat / 100) & 1) ? 0xFFFF : 0xD6DA);
+      lcd_expand_2bpp(&jet_font[0][0], sizeof(jet_font), pixels);
+      bench_sink = (uint16_t)(bench_sink + pixels[repeat % (sizeof(jet_font) * 4)]);
+      total_pixels += sizeof(jet_font) * 4;
+   }
+
+   return(total_pixels);
+}
+
+
+/*!
+* @brief Same work as bench_expand_table() decoded the way lcd.c did before the expansion
+*        table: mask each pixel out of its byte and look the masked value up in a sparse map
+*/
+static uint64_t
+bench_expand_reference(void)
+{
+   static uint8_t color_table_map[193];
+   static uint16_t pixels[sizeof(jet_font) * 4];
+   static const uint8_t bit_mask_table[4] = {0xC0, 0x30, 0x0C, 0x03};
+   uint64_t total_pixels = 0;
+
+   for(uint8_t code = 0; code < 4; code++)
+   {
+      for(uint8_t position = 0; position < 4; position++)
+      {
+         color_table_map[code << (6 - (position * 2))] = code;
+      }
+   }
+
+   for(uint32_t repeat = 0; repeat < 2000; repeat++)
+   {
+      uint16_t color_table[4] = {BENCH_TEXT_COLOR, (uint16_t)((repeat & 1) ? 0xFFFF : 0xD6DA), 0x8410, 0x4208};
+      const uint8_t *p_source = &jet_font[0][0];
+
+      for(size_t current_byte = 0; current_byte < sizeof(jet_font); current_byte++)
+      {
+         for(uint8_t current_pixel = 0; current_pixel < 4; current_pixel++)
+         {
+            pixels[(current_byte * 4) + current_pixel] =
+               color_table[color_table_map[p_source[current_byte] & bit_mask_table[current_pixel]]];
+         }
+      }
+
+      bench_sink = (uint16_t)(bench_sink + pixels[repeat % (sizeof(jet_font) * 4)]);
+      total_pixels += sizeof(jet_font) * 4;
+   }
+
+   return(total_pixels);
+}
+
+
+/*!
+* @brief Builds the rows of a medium font string the way lcd_print_string_line() does, with
+*        ink boxes copied from the RAM cache. The ink boxes of both palettes together are more than
+*        the cache holds, so they take turns every 100 strings, like two screens would
+*/
+static uint64_t
+bench_glyph_cache(void)
+{
+   static const char text[] = "The quick brown fox jump";
+   static uint16_t line_buffer[(sizeof(text) * 13) + 16];
+   uint64_t total_pixels = 0;
+
+   for(uint32_t repeat = 0; repeat < 20000; repeat++)
+   {
+      uint16_t color_table[4] = {0};
+      const uint16_t *glyph_pixels[sizeof(text)] = {0};
+
+      lcd_get_font_color_table(color_table, BENCH_TEXT_COLOR, ((repeat / 100) & 1) ? 0xFFFF : 0xD6DA);
+      lcd_glyph_cache_start_pass();
+
+      for(size_t current_char = 0; current_char < (sizeof(text) - 1); current_char++)
+      {
+         const t_font_glyph_metrics *p_metrics = &jet_font_metrics[text[current_char] - 32];
+
+         if(0 != p_metrics->ink_x_final)
+         {
+            glyph_pixels[current_char] = lcd_glyph_cache_get(&jet_font[0][0], 20, text[current_char], p_metrics, color_table);
+         }
+      }
+
+      for(uint8_t row = 0; row < 20; row++)
+      {
+         for(size_t column = 0; column < ((sizeof(text) - 1) * 13); column++)
+         {
+            line_buffer[column] = color_table[1];
+         }
+
+         //Ink boxes the full cache could not take are decoded in place
+         for(size_t current_char = 0; current_char < (sizeof(text) - 1); current_char++)
+         {
+            lcd_raster_glyph_row(&line_buffer[current_char * 13], jet_font[text[current_char] - 32], glyph_pixels[current_char],
+                                 &jet_font_metrics[text[current_char] - 32], row, 13, color_table);
+         }
+
+         bench_sink = (uint16_t)(bench_sink + line_buffer[row]);
+         total_pixels += (sizeof(text) - 1) * 13;
+      }
+   }
+
+   return(total_pixels);
+}
+
+
+/*!
+* @brief Same work as bench_glyph_cache() with every glyph row decoded from the font
+*/
+static uint64_t
+bench_glyph_expand(void)
+{
+   static const char text[] = "The quick brown fox jump";
+   static uint16_t line_buffer[(sizeof(text) * 13) + 16];
+   uint64_t total_pixels = 0;
+
+   for(uint32_t repeat = 0; repeat < 20000; repeat++)
+   {
+      uint16_t color_table[4] = {0};
+
+      lcd_get_font_color_table(color_table, BENCH_TEXT_COLOR, (repeat & 1) ? 0xFFFF : 0xD6DA);
+
+      for(uint8_t row = 0; row < 20; row++)
+      {
+         for(size_t column = 0; column < ((sizeof(text) - 1) * 13); column++)
+         {
+            line_buffer[column] = color_table[1];
+         }
+
+         for(size_t current_char = 0; current_char < (sizeof(text) - 1); current_char++)
+         {
+            lcd_raster_glyph_row(&line_buffer[current_char * 13], jet_font[text[current_char] - 32], NULL,
+                                 &jet_font_metrics[text[current_char] - 32], row, 13, color_table);
+         }
+
+         bench_sink = (uint16_t)(bench_sink + line_buffer[row]);
+         total_pixels += (sizeof(text) - 1) * 13;
+      }
+   }
+
+   return(total_pixels);
+}
+
+
+static void
+bench_firmware_entry(void)
+{
+   system_clock_init();
+   main_peripherals_init();
+
+   for(size_t current_case = 0; current_case < total_bench_cases; current_case++)
+   {
+      if(bench_selected[current_case] && bench_cases[current_case].simulated)
+      {
+         bench_run_case(&bench_cases[current_case]);
+      }
+   }
+
+   fflush(NULL);
+   exit(0);
+}
+
+/* end of file */
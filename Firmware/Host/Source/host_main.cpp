@@ -0,0 +1,400 @@
+/** @file host_main.cpp
+*
+* @brief  Command line runner for the host build. Boots the unmodified firmware main() against
+*         the simulated peripherals, replays a scripted sequence of user inputs and reports
+*         bus, LCD, SD and profiler statistics when the run ends.
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#include "sim.h"
+#include "struct_lcd_glyph_cache.h"
+#include "struct_sd_block_cache.h"
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
+
+extern "C" int firmware_main(void); //main() in main.c, renamed by the Makefile
+extern "C" void lcd_glyph_cache_get_stats(t_lcd_glyph_cache_stats *tmp_stats);
+extern "C" void sd_block_cache_get_stats(t_sd_block_cache_stats *tmp_stats);
+
+/*
+****************************************************
+************* File-Static Variables ****************
+****************************************************
+*/
+typedef enum e_script_action
+{
+   script_tap,
+   script_power_button,
+   script_headphones,
+   script_usb,
+   script_battery,
+   script_snapshot
+
+} e_script_action;
+
+typedef struct t_script_entry
+{
+   uint64_t when;
+   e_script_action action;
+   uint32_t arguments[3];
+   const char *p_path;
+
+} t_script_entry;
+
+static std::vector<t_script_entry> script;
+static size_t script_position = 0;
+static int script_slot = -1;
+
+static const char *p_dump_path = NULL;
+static uint8_t print_stats = 0;
+static uint32_t profile_entries = 0;
+
+/*
+****************************************************
+********** Private Function Prototypes *************
+****************************************************
+*/
+static void host_usage(const char *p_program);
+static uint8_t host_parse_time(const char *p_text, uint64_t *p_when, const char **pp_rest);
+static void host_schedule_next(void);
+static void host_script_event(uint64_t when);
+static void host_finish(const char *reason);
+static void host_firmware_entry(void);
+
+/*
+****************************************************
+********** Public Function Definitions *************
+****************************************************
+*/
+int
+main(int argc, char **argv)
+{
+   uint64_t run_time_ms = 10000;
+   uint8_t first_boot = 0;
+   uint8_t bmp_images = 0;
+   uint8_t compressed_images = 0;
+   uint8_t interlaced_images = 0;
+   uint8_t fat32_volume = 0;
+   FILE *p_uart_log = NULL;
+
+   for(int current_argument = 1; current_argument < argc; current_argument++)
+   {
+      const char *p_option = argv[current_argument];
+      const char *p_value = ((current_argument + 1) < argc) ? argv[current_argument + 1] : NULL;
+      t_script_entry entry = {};
+      const char *p_rest = NULL;
+
+      if(0 == strcmp(p_option, "--first-boot"))
+      {
+         first_boot = 1;
+         continue;
+      }
+
+      if(0 == strcmp(p_option, "--bmp-images"))
+      {
+         bmp_images = 1;
+         continue;
+      }
+
+      if(0 == strcmp(p_option, "--compressed-images"))
+      {
+         compressed_images = 1;
+         continue;
+      }
+
+      if(0 == strcmp(p_option, "--interlaced-images"))
+      {
+         interlaced_images = 1;
+         continue;
+      }
+
+      if(0 == strcmp(p_option, "--fat32"))
+      {
+         fat32_volume = 1;
+         continue;
+      }
+
+      if(0 == strcmp(p_option, "--stats"))
+      {
+         print_stats = 1;
+         continue;
+      }
+
+      if(0 == strcmp(p_option, "--profile"))
+      {
+         profile_entries = 30;
+         continue;
+      }
+
+      if(NULL == p_value)
+      {
+         host_usage(argv[0]);
+         return(1);
+      }
+
+      current_argument++;
+
+      if(0 == strcmp(p_option, "--time"))
+      {
+         run_time_ms = strtoull(p_value, NULL, 0);
+      }
+
+      else if(0 == strcmp(p_option, "--dump"))
+      {
+         p_dump_path = p_value;
+      }
+
+      else if(0 == strcmp(p_option, "--uart"))
+      {
+         p_uart_log = (0 == strcmp(p_value, "-")) ? stdout : fopen(p_value, "w");
+      }
+
+      else if(0 == strcmp(p_option, "--tap") && host_parse_time(p_value, &entry.when, &p_rest))
+      {
+         //MS:X,Y[,DURATION_MS]
+         entry.action = script_tap;
+         entry.arguments[2] = 100;
+
+         if(2 > sscanf(p_rest, "%u,%u,%u", &entry.arguments[0], &entry.arguments[1], &entry.arguments[2]))
+         {
+            host_usage(argv[0]);
+            return(1);
+         }
+
+         script.push_back(entry);
+      }
+
+      else if(0 == strcmp(p_option, "--press") && host_parse_time(p_value, &entry.when, &p_rest))
+      {
+         entry.action = script_power_button;
+         entry.arguments[0] = (uint32_t)strtoul(p_rest, NULL, 0);
+         script.push_back(entry);
+      }
+
+      else if(0 == strcmp(p_option, "--headphones") && host_parse_time(p_value, &entry.when, &p_rest))
+      {
+         entry.action = script_headphones;
+         entry.arguments[0] = (uint32_t)strtoul(p_rest, NULL, 0);
+         script.push_back(entry);
+      }
+
+      else if(0 == strcmp(p_option, "--usb") && host_parse_time(p_value, &entry.when, &p_rest))
+      {
+         entry.action = script_usb;
+         entry.arguments[0] = (uint32_t)strtoul(p_rest, NULL, 0);
+         script.push_back(entry);
+      }
+
+      else if(0 == strcmp(p_option, "--battery") && host_parse_time(p_value, &entry.when, &p_rest))
+      {
+         entry.action = script_battery;
+         entry.arguments[0] = (uint32_t)strtoul(p_rest, NULL, 0);
+         script.push_back(entry);
+      }
+
+      else if(0 == strcmp(p_option, "--snap") && host_parse_time(p_value, &entry.when, &p_rest))
+      {
+         entry.action = script_snapshot;
+         entry.p_path = p_rest;
+         script.push_back(entry);
+      }
+
+      else
+      {
+         host_usage(argv[0]);
+         return(1);
+      }
+   }
+
+   std::stable_sort(script.begin(), script.end(),
+                    [](const t_script_entry &a, const t_script_entry &b) { return(a.when < b.when); });
+
+   sim_init();
+   sim_card_init(first_boot);
+   sim_card_set_rgb565_images(!bmp_images);
+   sim_card_set_compressed_images(compressed_images);
+   sim_card_set_interlaced_images(interlaced_images);
+   sim_card_set_fat32_volume(fat32_volume);
+   sim_uart_set_log(p_uart_log);
+   sim_set_finish_hook(host_finish);
+   sim_set_time_limit(run_time_ms * SIM_CYCLES_PER_MS);
+   sim_profile_enable(0 != profile_entries);
+
+   script_slot = sim_event_register("script", host_script_event);
+   host_schedule_next();
+
+   sim_run_firmware(host_firmware_entry);
+
+   return(0);
+}
+
+
+/*
+****************************************************
+********** Private Function Definitions ************
+****************************************************
+*/
+static void
+host_usage(const char *p_program)
+{
+   fprintf(stderr,
+           "usage: %s [options]\n"
+           "  --time MS                 simulated run time (default 10000)\n"
+           "  --tap MS:X,Y[,HOLD_MS]    touch the panel\n"
+           "  --press MS:HOLD_MS        hold the power button\n"
+           "  --headphones MS:0|1       unplug/plug the headphones\n"
+           "  --usb MS:0|1              disconnect/connect USB power\n"
+           "  --battery MS:ADC          battery sense reading\n"
+           "  --snap MS:FILE.ppm        save the LCD contents\n"
+           "  --dump FILE.ppm           save the LCD contents at the end of the run\n"
+           "  --uart FILE|-             log USART1 output\n"
+           "  --first-boot              clear the startup flag on the card\n"
+           "  --bmp-images              store images as 24-bit BMPs instead of RGB565\n"
+           "  --compressed-images       store images in the compressed RGB565 container\n"
+           "  --interlaced-images       store images in the interlaced RGB565 container\n"
+           "  --fat32                   also list the files in /assets of a FAT32 volume\n"
+           "  --stats                   print bus/LCD/SD statistics\n"
+           "  --profile                 print the firmware function profile\n",
+           p_program);
+}
+
+
+/*!
+* @brief Parses the "MS:" prefix of a script option
+*/
+static uint8_t
+host_parse_time(const char *p_text, uint64_t *p_when, const char **pp_rest)
+{
+   char *p_end = NULL;
+   uint64_t milliseconds = strtoull(p_text, &p_end, 0);
+
+   if((p_end == p_text) || (':' != *p_end))
+   {
+      return(0);
+   }
+
+   *p_when = milliseconds * SIM_CYCLES_PER_MS;
+   *pp_rest = p_end + 1;
+   return(1);
+}
+
+
+static void
+host_schedule_next(void)
+{
+   if(script_position < script.size())
+   {
+      sim_event_schedule(script_slot, script[script_position].when);
+   }
+}
+
+
+static void
+host_script_event(uint64_t when)
+{
+   while((script_position < script.size()) && (script[script_position].when <= when))
+   {
+      const t_script_entry *p_entry = &script[script_position];
+      script_position++;
+
+      switch(p_entry->action)
+      {
+      case script_tap:
+         sim_touch_press((uint16_t)p_entry->arguments[0], (uint16_t)p_entry->arguments[1], p_entry->arguments[2]);
+         break;
+
+      case script_power_button:
+         sim_power_button_press(p_entry->arguments[0]);
+         break;
+
+      case script_headphones:
+         sim_set_headphones((uint8_t)p_entry->arguments[0]);
+         break;
+
+      case script_usb:
+         sim_set_usb((uint8_t)p_entry->arguments[0]);
+         break;
+
+      case script_battery:
+         sim_set_battery_adc((uint16_t)p_entry->arguments[0]);
+         break;
+
+      case script_snapshot:
+         sim_lcd_write_ppm(p_entry->p_path);
+         break;
+      }
+   }
+
+   host_schedule_next();
+}
+
+
+static void
+host_finish(const char *reason)
+{
+   fprintf(stdout, "\nsim: %s after %.3f ms (%llu cycles), LCD hash %016llx\n", reason,
+           (double)sim_now / SIM_CYCLES_PER_MS, (unsigned long long)sim_now, (unsigned long long)sim_lcd_hash());
+
+   if(NULL != p_dump_path)
+   {
+      sim_lcd_write_ppm(p_dump_path);
+   }
+
+   if(print_stats)
+   {
+      sim_stats_print(stdout);
+
+      t_lcd_glyph_cache_stats glyph_cache_stats = {};
+      lcd_glyph_cache_get_stats(&glyph_cache_stats);
+      fprintf(stdout, "glyph cache         hits %u, misses %u, bypasses %u, evictions %u, glyphs %u, bytes %u\n",
+              (unsigned)glyph_cache_stats.hits, (unsigned)glyph_cache_stats.misses, (unsigned)glyph_cache_stats.bypasses,
+              (unsigned)glyph_cache_stats.evictions,
+              (unsigned)glyph_cache_stats.glyphs, (unsigned)glyph_cache_stats.bytes);
+
+      t_sd_block_cache_stats block_cache_stats = {};
+      sd_block_cache_get_stats(&block_cache_stats);
+      fprintf(stdout, "sd block cache      hits %u, misses %u, evictions %u, invalidations %u, blocks %u, pinned %u, bytes %u\n",
+              (unsigned)block_cache_stats.hits, (unsigned)block_cache_stats.misses, (unsigned)block_cache_stats.evictions,
+              (unsigned)block_cache_stats.invalidations, (unsigned)block_cache_stats.blocks,
+              (unsigned)block_cache_stats.pinned, (unsigned)block_cache_stats.bytes);
+   }
+
+   if(0 != profile_entries)
+   {
+      sim_profile_print(stdout, profile_entries);
+   }
+
+   fflush(NULL);
+}
+
+
+static void
+host_firmware_entry(void)
+{
+   firmware_main();
+}
+
+/* end of file */
@@ -0,0 +1,1396 @@
+/** @file sim_card_image.cpp
+*
+* @brief  Contents of the simulated microSD card. Every file in enum_sd_file_list.h gets its
+*         own 1024-block slot, or starts right after the one before it when files are packed,
+*         generated on demand: BMPs are 24-bit images with the 5-byte file identifier in the
+*         header gap and WAVs are 8-bit tones with their RIFF size. The boot animation frames
+*         share one background under a ring of spinner dots, and its delta animation is coded
+*         from them. The address cheat sheet and startup flag are laid out exactly as
+*         microsd.c and states.c expect. Blocks written by the firmware are kept and read back.
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#include "sim.h"
+#include "enum_sd_file_list.h"
+#include "rgb565_image.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <ctype.h>
+#include <stdio.h>
+#include <map>
+#include <algorithm>
+#include <array>
+#include <vector>
+
+/*
+****************************************************
+**************** Card Layout ***********************
+****************************************************
+*/
+#define SIM_CARD_ASSET_BASE 20000          //Above the 15000 block start of sd_find_file_address()
+#define SIM_CARD_ASSET_SLOT 1024           //Blocks reserved per file, enough for a 320x480 BMP
+#define SIM_CARD_CHEAT_SHEET 4000000       //SD_ADDRESS_CHEAT_SHEET in microsd.c
+#define SIM_CARD_TABLE_FORMAT 512          //SD_ADDRESS_FORMAT_OFFSET in microsd.h
+#define SIM_CARD_TABLE_SIZES 516           //SD_ADDRESS_SIZE_OFFSET
+#define SIM_CARD_TABLE_TYPES 772           //SD_ADDRESS_TYPE_OFFSET
+#define SIM_CARD_STARTUP_FLAG 4005000      //STATES_ADDRESS_STARTUP_FLAG in states.h
+#define SIM_CARD_BMP_DATA_OFFSET 70
+#define SIM_CARD_BMP_ID_OFFSET 54
+#define SIM_CARD_BMP_BPP_OFFSET 28
+#define SIM_CARD_BMP_IMAGE_SIZE_OFFSET 34
+#define SIM_CARD_IMAGE_ROWS 480            //Compressed images are coded for a full screen height
+#define SIM_CARD_BMP_HEIGHT_OFFSET 22
+#define SIM_CARD_BMP_COMPRESSION_OFFSET 30
+#define SIM_CARD_ANIMATION_ROWS 200        //gui_boot_animation() draws 136x200 frames
+#define SIM_CARD_SLIDE_ROWS 331            //Portfolio and Device slides, SB_OFFSET to MENU3_UTILITIES_BAR_OFFSET
+#define SIM_CARD_SPINNER_DOTS 12           //One lit dot per frame, startup_animation_0 to _11
+#define SIM_CARD_SPINNER_RADIUS 44
+#define SIM_CARD_SPINNER_DOT_SIZE 12
+#define SIM_CARD_WAV_ID_OFFSET 36
+#define SIM_CARD_WAV_MIN_BLOCKS 120
+#define SIM_CARD_WAV_SAMPLE_RATE 22050
+
+/****** FAT32 Volume ***************/
+#define SIM_CARD_VOLUME_START 2048         //Where formatting tools put the first partition
+#define SIM_CARD_VOLUME_BLOCKS 1048576     //512 MB, ends well before the cheat sheet
+#define SIM_CARD_RESERVED_BLOCKS 32
+#define SIM_CARD_FAT_BLOCKS 1028           //Room for every cluster, and keeps the slots on cluster boundaries
+#define SIM_CARD_CLUSTER_BLOCKS 8
+#define SIM_CARD_FAT_START (SIM_CARD_VOLUME_START + SIM_CARD_RESERVED_BLOCKS)
+#define SIM_CARD_DATA_START (SIM_CARD_FAT_START + (2 * SIM_CARD_FAT_BLOCKS))
+#define SIM_CARD_ROOT_CLUSTER 2
+#define SIM_CARD_ASSETS_CLUSTER 3          //The asset directory follows the root directory
+#define SIM_CARD_END_OF_CHAIN 0x0FFFFFFF
+
+static_assert(0 == ((SIM_CARD_ASSET_BASE - SIM_CARD_DATA_START) % SIM_CARD_CLUSTER_BLOCKS),
+              "every slot must start a cluster");
+
+typedef enum e_sim_card_type
+{
+   sim_card_bmp,
+   sim_card_wav,
+   sim_card_animation
+
+} e_sim_card_type;
+
+typedef struct t_sim_card_file
+{
+   e_sim_card_type type;
+   uint8_t identifier[5];
+   const char *name; //In /assets when the card has a FAT32 volume
+
+} t_sim_card_file;
+
+/*
+****************************************************
+************* File-Static Variables ****************
+****************************************************
+*/
+
+//Identifiers and names copied from file_list in microsd.c, same order as enum_sd_file_list.h
+static const t_sim_card_file card_files[] =
+{
+   {sim_card_bmp, {0x00, 0x00, 0x00, 0x00, 0x00}, NULL},
+   {sim_card_wav, {0x25, 0x78, 0x99, 0x1B, 0x65}, "company_audio.wav"},
+   {sim_card_bmp, {0x25, 0x78, 0x99, 0x1B, 0x66}, "company_image.bmp"},
+   {sim_card_wav, {0x42, 0x7A, 0x97, 0x8D, 0x99}, "menu_button_audio.wav"},
+   {sim_card_bmp, {0x11, 0x03, 0x35, 0xBD, 0xF8}, "homescreen_picture.bmp"},
+   {sim_card_bmp, {0x58, 0x48, 0xD0, 0x5F, 0x00}, "startup_animation_0.bmp"},
+   {sim_card_bmp, {0x58, 0x48, 0xD0, 0x5F, 0x01}, "startup_animation_1.bmp"},
+   {sim_card_bmp, {0x58, 0x48, 0xD0, 0x5F, 0x02}, "startup_animation_2.bmp"},
+   {sim_card_bmp, {0x58, 0x48, 0xD0, 0x5F, 0x03}, "startup_animation_3.bmp"},
+   {sim_card_bmp, {0x58, 0x48, 0xD0, 0x5F, 0x04}, "startup_animation_4.bmp"},
+   {sim_card_bmp, {0x58, 0x48, 0xD0, 0x5F, 0x05}, "startup_animation_5.bmp"},
+   {sim_card_bmp, {0x58, 0x48, 0xD0, 0x5F, 0x06}, "startup_animation_6.bmp"},
+   {sim_card_bmp, {0x58, 0x48, 0xD0, 0x5F, 0x07}, "startup_animation_7.bmp"},
+   {sim_card_bmp, {0x58, 0x48, 0xD0, 0x5F, 0x08}, "startup_animation_8.bmp"},
+   {sim_card_bmp, {0x58, 0x48, 0xD0, 0x5F, 0x09}, "startup_animation_9.bmp"},
+   {sim_card_bmp, {0x58, 0x48, 0xD0, 0x5F, 0x0A}, "startup_animation_10.bmp"},
+   {sim_card_bmp, {0x58, 0x48, 0xD0, 0x5F, 0x0B}, "startup_animation_11.bmp"},
+   {sim_card_bmp, {0x58, 0x48, 0xD0, 0x5F, 0x0C}, "startup_animation_12.bmp"},
+   {sim_card_bmp, {0x15, 0x75, 0x26, 0x54, 0xC4}, "person1_large.bmp"},
+   {sim_card_bmp, {0x18, 0x91, 0xBA, 0xDC, 0x00}, "person1_small_pressed.bmp"},
+   {sim_card_bmp, {0x25, 0x51, 0x22, 0xDF, 0xD6}, "person1_small_not_pressed.bmp"},
+   {sim_card_bmp, {0x55, 0x68, 0x79, 0x53, 0x25}, "person3_large.bmp"},
+   {sim_card_bmp, {0x89, 0x28, 0xCD, 0xF9, 0x33}, "person3_small_pressed.bmp"},
+   {sim_card_bmp, {0x78, 0x98, 0xD9, 0x6B, 0x58}, "person3_small_not_pressed.bmp"},
+   {sim_card_bmp, {0xDF, 0x34, 0x97, 0xAC, 0x00}, "person2_large.bmp"},
+   {sim_card_bmp, {0xEA, 0xCB, 0x59, 0x56, 0x25}, "person2_small_pressed.bmp"},
+   {sim_card_bmp, {0xBE, 0x52, 0x32, 0x87, 0x62}, "person2_small_not_pressed.bmp"},
+   {sim_card_bmp, {0x62, 0x55, 0x20, 0x99, 0x01}, "person4_large.bmp"},
+   {sim_card_bmp, {0x62, 0x55, 0x20, 0x99, 0x02}, "person4_small_pressed.bmp"},
+   {sim_card_bmp, {0x62, 0x55, 0x20, 0x99, 0x03}, "person4_small_not_pressed.bmp"},
+   {sim_card_bmp, {0x54, 0x99, 0x98, 0x75, 0x00}, "aaron_large.bmp"},
+   {sim_card_bmp, {0xDF, 0xA3, 0x77, 0x86, 0x51}, "github_logo_light.bmp"},
+   {sim_card_bmp, {0xDF, 0xA3, 0x77, 0x86, 0x50}, "github_logo.bmp"},
+   {sim_card_bmp, {0x65, 0x4D, 0x6F, 0x45, 0x80}, "linkedin_logo.bmp"},
+   {sim_card_bmp, {0xDA, 0x52, 0x55, 0x96, 0xD0}, "skills_arm.bmp"},
+   {sim_card_bmp, {0x65, 0x20, 0x02, 0x02, 0x98}, "skills_circuit.bmp"},
+   {sim_card_bmp, {0x58, 0xAD, 0xFD, 0xFC, 0x54}, "skills_c.bmp"},
+   {sim_card_bmp, {0xEC, 0x89, 0x81, 0x16, 0x51}, "skills_equipment.bmp"},
+   {sim_card_bmp, {0x65, 0x18, 0x9D, 0xAF, 0x10}, "skills_pcb.bmp"},
+   {sim_card_bmp, {0x55, 0x5D, 0x5A, 0xF5, 0x15}, "skills_solder.bmp"},
+   {sim_card_bmp, {0x56, 0x72, 0x93, 0x05, 0xDF}, "slide_portfolio_acq_adc.bmp"},
+   {sim_card_bmp, {0xAB, 0x99, 0x8B, 0xE0, 0x00}, "slide_portfolio_acq_bode.bmp"},
+   {sim_card_bmp, {0xBE, 0xA0, 0x92, 0x34, 0x80}, "slide_portfolio_acq_breadboard.bmp"},
+   {sim_card_bmp, {0x98, 0x45, 0x60, 0x98, 0x45}, "slide_portfolio_acq_gui.bmp"},
+   {sim_card_bmp, {0x00, 0x78, 0x50, 0x65, 0x40}, "slide_portfolio_acq_filter.bmp"},
+   {sim_card_bmp, {0x21, 0x54, 0x55, 0x41, 0x25}, "slide_portfolio_acq_memory.bmp"},
+   {sim_card_bmp, {0x65, 0x74, 0x88, 0x77, 0x45}, "slide_portfolio_fobo_code.bmp"},
+   {sim_card_bmp, {0x20, 0x50, 0x40, 0x55, 0x01}, "slide_portfolio_fobo_standing.bmp"},
+   {sim_card_bmp, {0xEE, 0x65, 0x94, 0xE5, 0x00}, "slide_portfolio_fobo_fritzing.bmp"},
+   {sim_card_bmp, {0x01, 0x10, 0x25, 0x80, 0xFF}, "slide_portfolio_fobo_leg.bmp"},
+   {sim_card_bmp, {0x76, 0x45, 0x65, 0x4E, 0x0F}, "slide_portfolio_tamogatchi_code.bmp"},
+   {sim_card_bmp, {0x31, 0x25, 0x61, 0x10, 0x01}, "slide_portfolio_tamogatchi_case.bmp"},
+   {sim_card_bmp, {0x98, 0x45, 0x25, 0x20, 0x00}, "slide_portfolio_tamogatchi_pcb3D.bmp"},
+   {sim_card_bmp, {0x87, 0x95, 0x22, 0x54, 0x20}, "slide_portfolio_tamogatchi_pcbactual.bmp"},
+   {sim_card_bmp, {0xAA, 0xBE, 0xF1, 0x58, 0x50}, "slide_portfolio_tamogatchi_perf.bmp"},
+   {sim_card_bmp, {0xBA, 0xC0, 0x09, 0x82, 0x80}, "slide_portfolio_other_candy_main.bmp"},
+   {sim_card_bmp, {0x04, 0x05, 0x50, 0x56, 0x44}, "slide_portfolio_other_candy_minor.bmp"},
+   {sim_card_bmp, {0x00, 0x07, 0x8B, 0xEF, 0xA0}, "slide_portfolio_other_workshop.bmp"},
+   {sim_card_bmp, {0x51, 0x56, 0x16, 0x51, 0x21}, "slide_portfolio_other_UA741.bmp"},
+   {sim_card_bmp, {0x65, 0x1F, 0xCA, 0x58, 0x00}, "slide_portfolio_other_recorder.bmp"},
+   {sim_card_wav, {0x63, 0x49, 0x53, 0x83, 0x63}, "portfolio_fobo1_audio.wav"},
+   {sim_card_wav, {0x42, 0x41, 0x48, 0x50, 0x47}, "portfolio_fobo2_audio.wav"},
+   {sim_card_wav, {0x37, 0x47, 0x57, 0x69, 0x96}, "portfolio_fobo3_audio.wav"},
+   {sim_card_wav, {0x71, 0x70, 0x84, 0x78, 0x99}, "portfolio_fobo4_audio.wav"},
+   {sim_card_wav, {0x39, 0x38, 0x75, 0x80, 0x35}, "portfolio_gameboard1_audio.wav"},
+   {sim_card_wav, {0x45, 0x54, 0x64, 0x46, 0x97}, "portfolio_gameboard2_audio.wav"},
+   {sim_card_wav, {0x55, 0x53, 0x72, 0x32, 0x23}, "portfolio_gameboard3_audio.wav"},
+   {sim_card_wav, {0x82, 0x28, 0xA6, 0x4F, 0x76}, "portfolio_gameboard4_audio.wav"},
+   {sim_card_wav, {0x67, 0x54, 0x25, 0x9B, 0x4B}, "portfolio_gameboard5_audio.wav"},
+   {sim_card_wav, {0x76, 0x72, 0x65, 0x89, 0x91}, "portfolio_data1_audio.wav"},
+   {sim_card_wav, {0x72, 0x66, 0x59, 0x45, 0x77}, "portfolio_data2_audio.wav"},
+   {sim_card_wav, {0x88, 0x78, 0x56, 0x6E, 0x6F}, "portfolio_data3_audio.wav"},
+   {sim_card_wav, {0x55, 0x80, 0x90, 0x91, 0x85}, "portfolio_data4_audio.wav"},
+   {sim_card_wav, {0x69, 0x77, 0x88, 0x99, 0x40}, "portfolio_data5_audio.wav"},
+   {sim_card_wav, {0x46, 0x49, 0x88, 0x59, 0x95}, "portfolio_data6_audio.wav"},
+   {sim_card_wav, {0x7D, 0x80, 0x7B, 0x76, 0x79}, "portfolio_candymain_audio.wav"},
+   {sim_card_wav, {0x80, 0x7B, 0x76, 0x81, 0x7D}, "portfolio_candy3D_audio.wav"},
+   {sim_card_wav, {0x81, 0x75, 0x7B, 0x72, 0x73}, "portfolio_workshop_audio.wav"},
+   {sim_card_wav, {0x72, 0x70, 0x82, 0x70, 0x73}, "portfolio_ua741_audio.wav"},
+   {sim_card_wav, {0x71, 0x72, 0x78, 0x74, 0x84}, "portfolio_voice_audio.wav"},
+   {sim_card_bmp, {0xEC, 0xB3, 0x51, 0x65, 0x50}, "languages_main_screen.bmp"},
+   {sim_card_wav, {0x01, 0x28, 0x15, 0x72, 0x02}, "german_audio.wav"},
+   {sim_card_wav, {0x01, 0x28, 0x15, 0x72, 0x03}, "spanish_audio.wav"},
+   {sim_card_bmp, {0x01, 0x28, 0x15, 0x72, 0x04}, "german_image.bmp"},
+   {sim_card_bmp, {0x01, 0x28, 0x15, 0x72, 0x05}, "spanish_image.bmp"},
+   {sim_card_bmp, {0x58, 0x45, 0x56, 0x45, 0x22}, "about_me_main_menu.bmp"},
+   {sim_card_bmp, {0x68, 0x55, 0x98, 0x45, 0x00}, "about_me_main_education.bmp"},
+   {sim_card_bmp, {0xAD, 0x5A, 0x20, 0x10, 0x30}, "about_me_main_goals.bmp"},
+   {sim_card_bmp, {0x50, 0x90, 0x19, 0x68, 0xB0}, "about_me_main_hobbies.bmp"},
+   {sim_card_bmp, {0x90, 0x08, 0x55, 0x46, 0xBC}, "about_me_main_interests.bmp"},
+   {sim_card_bmp, {0xBD, 0xEF, 0x25, 0x45, 0x50}, "about_me_main_experience.bmp"},
+   {sim_card_bmp, {0x48, 0x51, 0x1B, 0x56, 0x56}, "about_me_sub_education.bmp"},
+   {sim_card_bmp, {0x05, 0x78, 0xB0, 0x66, 0x30}, "about_me_sub_goals.bmp"},
+   {sim_card_bmp, {0xCD, 0x0B, 0xE5, 0x98, 0x80}, "about_me_sub_hobbies.bmp"},
+   {sim_card_bmp, {0x56, 0x89, 0x5A, 0x55, 0xD8}, "about_me_sub_interests.bmp"},
+   {sim_card_bmp, {0x01, 0xA0, 0xB0, 0xD5, 0x4D}, "about_me_sub_experience.bmp"},
+   {sim_card_bmp, {0x85, 0x71, 0x52, 0x33, 0x00}, "slide_device_intro_drawing.bmp"},
+   {sim_card_bmp, {0x85, 0x71, 0x52, 0x33, 0x01}, "slide_device_intro_model.bmp"},
+   {sim_card_bmp, {0x85, 0x71, 0x52, 0x33, 0x02}, "slide_device_mechanical_prototype.bmp"},
+   {sim_card_bmp, {0x85, 0x71, 0x52, 0x33, 0x03}, "slide_device_mechanical_final.bmp"},
+   {sim_card_bmp, {0x85, 0x71, 0x52, 0x33, 0x0E}, "slide_device_mechanical_processing.bmp"},
+   {sim_card_bmp, {0x85, 0x71, 0x52, 0x33, 0x04}, "slide_device_hardware_schematic.bmp"},
+   {sim_card_bmp, {0x85, 0x71, 0x52, 0x33, 0x05}, "slide_device_hardware_layout.bmp"},
+   {sim_card_bmp, {0x85, 0x71, 0x52, 0x33, 0x06}, "slide_device_hardware_PCB.bmp"},
+   {sim_card_bmp, {0x85, 0x71, 0x52, 0x33, 0x07}, "slide_device_hardware_solder.bmp"},
+   {sim_card_bmp, {0x85, 0x71, 0x52, 0x33, 0x08}, "slide_device_hardware_firmware.bmp"},
+   {sim_card_bmp, {0x85, 0x71, 0x52, 0x33, 0x09}, "slide_device_hardware_jig.bmp"},
+   {sim_card_bmp, {0x85, 0x71, 0x52, 0x33, 0x0A}, "slide_device_product_photo.bmp"},
+   {sim_card_bmp, {0x85, 0x71, 0x52, 0x33, 0x0B}, "slide_device_product_box.bmp"},
+   {sim_card_bmp, {0x85, 0x71, 0x52, 0x33, 0x0C}, "slide_device_product_foam.bmp"},
+   {sim_card_bmp, {0x85, 0x71, 0x52, 0x33, 0x0D}, "slide_device_product_manual.bmp"},
+   {sim_card_wav, {0x66, 0x25, 0x91, 0x88, 0x00}, "device_start1_audio.wav"},
+   {sim_card_wav, {0x66, 0x25, 0x91, 0x88, 0x01}, "device_start2_audio.wav"},
+   {sim_card_wav, {0x66, 0x25, 0x91, 0x88, 0x02}, "device_mechanical1_audio.wav"},
+   {sim_card_wav, {0x66, 0x25, 0x91, 0x88, 0x03}, "device_mechanical2_audio.wav"},
+   {sim_card_wav, {0x66, 0x25, 0x91, 0x88, 0x04}, "device_mechanical3_audio.wav"},
+   {sim_card_wav, {0x66, 0x25, 0x91, 0x88, 0x05}, "device_hwfw1_audio.wav"},
+   {sim_card_wav, {0x66, 0x25, 0x91, 0x88, 0x06}, "device_hwfw2_audio.wav"},
+   {sim_card_wav, {0x66, 0x25, 0x91, 0x88, 0x07}, "device_hwfw3_audio.wav"},
+   {sim_card_wav, {0x66, 0x25, 0x91, 0x88, 0x08}, "device_hwfw4_audio.wav"},
+   {sim_card_wav, {0x66, 0x25, 0x91, 0x88, 0x09}, "device_hwfw5_audio.wav"},
+   {sim_card_wav, {0x66, 0x25, 0x91, 0x88, 0x0A}, "device_hwfw6_audio.wav"},
+   {sim_card_wav, {0x66, 0x25, 0x91, 0x88, 0x0B}, "device_product1_audio.wav"},
+   {sim_card_wav, {0x66, 0x25, 0x91, 0x88, 0x0C}, "device_product2_audio.wav"},
+   {sim_card_wav, {0x66, 0x25, 0x91, 0x88, 0x0D}, "device_product3_audio.wav"},
+   {sim_card_wav, {0x66, 0x25, 0x91, 0x88, 0x0E}, "device_product4_audio.wav"},
+   {sim_card_wav, {0x01, 0x28, 0x15, 0x72, 0x01}, "intro_audio.wav"},
+   {sim_card_animation, {0x58, 0x48, 0xD0, 0x5F, 0x0D}, "startup_animation_delta.r565a"},
+};
+
+static_assert((sizeof(card_files) / sizeof(card_files[0])) == max_total_addresses,
+              "card_files must list every entry of enum_sd_file_list.h");
+
+static std::map<uint32_t, std::array<uint8_t, 512>> written_blocks;
+static uint8_t startup_flag = 1;
+static uint8_t rgb565_images = 1; //Images as converted by bmp_to_rgb565, 0 = original 24-bit BMPs
+static uint8_t compressed_images = 0; //Images as converted by bmp_to_rgb565 --compress, overrides rgb565_images
+static uint8_t interlaced_images = 0; //Images as converted by bmp_to_rgb565 --interlace, overrides rgb565_images
+static std::map<uint32_t, std::vector<uint8_t>> compressed_files; //Whole files, built on first read
+static std::vector<uint8_t> animation_file; //startup_animation_delta, built on first read
+static uint8_t packed_files = 0; //Files back to back on the card instead of one per SIM_CARD_ASSET_SLOT
+static std::vector<uint32_t> packed_starts; //Start block of each file and the end of the last, see sim_card_packed_layout()
+static int packed_formats = -1; //Image formats packed_starts was worked out for
+static uint8_t fat32_volume = 0; //Files also listed in /assets of a FAT32 volume
+static uint8_t address_only_table = 0; //Cheat sheet as written before sizes and types were stored
+static uint8_t blank_table = 0; //Cheat sheet blocks read as zeros, the card was never indexed
+static uint32_t card_capacity = 0; //Blocks on the card, 0 = reads never run out
+
+/*
+****************************************************
+********** Private Function Prototypes *************
+****************************************************
+*/
+static uint16_t sim_card_image_width(uint32_t asset);
+static uint16_t sim_card_image_rows(uint32_t asset);
+static uint32_t sim_card_file_bytes(uint32_t asset);
+static uint32_t sim_card_file_blocks(uint32_t asset);
+static void sim_card_packed_layout(void);
+static void sim_card_bmp_block(uint32_t asset, uint32_t block_offset, uint8_t *p_buffer);
+static void sim_card_rgb565_block(uint32_t asset, uint32_t block_offset, uint8_t *p_buffer);
+static void sim_card_rgb565q_block(uint32_t asset, uint32_t block_offset, uint8_t *p_buffer);
+static void sim_card_rgb565i_block(uint32_t asset, uint32_t block_offset, uint8_t *p_buffer);
+static void sim_card_animation_block(uint32_t asset, uint32_t block_offset, uint8_t *p_buffer);
+static void sim_card_bmp_header(uint32_t asset, uint8_t *p_buffer);
+static uint8_t sim_card_bmp_channel(uint32_t asset, uint32_t pixel, uint32_t channel);
+static uint8_t sim_card_spinner_level(uint32_t frame, uint32_t x, uint32_t y);
+static void sim_card_wav_block(uint32_t asset, uint32_t block_offset, uint8_t *p_buffer);
+static uint32_t sim_card_wav_blocks(uint32_t asset);
+static void sim_card_cheat_sheet(uint8_t *p_table);
+static void sim_card_volume_block(uint32_t block, uint8_t *p_buffer);
+static uint32_t sim_card_fat_entry(uint32_t cluster);
+static void sim_card_assets_directory(std::vector<uint8_t> &directory);
+static void sim_card_directory_entry(uint8_t *p_entry, const char *p_short_name, uint8_t attributes, uint32_t cluster, uint32_t size);
+static void sim_card_put_uint16(uint8_t *p_bytes, uint16_t value);
+static void sim_card_put_uint32(uint8_t *p_bytes, uint32_t value);
+
+/*
+****************************************************
+********** Public Function Definitions *************
+****************************************************
+*/
+
+/*!
+* @brief Formats the simulated card
+* @param[in] first_boot 1 = the introduction popup has never been dismissed
+* @return NONE
+*/
+void
+sim_card_init(uint8_t first_boot)
+{
+   written_blocks.clear();
+   startup_flag = first_boot ? 0 : 1;
+}
+
+
+/*!
+* @brief Selects how image files are stored. Can be changed at any time, blocks are
+*        generated when they are read
+* @param[in] enable 1 = RGB565 container, 0 = 24-bit BMP
+* @return NONE
+*/
+void
+sim_card_set_rgb565_images(uint8_t enable)
+{
+   rgb565_images = enable;
+}
+
+
+/*!
+* @brief Selects whether image files are stored in the compressed RGB565 container. Can be
+*        changed at any time
+* @param[in] enable 1 = compressed, 0 = as selected by sim_card_set_rgb565_images()
+* @return NONE
+*/
+void
+sim_card_set_compressed_images(uint8_t enable)
+{
+   compressed_images = enable;
+}
+
+
+/*!
+* @brief Selects whether image files are stored in the interlaced RGB565 container, as tall as
+*        they are drawn. Can be changed at any time
+* @param[in] enable 1 = interlaced, 0 = as selected by sim_card_set_rgb565_images()
+* @return NONE
+*/
+void
+sim_card_set_interlaced_images(uint8_t enable)
+{
+   interlaced_images = enable;
+}
+
+
+/*!
+* @brief Selects whether files follow each other on the card, the way a freshly formatted
+*        card is filled, instead of each starting a slot of SIM_CARD_ASSET_SLOT blocks. Images
+*        are then only as tall as they are drawn. Addresses change, so set it before they are
+*        looked up
+* @param[in] enable 1 = back to back, 0 = slots
+* @return NONE
+*/
+void
+sim_card_set_packed_files(uint8_t enable)
+{
+   //Compressed files are coded for the rows drawn when packed
+   if(packed_files != enable)
+   {
+      compressed_files.clear();
+   }
+
+   packed_files = enable;
+}
+
+
+/*!
+* @brief Selects whether the card also has a FAT32 volume listing every file by name in
+*        /assets, the way a card the files were copied to from a PC does. The files stay in
+*        their slots, so it has no effect while files are packed
+* @param[in] enable 1 = FAT32 volume, 0 = raw blocks only, found through the cheat sheet
+* @return NONE
+*/
+void
+sim_card_set_fat32_volume(uint8_t enable)
+{
+   fat32_volume = enable;
+}
+
+
+/*!
+* @brief Selects the cheat sheet format
+* @param[in] enable 1 = addresses only, so the firmware reads each WAV header for its size,
+*                   0 = addresses, sizes and types
+* @return NONE
+*/
+void
+sim_card_set_address_only_table(uint8_t enable)
+{
+   address_only_table = enable;
+}
+
+
+/*!
+* @brief Leaves the cheat sheet out, as on a card the files were only copied to
+* @param[in] enable 1 = both cheat sheet blocks read as zeros, 0 = cheat sheet as selected above
+* @return NONE
+*/
+void
+sim_card_set_blank_table(uint8_t enable)
+{
+   blank_table = enable;
+}
+
+
+/*!
+* @brief Makes the card end after a number of blocks, so reads past it fail
+* @param[in] blocks 0 = no end
+* @return NONE
+*/
+void
+sim_card_set_capacity(uint32_t blocks)
+{
+   card_capacity = blocks;
+}
+
+
+/*!
+* @brief Whether a block is on the card, see sim_card_set_capacity()
+* @param[in] block Block address
+* @return 1 if it can be read
+*/
+uint8_t
+sim_card_has_block(uint32_t block)
+{
+   return((0 == card_capacity) || (block < card_capacity));
+}
+
+
+/*!
+* @brief The 5 bytes the firmware searches the card for to find a file
+* @param[in] asset Entry of e_sd_address
+* @return Identifier, the same as in file_list
+*/
+const uint8_t *
+sim_card_asset_identifier(uint32_t asset)
+{
+   return(card_files[asset].identifier);
+}
+
+
+/*!
+* @brief Start block of a file on the simulated card
+* @param[in] asset Entry of e_sd_address
+* @return Block address, 0 for null_address
+*/
+uint32_t
+sim_card_asset_address(uint32_t asset)
+{
+   if((null_address == asset) || (max_total_addresses <= asset))
+   {
+      return(0);
+   }
+
+   if(packed_files)
+   {
+      sim_card_packed_layout();
+      return(packed_starts[asset]);
+   }
+
+   return(SIM_CARD_ASSET_BASE + (asset * SIM_CARD_ASSET_SLOT));
+}
+
+
+/*!
+* @brief Produces the contents of one 512-byte block
+* @param[in] block Block address
+* @param[in] p_buffer Receives 512 bytes
+* @return NONE
+*/
+void
+sim_card_read(uint32_t block, uint8_t *p_buffer)
+{
+   auto written = written_blocks.find(block);
+
+   if(written_blocks.end() != written)
+   {
+      memcpy(p_buffer, written->second.data(), 512);
+      return;
+   }
+
+   memset(p_buffer, 0, 512);
+
+   if((SIM_CARD_CHEAT_SHEET == block) || ((SIM_CARD_CHEAT_SHEET + 1) == block))
+   {
+      uint8_t table[1024] = {0};
+
+      if(!blank_table)
+      {
+         sim_card_cheat_sheet(table);
+      }
+
+      //The second block starts at byte 511 of the table, see sd_search_file_addresses()
+      memcpy(p_buffer, table + ((SIM_CARD_CHEAT_SHEET == block) ? 0 : 511), 512);
+   }
+
+   else if(SIM_CARD_STARTUP_FLAG == block)
+   {
+      p_buffer[0] = startup_flag;
+   }
+
+   else if(fat32_volume && !packed_files && (SIM_CARD_ASSET_BASE > block))
+   {
+      sim_card_volume_block(block, p_buffer);
+   }
+
+   else if((SIM_CARD_ASSET_BASE + SIM_CARD_ASSET_SLOT) <= block)
+   {
+      uint32_t asset = (block - SIM_CARD_ASSET_BASE) / SIM_CARD_ASSET_SLOT;
+      uint32_t block_offset = (block - SIM_CARD_ASSET_BASE) % SIM_CARD_ASSET_SLOT;
+
+      if(packed_files)
+      {
+         //Last file starting at or before the block
+         sim_card_packed_layout();
+         asset = (std::upper_bound(packed_starts.begin(), packed_starts.end(), block) - packed_starts.begin()) - 1;
+         block_offset = block - packed_starts[asset];
+      }
+
+      if(max_total_addresses > asset)
+      {
+         if(sim_card_wav == card_files[asset].type)
+         {
+            sim_card_wav_block(asset, block_offset, p_buffer);
+         }
+
+         else if(sim_card_animation == card_files[asset].type)
+         {
+            sim_card_animation_block(asset, block_offset, p_buffer);
+         }
+
+         else if(compressed_images)
+         {
+            sim_card_rgb565q_block(asset, block_offset, p_buffer);
+         }
+
+         else if(interlaced_images)
+         {
+            sim_card_rgb565i_block(asset, block_offset, p_buffer);
+         }
+
+         else if(rgb565_images)
+         {
+            sim_card_rgb565_block(asset, block_offset, p_buffer);
+         }
+
+         else
+         {
+            sim_card_bmp_block(asset, block_offset, p_buffer);
+         }
+      }
+   }
+}
+
+
+/*!
+* @brief Stores a block written by the firmware
+* @param[in] block Block address
+* @param[in] p_buffer 512 bytes
+* @return NONE
+*/
+void
+sim_card_write(uint32_t block, const uint8_t *p_buffer)
+{
+   std::array<uint8_t, 512> data;
+
+   memcpy(data.data(), p_buffer, 512);
+   written_blocks[block] = data;
+}
+
+
+/*
+****************************************************
+********** Private Function Definitions ************
+****************************************************
+*/
+
+/*!
+* @brief Row width in pixels of each image, as drawn by gui.c and states.c
+*/
+static uint16_t
+sim_card_image_width(uint32_t asset)
+{
+   switch(asset)
+   {
+   case startup_animation_12:
+      return(268);
+
+   case person1_small_pressed: case person1_small_not_pressed:
+   case person2_small_pressed: case person2_small_not_pressed:
+   case person3_small_pressed: case person3_small_not_pressed:
+   case person4_small_pressed: case person4_small_not_pressed:
+   case about_me_main_education:
+      return(72);
+
+   case github_logo_light: case github_logo: case linkedin_logo:
+   case skills_arm: case skills_circuit: case skills_c:
+   case skills_equipment: case skills_pcb: case skills_solder:
+      return(32);
+
+   case about_me_main_goals:
+      return(40);
+
+   case about_me_main_hobbies:
+      return(104);
+
+   case about_me_main_interests:
+      return(80);
+
+   case about_me_main_experience:
+      return(280);
+
+   default:
+      return((((startup_animation_0 <= asset) && (startup_animation_11 >= asset)) || (startup_animation_delta == asset)) ? 136 : 320);
+   }
+}
+
+
+/*!
+* @brief Rows of each image as drawn by gui.c and states.c. The pixels do not depend on it,
+*        it sizes the files when they are packed back to back and the interlaced ones
+*/
+static uint16_t
+sim_card_image_rows(uint32_t asset)
+{
+   switch(asset)
+   {
+   case startup_animation_12:
+      return(40);
+
+   case person1_small_pressed: case person1_small_not_pressed:
+   case person2_small_pressed: case person2_small_not_pressed:
+   case person3_small_pressed: case person3_small_not_pressed:
+   case person4_small_pressed: case person4_small_not_pressed:
+      return(70);
+
+   case github_logo_light: case linkedin_logo:
+      return(32);
+
+   case skills_arm: case skills_circuit: case skills_c:
+   case skills_equipment: case skills_pcb: case skills_solder:
+   case github_logo: //Last icon of the skills list
+      return(40);
+
+   case about_me_main_education:
+      return(50);
+
+   case about_me_main_goals:
+      return(106);
+
+   case about_me_main_hobbies:
+      return(120);
+
+   case about_me_main_interests:
+      return(76);
+
+   case about_me_main_experience:
+      return(64);
+
+   default:
+      break;
+   }
+
+   if((startup_animation_0 <= asset) && (startup_animation_11 >= asset))
+   {
+      return(SIM_CARD_ANIMATION_ROWS);
+   }
+
+   if(((slide_portfolio_acq_adc <= asset) && (slide_portfolio_other_recorder >= asset)) ||
+      ((slide_device_intro_drawing <= asset) && (slide_device_product_manual >= asset)))
+   {
+      return(SIM_CARD_SLIDE_ROWS);
+   }
+
+   return(SIM_CARD_IMAGE_ROWS);
+}
+
+
+/*!
+* @brief Size of a file in the image format currently selected
+*/
+static uint32_t
+sim_card_file_bytes(uint32_t asset)
+{
+   uint8_t scratch[512];
+
+   if(sim_card_wav == card_files[asset].type)
+   {
+      return((sim_card_wav_blocks(asset) * 512) + 8); //RIFF size plus the "RIFF" tag and the size itself
+   }
+
+   else if(sim_card_animation == card_files[asset].type)
+   {
+      sim_card_animation_block(asset, 0, scratch); //Builds animation_file
+      return(animation_file.size());
+   }
+
+   else if(compressed_images)
+   {
+      sim_card_rgb565q_block(asset, 0, scratch); //Builds the file
+      return(compressed_files[asset].size());
+   }
+
+   return(SIM_CARD_BMP_DATA_OFFSET + ((uint32_t)sim_card_image_width(asset) * sim_card_image_rows(asset) * ((rgb565_images || interlaced_images) ? 2 : 3)));
+}
+
+
+/*!
+* @brief Blocks taken by a file in the image format currently selected
+*/
+static uint32_t
+sim_card_file_blocks(uint32_t asset)
+{
+   if(sim_card_wav == card_files[asset].type)
+   {
+      return(sim_card_wav_blocks(asset));
+   }
+
+   return((sim_card_file_bytes(asset) + 511) / 512);
+}
+
+
+/*!
+* @brief Works out where each file starts when they are packed back to back, in the order of
+*        enum_sd_file_list.h from where the slot of the first one starts. Redone when the
+*        image format changes, since it changes the file sizes
+*/
+static void
+sim_card_packed_layout(void)
+{
+   int formats = (interlaced_images << 2) | (compressed_images << 1) | rgb565_images;
+
+   if(formats == packed_formats)
+   {
+      return;
+   }
+
+   packed_formats = formats;
+   packed_starts.assign(max_total_addresses + 1, SIM_CARD_ASSET_BASE);
+   packed_starts[1] = SIM_CARD_ASSET_BASE + SIM_CARD_ASSET_SLOT;
+
+   for(uint32_t asset = 1; asset < max_total_addresses; asset++)
+   {
+      packed_starts[asset + 1] = packed_starts[asset] + sim_card_file_blocks(asset);
+   }
+}
+
+
+/*!
+* @brief BMP slot: 54-byte header, identifier in the gap before the data offset, then BGR
+*        pixels of a per-file gradient with a one pixel frame
+*/
+static void
+sim_card_bmp_block(uint32_t asset, uint32_t block_offset, uint8_t *p_buffer)
+{
+   uint32_t first_byte = block_offset * 512;
+
+   for(uint32_t current_byte = 0; current_byte < 512; current_byte++)
+   {
+      uint32_t file_byte = first_byte + current_byte;
+
+      if(SIM_CARD_BMP_DATA_OFFSET > file_byte)
+      {
+         continue;
+      }
+
+      p_buffer[current_byte] = sim_card_bmp_channel(asset, (file_byte - SIM_CARD_BMP_DATA_OFFSET) / 3,
+                                                    (file_byte - SIM_CARD_BMP_DATA_OFFSET) % 3);
+   }
+
+   if(0 == block_offset)
+   {
+      sim_card_bmp_header(asset, p_buffer);
+   }
+}
+
+
+/*!
+* @brief The same image run through bmp_to_rgb565: BMP header with the "R5" signature and
+*        16 bits per pixel, then big-endian RGB565 pixels in BMP order
+*/
+static void
+sim_card_rgb565_block(uint32_t asset, uint32_t block_offset, uint8_t *p_buffer)
+{
+   uint32_t first_byte = block_offset * 512;
+
+   for(uint32_t current_byte = 0; current_byte < 512; current_byte++)
+   {
+      uint32_t file_byte = first_byte + current_byte;
+
+      if(SIM_CARD_BMP_DATA_OFFSET > file_byte)
+      {
+         continue;
+      }
+
+      uint32_t pixel = (file_byte - SIM_CARD_BMP_DATA_OFFSET) / 2;
+      uint16_t pixel_value = rgb565_from_bgr(sim_card_bmp_channel(asset, pixel, 0), sim_card_bmp_channel(asset, pixel, 1),
+                                             sim_card_bmp_channel(asset, pixel, 2));
+
+      p_buffer[current_byte] = (0 == ((file_byte - SIM_CARD_BMP_DATA_OFFSET) % 2)) ? (uint8_t)(pixel_value >> 8)
+                                                                                    : (uint8_t)pixel_value;
+   }
+
+   if(0 == block_offset)
+   {
+      sim_card_bmp_header(asset, p_buffer);
+      p_buffer[0] = RGB565_SIGNATURE_0;
+      p_buffer[1] = RGB565_SIGNATURE_1;
+      p_buffer[SIM_CARD_BMP_BPP_OFFSET] = 16;
+   }
+}
+
+
+/*!
+* @brief The same image run through bmp_to_rgb565 --interlace: the RGB565 header with the "RI"
+*        signature and the height, then the rows in the order of rgb565i_interlace()
+*/
+static void
+sim_card_rgb565i_block(uint32_t asset, uint32_t block_offset, uint8_t *p_buffer)
+{
+   static const uint8_t first_row[RGB565I_PASSES] = {0, 4, 2, 1};
+   static const uint8_t row_step[RGB565I_PASSES] = {8, 8, 4, 2};
+   uint32_t width = sim_card_image_width(asset);
+   uint32_t height = sim_card_image_rows(asset);
+   uint32_t first_byte = block_offset * 512;
+
+   for(uint32_t current_byte = 0; current_byte < 512; current_byte++)
+   {
+      uint32_t file_byte = first_byte + current_byte;
+
+      if(SIM_CARD_BMP_DATA_OFFSET > file_byte)
+      {
+         continue;
+      }
+
+      uint32_t file_pixel = (file_byte - SIM_CARD_BMP_DATA_OFFSET) / 2;
+      uint32_t file_row = file_pixel / width;
+
+      if(file_row >= height)
+      {
+         break;
+      }
+
+      //Find the pass the row is stored in
+      uint32_t row = 0;
+
+      for(uint8_t pass = 0; pass < RGB565I_PASSES; pass++)
+      {
+         uint32_t pass_rows = (height + row_step[pass] - 1 - first_row[pass]) / row_step[pass];
+
+         if(file_row < pass_rows)
+         {
+            row = first_row[pass] + (file_row * row_step[pass]);
+            break;
+         }
+
+         file_row -= pass_rows;
+      }
+
+      uint32_t pixel = (row * width) + (file_pixel % width);
+      uint16_t pixel_value = rgb565_from_bgr(sim_card_bmp_channel(asset, pixel, 0), sim_card_bmp_channel(asset, pixel, 1),
+                                             sim_card_bmp_channel(asset, pixel, 2));
+
+      p_buffer[current_byte] = (0 == ((file_byte - SIM_CARD_BMP_DATA_OFFSET) % 2)) ? (uint8_t)(pixel_value >> 8)
+                                                                                    : (uint8_t)pixel_value;
+   }
+
+   if(0 == block_offset)
+   {
+      sim_card_bmp_header(asset, p_buffer);
+      p_buffer[0] = RGB565I_SIGNATURE_0;
+      p_buffer[1] = RGB565I_SIGNATURE_1;
+      p_buffer[SIM_CARD_BMP_BPP_OFFSET] = 16;
+      p_buffer[SIM_CARD_BMP_HEIGHT_OFFSET] = (uint8_t)height;
+      p_buffer[SIM_CARD_BMP_HEIGHT_OFFSET + 1] = (uint8_t)(height >> 8);
+   }
+}
+
+
+/*!
+* @brief The same image run through bmp_to_rgb565 --compress: the RGB565 header with the "RQ"
+*        signature and the compressed size, then the ops decoded by lcd_drain_rgb565q()
+*/
+static void
+sim_card_rgb565q_block(uint32_t asset, uint32_t block_offset, uint8_t *p_buffer)
+{
+   std::vector<uint8_t> &file = compressed_files[asset];
+
+   if(file.empty())
+   {
+      uint32_t total_pixels = sim_card_image_width(asset) * (packed_files ? sim_card_image_rows(asset) : SIM_CARD_IMAGE_ROWS);
+      std::vector<uint16_t> pixels(total_pixels);
+
+      for(uint32_t current_pixel = 0; current_pixel < total_pixels; current_pixel++)
+      {
+         pixels[current_pixel] = rgb565_from_bgr(sim_card_bmp_channel(asset, current_pixel, 0), sim_card_bmp_channel(asset, current_pixel, 1),
+                                                 sim_card_bmp_channel(asset, current_pixel, 2));
+      }
+
+      file.resize(SIM_CARD_BMP_DATA_OFFSET + RGB565Q_WORST_CASE_BYTES(total_pixels));
+      uint32_t data_bytes = rgb565q_compress(pixels.data(), total_pixels, &file[SIM_CARD_BMP_DATA_OFFSET]);
+      file.resize(SIM_CARD_BMP_DATA_OFFSET + data_bytes);
+
+      sim_card_bmp_header(asset, file.data());
+      file[0] = RGB565Q_SIGNATURE_0;
+      file[1] = RGB565Q_SIGNATURE_1;
+      file[SIM_CARD_BMP_BPP_OFFSET] = 16;
+
+      for(uint8_t current_byte = 0; current_byte < 4; current_byte++)
+      {
+         file[SIM_CARD_BMP_IMAGE_SIZE_OFFSET + current_byte] = (uint8_t)(data_bytes >> (current_byte * 8));
+      }
+   }
+
+   uint32_t first_byte = block_offset * 512;
+
+   if(first_byte < file.size())
+   {
+      memcpy(p_buffer, &file[first_byte], ((file.size() - first_byte) < 512) ? (file.size() - first_byte) : 512);
+   }
+}
+
+
+/*!
+* @brief The boot animation frames run through bmp_to_rgb565 --animation: the RGB565 header
+*        with the "RA" signature and the number of pictures, then the entry table and entries
+*        read by lcd_animation_draw_next()
+*/
+static void
+sim_card_animation_block(uint32_t asset, uint32_t block_offset, uint8_t *p_buffer)
+{
+   if(animation_file.empty())
+   {
+      uint32_t width = sim_card_image_width(asset);
+      uint32_t total_pixels = width * SIM_CARD_ANIMATION_ROWS;
+      std::vector<std::vector<uint16_t>> pictures(SIM_CARD_SPINNER_DOTS, std::vector<uint16_t>(total_pixels));
+      const uint16_t *p_pictures[SIM_CARD_SPINNER_DOTS];
+
+      for(uint32_t current_picture = 0; current_picture < SIM_CARD_SPINNER_DOTS; current_picture++)
+      {
+         for(uint32_t current_pixel = 0; current_pixel < total_pixels; current_pixel++)
+         {
+            uint32_t frame = startup_animation_0 + current_picture;
+
+            pictures[current_picture][current_pixel] = rgb565_from_bgr(sim_card_bmp_channel(frame, current_pixel, 0), sim_card_bmp_channel(frame, current_pixel, 1),
+                                                                       sim_card_bmp_channel(frame, current_pixel, 2));
+         }
+
+         p_pictures[current_picture] = pictures[current_picture].data();
+      }
+
+      animation_file.resize(SIM_CARD_BMP_DATA_OFFSET + RGB565A_WORST_CASE_BYTES(SIM_CARD_SPINNER_DOTS, width, SIM_CARD_ANIMATION_ROWS));
+      uint32_t data_bytes = rgb565a_encode(p_pictures, SIM_CARD_SPINNER_DOTS, (uint16_t)width, SIM_CARD_ANIMATION_ROWS,
+                                           SIM_CARD_BMP_DATA_OFFSET, &animation_file[SIM_CARD_BMP_DATA_OFFSET]);
+      animation_file.resize(SIM_CARD_BMP_DATA_OFFSET + data_bytes);
+
+      sim_card_bmp_header(asset, animation_file.data());
+      animation_file[0] = RGB565A_SIGNATURE_0;
+      animation_file[1] = RGB565A_SIGNATURE_1;
+      animation_file[SIM_CARD_BMP_HEIGHT_OFFSET] = SIM_CARD_ANIMATION_ROWS;
+      animation_file[SIM_CARD_BMP_BPP_OFFSET] = 16;
+      animation_file[SIM_CARD_BMP_COMPRESSION_OFFSET] = SIM_CARD_SPINNER_DOTS;
+
+      for(uint8_t current_byte = 0; current_byte < 4; current_byte++)
+      {
+         animation_file[SIM_CARD_BMP_IMAGE_SIZE_OFFSET + current_byte] = (uint8_t)(data_bytes >> (current_byte * 8));
+      }
+   }
+
+   uint32_t first_byte = block_offset * 512;
+
+   if(first_byte < animation_file.size())
+   {
+      memcpy(p_buffer, &animation_file[first_byte], ((animation_file.size() - first_byte) < 512) ? (animation_file.size() - first_byte) : 512);
+   }
+}
+
+
+static void
+sim_card_bmp_header(uint32_t asset, uint8_t *p_buffer)
+{
+   uint32_t width = sim_card_image_width(asset);
+
+   memset(p_buffer, 0, SIM_CARD_BMP_DATA_OFFSET);
+   p_buffer[0] = 'B';
+   p_buffer[1] = 'M';
+   p_buffer[10] = SIM_CARD_BMP_DATA_OFFSET;
+   p_buffer[14] = 40;
+   p_buffer[18] = (uint8_t)width;
+   p_buffer[19] = (uint8_t)(width >> 8);
+   p_buffer[SIM_CARD_BMP_BPP_OFFSET] = 24;
+   memcpy(p_buffer + SIM_CARD_BMP_ID_OFFSET, card_files[asset].identifier, 5);
+}
+
+
+/*!
+* @brief One byte of a generated image
+* @param[in] asset
+* @param[in] pixel Pixel number in file order
+* @param[in] channel 0 = blue, 1 = green, 2 = red
+*/
+static uint8_t
+sim_card_bmp_channel(uint32_t asset, uint32_t pixel, uint32_t channel)
+{
+   uint32_t width = sim_card_image_width(asset);
+   uint32_t x = pixel % width;
+   uint32_t y = pixel / width;
+
+   if((0 == x) || ((width - 1) == x) || (0 == y))
+   {
+      return(0xFF);
+   }
+
+   //Boot animation frames only differ in the spinner, the rest is the first frame
+   if((startup_animation_0 <= asset) && (startup_animation_11 >= asset))
+   {
+      uint8_t level = sim_card_spinner_level(asset - startup_animation_0, x, y);
+
+      if(0 != level)
+      {
+         return(level);
+      }
+
+      asset = startup_animation_0;
+   }
+
+   else if(0 == channel) //Blue
+   {
+      return((uint8_t)((asset * 37) + y));
+   }
+
+   else if(1 == channel) //Green
+   {
+      return((uint8_t)((x * 255) / width));
+   }
+
+   return((uint8_t)((asset * 91) ^ (y * 2))); //Red
+}
+
+
+/*!
+* @brief Gray level of a spinner dot: the dot of the frame is lit, the one before it fades
+* @param[in] frame 0 to SIM_CARD_SPINNER_DOTS - 1
+* @param[in] x
+* @param[in] y
+* @return 0 outside the dots
+*/
+static uint8_t
+sim_card_spinner_level(uint32_t frame, uint32_t x, uint32_t y)
+{
+   for(uint32_t current_dot = 0; current_dot < SIM_CARD_SPINNER_DOTS; current_dot++)
+   {
+      double angle = (2.0 * M_PI * current_dot) / SIM_CARD_SPINNER_DOTS;
+      int32_t center_x = 68 + (int32_t)lround(SIM_CARD_SPINNER_RADIUS * sin(angle));
+      int32_t center_y = (SIM_CARD_ANIMATION_ROWS / 2) - (int32_t)lround(SIM_CARD_SPINNER_RADIUS * cos(angle));
+
+      if((abs((int32_t)x - center_x) < (SIM_CARD_SPINNER_DOT_SIZE / 2)) && (abs((int32_t)y - center_y) < (SIM_CARD_SPINNER_DOT_SIZE / 2)))
+      {
+         if(current_dot == frame)
+         {
+            return(0xF8);
+         }
+
+         return((((current_dot + 1) % SIM_CARD_SPINNER_DOTS) == frame) ? 0x90 : 0x30);
+      }
+   }
+
+   return(0);
+}
+
+
+/*!
+* @brief WAV slot: RIFF size at bytes 4-7 (read by sd_parse_wav_header), identifier inside
+*        the header, then an 8-bit unsigned tone whose pitch depends on the file
+*/
+static void
+sim_card_wav_block(uint32_t asset, uint32_t block_offset, uint8_t *p_buffer)
+{
+   uint32_t total_blocks = sim_card_wav_blocks(asset);
+   double frequency = 220.0 + (asset * 5.0);
+
+   if(total_blocks <= block_offset)
+   {
+      memset(p_buffer, 0x80, 512);
+      return;
+   }
+
+   for(uint32_t current_byte = 0; current_byte < 512; current_byte++)
+   {
+      uint32_t sample = (block_offset * 512) + current_byte;
+      p_buffer[current_byte] = (uint8_t)(128.0 + (90.0 * sin((2.0 * M_PI * frequency * sample) / SIM_CARD_WAV_SAMPLE_RATE)));
+   }
+
+   if(0 == block_offset)
+   {
+      uint32_t riff_size = total_blocks * 512;
+
+      memset(p_buffer, 0, 44);
+      memcpy(p_buffer, "RIFF", 4);
+      p_buffer[4] = (uint8_t)riff_size;
+      p_buffer[5] = (uint8_t)(riff_size >> 8);
+      p_buffer[6] = (uint8_t)(riff_size >> 16);
+      p_buffer[7] = (uint8_t)(riff_size >> 24);
+      memcpy(p_buffer + 8, "WAVEfmt ", 8);
+      memcpy(p_buffer + SIM_CARD_WAV_ID_OFFSET, card_files[asset].identifier, 5);
+   }
+}
+
+
+static uint32_t
+sim_card_wav_blocks(uint32_t asset)
+{
+   return(SIM_CARD_WAV_MIN_BLOCKS + ((asset * 53) % 400));
+}
+
+
+/*!
+* @brief Big-endian start block of every file, 4 bytes per entry, then the tag, each WAV's size in
+*        blocks and the type of every file, unless the card has an addresses-only table
+*/
+static void
+sim_card_cheat_sheet(uint8_t *p_table)
+{
+   for(uint32_t current_file = 0; current_file < max_total_addresses; current_file++)
+   {
+      uint32_t address = sim_card_asset_address(current_file);
+
+      p_table[(current_file * 4)] = (uint8_t)(address >> 24);
+      p_table[(current_file * 4) + 1] = (uint8_t)(address >> 16);
+      p_table[(current_file * 4) + 2] = (uint8_t)(address >> 8);
+      p_table[(current_file * 4) + 3] = (uint8_t)address;
+   }
+
+   if(address_only_table)
+   {
+      return;
+   }
+
+   memcpy(&p_table[SIM_CARD_TABLE_FORMAT], "SDT2", 4);
+
+   for(uint32_t current_file = 0; current_file < max_total_addresses; current_file++)
+   {
+      uint8_t is_wav = (sim_card_wav == card_files[current_file].type);
+      uint32_t blocks = is_wav ? sim_card_wav_blocks(current_file) : 0;
+
+      p_table[SIM_CARD_TABLE_SIZES + (current_file * 2)] = (uint8_t)(blocks >> 8);
+      p_table[SIM_CARD_TABLE_SIZES + (current_file * 2) + 1] = (uint8_t)blocks;
+      p_table[SIM_CARD_TABLE_TYPES + current_file] = is_wav; //wav_file is 1, bmp_file 0 in microsd.c
+   }
+}
+
+
+/*!
+* @brief Blocks below the first slot on a card with a FAT32 volume: the MBR with one
+*        partition, its boot sector, both copies of the FAT, the root directory and /assets
+*/
+static void
+sim_card_volume_block(uint32_t block, uint8_t *p_buffer)
+{
+   if(0 == block)
+   {
+      uint8_t *p_partition = &p_buffer[0x1BE];
+
+      p_partition[4] = 0x0C; //FAT32 with LBA addressing
+      sim_card_put_uint32(&p_partition[8], SIM_CARD_VOLUME_START);
+      sim_card_put_uint32(&p_partition[12], SIM_CARD_VOLUME_BLOCKS);
+      p_buffer[0x1FE] = 0x55;
+      p_buffer[0x1FF] = 0xAA;
+   }
+
+   else if(SIM_CARD_VOLUME_START == block)
+   {
+      memcpy(p_buffer, "\xEB\x58\x90MSDOS5.0", 11);
+      sim_card_put_uint16(&p_buffer[0x0B], 512);
+      p_buffer[0x0D] = SIM_CARD_CLUSTER_BLOCKS;
+      sim_card_put_uint16(&p_buffer[0x0E], SIM_CARD_RESERVED_BLOCKS);
+      p_buffer[0x10] = 2; //FATs
+      p_buffer[0x15] = 0xF8; //Fixed disk
+      sim_card_put_uint16(&p_buffer[0x18], 63);
+      sim_card_put_uint16(&p_buffer[0x1A], 255);
+      sim_card_put_uint32(&p_buffer[0x1C], SIM_CARD_VOLUME_START);
+      sim_card_put_uint32(&p_buffer[0x20], SIM_CARD_VOLUME_BLOCKS);
+      sim_card_put_uint32(&p_buffer[0x24], SIM_CARD_FAT_BLOCKS);
+      sim_card_put_uint32(&p_buffer[0x2C], SIM_CARD_ROOT_CLUSTER);
+      sim_card_put_uint16(&p_buffer[0x30], 1); //FSInfo sector
+      sim_card_put_uint16(&p_buffer[0x32], 6); //Backup boot sector
+      p_buffer[0x40] = 0x80;
+      p_buffer[0x42] = 0x29;
+      sim_card_put_uint32(&p_buffer[0x43], 0x20261017);
+      memcpy(&p_buffer[0x47], "NO NAME    FAT32   ", 19);
+      p_buffer[0x1FE] = 0x55;
+      p_buffer[0x1FF] = 0xAA;
+   }
+
+   else if((SIM_CARD_FAT_START <= block) && (SIM_CARD_DATA_START > block))
+   {
+      uint32_t first_cluster = ((block - SIM_CARD_FAT_START) % SIM_CARD_FAT_BLOCKS) * 128;
+
+      for(uint32_t current_entry = 0; current_entry < 128; current_entry++)
+      {
+         sim_card_put_uint32(&p_buffer[current_entry * 4], sim_card_fat_entry(first_cluster + current_entry));
+      }
+   }
+
+   else if(SIM_CARD_DATA_START <= block)
+   {
+      uint32_t cluster = SIM_CARD_ROOT_CLUSTER + ((block - SIM_CARD_DATA_START) / SIM_CARD_CLUSTER_BLOCKS);
+      uint32_t directory_offset = (block - (SIM_CARD_DATA_START + ((SIM_CARD_ASSETS_CLUSTER - SIM_CARD_ROOT_CLUSTER) * SIM_CARD_CLUSTER_BLOCKS))) * 512;
+
+      if(SIM_CARD_DATA_START == block)
+      {
+         sim_card_directory_entry(p_buffer, "ASSETS     ", 0x10, SIM_CARD_ASSETS_CLUSTER, 0);
+      }
+
+      else if(SIM_CARD_ASSETS_CLUSTER <= cluster)
+      {
+         std::vector<uint8_t> directory;
+         sim_card_assets_directory(directory);
+
+         if(directory_offset < directory.size())
+         {
+            memcpy(p_buffer, &directory[directory_offset], 512);
+         }
+      }
+   }
+}
+
+
+/*!
+* @brief FAT entry of a cluster. The root directory takes one cluster, /assets the ones after
+*        it and each file the clusters from the start of its slot
+*/
+static uint32_t
+sim_card_fat_entry(uint32_t cluster)
+{
+   uint32_t cluster_bytes = SIM_CARD_CLUSTER_BLOCKS * 512;
+
+   if(SIM_CARD_ROOT_CLUSTER > cluster)
+   {
+      return((0 == cluster) ? 0x0FFFFFF8 : SIM_CARD_END_OF_CHAIN); //Media byte, then a reserved end of chain
+   }
+
+   if(SIM_CARD_ROOT_CLUSTER == cluster)
+   {
+      return(SIM_CARD_END_OF_CHAIN);
+   }
+
+   uint32_t chain_start = SIM_CARD_ASSETS_CLUSTER;
+   uint32_t chain_clusters = 0;
+   uint32_t block = SIM_CARD_DATA_START + ((cluster - SIM_CARD_ROOT_CLUSTER) * SIM_CARD_CLUSTER_BLOCKS);
+
+   if((SIM_CARD_ASSET_BASE + SIM_CARD_ASSET_SLOT) <= block)
+   {
+      uint32_t asset = (block - SIM_CARD_ASSET_BASE) / SIM_CARD_ASSET_SLOT;
+
+      if(max_total_addresses <= asset)
+      {
+         return(0);
+      }
+
+      chain_start = SIM_CARD_ROOT_CLUSTER + ((sim_card_asset_address(asset) - SIM_CARD_DATA_START) / SIM_CARD_CLUSTER_BLOCKS);
+      chain_clusters = (sim_card_file_bytes(asset) + cluster_bytes - 1) / cluster_bytes;
+   }
+
+   else if(SIM_CARD_ASSET_BASE > block)
+   {
+      std::vector<uint8_t> directory;
+      sim_card_assets_directory(directory);
+      chain_clusters = (directory.size() + cluster_bytes - 1) / cluster_bytes;
+   }
+
+   uint32_t chain_index = cluster - chain_start;
+
+   if(chain_index >= chain_clusters)
+   {
+      return(0);
+   }
+
+   return(((chain_index + 1) < chain_clusters) ? (cluster + 1) : SIM_CARD_END_OF_CHAIN);
+}
+
+
+/*!
+* @brief Entries of /assets: "." and "..", then each file under its long name with a short
+*        name made up from it
+*/
+static void
+sim_card_assets_directory(std::vector<uint8_t> &directory)
+{
+   uint8_t entry[32];
+
+   directory.clear();
+
+   sim_card_directory_entry(entry, ".          ", 0x10, SIM_CARD_ASSETS_CLUSTER, 0);
+   directory.insert(directory.end(), entry, entry + 32);
+   sim_card_directory_entry(entry, "..         ", 0x10, 0, 0); //0 stands for the root directory
+   directory.insert(directory.end(), entry, entry + 32);
+
+   for(uint32_t asset = 1; asset < max_total_addresses; asset++)
+   {
+      const char *p_name = card_files[asset].name;
+      const char *p_extension = strrchr(p_name, '.');
+      uint32_t name_length = strlen(p_name);
+      char short_name[12];
+      char tail[8];
+
+      //First letters of the name, a "~" tail that keeps it unique and the first 3 of the extension
+      memset(short_name, ' ', 11);
+      snprintf(tail, sizeof(tail), "~%u", (unsigned)asset);
+
+      uint32_t base_length = 8 - strlen(tail);
+      uint32_t short_length = 0;
+
+      for(const char *p_char = p_name; (p_char < p_extension) && (short_length < base_length); p_char++)
+      {
+         if(isalnum((unsigned char)*p_char))
+         {
+            short_name[short_length] = (char)toupper((unsigned char)*p_char);
+            short_length++;
+         }
+      }
+
+      memcpy(&short_name[short_length], tail, strlen(tail));
+
+      for(uint32_t current_char = 0; (current_char < 3) && ('\0' != p_extension[current_char + 1]); current_char++)
+      {
+         short_name[8 + current_char] = (char)toupper((unsigned char)p_extension[current_char + 1]);
+      }
+
+      uint8_t checksum = 0;
+
+      for(uint32_t current_char = 0; current_char < 11; current_char++)
+      {
+         checksum = (uint8_t)(((checksum & 0x01) << 7) + (checksum >> 1) + (uint8_t)short_name[current_char]);
+      }
+
+      //Long name entries, the end of the name first
+      static const uint8_t long_name_offsets[13] = {1, 3, 5, 7, 9, 14, 16, 18, 20, 22, 24, 28, 30};
+      uint32_t long_entries = (name_length + 12) / 13;
+
+      for(uint32_t order = long_entries; order > 0; order--)
+      {
+         memset(entry, 0, 32);
+         entry[0] = (uint8_t)(order | ((long_entries == order) ? 0x40 : 0x00));
+         entry[11] = 0x0F;
+         entry[13] = checksum;
+
+         for(uint32_t current_char = 0; current_char < 13; current_char++)
+         {
+            uint32_t name_index = ((order - 1) * 13) + current_char;
+            uint16_t character = (name_index < name_length) ? (uint8_t)p_name[name_index] : ((name_index == name_length) ? 0x0000 : 0xFFFF);
+
+            sim_card_put_uint16(&entry[long_name_offsets[current_char]], character);
+         }
+
+         directory.insert(directory.end(), entry, entry + 32);
+      }
+
+      uint32_t cluster = SIM_CARD_ROOT_CLUSTER + ((sim_card_asset_address(asset) - SIM_CARD_DATA_START) / SIM_CARD_CLUSTER_BLOCKS);
+      sim_card_directory_entry(entry, short_name, 0x20, cluster, sim_card_file_bytes(asset));
+      directory.insert(directory.end(), entry, entry + 32);
+   }
+}
+
+
+static void
+sim_card_directory_entry(uint8_t *p_entry, const char *p_short_name, uint8_t attributes, uint32_t cluster, uint32_t size)
+{
+   memset(p_entry, 0, 32);
+   memcpy(p_entry, p_short_name, 11);
+   p_entry[11] = attributes;
+   sim_card_put_uint16(&p_entry[20], (uint16_t)(cluster >> 16));
+   sim_card_put_uint16(&p_entry[26], (uint16_t)cluster);
+   sim_card_put_uint32(&p_entry[28], size);
+}
+
+
+static void
+sim_card_put_uint16(uint8_t *p_bytes, uint16_t value)
+{
+   p_bytes[0] = (uint8_t)value;
+   p_bytes[1] = (uint8_t)(value >> 8);
+}
+
+
+static void
+sim_card_put_uint32(uint8_t *p_bytes, uint32_t value)
+{
+   sim_card_put_uint16(p_bytes, (uint16_t)value);
+   sim_card_put_uint16(&p_bytes[2], (uint16_t)(value >> 16));
+}
+
+/* end of file */
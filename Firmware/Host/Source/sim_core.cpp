@@ -0,0 +1,1188 @@
+/** @file sim_core.cpp
+*
+* @brief  Core of the host-side peripheral simulator: the cycle counter, register bus routing,
+*         the event queue that drives peripheral models, the NVIC and the function profiler.
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @note Time only moves when the firmware touches a register, iterates a while() loop, calls
+*       timers_delay() or takes an interrupt. Pure computation between those points is free, so
+*       cycle counts are a model of bus and peripheral time, not an instruction-accurate trace.
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#include "sim.h"
+#include <stdlib.h>
+#include <string.h>
+#include <dlfcn.h>
+#include <cxxabi.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+
+/*
+****************************************************
+********** Firmware Interrupt Handlers *************
+****************************************************
+*/
+extern "C"
+{
+void EXTI0_IRQHandler(void) __attribute__((weak));
+void EXTI1_IRQHandler(void) __attribute__((weak));
+void EXTI3_IRQHandler(void) __attribute__((weak));
+void DMA1_Stream3_IRQHandler(void) __attribute__((weak));
+void DMA1_Stream4_IRQHandler(void) __attribute__((weak));
+void DMA1_Stream5_IRQHandler(void) __attribute__((weak));
+void TIM1_UP_IRQHandler(void) __attribute__((weak));
+void TIM1_TRG_COM_TIM11_IRQHandler(void) __attribute__((weak));
+void TIM5_IRQHandler(void) __attribute__((weak));
+void DMA2_Stream1_IRQHandler(void) __attribute__((weak));
+void DMA2_Stream5_IRQHandler(void) __attribute__((weak));
+void SysTick_Handler(void) __attribute__((weak));
+}
+
+extern "C" char __executable_start[];
+extern "C" char _end[];
+
+//Linker script symbols main_check_stack_room() measures the stack with. The firmware is not laid
+//out in SRAM here, so they bound a stand-in exactly as large as MAIN_STACK_BYTES in main.c
+extern "C" uint8_t _ebss[4096];
+uint8_t _ebss[4096];
+asm(".globl _estack\n.set _estack, _ebss + 4096");
+
+/*
+****************************************************
+************* File-Static Variables ****************
+****************************************************
+*/
+#define SIM_MAX_DEVICES 64
+#define SIM_MAX_EVENTS 32
+#define SIM_PROFILE_SLOTS 4096
+#define SIM_PROFILE_DEPTH 256
+#define SIM_FIRMWARE_STACK_SIZE (8ul * 1024ul * 1024ul)
+
+typedef struct t_sim_event
+{
+   const char *name;
+   sim_event_handler handler;
+   uint64_t when;
+   uint8_t active;
+
+} t_sim_event;
+
+typedef struct t_sim_profile_entry
+{
+   void *function;
+   uint64_t calls;
+   uint64_t self_cycles;
+   uint64_t total_cycles;
+
+} t_sim_profile_entry;
+
+typedef struct t_sim_profile_frame
+{
+   uint32_t entry;
+   uint64_t start;
+
+} t_sim_profile_frame;
+
+uint64_t sim_now = 0;
+t_sim_stats sim_stats;
+
+static t_sim_device devices[SIM_MAX_DEVICES];
+static uint32_t total_devices = 0;
+static t_sim_device *device_cache[256];   //Indexed by address bits 6..13, checked against the range
+
+static t_sim_event events[SIM_MAX_EVENTS];
+static uint32_t total_events = 0;
+static uint64_t next_event_time = UINT64_MAX;
+
+static void (*irq_handlers[SIM_IRQ_COUNT])(void);
+static uint8_t irq_enabled[SIM_IRQ_COUNT];
+static uint8_t irq_pending[SIM_IRQ_COUNT];
+static uint8_t irq_priority[SIM_IRQ_COUNT];
+static uint8_t irq_pending_any = 0;
+static uint8_t irq_active = 0;
+static uint8_t irq_masked = 0;
+
+static uint64_t time_limit = UINT64_MAX;
+static void (*finish_hook)(const char *reason) = NULL;
+static uint8_t finishing = 0;
+
+static uint8_t profile_enabled = 0;
+static t_sim_profile_entry profile_entries[SIM_PROFILE_SLOTS];
+static t_sim_profile_frame profile_stack[SIM_PROFILE_DEPTH];
+static uint32_t profile_depth = 0;
+static uint32_t profile_current = 0; //Slot 0 collects cycles outside any instrumented function
+
+static uint8_t *p_firmware_stack = NULL;
+static ucontext_t host_context;
+static ucontext_t firmware_context;
+
+/*
+****************************************************
+********** Private Function Prototypes *************
+****************************************************
+*/
+static void sim_run_events(void);
+static void sim_dispatch_irqs(void);
+static void sim_update_next_event(void);
+static uint32_t sim_profile_slot(void *function);
+static uint8_t sim_host_address_valid(uint32_t address, uint32_t size);
+
+/*
+****************************************************
+********** Public Function Definitions *************
+****************************************************
+*/
+
+/*!
+* @brief Resets the simulator and every peripheral model to its power-on state
+* @param[in] NONE
+* @return NONE
+*/
+void
+sim_init(void)
+{
+   sim_now = 0;
+   total_devices = 0;
+   total_events = 0;
+   memset(device_cache, 0, sizeof(device_cache));
+   next_event_time = UINT64_MAX;
+   irq_pending_any = 0;
+   irq_active = 0;
+   irq_masked = 0;
+   memset(irq_enabled, 0, sizeof(irq_enabled));
+   memset(irq_pending, 0, sizeof(irq_pending));
+   memset(irq_priority, 0, sizeof(irq_priority));
+   memset(irq_handlers, 0, sizeof(irq_handlers));
+
+   irq_handlers[EXTI0_IRQn] = EXTI0_IRQHandler;
+   irq_handlers[EXTI1_IRQn] = EXTI1_IRQHandler;
+   irq_handlers[EXTI3_IRQn] = EXTI3_IRQHandler;
+   irq_handlers[DMA1_Stream3_IRQn] = DMA1_Stream3_IRQHandler;
+   irq_handlers[DMA1_Stream4_IRQn] = DMA1_Stream4_IRQHandler;
+   irq_handlers[DMA1_Stream5_IRQn] = DMA1_Stream5_IRQHandler;
+   irq_handlers[TIM1_UP_IRQn] = TIM1_UP_IRQHandler;
+   irq_handlers[TIM1_TRG_COM_TIM11_IRQn] = TIM1_TRG_COM_TIM11_IRQHandler;
+   irq_handlers[TIM5_IRQn] = TIM5_IRQHandler;
+   irq_handlers[DMA2_Stream1_IRQn] = DMA2_Stream1_IRQHandler;
+   irq_handlers[DMA2_Stream5_IRQn] = DMA2_Stream5_IRQHandler;
+   irq_handlers[SysTick_IRQn] = SysTick_Handler;
+   irq_enabled[SysTick_IRQn] = 1; //System exceptions have no NVIC enable bit, TICKINT gates SysTick
+
+   sim_stats_reset();
+   sim_profile_reset();
+
+   sim_gpio_init();
+   sim_lcd_init();
+   sim_spi_init();
+   sim_sd_init();
+   sim_peripherals_init();
+}
+
+
+/*!
+* @brief Maps a block of simulated registers onto a bus
+* @param[in] name Peripheral name used in reports
+* @param[in] base First register of the block
+* @param[in] size Size of the register block in bytes
+* @param[in] bus Bus the peripheral is attached to, which sets the cost of each access
+* @param[in] read Read side effects, or NULL to return the stored value
+* @param[in] write Write side effects, or NULL to store the written value
+* @return NONE
+*/
+void
+sim_register_device(const char *name, void *base, size_t size, e_sim_bus bus,
+                    uint32_t (*read)(uint32_t, sim_reg *),
+                    void (*write)(uint32_t, sim_reg *, uint32_t))
+{
+   if(SIM_MAX_DEVICES > total_devices)
+   {
+      t_sim_device *p_device = &devices[total_devices++];
+      p_device->name = name;
+      p_device->base = base;
+      p_device->size = size;
+      p_device->bus = bus;
+      p_device->read = read;
+      p_device->write = write;
+      p_device->reads = 0;
+      p_device->writes = 0;
+      memset(base, 0, size);
+   }
+}
+
+
+/*!
+* @brief Finds the simulated peripheral that owns an address
+* @param[in] address Address of a register
+* @return Device descriptor, or NULL if the address is not a simulated register
+*/
+t_sim_device *
+sim_find_device(const void *address)
+{
+   const uint8_t *p_address = (const uint8_t *)address;
+   t_sim_device **pp_cached = &device_cache[((uintptr_t)address >> 6) & 0xFF];
+   t_sim_device *p_cached = *pp_cached;
+
+   if((NULL != p_cached) &&
+      (p_address >= (const uint8_t *)p_cached->base) &&
+      (p_address < ((const uint8_t *)p_cached->base + p_cached->size)))
+   {
+      return(p_cached);
+   }
+
+   for(uint32_t current_device = 0; current_device < total_devices; current_device++)
+   {
+      t_sim_device *p_device = &devices[current_device];
+
+      if((p_address >= (const uint8_t *)p_device->base) &&
+         (p_address < ((const uint8_t *)p_device->base + p_device->size)))
+      {
+         *pp_cached = p_device;
+         return(p_device);
+      }
+   }
+
+   return(NULL);
+}
+
+
+/*!
+* @brief Advances simulated time, runs every peripheral event that has come due and
+*        takes any interrupt that became pending
+* @param[in] cycles Core clock cycles to advance
+* @return NONE
+*/
+void
+sim_advance(uint64_t cycles)
+{
+   sim_now += cycles;
+
+   if(profile_enabled)
+   {
+      profile_entries[profile_current].self_cycles += cycles;
+   }
+
+   if(next_event_time <= sim_now)
+   {
+      sim_run_events();
+   }
+
+   if(irq_pending_any && !irq_active && !irq_masked)
+   {
+      sim_dispatch_irqs();
+   }
+
+   if(time_limit <= sim_now)
+   {
+      sim_finish("time limit reached");
+   }
+}
+
+
+/*!
+* @brief Charged once per while() iteration in firmware code. This is what lets loops that
+*        poll RAM flags written by interrupt handlers make progress.
+* @param[in] NONE
+* @return NONE
+*/
+void
+sim_loop_tick(void)
+{
+   sim_stats.cycles_loop += SIM_LOOP_CYCLES;
+   sim_advance(SIM_LOOP_CYCLES);
+}
+
+
+/*!
+* @brief Charges cycles for work the register model cannot see, e.g. a busy-wait delay
+* @param[in] cycles Core clock cycles
+* @return NONE
+*/
+void
+sim_cpu_cycles(uint32_t cycles)
+{
+   sim_stats.cycles_cpu += cycles;
+   sim_advance(cycles);
+}
+
+
+/*!
+* @brief Replaces the busy loop of timers_delay() in timers.c (renamed by the Makefile) so
+*        the delay costs simulated time instead of host time
+* @param[in] delay_time Loop count in thousands, as on the target
+* @return NONE
+*/
+void
+timers_delay(uint32_t delay_time)
+{
+   uint64_t cycles = (uint64_t)delay_time * 1000 * SIM_DELAY_LOOP_CYCLES;
+
+   sim_stats.cycles_delay += cycles;
+   sim_advance(cycles);
+}
+
+
+/*!
+* @brief Replaces the busy loop of timers_delay_mini() in timers.c
+* @param[in] delay_time Loop count
+* @return NONE
+*/
+void
+timers_delay_mini(uint32_t delay_time)
+{
+   uint64_t cycles = (uint64_t)delay_time * SIM_DELAY_LOOP_CYCLES;
+
+   sim_stats.cycles_delay += cycles;
+   sim_advance(cycles);
+}
+
+
+/*!
+* @brief Ends the run once simulated time reaches a limit
+* @param[in] cycles Absolute time in core clock cycles
+* @return NONE
+*/
+void
+sim_set_time_limit(uint64_t cycles)
+{
+   time_limit = cycles;
+}
+
+
+/*!
+* @brief Installs the function called once when the run ends
+* @param[in] hook Callback, receives the reason the simulation stopped
+* @return NONE
+*/
+void
+sim_set_finish_hook(void (*hook)(const char *reason))
+{
+   finish_hook = hook;
+}
+
+
+/*!
+* @brief Stops the simulation, reports through the finish hook and exits the process
+* @param[in] reason Human readable cause
+* @return NONE
+*/
+void
+sim_finish(const char *reason)
+{
+   if(!finishing)
+   {
+      finishing = 1;
+      time_limit = UINT64_MAX;
+
+      if(NULL != finish_hook)
+      {
+         finish_hook(reason);
+      }
+
+      exit(0);
+   }
+}
+
+
+/*!
+* @brief Runs the firmware entry point on a stack mapped below 4GB. The drivers hand stack
+*        buffers to DMA as (uint32_t) casts, which only survive on a 32-bit addressable stack.
+* @param[in] entry Firmware main()
+* @return NONE
+*/
+void
+sim_run_firmware(void (*entry)(void))
+{
+   p_firmware_stack = (uint8_t *)mmap(NULL, SIM_FIRMWARE_STACK_SIZE, PROT_READ | PROT_WRITE,
+                                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT, -1, 0);
+
+   if(MAP_FAILED == (void *)p_firmware_stack)
+   {
+      fprintf(stderr, "sim: unable to map the firmware stack below 4GB\n");
+      exit(1);
+   }
+
+   getcontext(&firmware_context);
+   firmware_context.uc_stack.ss_sp = p_firmware_stack;
+   firmware_context.uc_stack.ss_size = SIM_FIRMWARE_STACK_SIZE;
+   firmware_context.uc_link = &host_context;
+   makecontext(&firmware_context, entry, 0);
+   swapcontext(&host_context, &firmware_context);
+
+   sim_finish("firmware main() returned");
+}
+
+
+/*!
+* @brief Allocates an event slot for a peripheral model
+* @param[in] name Event name, used for debugging
+* @param[in] handler Called with the scheduled time once simulated time passes it
+* @return slot Handle used with sim_event_schedule()
+*/
+int
+sim_event_register(const char *name, sim_event_handler handler)
+{
+   if(SIM_MAX_EVENTS <= total_events)
+   {
+      fprintf(stderr, "sim: too many events registered\n");
+      abort();
+   }
+
+   events[total_events].name = name;
+   events[total_events].handler = handler;
+   events[total_events].active = 0;
+   events[total_events].when = 0;
+
+   return((int)total_events++);
+}
+
+
+/*!
+* @brief Schedules (or reschedules) an event
+* @param[in] slot Event handle
+* @param[in] when Absolute time in core clock cycles
+* @return NONE
+*/
+void
+sim_event_schedule(int slot, uint64_t when)
+{
+   events[slot].when = when;
+   events[slot].active = 1;
+
+   if(when < next_event_time)
+   {
+      next_event_time = when;
+   }
+}
+
+
+/*!
+* @brief Cancels a pending event
+* @param[in] slot Event handle
+* @return NONE
+*/
+void
+sim_event_cancel(int slot)
+{
+   events[slot].active = 0;
+   sim_update_next_event();
+}
+
+
+/*!
+* @brief Returns whether an event is currently scheduled
+* @param[in] slot Event handle
+* @return 1 if scheduled, else 0
+*/
+uint8_t
+sim_event_pending(int slot)
+{
+   return(events[slot].active);
+}
+
+
+/*!
+* @brief Marks an interrupt pending in the NVIC. It is taken on the next time advance if enabled.
+* @param[in] irq_number IRQn_Type value
+* @return NONE
+*/
+void
+sim_irq_raise(int irq_number)
+{
+   irq_pending[irq_number] = 1;
+   irq_pending_any = 1;
+}
+
+
+/*!
+* @brief Returns whether the firmware is currently executing an interrupt handler
+* @param[in] NONE
+* @return 1 inside a handler, else 0
+*/
+uint8_t
+sim_in_isr(void)
+{
+   return(irq_active);
+}
+
+
+void
+sim_nvic_enable(int irq_number)
+{
+   sim_advance(SIM_BUS_CORE_CYCLES);
+   irq_enabled[irq_number] = 1;
+}
+
+
+void
+sim_nvic_disable(int irq_number)
+{
+   sim_advance(SIM_BUS_CORE_CYCLES);
+   irq_enabled[irq_number] = 0;
+}
+
+
+void
+sim_nvic_set_priority(int irq_number, uint32_t priority)
+{
+   sim_advance(SIM_BUS_CORE_CYCLES);
+   irq_priority[irq_number] = (uint8_t)priority;
+}
+
+
+void
+sim_nvic_clear_pending(int irq_number)
+{
+   sim_advance(SIM_BUS_CORE_CYCLES);
+   irq_pending[irq_number] = 0;
+}
+
+
+void
+sim_nvic_set_pending(int irq_number)
+{
+   sim_irq_raise(irq_number);
+   sim_advance(SIM_BUS_CORE_CYCLES);
+}
+
+
+void
+sim_cpu_irq_mask(uint8_t masked)
+{
+   irq_masked = masked;
+   sim_advance(1);
+}
+
+
+/*!
+* @brief Models the WFI instruction. Standby (SLEEPDEEP + PDDS) ends the run, plain sleep
+*        idles until the next peripheral event.
+* @param[in] NONE
+* @return NONE
+*/
+void
+sim_cpu_wfi(void)
+{
+   if((sim_scb.SCR.raw & SCB_SCR_SLEEPDEEP_Msk) && (sim_pwr.CR.raw & PWR_CR_PDDS))
+   {
+      sim_finish("MCU entered standby");
+   }
+
+   if(UINT64_MAX == next_event_time)
+   {
+      sim_finish("WFI with no pending peripheral events");
+   }
+
+   if(next_event_time > sim_now)
+   {
+      sim_advance(next_event_time - sim_now);
+   }
+}
+
+
+/*!
+* @brief Reads memory or a register on behalf of a DMA stream
+* @param[in] address 32-bit bus address
+* @param[in] size Access size in bytes (1, 2 or 4)
+* @param[in] p_value Receives the value
+* @return 1 on success, 0 if the address is not mapped in the host process
+*/
+uint8_t
+sim_dma_read(uint32_t address, uint32_t size, uint32_t *p_value)
+{
+   void *p_address = (void *)(uintptr_t)address;
+   t_sim_device *p_device = sim_find_device(p_address);
+
+   if(NULL != p_device)
+   {
+      sim_reg *p_reg = (sim_reg *)((uintptr_t)p_address & ~(uintptr_t)3);
+      uint32_t offset = (uint32_t)((uint8_t *)p_reg - (uint8_t *)p_device->base);
+      sim_stats.bus_reads[sim_bus_dma]++;
+      *p_value = (NULL != p_device->read) ? p_device->read(offset, p_reg) : p_reg->raw;
+      return(1);
+   }
+
+   if(!sim_host_address_valid(address, size))
+   {
+      *p_value = 0;
+      return(0);
+   }
+
+   if(1 == size)
+   {
+      *p_value = *(uint8_t *)p_address;
+   }
+
+   else if(2 == size)
+   {
+      *p_value = *(uint16_t *)p_address;
+   }
+
+   else
+   {
+      *p_value = *(uint32_t *)p_address;
+   }
+
+   return(1);
+}
+
+
+/*!
+* @brief Writes memory or a register on behalf of a DMA stream
+* @param[in] address 32-bit bus address
+* @param[in] size Access size in bytes (1, 2 or 4)
+* @param[in] value Value to store
+* @return 1 on success, 0 if the address is not mapped in the host process
+*/
+uint8_t
+sim_dma_write(uint32_t address, uint32_t size, uint32_t value)
+{
+   void *p_address = (void *)(uintptr_t)address;
+   t_sim_device *p_device = sim_find_device(p_address);
+
+   if(NULL != p_device)
+   {
+      sim_reg *p_reg = (sim_reg *)((uintptr_t)p_address & ~(uintptr_t)3);
+      uint32_t offset = (uint32_t)((uint8_t *)p_reg - (uint8_t *)p_device->base);
+      sim_stats.bus_writes[sim_bus_dma]++;
+
+      //Byte and halfword stores only change their own lanes, e.g. the low byte of a GPIO ODR
+      if(4 > size)
+      {
+         uint32_t lane_shift = 8 * (address & 3);
+         uint32_t lane_mask = ((1ul << (8 * size)) - 1) << lane_shift;
+         value = (p_reg->raw & ~lane_mask) | ((value << lane_shift) & lane_mask);
+      }
+
+      if(NULL != p_device->write)
+      {
+         p_device->write(offset, p_reg, value);
+      }
+
+      else
+      {
+         p_reg->raw = value;
+      }
+
+      return(1);
+   }
+
+   if(!sim_host_address_valid(address, size))
+   {
+      return(0);
+   }
+
+   if(1 == size)
+   {
+      *(uint8_t *)p_address = (uint8_t)value;
+   }
+
+   else if(2 == size)
+   {
+      *(uint16_t *)p_address = (uint16_t)value;
+   }
+
+   else
+   {
+      *(uint32_t *)p_address = value;
+   }
+
+   return(1);
+}
+
+
+/*!
+* @brief Clears all counters
+* @param[in] NONE
+* @return NONE
+*/
+void
+sim_stats_reset(void)
+{
+   memset(&sim_stats, 0, sizeof(sim_stats));
+
+   for(uint32_t current_device = 0; current_device < total_devices; current_device++)
+   {
+      devices[current_device].reads = 0;
+      devices[current_device].writes = 0;
+   }
+}
+
+
+/*!
+* @brief Prints a summary of time and bus traffic
+* @param[in] p_out Output stream
+* @return NONE
+*/
+void
+sim_stats_print(FILE *p_out)
+{
+   static const char *bus_names[sim_total_buses] = {"core", "AHB1", "APB1", "APB2", "DMA"};
+
+   fprintf(p_out, "simulated time      %12.3f ms (%llu cycles)\n", (double)sim_now / SIM_CYCLES_PER_MS, (unsigned long long)sim_now);
+   fprintf(p_out, "  register access   %12llu cycles\n", (unsigned long long)sim_stats.cycles_bus);
+   fprintf(p_out, "  while() loops     %12llu cycles\n", (unsigned long long)sim_stats.cycles_loop);
+   fprintf(p_out, "  delay loops       %12llu cycles\n", (unsigned long long)sim_stats.cycles_delay);
+   fprintf(p_out, "  interrupts        %12llu cycles\n", (unsigned long long)sim_stats.cycles_isr);
+
+   fprintf(p_out, "bus transactions    %8s %12s %12s\n", "", "reads", "writes");
+   for(uint32_t current_bus = 0; current_bus < sim_total_buses; current_bus++)
+   {
+      fprintf(p_out, "  %-8s          %8s %12llu %12llu\n", bus_names[current_bus], "",
+              (unsigned long long)sim_stats.bus_reads[current_bus], (unsigned long long)sim_stats.bus_writes[current_bus]);
+   }
+
+   fprintf(p_out, "peripheral          %8s %12s %12s\n", "", "reads", "writes");
+   for(uint32_t current_device = 0; current_device < total_devices; current_device++)
+   {
+      if(devices[current_device].reads || devices[current_device].writes)
+      {
+         fprintf(p_out, "  %-16s  %8s %12llu %12llu\n", devices[current_device].name, "",
+                 (unsigned long long)devices[current_device].reads, (unsigned long long)devices[current_device].writes);
+      }
+   }
+
+   fprintf(p_out, "lcd                 commands %llu, data bytes %llu, pixels %llu, windows %llu, dropped bytes %llu, read bytes %llu\n",
+           (unsigned long long)sim_stats.lcd_commands, (unsigned long long)sim_stats.lcd_data_bytes,
+           (unsigned long long)sim_stats.lcd_pixels, (unsigned long long)sim_stats.lcd_command_count[0x2A],
+           (unsigned long long)sim_stats.lcd_dropped_bytes, (unsigned long long)sim_stats.lcd_read_bytes);
+   fprintf(p_out, "spi2                bytes %llu, shifter busy %.3f ms, overruns %llu\n",
+           (unsigned long long)sim_stats.spi_bytes, (double)sim_stats.spi_busy_cycles / SIM_CYCLES_PER_MS,
+           (unsigned long long)sim_stats.spi_overruns);
+   fprintf(p_out, "sd card             commands %llu, blocks read %llu, blocks written %llu\n",
+           (unsigned long long)sim_stats.sd_commands, (unsigned long long)sim_stats.sd_blocks_read,
+           (unsigned long long)sim_stats.sd_blocks_written);
+   fprintf(p_out, "dma                 transfers %llu\n", (unsigned long long)sim_stats.dma_transfers);
+
+   fprintf(p_out, "interrupts         ");
+   for(uint32_t current_irq = 0; current_irq < SIM_IRQ_COUNT; current_irq++)
+   {
+      if(sim_stats.isr_count[current_irq])
+      {
+         fprintf(p_out, " irq%u:%llu", current_irq, (unsigned long long)sim_stats.isr_count[current_irq]);
+      }
+   }
+   fprintf(p_out, "\n");
+}
+
+
+/*!
+* @brief Turns the per-function cycle profiler on or off
+* @param[in] enable 1 to collect, 0 to stop
+* @return NONE
+*/
+void
+sim_profile_enable(uint8_t enable)
+{
+   profile_enabled = enable;
+}
+
+
+/*!
+* @brief Clears the profile. The call stack is kept so in-flight functions stay attributed.
+* @param[in] NONE
+* @return NONE
+*/
+void
+sim_profile_reset(void)
+{
+   for(uint32_t current_entry = 0; current_entry < SIM_PROFILE_SLOTS; current_entry++)
+   {
+      profile_entries[current_entry].calls = 0;
+      profile_entries[current_entry].self_cycles = 0;
+      profile_entries[current_entry].total_cycles = 0;
+   }
+}
+
+
+/*!
+* @brief Prints the firmware functions that consumed the most simulated cycles
+* @param[in] p_out Output stream
+* @param[in] max_entries Number of functions to list
+* @return NONE
+*/
+void
+sim_profile_print(FILE *p_out, uint32_t max_entries)
+{
+   static uint32_t order[SIM_PROFILE_SLOTS];
+   uint32_t total_entries = 0;
+   uint64_t total_cycles = 0;
+
+   for(uint32_t current_entry = 0; current_entry < SIM_PROFILE_SLOTS; current_entry++)
+   {
+      if(profile_entries[current_entry].self_cycles || profile_entries[current_entry].calls)
+      {
+         order[total_entries++] = current_entry;
+         total_cycles += profile_entries[current_entry].self_cycles;
+      }
+   }
+
+   //Insertion sort by self time, the table is small
+   for(uint32_t i = 1; i < total_entries; i++)
+   {
+      uint32_t key = order[i];
+      int32_t j = (int32_t)i - 1;
+
+      while((0 <= j) && (profile_entries[order[j]].self_cycles < profile_entries[key].self_cycles))
+      {
+         order[j + 1] = order[j];
+         j--;
+      }
+
+      order[j + 1] = key;
+   }
+
+   fprintf(p_out, "%6s %12s %12s %10s  %s\n", "self%", "self(cyc)", "total(cyc)", "calls", "function");
+
+   for(uint32_t i = 0; (i < total_entries) && (i < max_entries); i++)
+   {
+      t_sim_profile_entry *p_entry = &profile_entries[order[i]];
+      char name[96] = "(outside firmware)";
+
+      if(NULL != p_entry->function)
+      {
+         Dl_info info;
+         snprintf(name, sizeof(name), "%p", p_entry->function);
+
+         if(dladdr(p_entry->function, &info) && (NULL != info.dli_sname))
+         {
+            int status = 0;
+            char *p_demangled = abi::__cxa_demangle(info.dli_sname, NULL, NULL, &status);
+            const char *p_symbol = ((0 == status) && (NULL != p_demangled)) ? p_demangled : info.dli_sname;
+            snprintf(name, sizeof(name), "%s", p_symbol);
+            char *p_paren = strchr(name, '(');
+
+            if(NULL != p_paren)
+            {
+               *p_paren = '\0';
+            }
+
+            free(p_demangled);
+         }
+      }
+
+      fprintf(p_out, "%5.1f%% %12llu %12llu %10llu  %s\n",
+              total_cycles ? (100.0 * (double)p_entry->self_cycles / (double)total_cycles) : 0.0,
+              (unsigned long long)p_entry->self_cycles, (unsigned long long)p_entry->total_cycles,
+              (unsigned long long)p_entry->calls, name);
+   }
+}
+
+
+/*
+****************************************************
+*********** Register Bus Entry Points *************
+****************************************************
+*/
+
+/*!
+* @brief Every firmware register load lands here
+* @param[in] p_reg Register being read
+* @return Register value as seen by the CPU
+*/
+uint32_t
+sim_bus_read(sim_reg *p_reg)
+{
+   static const uint8_t bus_cycles[sim_total_buses] =
+   {
+      SIM_BUS_CORE_CYCLES, SIM_BUS_AHB1_CYCLES, SIM_BUS_APB1_CYCLES, SIM_BUS_APB2_CYCLES, 0
+   };
+
+   t_sim_device *p_device = sim_find_device(p_reg);
+
+   if(NULL == p_device)
+   {
+      fprintf(stderr, "sim: read of unmapped register %p\n", (void *)p_reg);
+      abort();
+   }
+
+   sim_stats.cycles_bus += bus_cycles[p_device->bus];
+   sim_advance(bus_cycles[p_device->bus]);
+
+   sim_stats.bus_reads[p_device->bus]++;
+   p_device->reads++;
+
+   uint32_t offset = (uint32_t)((uint8_t *)p_reg - (uint8_t *)p_device->base);
+
+   return((NULL != p_device->read) ? p_device->read(offset, p_reg) : p_reg->raw);
+}
+
+
+/*!
+* @brief Every firmware register store lands here
+* @param[in] p_reg Register being written
+* @param[in] value Value stored by the CPU
+* @return NONE
+*/
+void
+sim_bus_write(sim_reg *p_reg, uint32_t value)
+{
+   static const uint8_t bus_cycles[sim_total_buses] =
+   {
+      SIM_BUS_CORE_CYCLES, SIM_BUS_AHB1_CYCLES, SIM_BUS_APB1_CYCLES, SIM_BUS_APB2_CYCLES, 0
+   };
+
+   t_sim_device *p_device = sim_find_device(p_reg);
+
+   if(NULL == p_device)
+   {
+      fprintf(stderr, "sim: write of unmapped register %p\n", (void *)p_reg);
+      abort();
+   }
+
+   sim_stats.cycles_bus += bus_cycles[p_device->bus];
+   sim_advance(bus_cycles[p_device->bus]);
+
+   sim_stats.bus_writes[p_device->bus]++;
+   p_device->writes++;
+
+   uint32_t offset = (uint32_t)((uint8_t *)p_reg - (uint8_t *)p_device->base);
+
+   if(NULL != p_device->write)
+   {
+      p_device->write(offset, p_reg, value);
+   }
+
+   else
+   {
+      p_reg->raw = value;
+   }
+}
+
+
+/*
+****************************************************
+************ Function Profiler Hooks ***************
+****************************************************
+*/
+extern "C" void __cyg_profile_func_enter(void *function, void *call_site) __attribute__((no_instrument_function));
+extern "C" void __cyg_profile_func_exit(void *function, void *call_site) __attribute__((no_instrument_function));
+
+extern "C" void
+__cyg_profile_func_enter(void *function, void *call_site)
+{
+   (void)call_site;
+
+   if(!profile_enabled)
+   {
+      return;
+   }
+
+   uint32_t slot = sim_profile_slot(function);
+
+   if(SIM_PROFILE_DEPTH > profile_depth)
+   {
+      profile_stack[profile_depth].entry = slot;
+      profile_stack[profile_depth].start = sim_now;
+   }
+
+   profile_depth++;
+   profile_current = slot;
+
+   if(profile_enabled)
+   {
+      profile_entries[slot].calls++;
+   }
+}
+
+
+extern "C" void
+__cyg_profile_func_exit(void *function, void *call_site)
+{
+   (void)function;
+   (void)call_site;
+
+   if(!profile_enabled || (0 == profile_depth))
+   {
+      return;
+   }
+
+   profile_depth--;
+
+   if(SIM_PROFILE_DEPTH > profile_depth)
+   {
+      t_sim_profile_frame *p_frame = &profile_stack[profile_depth];
+
+      if(profile_enabled)
+      {
+         profile_entries[p_frame->entry].total_cycles += (sim_now - p_frame->start);
+      }
+   }
+
+   profile_current = ((0 != profile_depth) && (SIM_PROFILE_DEPTH >= profile_depth)) ? profile_stack[profile_depth - 1].entry : 0;
+}
+
+
+/*
+****************************************************
+********** Private Function Definitions ************
+****************************************************
+*/
+
+/*!
+* @brief Runs due events in time order. Handlers may schedule further events.
+* @param[in] NONE
+* @return NONE
+*/
+static void
+sim_run_events(void)
+{
+   while(next_event_time <= sim_now)
+   {
+      int due_slot = -1;
+
+      for(uint32_t current_event = 0; current_event < total_events; current_event++)
+      {
+         if(events[current_event].active && (events[current_event].when <= sim_now) &&
+            ((-1 == due_slot) || (events[current_event].when < events[due_slot].when)))
+         {
+            due_slot = (int)current_event;
+         }
+      }
+
+      if(-1 == due_slot)
+      {
+         sim_update_next_event();
+         break;
+      }
+
+      events[due_slot].active = 0;
+      uint64_t when = events[due_slot].when;
+      sim_update_next_event();
+      events[due_slot].handler(when);
+      sim_update_next_event();
+   }
+}
+
+
+static void
+sim_update_next_event(void)
+{
+   next_event_time = UINT64_MAX;
+
+   for(uint32_t current_event = 0; current_event < total_events; current_event++)
+   {
+      if(events[current_event].active && (events[current_event].when < next_event_time))
+      {
+         next_event_time = events[current_event].when;
+      }
+   }
+}
+
+
+/*!
+* @brief Takes pending, enabled interrupts in priority order. Handlers do not nest.
+* @param[in] NONE
+* @return NONE
+*/
+static void
+sim_dispatch_irqs(void)
+{
+   for(;;)
+   {
+      int selected_irq = -1;
+      uint8_t any_pending = 0;
+
+      for(int current_irq = 0; current_irq < SIM_IRQ_COUNT; current_irq++)
+      {
+         if(irq_pending[current_irq])
+         {
+            any_pending = 1;
+
+            if(irq_enabled[current_irq] &&
+               ((-1 == selected_irq) || (irq_priority[current_irq] < irq_priority[selected_irq])))
+            {
+               selected_irq = current_irq;
+            }
+         }
+      }
+
+      irq_pending_any = any_pending;
+
+      if(-1 == selected_irq)
+      {
+         break;
+      }
+
+      irq_pending[selected_irq] = 0;
+      irq_active = 1;
+
+      uint64_t start = sim_now;
+      sim_stats.isr_count[selected_irq]++;
+      sim_advance(SIM_ISR_ENTRY_CYCLES);
+
+      if(NULL != irq_handlers[selected_irq])
+      {
+         irq_handlers[selected_irq]();
+      }
+
+      sim_advance(SIM_ISR_EXIT_CYCLES);
+      sim_stats.cycles_isr += (sim_now - start);
+      irq_active = 0;
+   }
+}
+
+
+static uint32_t
+sim_profile_slot(void *function)
+{
+   uint32_t slot = (uint32_t)(((uintptr_t)function >> 4) * 2654435761u) % (SIM_PROFILE_SLOTS - 1);
+   slot++; //Slot 0 is reserved
+
+   for(uint32_t probe = 0; probe < (SIM_PROFILE_SLOTS - 1); probe++)
+   {
+      if(profile_entries[slot].function == function)
+      {
+         return(slot);
+      }
+
+      if(NULL == profile_entries[slot].function)
+      {
+         profile_entries[slot].function = function;
+         return(slot);
+      }
+
+      slot = (slot % (SIM_PROFILE_SLOTS - 1)) + 1;
+   }
+
+   return(0);
+}
+
+
+static uint8_t
+sim_host_address_valid(uint32_t address, uint32_t size)
+{
+   uintptr_t start = (uintptr_t)__executable_start;
+   uintptr_t end = (uintptr_t)_end;
+   uintptr_t stack_start = (uintptr_t)p_firmware_stack;
+
+   if((NULL != p_firmware_stack) && ((uintptr_t)address >= stack_start) &&
+      (((uintptr_t)address + size) <= (stack_start + SIM_FIRMWARE_STACK_SIZE)))
+   {
+      return(1);
+   }
+
+   return(((uintptr_t)address >= start) && (((uintptr_t)address + size) <= end));
+}
+
+/* end of file */
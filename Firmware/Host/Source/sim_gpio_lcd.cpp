@@ -0,0 +1,828 @@
+/** @file sim_gpio_lcd.cpp
+*
+* @brief  GPIO port model and the ILI9486 controller hanging off the 8080-style parallel bus
+*         (DB0-DB7 on GPIOB, WR/RS/CS/RD on GPIOA). The controller latches on the rising edge
+*         of WR exactly like the real part, so every byte the firmware strobes is decoded into
+*         commands, parameters and GRAM writes. Memory reads are answered on the falling edge
+*         of RD by driving DB0-DB7 the way the part does in 8-bit mode. Vertical scrolling is applied when the panel
+*         is read back, GRAM itself is never moved.
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#include "sim.h"
+#include <string.h>
+
+/*
+****************************************************
+*********** Simulated Register Blocks **************
+****************************************************
+*/
+GPIO_TypeDef sim_gpioa, sim_gpiob, sim_gpioc, sim_gpioh;
+
+/*
+****************************************************
+************* File-Static Variables ****************
+****************************************************
+*/
+#define SIM_LCD_WR_PIN 8    //PA8
+#define SIM_LCD_RD_PIN 11   //PA11
+#define SIM_LCD_CS_PIN 12   //PA12
+#define SIM_LCD_RS_PIN 15   //PA15
+#define SIM_LCD_RESET_PIN 10 //PC10
+
+typedef struct t_sim_port
+{
+   GPIO_TypeDef *p_port;
+   uint32_t input_levels;   //Level driven onto each pin from outside the MCU
+   uint32_t alternate_pins; //Pins with a modeled alternate function output, e.g. a timer channel
+   uint32_t alternate_levels;
+
+} t_sim_port;
+
+typedef struct t_sim_lcd
+{
+   uint8_t command;
+   uint8_t parameter_count;
+   uint8_t parameters[16];
+   uint16_t column_start;
+   uint16_t column_end;
+   uint16_t page_start;
+   uint16_t page_end;
+   uint16_t x;
+   uint16_t y;
+   uint8_t high_byte;
+   uint8_t byte_phase;
+   uint8_t read_phase;       //Memory read: 0 = dummy byte next, then red, green, blue
+   uint8_t madctl;
+   uint8_t colmod;
+   uint8_t inverted;
+   uint8_t display_on;
+   uint8_t sleeping;
+   uint16_t scroll_top;      //Vertical scroll definition, top fixed area
+   uint16_t scroll_height;   //Vertical scroll definition, scroll area
+   uint16_t scroll_start;    //GRAM line shown at the top of the scroll area
+
+} t_sim_lcd;
+
+//GRAM area whose pixels are counted off as they are written, see sim_lcd_watch_area()
+typedef struct t_sim_lcd_watch
+{
+   uint16_t x_initial;
+   uint16_t y_initial;
+   uint16_t x_final;
+   uint16_t y_final;
+   uint32_t pixels_left;    //Not written since the watch started
+   uint64_t filled_at;      //sim_now when pixels_left reached 0
+
+} t_sim_lcd_watch;
+
+static t_sim_port ports[4];
+static t_sim_lcd lcd;
+static uint16_t gram[SIM_LCD_HEIGHT][SIM_LCD_WIDTH];
+static t_sim_lcd_watch watch;
+static uint8_t watch_written[SIM_LCD_HEIGHT][SIM_LCD_WIDTH];
+
+/*
+****************************************************
+********** Private Function Prototypes *************
+****************************************************
+*/
+static uint32_t sim_gpio_read(uint32_t offset, sim_reg *p_reg);
+static void sim_gpio_write(uint32_t offset, sim_reg *p_reg, uint32_t value);
+static void sim_gpio_odr_changed(GPIO_TypeDef *p_port, uint32_t old_odr, uint32_t new_odr);
+static uint32_t sim_gpio_output_levels(GPIO_TypeDef *p_port);
+static t_sim_port *sim_gpio_port(GPIO_TypeDef *p_port);
+static void sim_lcd_reset_registers(void);
+static void sim_lcd_memory_write(uint8_t byte);
+static uint8_t sim_lcd_memory_read(void);
+static uint16_t sim_lcd_gram_row(uint16_t y);
+
+/*
+****************************************************
+********** Public Function Definitions *************
+****************************************************
+*/
+
+/*!
+* @brief Maps the GPIO ports and sets the idle level of every externally driven input
+* @param[in] NONE
+* @return NONE
+*/
+void
+sim_gpio_init(void)
+{
+   sim_register_device("GPIOA", &sim_gpioa, sizeof(sim_gpioa), sim_bus_ahb1, sim_gpio_read, sim_gpio_write);
+   sim_register_device("GPIOB", &sim_gpiob, sizeof(sim_gpiob), sim_bus_ahb1, sim_gpio_read, sim_gpio_write);
+   sim_register_device("GPIOC", &sim_gpioc, sizeof(sim_gpioc), sim_bus_ahb1, sim_gpio_read, sim_gpio_write);
+   sim_register_device("GPIOH", &sim_gpioh, sizeof(sim_gpioh), sim_bus_ahb1, sim_gpio_read, sim_gpio_write);
+
+   ports[0].p_port = &sim_gpioa;
+   ports[1].p_port = &sim_gpiob;
+   ports[2].p_port = &sim_gpioc;
+   ports[3].p_port = &sim_gpioh;
+
+   //Power button (PA0) and touch detect (PA1) idle high through pull-ups
+   ports[0].input_levels = (1ul << 0) | (1ul << 1);
+   ports[1].input_levels = 0;
+   ports[2].input_levels = 0;
+   ports[3].input_levels = 0;
+
+   for(uint8_t current_port = 0; current_port < 4; current_port++)
+   {
+      ports[current_port].alternate_pins = 0;
+      ports[current_port].alternate_levels = 0;
+   }
+
+   //Reset values from RM0401
+   sim_gpioa.MODER.raw = 0xA8000000;
+   sim_gpiob.MODER.raw = 0x00000280;
+}
+
+
+/*!
+* @brief Drives an input pin from outside the MCU, e.g. a button or jack detect
+* @param[in] p_port GPIO port
+* @param[in] pin Pin number
+* @param[in] level 0 or 1
+* @return NONE
+*/
+void
+sim_gpio_set_input(GPIO_TypeDef *p_port, uint8_t pin, uint8_t level)
+{
+   t_sim_port *p_sim_port = sim_gpio_port(p_port);
+   uint32_t old_levels = p_sim_port->input_levels;
+
+   if(level)
+   {
+      p_sim_port->input_levels |= (1ul << pin);
+   }
+
+   else
+   {
+      p_sim_port->input_levels &= ~(1ul << pin);
+   }
+
+   if(old_levels != p_sim_port->input_levels)
+   {
+      sim_exti_input_changed((uint8_t)(p_sim_port - ports), pin, level);
+   }
+}
+
+
+/*!
+* @brief A peripheral drives a pin through its alternate function. The level only reaches the
+*        pin while it is in alternate function mode, otherwise ODR does as usual
+* @param[in] p_port GPIO port
+* @param[in] pin Pin number
+* @param[in] level 0 or 1
+* @return NONE
+*/
+void
+sim_gpio_alternate_output(GPIO_TypeDef *p_port, uint8_t pin, uint8_t level)
+{
+   t_sim_port *p_sim_port = sim_gpio_port(p_port);
+   uint32_t old_levels = sim_gpio_output_levels(p_port);
+
+   p_sim_port->alternate_pins |= (1ul << pin);
+
+   if(level)
+   {
+      p_sim_port->alternate_levels |= (1ul << pin);
+   }
+
+   else
+   {
+      p_sim_port->alternate_levels &= ~(1ul << pin);
+   }
+
+   uint32_t new_levels = sim_gpio_output_levels(p_port);
+
+   if(old_levels != new_levels)
+   {
+      sim_gpio_odr_changed(p_port, old_levels, new_levels);
+   }
+}
+
+
+/*!
+* @brief Returns the output data register without charging bus time
+* @param[in] p_port GPIO port
+* @return ODR value
+*/
+uint32_t
+sim_gpio_get_odr(GPIO_TypeDef *p_port)
+{
+   return(p_port->ODR.raw);
+}
+
+
+/*!
+* @brief Powers up the display controller. GRAM holds noise until the firmware paints it,
+*        here it starts black.
+* @param[in] NONE
+* @return NONE
+*/
+void
+sim_lcd_init(void)
+{
+   memset(gram, 0, sizeof(gram));
+   sim_lcd_reset_registers();
+}
+
+
+/*!
+* @brief Latches one byte on the rising edge of WR
+* @param[in] rs 0 = command, 1 = data/parameter
+* @param[in] byte Value on DB0-DB7
+* @return NONE
+*/
+void
+sim_lcd_strobe(uint8_t rs, uint8_t byte)
+{
+   if(0 == rs)
+   {
+      sim_stats.lcd_commands++;
+      sim_stats.lcd_command_count[byte]++;
+      lcd.command = byte;
+      lcd.parameter_count = 0;
+
+      switch(byte)
+      {
+      case 0x01: //Software reset
+         sim_lcd_reset_registers();
+         break;
+      case 0x11: //Sleep out
+         lcd.sleeping = 0;
+         break;
+      case 0x10: //Sleep in
+         lcd.sleeping = 1;
+         break;
+      case 0x20: //Inversion off
+         lcd.inverted = 0;
+         break;
+      case 0x21: //Inversion on
+         lcd.inverted = 1;
+         break;
+      case 0x28: //Display off
+         lcd.display_on = 0;
+         break;
+      case 0x29: //Display on
+         lcd.display_on = 1;
+         break;
+      case 0x2C: //Memory write restarts at the window origin
+         lcd.x = lcd.column_start;
+         lcd.y = lcd.page_start;
+         lcd.byte_phase = 0;
+         break;
+      case 0x3C: //Memory write continue keeps the current position
+         lcd.byte_phase = 0;
+         break;
+      case 0x2E: //Memory read restarts at the window origin
+         lcd.x = lcd.column_start;
+         lcd.y = lcd.page_start;
+         lcd.read_phase = 0;
+         break;
+      default:
+         break;
+      }
+
+      return;
+   }
+
+   sim_stats.lcd_data_bytes++;
+
+   switch(lcd.command)
+   {
+   case 0x2C:
+   case 0x3C:
+      sim_lcd_memory_write(byte);
+      break;
+
+   case 0x2A:
+   case 0x2B:
+      if(4 > lcd.parameter_count)
+      {
+         lcd.parameters[lcd.parameter_count++] = byte;
+      }
+
+      if(4 == lcd.parameter_count)
+      {
+         uint16_t start = (uint16_t)((lcd.parameters[0] << 8) | lcd.parameters[1]);
+         uint16_t end = (uint16_t)((lcd.parameters[2] << 8) | lcd.parameters[3]);
+
+         if(0x2A == lcd.command)
+         {
+            lcd.column_start = start;
+            lcd.column_end = end;
+         }
+
+         else
+         {
+            lcd.page_start = start;
+            lcd.page_end = end;
+         }
+
+         lcd.parameter_count++;
+      }
+      break;
+
+   case 0x33: //Vertical scroll definition: top fixed area, scroll area, bottom fixed area
+      if(6 > lcd.parameter_count)
+      {
+         lcd.parameters[lcd.parameter_count++] = byte;
+      }
+
+      if(6 == lcd.parameter_count)
+      {
+         uint16_t top = (uint16_t)((lcd.parameters[0] << 8) | lcd.parameters[1]);
+         uint16_t height = (uint16_t)((lcd.parameters[2] << 8) | lcd.parameters[3]);
+         uint16_t bottom = (uint16_t)((lcd.parameters[4] << 8) | lcd.parameters[5]);
+
+         //The three areas must add up to the panel height, anything else is ignored by the part
+         if((0 < height) && (SIM_LCD_HEIGHT == (top + height + bottom)))
+         {
+            lcd.scroll_top = top;
+            lcd.scroll_height = height;
+         }
+
+         lcd.parameter_count++;
+      }
+      break;
+
+   case 0x37: //Vertical scroll start address
+      if(2 > lcd.parameter_count)
+      {
+         lcd.parameters[lcd.parameter_count++] = byte;
+      }
+
+      if(2 == lcd.parameter_count)
+      {
+         lcd.scroll_start = (uint16_t)((lcd.parameters[0] << 8) | lcd.parameters[1]);
+         lcd.parameter_count++;
+      }
+      break;
+
+   case 0x36:
+      lcd.madctl = byte;
+      break;
+
+   case 0x3A:
+      lcd.colmod = byte;
+      break;
+
+   case 0x00: //No command latched since reset
+      sim_stats.lcd_dropped_bytes++;
+      break;
+
+   default: //Vendor setup parameters (power, gamma, ...), accepted and ignored
+      if(16 > lcd.parameter_count)
+      {
+         lcd.parameters[lcd.parameter_count++] = byte;
+      }
+      break;
+   }
+}
+
+
+/*!
+* @brief Reads one pixel as RGB565, as it is shown on the panel
+* @param[in] x Column
+* @param[in] y Row
+* @return Pixel value
+*/
+uint16_t
+sim_lcd_get_pixel(uint16_t x, uint16_t y)
+{
+   return(((SIM_LCD_WIDTH > x) && (SIM_LCD_HEIGHT > y)) ? gram[sim_lcd_gram_row(y)][x] : 0);
+}
+
+
+/*!
+* @brief Fills GRAM directly, used by benchmarks to start from a known screen
+* @param[in] color RGB565 value
+* @return NONE
+*/
+void
+sim_lcd_fill(uint16_t color)
+{
+   for(uint16_t y = 0; y < SIM_LCD_HEIGHT; y++)
+   {
+      for(uint16_t x = 0; x < SIM_LCD_WIDTH; x++)
+      {
+         gram[y][x] = color;
+      }
+   }
+}
+
+
+/*!
+* @brief Starts counting the pixels of a GRAM area written from now on, to time how long the
+*        whole area takes to be covered once
+* @param[in] x_initial
+* @param[in] y_initial
+* @param[in] x_final Exclusive
+* @param[in] y_final Exclusive
+* @return NONE
+*/
+void
+sim_lcd_watch_area(uint16_t x_initial, uint16_t y_initial, uint16_t x_final, uint16_t y_final)
+{
+   memset(watch_written, 0, sizeof(watch_written));
+   watch.x_initial = x_initial;
+   watch.y_initial = y_initial;
+   watch.x_final = x_final;
+   watch.y_final = y_final;
+   watch.pixels_left = (uint32_t)(x_final - x_initial) * (y_final - y_initial);
+   watch.filled_at = 0;
+}
+
+
+/*!
+* @brief Time the watched area was covered
+* @param[in] NONE
+* @return sim_now when its last unwritten pixel was written, 0 if some still are not
+*/
+uint64_t
+sim_lcd_watch_filled(void)
+{
+   return(watch.filled_at);
+}
+
+
+/*!
+* @brief Saves the panel contents as a binary PPM
+* @param[in] p_path Output file
+* @return 1 on success, 0 on failure
+*/
+uint8_t
+sim_lcd_write_ppm(const char *p_path)
+{
+   FILE *p_file = fopen(p_path, "wb");
+
+   if(NULL == p_file)
+   {
+      return(0);
+   }
+
+   fprintf(p_file, "P6\n%d %d\n255\n", SIM_LCD_WIDTH, SIM_LCD_HEIGHT);
+
+   for(uint16_t y = 0; y < SIM_LCD_HEIGHT; y++)
+   {
+      for(uint16_t x = 0; x < SIM_LCD_WIDTH; x++)
+      {
+         uint16_t pixel = gram[sim_lcd_gram_row(y)][x];
+         uint8_t rgb[3];
+         rgb[0] = (uint8_t)(((pixel >> 11) & 0x1F) * 255 / 31);
+         rgb[1] = (uint8_t)(((pixel >> 5) & 0x3F) * 255 / 63);
+         rgb[2] = (uint8_t)((pixel & 0x1F) * 255 / 31);
+         fwrite(rgb, 1, 3, p_file);
+      }
+   }
+
+   fclose(p_file);
+   return(1);
+}
+
+
+/*!
+* @brief FNV-1a hash of the panel contents, used to check that an optimization draws the same screen
+* @param[in] NONE
+* @return 64-bit hash
+*/
+uint64_t
+sim_lcd_hash(void)
+{
+   uint64_t hash = 0xCBF29CE484222325ull;
+
+   for(uint16_t y = 0; y < SIM_LCD_HEIGHT; y++)
+   {
+      const uint8_t *p_bytes = (const uint8_t *)gram[sim_lcd_gram_row(y)];
+
+      for(size_t current_byte = 0; current_byte < sizeof(gram[0]); current_byte++)
+      {
+         hash ^= p_bytes[current_byte];
+         hash *= 0x100000001B3ull;
+      }
+   }
+
+   return(hash);
+}
+
+
+/*
+****************************************************
+********** Private Function Definitions ************
+****************************************************
+*/
+
+/*!
+* @brief IDR mirrors the output latch on output pins and the external level on inputs
+*/
+static uint32_t
+sim_gpio_read(uint32_t offset, sim_reg *p_reg)
+{
+   if(offsetof(GPIO_TypeDef, IDR) == offset)
+   {
+      GPIO_TypeDef *p_port = (GPIO_TypeDef *)((uint8_t *)p_reg - offset);
+      t_sim_port *p_sim_port = sim_gpio_port(p_port);
+      uint32_t moder = p_port->MODER.raw;
+      uint32_t idr = 0;
+
+      for(uint8_t pin = 0; pin < 16; pin++)
+      {
+         uint32_t mode = (moder >> (2 * pin)) & 0x3;
+         uint32_t level = (1 == mode) ? ((p_port->ODR.raw >> pin) & 1) : ((p_sim_port->input_levels >> pin) & 1);
+         idr |= (level << pin);
+      }
+
+      return(idr);
+   }
+
+   if(offsetof(GPIO_TypeDef, BSRR) == offset)
+   {
+      return(0); //Write only
+   }
+
+   return(p_reg->raw);
+}
+
+
+static void
+sim_gpio_write(uint32_t offset, sim_reg *p_reg, uint32_t value)
+{
+   GPIO_TypeDef *p_port = (GPIO_TypeDef *)((uint8_t *)p_reg - offset);
+   uint32_t old_levels = sim_gpio_output_levels(p_port);
+
+   if(offsetof(GPIO_TypeDef, BSRR) == offset)
+   {
+      uint32_t set_bits = value & 0xFFFF;
+      uint32_t reset_bits = (value >> 16) & ~set_bits; //Set wins when both are written
+      p_port->ODR.raw = (p_port->ODR.raw | set_bits) & ~reset_bits;
+   }
+
+   else if(offsetof(GPIO_TypeDef, ODR) == offset)
+   {
+      p_port->ODR.raw = value & 0xFFFF;
+   }
+
+   else if(offsetof(GPIO_TypeDef, IDR) == offset)
+   {
+      return; //Read only
+   }
+
+   else
+   {
+      p_reg->raw = value;
+
+      //Handing a pin to or from its alternate function can move it
+      if(offsetof(GPIO_TypeDef, MODER) != offset)
+      {
+         return;
+      }
+   }
+
+   uint32_t new_levels = sim_gpio_output_levels(p_port);
+
+   if(old_levels != new_levels)
+   {
+      sim_gpio_odr_changed(p_port, old_levels, new_levels);
+   }
+}
+
+
+/*!
+* @brief Wires output pins to the devices listening on them
+*/
+static void
+sim_gpio_odr_changed(GPIO_TypeDef *p_port, uint32_t old_odr, uint32_t new_odr)
+{
+   if(&sim_gpioa == p_port)
+   {
+      uint32_t rising = new_odr & ~old_odr;
+
+      if((rising & (1ul << SIM_LCD_WR_PIN)) && !(new_odr & (1ul << SIM_LCD_CS_PIN)))
+      {
+         sim_lcd_strobe((uint8_t)((new_odr >> SIM_LCD_RS_PIN) & 1), (uint8_t)(sim_gpiob.ODR.raw & 0xFF));
+      }
+
+      //The controller drives the data bus while RD is low, firmware samples it before raising RD
+      if((old_odr & ~new_odr & (1ul << SIM_LCD_RD_PIN)) && !(new_odr & (1ul << SIM_LCD_CS_PIN)) &&
+         (new_odr & (1ul << SIM_LCD_RS_PIN)))
+      {
+         ports[1].input_levels = (ports[1].input_levels & ~0xFFul) | sim_lcd_memory_read();
+      }
+   }
+
+   else if(&sim_gpioc == p_port)
+   {
+      //Releasing the LCD reset line restores the controller defaults, GRAM is retained
+      if((new_odr & ~old_odr) & (1ul << SIM_LCD_RESET_PIN))
+      {
+         sim_lcd_reset_registers();
+      }
+   }
+}
+
+
+/*!
+* @brief Level of each output pin: ODR, except pins in alternate function mode that a modeled
+*        peripheral drives
+*/
+static uint32_t
+sim_gpio_output_levels(GPIO_TypeDef *p_port)
+{
+   t_sim_port *p_sim_port = sim_gpio_port(p_port);
+   uint32_t alternate_pins = 0;
+
+   //Only the few pins a peripheral model drives are looked at, this runs on every GPIO write
+   for(uint32_t pins = p_sim_port->alternate_pins; 0 != pins; pins &= (pins - 1))
+   {
+      uint32_t pin = (uint32_t)__builtin_ctz(pins);
+
+      if(2 == ((p_port->MODER.raw >> (2 * pin)) & 0x3))
+      {
+         alternate_pins |= (1ul << pin);
+      }
+   }
+
+   return((p_port->ODR.raw & ~alternate_pins) | (p_sim_port->alternate_levels & alternate_pins));
+}
+
+
+static t_sim_port *
+sim_gpio_port(GPIO_TypeDef *p_port)
+{
+   for(uint8_t current_port = 0; current_port < 3; current_port++)
+   {
+      if(ports[current_port].p_port == p_port)
+      {
+         return(&ports[current_port]);
+      }
+   }
+
+   return(&ports[3]);
+}
+
+
+static void
+sim_lcd_reset_registers(void)
+{
+   memset(&lcd, 0, sizeof(lcd));
+   lcd.column_end = SIM_LCD_WIDTH - 1;
+   lcd.page_end = SIM_LCD_HEIGHT - 1;
+   lcd.scroll_height = SIM_LCD_HEIGHT;
+   lcd.sleeping = 1;
+}
+
+
+/*!
+* @brief Two bytes per pixel in 16bpp mode, high byte first. The write pointer runs left to
+*        right inside the column window and wraps to the next page, then back to the top.
+*/
+static void
+sim_lcd_memory_write(uint8_t byte)
+{
+   if(0 == lcd.byte_phase)
+   {
+      lcd.high_byte = byte;
+      lcd.byte_phase = 1;
+      return;
+   }
+
+   lcd.byte_phase = 0;
+   sim_stats.lcd_pixels++;
+
+   if((SIM_LCD_WIDTH > lcd.x) && (SIM_LCD_HEIGHT > lcd.y))
+   {
+      gram[lcd.y][lcd.x] = (uint16_t)((lcd.high_byte << 8) | byte);
+
+      if((0 < watch.pixels_left) && (lcd.x >= watch.x_initial) && (lcd.x < watch.x_final) &&
+         (lcd.y >= watch.y_initial) && (lcd.y < watch.y_final) && !watch_written[lcd.y][lcd.x])
+      {
+         watch_written[lcd.y][lcd.x] = 1;
+         watch.pixels_left--;
+
+         if(0 == watch.pixels_left)
+         {
+            watch.filled_at = sim_now;
+         }
+      }
+   }
+
+   if(lcd.x >= lcd.column_end)
+   {
+      lcd.x = lcd.column_start;
+
+      if(lcd.y >= lcd.page_end)
+      {
+         lcd.y = lcd.page_start;
+      }
+
+      else
+      {
+         lcd.y++;
+      }
+   }
+
+   else
+   {
+      lcd.x++;
+   }
+}
+
+
+/*!
+* @brief Next byte of a memory read. Pixels come out as 18-bit red, green and blue, each in the
+*        top six bits of a byte, with the 16-bit colors written expanded the way the part
+*        stores them. The read pointer moves through the window like the write pointer.
+*/
+static uint8_t
+sim_lcd_memory_read(void)
+{
+   if(0x2E != lcd.command)
+   {
+      return(0); //Register reads are not modeled
+   }
+
+   sim_stats.lcd_read_bytes++;
+
+   if(0 == lcd.read_phase)
+   {
+      lcd.read_phase = 1;
+      return(0); //Dummy byte
+   }
+
+   uint16_t pixel = ((SIM_LCD_WIDTH > lcd.x) && (SIM_LCD_HEIGHT > lcd.y)) ? gram[lcd.y][lcd.x] : 0;
+   uint8_t red = (uint8_t)(((pixel >> 11) << 1) | (pixel >> 15));
+   uint8_t green = (uint8_t)((pixel >> 5) & 0x3F);
+   uint8_t blue = (uint8_t)(((pixel & 0x1F) << 1) | ((pixel >> 4) & 1));
+   uint8_t channels[3] = {red, green, blue};
+   uint8_t byte = (uint8_t)(channels[lcd.read_phase - 1] << 2);
+
+   if(3 > lcd.read_phase)
+   {
+      lcd.read_phase++;
+      return(byte);
+   }
+
+   lcd.read_phase = 1;
+
+   if(lcd.x >= lcd.column_end)
+   {
+      lcd.x = lcd.column_start;
+      lcd.y = (lcd.y >= lcd.page_end) ? lcd.page_start : (uint16_t)(lcd.y + 1);
+   }
+
+   else
+   {
+      lcd.x++;
+   }
+
+   return(byte);
+}
+
+
+/*!
+* @brief GRAM line shown at a panel row. Rows of the scroll area start at the scroll start
+*        address and wrap around inside the area, the fixed areas are shown as they are.
+*/
+static uint16_t
+sim_lcd_gram_row(uint16_t y)
+{
+   if((y < lcd.scroll_top) || (y >= (lcd.scroll_top + lcd.scroll_height)))
+   {
+      return(y);
+   }
+
+   uint16_t start = lcd.scroll_start;
+
+   if((start < lcd.scroll_top) || (start >= (lcd.scroll_top + lcd.scroll_height)))
+   {
+      start = lcd.scroll_top;
+   }
+
+   return((uint16_t)(lcd.scroll_top + (((y - lcd.scroll_top) + (start - lcd.scroll_top)) % lcd.scroll_height)));
+}
+
+/* end of file */
@@ -0,0 +1,1460 @@
+/** @file sim_peripherals.cpp
+*
+* @brief  Models of the remaining STM32F410 peripherals used by the firmware: RCC, PWR, FLASH,
+*         SYSCFG/EXTI, TIM1/5/11, DMA1/2, DAC, ADC1 (touch panel and battery sense), RTC,
+*         USART1 and the core SCB/SysTick blocks. Also drives the external inputs (touch
+*         panel, power button, headphone jack, USB sense).
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#include "sim.h"
+#include <string.h>
+
+/*
+****************************************************
+*********** Simulated Register Blocks **************
+****************************************************
+*/
+DMA_TypeDef sim_dma1, sim_dma2;
+DMA_Stream_TypeDef sim_dma1_stream[8], sim_dma2_stream[8];
+DAC_TypeDef sim_dac;
+ADC_TypeDef sim_adc1;
+ADC_Common_TypeDef sim_adc_common;
+TIM_TypeDef sim_tim1, sim_tim5, sim_tim6, sim_tim9, sim_tim11;
+RTC_TypeDef sim_rtc;
+USART_TypeDef sim_usart1, sim_usart2, sim_usart6;
+EXTI_TypeDef sim_exti;
+RCC_TypeDef sim_rcc;
+PWR_TypeDef sim_pwr;
+FLASH_TypeDef sim_flash;
+SYSCFG_TypeDef sim_syscfg;
+SCB_Type sim_scb;
+SysTick_Type sim_systick;
+
+/*
+****************************************************
+************** Peripheral Constants ****************
+****************************************************
+*/
+#define SIM_TIMER_CLOCK_DIVIDER 1          //TIMxCLK = HCLK on both APB buses with this clock tree
+#define SIM_ADC_CONVERSION_CYCLES 108      //(15 sample + 12 conversion) ADC clocks at PCLK2/4
+#define SIM_DMA_ITEM_CYCLES 4              //Memory-to-memory item transfer
+#define SIM_RTC_START_SECONDS ((10 * 3600) + (9 * 60)) //10:09:00 AM on every power up
+
+/*
+****************************************************
+************* File-Static Variables ****************
+****************************************************
+*/
+typedef struct t_sim_timer
+{
+   TIM_TypeDef *p_timer;
+   const char *name;
+   int irq_number;
+   int event_slot;
+   int compare_slot;        //Channel 1 compare, -1 if the channel is not modeled
+   int compare2_slot;       //Channel 2 compare, only its DMA request is modeled, -1 if not modeled
+   uint64_t period_start;
+   uint32_t repetition;     //Overflows left before the next update event, reloaded from RCR
+   uint8_t channel1_level;  //OC1REF
+
+} t_sim_timer;
+
+typedef struct t_sim_dma_stream
+{
+   uint8_t controller;     //1 or 2
+   uint8_t number;
+   int irq_number;
+   uint32_t memory_address;
+   uint32_t peripheral_address;
+   uint32_t remaining;
+
+} t_sim_dma_stream;
+
+typedef struct t_sim_uart
+{
+   int event_slot;
+   uint8_t shifter_active;
+   uint8_t tdr_full;
+   uint8_t tdr;
+   FILE *p_log;
+
+} t_sim_uart;
+
+typedef struct t_sim_adc
+{
+   int event_slot;
+   uint8_t sequence_index;
+   uint8_t sequence_length;
+
+} t_sim_adc;
+
+typedef struct t_sim_rtc
+{
+   int event_slot;
+   uint32_t base_seconds;   //Seconds since midnight when the calendar was last loaded
+   uint64_t base_cycle;
+
+} t_sim_rtc;
+
+typedef struct t_sim_inputs
+{
+   uint8_t touched;
+   uint16_t touch_x;
+   uint16_t touch_y;
+   uint16_t battery_adc;
+   int touch_release_slot;
+   int button_release_slot;
+
+} t_sim_inputs;
+
+typedef struct t_sim_systick
+{
+   int event_slot;
+   uint64_t period_start;   //Cycle VAL was last reloaded from LOAD
+
+} t_sim_systick;
+
+static t_sim_timer timers[3];
+static t_sim_dma_stream dma_streams[2][8];
+static int dma_m2m_slot[2];
+static t_sim_uart uart;
+static t_sim_adc adc;
+static t_sim_rtc rtc;
+static t_sim_inputs inputs;
+static t_sim_systick systick;
+
+static const int dma1_irqs[8] = {DMA1_Stream0_IRQn, DMA1_Stream1_IRQn, DMA1_Stream2_IRQn, DMA1_Stream3_IRQn,
+                                 DMA1_Stream4_IRQn, DMA1_Stream5_IRQn, DMA1_Stream6_IRQn, DMA1_Stream7_IRQn};
+static const int dma2_irqs[8] = {DMA2_Stream0_IRQn, DMA2_Stream1_IRQn, DMA2_Stream2_IRQn, DMA2_Stream3_IRQn,
+                                 DMA2_Stream4_IRQn, DMA2_Stream5_IRQn, DMA2_Stream6_IRQn, DMA2_Stream7_IRQn};
+
+/*
+****************************************************
+********** Private Function Prototypes *************
+****************************************************
+*/
+static uint32_t sim_rcc_read(uint32_t offset, sim_reg *p_reg);
+static void sim_rcc_write(uint32_t offset, sim_reg *p_reg, uint32_t value);
+static void sim_exti_write(uint32_t offset, sim_reg *p_reg, uint32_t value);
+static void sim_exti_raise(uint8_t line);
+static t_sim_timer *sim_timer_find(sim_reg *p_reg, uint32_t offset);
+static uint32_t sim_timer_read(uint32_t offset, sim_reg *p_reg);
+static void sim_timer_write(uint32_t offset, sim_reg *p_reg, uint32_t value);
+static void sim_timer_update(t_sim_timer *p_sim_timer, uint8_t software_generated);
+static void sim_timer_schedule(t_sim_timer *p_sim_timer);
+static void sim_timer_event(uint64_t when);
+static void sim_timer_compare_schedule(t_sim_timer *p_sim_timer);
+static void sim_timer_compare_event(uint64_t when);
+static void sim_timer_compare2_event(uint64_t when);
+static void sim_timer_channel1_output(t_sim_timer *p_sim_timer, uint8_t level);
+static uint32_t sim_dma_read_reg(uint32_t offset, sim_reg *p_reg);
+static void sim_dma_write_reg(uint32_t offset, sim_reg *p_reg, uint32_t value);
+static void sim_dma_stream_write(uint32_t offset, sim_reg *p_reg, uint32_t value);
+static uint32_t sim_dma_stream_read(uint32_t offset, sim_reg *p_reg);
+static void sim_dma_transfer_item(t_sim_dma_stream *p_stream);
+static void sim_dma_set_flag(t_sim_dma_stream *p_stream, uint32_t flag);
+static void sim_dma_m2m_event(uint64_t when);
+static uint32_t sim_adc_read(uint32_t offset, sim_reg *p_reg);
+static void sim_adc_write(uint32_t offset, sim_reg *p_reg, uint32_t value);
+static void sim_adc_event(uint64_t when);
+static uint16_t sim_adc_channel_value(uint8_t channel);
+static uint32_t sim_rtc_read(uint32_t offset, sim_reg *p_reg);
+static void sim_rtc_write(uint32_t offset, sim_reg *p_reg, uint32_t value);
+static void sim_rtc_event(uint64_t when);
+static uint32_t sim_rtc_seconds(void);
+static uint32_t sim_rtc_encode(uint32_t seconds);
+static uint32_t sim_rtc_decode(uint32_t time_register);
+static void sim_rtc_reset(void);
+static uint32_t sim_uart_read(uint32_t offset, sim_reg *p_reg);
+static void sim_uart_write(uint32_t offset, sim_reg *p_reg, uint32_t value);
+static void sim_uart_start(uint8_t byte);
+static void sim_uart_event(uint64_t when);
+static uint32_t sim_systick_read(uint32_t offset, sim_reg *p_reg);
+static void sim_systick_write(uint32_t offset, sim_reg *p_reg, uint32_t value);
+static void sim_systick_event(uint64_t when);
+static void sim_touch_release(uint64_t when);
+static void sim_power_button_release(uint64_t when);
+
+/*
+****************************************************
+********** Public Function Definitions *************
+****************************************************
+*/
+
+/*!
+* @brief Maps every remaining peripheral and puts it in its reset state
+* @param[in] NONE
+* @return NONE
+*/
+void
+sim_peripherals_init(void)
+{
+   sim_register_device("RCC", &sim_rcc, sizeof(sim_rcc), sim_bus_ahb1, sim_rcc_read, sim_rcc_write);
+   sim_register_device("FLASH", &sim_flash, sizeof(sim_flash), sim_bus_ahb1, NULL, NULL);
+   sim_register_device("PWR", &sim_pwr, sizeof(sim_pwr), sim_bus_apb1, NULL, NULL);
+   sim_register_device("SYSCFG", &sim_syscfg, sizeof(sim_syscfg), sim_bus_apb2, NULL, NULL);
+   sim_register_device("EXTI", &sim_exti, sizeof(sim_exti), sim_bus_apb2, NULL, sim_exti_write);
+   sim_register_device("SCB", &sim_scb, sizeof(sim_scb), sim_bus_core, NULL, NULL);
+   sim_register_device("SysTick", &sim_systick, sizeof(sim_systick), sim_bus_core, sim_systick_read, sim_systick_write);
+   sim_register_device("DAC", &sim_dac, sizeof(sim_dac), sim_bus_apb1, NULL, NULL);
+   sim_register_device("TIM1", &sim_tim1, sizeof(sim_tim1), sim_bus_apb2, sim_timer_read, sim_timer_write);
+   sim_register_device("TIM5", &sim_tim5, sizeof(sim_tim5), sim_bus_apb1, sim_timer_read, sim_timer_write);
+   sim_register_device("TIM6", &sim_tim6, sizeof(sim_tim6), sim_bus_apb1, NULL, NULL);
+   sim_register_device("TIM9", &sim_tim9, sizeof(sim_tim9), sim_bus_apb2, NULL, NULL);
+   sim_register_device("TIM11", &sim_tim11, sizeof(sim_tim11), sim_bus_apb2, sim_timer_read, sim_timer_write);
+   sim_register_device("DMA1", &sim_dma1, sizeof(sim_dma1), sim_bus_ahb1, sim_dma_read_reg, sim_dma_write_reg);
+   sim_register_device("DMA2", &sim_dma2, sizeof(sim_dma2), sim_bus_ahb1, sim_dma_read_reg, sim_dma_write_reg);
+   sim_register_device("DMA1 streams", sim_dma1_stream, sizeof(sim_dma1_stream), sim_bus_ahb1, sim_dma_stream_read, sim_dma_stream_write);
+   sim_register_device("DMA2 streams", sim_dma2_stream, sizeof(sim_dma2_stream), sim_bus_ahb1, sim_dma_stream_read, sim_dma_stream_write);
+   sim_register_device("ADC1", &sim_adc1, sizeof(sim_adc1), sim_bus_apb2, sim_adc_read, sim_adc_write);
+   sim_register_device("ADC common", &sim_adc_common, sizeof(sim_adc_common), sim_bus_apb2, NULL, NULL);
+   sim_register_device("RTC", &sim_rtc, sizeof(sim_rtc), sim_bus_apb1, sim_rtc_read, sim_rtc_write);
+   sim_register_device("USART1", &sim_usart1, sizeof(sim_usart1), sim_bus_apb2, sim_uart_read, sim_uart_write);
+   sim_register_device("USART2", &sim_usart2, sizeof(sim_usart2), sim_bus_apb1, NULL, NULL);
+   sim_register_device("USART6", &sim_usart6, sizeof(sim_usart6), sim_bus_apb2, NULL, NULL);
+
+   memset(timers, 0, sizeof(timers));
+   timers[0].p_timer = &sim_tim1;
+   timers[0].name = "tim1 update";
+   timers[0].irq_number = TIM1_UP_IRQn;
+   timers[1].p_timer = &sim_tim5;
+   timers[1].name = "tim5 update";
+   timers[1].irq_number = TIM5_IRQn;
+   timers[2].p_timer = &sim_tim11;
+   timers[2].name = "tim11 update";
+   timers[2].irq_number = TIM1_TRG_COM_TIM11_IRQn;
+
+   for(uint8_t current_timer = 0; current_timer < 3; current_timer++)
+   {
+      timers[current_timer].event_slot = sim_event_register(timers[current_timer].name, sim_timer_event);
+      timers[current_timer].compare_slot = -1;
+      timers[current_timer].compare2_slot = -1;
+      timers[current_timer].p_timer->ARR.raw = 0xFFFF;
+   }
+
+   //TIM1 channel 1 drives PA8 (LCD_WR), channel 2 requests DMA2 stream 2
+   timers[0].compare_slot = sim_event_register("tim1 compare 1", sim_timer_compare_event);
+   timers[0].compare2_slot = sim_event_register("tim1 compare 2", sim_timer_compare2_event);
+
+   for(uint8_t current_stream = 0; current_stream < 8; current_stream++)
+   {
+      dma_streams[0][current_stream].controller = 1;
+      dma_streams[0][current_stream].number = current_stream;
+      dma_streams[0][current_stream].irq_number = dma1_irqs[current_stream];
+      dma_streams[0][current_stream].remaining = 0;
+      dma_streams[1][current_stream].controller = 2;
+      dma_streams[1][current_stream].number = current_stream;
+      dma_streams[1][current_stream].irq_number = dma2_irqs[current_stream];
+      dma_streams[1][current_stream].remaining = 0;
+   }
+
+   dma_m2m_slot[0] = sim_event_register("dma1 mem2mem", sim_dma_m2m_event);
+   dma_m2m_slot[1] = sim_event_register("dma2 mem2mem", sim_dma_m2m_event);
+
+   FILE *p_log = uart.p_log;
+   memset(&uart, 0, sizeof(uart));
+   uart.p_log = p_log;
+   uart.event_slot = sim_event_register("usart1 shifter", sim_uart_event);
+   sim_usart1.SR.raw = USART_SR_TC | USART_SR_TXE;
+
+   memset(&adc, 0, sizeof(adc));
+   adc.event_slot = sim_event_register("adc1 conversion", sim_adc_event);
+
+   memset(&systick, 0, sizeof(systick));
+   systick.event_slot = sim_event_register("systick reload", sim_systick_event);
+
+   rtc.event_slot = sim_event_register("rtc second", sim_rtc_event);
+   sim_rtc_reset();
+   sim_event_schedule(rtc.event_slot, SIM_CPU_HZ);
+
+   memset(&inputs, 0, sizeof(inputs));
+   inputs.battery_adc = 2000;
+   inputs.touch_release_slot = sim_event_register("touch release", sim_touch_release);
+   inputs.button_release_slot = sim_event_register("power button release", sim_power_button_release);
+
+   //Reset values from RM0401
+   sim_rcc.CR.raw = RCC_CR_HSION | RCC_CR_HSIRDY;
+   sim_systick.CALIB.raw = 0x4000000;
+}
+
+
+/*!
+* @brief Presses the touch panel for a while. The touch detect line (PA1) falls, which fires
+*        EXTI1, and the panel ADC channels read the position until release.
+* @param[in] x Screen column
+* @param[in] y Screen row
+* @param[in] duration_ms How long the finger stays down
+* @return NONE
+*/
+void
+sim_touch_press(uint16_t x, uint16_t y, uint32_t duration_ms)
+{
+   inputs.touched = 1;
+   inputs.touch_x = x;
+   inputs.touch_y = y;
+   sim_gpio_set_input(GPIOA, 1, 0);
+   sim_event_schedule(inputs.touch_release_slot, sim_now + (duration_ms * SIM_CYCLES_PER_MS));
+}
+
+
+/*!
+* @brief Holds the main power button (PA0, active low)
+* @param[in] duration_ms How long the button stays down
+* @return NONE
+*/
+void
+sim_power_button_press(uint32_t duration_ms)
+{
+   sim_gpio_set_input(GPIOA, 0, 0);
+   sim_event_schedule(inputs.button_release_slot, sim_now + (duration_ms * SIM_CYCLES_PER_MS));
+}
+
+
+/*!
+* @brief Plugs or unplugs the headphones (PA3, high when inserted)
+* @param[in] inserted 1 = plugged in
+* @return NONE
+*/
+void
+sim_set_headphones(uint8_t inserted)
+{
+   sim_gpio_set_input(GPIOA, 3, inserted);
+}
+
+
+/*!
+* @brief Connects or disconnects USB power (PC1)
+* @param[in] connected 1 = connected
+* @return NONE
+*/
+void
+sim_set_usb(uint8_t connected)
+{
+   sim_gpio_set_input(GPIOC, 1, connected);
+}
+
+
+/*!
+* @brief Sets the raw ADC reading of the battery divider (ADC channel 7)
+* @param[in] value 12-bit ADC value
+* @return NONE
+*/
+void
+sim_set_battery_adc(uint16_t value)
+{
+   inputs.battery_adc = value;
+}
+
+
+/*!
+* @brief Selects where characters sent on USART1 are written
+* @param[in] p_log Stream, or NULL to discard
+* @return NONE
+*/
+void
+sim_uart_set_log(FILE *p_log)
+{
+   uart.p_log = p_log;
+}
+
+
+/*!
+* @brief A peripheral asserts its DMA request line. One item is moved if the stream is on.
+* @param[in] controller 1 or 2
+* @param[in] stream Stream number 0-7
+* @return NONE
+*/
+void
+sim_dma_request(uint8_t controller, uint8_t stream)
+{
+   DMA_Stream_TypeDef *p_registers = (1 == controller) ? &sim_dma1_stream[stream] : &sim_dma2_stream[stream];
+
+   if(p_registers->CR.raw & DMA_SxCR_EN)
+   {
+      sim_dma_transfer_item(&dma_streams[controller - 1][stream]);
+   }
+}
+
+
+/*!
+* @brief Edge detection for the EXTI lines. Called whenever an external input changes level.
+* @param[in] port_index 0 = GPIOA, 1 = GPIOB, 2 = GPIOC
+* @param[in] pin Pin number, which is also the EXTI line
+* @param[in] level New level
+* @return NONE
+*/
+void
+sim_exti_input_changed(uint8_t port_index, uint8_t pin, uint8_t level)
+{
+   uint32_t selected_port = (sim_syscfg.EXTICR[pin / 4].raw >> (4 * (pin % 4))) & 0xF;
+   uint32_t line_mask = 1ul << pin;
+
+   if(selected_port != port_index)
+   {
+      return;
+   }
+
+   if((level && (sim_exti.RTSR.raw & line_mask)) || (!level && (sim_exti.FTSR.raw & line_mask)))
+   {
+      sim_exti.PR.raw |= line_mask;
+
+      if(sim_exti.IMR.raw & line_mask)
+      {
+         sim_exti_raise(pin);
+      }
+   }
+}
+
+
+/*
+****************************************************
+********** Private Function Definitions ************
+****************************************************
+*/
+
+/*!
+* @brief Oscillators and the PLL lock as soon as they are enabled
+*/
+static uint32_t
+sim_rcc_read(uint32_t offset, sim_reg *p_reg)
+{
+   uint32_t value = p_reg->raw;
+
+   if(offsetof(RCC_TypeDef, CR) == offset)
+   {
+      value &= ~(RCC_CR_HSIRDY | RCC_CR_HSERDY | RCC_CR_PLLRDY);
+      value |= (value & RCC_CR_HSION) ? RCC_CR_HSIRDY : 0;
+      value |= (value & RCC_CR_HSEON) ? RCC_CR_HSERDY : 0;
+      value |= (value & RCC_CR_PLLON) ? RCC_CR_PLLRDY : 0;
+   }
+
+   else if(offsetof(RCC_TypeDef, CFGR) == offset)
+   {
+      value &= ~RCC_CFGR_SWS_Msk;
+      value |= ((value & RCC_CFGR_SW_Msk) << RCC_CFGR_SWS_Pos);
+   }
+
+   else if(offsetof(RCC_TypeDef, BDCR) == offset)
+   {
+      value &= ~RCC_BDCR_LSERDY;
+      value |= (value & RCC_BDCR_LSEON) ? RCC_BDCR_LSERDY : 0;
+   }
+
+   return(value);
+}
+
+
+static void
+sim_rcc_write(uint32_t offset, sim_reg *p_reg, uint32_t value)
+{
+   uint32_t old_value = p_reg->raw;
+   p_reg->raw = value;
+
+   //Backup domain reset clears the RTC
+   if((offsetof(RCC_TypeDef, BDCR) == offset) && (value & RCC_BDCR_BDRST) && !(old_value & RCC_BDCR_BDRST))
+   {
+      sim_rtc_reset();
+   }
+}
+
+
+static void
+sim_exti_write(uint32_t offset, sim_reg *p_reg, uint32_t value)
+{
+   if(offsetof(EXTI_TypeDef, PR) == offset)
+   {
+      p_reg->raw &= ~value; //Write 1 to clear
+      return;
+   }
+
+   p_reg->raw = value;
+
+   //Unmasking a line with a latched edge asserts its interrupt
+   if(offsetof(EXTI_TypeDef, IMR) == offset)
+   {
+      uint32_t pending = sim_exti.PR.raw & value;
+
+      for(uint8_t line = 0; line < 16; line++)
+      {
+         if(pending & (1ul << line))
+         {
+            sim_exti_raise(line);
+         }
+      }
+   }
+}
+
+
+static void
+sim_exti_raise(uint8_t line)
+{
+   if(4 >= line)
+   {
+      sim_irq_raise(EXTI0_IRQn + line);
+   }
+}
+
+
+static t_sim_timer *
+sim_timer_find(sim_reg *p_reg, uint32_t offset)
+{
+   TIM_TypeDef *p_timer = (TIM_TypeDef *)((uint8_t *)p_reg - offset);
+
+   for(uint8_t current_timer = 0; current_timer < 3; current_timer++)
+   {
+      if(timers[current_timer].p_timer == p_timer)
+      {
+         return(&timers[current_timer]);
+      }
+   }
+
+   return(NULL);
+}
+
+
+static uint32_t
+sim_timer_read(uint32_t offset, sim_reg *p_reg)
+{
+   if(offsetof(TIM_TypeDef, CNT) == offset)
+   {
+      t_sim_timer *p_sim_timer = sim_timer_find(p_reg, offset);
+      TIM_TypeDef *p_timer = p_sim_timer->p_timer;
+
+      if(p_timer->CR1.raw & TIM_CR1_CEN)
+      {
+         uint64_t ticks = (sim_now - p_sim_timer->period_start) / (SIM_TIMER_CLOCK_DIVIDER * (p_timer->PSC.raw + 1));
+         return((uint32_t)(ticks % ((uint64_t)p_timer->ARR.raw + 1)));
+      }
+   }
+
+   return(p_reg->raw);
+}
+
+
+static void
+sim_timer_write(uint32_t offset, sim_reg *p_reg, uint32_t value)
+{
+   t_sim_timer *p_sim_timer = sim_timer_find(p_reg, offset);
+   uint32_t old_value = p_reg->raw;
+
+   if(offsetof(TIM_TypeDef, SR) == offset)
+   {
+      p_reg->raw &= value; //Status flags are cleared by writing 0
+      return;
+   }
+
+   if(offsetof(TIM_TypeDef, EGR) == offset)
+   {
+      if(value & TIM_EGR_UG)
+      {
+         sim_timer_update(p_sim_timer, 1);
+         sim_timer_channel1_output(p_sim_timer, 0 == p_sim_timer->p_timer->CCR1.raw); //Counter back to 0
+      }
+
+      return;
+   }
+
+   p_reg->raw = value;
+
+   if(offsetof(TIM_TypeDef, CR1) == offset)
+   {
+      if((value & TIM_CR1_CEN) && !(old_value & TIM_CR1_CEN))
+      {
+         p_sim_timer->period_start = sim_now;
+         sim_timer_schedule(p_sim_timer);
+         sim_timer_channel1_output(p_sim_timer, 0 == p_sim_timer->p_timer->CCR1.raw);
+         sim_timer_compare_schedule(p_sim_timer);
+      }
+
+      else if(!(value & TIM_CR1_CEN))
+      {
+         sim_event_cancel(p_sim_timer->event_slot);
+
+         if(0 <= p_sim_timer->compare_slot)
+         {
+            sim_event_cancel(p_sim_timer->compare_slot);
+         }
+
+         if(0 <= p_sim_timer->compare2_slot)
+         {
+            sim_event_cancel(p_sim_timer->compare2_slot);
+         }
+      }
+   }
+
+   else if(offsetof(TIM_TypeDef, DIER) == offset)
+   {
+      //Enabling UIE with UIF already set asserts the interrupt
+      if((value & TIM_DIER_UIE) && !(old_value & TIM_DIER_UIE) && (p_sim_timer->p_timer->SR.raw & TIM_SR_UIF))
+      {
+         sim_irq_raise(p_sim_timer->irq_number);
+      }
+   }
+}
+
+
+/*!
+* @brief Update event: sets UIF, drives TRGO (TIM5 -> DAC) and the update DMA request (TIM1)
+*/
+static void
+sim_timer_update(t_sim_timer *p_sim_timer, uint8_t software_generated)
+{
+   TIM_TypeDef *p_timer = p_sim_timer->p_timer;
+
+   p_sim_timer->period_start = sim_now;
+   p_sim_timer->repetition = p_timer->RCR.raw & 0xFF;
+
+   if(software_generated && (p_timer->CR1.raw & TIM_CR1_URS))
+   {
+      return; //URS: only counter overflow raises UIF and DMA requests
+   }
+
+   p_timer->SR.raw |= TIM_SR_UIF;
+
+   if(p_timer->DIER.raw & TIM_DIER_UIE)
+   {
+      sim_irq_raise(p_sim_timer->irq_number);
+   }
+
+   if((&sim_tim1 == p_timer) && (p_timer->DIER.raw & TIM_DIER_UDE))
+   {
+      sim_dma_request(2, 5); //TIM1_UP is DMA2 stream 5 channel 6
+   }
+
+   //TIM5 TRGO on update (MMS = 010) triggers DAC channel 1 (TSEL1 = 011)
+   if((&sim_tim5 == p_timer) && (TIM_CR2_MMS_1 == (p_timer->CR2.raw & (TIM_CR2_MMS_0 | TIM_CR2_MMS_1 | TIM_CR2_MMS_2))) &&
+      (sim_dac.CR.raw & DAC_CR_EN1) && (sim_dac.CR.raw & DAC_CR_TEN1) && (sim_dac.CR.raw & DAC_CR_DMAEN1))
+   {
+      sim_dma_request(1, 5); //DAC1 is DMA1 stream 5 channel 7
+   }
+}
+
+
+static void
+sim_timer_schedule(t_sim_timer *p_sim_timer)
+{
+   TIM_TypeDef *p_timer = p_sim_timer->p_timer;
+   uint64_t period = SIM_TIMER_CLOCK_DIVIDER * ((uint64_t)p_timer->PSC.raw + 1) * ((uint64_t)p_timer->ARR.raw + 1);
+
+   sim_event_schedule(p_sim_timer->event_slot, p_sim_timer->period_start + period);
+}
+
+
+static void
+sim_timer_event(uint64_t when)
+{
+   for(uint8_t current_timer = 0; current_timer < 3; current_timer++)
+   {
+      t_sim_timer *p_sim_timer = &timers[current_timer];
+
+      if(!sim_event_pending(p_sim_timer->event_slot) && (p_sim_timer->p_timer->CR1.raw & TIM_CR1_CEN))
+      {
+         uint64_t period = SIM_TIMER_CLOCK_DIVIDER * ((uint64_t)p_sim_timer->p_timer->PSC.raw + 1) *
+                           ((uint64_t)p_sim_timer->p_timer->ARR.raw + 1);
+
+         if((p_sim_timer->period_start + period) <= when)
+         {
+            uint64_t next_period_start = p_sim_timer->period_start + period;
+
+            sim_timer_channel1_output(p_sim_timer, 0 == p_sim_timer->p_timer->CCR1.raw);
+
+            //With a repetition count only the last overflow is an update event
+            if(0 < p_sim_timer->repetition)
+            {
+               p_sim_timer->repetition--;
+            }
+
+            else
+            {
+               sim_timer_update(p_sim_timer, 0);
+
+               //One pulse mode stops the counter at the update event
+               if(p_sim_timer->p_timer->CR1.raw & TIM_CR1_OPM)
+               {
+                  p_sim_timer->p_timer->CR1.raw &= ~TIM_CR1_CEN;
+                  return;
+               }
+            }
+
+            p_sim_timer->period_start = next_period_start;
+            sim_timer_schedule(p_sim_timer);
+            sim_timer_compare_schedule(p_sim_timer);
+            return;
+         }
+      }
+   }
+}
+
+
+/*!
+* @brief Schedules the channel 1 and 2 matches of the current period, when the channel is
+*        modeled and its CCR falls inside the period
+*/
+static void
+sim_timer_compare_schedule(t_sim_timer *p_sim_timer)
+{
+   TIM_TypeDef *p_timer = p_sim_timer->p_timer;
+   uint64_t tick = SIM_TIMER_CLOCK_DIVIDER * ((uint64_t)p_timer->PSC.raw + 1);
+
+   if((0 <= p_sim_timer->compare_slot) && (0 != p_timer->CCR1.raw) && (p_timer->CCR1.raw <= p_timer->ARR.raw))
+   {
+      sim_event_schedule(p_sim_timer->compare_slot, p_sim_timer->period_start + (tick * p_timer->CCR1.raw));
+   }
+
+   if((0 <= p_sim_timer->compare2_slot) && (0 != p_timer->CCR2.raw) && (p_timer->CCR2.raw <= p_timer->ARR.raw))
+   {
+      sim_event_schedule(p_sim_timer->compare2_slot, p_sim_timer->period_start + (tick * p_timer->CCR2.raw));
+   }
+}
+
+
+/*!
+* @brief Counter reached CCR1: OC1REF changes level, CC1IF is set and the CC1 DMA request
+*        is asserted. The pin moves before the DMA stream writes anything
+*/
+static void
+sim_timer_compare_event(uint64_t when)
+{
+   (void)when;
+
+   for(uint8_t current_timer = 0; current_timer < 3; current_timer++)
+   {
+      t_sim_timer *p_sim_timer = &timers[current_timer];
+      TIM_TypeDef *p_timer = p_sim_timer->p_timer;
+
+      if((0 > p_sim_timer->compare_slot) || sim_event_pending(p_sim_timer->compare_slot) || !(p_timer->CR1.raw & TIM_CR1_CEN))
+      {
+         continue;
+      }
+
+      sim_timer_channel1_output(p_sim_timer, 1);
+      p_timer->SR.raw |= TIM_SR_CC1IF;
+
+      if((&sim_tim1 == p_timer) && (p_timer->DIER.raw & TIM_DIER_CC1DE))
+      {
+         sim_dma_request(2, 1); //TIM1_CH1 is DMA2 stream 1 channel 6
+      }
+   }
+}
+
+
+/*!
+* @brief Counter reached CCR2: CC2IF is set and the CC2 DMA request is asserted
+*/
+static void
+sim_timer_compare2_event(uint64_t when)
+{
+   (void)when;
+
+   for(uint8_t current_timer = 0; current_timer < 3; current_timer++)
+   {
+      t_sim_timer *p_sim_timer = &timers[current_timer];
+      TIM_TypeDef *p_timer = p_sim_timer->p_timer;
+
+      if((0 > p_sim_timer->compare2_slot) || sim_event_pending(p_sim_timer->compare2_slot) || !(p_timer->CR1.raw & TIM_CR1_CEN))
+      {
+         continue;
+      }
+
+      p_timer->SR.raw |= TIM_SR_CC2IF;
+
+      if((&sim_tim1 == p_timer) && (p_timer->DIER.raw & TIM_DIER_CC2DE))
+      {
+         sim_dma_request(2, 2); //TIM1_CH2 is DMA2 stream 2 channel 6
+      }
+   }
+}
+
+
+/*!
+* @brief Sets OC1REF from the counter position and passes it to the pin. PWM mode 1 is high
+*        below CCR1, PWM mode 2 is high from CCR1 on; other modes are not modeled
+* @param[in] p_sim_timer
+* @param[in] at_or_above_compare 1 once the counter has reached CCR1 in this period
+*/
+static void
+sim_timer_channel1_output(t_sim_timer *p_sim_timer, uint8_t at_or_above_compare)
+{
+   TIM_TypeDef *p_timer = p_sim_timer->p_timer;
+   uint32_t mode = p_timer->CCMR1.raw & TIM_CCMR1_OC1M_Msk;
+   uint8_t level = 0;
+
+   if(0 > p_sim_timer->compare_slot)
+   {
+      return;
+   }
+
+   if((TIM_CCMR1_OC1M_2 | TIM_CCMR1_OC1M_1) == mode)
+   {
+      level = !at_or_above_compare;
+   }
+
+   else if((TIM_CCMR1_OC1M_2 | TIM_CCMR1_OC1M_1 | TIM_CCMR1_OC1M_0) == mode)
+   {
+      level = at_or_above_compare;
+   }
+
+   else
+   {
+      return;
+   }
+
+   p_sim_timer->channel1_level = level;
+
+   //Advanced timer outputs also need the main output enable
+   if((p_timer->CCER.raw & TIM_CCER_CC1E) && (p_timer->BDTR.raw & TIM_BDTR_MOE))
+   {
+      sim_gpio_alternate_output(&sim_gpioa, 8, level);
+   }
+}
+
+
+static uint32_t
+sim_dma_read_reg(uint32_t offset, sim_reg *p_reg)
+{
+   (void)offset;
+   return(p_reg->raw);
+}
+
+
+static void
+sim_dma_write_reg(uint32_t offset, sim_reg *p_reg, uint32_t value)
+{
+   DMA_TypeDef *p_dma = (DMA_TypeDef *)((uint8_t *)p_reg - offset);
+
+   if(offsetof(DMA_TypeDef, LIFCR) == offset)
+   {
+      p_dma->LISR.raw &= ~value;
+   }
+
+   else if(offsetof(DMA_TypeDef, HIFCR) == offset)
+   {
+      p_dma->HISR.raw &= ~value;
+   }
+
+   //LISR and HISR are read only
+}
+
+
+static t_sim_dma_stream *
+sim_dma_stream_lookup(sim_reg *p_reg, uint32_t offset, DMA_Stream_TypeDef **pp_registers)
+{
+   uint32_t stream_index = offset / sizeof(DMA_Stream_TypeDef);
+   uint32_t register_offset = offset % sizeof(DMA_Stream_TypeDef);
+   DMA_Stream_TypeDef *p_registers = (DMA_Stream_TypeDef *)((uint8_t *)p_reg - register_offset);
+
+   *pp_registers = p_registers;
+   return(&dma_streams[(&sim_dma2_stream[stream_index] == p_registers) ? 1 : 0][stream_index]);
+}
+
+
+static uint32_t
+sim_dma_stream_read(uint32_t offset, sim_reg *p_reg)
+{
+   DMA_Stream_TypeDef *p_registers = NULL;
+   t_sim_dma_stream *p_stream = sim_dma_stream_lookup(p_reg, offset, &p_registers);
+
+   if((offsetof(DMA_Stream_TypeDef, NDTR) == (offset % sizeof(DMA_Stream_TypeDef))) && (p_registers->CR.raw & DMA_SxCR_EN))
+   {
+      return(p_stream->remaining);
+   }
+
+   return(p_reg->raw);
+}
+
+
+static void
+sim_dma_stream_write(uint32_t offset, sim_reg *p_reg, uint32_t value)
+{
+   DMA_Stream_TypeDef *p_registers = NULL;
+   t_sim_dma_stream *p_stream = sim_dma_stream_lookup(p_reg, offset, &p_registers);
+   uint32_t register_offset = offset % sizeof(DMA_Stream_TypeDef);
+   uint32_t old_value = p_reg->raw;
+
+   //Address and count registers are locked while the stream is enabled
+   if((offsetof(DMA_Stream_TypeDef, CR) != register_offset) && (p_registers->CR.raw & DMA_SxCR_EN))
+   {
+      return;
+   }
+
+   p_reg->raw = value;
+
+   if(offsetof(DMA_Stream_TypeDef, CR) != register_offset)
+   {
+      return;
+   }
+
+   if((value & DMA_SxCR_EN) && !(old_value & DMA_SxCR_EN))
+   {
+      p_stream->memory_address = p_registers->M0AR.raw;
+      p_stream->peripheral_address = p_registers->PAR.raw;
+      p_stream->remaining = p_registers->NDTR.raw & 0xFFFF;
+
+      if(DMA_SxCR_DIR_1 == (value & DMA_SxCR_DIR_Msk))
+      {
+         sim_event_schedule(dma_m2m_slot[p_stream->controller - 1], sim_now + ((uint64_t)p_stream->remaining * SIM_DMA_ITEM_CYCLES));
+      }
+   }
+
+   else if(!(value & DMA_SxCR_EN) && (old_value & DMA_SxCR_EN))
+   {
+      p_registers->NDTR.raw = p_stream->remaining;
+   }
+}
+
+
+/*!
+* @brief Moves one data item and updates NDTR, flags and the interrupt
+*/
+static void
+sim_dma_transfer_item(t_sim_dma_stream *p_stream)
+{
+   DMA_Stream_TypeDef *p_registers = (1 == p_stream->controller) ? &sim_dma1_stream[p_stream->number] : &sim_dma2_stream[p_stream->number];
+   uint32_t control = p_registers->CR.raw;
+   uint32_t peripheral_size = 1ul << ((control & DMA_SxCR_PSIZE_Msk) >> DMA_SxCR_PSIZE_Pos);
+   uint32_t memory_size = 1ul << ((control & DMA_SxCR_MSIZE_Msk) >> DMA_SxCR_MSIZE_Pos);
+   uint32_t direction = control & DMA_SxCR_DIR_Msk;
+   uint32_t item = 0;
+
+   if(0 == p_stream->remaining)
+   {
+      return;
+   }
+
+   if(0 == direction) //Peripheral to memory
+   {
+      sim_dma_read(p_stream->peripheral_address, peripheral_size, &item);
+      sim_dma_write(p_stream->memory_address, memory_size, item);
+   }
+
+   else if(DMA_SxCR_DIR_0 == direction) //Memory to peripheral
+   {
+      sim_dma_read(p_stream->memory_address, memory_size, &item);
+      sim_dma_write(p_stream->peripheral_address, peripheral_size, item);
+   }
+
+   else //Memory to memory, PAR is the source
+   {
+      sim_dma_read(p_stream->peripheral_address, peripheral_size, &item);
+      sim_dma_write(p_stream->memory_address, memory_size, item);
+   }
+
+   sim_stats.dma_transfers++;
+
+   if(control & DMA_SxCR_MINC)
+   {
+      p_stream->memory_address += memory_size;
+   }
+
+   if(control & DMA_SxCR_PINC)
+   {
+      p_stream->peripheral_address += peripheral_size;
+   }
+
+   p_stream->remaining--;
+
+   if(((p_registers->NDTR.raw & 0xFFFF) / 2) == p_stream->remaining)
+   {
+      sim_dma_set_flag(p_stream, 1ul << 4); //HTIF
+
+      if(control & DMA_SxCR_HTIE)
+      {
+         sim_irq_raise(p_stream->irq_number);
+      }
+   }
+
+   if(0 == p_stream->remaining)
+   {
+      sim_dma_set_flag(p_stream, 1ul << 5); //TCIF
+
+      if(control & DMA_SxCR_CIRC)
+      {
+         p_stream->memory_address = p_registers->M0AR.raw;
+         p_stream->peripheral_address = p_registers->PAR.raw;
+         p_stream->remaining = p_registers->NDTR.raw & 0xFFFF;
+      }
+
+      else
+      {
+         p_registers->CR.raw &= ~DMA_SxCR_EN;
+         p_registers->NDTR.raw = 0;
+      }
+
+      if(control & DMA_SxCR_TCIE)
+      {
+         sim_irq_raise(p_stream->irq_number);
+      }
+   }
+}
+
+
+/*!
+* @brief Sets a status flag of a stream. The flag groups sit at bits 0, 6, 16 and 22.
+*/
+static void
+sim_dma_set_flag(t_sim_dma_stream *p_stream, uint32_t flag)
+{
+   static const uint8_t group_shift[4] = {0, 6, 16, 22};
+   DMA_TypeDef *p_dma = (1 == p_stream->controller) ? &sim_dma1 : &sim_dma2;
+   sim_reg *p_status = (4 > p_stream->number) ? &p_dma->LISR : &p_dma->HISR;
+
+   p_status->raw |= (flag << group_shift[p_stream->number % 4]);
+}
+
+
+/*!
+* @brief Memory-to-memory streams run without requests and finish as one burst
+*/
+static void
+sim_dma_m2m_event(uint64_t when)
+{
+   (void)when;
+
+   for(uint8_t controller = 0; controller < 2; controller++)
+   {
+      for(uint8_t current_stream = 0; current_stream < 8; current_stream++)
+      {
+         DMA_Stream_TypeDef *p_registers = (0 == controller) ? &sim_dma1_stream[current_stream] : &sim_dma2_stream[current_stream];
+
+         if((p_registers->CR.raw & DMA_SxCR_EN) && (DMA_SxCR_DIR_1 == (p_registers->CR.raw & DMA_SxCR_DIR_Msk)))
+         {
+            while(p_registers->CR.raw & DMA_SxCR_EN)
+            {
+               sim_dma_transfer_item(&dma_streams[controller][current_stream]);
+            }
+         }
+      }
+   }
+}
+
+
+static uint32_t
+sim_adc_read(uint32_t offset, sim_reg *p_reg)
+{
+   if(offsetof(ADC_TypeDef, DR) == offset)
+   {
+      sim_adc1.SR.raw &= ~ADC_SR_EOC;
+   }
+
+   return(p_reg->raw);
+}
+
+
+static void
+sim_adc_write(uint32_t offset, sim_reg *p_reg, uint32_t value)
+{
+   if(offsetof(ADC_TypeDef, SR) == offset)
+   {
+      p_reg->raw &= value; //rc_w0
+      return;
+   }
+
+   p_reg->raw = value & ~ADC_CR2_SWSTART;
+
+   if((offsetof(ADC_TypeDef, CR2) == offset) && (value & ADC_CR2_SWSTART) && (value & ADC_CR2_ADON))
+   {
+      adc.sequence_index = 0;
+      adc.sequence_length = (uint8_t)(((sim_adc1.SQR1.raw >> 20) & 0xF) + 1);
+
+      if(!(sim_adc1.CR1.raw & ADC_CR1_SCAN))
+      {
+         adc.sequence_length = 1;
+      }
+
+      sim_adc1.SR.raw |= ADC_SR_STRT;
+      sim_event_schedule(adc.event_slot, sim_now + SIM_ADC_CONVERSION_CYCLES);
+   }
+}
+
+
+static void
+sim_adc_event(uint64_t when)
+{
+   uint8_t rank = adc.sequence_index;
+   uint32_t channel = (sim_adc1.SQR3.raw >> (5 * rank)) & 0x1F;
+
+   if(sim_adc1.SR.raw & ADC_SR_EOC)
+   {
+      sim_adc1.SR.raw |= ADC_SR_OVR;
+   }
+
+   sim_adc1.DR.raw = sim_adc_channel_value((uint8_t)channel);
+   sim_adc1.SR.raw |= ADC_SR_EOC;
+   adc.sequence_index++;
+
+   if(adc.sequence_index < adc.sequence_length)
+   {
+      sim_event_schedule(adc.event_slot, when + SIM_ADC_CONVERSION_CYCLES);
+   }
+}
+
+
+/*!
+* @brief Resistive panel: the driver maps ch2 450-3650 onto x 0-320 and ch1 360-3720 onto
+*        y 480-0. With no finger on the panel both plates float high.
+*/
+static uint16_t
+sim_adc_channel_value(uint8_t channel)
+{
+   switch(channel)
+   {
+   case 1:
+      return(inputs.touched ? (uint16_t)(360 + (7 * (480 - inputs.touch_y))) : 4095);
+   case 2:
+      return(inputs.touched ? (uint16_t)(450 + (10 * inputs.touch_x)) : 4095);
+   case 7:
+      return(inputs.battery_adc);
+   default:
+      return(0);
+   }
+}
+
+
+static uint32_t
+sim_rtc_read(uint32_t offset, sim_reg *p_reg)
+{
+   if(offsetof(RTC_TypeDef, TR) == offset)
+   {
+      if(!(sim_rtc.ISR.raw & RTC_ISR_INIT))
+      {
+         return(sim_rtc_encode(sim_rtc_seconds()));
+      }
+   }
+
+   else if(offsetof(RTC_TypeDef, ISR) == offset)
+   {
+      uint32_t value = p_reg->raw & ~(RTC_ISR_INITF | RTC_ISR_ALRAWF);
+      value |= (value & RTC_ISR_INIT) ? RTC_ISR_INITF : 0;
+      value |= (sim_rtc.CR.raw & RTC_CR_ALRAE) ? 0 : RTC_ISR_ALRAWF;
+      value |= RTC_ISR_RSF;
+      return(value);
+   }
+
+   return(p_reg->raw);
+}
+
+
+static void
+sim_rtc_write(uint32_t offset, sim_reg *p_reg, uint32_t value)
+{
+   if(offsetof(RTC_TypeDef, ISR) == offset)
+   {
+      uint32_t old_value = p_reg->raw;
+      //ALRAF is rc_w0, INIT is read/write
+      p_reg->raw = (value & RTC_ISR_INIT) | (old_value & value & RTC_ISR_ALRAF);
+
+      //Leaving init mode starts the calendar from the loaded time
+      if((old_value & RTC_ISR_INIT) && !(value & RTC_ISR_INIT))
+      {
+         rtc.base_seconds = sim_rtc_decode(sim_rtc.TR.raw);
+         rtc.base_cycle = sim_now;
+      }
+
+      return;
+   }
+
+   if(offsetof(RTC_TypeDef, TR) == offset)
+   {
+      if(sim_rtc.ISR.raw & RTC_ISR_INIT)
+      {
+         p_reg->raw = value;
+      }
+
+      return;
+   }
+
+   p_reg->raw = value;
+}
+
+
+/*!
+* @brief Once per second, alarm A is compared against the seconds field (MSK4..2 set)
+*/
+static void
+sim_rtc_event(uint64_t when)
+{
+   if(sim_rtc.CR.raw & RTC_CR_ALRAE)
+   {
+      uint32_t seconds = sim_rtc_seconds() % 60;
+      uint32_t alarm = sim_rtc.ALRMAR.raw;
+      uint32_t alarm_seconds = (((alarm & RTC_ALRMAR_ST_Msk) >> RTC_ALRMAR_ST_Pos) * 10) +
+                               ((alarm & RTC_ALRMAR_SU_Msk) >> RTC_ALRMAR_SU_Pos);
+
+      if(alarm_seconds == seconds)
+      {
+         sim_rtc.ISR.raw |= RTC_ISR_ALRAF;
+      }
+   }
+
+   sim_event_schedule(rtc.event_slot, when + SIM_CPU_HZ);
+}
+
+
+static uint32_t
+sim_rtc_seconds(void)
+{
+   return((uint32_t)((rtc.base_seconds + ((sim_now - rtc.base_cycle) / SIM_CPU_HZ)) % 86400));
+}
+
+
+/*!
+* @brief Seconds since midnight to a BCD time register in AM/PM format
+*/
+static uint32_t
+sim_rtc_encode(uint32_t seconds)
+{
+   uint32_t hours = seconds / 3600;
+   uint32_t minutes = (seconds / 60) % 60;
+   uint32_t pm = (12 <= hours);
+   uint32_t value = 0;
+
+   seconds %= 60;
+
+   if(sim_rtc.CR.raw & RTC_CR_FMT)
+   {
+      hours %= 12;
+      hours = (0 == hours) ? 12 : hours;
+   }
+
+   value |= (hours / 10) << RTC_TR_HT_Pos;
+   value |= (hours % 10) << RTC_TR_HU_Pos;
+   value |= (minutes / 10) << RTC_TR_MNT_Pos;
+   value |= (minutes % 10) << RTC_TR_MNU_Pos;
+   value |= (seconds / 10) << RTC_TR_ST_Pos;
+   value |= (seconds % 10) << RTC_TR_SU_Pos;
+   value |= (pm && (sim_rtc.CR.raw & RTC_CR_FMT)) ? RTC_TR_PM : 0;
+
+   return(value);
+}
+
+
+static uint32_t
+sim_rtc_decode(uint32_t time_register)
+{
+   uint32_t hours = (((time_register & RTC_TR_HT_Msk) >> RTC_TR_HT_Pos) * 10) + ((time_register & RTC_TR_HU_Msk) >> RTC_TR_HU_Pos);
+   uint32_t minutes = (((time_register & RTC_TR_MNT_Msk) >> RTC_TR_MNT_Pos) * 10) + ((time_register & RTC_TR_MNU_Msk) >> RTC_TR_MNU_Pos);
+   uint32_t seconds = (((time_register & RTC_TR_ST_Msk) >> RTC_TR_ST_Pos) * 10) + ((time_register & RTC_TR_SU_Msk) >> RTC_TR_SU_Pos);
+
+   if(sim_rtc.CR.raw & RTC_CR_FMT)
+   {
+      hours %= 12;
+      hours += (time_register & RTC_TR_PM) ? 12 : 0;
+   }
+
+   return((hours * 3600) + (minutes * 60) + seconds);
+}
+
+
+static void
+sim_rtc_reset(void)
+{
+   memset((void *)&sim_rtc, 0, sizeof(sim_rtc));
+   sim_rtc.ISR.raw = RTC_ISR_INITS;
+   rtc.base_seconds = SIM_RTC_START_SECONDS;
+   rtc.base_cycle = sim_now;
+}
+
+
+static uint32_t
+sim_uart_read(uint32_t offset, sim_reg *p_reg)
+{
+   if(offsetof(USART_TypeDef, SR) == offset)
+   {
+      uint32_t value = p_reg->raw & ~(USART_SR_TXE | USART_SR_TC);
+      value |= uart.tdr_full ? 0 : USART_SR_TXE;
+      value |= (uart.tdr_full || uart.shifter_active) ? 0 : USART_SR_TC;
+      return(value);
+   }
+
+   return(p_reg->raw);
+}
+
+
+static void
+sim_uart_write(uint32_t offset, sim_reg *p_reg, uint32_t value)
+{
+   if(offsetof(USART_TypeDef, DR) == offset)
+   {
+      if(!(sim_usart1.CR1.raw & USART_CR1_UE) || !(sim_usart1.CR1.raw & USART_CR1_TE))
+      {
+         return;
+      }
+
+      if(!uart.shifter_active)
+      {
+         sim_uart_start((uint8_t)value);
+      }
+
+      else
+      {
+         uart.tdr_full = 1;  //A write while TXE = 0 overwrites the waiting character
+         uart.tdr = (uint8_t)value;
+      }
+
+      return;
+   }
+
+   p_reg->raw = value;
+}
+
+
+/*!
+* @brief One start bit, 8 data bits and one stop bit, BRR is USARTDIV x 16 in APB2 clocks
+*/
+static void
+sim_uart_start(uint8_t byte)
+{
+   uint32_t brr = sim_usart1.BRR.raw & 0xFFFF;
+   uint64_t character_cycles = (uint64_t)((0 != brr) ? brr : 1) * 10;
+
+   uart.shifter_active = 1;
+   sim_stats.uart_bytes++;
+
+   if(NULL != uart.p_log)
+   {
+      fputc(byte, uart.p_log);
+   }
+
+   sim_event_schedule(uart.event_slot, sim_now + character_cycles);
+}
+
+
+static void
+sim_uart_event(uint64_t when)
+{
+   (void)when;
+   uart.shifter_active = 0;
+
+   if(uart.tdr_full)
+   {
+      uart.tdr_full = 0;
+      sim_uart_start(uart.tdr);
+   }
+}
+
+
+/*!
+* @brief VAL counts down from LOAD on the processor clock. Reading CTRL clears COUNTFLAG
+*/
+static uint32_t
+sim_systick_read(uint32_t offset, sim_reg *p_reg)
+{
+   if((offsetof(SysTick_Type, VAL) == offset) && (sim_systick.CTRL.raw & SysTick_CTRL_ENABLE_Msk))
+   {
+      uint64_t period = (uint64_t)(sim_systick.LOAD.raw & 0x00FFFFFF) + 1;
+      return(sim_systick.LOAD.raw - (uint32_t)((sim_now - systick.period_start) % period));
+   }
+
+   if(offsetof(SysTick_Type, CTRL) == offset)
+   {
+      uint32_t value = p_reg->raw;
+      p_reg->raw &= ~SysTick_CTRL_COUNTFLAG_Msk;
+      return(value);
+   }
+
+   return(p_reg->raw);
+}
+
+
+/*!
+* @brief Enabling the counter or writing VAL restarts the count from LOAD
+*/
+static void
+sim_systick_write(uint32_t offset, sim_reg *p_reg, uint32_t value)
+{
+   uint32_t old_value = p_reg->raw;
+
+   if(offsetof(SysTick_Type, VAL) == offset)
+   {
+      p_reg->raw = 0;
+      sim_systick.CTRL.raw &= ~SysTick_CTRL_COUNTFLAG_Msk;
+   }
+
+   else if(offsetof(SysTick_Type, CTRL) == offset)
+   {
+      p_reg->raw = (value & ~SysTick_CTRL_COUNTFLAG_Msk) | (old_value & SysTick_CTRL_COUNTFLAG_Msk);
+
+      if(!(value & SysTick_CTRL_ENABLE_Msk))
+      {
+         sim_event_cancel(systick.event_slot);
+         return;
+      }
+
+      if(old_value & SysTick_CTRL_ENABLE_Msk)
+      {
+         return;
+      }
+   }
+
+   else
+   {
+      p_reg->raw = value;
+      return;
+   }
+
+   if(sim_systick.CTRL.raw & SysTick_CTRL_ENABLE_Msk)
+   {
+      systick.period_start = sim_now;
+      sim_event_schedule(systick.event_slot, sim_now + (sim_systick.LOAD.raw & 0x00FFFFFF) + 1);
+   }
+}
+
+
+/*!
+* @brief VAL reached 0: COUNTFLAG is set, the exception is raised if TICKINT is set, and the
+*        count starts over from LOAD
+*/
+static void
+sim_systick_event(uint64_t when)
+{
+   sim_systick.CTRL.raw |= SysTick_CTRL_COUNTFLAG_Msk;
+
+   if(sim_systick.CTRL.raw & SysTick_CTRL_TICKINT_Msk)
+   {
+      sim_irq_raise(SysTick_IRQn);
+   }
+
+   systick.period_start = when;
+   sim_event_schedule(systick.event_slot, when + (sim_systick.LOAD.raw & 0x00FFFFFF) + 1);
+}
+
+
+static void
+sim_touch_release(uint64_t when)
+{
+   (void)when;
+   inputs.touched = 0;
+   sim_gpio_set_input(GPIOA, 1, 1);
+}
+
+
+static void
+sim_power_button_release(uint64_t when)
+{
+   (void)when;
+   sim_gpio_set_input(GPIOA, 0, 1);
+}
+
+/* end of file */
@@ -0,0 +1,649 @@
+/** @file sim_spi_sd.cpp
+*
+* @brief  SPI2 master and the microSD card on the other end of it. The SPI model reproduces
+*         the STM32 behaviour the driver depends on: a one byte transmit buffer in front of
+*         the shifter, RXNE that is never cleared by spi_send_byte() and the resulting overrun,
+*         so receive calls return the byte clocked by the previous transfer. The card speaks
+*         the SPI-mode protocol used by microsd.c (CMD0/8/55/41/58/17/18/12/24/25/13, ACMD23).
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#include "sim.h"
+#include <string.h>
+
+/*
+****************************************************
+*********** Simulated Register Blocks **************
+****************************************************
+*/
+SPI_TypeDef sim_spi1, sim_spi2, sim_spi5;
+
+/*
+****************************************************
+************** Card Timing Constants ***************
+****************************************************
+*/
+#define SIM_SD_READ_LATENCY_CYCLES (100 * SIM_CYCLES_PER_US)   //CMD17/CMD18 command to first data token
+#define SIM_SD_NEXT_BLOCK_CYCLES (2 * SIM_CYCLES_PER_US)       //Gap between blocks of a CMD18 stream
+#define SIM_SD_WRITE_BUSY_CYCLES (500 * SIM_CYCLES_PER_US)     //Programming time of a CMD24 block
+#define SIM_SD_MULTI_BUSY_CYCLES (180 * SIM_CYCLES_PER_US)     //Per block inside a CMD25 stream
+#define SIM_SD_ERASED_BUSY_CYCLES (100 * SIM_CYCLES_PER_US)    //Per block after ACMD23 pre-erase
+#define SIM_SD_STOP_BUSY_CYCLES (500 * SIM_CYCLES_PER_US)      //Stop tran token to ready
+#define SIM_SD_TOKEN_WAIT 0xFFFF
+#define SIM_SD_OUT_OF_RANGE_TOKEN 0x08 //Data error token for a block past the end of the card
+
+#define SIM_SPI2_CS_PIN 8   //PC8
+
+/*
+****************************************************
+************* File-Static Variables ****************
+****************************************************
+*/
+typedef enum e_sim_sd_state
+{
+   sim_sd_idle,
+   sim_sd_reading,
+   sim_sd_write_token,
+   sim_sd_write_data,
+   sim_sd_write_busy
+
+} e_sim_sd_state;
+
+typedef struct t_sim_spi
+{
+   int event_slot;
+   uint8_t shifter_active;
+   uint8_t shifter_miso;
+   uint8_t tx_full;
+   uint8_t tx_byte;
+   uint8_t rx_full;
+   uint8_t rx_byte;
+   uint8_t overrun;
+   uint64_t transfer_start;
+
+} t_sim_spi;
+
+typedef struct t_sim_sd
+{
+   e_sim_sd_state state;
+   uint8_t frame[6];
+   uint8_t frame_length;
+   uint8_t queue[16];
+   uint8_t queue_head;
+   uint8_t queue_count;
+   uint8_t initialized;
+   uint8_t app_command;
+   uint8_t acmd41_count;
+
+   uint32_t read_address;
+   uint8_t read_multiple;
+   uint16_t read_index;
+   uint64_t token_time;
+   uint8_t read_buffer[512];
+
+   uint32_t write_address;
+   uint8_t write_multiple;
+   uint16_t write_index;
+   uint32_t pre_erased_blocks;
+   uint64_t busy_until;
+   uint8_t write_buffer[514];
+
+} t_sim_sd;
+
+static t_sim_spi spi;
+static t_sim_sd card;
+
+/*
+****************************************************
+********** Private Function Prototypes *************
+****************************************************
+*/
+static uint32_t sim_spi_read(uint32_t offset, sim_reg *p_reg);
+static void sim_spi_write(uint32_t offset, sim_reg *p_reg, uint32_t value);
+static void sim_spi_start_transfer(uint8_t byte);
+static void sim_spi_transfer_done(uint64_t when);
+static uint32_t sim_spi_byte_cycles(void);
+static uint8_t sim_sd_output(void);
+static void sim_sd_input(uint8_t mosi);
+static void sim_sd_command(uint8_t command, uint32_t argument);
+static void sim_sd_respond(const uint8_t *p_bytes, uint8_t total_bytes);
+
+/*
+****************************************************
+********** Public Function Definitions *************
+****************************************************
+*/
+
+/*!
+* @brief Maps the SPI register blocks
+* @param[in] NONE
+* @return NONE
+*/
+void
+sim_spi_init(void)
+{
+   memset(&spi, 0, sizeof(spi));
+   sim_register_device("SPI1", &sim_spi1, sizeof(sim_spi1), sim_bus_apb2, NULL, NULL);
+   sim_register_device("SPI2", &sim_spi2, sizeof(sim_spi2), sim_bus_apb1, sim_spi_read, sim_spi_write);
+   sim_register_device("SPI5", &sim_spi5, sizeof(sim_spi5), sim_bus_apb2, NULL, NULL);
+   spi.event_slot = sim_event_register("spi2 shifter", sim_spi_transfer_done);
+   sim_spi2.SR.raw = SPI_SR_TXE;
+}
+
+
+/*!
+* @brief Powers up the card in its pre-initialization state
+* @param[in] NONE
+* @return NONE
+*/
+void
+sim_sd_init(void)
+{
+   memset(&card, 0, sizeof(card));
+}
+
+
+/*!
+* @brief Clocks one byte through the card
+* @param[in] mosi Byte sent by the MCU
+* @param[in] cs_active 1 while the chip select line is low
+* @return Byte the card drives on MISO during the same 8 clocks
+*/
+uint8_t
+sim_sd_exchange(uint8_t mosi, uint8_t cs_active)
+{
+   if(!cs_active)
+   {
+      card.queue_count = 0;
+      card.frame_length = 0;
+      return(0xFF);
+   }
+
+   uint8_t miso = sim_sd_output();
+   sim_sd_input(mosi);
+
+   return(miso);
+}
+
+
+/*
+****************************************************
+********** Private Function Definitions ************
+****************************************************
+*/
+
+static uint32_t
+sim_spi_read(uint32_t offset, sim_reg *p_reg)
+{
+   if(offsetof(SPI_TypeDef, SR) == offset)
+   {
+      uint32_t status = 0;
+
+      if(spi.rx_full)
+      {
+         status |= SPI_SR_RXNE;
+      }
+
+      if(!spi.tx_full)
+      {
+         status |= SPI_SR_TXE;
+      }
+
+      if(spi.overrun)
+      {
+         status |= SPI_SR_OVR;
+      }
+
+      if(spi.shifter_active || spi.tx_full)
+      {
+         status |= SPI_SR_BSY;
+      }
+
+      return(status);
+   }
+
+   if(offsetof(SPI_TypeDef, DR) == offset)
+   {
+      spi.rx_full = 0;
+      return(spi.rx_byte);
+   }
+
+   return(p_reg->raw);
+}
+
+
+static void
+sim_spi_write(uint32_t offset, sim_reg *p_reg, uint32_t value)
+{
+   if(offsetof(SPI_TypeDef, DR) == offset)
+   {
+      if(!(sim_spi2.CR1.raw & SPI_CR1_SPE))
+      {
+         return;
+      }
+
+      if(!spi.shifter_active)
+      {
+         sim_spi_start_transfer((uint8_t)value);
+
+         if(sim_spi2.CR2.raw & SPI_CR2_TXDMAEN)
+         {
+            sim_dma_request(1, 4);
+         }
+      }
+
+      else
+      {
+         spi.tx_full = 1;
+         spi.tx_byte = (uint8_t)value;
+      }
+
+      return;
+   }
+
+   if(offsetof(SPI_TypeDef, SR) == offset)
+   {
+      //Only CRCERR is writable. Reading SR after DR clears OVR.
+      spi.overrun = 0;
+      return;
+   }
+
+   uint32_t old_value = p_reg->raw;
+   p_reg->raw = value;
+
+   if(offsetof(SPI_TypeDef, CR2) == offset)
+   {
+      //Enabling a DMA request while its flag is already set triggers it immediately
+      if((value & SPI_CR2_TXDMAEN) && !(old_value & SPI_CR2_TXDMAEN) && !spi.tx_full)
+      {
+         sim_dma_request(1, 4);
+      }
+
+      if((value & SPI_CR2_RXDMAEN) && !(old_value & SPI_CR2_RXDMAEN) && spi.rx_full)
+      {
+         sim_dma_request(1, 3);
+      }
+   }
+}
+
+
+/*!
+* @brief The card samples MOSI and drives MISO for the whole byte, so the exchange is
+*        resolved when the shifter starts. Chip select is sampled at the same moment.
+*/
+static void
+sim_spi_start_transfer(uint8_t byte)
+{
+   uint32_t byte_cycles = sim_spi_byte_cycles();
+   uint8_t cs_active = !(sim_gpioc.ODR.raw & (1ul << SIM_SPI2_CS_PIN));
+
+   spi.shifter_active = 1;
+   spi.shifter_miso = sim_sd_exchange(byte, cs_active);
+   spi.transfer_start = sim_now;
+
+   sim_stats.spi_bytes++;
+   sim_stats.spi_busy_cycles += byte_cycles;
+   sim_event_schedule(spi.event_slot, sim_now + byte_cycles);
+}
+
+
+static void
+sim_spi_transfer_done(uint64_t when)
+{
+   (void)when;
+   spi.shifter_active = 0;
+
+   if(spi.rx_full)
+   {
+      //RXNE still set: the new byte is lost and OVR is raised
+      spi.overrun = 1;
+      sim_stats.spi_overruns++;
+   }
+
+   else
+   {
+      spi.rx_byte = spi.shifter_miso;
+      spi.rx_full = 1;
+
+      if(sim_spi2.CR2.raw & SPI_CR2_RXDMAEN)
+      {
+         sim_dma_request(1, 3);
+      }
+   }
+
+   if(spi.tx_full)
+   {
+      spi.tx_full = 0;
+      sim_spi_start_transfer(spi.tx_byte);
+
+      if(sim_spi2.CR2.raw & SPI_CR2_TXDMAEN)
+      {
+         sim_dma_request(1, 4);
+      }
+   }
+}
+
+
+/*!
+* @brief SCK = PCLK1 / 2^(BR+1) with PCLK1 = HCLK/2
+*/
+static uint32_t
+sim_spi_byte_cycles(void)
+{
+   uint32_t baud_divider = (sim_spi2.CR1.raw & SPI_CR1_BR_Msk) >> SPI_CR1_BR_Pos;
+
+   return(32ul << baud_divider);
+}
+
+
+/*!
+* @brief Byte the card drives for the current 8 clocks
+*/
+static uint8_t
+sim_sd_output(void)
+{
+   if(0 != card.queue_count)
+   {
+      uint8_t byte = card.queue[card.queue_head];
+      card.queue_head = (uint8_t)((card.queue_head + 1) % sizeof(card.queue));
+      card.queue_count--;
+      return(byte);
+   }
+
+   switch(card.state)
+   {
+   case sim_sd_reading:
+      if(SIM_SD_TOKEN_WAIT == card.read_index)
+      {
+         if(sim_now < card.token_time)
+         {
+            return(0xFF);
+         }
+
+         //The card sends nothing more until the host stops the read
+         if(!sim_card_has_block(card.read_address))
+         {
+            card.state = sim_sd_idle;
+            return(SIM_SD_OUT_OF_RANGE_TOKEN);
+         }
+
+         sim_card_read(card.read_address, card.read_buffer);
+         card.read_index = 0;
+         return(0xFE);
+      }
+
+      if(512 > card.read_index)
+      {
+         return(card.read_buffer[card.read_index++]);
+      }
+
+      //Two CRC bytes, then either the next block or back to idle
+      card.read_index++;
+
+      if(514 == card.read_index)
+      {
+         sim_stats.sd_blocks_read++;
+
+         if(card.read_multiple)
+         {
+            card.read_address++;
+            card.read_index = SIM_SD_TOKEN_WAIT;
+            card.token_time = sim_now + SIM_SD_NEXT_BLOCK_CYCLES;
+         }
+
+         else
+         {
+            card.state = sim_sd_idle;
+         }
+      }
+
+      return(0x00);
+
+   case sim_sd_write_busy:
+      if(sim_now < card.busy_until)
+      {
+         return(0x00);
+      }
+
+      card.state = card.write_multiple ? sim_sd_write_token : sim_sd_idle;
+      return(0xFF);
+
+   default:
+      return(0xFF);
+   }
+}
+
+
+/*!
+* @brief Byte the card samples on MOSI during the current 8 clocks
+*/
+static void
+sim_sd_input(uint8_t mosi)
+{
+   if(sim_sd_write_data == card.state)
+   {
+      card.write_buffer[card.write_index++] = mosi;
+
+      //512 data bytes and 2 CRC bytes, CRC is not checked in SPI mode
+      if(514 == card.write_index)
+      {
+         static const uint8_t data_accepted[] = {0xE5};
+         uint64_t busy_cycles = SIM_SD_WRITE_BUSY_CYCLES;
+
+         sim_card_write(card.write_address, card.write_buffer);
+         sim_stats.sd_blocks_written++;
+         sim_sd_respond(data_accepted, 1);
+
+         if(card.write_multiple)
+         {
+            card.write_address++;
+            busy_cycles = SIM_SD_MULTI_BUSY_CYCLES;
+
+            if(0 != card.pre_erased_blocks)
+            {
+               card.pre_erased_blocks--;
+               busy_cycles = SIM_SD_ERASED_BUSY_CYCLES;
+            }
+         }
+
+         card.state = sim_sd_write_busy;
+         card.busy_until = sim_now + busy_cycles;
+      }
+
+      return;
+   }
+
+   if(sim_sd_write_token == card.state)
+   {
+      if((0xFE == mosi) || ((0xFC == mosi) && card.write_multiple))
+      {
+         card.state = sim_sd_write_data;
+         card.write_index = 0;
+         return;
+      }
+
+      if((0xFD == mosi) && card.write_multiple)
+      {
+         card.write_multiple = 0;
+         card.pre_erased_blocks = 0;
+         card.state = sim_sd_write_busy;
+         card.busy_until = sim_now + SIM_SD_STOP_BUSY_CYCLES;
+         return;
+      }
+   }
+
+   if(0 == card.frame_length)
+   {
+      //Start bit 0, transmission bit 1
+      if(0x40 != (mosi & 0xC0))
+      {
+         return;
+      }
+   }
+
+   card.frame[card.frame_length++] = mosi;
+
+   if(6 == card.frame_length)
+   {
+      card.frame_length = 0;
+      uint32_t argument = ((uint32_t)card.frame[1] << 24) | ((uint32_t)card.frame[2] << 16) |
+                          ((uint32_t)card.frame[3] << 8) | (uint32_t)card.frame[4];
+      sim_sd_command((uint8_t)(card.frame[0] & 0x3F), argument);
+   }
+}
+
+
+/*!
+* @brief Every response is preceded by one 0xFF byte (NCR = 1)
+*/
+static void
+sim_sd_command(uint8_t command, uint32_t argument)
+{
+   uint8_t application_command = card.app_command;
+   uint8_t r1 = card.initialized ? 0x00 : 0x01;
+
+   card.app_command = 0;
+   card.queue_count = 0;
+   sim_stats.sd_commands++;
+   sim_stats.sd_command_count[command]++;
+
+   switch(command)
+   {
+   case 0: //GO_IDLE_STATE
+      {
+         static const uint8_t response[] = {0xFF, 0x01};
+         card.initialized = 0;
+         card.acmd41_count = 0;
+         card.state = sim_sd_idle;
+         sim_sd_respond(response, sizeof(response));
+      }
+      break;
+
+   case 8: //SEND_IF_COND, R7 echoes the voltage and check pattern
+      {
+         uint8_t response[] = {0xFF, r1, 0x00, 0x00, (uint8_t)((argument >> 8) & 0x0F), (uint8_t)argument};
+         sim_sd_respond(response, sizeof(response));
+      }
+      break;
+
+   case 12: //STOP_TRANSMISSION, one stuff byte before R1
+      {
+         static const uint8_t response[] = {0xFF, 0xFF, 0x00};
+         card.state = sim_sd_idle;
+         sim_sd_respond(response, sizeof(response));
+      }
+      break;
+
+   case 13: //SEND_STATUS, R2
+      {
+         uint8_t response[] = {0xFF, r1, 0x00};
+         sim_sd_respond(response, sizeof(response));
+      }
+      break;
+
+   case 17: //READ_SINGLE_BLOCK
+   case 18: //READ_MULTIPLE_BLOCK
+      {
+         uint8_t response[] = {0xFF, r1};
+         card.state = sim_sd_reading;
+         card.read_multiple = (18 == command);
+         card.read_address = argument;
+         card.read_index = SIM_SD_TOKEN_WAIT;
+         card.token_time = sim_now + SIM_SD_READ_LATENCY_CYCLES;
+         sim_sd_respond(response, sizeof(response));
+      }
+      break;
+
+   case 23: //ACMD23 SET_WR_BLK_ERASE_COUNT
+      {
+         uint8_t response[] = {0xFF, r1};
+         card.pre_erased_blocks = application_command ? (argument & 0x7FFFFF) : 0;
+         sim_sd_respond(response, sizeof(response));
+      }
+      break;
+
+   case 24: //WRITE_BLOCK
+   case 25: //WRITE_MULTIPLE_BLOCK
+      {
+         uint8_t response[] = {0xFF, r1};
+         card.state = sim_sd_write_token;
+         card.write_multiple = (25 == command);
+         card.write_address = argument;
+         sim_sd_respond(response, sizeof(response));
+      }
+      break;
+
+   case 41: //ACMD41 SD_SEND_OP_COND, the card needs a few polls before it leaves idle
+      {
+         card.acmd41_count++;
+
+         if(3 <= card.acmd41_count)
+         {
+            card.initialized = 1;
+         }
+
+         uint8_t response[] = {0xFF, (uint8_t)(card.initialized ? 0x00 : 0x01)};
+         sim_sd_respond(response, sizeof(response));
+      }
+      break;
+
+   case 55: //APP_CMD
+      {
+         uint8_t response[] = {0xFF, r1};
+         card.app_command = 1;
+         sim_sd_respond(response, sizeof(response));
+      }
+      break;
+
+   case 58: //READ_OCR, power up and CCS are only set once initialization has finished
+      {
+         uint8_t response[] = {0xFF, r1, (uint8_t)(card.initialized ? 0xC0 : 0x00), 0xFF, 0x80, 0x00};
+         sim_sd_respond(response, sizeof(response));
+      }
+      break;
+
+   default: //Illegal command
+      {
+         uint8_t response[] = {0xFF, (uint8_t)(r1 | 0x04)};
+         sim_sd_respond(response, sizeof(response));
+      }
+      break;
+   }
+}
+
+
+static void
+sim_sd_respond(const uint8_t *p_bytes, uint8_t total_bytes)
+{
+   for(uint8_t current_byte = 0; current_byte < total_bytes; current_byte++)
+   {
+      if(sizeof(card.queue) > card.queue_count)
+      {
+         card.queue[(card.queue_head + card.queue_count) % sizeof(card.queue)] = p_bytes[current_byte];
+         card.queue_count++;
+      }
+   }
+}
+
+/* end of file */
@@ -52,6 +52,27 @@
 #include "stm32f4xx.h"
 #include "stm32f410rx.h"
 
+/*
+****************************************************
+*********** Compile-Time Pin Access ****************
+****************************************************
+*/
+//Pins are the "GPIOx,n" pairs each driver defines, e.g. gpio_pin_set(LCD_CS). The pair is split
+//by a second expansion, so the port and mask are constants and every call is one BSRR store
+#define gpio_pin_set(pin) GPIO_PIN_SET(pin)
+#define gpio_pin_clear(pin) GPIO_PIN_CLEAR(pin)
+#define gpio_pin_read(pin) GPIO_PIN_READ(pin)
+
+//Drive the 8 pins starting at lowest_pin to a byte. Set wins over reset in BSRR, so clearing the
+//old byte and writing the new one is a single store
+#define gpio_bus_write_byte(lowest_pin, byte) GPIO_BUS_WRITE_BYTE(lowest_pin, byte)
+
+#define GPIO_PIN_SET(port, number) ((port)->BSRR = (1ul << (number)))
+#define GPIO_PIN_CLEAR(port, number) ((port)->BSRR = (1ul << ((number) + 16)))
+#define GPIO_PIN_READ(port, number) (((port)->IDR >> (number)) & 1ul)
+#define GPIO_BUS_WRITE_BYTE(port, number, byte) \
+   ((port)->BSRR = (0xFFul << ((number) + 16)) | ((uint32_t)(uint8_t)(byte) << (number)))
+
 /*
 ****************************************************
 ** Public Function Defined in base_gpio_drivers.c **
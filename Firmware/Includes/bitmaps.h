@@ -42,59 +42,58 @@
 
 
 /*************** Button Elements ******************/
-const uint8_t button_corner_m_ul[40];
-const uint8_t button_corner_m_ur[31];
-const uint8_t button_corner_m_ll[40];
-const uint8_t button_corner_m_lr[31];
-const uint8_t button_ghost_ul_bmp[22];
-const uint8_t button_ghost_ur_bmp[22];
-const uint8_t button_ghost_ll_bmp[22];
-const uint8_t button_ghost_lr_bmp[22];
-const uint8_t button_toggle_left_bmp[70];
-const uint8_t button_toggle_right_bmp[70];
-const uint8_t button_toggle_middle_bmp[68];
+extern const uint8_t button_corner_m_ul[40];
+extern const uint8_t button_corner_m_ur[31];
+extern const uint8_t button_corner_m_ll[40];
+extern const uint8_t button_corner_m_lr[31];
+extern const uint8_t button_ghost_ul_bmp[22];
+extern const uint8_t button_ghost_ur_bmp[22];
+extern const uint8_t button_ghost_ll_bmp[22];
+extern const uint8_t button_ghost_lr_bmp[22];
+extern const uint8_t button_toggle_left_bmp[70];
+extern const uint8_t button_toggle_right_bmp[70];
+extern const uint8_t button_toggle_middle_bmp[68];
 
 /************** Main User Buttons *****************/
-const uint8_t back_button_bmp[146];
-const uint8_t home_button_bmp[220];
-const uint8_t square_button_bmp[152];
+extern const uint8_t back_button_bmp[146];
+extern const uint8_t home_button_bmp[220];
+extern const uint8_t square_button_bmp[152];
 
 /************** Status Bar Icons ******************/
-const uint8_t speaker_muted[77];
-const uint8_t speaker_low[77];
-const uint8_t speaker_medium[77];
-const uint8_t speaker_high[77];
-const uint8_t battery_icon_bmp[64];
-const uint8_t headphone_icon_bmp[66];
-const uint8_t usb_icon_bmp[125];
+extern const uint8_t speaker_muted[77];
+extern const uint8_t speaker_low[77];
+extern const uint8_t speaker_medium[77];
+extern const uint8_t speaker_high[77];
+extern const uint8_t battery_icon_bmp[64];
+extern const uint8_t headphone_icon_bmp[66];
+extern const uint8_t usb_icon_bmp[125];
 
 /************* Menu Type 2 Elements ***************/
-const uint8_t job_icon_bmp[304];
-const uint8_t mail_icon_bmp[304];
-const uint8_t phone_icon_bmp[304];
+extern const uint8_t job_icon_bmp[304];
+extern const uint8_t mail_icon_bmp[304];
+extern const uint8_t phone_icon_bmp[304];
 
 /************* Menu Type 3 Elements ***************/
-const uint8_t play_button_bmp[212];
-const uint8_t pause_button_bmp[212];
-const uint8_t left_music_arrows_bmp[204];
-const uint8_t right_music_arrows_bmp[204];
-const uint8_t sliding_bar_marker_bmp[60];
-const uint8_t pause_button_inner_symbol[20];
-const uint8_t pause_button_inner_symbol[20];
-const uint8_t repeat_music_icon_bmp[264];
-const uint8_t play_button_inner_symbol[34];
+extern const uint8_t play_button_bmp[212];
+extern const uint8_t pause_button_bmp[212];
+extern const uint8_t left_music_arrows_bmp[204];
+extern const uint8_t right_music_arrows_bmp[204];
+extern const uint8_t sliding_bar_marker_bmp[60];
+extern const uint8_t pause_button_inner_symbol[20];
+extern const uint8_t repeat_music_icon_bmp[264];
+extern const uint8_t play_button_inner_symbol[34];
 
 /************ Portfolio App Icons ***************/
-const uint8_t data_acquisition_icon_bmp[304];
-const uint8_t FOBO_icon_bmp[304];
-const uint8_t tamagotchi_icon_bmp[304];
-const uint8_t additional_icon_bmp[304];
-const uint8_t up_arrow_bmp[28];
-const uint8_t down_arrow_bmp[28];
+extern const uint8_t data_acquisition_icon_bmp[304];
+extern const uint8_t FOBO_icon_bmp[304];
+extern const uint8_t tamagotchi_icon_bmp[304];
+extern const uint8_t additional_icon_bmp[304];
+extern const uint8_t up_arrow_bmp[28];
+extern const uint8_t down_arrow_bmp[28];
 
 /*************** Miscellaneous ******************/
-const uint8_t check_mark_bmp[104];
-const uint8_t menu_arrow_bmp[36];
+extern const uint8_t check_mark_bmp[104];
+extern const uint8_t menu_arrow_bmp[36];
 
 #endif /* BITMAPS_H */
 
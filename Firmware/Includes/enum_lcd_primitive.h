@@ -0,0 +1,43 @@
+/** @file enum_lcd_primitive.h
+*
+* @brief  This file contains an enum type for the drawing calls a display list records
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#ifndef ENUM_LCD_PRIMITIVE_H
+#define ENUM_LCD_PRIMITIVE_H
+
+typedef enum e_lcd_primitive_tag
+{
+   lcd_primitive_rectangle,
+   lcd_primitive_bitmap,
+   lcd_primitive_string,
+   lcd_primitive_string_small,
+   lcd_primitive_sd_image
+
+} e_lcd_primitive;
+
+#endif /* ENUM_LCD_PRIMITIVE_H */
+
+/* end of file */
@@ -187,6 +187,9 @@ typedef enum e_sd_address
    /*** App Intro ***/
    intro_audio,
 
+   /*** Boot Animation ***/
+   startup_animation_delta, //Frames 0-11 as a delta animation, see LCD_ANIMATION_* in lcd_sd_stream.h
+
 
    max_total_addresses
 
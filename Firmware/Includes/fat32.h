@@ -0,0 +1,97 @@
+/** @file fat32.h
+*
+* @brief  This file reads files from the FAT32 volume on the microSD card. It finds the volume,
+*         follows paths through its directories and hands out each file as runs of consecutive
+*         blocks, which can be streamed with a single CMD18
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#ifndef FAT32_H
+#define FAT32_H
+
+/****** Master Boot Record ***************/
+#define FAT32_SIGNATURE_LOCATION 0x1FE //0x55 then 0xAA, in the MBR and the boot sector
+#define FAT32_PARTITION_TABLE_LOCATION 0x1BE
+#define FAT32_PARTITION_ENTRY_SIZE 16
+#define FAT32_PARTITION_TYPE_OFFSET 4
+#define FAT32_PARTITION_START_OFFSET 8
+#define FAT32_PARTITION_TYPE_CHS 0x0B
+#define FAT32_PARTITION_TYPE_LBA 0x0C
+
+/****** Boot Sector ***************/
+#define FAT32_BYTES_PER_SECTOR_LOCATION 0x0B
+#define FAT32_SECTORS_PER_CLUSTER_LOCATION 0x0D
+#define FAT32_RESERVED_SECTORS_LOCATION 0x0E
+#define FAT32_NUMBER_OF_FATS_LOCATION 0x10
+#define FAT32_ROOT_ENTRIES_LOCATION 0x11 //0 on FAT32
+#define FAT32_TOTAL_SECTORS_16_LOCATION 0x13
+#define FAT32_FAT_SIZE_16_LOCATION 0x16 //0 on FAT32
+#define FAT32_TOTAL_SECTORS_32_LOCATION 0x20
+#define FAT32_FAT_SIZE_32_LOCATION 0x24
+#define FAT32_ROOT_CLUSTER_LOCATION 0x2C
+#define FAT32_MIN_CLUSTERS 65525 //Fewer clusters make it FAT12 or FAT16
+
+/****** File Allocation Table ***************/
+#define FAT32_ENTRIES_PER_BLOCK 128
+#define FAT32_CLUSTER_MASK 0x0FFFFFFF //The top 4 bits are reserved
+#define FAT32_FIRST_CLUSTER 2
+
+/****** Directory Entries ***************/
+#define FAT32_ENTRY_SIZE 32
+#define FAT32_ENTRIES_PER_BLOCK_DIRECTORY 16
+#define FAT32_ENTRY_END 0x00 //First name byte of the entry after the last one
+#define FAT32_ENTRY_DELETED 0xE5
+#define FAT32_ENTRY_ATTRIBUTE_OFFSET 11
+#define FAT32_ENTRY_CLUSTER_HIGH_OFFSET 20
+#define FAT32_ENTRY_CLUSTER_LOW_OFFSET 26
+#define FAT32_ENTRY_SIZE_OFFSET 28
+#define FAT32_ATTRIBUTE_VOLUME_ID 0x08
+#define FAT32_ATTRIBUTE_DIRECTORY 0x10
+#define FAT32_ATTRIBUTE_LONG_NAME 0x0F //Read only, hidden, system and volume ID together
+#define FAT32_LONG_NAME_LAST 0x40 //Set in the order byte of the entry holding the end of the name
+#define FAT32_LONG_NAME_ORDER_MASK 0x1F
+#define FAT32_LONG_NAME_CHECKSUM_OFFSET 13
+#define FAT32_LONG_NAME_CHARACTERS 13 //UTF-16 characters per entry
+
+#include <stdint.h>
+#include "struct_fat32_file.h"
+#include "microsd.h"
+#include "uart.h"
+
+/*
+****************************************************
+******** Public Functions Defined in fat32.c *******
+****************************************************
+*/
+uint8_t fat32_mount(void);
+uint8_t fat32_open(const char *tmp_path, t_fat32_file *tmp_file);
+void fat32_rewind(t_fat32_file *tmp_file);
+uint8_t fat32_next_extent(t_fat32_file *tmp_file, uint32_t *tmp_block_address, uint32_t *tmp_blocks);
+void fat32_open_directory(const t_fat32_file *tmp_directory, t_fat32_directory *tmp_iterator);
+uint8_t fat32_read_directory(t_fat32_directory *tmp_iterator, t_fat32_file *tmp_file);
+uint8_t fat32_names_match(const char *tmp_name_a, const char *tmp_name_b, uint16_t tmp_length);
+
+#endif /* FAT32_H */
+
+/* end of file */
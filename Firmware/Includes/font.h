@@ -112,14 +112,25 @@
 #define FONT_H
 
 #include <stdint.h>
+#include "struct_font_metrics.h"
 
 /*
 ****************************************************
 ******* Public Variables Defined in fonts.c *******
 ****************************************************
 */
-const uint8_t jet_font[91][80];
-const uint8_t jet_font_small[91][64];
+extern const uint8_t jet_font[91][80];
+extern const uint8_t jet_font_small[91][64];
+
+
+/*
+****************************************************
+*** Public Variables Defined in font_metrics.c ****
+****************************************************
+*/
+//Generated from the bitmaps above by Host/build/font_metrics
+extern const t_font_glyph_metrics jet_font_metrics[91];
+extern const t_font_glyph_metrics jet_font_small_metrics[91];
 
 
 #endif /* FONT_H */
@@ -95,6 +95,15 @@
 #define GUI_TESTS_HEADER_HEIGHT 70
 #define GUI_TESTS_TITLE_Y_OFFSET 100
 
+//Animation timing. Each period is what the timers_delay() busy loop it replaced took, 80us per unit at 100MHz
+#define GUI_BOOT_MAX_FRAMES (LCD_ANIMATION_MAX_PICTURES + 1) //Spinner frames, then the title
+#define GUI_BOOT_ROTATIONS 3
+#define GUI_BOOT_FRAME_MS 24 //timers_delay(300)
+#define GUI_BOOT_PAUSE_MS 320 //timers_delay(4000)
+#define GUI_BOOT_HOLD_MS 560 //timers_delay(7000)
+#define GUI_LOADING_CIRCLE_FRAMES 28
+#define GUI_LOADING_CIRCLE_FRAME_MS 40 //timers_delay(500)
+
 #include <math.h>
 #include <strings.h>
 #include "struct_gui_person_profile.h"
@@ -106,6 +115,8 @@
 #include "enum_dac_volume.h"
 #include "monitor.h"
 #include "rtc.h"
+#include "gui_compositor.h"
+#include "gui_animation.h"
 
 /*
 ****************************************************
@@ -126,6 +137,7 @@ void gui_draw_play_button(void);
 void gui_draw_pause_button(void);
 void gui_create_menu_contact_info(const t_light_button *tmp_button_list);
 void gui_create_menu_skills(const t_light_button *tmp_button_list, size_t length);
+void gui_scroll_menu_skills(int8_t tmp_rows);
 void gui_create_warning_menu( t_button *tmp_buttons, char **strings);
 
 void gui_create_menu_languages(uint32_t main_menu_image_address);
@@ -142,8 +154,8 @@ void gui_create_aboutme_experience_menu(void);
 void gui_create_aboutme_hobbies_menu(void);
 void gui_create_intro_menu(uint8_t tmp_startup_status_flag);
 
-void gui_loading_circle_animation(uint16_t x, uint16_t y);
-void gui_boot_animation(uint32_t *animation_frames, size_t number_of_frames);
+void gui_loading_circle_animation(t_gui_animation *tmp_animation, uint16_t x, uint16_t y);
+void gui_boot_animation(t_gui_animation *tmp_animation, const uint32_t *animation_frames, size_t number_of_frames, uint32_t delta_address);
 
 void gui_tests_create_main_menu(void);
 void gui_tests_display_pass_screen(void);
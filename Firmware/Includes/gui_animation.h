@@ -0,0 +1,57 @@
+/** @file gui_animation.h
+*
+* @brief  This file plays animations from the main loop. Each animation is a state object
+*         whose next frame is drawn once it is due, so the rest of the system keeps running
+*         between frames
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#ifndef GUI_ANIMATION_H
+#define GUI_ANIMATION_H
+
+#define GUI_ANIMATION_MAX_RUNNING 4
+#define GUI_ANIMATION_DONE 0xFFFFFFFF //Returned by step() after the last frame
+
+#include <stdint.h>
+#include <string.h>
+#include "struct_gui_animation.h"
+#include "timers.h"
+#include "uart.h"
+#include "personal_function_toolbox.h"
+
+/*
+****************************************************
+**** Public Functions Defined in gui_animation.c ****
+****************************************************
+*/
+uint8_t gui_animation_start(t_gui_animation *tmp_animation, uint32_t (*tmp_step)(t_gui_animation *), const char *tmp_name,
+                            uint8_t owns_screen);
+void gui_animation_stop(t_gui_animation *tmp_animation);
+void gui_animation_update(void);
+uint8_t gui_animation_is_running(const t_gui_animation *tmp_animation);
+uint8_t gui_animation_owns_screen(void);
+
+#endif /* GUI_ANIMATION_H */
+
+/* end of file */
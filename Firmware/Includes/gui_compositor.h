@@ -0,0 +1,53 @@
+/** @file gui_compositor.h
+*
+* @brief  This file tracks which parts of the status bar and footer are out of date and
+*         redraws only those widgets once per pass of the main loop
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#ifndef GUI_COMPOSITOR_H
+#define GUI_COMPOSITOR_H
+
+#define GUI_COMPOSITOR_MAX_PANELS 4
+#define GUI_COMPOSITOR_MAX_DIRTY_RECTS 8 //Further rectangles are merged into the last one
+
+#include <stdint.h>
+#include "struct_gui_widget.h"
+#include "lcd.h"
+
+/*
+****************************************************
+*** Public Functions Defined in gui_compositor.c ***
+****************************************************
+*/
+void gui_compositor_add_panel(t_gui_panel *tmp_panel);
+void gui_compositor_invalidate(const t_gui_rect *tmp_rect, uint8_t background_flag);
+void gui_compositor_invalidate_panel(t_gui_panel *tmp_panel);
+void gui_compositor_update_panel(t_gui_panel *tmp_panel);
+void gui_compositor_flush(void);
+uint32_t gui_compositor_get_frame_pixels(void);
+
+#endif /* GUI_COMPOSITOR_H */
+
+/* end of file */
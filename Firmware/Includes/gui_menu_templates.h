@@ -79,8 +79,10 @@
 
 #define MENU_SKILLS_ICON_WIDTH 32
 #define MENU_SKILLS_ICON_HEIGHT 40
-#define MENU_SKILLS_PICTURE_Y_OFFSET HEADER_OFFSET + 9
+#define MENU_SKILLS_PICTURE_Y_OFFSET HEADER_OFFSET + 8
 #define MENU_SKILLS_TEXT_SPACING 48
+#define MENU_SKILLS_VISIBLE_ROWS 7 //Rows between the title bar and the footer
+#define MENU_SKILLS_SCROLL_ZONE_HEIGHT 96 //Taps this close to the top or bottom of the list scroll it
 
 #define MENU_WARNING_BACKGROUND_OFFSET HEADER_OFFSET - 10
 #define MENU_WARNING_BACKGROUND_HEIGHT MENU_WARNING_BACKGROUND_OFFSET + 250
@@ -138,17 +140,17 @@ typedef enum e_menu3_button_tag
 ** Menu Templates defined in gui_menu_templates.c **
 ****************************************************
 */
-t_button menu1_template[4];
-t_button user_button_template[3];
-t_button menu3_template[4];
-t_button warning_menu_template[2];
-t_button intro_menu_template[3];
-t_button languages_menu_template[2];
-t_button settings_menu_template[4];
-t_button settings_time_menu_template[6];
-t_button about_me_menu_template[5];
-
-t_button touch_targets_template[5];
+extern t_button menu1_template[4];
+extern t_button user_button_template[3];
+extern t_button menu3_template[4];
+extern t_button warning_menu_template[2];
+extern t_button intro_menu_template[3];
+extern t_button languages_menu_template[2];
+extern t_button settings_menu_template[4];
+extern t_button settings_time_menu_template[6];
+extern t_button about_me_menu_template[5];
+
+extern t_button touch_targets_template[5];
 
 
 #endif /* GUI_MENU_TEMPLATES_H */
@@ -39,12 +39,14 @@
 #define LCD_WR  GPIOA,8
 #define LCD_RD  GPIOA,11
 #define LCD_BACKLIGHT GPIOC,12 //This is initialized as open drain
+#define LCD_DATA_BUS GPIOB,0 //DB0-DB7 on PB0-PB7
 
 
 /****** LCD Commands List ***********/
 #define LCD_CMD_COLUMN_ADDRESS_SET 0x2A
 #define LCD_CMD_PAGE_ADDRESS_SET 0x2B //Page means row here
 #define LCD_CMD_MEMORY_WRITE 0x2C
+#define LCD_CMD_MEMORY_READ 0x2E
 #define LCD_CMD_POWER_CONTROL_1 0xC0
 #define LCD_CMD_POWER_CONTROL_2 0xC1
 #define LCD_CMD_POWER_CONTROL_3 0xC2
@@ -62,12 +64,36 @@
 #define LCD_CMD_DISPLAY_INVERSION_ON 0x21
 #define LCD_CMD_DISPLAY_INVERSION_OFF 0x20
 #define LCD_CMD_BRIGHTNESS_VALUE 0x51
+#define LCD_CMD_VERTICAL_SCROLL_DEFINITION 0x33
+#define LCD_CMD_VERTICAL_SCROLL_START_ADDRESS 0x37
 
-#define LCD_BMP_OFFSET_LOCATION 0x0B
 #define LCD_MAX_SINGLE_LINE_CHARACTERS 26
 
-#define lcd_backlight_enable() gpio_clear(LCD_BACKLIGHT)
-#define lcd_backlight_disable() gpio_set(LCD_BACKLIGHT)
+/****** Screen and Font Dimensions **/
+#define LCD_WIDTH 320
+#define LCD_HEIGHT 480
+#define LCD_FONT_CELL_WIDTH 16 //Both fonts are drawn from 16 pixel wide cells
+#define LCD_FONT_HEIGHT 20
+#define LCD_FONT_SMALL_HEIGHT 16
+#define LCD_EXPANSION_CHUNK_BYTES 16 //2bpp bytes expanded per pass of lcd_send_bitmap()
+
+/****** GRAM Readback ***************/
+//Frame memory reads return each pixel as three bytes, red, green and blue in the top six
+//bits. The first byte after LCD_CMD_MEMORY_READ is a dummy
+#define LCD_DATA_BUS_MODER_MASK 0x0000FFFF   //DB0-DB7 on PB0-PB7
+#define LCD_DATA_BUS_MODER_OUTPUT 0x00005555
+#define LCD_GRAM_READ_DELAY 5 //timers_delay_mini() loops covering the 355ns RD low time of frame memory reads
+#define LCD_SAVE_UNDER_BYTES LCD_GLYPH_CACHE_PIXEL_BYTES //Compressed pixels kept by lcd_save_under(), in the glyph cache's RAM
+#define LCD_READ_CHUNK_PIXELS 32 //Pixels read back at a time by lcd_save_under(), on the stack
+
+#define lcd_backlight_enable() gpio_pin_clear(LCD_BACKLIGHT)
+#define lcd_backlight_disable() gpio_pin_set(LCD_BACKLIGHT)
+
+//Put a byte on DB0-DB7 and pulse LCD_WR to clock it in, three stores in all
+#define lcd_bus_write(byte) (gpio_bus_write_byte(LCD_DATA_BUS, (byte)), gpio_pin_set(LCD_WR), gpio_pin_clear(LCD_WR))
+
+//Select the LCD once any background transfer is done with the bus. See lcd_dma.c
+#define lcd_select() (lcd_dma_wait(), gpio_pin_clear(LCD_CS))
 
 #include <stdint.h>
 #include "stm32f4xx.h"
@@ -78,6 +104,10 @@
 #include "personal_function_toolbox.h"
 #include "bitmaps.h"
 #include "font.h"
+#include "lcd_dma.h"
+#include "lcd_display_list.h"
+#include "lcd_rgb565q.h"
+#include "lcd_sd_stream.h"
 
 /*
 ****************************************************
@@ -88,12 +118,36 @@ void lcd_init(void);
 void lcd_invert_screen_on(void);
 void lcd_invert_screen_off(void);
 void lcd_background_squares(void);
-void lcd_image_from_sd(uint16_t x_in ,uint16_t y_in,uint16_t x_fin ,uint16_t y_fin, uint32_t memory_starting_address);
 
 void lcd_draw_rectangle(uint16_t color,uint16_t x_in ,uint16_t y_in,uint16_t x_fin ,uint16_t y_fin);
 void lcd_print_string(char *tmp_string, uint16_t x, uint16_t y, uint16_t font_color, uint16_t background_color);
 void lcd_print_string_small(char *tmp_string, uint16_t x, uint16_t y, uint16_t font_color, uint16_t background_color);
+void lcd_print_string_over(char *tmp_string, uint16_t x, uint16_t y, uint16_t font_color);
+void lcd_print_string_small_over(char *tmp_string, uint16_t x, uint16_t y, uint16_t font_color);
 void lcd_send_bitmap(const uint8_t *tmp_bmp, uint16_t x, uint16_t y, uint16_t main_color, uint16_t background_color);
+void lcd_load_expansion_table(uint16_t font_color, uint16_t background_color);
+void lcd_expand_2bpp(const uint8_t *tmp_source, uint16_t source_bytes, uint16_t *tmp_pixels);
+void lcd_parse_local_bitmap(const uint8_t *tmp_bitmap, uint16_t *tmp_dimensions);
+uint16_t lcd_get_string_width_small(const char *tmp_string);
+uint32_t lcd_get_pixels_pushed(void);
+void lcd_add_pixels_pushed(uint32_t tmp_pixels);
+void lcd_scroll_define(uint16_t top_fixed_rows, uint16_t tmp_scroll_rows);
+void lcd_scroll_lines(int16_t tmp_lines);
+void lcd_scroll_reset(void);
+void lcd_read_region(uint16_t x_in, uint16_t y_in, uint16_t x_fin, uint16_t y_fin, uint16_t *tmp_pixels);
+uint8_t lcd_save_under(uint16_t x_in, uint16_t y_in, uint16_t x_fin, uint16_t y_fin, uint16_t tmp_bytes);
+uint8_t lcd_restore_under(void);
+void lcd_discard_under(void);
+void lcd_set_window_address(uint16_t x_initial,uint16_t y_initial,uint16_t x_final,uint16_t y_final);
+uint16_t lcd_scroll_map_row(uint16_t row, uint16_t *tmp_rows);
+void lcd_read_start(uint16_t x_in, uint16_t y_in, uint16_t x_fin, uint16_t y_fin);
+void lcd_read_pixels(uint16_t *tmp_pixels, uint32_t tmp_count);
+void lcd_read_end(void);
+void lcd_get_font_color_table(uint16_t *tmp_table, uint16_t tmp_font_color, uint16_t tmp_background_color);
+uint16_t lcd_get_string_width(const char *tmp_string, const t_font_glyph_metrics *tmp_metrics);
+void lcd_raster_glyph_row(uint16_t *tmp_line, const uint8_t *tmp_glyph, const uint16_t *tmp_glyph_pixels,
+                          const t_font_glyph_metrics *tmp_metrics, uint8_t row, uint8_t column_final,
+                          const uint16_t *tmp_palette);
 
 
 #endif /* LCD_H */
@@ -0,0 +1,62 @@
+/** @file lcd_display_list.h
+*
+* @brief  This file records rectangles, bitmaps, strings and SD images instead of drawing them,
+*         then sends each pixel of the recorded screen area to the LCD once
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#ifndef LCD_DISPLAY_LIST_H
+#define LCD_DISPLAY_LIST_H
+
+/****** Display List ****************/
+#define LCD_DISPLAY_LIST_LENGTH 48 //Primitives recorded before the list is flushed early
+#define LCD_DISPLAY_LIST_TEXT_BYTES 512 //Room for the strings of recorded text, terminators included
+
+#include <stdint.h>
+#include <string.h>
+#include "enum_lcd_primitive.h"
+#include "lcd.h"
+
+/*
+****************************************************
+** Public Functions Defined in lcd_display_list.c **
+****************************************************
+*/
+void lcd_display_list_begin(void);
+void lcd_display_list_end(void);
+void lcd_display_list_flush(void);
+uint8_t lcd_display_list_add_rectangle(uint16_t color, uint16_t x_in, uint16_t y_in, uint16_t x_fin, uint16_t y_fin);
+uint8_t lcd_display_list_add_bitmap(const uint8_t *tmp_bmp, uint16_t x, uint16_t y, uint16_t main_color, uint16_t background_color);
+uint8_t lcd_display_list_add_text(e_lcd_primitive tmp_type, const char *tmp_string, uint16_t x, uint16_t y,
+                                  uint16_t font_color, uint16_t background_color, uint8_t is_transparent);
+uint8_t lcd_display_list_add_sd_image(uint16_t x_in, uint16_t y_in, uint16_t x_fin, uint16_t y_fin, uint16_t image_column,
+                                      uint16_t image_row, uint16_t image_width, uint32_t memory_starting_address);
+uint8_t lcd_display_list_is_compositing(void);
+void lcd_display_list_composite_row(uint16_t row);
+void lcd_display_list_composite_bytes(const uint8_t *tmp_data, uint16_t tmp_bytes);
+void lcd_display_list_composite_pixels(uint16_t pixel_value, uint32_t repeat);
+
+#endif /* LCD_DISPLAY_LIST_H */
+
+/* end of file */
@@ -0,0 +1,78 @@
+/** @file lcd_dma.h
+*
+* @brief  This file clocks bytes out on the LCD bus in the background. TIM1 generates the LCD_WR
+*         strobes and DMA2 puts each byte on DB0-DB7, so large fills and image rows no longer
+*         hold up the CPU
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#ifndef LCD_DMA_H
+#define LCD_DMA_H
+
+/****** Strobe Timing ***************/
+//TIM1 channel 1 is the alternate function of LCD_WR (PA8). In PWM mode 2 it is low from
+//the start of each period and rises at CCR1, which latches the byte. Channel 2 matches halfway
+//through the high phase and asks DMA2 stream 2 for the next byte, so the bus changes well after
+//the latch and the byte still has the rest of the period to land before the next one
+//@warning Only checked against the simulator. DMA2 takes several AHB cycles to answer a request,
+//         so the period and strobe below must be measured on a scope before LCD_DMA_ENABLED is set.
+//         At 120ns per byte the transport is about half the speed of the CPU loop, it only pays
+//         where the CPU has other work while the bytes go out
+#ifndef LCD_DMA_ENABLED
+#define LCD_DMA_ENABLED 0 //Off until the strobe timing is measured on hardware, every transfer is sent by the CPU
+#endif
+
+#define LCD_DMA_WR_AF 1ul //TIM1_CH1 on PA8
+#define LCD_DMA_PERIOD_CYCLES 12 //120ns per byte at 100MHz, twice the 50ns write cycle with room for DMA latency
+#define LCD_DMA_STROBE_CYCLES 4 //LCD_WR low for the first 40ns of the period
+#define LCD_DMA_REQUEST_CYCLES 8 //Middle of the high phase
+#define LCD_DMA_CHUNK_BYTES 256 //TIM1 RCR is 8 bits, longer transfers are restarted from the update interrupt
+#define LCD_DMA_MIN_BYTES 128 //Smaller transfers are sent by the CPU, setting up the timer and stream costs about this much
+
+/****** DMA2 Stream 2 ***************/
+#define LCD_DMA_STREAM DMA2_Stream2
+#define LCD_DMA_CHANNEL 6ul //TIM1_CH2
+#define LCD_DMA_FLAGS 0x003D0000 //Every DMA2 stream 2 flag in LISR/LIFCR
+
+#include <stdint.h>
+#include "stm32f4xx.h"
+#include "stm32f410rx.h"
+#include "base_gpio_drivers.h"
+#include "lcd.h"
+
+/*
+****************************************************
+******* Public Functions Defined in lcd_dma.c ******
+****************************************************
+*/
+void lcd_dma_init(void);
+void lcd_dma_fill(uint16_t color, uint32_t pixels, uint8_t release_lcd);
+void lcd_dma_send(const uint8_t *tmp_data, uint32_t tmp_bytes, uint8_t release_lcd);
+void lcd_dma_wait(void);
+uint8_t lcd_dma_busy(void);
+void TIM1_UP_IRQHandler(void);
+
+#endif /* LCD_DMA_H */
+
+/* end of file */
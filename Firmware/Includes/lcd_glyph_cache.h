@@ -0,0 +1,56 @@
+/** @file lcd_glyph_cache.h
+*
+* @brief  This file keeps recently drawn font glyphs expanded to RGB565 in a fixed amount of RAM,
+*         so text drawn again in the same colors is copied instead of decoded
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#ifndef LCD_GLYPH_CACHE_H
+#define LCD_GLYPH_CACHE_H
+
+#define LCD_GLYPH_CACHE_BYTES 8192 //Hard cap, the MCU only has 32 KB of SRAM
+#define LCD_GLYPH_CACHE_ENTRIES 40 //Glyphs held at most, the average ink box is about 106 pixels
+#define LCD_GLYPH_CACHE_PIXELS 3520 //Ink boxes are packed one after the other, the largest is 208 pixels
+#define LCD_GLYPH_CACHE_PIXEL_BYTES (LCD_GLYPH_CACHE_PIXELS * 2) //Lent out by lcd_glyph_cache_lend()
+
+#include <stdint.h>
+#include <string.h>
+#include "struct_lcd_glyph_cache.h"
+#include "lcd.h"
+
+/*
+****************************************************
+** Public Functions Defined in lcd_glyph_cache.c ***
+****************************************************
+*/
+void lcd_glyph_cache_start_pass(void);
+const uint16_t *lcd_glyph_cache_get(const uint8_t *tmp_font, uint8_t glyph_height, char tmp_char,
+                                    const t_font_glyph_metrics *tmp_metrics, const uint16_t *tmp_palette);
+void lcd_glyph_cache_get_stats(t_lcd_glyph_cache_stats *tmp_stats);
+uint8_t *lcd_glyph_cache_lend(void);
+void lcd_glyph_cache_reclaim(void);
+
+#endif /* LCD_GLYPH_CACHE_H */
+
+/* end of file */
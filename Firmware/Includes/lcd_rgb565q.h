@@ -0,0 +1,70 @@
+/** @file lcd_rgb565q.h
+*
+* @brief  This file contains the decoder of compressed RGB565 images and the encoder used to
+*         keep pixels read back from the LCD in the same format
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#ifndef LCD_RGB565Q_H
+#define LCD_RGB565Q_H
+
+/****** Compressed RGB565 Images ****/
+//RGB565 container with this signature and the image size field holding the bytes of
+//compressed data. Pixels are coded in BMP order by ops of one to three bytes:
+//   00iiiiii                     pixel i of the table of recently seen pixels
+//   01rrggbb                     previous pixel, each channel plus -2..1
+//   10gggggg rrrrbbbb            previous pixel, green plus -32..31, red and blue plus
+//                                half of that green step and -8..7
+//   11nnnnnn                     previous pixel n + 1 more times, n up to 61
+//   11111110 hhhhhhhh llllllll   literal pixel, high byte first
+//Channels wrap around. Every pixel decoded goes into the table at
+//((red * 3) + (green * 5) + (blue * 7)) % 64. See Host/Includes/rgb565_image.h for the encoder
+#define LCD_RGB565Q_SIGNATURE_0 'R'
+#define LCD_RGB565Q_SIGNATURE_1 'Q'
+#define LCD_BMP_IMAGE_SIZE_LOCATION 0x22
+#define LCD_RGB565Q_OP_MASK 0xC0
+#define LCD_RGB565Q_OP_INDEX 0x00
+#define LCD_RGB565Q_OP_DIFF 0x40
+#define LCD_RGB565Q_OP_LUMA 0x80
+#define LCD_RGB565Q_OP_RUN 0xC0
+#define LCD_RGB565Q_OP_PIXEL 0xFE
+#define LCD_RGB565Q_MAX_RUN 62
+
+#include <stdint.h>
+#include <string.h>
+#include "struct_lcd_rgb565q.h"
+#include "lcd.h"
+
+/*
+****************************************************
+***** Public Functions Defined in lcd_rgb565q.c ****
+****************************************************
+*/
+uint16_t lcd_drain_rgb565q(const uint8_t *tmp_data, uint16_t tmp_bytes, t_lcd_rgb565q_decoder *tmp_decoder);
+void lcd_encode_rgb565q(const uint16_t *tmp_pixels, uint16_t tmp_count, t_lcd_rgb565q_encoder *tmp_encoder);
+void lcd_encode_rgb565q_end(t_lcd_rgb565q_encoder *tmp_encoder);
+
+#endif /* LCD_RGB565Q_H */
+
+/* end of file */
@@ -0,0 +1,98 @@
+/** @file lcd_sd_stream.h
+*
+* @brief  This file streams images and animations from the SD card to the LCD. Blocks are
+*         read by DMA while the ones before them are sent
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#ifndef LCD_SD_STREAM_H
+#define LCD_SD_STREAM_H
+
+#define LCD_BMP_OFFSET_LOCATION 0x0B
+#define LCD_BMP_WIDTH_LOCATION 0x12
+
+/****** RGB565 SD Card Images *******/
+//Same header layout as a .BMP (data offset at 0x0A, width/height at 0x12/0x16) with this
+//signature in place of "BM". Pixel data is 16-bit RGB565, high byte first, in the same
+//order as the .BMP it was converted from. See Host/Source/bmp_to_rgb565.cpp
+#define LCD_RGB565_SIGNATURE_0 'R'
+#define LCD_RGB565_SIGNATURE_1 '5'
+
+/****** Interlaced RGB565 Images ****/
+//RGB565 container with this signature and the number of rows at 0x16. The rows are stored
+//in four passes: every 8th row from row 0, every 8th from row 4, every 4th from row 2, then
+//the odd rows. Each pass is drawn over the rows the next ones fill in, 8, 4, 2 and 1 tall,
+//so after the first eighth of the file the whole image is on the screen at a coarse
+//resolution. See Host/Includes/rgb565_image.h for the encoder
+#define LCD_RGB565I_SIGNATURE_0 'R'
+#define LCD_RGB565I_SIGNATURE_1 'I'
+#define LCD_BMP_HEIGHT_LOCATION 0x16
+#define LCD_INTERLACE_PASSES 4
+
+/****** Delta Animations ************/
+//RGB565 container with this signature. The compression field holds the number of pictures
+//and the data offset points at a table of little endian uint32 file offsets, one for each
+//entry plus one for the end of the data. Entry 0 is the first picture whole, entry n holds
+//what changed from picture n - 1 to picture n and the last entry what changes back to
+//picture 0, so the animation can loop. An entry is a little endian uint16 count of
+//rectangles, each an x, y, width and height (little endian uint16, from the top left
+//corner of the animation) followed by its RGB565 pixels, high byte first, row by row.
+//See Host/Includes/rgb565_image.h for the encoder
+#define LCD_ANIMATION_SIGNATURE_0 'R'
+#define LCD_ANIMATION_SIGNATURE_1 'A'
+#define LCD_BMP_COMPRESSION_LOCATION 0x1E
+#define LCD_ANIMATION_RECTANGLE_BYTES 8
+
+/****** SD Card Reads ***************/
+#define LCD_SD_BLOCK_BYTES 512
+#define LCD_SD_BLOCK_DMA_BYTES (LCD_SD_BLOCK_BYTES + 2) //Data plus the 16-bit CRC that follows it
+#define LCD_SD_BATCH_GAP_BLOCKS 2 //Unused blocks read through between two images of a batch, restarting the read costs about that much
+
+#include <stdint.h>
+#include <string.h>
+#include "microsd.h"
+#include "struct_lcd_animation.h"
+#include "struct_lcd_image_blit.h"
+#include "lcd.h"
+#include "lcd_rgb565q.h"
+
+/*
+****************************************************
+*** Public Functions Defined in lcd_sd_stream.c ****
+****************************************************
+*/
+void lcd_image_from_sd(uint16_t x_in ,uint16_t y_in,uint16_t x_fin ,uint16_t y_fin, uint32_t memory_starting_address);
+void lcd_image_region_from_sd(uint16_t x_in, uint16_t y_in, uint16_t x_fin, uint16_t y_fin,
+                              uint16_t image_x, uint16_t image_y, uint32_t memory_starting_address);
+void lcd_images_from_sd(const t_lcd_image_blit *tmp_images, uint8_t image_count);
+uint8_t lcd_animation_open(t_lcd_animation *tmp_animation, uint16_t x, uint16_t y, uint32_t memory_starting_address);
+uint8_t lcd_animation_draw_next(t_lcd_animation *tmp_animation);
+void lcd_stream_image_from_sd(uint16_t x_in, uint16_t y_in, uint16_t x_fin, uint16_t y_fin, uint16_t image_column,
+                              uint16_t image_row, uint16_t image_width, uint32_t memory_starting_address);
+void lcd_sd_batch_begin(void);
+void lcd_sd_batch_end(void);
+
+#endif /* LCD_SD_STREAM_H */
+
+/* end of file */
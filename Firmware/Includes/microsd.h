@@ -39,10 +39,27 @@
 #define SD_RESPONSE3_POWER_UP 0X80
 #define SD_RESPONSE3_CCS 0x40
 #define SD_CMD17_TOKEN 0xFE
+#define SD_READ_TOKEN_TIMEOUT 6000 //Bytes polled for the token in front of a block read
+#define SD_DATA_ERROR_MASK 0xF0 //Clear in a data error token, sent instead of a block the card cannot read
+#define SD_CMD25_TOKEN 0xFC //Start of each block of a multiple block write
+#define SD_STOP_TRAN_TOKEN 0xFD //Ends a multiple block write
+#define SD_DATA_RESPONSE_MASK 0x1F
+#define SD_DATA_ACCEPTED 0x05
+#define SD_WRITE_TIMEOUT 0xFFFFF //Bytes polled before giving up on a response or busy, about 350 ms at 25 MHz
 
 /******************* File addresses *******************/
 #define SD_ADDRESS_CHEAT_SHEET 4000000
-#define SD_ADDRESS_LIST_OFFSET 0
+#define SD_ADDRESS_LIST_OFFSET 0 //Big-endian start block per file
+#define SD_ADDRESS_FORMAT_OFFSET 512 //SD_ADDRESS_FORMAT_TAG once the table also holds sizes and types
+#define SD_ADDRESS_FORMAT_TAG "SDT2"
+#define SD_ADDRESS_SIZE_OFFSET 516 //Big-endian uint16 per file, blocks of a WAV, 0 if not known
+#define SD_ADDRESS_TYPE_OFFSET 772 //e_sd_file_type per file
+#define SD_ADDRESS_TYPE_UNKNOWN 0xFF
+#define SD_SEARCH_FIRST_BLOCK 15000 //Files are searched for from here up
+#define SD_SEARCH_HASH_SLOTS 256 //Power of 2, at least twice max_total_addresses
+#define SD_SEARCH_SLOT_EMPTY 0x00
+#define SD_SEARCH_SLOT_FOUND 0xFF //Kept in the probe sequence, but the file is no longer looked for
+#define SD_ASSET_DIRECTORY "/assets" //FAT32 directory holding every file by its name in file_list
 
 
 #include <stdint.h>
@@ -55,6 +72,8 @@
 #include "uart.h"
 #include "lcd.h"
 #include "personal_function_toolbox.h"
+#include "fat32.h"
+#include "sd_block_cache.h"
 
 /*
 ****************************************************
@@ -64,8 +83,10 @@
 uint8_t microsd_init(void);
 void sd_read_block(uint8_t *p_read_buffer, uint32_t block_address);
 void sd_write_block(uint8_t *tmp_write_buffer, uint32_t block_address);
+uint8_t sd_write_multiple_block(const uint8_t *tmp_write_buffer, uint32_t block_address, uint32_t tmp_blocks, uint8_t tmp_pre_erase);
 uint32_t sd_find_file_address(const uint8_t *file_identifier);
 void sd_read_multiple_block(uint32_t start_address);
+uint8_t sd_wait_read_token(void);
 void sd_print_block(uint64_t block_address);
 void sd_stop_transmission(void);
 void sd_search_file_addresses(void);
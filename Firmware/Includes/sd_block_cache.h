@@ -0,0 +1,66 @@
+/** @file sd_block_cache.h
+*
+* @brief  This file keeps recently read SD card blocks in a fixed number of 512-byte slots of RAM,
+*         so metadata read again, like the file address table, the startup flag and the FAT32
+*         directories and FAT, is copied instead of read from the card
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#ifndef SD_BLOCK_CACHE_H
+#define SD_BLOCK_CACHE_H
+
+//Each slot is 512 bytes of SRAM. At least 3, sd_import_file_addresses() pins the two file
+//address table blocks while it reads WAV headers
+#ifndef SD_BLOCK_CACHE_SLOTS
+#define SD_BLOCK_CACHE_SLOTS 4
+#endif
+
+#if SD_BLOCK_CACHE_SLOTS < 3
+#error "SD_BLOCK_CACHE_SLOTS must be at least 3"
+#endif
+
+#define SD_BLOCK_CACHE_BLOCK_BYTES 512
+
+#include <stdint.h>
+#include <string.h>
+#include "struct_sd_block_cache.h"
+#include "microsd.h"
+
+/*
+****************************************************
+*** Public Functions Defined in sd_block_cache.c ***
+****************************************************
+*/
+const uint8_t *sd_block_cache_get(uint32_t block_address);
+void sd_block_cache_read(uint8_t *tmp_buffer, uint32_t block_address, uint16_t tmp_offset, uint16_t tmp_bytes);
+void sd_block_cache_write(const uint8_t *tmp_write_buffer, uint32_t block_address);
+const uint8_t *sd_block_cache_pin(uint32_t block_address);
+void sd_block_cache_unpin(uint32_t block_address);
+void sd_block_cache_invalidate(uint32_t block_address, uint32_t tmp_blocks);
+void sd_block_cache_invalidate_all(void);
+void sd_block_cache_get_stats(t_sd_block_cache_stats *tmp_stats);
+
+#endif /* SD_BLOCK_CACHE_H */
+
+/* end of file */
@@ -35,6 +35,9 @@
 
 #define spi_set_clk_low_speed()  SPI2->CR1 |= (0x07 << SPI_CR1_BR_Pos); //50MHz/256 = 200KHz
 #define spi_set_clk_med_speed()  SPI2->CR1 |= (0x01 << SPI_CR1_BR_Pos); //50MHz/4 = 12.5MHz
+#define SPI_DMA_RX_FLAGS 0x0F400000 //Every DMA1 stream 3 flag in LISR/LIFCR
+#define SPI_DMA_TX_FLAGS 0x0000003D //Every DMA1 stream 4 flag in HISR/HIFCR
+
 #define spi_set_clk_high_speed() SPI2->CR1 &= ~(0x07 << SPI_CR1_BR_Pos); //50MHz/2 = 25MHz
 
 #include <stdint.h>
@@ -52,6 +55,9 @@
 void spi_spi2_init(void);
 void spi_send_byte(uint8_t tmp_byte);
 uint8_t spi_receive_byte(uint8_t dummy_byte);
+void spi_dma_receive_start(uint8_t *tmp_buffer, uint16_t tmp_bytes);
+void spi_dma_receive_wait(void);
+void spi_receive_flush(void);
 
 #endif /* SPI_H */
 
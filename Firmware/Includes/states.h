@@ -38,10 +38,17 @@
 #define STATES_STARTUP_FLAG_SET 1
 #define STATES_STARTUP_FLAG_CLEAR 0
 
+//Encoded bytes of the area under the settings popup in each main menu, see states_popup_save_under_bytes()
+#define STATES_UNDER_REFERENCES_BYTES 20279
+#define STATES_UNDER_CONTACT_BYTES 20962
+#define STATES_UNDER_ABOUT_ME_BYTES 30081
+#define STATES_UNDER_LANGUAGE_BYTES 28940
+
 #include "enum_sd_file_list.h"
 #include "struct_buttons.h"
 #include "microsd.h"
 #include "lcd.h"
+#include "lcd_glyph_cache.h"
 #include "dac.h"
 #include "gui.h"
 #include "struct_gui_person_profile.h"
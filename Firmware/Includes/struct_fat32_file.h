@@ -0,0 +1,63 @@
+/** @file struct_fat32_file.h
+*
+* @brief  This file contains the structures used to walk files and directories of a FAT32 volume
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#ifndef STRUCT_FAT32_FILE_H
+#define STRUCT_FAT32_FILE_H
+
+#define FAT32_MAX_NAME_LENGTH 64 //Longer names are cut short
+
+#include <stdint.h>
+
+/*
+****************************************************
+***** Private Types and Structure Definitions ******
+****************************************************
+*/
+typedef struct t_fat32_file_tag
+{
+   uint32_t first_cluster;
+   uint32_t size;            //In bytes, 0 for directories
+   uint8_t is_directory;
+   uint32_t next_cluster;    //First cluster of the next extent, 0 once the chain has been read
+   uint32_t blocks_left;     //Blocks of the file not yet handed out by fat32_next_extent()
+
+} t_fat32_file;
+
+
+typedef struct t_fat32_directory_tag
+{
+   uint32_t cluster;         //Cluster holding the next entry, 0 once the end is reached
+   uint16_t entry;           //Entry within that cluster
+   uint8_t long_name_checksum; //Checksum of the 8.3 name the long name being collected belongs to
+   uint8_t has_long_name;
+   char name[FAT32_MAX_NAME_LENGTH + 1]; //Long name of the last entry read, or its 8.3 name if it has none
+
+} t_fat32_directory;
+
+#endif /* STRUCT_FAT32_FILE_H */
+
+/* end of file */
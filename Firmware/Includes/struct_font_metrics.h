@@ -0,0 +1,51 @@
+/** @file struct_font_metrics.h
+*
+* @brief  This contains the per-glyph layout data generated from font.c, which is meant to be
+*         accessed by the LCD driver and the GUI
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#ifndef STRUCT_FONT_METRICS_H
+#define STRUCT_FONT_METRICS_H
+
+#include <stdint.h>
+
+/*
+****************************************************
+***** Private Types and Structure Definitions ******
+****************************************************
+*/
+typedef struct t_font_glyph_metrics_tag
+{
+   uint8_t advance;       //Distance from this character to the next
+   uint8_t ink_x_initial; //Smallest box of the cell holding anything but background.
+   uint8_t ink_x_final;   //Final values are exclusive, and all four are 0 for a blank glyph
+   uint8_t ink_y_initial;
+   uint8_t ink_y_final;
+
+} t_font_glyph_metrics;
+
+#endif /* STRUCT_FONT_METRICS_H */
+
+/* end of file */
@@ -0,0 +1,58 @@
+/** @file struct_gui_animation.h
+*
+* @brief  This contains the state of an animation played from the main loop, which is meant
+*         to be accessed by the animation engine and the GUI
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#ifndef STRUCT_GUI_ANIMATION_H
+#define STRUCT_GUI_ANIMATION_H
+
+#include <stdint.h>
+
+/*
+****************************************************
+***** Private Types and Structure Definitions ******
+****************************************************
+*/
+typedef struct t_gui_animation_tag
+{
+   uint32_t (*step)(struct t_gui_animation_tag *tmp_animation); //Draws frame number "frame", returns the ms until the next one
+   const char *name;      //Used in the jitter report
+   uint16_t x;            //Free for step(), e.g. the position on the screen
+   uint16_t y;
+   uint16_t frame;        //Frames drawn so far
+   uint8_t owns_screen;   //Status bar and footer are not drawn while it plays
+   uint8_t running;
+   uint32_t due_us;       //When the next frame should be drawn
+
+   //Frame time jitter, how late each frame was drawn compared to its schedule
+   uint32_t late_total_us;
+   uint32_t late_max_us;
+
+} t_gui_animation;
+
+#endif /* STRUCT_GUI_ANIMATION_H */
+
+/* end of file */
@@ -0,0 +1,71 @@
+/** @file struct_gui_widget.h
+*
+* @brief  This contains the rectangle, widget and panel structures used by the GUI
+*         compositor, which is meant to be accessed by both the GUI and the system state machine
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#ifndef STRUCT_GUI_WIDGET_H
+#define STRUCT_GUI_WIDGET_H
+
+#include <stdint.h>
+
+/*
+****************************************************
+***** Private Types and Structure Definitions ******
+****************************************************
+*/
+typedef struct t_gui_rect_tag
+{
+   uint16_t x_initial; //Same convention as lcd_draw_rectangle(), final values are exclusive
+   uint16_t y_initial;
+   uint16_t x_final;
+   uint16_t y_final;
+
+} t_gui_rect;
+
+
+typedef struct t_gui_widget_tag
+{
+   t_gui_rect area; //Everything draw() paints lies inside this rectangle
+   uint32_t (*get_state)(void); //Packs every input the widget's pixels depend on, NULL if it only redraws with its panel
+   void (*draw)(const struct t_gui_widget_tag *tmp_widget, uint16_t background_color);
+   uint32_t state; //Value of get_state() the last time the widget was invalidated
+   uint8_t id; //Free for draw(), e.g. a button index
+
+} t_gui_widget;
+
+
+typedef struct t_gui_panel_tag
+{
+   t_gui_rect area;
+   uint16_t (*get_background_color)(void);
+   t_gui_widget *widgets;
+   uint8_t widget_count;
+
+} t_gui_panel;
+
+#endif /* STRUCT_GUI_WIDGET_H */
+
+/* end of file */
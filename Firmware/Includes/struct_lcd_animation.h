@@ -0,0 +1,54 @@
+/** @file struct_lcd_animation.h
+*
+* @brief  This contains the playback state of a delta animation on the SD card, which is meant
+*         to be accessed by the LCD driver, the GUI and the host tools
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#ifndef STRUCT_LCD_ANIMATION_H
+#define STRUCT_LCD_ANIMATION_H
+
+#define LCD_ANIMATION_MAX_PICTURES 30 //The entry table must fit in the first block with the header
+
+#include <stdint.h>
+
+/*
+****************************************************
+***** Private Types and Structure Definitions ******
+****************************************************
+*/
+typedef struct t_lcd_animation_tag
+{
+   uint32_t address;    //Memory block location of the animation on the SD card
+   uint16_t x;          //Screen position of its top left corner
+   uint16_t y;
+   uint8_t pictures;
+   uint8_t next_entry;  //Entry drawn by the next lcd_animation_draw_next()
+   uint32_t entry_offsets[LCD_ANIMATION_MAX_PICTURES + 2]; //File offset of each entry, then of the end of the data
+
+} t_lcd_animation;
+
+#endif /* STRUCT_LCD_ANIMATION_H */
+
+/* end of file */
@@ -0,0 +1,52 @@
+/** @file struct_lcd_glyph_cache.h
+*
+* @brief  This contains the counters reported by the LCD glyph cache, which is meant to be
+*         accessed by the LCD driver and the host tools
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#ifndef STRUCT_LCD_GLYPH_CACHE_H
+#define STRUCT_LCD_GLYPH_CACHE_H
+
+#include <stdint.h>
+
+/*
+****************************************************
+***** Private Types and Structure Definitions ******
+****************************************************
+*/
+typedef struct t_lcd_glyph_cache_stats_tag
+{
+   uint32_t hits;      //Lookups answered from RAM
+   uint32_t misses;    //Lookups that expanded the glyph into a slot
+   uint32_t bypasses;  //Lookups turned away because every slot held a glyph of the current pass, or the pixels were lent out
+   uint32_t evictions; //Glyphs dropped to make room for another one
+   uint16_t glyphs;    //Glyphs held right now
+   uint16_t bytes;     //RAM reserved for expanded glyphs, never more than LCD_GLYPH_CACHE_BYTES
+
+} t_lcd_glyph_cache_stats;
+
+#endif /* STRUCT_LCD_GLYPH_CACHE_H */
+
+/* end of file */
@@ -0,0 +1,51 @@
+/** @file struct_lcd_image_blit.h
+*
+* @brief  This contains one entry of a batch of SD card images drawn by lcd_images_from_sd(),
+*         which is meant to be accessed by the LCD driver and the GUI
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#ifndef STRUCT_LCD_IMAGE_BLIT_H
+#define STRUCT_LCD_IMAGE_BLIT_H
+
+#include <stdint.h>
+
+/*
+****************************************************
+***** Private Types and Structure Definitions ******
+****************************************************
+*/
+typedef struct t_lcd_image_blit_tag
+{
+   uint16_t x_initial;  //Screen rectangle the image is drawn in, final positions exclusive
+   uint16_t y_initial;
+   uint16_t x_final;
+   uint16_t y_final;
+   uint32_t address;    //Memory block location of the image on the SD card
+
+} t_lcd_image_blit;
+
+#endif /* STRUCT_LCD_IMAGE_BLIT_H */
+
+/* end of file */
@@ -0,0 +1,72 @@
+/** @file struct_lcd_rgb565q.h
+*
+* @brief  This file contains the state kept while decoding or encoding compressed RGB565 images
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#ifndef STRUCT_LCD_RGB565Q_H
+#define STRUCT_LCD_RGB565Q_H
+
+#define LCD_RGB565Q_INDEX_LENGTH 64 //Recently seen pixels kept by both sides, see LCD_RGB565Q_* in lcd_rgb565q.h
+
+#include <stdint.h>
+
+/*
+****************************************************
+***** Private Types and Structure Definitions ******
+****************************************************
+*/
+//Streaming state of a compressed RGB565 image, see LCD_RGB565Q_* in lcd_rgb565q.h
+typedef struct t_lcd_rgb565q_decoder_tag
+{
+   uint16_t index[LCD_RGB565Q_INDEX_LENGTH]; //Recently seen pixels
+   uint16_t pixel;                            //Last pixel decoded
+   uint32_t pixels_left;                      //Decoding stops once the window is full
+   uint16_t image_width;
+   uint16_t column;                           //Image column of the next pixel decoded
+   uint16_t column_initial;                   //Image columns inside the window
+   uint16_t column_final;
+   uint16_t rows_to_skip;                     //Image rows above the window still to decode
+   uint8_t op[3];                             //Op being collected, it may be split across blocks
+   uint8_t op_bytes;
+
+} t_lcd_rgb565q_decoder;
+
+
+//Compression state of lcd_encode_rgb565q(), the encoder side of t_lcd_rgb565q_decoder
+typedef struct t_lcd_rgb565q_encoder_tag
+{
+   uint16_t index[LCD_RGB565Q_INDEX_LENGTH]; //Recently seen pixels
+   uint16_t previous;                         //Last pixel coded
+   uint8_t run;                               //Repeats of previous not yet written
+   uint8_t *data;
+   uint16_t capacity;                         //Bytes data has room for, is_full is set past it
+   uint16_t bytes;                            //Written to data
+   uint8_t is_full;
+
+} t_lcd_rgb565q_encoder;
+
+#endif /* STRUCT_LCD_RGB565Q_H */
+
+/* end of file */
@@ -0,0 +1,53 @@
+/** @file struct_sd_block_cache.h
+*
+* @brief  This contains the counters reported by the SD block cache, which is meant to be
+*         accessed by the SD card driver and the host tools
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#ifndef STRUCT_SD_BLOCK_CACHE_H
+#define STRUCT_SD_BLOCK_CACHE_H
+
+#include <stdint.h>
+
+/*
+****************************************************
+***** Private Types and Structure Definitions ******
+****************************************************
+*/
+typedef struct t_sd_block_cache_stats_tag
+{
+   uint32_t hits;          //Reads answered from RAM
+   uint32_t misses;        //Reads that went to the card
+   uint32_t evictions;     //Blocks dropped to make room for another one
+   uint32_t invalidations; //Cached blocks dropped because the card was written or changed
+   uint16_t blocks;        //Blocks held right now
+   uint16_t pinned;        //Slots that are never evicted right now
+   uint16_t bytes;         //RAM reserved for blocks, SD_BLOCK_CACHE_SLOTS * 512
+
+} t_sd_block_cache_stats;
+
+#endif /* STRUCT_SD_BLOCK_CACHE_H */
+
+/* end of file */
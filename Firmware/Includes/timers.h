@@ -63,8 +63,11 @@ void timers_update_audio_clock(void);
 uint16_t timers_get_audio_clock(void);
 void timers_reset_audio_clock(void);
 void timers_uint16_to_time(uint16_t tmp_counter_value, char *converted_time);
+uint32_t timers_get_ms(void);
+uint32_t timers_get_us(void);
 void timers_delay(uint32_t delay_time);
 void timers_delay_mini(uint32_t delay_time);
+void SysTick_Handler(void);
 
 #endif /* TIMERS_H */
 
@@ -86,7 +86,7 @@
 ****************************************************
 */
 void uart1_init(uint32_t baud_rate);
-void uart1_printf(char print_statement[]);
+void uart1_printf(const char print_statement[]);
 void uart1_send_byte(char tmp_byte);
 void uart1_arduino_plotter(char temp_single_char);
 
@@ -60,6 +60,7 @@
 void
 gpio_clk_init(GPIO_TypeDef * p_gpio_tmp, uint8_t pin_number)
 {
+   (void)pin_number; //The clock is enabled for the whole port
    if (p_gpio_tmp == GPIOA)
    {
       RCC->AHB1ENR |= RCC_AHB1ENR_GPIOAEN;
@@ -73,27 +73,36 @@ void buttons_make_ghost_button(t_button button, char *button_text);
 void
 buttons_create(t_button buttons[], char **button_text, size_t list_length)
 {
+   static char empty_text[] = "";
+
+   lcd_display_list_begin();
+
    //Loop through all buttons in the list
    for(uint8_t current_button = 0; current_button < list_length; current_button++)
    {
       e_button_type type = buttons[current_button].type;
 
+      //Buttons without text are given a NULL entry. Treat them as an empty string
+      char *tmp_text = (NULL != button_text[current_button]) ? button_text[current_button] : empty_text;
+
       switch(type)
       {
       case button_rectangle:
-         buttons_make_rectangle_button(buttons[current_button], button_text[current_button]);
+         buttons_make_rectangle_button(buttons[current_button], tmp_text);
          break;
       case button_rounded_corners:
-         buttons_make_rounded_button(buttons[current_button], button_text[current_button]);
+         buttons_make_rounded_button(buttons[current_button], tmp_text);
          break;
       case button_ghost:
-         buttons_make_ghost_button(buttons[current_button], button_text[current_button]);
+         buttons_make_ghost_button(buttons[current_button], tmp_text);
          break;
       default:
          break;
 
       }
    }
+
+   lcd_display_list_end();
 }
 
 
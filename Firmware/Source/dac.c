@@ -126,7 +126,7 @@ dac_audio_from_sd(uint32_t memory_starting_address)
       g_dma_transfer_complete_flag = 0;
 
       DMA1_Stream5->NDTR = 512;
-      DMA1_Stream5->M0AR = (uint32_t)p_current_buffer;
+      DMA1_Stream5->M0AR = (uint32_t)(uintptr_t)p_current_buffer;
       DMA1_Stream5->CR |= DMA_SxCR_EN;
 
       //Burn through the CRC bits and wait until SD card sends data valid token
@@ -198,7 +198,7 @@ dac_service_audio(uint32_t total_blocks, uint8_t tmp_early_termination_flag)
 
       //Reinitialize the DMA with the new buffer address and enable it
       DMA1_Stream5->NDTR = 512;
-      DMA1_Stream5->M0AR = (uint32_t)p_current_buffer;
+      DMA1_Stream5->M0AR = (uint32_t)(uintptr_t)p_current_buffer;
       DMA1_Stream5->CR |= DMA_SxCR_EN;
 
       //Burn through the CRC bits and wait until SD card sends data valid token
@@ -321,7 +321,7 @@ dac_dma1_init(void)
    DMA1_Stream5->CR |= (DMA_SxCR_MSIZE_0 | DMA_SxCR_PSIZE_0);
 
    //Send to 12-bit right aligned DAC output register
-   DMA1_Stream5->PAR = (uint32_t)&(DAC1->DHR12R1);
+   DMA1_Stream5->PAR = (uint32_t)(uintptr_t)&(DAC1->DHR12R1);
 
 }
 
@@ -396,7 +396,7 @@ dac_start_audio_transmission(uint32_t tmp_address)
    //Enable DMA
    DMA1->HIFCR = 0x0F7C0F7C;
    DMA1_Stream5->NDTR = 512;
-   DMA1_Stream5->M0AR = (uint32_t)tmp_buffer; //DMA read from ping buffer
+   DMA1_Stream5->M0AR = (uint32_t)(uintptr_t)tmp_buffer; //DMA read from ping buffer
    DMA1_Stream5->CR |= DMA_SxCR_EN;
 
    //Enable timer
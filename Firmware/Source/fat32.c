@@ -0,0 +1,595 @@
+/** @file fat32.c
+*
+* @brief  This file reads files from the FAT32 volume on the microSD card. Only what is needed
+*         to find and stream files is here: the volume is never written, and only the first
+*         copy of the FAT is used. Long names are read as ASCII and compared without regard
+*         to case, like the card reader of a PC does.
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#include "fat32.h"
+
+
+/*
+****************************************************
+************* File-Static Variables ****************
+****************************************************
+*/
+static uint8_t fat32_mounted = 0;
+static uint8_t blocks_per_cluster = 0;
+static uint32_t fat_start_address = 0;   //First block of the first FAT
+static uint32_t data_start_address = 0;  //First block of cluster 2
+static uint32_t root_cluster = 0;
+static uint32_t last_cluster = 0;        //Highest cluster number the volume has
+
+//Byte of each UTF-16 character of a long name entry, in name order
+static const uint8_t long_name_offsets[FAT32_LONG_NAME_CHARACTERS] = {1, 3, 5, 7, 9, 14, 16, 18, 20, 22, 24, 28, 30};
+
+
+/*
+****************************************************
+********** Private Function Prototypes *************
+****************************************************
+*/
+uint8_t fat32_is_boot_sector(const uint8_t *tmp_block);
+uint32_t fat32_next_cluster(uint32_t tmp_cluster);
+uint32_t fat32_cluster_address(uint32_t tmp_cluster);
+void fat32_read_short_name(const uint8_t *tmp_entry, char *tmp_name);
+uint8_t fat32_short_name_checksum(const uint8_t *tmp_entry);
+uint16_t fat32_read_uint16(const uint8_t *tmp_bytes);
+uint32_t fat32_read_uint32(const uint8_t *tmp_bytes);
+
+
+/*
+****************************************************
+********** Public Function Definitions *************
+****************************************************
+*/
+
+/*!
+* @brief Find the FAT32 volume on the SD card and read its layout. The card may be partitioned,
+*        then the first FAT32 partition is used, or hold the volume from block 0
+* @param[in] NONE
+* @return 1 if a FAT32 volume was found, otherwise 0 and every other function fails
+*
+* @warning microsd_init() must have brought the card out of idle
+*/
+uint8_t
+fat32_mount(void)
+{
+   fat32_mounted = 0;
+
+   //MBR or boot sector
+   const uint8_t *p_block = sd_block_cache_get(0);
+   uint32_t volume_address = 0;
+
+   if(!fat32_is_boot_sector(p_block))
+   {
+      //Master boot record, look for a FAT32 partition
+      for(uint8_t current_partition = 0; current_partition < 4; current_partition++)
+      {
+         const uint8_t *p_partition = &p_block[FAT32_PARTITION_TABLE_LOCATION + (current_partition * FAT32_PARTITION_ENTRY_SIZE)];
+         uint8_t partition_type = p_partition[FAT32_PARTITION_TYPE_OFFSET];
+
+         if((FAT32_PARTITION_TYPE_CHS == partition_type) || (FAT32_PARTITION_TYPE_LBA == partition_type))
+         {
+            volume_address = fat32_read_uint32(&p_partition[FAT32_PARTITION_START_OFFSET]);
+            break;
+         }
+      }
+
+      if(0 == volume_address)
+      {
+         uart1_printf("No FAT32 partition on the SD card \n\r\0");
+         return(0);
+      }
+
+      p_block = sd_block_cache_get(volume_address);
+
+      if(!fat32_is_boot_sector(p_block))
+      {
+         uart1_printf("FAT32 partition has no boot sector \n\r\0");
+         return(0);
+      }
+   }
+
+   blocks_per_cluster = p_block[FAT32_SECTORS_PER_CLUSTER_LOCATION];
+   fat_start_address = volume_address + fat32_read_uint16(&p_block[FAT32_RESERVED_SECTORS_LOCATION]);
+   data_start_address = fat_start_address + (p_block[FAT32_NUMBER_OF_FATS_LOCATION] * fat32_read_uint32(&p_block[FAT32_FAT_SIZE_32_LOCATION]));
+   root_cluster = fat32_read_uint32(&p_block[FAT32_ROOT_CLUSTER_LOCATION]) & FAT32_CLUSTER_MASK;
+
+   uint32_t total_blocks = fat32_read_uint16(&p_block[FAT32_TOTAL_SECTORS_16_LOCATION]);
+
+   if(0 == total_blocks)
+   {
+      total_blocks = fat32_read_uint32(&p_block[FAT32_TOTAL_SECTORS_32_LOCATION]);
+   }
+
+   //Clusters that fit after the FATs. The count is what makes a volume FAT32, not the label
+   uint32_t cluster_count = (total_blocks - (data_start_address - volume_address)) / blocks_per_cluster;
+   last_cluster = cluster_count + 1;
+
+   if((FAT32_MIN_CLUSTERS > cluster_count) || (FAT32_FIRST_CLUSTER > root_cluster) || (last_cluster < root_cluster))
+   {
+      uart1_printf("SD card volume is not FAT32 \n\r\0");
+      return(0);
+   }
+
+   fat32_mounted = 1;
+   uart1_printf("FAT32 volume mounted \n\r\0");
+
+   return(1);
+}
+
+
+/*!
+* @brief Find a file or directory by its path
+* @param[in] tmp_path Directories separated by '/', starting from the root. A leading '/' is
+*                     optional and an empty path opens the root directory
+* @param[in] tmp_file Filled in and rewound if found
+* @return 1 if found, otherwise 0
+*
+* @note Each directory on the way is read from its start until the name turns up, so this
+*       costs a few block reads in a directory of a few hundred entries
+*/
+uint8_t
+fat32_open(const char *tmp_path, t_fat32_file *tmp_file)
+{
+   if(!fat32_mounted)
+   {
+      return(0);
+   }
+
+   //Start at the root directory
+   tmp_file->first_cluster = root_cluster;
+   tmp_file->size = 0;
+   tmp_file->is_directory = 1;
+
+   while('\0' != *tmp_path)
+   {
+      if('/' == *tmp_path)
+      {
+         tmp_path++;
+         continue;
+      }
+
+      if(!tmp_file->is_directory)
+      {
+         return(0);
+      }
+
+      //Length of the name up to the next '/'
+      uint16_t name_length = 0;
+
+      while(('\0' != tmp_path[name_length]) && ('/' != tmp_path[name_length]))
+      {
+         name_length++;
+      }
+
+      t_fat32_directory tmp_iterator;
+      uint8_t name_found = 0;
+      fat32_open_directory(tmp_file, &tmp_iterator);
+
+      while(fat32_read_directory(&tmp_iterator, tmp_file))
+      {
+         if(fat32_names_match(tmp_path, tmp_iterator.name, name_length))
+         {
+            name_found = 1;
+            break;
+         }
+      }
+
+      if(!name_found)
+      {
+         return(0);
+      }
+
+      tmp_path += name_length;
+   }
+
+   fat32_rewind(tmp_file);
+
+   return(1);
+}
+
+
+/*!
+* @brief Make fat32_next_extent() start from the beginning of the file again
+* @param[in] tmp_file
+* @return NONE
+*/
+void
+fat32_rewind(t_fat32_file *tmp_file)
+{
+   tmp_file->next_cluster = tmp_file->first_cluster;
+
+   //Directories have no size, their chain is followed to its end
+   if(tmp_file->is_directory)
+   {
+      tmp_file->blocks_left = 0xFFFFFFFF;
+   }
+
+   else
+   {
+      tmp_file->blocks_left = (tmp_file->size + 511) / 512;
+   }
+}
+
+
+/*!
+* @brief Get the next run of consecutive blocks of a file. Each run can be streamed with
+*        sd_read_multiple_block() from its first block and stopped after its last one
+* @param[in] tmp_file Opened by fat32_open() or fat32_read_directory()
+* @param[in] tmp_block_address Receives the first block of the run
+* @param[in] tmp_blocks Receives the number of blocks, the last one may only partly belong to the file
+* @return 1 if there was a run left, 0 at the end of the file
+*
+* @note A file that was written in one go on a freshly formatted card is a single run
+*/
+uint8_t
+fat32_next_extent(t_fat32_file *tmp_file, uint32_t *tmp_block_address, uint32_t *tmp_blocks)
+{
+   if((!fat32_mounted) || (FAT32_FIRST_CLUSTER > tmp_file->next_cluster) || (0 == tmp_file->blocks_left))
+   {
+      return(0);
+   }
+
+   uint32_t first_cluster = tmp_file->next_cluster;
+   uint32_t current_cluster = first_cluster;
+   uint32_t next_cluster = 0;
+   uint32_t run_blocks = blocks_per_cluster;
+
+   //Follow the chain while it stays in order and the file goes on
+   while(run_blocks < tmp_file->blocks_left)
+   {
+      next_cluster = fat32_next_cluster(current_cluster);
+
+      if((current_cluster + 1) != next_cluster)
+      {
+         break;
+      }
+
+      current_cluster = next_cluster;
+      next_cluster = 0;
+      run_blocks += blocks_per_cluster;
+   }
+
+   if(run_blocks > tmp_file->blocks_left)
+   {
+      run_blocks = tmp_file->blocks_left;
+   }
+
+   *tmp_block_address = fat32_cluster_address(first_cluster);
+   *tmp_blocks = run_blocks;
+
+   tmp_file->blocks_left -= run_blocks;
+   tmp_file->next_cluster = next_cluster;
+
+   return(1);
+}
+
+
+/*!
+* @brief Start reading the entries of a directory
+* @param[in] tmp_directory Opened by fat32_open() or fat32_read_directory()
+* @param[in] tmp_iterator
+* @return NONE
+*/
+void
+fat32_open_directory(const t_fat32_file *tmp_directory, t_fat32_directory *tmp_iterator)
+{
+   tmp_iterator->cluster = tmp_directory->first_cluster;
+   tmp_iterator->entry = 0;
+   tmp_iterator->has_long_name = 0;
+   tmp_iterator->name[0] = '\0';
+}
+
+
+/*!
+* @brief Read the next file or directory of a directory, skipping deleted entries and the
+*        volume label
+* @param[in] tmp_iterator Set up by fat32_open_directory(). Its name is set to the entry's name
+* @param[in] tmp_file Filled in and rewound
+* @return 1 if an entry was read, 0 at the end of the directory
+*/
+uint8_t
+fat32_read_directory(t_fat32_directory *tmp_iterator, t_fat32_file *tmp_file)
+{
+   uint16_t entries_per_cluster = blocks_per_cluster * FAT32_ENTRIES_PER_BLOCK_DIRECTORY;
+
+   while(fat32_mounted && (FAT32_FIRST_CLUSTER <= tmp_iterator->cluster))
+   {
+      if(entries_per_cluster <= tmp_iterator->entry)
+      {
+         tmp_iterator->cluster = fat32_next_cluster(tmp_iterator->cluster);
+         tmp_iterator->entry = 0;
+         continue;
+      }
+
+      uint32_t block_address = fat32_cluster_address(tmp_iterator->cluster) + (tmp_iterator->entry / FAT32_ENTRIES_PER_BLOCK_DIRECTORY);
+      const uint8_t *p_entry = sd_block_cache_get(block_address) +
+                               ((tmp_iterator->entry % FAT32_ENTRIES_PER_BLOCK_DIRECTORY) * FAT32_ENTRY_SIZE);
+      uint8_t attributes = p_entry[FAT32_ENTRY_ATTRIBUTE_OFFSET];
+
+      tmp_iterator->entry++;
+
+      if(FAT32_ENTRY_END == p_entry[0])
+      {
+         tmp_iterator->cluster = 0;
+         break;
+      }
+
+      if(FAT32_ENTRY_DELETED == p_entry[0])
+      {
+         tmp_iterator->has_long_name = 0;
+         continue;
+      }
+
+      //Long names are stored backwards, a part of 13 characters per entry, ahead of the 8.3 entry
+      if(FAT32_ATTRIBUTE_LONG_NAME == (attributes & FAT32_ATTRIBUTE_LONG_NAME))
+      {
+         uint8_t order = p_entry[0] & FAT32_LONG_NAME_ORDER_MASK;
+
+         if(p_entry[0] & FAT32_LONG_NAME_LAST)
+         {
+            uint16_t name_length = order * FAT32_LONG_NAME_CHARACTERS;
+
+            tmp_iterator->has_long_name = 1;
+            tmp_iterator->long_name_checksum = p_entry[FAT32_LONG_NAME_CHECKSUM_OFFSET];
+            tmp_iterator->name[(FAT32_MAX_NAME_LENGTH < name_length) ? FAT32_MAX_NAME_LENGTH : name_length] = '\0';
+         }
+
+         else if(tmp_iterator->long_name_checksum != p_entry[FAT32_LONG_NAME_CHECKSUM_OFFSET])
+         {
+            tmp_iterator->has_long_name = 0;
+         }
+
+         for(uint8_t current_char = 0; (current_char < FAT32_LONG_NAME_CHARACTERS) && (0 < order); current_char++)
+         {
+            uint16_t name_index = ((order - 1) * FAT32_LONG_NAME_CHARACTERS) + current_char;
+            uint16_t character = fat32_read_uint16(&p_entry[long_name_offsets[current_char]]);
+
+            if(FAT32_MAX_NAME_LENGTH <= name_index)
+            {
+               break;
+            }
+
+            //The name ends with 0 and is padded with 0xFFFF
+            if((0x0000 == character) || (0xFFFF == character))
+            {
+               tmp_iterator->name[name_index] = '\0';
+               break;
+            }
+
+            tmp_iterator->name[name_index] = (0x7F < character) ? '?' : (char)character;
+         }
+
+         continue;
+      }
+
+      if(attributes & FAT32_ATTRIBUTE_VOLUME_ID)
+      {
+         tmp_iterator->has_long_name = 0;
+         continue;
+      }
+
+      //A long name only belongs to the 8.3 entry right after it
+      if((!tmp_iterator->has_long_name) || (tmp_iterator->long_name_checksum != fat32_short_name_checksum(p_entry)))
+      {
+         fat32_read_short_name(p_entry, tmp_iterator->name);
+      }
+
+      tmp_iterator->has_long_name = 0;
+
+      tmp_file->first_cluster = ((((uint32_t)fat32_read_uint16(&p_entry[FAT32_ENTRY_CLUSTER_HIGH_OFFSET])) << 16) |
+                                 fat32_read_uint16(&p_entry[FAT32_ENTRY_CLUSTER_LOW_OFFSET])) & FAT32_CLUSTER_MASK;
+      tmp_file->size = fat32_read_uint32(&p_entry[FAT32_ENTRY_SIZE_OFFSET]);
+      tmp_file->is_directory = (attributes & FAT32_ATTRIBUTE_DIRECTORY) ? 1 : 0;
+
+      //".." of a directory in the root points to cluster 0
+      if(tmp_file->is_directory && (0 == tmp_file->first_cluster))
+      {
+         tmp_file->first_cluster = root_cluster;
+      }
+
+      fat32_rewind(tmp_file);
+
+      return(1);
+   }
+
+   return(0);
+}
+
+
+/*!
+* @brief Compare a name with a file name the way FAT does, without regard to case
+* @param[in] tmp_name_a Only the first tmp_length characters are compared, it needs no '\0'
+* @param[in] tmp_name_b Must end right after them
+* @param[in] tmp_length
+* @return 1 if they match, otherwise 0
+*/
+uint8_t
+fat32_names_match(const char *tmp_name_a, const char *tmp_name_b, uint16_t tmp_length)
+{
+   for(uint16_t current_char = 0; current_char < tmp_length; current_char++)
+   {
+      char char_a = tmp_name_a[current_char];
+      char char_b = tmp_name_b[current_char];
+
+      if(('a' <= char_a) && ('z' >= char_a))
+      {
+         char_a -= ('a' - 'A');
+      }
+
+      if(('a' <= char_b) && ('z' >= char_b))
+      {
+         char_b -= ('a' - 'A');
+      }
+
+      if((char_a != char_b) || ('\0' == char_b))
+      {
+         return(0);
+      }
+   }
+
+   return('\0' == tmp_name_b[tmp_length]);
+}
+
+
+
+
+/*
+****************************************************
+********** Private Function Definitions ************
+****************************************************
+*/
+
+/*!
+* @brief Check whether a block is a FAT32 boot sector rather than a master boot record
+* @param[in] tmp_block
+* @return 1 if it is
+*/
+uint8_t
+fat32_is_boot_sector(const uint8_t *tmp_block)
+{
+   //Boot sectors start with a jump over the parameter block, an MBR with code
+   return(((0xEB == tmp_block[0]) || (0xE9 == tmp_block[0])) &&
+          (0x55 == tmp_block[FAT32_SIGNATURE_LOCATION]) && (0xAA == tmp_block[FAT32_SIGNATURE_LOCATION + 1]) &&
+          (512 == fat32_read_uint16(&tmp_block[FAT32_BYTES_PER_SECTOR_LOCATION])) &&
+          (0 != tmp_block[FAT32_SECTORS_PER_CLUSTER_LOCATION]) &&
+          (0 == fat32_read_uint16(&tmp_block[FAT32_ROOT_ENTRIES_LOCATION])) &&
+          (0 == fat32_read_uint16(&tmp_block[FAT32_FAT_SIZE_16_LOCATION])));
+}
+
+
+/*!
+* @brief Look up the cluster after this one in the FAT
+* @param[in] tmp_cluster
+* @return The next cluster, or 0 at the end of the chain or if the entry makes no sense
+*/
+uint32_t
+fat32_next_cluster(uint32_t tmp_cluster)
+{
+   const uint8_t *p_fat = sd_block_cache_get(fat_start_address + (tmp_cluster / FAT32_ENTRIES_PER_BLOCK));
+   uint32_t next_cluster = fat32_read_uint32(&p_fat[(tmp_cluster % FAT32_ENTRIES_PER_BLOCK) * 4]) & FAT32_CLUSTER_MASK;
+
+   //Free, bad and end of chain entries all end the walk
+   if((FAT32_FIRST_CLUSTER > next_cluster) || (last_cluster < next_cluster))
+   {
+      return(0);
+   }
+
+   return(next_cluster);
+}
+
+
+/*!
+* @brief First block of a cluster
+* @param[in] tmp_cluster 2 or more
+* @return Block address
+*/
+uint32_t
+fat32_cluster_address(uint32_t tmp_cluster)
+{
+   return(data_start_address + ((tmp_cluster - FAT32_FIRST_CLUSTER) * blocks_per_cluster));
+}
+
+
+/*!
+* @brief Turn the padded 11 characters of an 8.3 entry into "NAME.EXT"
+* @param[in] tmp_entry
+* @param[in] tmp_name At least 13 bytes
+* @return NONE
+*/
+void
+fat32_read_short_name(const uint8_t *tmp_entry, char *tmp_name)
+{
+   uint8_t name_length = 0;
+
+   for(uint8_t current_char = 0; current_char < 8; current_char++)
+   {
+      if(' ' != tmp_entry[current_char])
+      {
+         name_length = current_char + 1;
+      }
+
+      tmp_name[current_char] = tmp_entry[current_char];
+   }
+
+   //0x05 stands in for a leading 0xE5, which marks deleted entries
+   if(0x05 == tmp_name[0])
+   {
+      tmp_name[0] = (char)0xE5;
+   }
+
+   if(' ' != tmp_entry[8])
+   {
+      tmp_name[name_length] = '.';
+      name_length++;
+
+      for(uint8_t current_char = 8; (current_char < 11) && (' ' != tmp_entry[current_char]); current_char++)
+      {
+         tmp_name[name_length] = tmp_entry[current_char];
+         name_length++;
+      }
+   }
+
+   tmp_name[name_length] = '\0';
+}
+
+
+/*!
+* @brief Checksum of the 11 characters of an 8.3 name, stored in each of its long name entries
+* @param[in] tmp_entry
+* @return Checksum
+*/
+uint8_t
+fat32_short_name_checksum(const uint8_t *tmp_entry)
+{
+   uint8_t checksum = 0;
+
+   for(uint8_t current_char = 0; current_char < 11; current_char++)
+   {
+      checksum = (uint8_t)(((checksum & 0x01) << 7) + (checksum >> 1) + tmp_entry[current_char]);
+   }
+
+   return(checksum);
+}
+
+
+uint16_t
+fat32_read_uint16(const uint8_t *tmp_bytes)
+{
+   return((uint16_t)(tmp_bytes[0] | (tmp_bytes[1] << 8)));
+}
+
+
+uint32_t
+fat32_read_uint32(const uint8_t *tmp_bytes)
+{
+   return(((uint32_t)tmp_bytes[0]) | (((uint32_t)tmp_bytes[1]) << 8) | (((uint32_t)tmp_bytes[2]) << 16) | (((uint32_t)tmp_bytes[3]) << 24));
+}
+
+
+/* end of file */
@@ -0,0 +1,202 @@
+/** @file font_metrics.c
+*
+* @brief  Ink boxes and advances of every glyph in font.c. Generated by Host/build/font_metrics,
+*         do not edit. See font.h for the license of the font the data is taken from.
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*/
+
+#include "font.h"
+
+//Advance, ink x initial, ink x final, ink y initial, ink y final
+const t_font_glyph_metrics jet_font_metrics[91] = {
+   {13,  0,  0,  0,  0}, //' '
+   {13,  0,  0,  0,  0}, //'!'
+   {13,  0,  0,  0,  0}, //'"'
+   {13,  0,  0,  0,  0}, //'#'
+   {13,  0,  0,  0,  0}, //'$'
+   {13,  0,  0,  0,  0}, //'%'
+   {13,  0,  0,  0,  0}, //'&'
+   { 7,  0,  0,  0,  0}, //'\''
+   {13,  0,  0,  0,  0}, //'('
+   {13,  0,  0,  0,  0}, //')'
+   {13,  0,  0,  0,  0}, //'*'
+   {13,  0,  5, 13, 16}, //'+'
+   {13,  0,  5, 13, 16}, //','
+   {13,  4, 10,  9, 11}, //'-'
+   {13,  0,  5, 13, 16}, //'.'
+   {13,  0,  5, 13, 16}, //'/'
+   {13,  0, 10,  0, 16}, //'0'
+   {13,  0, 10,  0, 16}, //'1'
+   {13,  1, 11,  0, 16}, //'2'
+   {13,  0, 10,  0, 16}, //'3'
+   {13,  0, 10,  0, 16}, //'4'
+   {13,  0, 10,  0, 16}, //'5'
+   {13,  0, 11,  0, 16}, //'6'
+   {13,  0, 11,  0, 16}, //'7'
+   {13,  0, 11,  0, 16}, //'8'
+   {13,  0, 11,  0, 16}, //'9'
+   {13,  5,  8,  5, 14}, //':'
+   {13,  0,  5, 13, 16}, //';'
+   {13,  0,  5, 13, 16}, //'<'
+   {13,  0,  5, 13, 16}, //'='
+   {13,  0,  5, 13, 16}, //'>'
+   {13,  0,  5, 13, 16}, //'?'
+   {13,  0,  5, 12, 16}, //'@'
+   {13,  0, 11,  0, 16}, //'A'
+   {13,  0, 10,  0, 16}, //'B'
+   {13,  0, 10,  0, 16}, //'C'
+   {13,  0, 10,  0, 16}, //'D'
+   {13,  0, 10,  0, 16}, //'E'
+   {13,  0, 10,  0, 16}, //'F'
+   {13,  0, 10,  0, 16}, //'G'
+   {13,  0, 10,  0, 16}, //'H'
+   {13,  1, 10,  0, 16}, //'I'
+   {13,  0, 10,  0, 16}, //'J'
+   {13,  0, 10,  0, 16}, //'K'
+   {13,  0, 10,  0, 16}, //'L'
+   {13,  1, 11,  0, 16}, //'M'
+   {13,  0, 10,  0, 16}, //'N'
+   {13,  0, 10,  0, 16}, //'O'
+   {13,  0, 11,  0, 16}, //'P'
+   {13,  0, 10,  0, 20}, //'Q'
+   {13,  0, 10,  0, 16}, //'R'
+   {13,  0, 11,  0, 16}, //'S'
+   {13,  0, 11,  0, 16}, //'T'
+   {13,  0, 10,  0, 16}, //'U'
+   {13,  1, 12,  0, 16}, //'V'
+   {13,  0, 13,  0, 16}, //'W'
+   {13,  0, 11,  0, 16}, //'X'
+   {13,  0, 12,  0, 16}, //'Y'
+   {13,  0, 10,  0, 16}, //'Z'
+   {13,  0,  5, 13, 16}, //'['
+   {13,  0,  5, 13, 16}, //'\\'
+   {13,  0,  5, 13, 16}, //']'
+   {13,  0,  5, 13, 16}, //'^'
+   {13,  0,  5, 13, 16}, //'_'
+   {13,  0,  5, 13, 16}, //'`'
+   {13,  0, 11,  4, 16}, //'a'
+   {13,  0, 10,  0, 16}, //'b'
+   {13,  1, 11,  4, 16}, //'c'
+   {13,  0,  9,  0, 16}, //'d'
+   {13,  0, 10,  4, 16}, //'e'
+   {13,  0, 11,  0, 16}, //'f'
+   {13,  1, 10,  4, 20}, //'g'
+   {13,  0,  9,  0, 16}, //'h'
+   {13,  0, 11,  0, 16}, //'i'
+   {13,  0,  9,  0, 20}, //'j'
+   {13,  0, 11,  0, 16}, //'k'
+   {13,  0, 12,  0, 16}, //'l'
+   {13,  0, 11,  4, 16}, //'m'
+   {13,  0, 10,  4, 16}, //'n'
+   {13,  1, 11,  4, 16}, //'o'
+   {13,  0, 10,  4, 20}, //'p'
+   {13,  0, 10,  4, 20}, //'q'
+   {13,  1, 11,  4, 16}, //'r'
+   {13,  1, 11,  4, 16}, //'s'
+   {13,  0, 11,  1, 16}, //'t'
+   {13,  0, 10,  4, 16}, //'u'
+   {13,  0, 11,  4, 16}, //'v'
+   {13,  0, 12,  4, 16}, //'w'
+   {13,  0, 11,  4, 16}, //'x'
+   {13,  0, 11,  4, 20}, //'y'
+   {13,  0, 10,  4, 16}, //'z'
+};
+
+//Advance, ink x initial, ink x final, ink y initial, ink y final
+const t_font_glyph_metrics jet_font_small_metrics[91] = {
+   {11,  0,  0,  0,  0}, //' '
+   {11,  0,  3,  0, 12}, //'!'
+   {11,  0,  8,  0,  5}, //'"'
+   {11,  0, 10,  0, 12}, //'#'
+   {11,  0,  8,  0, 16}, //'$'
+   {11,  0, 10,  0, 12}, //'%'
+   {11,  0, 10,  0, 12}, //'&'
+   { 5,  0,  4,  0,  5}, //'\''
+   {11,  0,  6,  0, 16}, //'('
+   {11,  0,  6,  0, 16}, //')'
+   {11,  1, 10,  1, 10}, //'*'
+   {11,  0,  9,  2, 10}, //'+'
+   {11,  0,  4, 11, 16}, //','
+   {11,  0,  8,  5,  6}, //'-'
+   { 5,  0,  3,  9, 12}, //'.'
+   {11,  0,  8,  0, 15}, //'/'
+   {11,  0,  8,  0, 12}, //'0'
+   {11,  0,  8,  0, 12}, //'1'
+   {11,  0,  8,  0, 12}, //'2'
+   {11,  0,  8,  0, 12}, //'3'
+   {11,  0,  7,  0, 12}, //'4'
+   {11,  0,  8,  0, 12}, //'5'
+   {11,  0,  9,  0, 12}, //'6'
+   {11,  0,  8,  0, 12}, //'7'
+   {11,  0,  9,  0, 12}, //'8'
+   {11,  0,  9,  0, 12}, //'9'
+   { 8,  1,  4,  3, 12}, //':'
+   {11,  0,  4,  4, 16}, //';'
+   {11,  0, 14,  3, 16}, //'<'
+   {11,  0,  8,  4,  9}, //'='
+   {11,  0,  8,  3, 12}, //'>'
+   {11,  0,  7,  0, 12}, //'?'
+   {11,  0,  9,  0, 15}, //'@'
+   {11,  0,  9,  0, 12}, //'A'
+   {11,  0,  8,  0, 12}, //'B'
+   {11,  0,  8,  0, 12}, //'C'
+   {11,  0,  8,  0, 12}, //'D'
+   {11,  0,  8,  0, 12}, //'E'
+   {11,  0,  8,  0, 12}, //'F'
+   {11,  0,  8,  0, 12}, //'G'
+   {11,  0,  8,  0, 12}, //'H'
+   {11,  1,  8,  0, 12}, //'I'
+   {11,  0,  8,  0, 12}, //'J'
+   {11,  0,  8,  0, 12}, //'K'
+   {11,  0,  8,  0, 12}, //'L'
+   {11,  0,  9,  0, 12}, //'M'
+   {11,  0,  8,  0, 12}, //'N'
+   {11,  1,  8,  0, 12}, //'O'
+   {11,  0,  9,  0, 12}, //'P'
+   {11,  0,  9,  0, 15}, //'Q'
+   {11,  0,  9,  0, 12}, //'R'
+   {11,  0,  8,  0, 12}, //'S'
+   {11,  0,  9,  0, 12}, //'T'
+   {11,  0,  8,  0, 12}, //'U'
+   {11,  0,  9,  0, 12}, //'V'
+   {11,  0, 10,  0, 12}, //'W'
+   {11,  0, 10,  0, 12}, //'X'
+   {11,  0,  9,  0, 12}, //'Y'
+   {11,  0,  9,  0, 12}, //'Z'
+   {11,  0,  5,  0, 15}, //'['
+   {11,  0,  8,  0, 15}, //'\\'
+   {11,  0,  5,  0, 15}, //']'
+   {11,  0,  7,  0,  7}, //'^'
+   {11,  0,  8,  5,  6}, //'_'
+   {11,  0,  4,  0,  5}, //'`'
+   {11,  0,  8,  3, 12}, //'a'
+   {11,  0,  8,  0, 12}, //'b'
+   {11,  1,  8,  3, 12}, //'c'
+   {11,  0,  8,  0, 12}, //'d'
+   {11,  0,  8,  3, 12}, //'e'
+   {11,  0,  9,  0, 12}, //'f'
+   {11,  0,  7,  4, 16}, //'g'
+   {11,  0,  8,  0, 12}, //'h'
+   {11,  0,  8,  0, 12}, //'i'
+   {11,  1,  8,  1, 16}, //'j'
+   {11,  0,  9,  0, 12}, //'k'
+   {11,  0,  9,  0, 12}, //'l'
+   {11,  0,  8,  3, 12}, //'m'
+   {11,  0,  8,  3, 12}, //'n'
+   {11,  0,  8,  3, 12}, //'o'
+   {11,  0,  8,  3, 15}, //'p'
+   {11,  0,  8,  2, 14}, //'q'
+   {11,  0,  8,  3, 12}, //'r'
+   {11,  0,  8,  3, 12}, //'s'
+   {11,  0,  9,  0, 12}, //'t'
+   {11,  0,  8,  3, 12}, //'u'
+   {11,  0,  9,  3, 12}, //'v'
+   {11,  1, 10,  3, 12}, //'w'
+   {11,  0,  9,  3, 12}, //'x'
+   {11,  0,  9,  4, 16}, //'y'
+   {11,  0,  8,  3, 12}, //'z'
+};
+
+/* end of file */
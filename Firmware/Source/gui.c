@@ -39,33 +39,77 @@
 */
 
 
-/*
-****************************************************
-************* File-Static Variables ****************
-****************************************************
-*/
-static uint16_t status_bar_background_color = BLACK;
-static uint16_t footer_background_color = NULL_COLOR;
-
-
 /*
 ****************************************************
 ********** Private Function Prototypes *************
 ****************************************************
 */
 uint16_t gui_get_status_bar_color(void);
-void gui_update_status_bar_battery(uint8_t background_color_change_flag);
+void gui_status_bar_init(void);
+uint32_t gui_get_status_bar_time_state(void);
+void gui_draw_status_bar_time(const t_gui_widget *tmp_widget, uint16_t background_color);
+uint32_t gui_get_status_bar_usb_state(void);
+void gui_draw_status_bar_usb(const t_gui_widget *tmp_widget, uint16_t background_color);
+uint32_t gui_get_status_bar_headphones_state(void);
+void gui_draw_status_bar_headphones(const t_gui_widget *tmp_widget, uint16_t background_color);
+uint32_t gui_get_status_bar_volume_state(void);
+void gui_draw_status_bar_volume(const t_gui_widget *tmp_widget, uint16_t background_color);
+uint32_t gui_get_status_bar_battery_icon_state(void);
+void gui_draw_status_bar_battery_icon(const t_gui_widget *tmp_widget, uint16_t background_color);
+uint32_t gui_get_status_bar_battery_text_state(void);
+void gui_draw_status_bar_battery_text(const t_gui_widget *tmp_widget, uint16_t background_color);
 void gui_get_battery_time_remaining(char *tmp_time_string);
-void gui_update_status_bar_volume(uint8_t background_color_change_flag);
-void gui_update_status_bar_time(uint8_t background_color_change_flag);
-void gui_update_status_bar_headphones(uint8_t background_color_change_flag);
-void gui_update_status_bar_usb(uint8_t background_color_change_flag);
 void gui_create_title_bar(char *menu_title);
 void gui_draw_audio_clock(uint16_t tmp_current_time, uint16_t tmp_total_time);
+void gui_draw_menu_skills_rows(uint8_t first_visible_row, uint8_t last_visible_row);
 void gui_rtc_to_string(char *tmp_time_string);
 void gui_settings_menu_update_volume(void);
 void gui_settings_menu_update_battery(void);
 void gui_time_to_string(char *tmp_time_string, uint8_t *tmp_time_buffer);
+uint32_t gui_loading_circle_step(t_gui_animation *tmp_animation);
+uint32_t gui_boot_animation_step(t_gui_animation *tmp_animation);
+
+
+/*
+****************************************************
+************* File-Static Variables ****************
+****************************************************
+*/
+static uint16_t status_bar_background_color = BLACK;
+static uint16_t footer_background_color = NULL_COLOR;
+
+//Status bar inputs, sampled when the RTC alarm triggers or the status bar changes color
+static uint8_t status_bar_battery_level = 0;
+static char status_bar_time_string[6] = {0};
+
+//Skills list shown by gui_create_menu_skills(), kept so it can be scrolled
+static const t_light_button *menu_skills_list = NULL;
+static size_t menu_skills_length = 0;
+static uint8_t menu_skills_first_row = 0; //List entry shown in the top row
+
+//Boot animation frames copied by gui_boot_animation() for its step function
+static uint32_t boot_frames[GUI_BOOT_MAX_FRAMES] = {0};
+static size_t boot_frame_count = 0;
+static t_lcd_animation boot_delta = {0};
+static uint8_t boot_is_delta = 0;
+
+//Widget areas are filled in by gui_status_bar_init() since they depend on bitmap and font sizes
+static t_gui_widget status_bar_widgets[6] =
+{
+   {{0}, gui_get_status_bar_time_state, gui_draw_status_bar_time, 0, 0},
+   {{0}, gui_get_status_bar_usb_state, gui_draw_status_bar_usb, 0, 0},
+   {{0}, gui_get_status_bar_headphones_state, gui_draw_status_bar_headphones, 0, 0},
+   {{0}, gui_get_status_bar_volume_state, gui_draw_status_bar_volume, 0, 0},
+   {{0}, gui_get_status_bar_battery_icon_state, gui_draw_status_bar_battery_icon, 0, 0},
+   {{0}, gui_get_status_bar_battery_text_state, gui_draw_status_bar_battery_text, 0, 0}
+};
+
+static t_gui_panel status_bar_panel =
+{
+   {0, 0, LCD_WIDTH, SB_OFFSET}, gui_get_status_bar_color, status_bar_widgets,
+   (sizeof(status_bar_widgets) / sizeof(*status_bar_widgets))
+};
+
 
 /*
 ****************************************************
@@ -110,33 +154,45 @@ gui_get_footer_color(void)
 
 
 /*!
-* @brief Redraw the status bar in order to match the current menu
+* @brief Queue a redraw of every status bar icon whose value changed, or of the whole status bar
+*        if it changed color. The drawing itself happens in gui_compositor_flush()
 * @param[in] NONE
 * @return  NONE
 */
 void
 gui_update_status_bar(void)
 {
+   static uint8_t first_entry_flag = 1;
    static uint16_t previous_background_color = NULL_COLOR;
    uint16_t current_background_color = gui_get_status_bar_color();
-   uint8_t background_color_change_flag = 0;
+
+   if(first_entry_flag)
+   {
+      gui_status_bar_init();
+      first_entry_flag = 0;
+   }
+
+   //Only sample the battery and RTC every 10 seconds when the alarm triggers, or when everything is redrawn anyway
+   if((RTC->ISR & RTC_ISR_ALRAF) || (previous_background_color != current_background_color))
+   {
+      status_bar_battery_level = monitor_get_battery_level(BATTERY_SAMPLE_FLAG_SAMPLE);
+      gui_rtc_to_string(status_bar_time_string);
+      rtc_update_alarm(); //Update alarm value to trigger at next 10 second overflow
+   }
 
    //If the status bar has changed color, it needs to be redrawn
    if(previous_background_color != current_background_color)
    {
-      lcd_draw_rectangle(current_background_color, 0, 0, 320, SB_OFFSET);
-      background_color_change_flag = 1;
+      gui_compositor_invalidate_panel(&status_bar_panel);
    }
 
-   previous_background_color = current_background_color;
-
-   //Update each icon
-   gui_update_status_bar_battery(background_color_change_flag);
-   gui_update_status_bar_volume(background_color_change_flag);
-   gui_update_status_bar_time(background_color_change_flag);
-   gui_update_status_bar_headphones(background_color_change_flag);
-   gui_update_status_bar_usb(background_color_change_flag);
+   //Otherwise only the icons whose values changed are redrawn. This helps with LCD flickering
+   else
+   {
+      gui_compositor_update_panel(&status_bar_panel);
+   }
 
+   previous_background_color = current_background_color;
 }
 
 
@@ -158,6 +214,9 @@ gui_update_status_bar(void)
 void
 gui_create_menu_type1(char *title, t_light_button *button_list, size_t list_length, uint8_t active_button)
 {
+   (void)active_button; //Pressed options are redrawn by gui_update_menu1_buttons()
+   lcd_display_list_begin();
+
    gui_set_footer_color(BLACK);
    gui_set_status_bar_color(GUI_HEADER_DARK);
 
@@ -214,6 +273,7 @@ gui_create_menu_type1(char *title, t_light_button *button_list, size_t list_leng
       lcd_send_bitmap(menu_arrow_bmp, offset_x, offset_y, THEME_TEXT, THEME_NEAR_WHITE);
    }
 
+   lcd_display_list_end();
 }
 
 
@@ -227,6 +287,8 @@ gui_create_menu_type1(char *title, t_light_button *button_list, size_t list_leng
 void
 gui_update_menu1_buttons( t_light_button *button_list, uint8_t menu1_substate, uint8_t tmp_current_substate)
 {
+   lcd_display_list_begin();
+
    uint8_t active_button = buttons_status(menu1_template,(sizeof(menu1_template) / sizeof(*menu1_template)));
 
    if((NO_BUTTON_PRESS != active_button) && (menu1_substate == tmp_current_substate))
@@ -278,6 +340,8 @@ gui_update_menu1_buttons( t_light_button *button_list, uint8_t menu1_substate, u
       offset_y =   MENU1_ARROWS_Y_OFFSET + (active_button*MENU1_BUTTON_SPACING) + SB_OFFSET;
       lcd_send_bitmap(menu_arrow_bmp, offset_x, offset_y, THEME_TEXT, THEME_LIGHT_GRAY);
    }
+
+   lcd_display_list_end();
 }
 
 
@@ -289,6 +353,8 @@ gui_update_menu1_buttons( t_light_button *button_list, uint8_t menu1_substate, u
 void
 gui_create_menu_type2(const t_person_profile tmp_profile)
 {
+   lcd_display_list_begin();
+
    gui_set_footer_color(BLACK);
    gui_set_status_bar_color(GUI_HEADER_DARK);
    gui_create_title_bar("Profile");
@@ -326,6 +392,8 @@ gui_create_menu_type2(const t_person_profile tmp_profile)
    lcd_send_bitmap(phone_icon_bmp, x_offset, y_offset, GREEN_PHONE, THEME_NEAR_WHITE);
    y_offset += MENU2_TEXT_SPACING;
    lcd_send_bitmap(mail_icon_bmp, x_offset, y_offset, RED_DARK, THEME_NEAR_WHITE);
+
+   lcd_display_list_end();
 }
 
 
@@ -337,6 +405,8 @@ gui_create_menu_type2(const t_person_profile tmp_profile)
 void
 gui_create_menu_type3(void)
 {
+   lcd_display_list_begin();
+
    gui_set_footer_color(GRAY_MENU3);
    gui_set_status_bar_color(GRAY_MENU3);
 
@@ -353,6 +423,8 @@ gui_create_menu_type3(void)
 
    //Set the initial audio play button visual to "play" aka a triangle inside of a circle
    lcd_send_bitmap(play_button_inner_symbol, MENU3_PLAY_BUTTON_ICON_X_OFFSET, MENU3_PLAY_BUTTON_ICON_Y_OFFSET, WHITE_PURE, THEME_MAIN);
+
+   lcd_display_list_end();
 }
 
 
@@ -365,6 +437,8 @@ gui_create_menu_type3(void)
 void
 gui_create_menu_languages(uint32_t main_menu_image_address)
 {
+   lcd_display_list_begin();
+
    gui_set_footer_color(BLACK);
    gui_set_status_bar_color(GUI_HEADER_DARK);
 
@@ -374,6 +448,8 @@ gui_create_menu_languages(uint32_t main_menu_image_address)
    lcd_print_string_small("Choose a country", 10, HEADER_OFFSET + 10, THEME_TEXT, 0xBE9F);
    lcd_print_string_small("for a sample of", 10, HEADER_OFFSET + 25, THEME_TEXT, 0xBE9F);
    lcd_print_string_small("my language skills", 10, HEADER_OFFSET + 40, THEME_TEXT, 0xBE9F);
+
+   lcd_display_list_end();
 }
 
 
@@ -387,10 +463,14 @@ gui_create_menu_languages(uint32_t main_menu_image_address)
 void
 gui_draw_play_button(void)
 {
+   lcd_display_list_begin();
+
    uint16_t x = menu3_template[menu3_play_pause].x_position;
    uint16_t y = menu3_template[menu3_play_pause].y_position;
    lcd_send_bitmap(menu3_template[menu3_play_pause].bmp, x, y, THEME_MAIN, BLACK);
    lcd_send_bitmap(play_button_inner_symbol, MENU3_PLAY_BUTTON_ICON_X_OFFSET, MENU3_PLAY_BUTTON_ICON_Y_OFFSET, WHITE_PURE, THEME_MAIN);
+
+   lcd_display_list_end();
 }
 
 
@@ -404,10 +484,14 @@ gui_draw_play_button(void)
 void
 gui_draw_pause_button(void)
 {
+   lcd_display_list_begin();
+
    uint16_t x = menu3_template[menu3_play_pause].x_position;
    uint16_t y = menu3_template[menu3_play_pause].y_position;
    lcd_send_bitmap(menu3_template[menu3_play_pause].bmp, x, y, THEME_MAIN, BLACK);
    lcd_send_bitmap(pause_button_inner_symbol, MENU3_PAUSE_BUTTON_ICON_X_OFFSET, MENU3_PLAY_BUTTON_ICON_Y_OFFSET, WHITE_PURE, THEME_MAIN);
+
+   lcd_display_list_end();
 }
 
 
@@ -419,6 +503,8 @@ gui_draw_pause_button(void)
 void
 gui_create_menu_contact_info(const t_light_button *tmp_button_list)
 {
+   lcd_display_list_begin();
+
    gui_set_footer_color(BLACK);
    gui_set_status_bar_color(GUI_HEADER_DARK);
 
@@ -470,53 +556,148 @@ gui_create_menu_contact_info(const t_light_button *tmp_button_list)
    x_offset += 10; //Offset subtext from main text
    y_offset += 16;
    lcd_print_string_small(tmp_button_list[3].minor_text, x_offset, y_offset, THEME_TEXT, THEME_NEAR_WHITE);
+
+   lcd_display_list_end();
 }
 
 
 /*!
 * @brief Display a menu of the author's skills with bitmaps and text
-* @param[in] tmp_button_list List of skills with bitmap attributes
+* @param[in] tmp_button_list List of skills with bitmap attributes. Must stay valid while the menu is shown
 * @param[in] length Variable to keep track of array length while passing by pointer
 * @return  NONE
+*
+* @note The list area between the title bar and the footer is set up as the LCD's hardware
+*       scroll area, see gui_scroll_menu_skills()
 */
 void
 gui_create_menu_skills(const t_light_button *tmp_button_list, size_t length)
 {
+   menu_skills_list = tmp_button_list;
+   menu_skills_length = length;
+   menu_skills_first_row = 0;
+
+   lcd_scroll_define(HEADER_OFFSET, (FOOTER_OFFSET - (HEADER_OFFSET)));
+
+   lcd_display_list_begin();
+
    gui_set_footer_color(BLACK);
    gui_set_status_bar_color(GUI_HEADER_DARK);
 
    //Menu title
    gui_create_title_bar("Skills");
 
+   gui_draw_menu_skills_rows(0, MENU_SKILLS_VISIBLE_ROWS);
+
+   lcd_display_list_end();
+}
+
+
+/*!
+* @brief Scroll the skills list by whole rows. The LCD moves the rows that stay on the screen,
+*        only the rows that come into view are drawn
+* @param[in] tmp_rows Positive shows later entries, negative earlier ones
+* @return  NONE
+*
+* @note Stops at either end of the list, a list that fits on the screen never moves
+*/
+void
+gui_scroll_menu_skills(int8_t tmp_rows)
+{
+   int16_t last_first_row = (int16_t)menu_skills_length - MENU_SKILLS_VISIBLE_ROWS;
+   int16_t new_first_row = menu_skills_first_row + tmp_rows;
+
+   if(new_first_row > last_first_row)
+   {
+      new_first_row = last_first_row;
+   }
+
+   if(0 > new_first_row)
+   {
+      new_first_row = 0;
+   }
+
+   int16_t moved_rows = new_first_row - menu_skills_first_row;
+
+   if(0 == moved_rows)
+   {
+      return;
+   }
+
+   menu_skills_first_row = new_first_row;
+
+   //Nothing on the screen is reused if the list moved by a full screen or more
+   if((MENU_SKILLS_VISIBLE_ROWS <= moved_rows) || (-MENU_SKILLS_VISIBLE_ROWS >= moved_rows))
+   {
+      gui_draw_menu_skills_rows(0, MENU_SKILLS_VISIBLE_ROWS);
+      return;
+   }
+
+   lcd_scroll_lines(moved_rows * MENU_SKILLS_TEXT_SPACING);
+
+   if(0 < moved_rows)
+   {
+      gui_draw_menu_skills_rows(MENU_SKILLS_VISIBLE_ROWS - moved_rows, MENU_SKILLS_VISIBLE_ROWS);
+   }
+
+   else
+   {
+      gui_draw_menu_skills_rows(0, -moved_rows);
+   }
+}
+
+
+/*!
+* @brief Draw some of the rows of the skills list, starting from menu_skills_first_row
+* @param[in] first_visible_row First row on the screen to draw, 0 is the row under the title bar
+* @param[in] last_visible_row Row on the screen to stop at, exclusive
+* @return  NONE
+*
+* @note Each row is MENU_SKILLS_TEXT_SPACING tall and everything in it stays inside it, so a
+*       row can be drawn without touching its neighbors
+*/
+void
+gui_draw_menu_skills_rows(uint8_t first_visible_row, uint8_t last_visible_row)
+{
+   //The rows are usually in the scrolled area, which only a display list can draw into
+   lcd_display_list_begin();
+
    //Text background
-   lcd_draw_rectangle(GRAY_DARK, 0, HEADER_OFFSET, 320, FOOTER_OFFSET);
+   lcd_draw_rectangle(GRAY_DARK, 0, HEADER_OFFSET + (first_visible_row * MENU_SKILLS_TEXT_SPACING),
+                      320, HEADER_OFFSET + (last_visible_row * MENU_SKILLS_TEXT_SPACING));
 
-   //Loop through the button list, creating the attributes of each
-   for(uint8_t current_button = 0; current_button < length; current_button++)
+   //Loop through the visible rows, creating the attributes of each button
+   for(uint8_t current_row = first_visible_row; current_row < last_visible_row; current_row++)
    {
+      size_t current_button = menu_skills_first_row + current_row;
 
+      if(current_button >= menu_skills_length)
+      {
+         break;
+      }
 
       //Print picture
-      uint32_t tmp_image = tmp_button_list[current_button].image[0];
+      uint32_t tmp_image = menu_skills_list[current_button].image[0];
       uint16_t x_offset = PROFILE_BAR_ICON_X_OFFSET;
-      uint16_t y_offset = 0;
+      uint16_t y_offset = MENU_SKILLS_PICTURE_Y_OFFSET + (current_row * MENU_SKILLS_TEXT_SPACING);
 
       if(null_address != tmp_image)
       {
-         y_offset = MENU_SKILLS_PICTURE_Y_OFFSET + (current_button*MENU_SKILLS_TEXT_SPACING);
          lcd_image_from_sd(x_offset, y_offset, x_offset + MENU_SKILLS_ICON_WIDTH, y_offset + MENU_SKILLS_ICON_HEIGHT, tmp_image);
          x_offset += (PROFILE_BAR_ICON_X_OFFSET + MENU_SKILLS_ICON_WIDTH); //Offset the text from the picture
       }
 
       //Print Text
-      char *tmp_text =  tmp_button_list[current_button].major_text;
+      char *tmp_text =  menu_skills_list[current_button].major_text;
       lcd_print_string_small(tmp_text, x_offset, y_offset, THEME_LIGHT_GRAY, GRAY_DARK);
 
       //Print the final portion of the LinkedIn website link that wouldn't fit on a single line
       x_offset += 10; //Offset subtext from main text
       y_offset += 16;
-      lcd_print_string_small(tmp_button_list[current_button].minor_text, x_offset, y_offset, GRAY_MEDIUM, GRAY_DARK);
+      lcd_print_string_small(menu_skills_list[current_button].minor_text, x_offset, y_offset, GRAY_MEDIUM, GRAY_DARK);
    }
+
+   lcd_display_list_end();
 }
 
 
@@ -540,7 +721,7 @@ gui_draw_audio_clock(uint16_t tmp_current_time, uint16_t tmp_total_time)
    timers_uint16_to_time(tmp_total_time, total_time_buffer);
 
    //Combine the two so that they are in the form    0:00 / 0:00
-   char combined_time_buffer[12] = {"     /      "};
+   char combined_time_buffer[12] = {"     /     "};
    combined_time_buffer[0] = current_time_buffer[0];
    combined_time_buffer[1] = current_time_buffer[1];
    combined_time_buffer[2] = current_time_buffer[2];
@@ -570,6 +751,8 @@ gui_draw_audio_clock(uint16_t tmp_current_time, uint16_t tmp_total_time)
 void
 gui_update_menu3_clock(uint32_t tmp_total_blocks, uint8_t first_entry_flag)
 {
+   lcd_display_list_begin();
+
    static uint16_t tmp_previous_clock = 1; //This cannot be '0', or it will not refresh upon entering a new slide
    uint16_t tmp_current_clock = timers_get_audio_clock();
 
@@ -605,6 +788,8 @@ gui_update_menu3_clock(uint32_t tmp_total_blocks, uint8_t first_entry_flag)
    }
 
    tmp_previous_clock = tmp_current_clock;
+
+   lcd_display_list_end();
 }
 
 
@@ -622,6 +807,8 @@ gui_update_menu3_clock(uint32_t tmp_total_blocks, uint8_t first_entry_flag)
 void
 gui_create_warning_menu( t_button *tmp_buttons, char **strings)
 {
+   lcd_display_list_begin();
+
    //Background. This starts at x = 10 and ends at x = 310 aka 10 pixels offset from the edges
    lcd_draw_rectangle(GRAY_MEDIUM_DARK, 10, MENU_WARNING_BACKGROUND_OFFSET, 310, MENU_WARNING_BACKGROUND_HEIGHT);
 
@@ -641,6 +828,8 @@ gui_create_warning_menu( t_button *tmp_buttons, char **strings)
    lcd_print_string_small(strings[4], 20, y_offset, THEME_LIGHT_GRAY, GRAY_MEDIUM_DARK);
 
    buttons_create(tmp_buttons, strings, 2); //There are ever only 2 buttons in this menu
+
+   lcd_display_list_end();
 }
 
 
@@ -653,6 +842,8 @@ gui_create_warning_menu( t_button *tmp_buttons, char **strings)
 void
 gui_create_settings_menu(void)
 {
+   lcd_display_list_begin();
+
    //Background. This starts at x = 10 and ends at x = 310 aka 10 pixels offset from the edges
    lcd_draw_rectangle(GRAY_MEDIUM_DARK, 10, MENU_WARNING_BACKGROUND_OFFSET, 310, MENU_WARNING_BACKGROUND_HEIGHT);
 
@@ -685,6 +876,7 @@ gui_create_settings_menu(void)
    lcd_print_string_small("Time", x_offset, y_offset, WHITE_PURE, GRAY_MEDIUM_DARK);
    lcd_print_string_small("Set          >", MENU_SETTINGS_BUTTON_X_OFFSET, y_offset + 2, GRAY_MEDIUM, GRAY_MEDIUM_DARK);
 
+   lcd_display_list_end();
 }
 
 
@@ -712,6 +904,8 @@ gui_update_settings_menu(void)
 void
 gui_create_settings_time_menu(void)
 {
+   lcd_display_list_begin();
+
    //Background. This starts at x = 10 and ends at x = 310 aka 10 pixels offset from the edges
    lcd_draw_rectangle(GRAY_MEDIUM_DARK, 10, MENU_WARNING_BACKGROUND_OFFSET, 310, MENU_WARNING_BACKGROUND_HEIGHT);
 
@@ -755,6 +949,8 @@ gui_create_settings_time_menu(void)
 
    uint8_t tmp_initial_time[4] = {1, 2, 0, 0};
    gui_update_settings_time_menu(tmp_initial_time, 0); //Initialize the time displayed
+
+   lcd_display_list_end();
 }
 
 
@@ -770,6 +966,8 @@ gui_create_settings_time_menu(void)
 void
 gui_update_settings_time_menu(uint8_t *time_buffer, uint8_t current_place)
 {
+   lcd_display_list_begin();
+
    uint8_t designator_xoffset[3] = {64, 97,108}; //Location of each time character in order to underline current_place
 
    lcd_draw_rectangle(GRAY_MEDIUM_DARK, 50, 230, 170, 232);
@@ -779,6 +977,8 @@ gui_update_settings_time_menu(uint8_t *time_buffer, uint8_t current_place)
    char tmp_string[6] = {0};
    gui_time_to_string(tmp_string, time_buffer);
    lcd_print_string(tmp_string, MENU_SETTINGS_TIME_X_OFFSET, MENU_SETTINGS_TIME_Y_OFFSET, GRAY_EXTRA_LIGHT, GRAY_MEDIUM_DARK);
+
+   lcd_display_list_end();
 }
 
 
@@ -791,6 +991,8 @@ gui_update_settings_time_menu(uint8_t *time_buffer, uint8_t current_place)
 void
 gui_create_aboutme_main_menu(uint32_t *tmp_button_images)
 {
+   lcd_display_list_begin();
+
    //Black background of the menu
    lcd_draw_rectangle(BLACK, 0, SB_OFFSET, 320, FOOTER_OFFSET);
 
@@ -800,17 +1002,25 @@ gui_create_aboutme_main_menu(uint32_t *tmp_button_images)
 
    //Add the corresponding images and text to each button. The "magic numbers" here are specific
    //locations which were tuned by trial and error.
-   lcd_image_from_sd(40, SB_OFFSET + 46, 112, SB_OFFSET + 96, tmp_button_images[0]);    //72  x 50
-   lcd_image_from_sd(220, SB_OFFSET + 46, 260, SB_OFFSET + 152, tmp_button_images[1]);  //40  x 106
-   lcd_image_from_sd(30, SB_OFFSET + 170, 134, SB_OFFSET + 290, tmp_button_images[2]);  //104 x 120
-   lcd_image_from_sd(215, SB_OFFSET + 210, 295, SB_OFFSET + 286, tmp_button_images[3]); //80  x 76
-   lcd_image_from_sd(25, SB_OFFSET + 340, 305, SB_OFFSET + 404, tmp_button_images[4]);  //280 x 64
+   t_lcd_image_blit button_images[5] =
+   {
+      {40, SB_OFFSET + 46, 112, SB_OFFSET + 96, tmp_button_images[0]},    //72  x 50
+      {220, SB_OFFSET + 46, 260, SB_OFFSET + 152, tmp_button_images[1]},  //40  x 106
+      {30, SB_OFFSET + 170, 134, SB_OFFSET + 290, tmp_button_images[2]},  //104 x 120
+      {215, SB_OFFSET + 210, 295, SB_OFFSET + 286, tmp_button_images[3]}, //80  x 76
+      {25, SB_OFFSET + 340, 305, SB_OFFSET + 404, tmp_button_images[4]}   //280 x 64
+   };
+
+   //They follow each other on the card, so they can share one read
+   lcd_images_from_sd(button_images, 5);
 
    lcd_print_string("Education", 25, SB_OFFSET + 17, WHITE_PURE, GRAY_DARK_ALT);
    lcd_print_string("Goals", 210, SB_OFFSET + 17, WHITE_PURE, GRAY_DARK_ALT);
    lcd_print_string("Hobbies", 35, SB_OFFSET + 140, WHITE_PURE, GRAY_DARK_ALT);
    lcd_print_string("Interests", 180, SB_OFFSET + 185, WHITE_PURE, GRAY_DARK_ALT);
    lcd_print_string("Experience", 25, SB_OFFSET + 325, WHITE_PURE, GRAY_DARK_ALT);
+
+   lcd_display_list_end();
 }
 
 
@@ -823,6 +1033,8 @@ gui_create_aboutme_main_menu(uint32_t *tmp_button_images)
 void
 gui_create_aboutme_education_menu(void)
 {
+   lcd_display_list_begin();
+
    //Black background of the menu
    lcd_draw_rectangle(BLACK, 0, MENU_ABOUTME_SUBMENU_TEXT_Y_OFFSET, 320, FOOTER_OFFSET);
    lcd_draw_rectangle(PINK, 0, MENU_ABOUTME_SUBMENU_TEXT_Y_OFFSET, 5, FOOTER_OFFSET);
@@ -853,6 +1065,7 @@ gui_create_aboutme_education_menu(void)
    y_offset += 25;
    lcd_print_string_small("University 3", x_offset, y_offset, GRAY_LIGHT, BLACK);
 
+   lcd_display_list_end();
 }
 
 
@@ -865,6 +1078,8 @@ gui_create_aboutme_education_menu(void)
 void
 gui_create_aboutme_goals_menu(void)
 {
+   lcd_display_list_begin();
+
    //Black background of the menu
    lcd_draw_rectangle(BLACK, 0, MENU_ABOUTME_SUBMENU_TEXT_Y_OFFSET, 320, FOOTER_OFFSET);
    lcd_draw_rectangle(PINK, 0, MENU_ABOUTME_SUBMENU_TEXT_Y_OFFSET, 5, FOOTER_OFFSET);
@@ -902,6 +1117,8 @@ gui_create_aboutme_goals_menu(void)
    lcd_print_string_small("leave my tiny piece just a", x_offset, y_offset, WHITE_PURE, BLACK);
    y_offset += line_spacing;
    lcd_print_string_small("little bit better", x_offset, y_offset, WHITE_PURE, BLACK);
+
+   lcd_display_list_end();
 }
 
 
@@ -914,6 +1131,8 @@ gui_create_aboutme_goals_menu(void)
 void
 gui_create_aboutme_hobbies_menu(void)
 {
+   lcd_display_list_begin();
+
    //Black background of the menu
    lcd_draw_rectangle(BLACK, 0, MENU_ABOUTME_SUBMENU_TEXT_Y_OFFSET, 320, FOOTER_OFFSET);
    lcd_draw_rectangle(PINK, 0, MENU_ABOUTME_SUBMENU_TEXT_Y_OFFSET, 5, FOOTER_OFFSET);
@@ -950,6 +1169,8 @@ gui_create_aboutme_hobbies_menu(void)
    lcd_print_string_small("related and hold a CA", x_offset, y_offset, WHITE_PURE, BLACK);
    y_offset += line_spacing;
    lcd_print_string_small("sailing certificate.", x_offset, y_offset, WHITE_PURE, BLACK);
+
+   lcd_display_list_end();
 }
 
 
@@ -962,6 +1183,8 @@ gui_create_aboutme_hobbies_menu(void)
 void
 gui_create_aboutme_interests_menu(void)
 {
+   lcd_display_list_begin();
+
    //Black background of the menu
    lcd_draw_rectangle(BLACK, 0, MENU_ABOUTME_SUBMENU_TEXT_Y_OFFSET, 320, FOOTER_OFFSET);
    lcd_draw_rectangle(PINK, 0, MENU_ABOUTME_SUBMENU_TEXT_Y_OFFSET, 5, FOOTER_OFFSET);
@@ -998,6 +1221,7 @@ gui_create_aboutme_interests_menu(void)
    y_offset += line_spacing;
    lcd_print_string_small("-Consumer    -Space", x_offset, y_offset, GRAY_LIGHT, BLACK);
 
+   lcd_display_list_end();
 }
 
 
@@ -1010,6 +1234,8 @@ gui_create_aboutme_interests_menu(void)
 void
 gui_create_aboutme_experience_menu(void)
 {
+   lcd_display_list_begin();
+
    //Black background of the menu
    lcd_draw_rectangle(BLACK, 0, MENU_ABOUTME_SUBMENU_TEXT_Y_OFFSET, 320, FOOTER_OFFSET);
    lcd_draw_rectangle(PINK, 0, MENU_ABOUTME_SUBMENU_TEXT_Y_OFFSET, 5, FOOTER_OFFSET);
@@ -1040,119 +1266,57 @@ gui_create_aboutme_experience_menu(void)
    y_offset += 20;
    lcd_print_string_small("Company 3 Details", x_offset, y_offset, GRAY_MEDIUM, BLACK);
 
+   lcd_display_list_end();
 }
 
 
 /*!
-* @brief Displays a waiting "spinning circle" animation while the device is shutting down
+* @brief Starts a "spinning circle" animation, e.g. while the device is shutting down
+* @param[in] tmp_animation Left running for GUI_LOADING_CIRCLE_FRAMES frames
 * @param[in] x The X midpoint of the circle
 * @param[in] y The Y midpoint of the circle
 * @return NONE
 *
-* @warning This function locks the processor with delay functions. It should never be used in multithreaded applications.
-* @note This is not the fastest implementation, but by definition (it's a loading screen animation)
-*       latency is usually not a problem
+* @note The frames are drawn by gui_animation_update() from the main loop
 */
 void
-gui_loading_circle_animation(uint16_t x, uint16_t y)
+gui_loading_circle_animation(t_gui_animation *tmp_animation, uint16_t x, uint16_t y)
 {
-   uint8_t radius = 30;
-   uint8_t d_radius = (((sqrt(2)) / 2) * radius); //Each leg of a 45-45-90 triangle is sqrt(2) / 2
-
-   //Lookup tables for each small circle position
-   const uint16_t x_pos[8] = {(x - d_radius), (x - radius ), (x - d_radius), x,
-                              (x + d_radius), x + radius, (x + d_radius), x};
-
-   const uint16_t y_pos[8] = {(y - d_radius), y, (y + d_radius), (y + radius),
-                              (y + d_radius), y, (y - d_radius), (y - radius)};
-
-   //Color table for each mini circle in the spectrum of white to black
-   const uint16_t color_buffer[8] = {WHITE_PURE, GRAY_EXTRA_LIGHT, GRAY_LIGHT, GRAY_LIGHT, GRAY_MEDIUM, GRAY_MEDIUM_DARK, GRAY_DARK_ALT, BLACK};
-   uint8_t color_number = 0;
-
-
-   //Each cycle represents redrawing all 8 mini circles with their updated colors
-   for(uint8_t cycle = 0; cycle < 28; cycle++)
-   {
-      //Draw all 8 mini circles
-      for(uint8_t mini_circle = 0; mini_circle < 8; mini_circle++)
-      {
-
-         lcd_send_bitmap(sliding_bar_marker_bmp, x_pos[mini_circle], y_pos[mini_circle], color_buffer[color_number], BLACK);
-
-         //Update color index
-         if(7 > color_number)
-         {
-            color_number++;
-         }
-
-         else
-         {
-            color_number = 0;
-         }
-
-      }
-
-      //Increment color index so that the animation appears to be spinning
-      if(7 > color_number)
-      {
-         color_number++;
-      }
-
-      else
-      {
-         color_number = 0;
-      }
-
-      //Display each cycle for roughly 500mS
-      timers_delay(500);
-   }
-
+   tmp_animation->x = x;
+   tmp_animation->y = y;
+   gui_animation_start(tmp_animation, gui_loading_circle_step, "loading circle", 1);
 }
 
 
 /*!
-* @brief Displays the boot animation while the system starts up
-* @param[in] animation_frames List of addresses in the SD card that hold the animation bitmaps
+* @brief Starts the boot animation while the system starts up
+* @param[in] tmp_animation Left running until the title and author have been shown
+* @param[in] animation_frames List of addresses in the SD card that hold the animation bitmaps, the title last
 * @param[in] number_of_frames
+* @param[in] delta_address Address of the same frames as a delta animation, 0 if the card has none
 * @return NONE
 *
+* @note Consecutive frames only differ around the spinner, so the delta animation sends a
+*       small part of each frame after the first. Cards without it get the whole bitmaps
 */
 void
-gui_boot_animation(uint32_t *animation_frames, size_t number_of_frames)
+gui_boot_animation(t_gui_animation *tmp_animation, const uint32_t *animation_frames, size_t number_of_frames, uint32_t delta_address)
 {
-   //Clear screen to start animation on a blank background
-   lcd_draw_rectangle(BLACK, 0, 0, 320, 480);
-   lcd_invert_screen_on();
-   lcd_backlight_enable();
-   timers_delay(4000);
-
-   uint16_t x_offset = 92, y_offset = 150;
-
-   for(uint8_t rotations = 0; rotations < 3; rotations++)
+   if(GUI_BOOT_MAX_FRAMES < number_of_frames)
    {
-      for(uint8_t current_frame = 0; current_frame < (number_of_frames - 1); current_frame++)
-      {
-         //Loop through all frames except for the last, which is the "EMBEDDED RESUME" title
-         lcd_image_from_sd(x_offset, y_offset, x_offset + 136, y_offset + 200, animation_frames[current_frame]);
-         timers_delay(300);
-      }
+      number_of_frames = GUI_BOOT_MAX_FRAMES;
    }
 
-   timers_delay(4000);
-   lcd_invert_screen_off(); //Bring screen back to "normal" display mode
-   timers_delay(7000);
+   memcpy(boot_frames, animation_frames, number_of_frames * sizeof(*animation_frames));
+   boot_frame_count = number_of_frames;
 
-   x_offset = 27;
-   y_offset = 65;
-   lcd_image_from_sd(x_offset, y_offset, x_offset + 268, y_offset + 40, animation_frames[12]); //Display "EMBEDDED RESUME" title
-   timers_delay(7000);
+   tmp_animation->x = 92;
+   tmp_animation->y = 150;
 
-   x_offset += 44;
-   y_offset += 35;
-   lcd_print_string("by Aaron Vorse", x_offset, y_offset, GRAY_LIGHT, BLACK);
-   timers_delay(7000);
+   //The delta animation must hold the same frames, i.e. all but the title
+   boot_is_delta = ((number_of_frames - 1) == lcd_animation_open(&boot_delta, tmp_animation->x, tmp_animation->y, delta_address));
 
+   gui_animation_start(tmp_animation, gui_boot_animation_step, "boot animation", 1);
 }
 
 
@@ -1166,6 +1330,8 @@ gui_boot_animation(uint32_t *animation_frames, size_t number_of_frames)
 void
 gui_create_intro_menu(uint8_t tmp_startup_status_flag)
 {
+   lcd_display_list_begin();
+
    //Background. This starts at x = 10 and ends at x = 310 aka 10 pixels offset from the edges
    lcd_draw_rectangle(GRAY_MEDIUM_DARK, 10, MENU_WARNING_BACKGROUND_OFFSET, 310, MENU_WARNING_BACKGROUND_HEIGHT);
 
@@ -1203,6 +1369,8 @@ gui_create_intro_menu(uint8_t tmp_startup_status_flag)
    lcd_print_string_small("Do not show this", x_offset, y_offset, THEME_LIGHT_GRAY, GRAY_MEDIUM_DARK);
    y_offset += 20;
    lcd_print_string_small("message on startup", x_offset, y_offset, THEME_LIGHT_GRAY, GRAY_MEDIUM_DARK);
+
+   lcd_display_list_end();
 }
 
 
@@ -1214,12 +1382,16 @@ gui_create_intro_menu(uint8_t tmp_startup_status_flag)
 void
 gui_tests_create_main_menu(void)
 {
+   lcd_display_list_begin();
+
    //Create the production test main title header and body
    lcd_draw_rectangle(GRAY_MEDIUM_DARK, 0, 0, 320, GUI_TESTS_HEADER_HEIGHT);
    lcd_draw_rectangle(BLACK, 0, GUI_TESTS_HEADER_HEIGHT, 320, 480);
 
    uint16_t x_offset = 10, y_offset = 30;
    lcd_print_string("PRODUCTION TESTING", x_offset, y_offset, WHITE_PURE, GRAY_MEDIUM_DARK);
+
+   lcd_display_list_end();
 }
 
 
@@ -1247,6 +1419,8 @@ gui_tests_display_pass_screen(void)
 void
 gui_tests_create_usb_menu(void)
 {
+   lcd_display_list_begin();
+
    //Display test title
    uint16_t x_offset = 10, y_offset = GUI_TESTS_TITLE_Y_OFFSET;
    lcd_print_string("USB Test", x_offset, y_offset, GRAY_MEDIUM, BLACK);
@@ -1254,6 +1428,7 @@ gui_tests_create_usb_menu(void)
    y_offset += 60;
    lcd_print_string_small("Please plug in USB", x_offset, y_offset, GRAY_LIGHT, BLACK);
 
+   lcd_display_list_end();
 }
 
 /*!
@@ -1264,6 +1439,7 @@ gui_tests_create_usb_menu(void)
 void
 gui_tests_create_battery_menu(uint8_t voltage_test_number)
 {
+   lcd_display_list_begin();
 
    //Create the menu backdrop
    gui_tests_create_main_menu();
@@ -1277,7 +1453,7 @@ gui_tests_create_battery_menu(uint8_t voltage_test_number)
 
    char test_voltage[5][6] =
    {
-      {" OFF \0"}, {" 2.1V\0"}, {" 2.4V\0"}, {" 2.6V\0"}, {" 3.1V\0"}
+      {" OFF "}, {" 2.1V"}, {" 2.4V"}, {" 2.6V"}, {" 3.1V"}
    };
 
    //Display the current voltage being tested and send it to the command terminal
@@ -1285,6 +1461,7 @@ gui_tests_create_battery_menu(uint8_t voltage_test_number)
    lcd_print_string(test_voltage[voltage_test_number], x_offset, y_offset, GRAY_LIGHT, BLACK);
    uart1_printf(test_voltage[voltage_test_number]);
 
+   lcd_display_list_end();
 }
 
 
@@ -1296,6 +1473,7 @@ gui_tests_create_battery_menu(uint8_t voltage_test_number)
 void
 gui_tests_create_touch_menu(uint8_t touch_test_number)
 {
+   lcd_display_list_begin();
 
    //Create the menu backdrop
    gui_tests_create_main_menu();
@@ -1329,6 +1507,8 @@ gui_tests_create_touch_menu(uint8_t touch_test_number)
    //Draw all targets (although only the currently active one will be a visible red)
    char *filler_text[5] = { "x\0", "x\0", "x\0", "x\0", "x\0"};
    buttons_create(touch_targets_template, filler_text, total_targets);
+
+   lcd_display_list_end();
 }
 
 
@@ -1340,6 +1520,8 @@ gui_tests_create_touch_menu(uint8_t touch_test_number)
 void
 gui_tests_create_power_button_menu(void)
 {
+   lcd_display_list_begin();
+
    //Create the menu backdrop
    gui_tests_create_main_menu();
 
@@ -1351,6 +1533,7 @@ gui_tests_create_power_button_menu(void)
    y_offset += 20;
    lcd_print_string_small("power button\0", x_offset, y_offset, GRAY_LIGHT, BLACK);
 
+   lcd_display_list_end();
 }
 
 /*!
@@ -1361,6 +1544,7 @@ gui_tests_create_power_button_menu(void)
 void
 gui_tests_create_LCD_switch_menu(uint8_t seconds_remaining)
 {
+   lcd_display_list_begin();
 
    //Create the menu backdrop
    gui_tests_create_main_menu();
@@ -1374,7 +1558,7 @@ gui_tests_create_LCD_switch_menu(uint8_t seconds_remaining)
 
    char time[5][2] =
    {
-      {"0\0"}, {"1\0"}, {"2\0"}, {"3\0"}, {"4\0"}
+      {"0"}, {"1"}, {"2"}, {"3"}, {"4"}
    };
 
 
@@ -1382,6 +1566,7 @@ gui_tests_create_LCD_switch_menu(uint8_t seconds_remaining)
    y_offset += 30;
    lcd_print_string(time[seconds_remaining], x_offset, y_offset, GRAY_LIGHT, BLACK);
 
+   lcd_display_list_end();
 }
 
 
@@ -1393,11 +1578,13 @@ gui_tests_create_LCD_switch_menu(uint8_t seconds_remaining)
 void
 gui_tests_create_audio_menu(uint8_t test_number)
 {
+   lcd_display_list_begin();
+
    //Create the menu backdrop
    gui_tests_create_main_menu();
 
    char main_text[2][20] = {"Plug in headphones\0", "Audio is playing\0"};
-   char sub_text[2][22] = {"                   \0", "Listen for test audio\0"};
+   char sub_text[2][22] = {"                   \0", "Listen for test audio"};
 
    //Display title
    uint16_t x_offset = 30, y_offset = GUI_TESTS_TITLE_Y_OFFSET;
@@ -1409,6 +1596,7 @@ gui_tests_create_audio_menu(uint8_t test_number)
    y_offset += 20;
    lcd_print_string_small(sub_text[test_number], x_offset, y_offset, GRAY_LIGHT, BLACK);
 
+   lcd_display_list_end();
 }
 
 
@@ -1432,186 +1620,274 @@ gui_get_status_bar_color(void)
 
 
 /*!
-* @brief Update the battery icon in the status bar
-* @param[in] background_color_change_flag indicates if the status bar has changed colors
+* @brief Compute the area of each status bar widget and register the status bar with the compositor
+* @param[in] NONE
 * @return  NONE
+*
+* @note Text areas are sized for the widest string each widget prints, all digits in the small
+*       font have the same advance
 */
 void
-gui_update_status_bar_battery(uint8_t background_color_change_flag)
+gui_status_bar_init(void)
 {
-   //Only redraw the battery once every 10 seconds when the RTC alarm triggers. This helps with LCD flickering
-   if((RTC->ISR & RTC_ISR_ALRAF) || background_color_change_flag)
-   {
-      uint8_t tmp_current_level = monitor_get_battery_level(BATTERY_SAMPLE_FLAG_SAMPLE);
+   uint16_t bitmap_dimensions[2] = {0};
+   t_gui_rect *p_area = NULL;
+
+   p_area = &status_bar_widgets[0].area; //Time
+   p_area->x_initial = SB_TIME_X_OFFSET;
+   p_area->y_initial = SB_TIME_Y_OFFSET;
+   p_area->x_final = SB_TIME_X_OFFSET + lcd_get_string_width_small("00:00");
+   p_area->y_final = SB_TIME_Y_OFFSET + LCD_FONT_SMALL_HEIGHT;
+
+   p_area = &status_bar_widgets[1].area; //USB, cleared over the full status bar height
+   p_area->x_initial = SB_USB_X_OFFSET;
+   p_area->y_initial = 0;
+   p_area->x_final = SB_USB_X_OFFSET + 24;
+   p_area->y_final = SB_OFFSET;
+
+   p_area = &status_bar_widgets[2].area; //Headphones, cleared over the full status bar height
+   p_area->x_initial = SB_HEADPHONES_X_OFFSET;
+   p_area->y_initial = 0;
+   p_area->x_final = SB_HEADPHONES_X_OFFSET + 20;
+   p_area->y_final = SB_OFFSET;
+
+   lcd_parse_local_bitmap(speaker_muted, bitmap_dimensions); //Every speaker bitmap is the same size
+   p_area = &status_bar_widgets[3].area;
+   p_area->x_initial = SB_SPEAKER_X_OFFSET;
+   p_area->y_initial = SB_SPEAKER_Y_OFFSET;
+   p_area->x_final = SB_SPEAKER_X_OFFSET + bitmap_dimensions[0];
+   p_area->y_final = SB_SPEAKER_Y_OFFSET + bitmap_dimensions[1];
+
+   lcd_parse_local_bitmap(battery_icon_bmp, bitmap_dimensions);
+   p_area = &status_bar_widgets[4].area;
+   p_area->x_initial = SB_BATTERY_X_OFFSET;
+   p_area->y_initial = SB_BATTERY_Y_OFFSET;
+   p_area->x_final = SB_BATTERY_X_OFFSET + bitmap_dimensions[0];
+   p_area->y_final = SB_BATTERY_Y_OFFSET + bitmap_dimensions[1];
+
+   p_area = &status_bar_widgets[5].area; //Battery percentage
+   p_area->x_initial = SB_BATTERY_TEXT_X_OFFSET;
+   p_area->y_initial = SB_BATTERY_TEXT_Y_OFFSET;
+   p_area->x_final = SB_BATTERY_TEXT_X_OFFSET + lcd_get_string_width_small("00%");
+   p_area->y_final = SB_BATTERY_TEXT_Y_OFFSET + LCD_FONT_SMALL_HEIGHT;
+
+   gui_compositor_add_panel(&status_bar_panel);
+}
 
-      char tmp_string[11] = {' '};
-      pft_uint32_to_string(tmp_current_level, tmp_string);
-      char converted_string[4] = {"  %\0"};
-      converted_string[0] = tmp_string[8];
-      converted_string[1] = tmp_string[9];
 
-      //Take out preceding "0" if battery percentage is less than 10%
-      if('0'== converted_string[0])
-      {
-         converted_string[0] = ' ';
-      }
+/*!
+* @brief Status bar time widget inputs
+* @param[in] NONE
+* @return  The four displayed digits of status_bar_time_string
+*/
+uint32_t
+gui_get_status_bar_time_state(void)
+{
+   return(((uint32_t)(uint8_t)status_bar_time_string[0] << 24) | ((uint32_t)(uint8_t)status_bar_time_string[1] << 16) |
+          ((uint32_t)(uint8_t)status_bar_time_string[3] << 8) | (uint8_t)status_bar_time_string[4]);
+}
 
-      //Print battery icon and percentage
-      lcd_print_string_small(converted_string, SB_BATTERY_TEXT_X_OFFSET, SB_BATTERY_TEXT_Y_OFFSET, THEME_NEAR_WHITE, gui_get_status_bar_color());
 
-      uint16_t battery_color = THEME_NEAR_WHITE;
+/*!
+* @brief Draw the time on the status bar
+* @param[in] tmp_widget
+* @param[in] background_color
+* @return  NONE
+*/
+void
+gui_draw_status_bar_time(const t_gui_widget *tmp_widget, uint16_t background_color)
+{
+   (void)tmp_widget; //The time string is refreshed when the status bar samples the RTC
+   lcd_print_string_small(status_bar_time_string, SB_TIME_X_OFFSET, SB_TIME_Y_OFFSET, THEME_NEAR_WHITE, background_color);
+}
 
-      if(10 >= tmp_current_level)
-      {
-         battery_color = RED_LIGHT;
-      }
 
-      lcd_send_bitmap(battery_icon_bmp, SB_BATTERY_X_OFFSET, SB_BATTERY_Y_OFFSET, battery_color, gui_get_status_bar_color());
+/*!
+* @brief Status bar usb widget inputs
+* @param[in] NONE
+* @return  1 if usb is plugged in
+*/
+uint32_t
+gui_get_status_bar_usb_state(void)
+{
+   //Status will be > 0 if usb is plugged in. See monitor.c for info.
+   return(0 < monitor_get_usb_status());
+}
 
-      //Fill in battery icon with current percentage
-      uint16_t battery_fill = ((15 * tmp_current_level) / 100); //Formula: ((15 pixel rows in the battery) / 100_percent) * current_percentage
-      battery_fill = SB_BATTERY_FILL_Y_OFFSET - battery_fill; //Adjust number of active rows to rows above the bottom of the battery icon
 
-      lcd_draw_rectangle(THEME_NEAR_WHITE, SB_BATTERY_X_OFFSET, battery_fill, SB_BATTERY_X_OFFSET + 10, SB_BATTERY_FILL_Y_OFFSET);
+/*!
+* @brief Draw the usb icon, or clear it if usb is unplugged
+* @param[in] tmp_widget
+* @param[in] background_color
+* @return  NONE
+*/
+void
+gui_draw_status_bar_usb(const t_gui_widget *tmp_widget, uint16_t background_color)
+{
+   if(1 == tmp_widget->state)
+   {
+      lcd_send_bitmap(usb_icon_bmp, SB_USB_X_OFFSET, SB_USB_Y_OFFSET, THEME_NEAR_WHITE, background_color); //Display Icon
+   }
+
+   else
+   {
+      lcd_draw_rectangle(background_color, tmp_widget->area.x_initial, tmp_widget->area.y_initial,
+                         tmp_widget->area.x_final, tmp_widget->area.y_final); //Clear icon if usb is unplugged
    }
+}
+
 
+/*!
+* @brief Status bar headphones widget inputs
+* @param[in] NONE
+* @return  1 if headphones are plugged in
+*/
+uint32_t
+gui_get_status_bar_headphones_state(void)
+{
+   return(monitor_get_headphone_status());
 }
 
 
 /*!
-* @brief Update the speaker icon on the status bar
-* @param[in] background_color_change_flag This tells the function if the background color of the
-*                                         status bar has changed, meaning the speaker icon has been
-*                                         rewritten. A value of "1" means it has changed
+* @brief Draw the headphone icon, or clear it if there are no headphones
+* @param[in] tmp_widget
+* @param[in] background_color
 * @return  NONE
 */
 void
-gui_update_status_bar_volume(uint8_t background_color_change_flag)
+gui_draw_status_bar_headphones(const t_gui_widget *tmp_widget, uint16_t background_color)
 {
-   static e_dac_volume_type previous_volume_level = volume_on_init;
-   e_dac_volume_type current_volume = dac_get_volume();
-
-   //Only redraw the volume if level has changed. This helps with LCD flickering
-   if((previous_volume_level != current_volume) || (1 == background_color_change_flag))
+   if(1 == tmp_widget->state)
    {
-      switch(current_volume)
-      {
-      case volume_on_init:
-         break;
-      case volume_muted:
-         lcd_send_bitmap(speaker_muted, SB_SPEAKER_X_OFFSET, SB_SPEAKER_Y_OFFSET, THEME_NEAR_WHITE, gui_get_status_bar_color());
-         break;
-      case volume_low:
-         lcd_send_bitmap(speaker_low, SB_SPEAKER_X_OFFSET, SB_SPEAKER_Y_OFFSET, THEME_NEAR_WHITE,gui_get_status_bar_color());
-         break;
-      case volume_medium:
-         lcd_send_bitmap(speaker_medium,SB_SPEAKER_X_OFFSET, SB_SPEAKER_Y_OFFSET, THEME_NEAR_WHITE,gui_get_status_bar_color());
-         break;
-      case volume_high:
-         lcd_send_bitmap(speaker_high,SB_SPEAKER_X_OFFSET, SB_SPEAKER_Y_OFFSET, THEME_NEAR_WHITE,gui_get_status_bar_color());
-         break;
-      default:
-         break;
-
-      }
+      lcd_send_bitmap(headphone_icon_bmp, SB_HEADPHONES_X_OFFSET, SB_HEADPHONES_Y_OFFSET, THEME_NEAR_WHITE, background_color); //Display Icon
+   }
 
+   else
+   {
+      lcd_draw_rectangle(background_color, tmp_widget->area.x_initial, tmp_widget->area.y_initial,
+                         tmp_widget->area.x_final, tmp_widget->area.y_final); //Clear icon if there are no headphones
    }
+}
+
 
-   previous_volume_level = current_volume;
+/*!
+* @brief Status bar speaker widget inputs
+* @param[in] NONE
+* @return  Current volume level
+*/
+uint32_t
+gui_get_status_bar_volume_state(void)
+{
+   return(dac_get_volume());
 }
 
 
 /*!
-* @brief Redraw the time icon if a change to the status bar has occurred
-* @param[in] background_color_change_flag Parameter passed in to tell the function
-*                                         whether a state transition has occurred,
-*                                         meaning the status bar must also be updated.
-*                                         A value of "1" means that it has changed.
+* @brief Draw the speaker icon for the current volume level
+* @param[in] tmp_widget
+* @param[in] background_color
 * @return  NONE
 */
 void
-gui_update_status_bar_time(uint8_t background_color_change_flag)
+gui_draw_status_bar_volume(const t_gui_widget *tmp_widget, uint16_t background_color)
 {
-
-   //Only read RTC every 10 seconds when the alarm triggers
-   if((RTC->ISR & RTC_ISR_ALRAF) || background_color_change_flag)
+   switch((e_dac_volume_type)tmp_widget->state)
    {
-      char tmp_string[6] = {0};
+   case volume_on_init:
+      break;
+   case volume_muted:
+      lcd_send_bitmap(speaker_muted, SB_SPEAKER_X_OFFSET, SB_SPEAKER_Y_OFFSET, THEME_NEAR_WHITE, background_color);
+      break;
+   case volume_low:
+      lcd_send_bitmap(speaker_low, SB_SPEAKER_X_OFFSET, SB_SPEAKER_Y_OFFSET, THEME_NEAR_WHITE, background_color);
+      break;
+   case volume_medium:
+      lcd_send_bitmap(speaker_medium, SB_SPEAKER_X_OFFSET, SB_SPEAKER_Y_OFFSET, THEME_NEAR_WHITE, background_color);
+      break;
+   case volume_high:
+      lcd_send_bitmap(speaker_high, SB_SPEAKER_X_OFFSET, SB_SPEAKER_Y_OFFSET, THEME_NEAR_WHITE, background_color);
+      break;
+   default:
+      break;
+   }
+}
 
-      gui_rtc_to_string(tmp_string);
-      lcd_print_string_small(tmp_string, SB_TIME_X_OFFSET, SB_TIME_Y_OFFSET, THEME_NEAR_WHITE, gui_get_status_bar_color());
-      rtc_update_alarm(); //Update alarm value to trigger at next 10 second overflow
 
-   }
+/*!
+* @brief Status bar battery icon inputs. The icon only changes when the number of filled
+*        rows or the low battery color changes, not with every percent
+* @param[in] NONE
+* @return  Filled rows in the low byte, 1 in the next byte if the battery is low
+*/
+uint32_t
+gui_get_status_bar_battery_icon_state(void)
+{
+   uint32_t battery_fill = ((15 * status_bar_battery_level) / 100); //Formula: ((15 pixel rows in the battery) / 100_percent) * current_percentage
+
+   return(battery_fill | ((10 >= status_bar_battery_level) << 8));
 }
 
 
 /*!
-* @brief Redraw the headphone icon if a change to the status bar has occurred
-* @param[in] background_color_change_flag Parameter passed in to tell the function
-*                                         whether a state transition has occurred,
-*                                         meaning the status bar must also be updated.
-*                                         A value of "1" means that it has changed.
+* @brief Draw the battery icon and fill it in with the current percentage
+* @param[in] tmp_widget
+* @param[in] background_color
 * @return  NONE
 */
 void
-gui_update_status_bar_headphones(uint8_t background_color_change_flag)
+gui_draw_status_bar_battery_icon(const t_gui_widget *tmp_widget, uint16_t background_color)
 {
-   static uint8_t previous_headphones_status = 0;
-   uint8_t current_headphone_status = monitor_get_headphone_status();
+   uint16_t battery_color = THEME_NEAR_WHITE;
 
-   //Only redraw the icon if the headphone status has changed. This helps with LCD flickering
-   if((previous_headphones_status != current_headphone_status) || (1 == background_color_change_flag))
+   if(tmp_widget->state >> 8)
    {
-      if(1 == current_headphone_status)
-      {
-         lcd_send_bitmap(headphone_icon_bmp, SB_HEADPHONES_X_OFFSET, SB_HEADPHONES_Y_OFFSET, THEME_NEAR_WHITE, gui_get_status_bar_color()); //Display Icon
-      }
+      battery_color = RED_LIGHT;
+   }
 
-      else
-      {
-         lcd_draw_rectangle(gui_get_status_bar_color(), SB_HEADPHONES_X_OFFSET, 0, SB_HEADPHONES_X_OFFSET + 20, SB_OFFSET); //Clear icon if there are no headphones
-      }
+   lcd_send_bitmap(battery_icon_bmp, SB_BATTERY_X_OFFSET, SB_BATTERY_Y_OFFSET, battery_color, background_color);
 
-   }
+   //Fill in battery icon with current percentage
+   uint16_t battery_fill = SB_BATTERY_FILL_Y_OFFSET - (tmp_widget->state & 0xFF); //Adjust number of active rows to rows above the bottom of the battery icon
+
+   lcd_draw_rectangle(THEME_NEAR_WHITE, SB_BATTERY_X_OFFSET, battery_fill, SB_BATTERY_X_OFFSET + 10, SB_BATTERY_FILL_Y_OFFSET);
+}
 
-   previous_headphones_status = current_headphone_status;
 
+/*!
+* @brief Status bar battery percentage inputs
+* @param[in] NONE
+* @return  Last sampled battery level
+*/
+uint32_t
+gui_get_status_bar_battery_text_state(void)
+{
+   return(status_bar_battery_level);
 }
 
 
 /*!
-* @brief Redraw the usb icon if a change to the status bar has occurred
-* @param[in] background_color_change_flag Parameter passed in to tell the function
-*                                         whether a state transition has occurred,
-*                                         meaning the status bar must also be updated.
-*                                         A value of "1" means that it has changed.
+* @brief Draw the battery percentage on the status bar
+* @param[in] tmp_widget
+* @param[in] background_color
 * @return  NONE
 */
 void
-gui_update_status_bar_usb(uint8_t background_color_change_flag)
+gui_draw_status_bar_battery_text(const t_gui_widget *tmp_widget, uint16_t background_color)
 {
-   static uint8_t previous_usb_status = 0;
-   uint8_t current_usb_status = monitor_get_usb_status();
-
-   //Only redraw the icon if usb status has changed. This helps with LCD flickering
-   if((previous_usb_status != current_usb_status) || (1 == background_color_change_flag))
+   char tmp_string[11] = {' '};
+   pft_uint32_to_string(tmp_widget->state, tmp_string);
+   char converted_string[4] = {"  %"};
+   converted_string[0] = tmp_string[8];
+   converted_string[1] = tmp_string[9];
+
+   //Take out preceding "0" if battery percentage is less than 10%
+   if('0'== converted_string[0])
    {
-      //Status will be > 0 if usb is plugged in. See monitor.c for info.
-      if(0 < current_usb_status)
-      {
-         lcd_send_bitmap(usb_icon_bmp, SB_USB_X_OFFSET, SB_USB_Y_OFFSET, THEME_NEAR_WHITE, gui_get_status_bar_color()); //Display Icon
-      }
-
-      else
-      {
-         lcd_draw_rectangle(gui_get_status_bar_color(), SB_USB_X_OFFSET, 0, SB_USB_X_OFFSET + 24, SB_OFFSET); //Clear icon if there are no headphones
-      }
-
+      converted_string[0] = ' ';
    }
 
-   previous_usb_status = current_usb_status;
-
+   lcd_print_string_small(converted_string, SB_BATTERY_TEXT_X_OFFSET, SB_BATTERY_TEXT_Y_OFFSET, THEME_NEAR_WHITE, background_color);
 }
 
 
@@ -1657,7 +1933,7 @@ gui_get_battery_time_remaining(char *final_string)
    //Get the current battery level without sampling the ADC
    uint8_t tmp_battery_level = monitor_get_battery_level(BATTERY_SAMPLE_FLAG_NONE);
 
-   char tmp_time_string[9] = " hr   min";
+   char tmp_time_string[10] = " hr   min";
 
    //Convert battery level from uint8 to a string
    tmp_time_string[0] = number_char_lookup[((time_remaining[tmp_battery_level]) / 60)]; //Hours
@@ -1680,6 +1956,8 @@ gui_get_battery_time_remaining(char *final_string)
 void
 gui_settings_menu_update_volume(void)
 {
+   lcd_display_list_begin();
+
    uint16_t x_offset = MENU_SETTINGS_BUTTON_X_OFFSET, y_offset = MENU_SETTINGS_BUTTON_Y_OFFSET;
    uint16_t slider_offset = x_offset + 27, tmp_color = GREEN_NEON;
    e_dac_volume_type tmp_volume = dac_get_volume();
@@ -1715,6 +1993,7 @@ gui_settings_menu_update_volume(void)
       y_offset -= 10;
    }
 
+   lcd_display_list_end();
 }
 
 
@@ -1803,6 +2082,101 @@ gui_time_to_string(char *tmp_time_string, uint8_t *tmp_time_buffer)
 }
 
 
+/*!
+* @brief Draws one turn of the loading circle: 8 mini circles whose colors move one place per frame
+* @param[in] tmp_animation
+* @return The time until the next frame in ms, GUI_ANIMATION_DONE after the last
+*/
+uint32_t
+gui_loading_circle_step(t_gui_animation *tmp_animation)
+{
+   if(GUI_LOADING_CIRCLE_FRAMES <= tmp_animation->frame)
+   {
+      return(GUI_ANIMATION_DONE);
+   }
+
+   uint16_t x = tmp_animation->x;
+   uint16_t y = tmp_animation->y;
+   uint8_t radius = 30;
+   uint8_t d_radius = (((sqrt(2)) / 2) * radius); //Each leg of a 45-45-90 triangle is sqrt(2) / 2
+
+   //Lookup tables for each small circle position
+   const uint16_t x_pos[8] = {(x - d_radius), (x - radius ), (x - d_radius), x,
+                              (x + d_radius), x + radius, (x + d_radius), x};
+
+   const uint16_t y_pos[8] = {(y - d_radius), y, (y + d_radius), (y + radius),
+                              (y + d_radius), y, (y - d_radius), (y - radius)};
+
+   //Color table for each mini circle in the spectrum of white to black
+   const uint16_t color_buffer[8] = {WHITE_PURE, GRAY_EXTRA_LIGHT, GRAY_LIGHT, GRAY_LIGHT, GRAY_MEDIUM, GRAY_MEDIUM_DARK, GRAY_DARK_ALT, BLACK};
+
+   //Starting one color further each frame makes the circle appear to spin
+   for(uint8_t mini_circle = 0; mini_circle < 8; mini_circle++)
+   {
+      lcd_send_bitmap(sliding_bar_marker_bmp, x_pos[mini_circle], y_pos[mini_circle], color_buffer[(tmp_animation->frame + mini_circle) & 0x07], BLACK);
+   }
+
+   return(GUI_LOADING_CIRCLE_FRAME_MS);
+}
+
+
+/*!
+* @brief Draws one step of the boot animation: the blank screen, GUI_BOOT_ROTATIONS turns of the
+*        spinner, then the title and the author
+* @param[in] tmp_animation
+* @return The time until the next frame in ms, GUI_ANIMATION_DONE after the last
+*/
+uint32_t
+gui_boot_animation_step(t_gui_animation *tmp_animation)
+{
+   uint16_t spinner_frames = (boot_frame_count - 1) * GUI_BOOT_ROTATIONS; //All frames but the last, which is the "EMBEDDED RESUME" title
+   uint16_t frame = tmp_animation->frame;
+
+   //Clear screen to start animation on a blank background
+   if(0 == frame)
+   {
+      lcd_draw_rectangle(BLACK, 0, 0, 320, 480);
+      lcd_invert_screen_on();
+      lcd_backlight_enable();
+      return(GUI_BOOT_PAUSE_MS);
+   }
+
+   if(spinner_frames >= frame)
+   {
+      if(boot_is_delta)
+      {
+         lcd_animation_draw_next(&boot_delta);
+      }
+
+      else
+      {
+         uint16_t x_offset = tmp_animation->x, y_offset = tmp_animation->y;
+         lcd_image_from_sd(x_offset, y_offset, x_offset + 136, y_offset + 200, boot_frames[(frame - 1) % (boot_frame_count - 1)]);
+      }
+
+      return((spinner_frames == frame) ? (GUI_BOOT_FRAME_MS + GUI_BOOT_PAUSE_MS) : GUI_BOOT_FRAME_MS);
+   }
+
+   switch(frame - spinner_frames)
+   {
+   case 1:
+      lcd_invert_screen_off(); //Bring screen back to "normal" display mode
+      return(GUI_BOOT_HOLD_MS);
+
+   case 2:
+      lcd_image_from_sd(27, 65, 27 + 268, 65 + 40, boot_frames[boot_frame_count - 1]); //Display "EMBEDDED RESUME" title
+      return(GUI_BOOT_HOLD_MS);
+
+   case 3:
+      lcd_print_string("by Aaron Vorse", 27 + 44, 65 + 35, GRAY_LIGHT, BLACK);
+      return(GUI_BOOT_HOLD_MS);
+
+   default:
+      return(GUI_ANIMATION_DONE);
+   }
+}
+
+
 #pragma GCC pop_options
 
 /* end of file */
@@ -0,0 +1,288 @@
+/** @file gui_animation.c
+*
+* @brief  This file plays animations from the main loop. An animation is a step function and
+*         the state it works from. gui_animation_update() calls the step function of every
+*         animation whose frame is due, and the step function says how long to wait for the
+*         next one. Nothing blocks in between, so touch polling, audio and the state machines
+*         run while an animation plays. How late each frame was drawn is kept and reported
+*         over UART when the animation ends.
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#include "gui_animation.h"
+
+
+/*
+****************************************************
+************* File-Static Variables ****************
+****************************************************
+*/
+static t_gui_animation *running_animations[GUI_ANIMATION_MAX_RUNNING] = {0};
+
+
+/*
+****************************************************
+********** Private Function Prototypes *************
+****************************************************
+*/
+void gui_animation_remove(t_gui_animation *tmp_animation);
+void gui_animation_report(const t_gui_animation *tmp_animation);
+void gui_animation_print(const char *tmp_string);
+const char *gui_animation_number_to_string(uint32_t tmp_number, char *p_tmp_string);
+
+
+/*
+****************************************************
+********** Public Function Definitions *************
+****************************************************
+*/
+
+/*!
+* @brief Start playing an animation. Its first frame is drawn on the next gui_animation_update()
+* @param[in] tmp_animation Must stay in place until the animation ends, x and y are kept
+* @param[in] tmp_step Draws the frame numbered tmp_animation->frame
+* @param[in] tmp_name Used in the jitter report
+* @param[in] owns_screen 1 if nothing else may draw while it plays
+* @return 1 if started, 0 if GUI_ANIMATION_MAX_RUNNING animations are already playing
+*
+* @note Starting an animation that is already playing restarts it
+*/
+uint8_t
+gui_animation_start(t_gui_animation *tmp_animation, uint32_t (*tmp_step)(t_gui_animation *), const char *tmp_name,
+                    uint8_t owns_screen)
+{
+   gui_animation_remove(tmp_animation);
+
+   for(uint8_t current_slot = 0; current_slot < GUI_ANIMATION_MAX_RUNNING; current_slot++)
+   {
+      if(NULL == running_animations[current_slot])
+      {
+         tmp_animation->step = tmp_step;
+         tmp_animation->name = tmp_name;
+         tmp_animation->frame = 0;
+         tmp_animation->owns_screen = owns_screen;
+         tmp_animation->running = 1;
+         tmp_animation->due_us = timers_get_us();
+         tmp_animation->late_total_us = 0;
+         tmp_animation->late_max_us = 0;
+
+         running_animations[current_slot] = tmp_animation;
+         return(1);
+      }
+   }
+
+   return(0);
+}
+
+
+/*!
+* @brief Stop an animation where it is. Whatever it last drew stays on the screen
+* @param[in] tmp_animation
+* @return NONE
+*/
+void
+gui_animation_stop(t_gui_animation *tmp_animation)
+{
+   gui_animation_remove(tmp_animation);
+   tmp_animation->running = 0;
+}
+
+
+/*!
+* @brief Draw the next frame of every animation that is due. Called once per pass of the main loop
+* @param[in] NONE
+* @return NONE
+*
+* @note A frame is scheduled one period after the previous one was due rather than after it was
+*       drawn, so drawing time does not add up over the animation. If the main loop was held up
+*       for longer than a period, the schedule starts over instead of rushing the missed frames
+*/
+void
+gui_animation_update(void)
+{
+   for(uint8_t current_slot = 0; current_slot < GUI_ANIMATION_MAX_RUNNING; current_slot++)
+   {
+      t_gui_animation *p_animation = running_animations[current_slot];
+
+      if(NULL == p_animation)
+      {
+         continue;
+      }
+
+      uint32_t tmp_now = timers_get_us();
+      uint32_t tmp_late = tmp_now - p_animation->due_us;
+
+      //Not due yet. The difference wraps to a large value while due_us is ahead
+      if(0x80000000 <= tmp_late)
+      {
+         continue;
+      }
+
+      p_animation->late_total_us += tmp_late;
+
+      if(tmp_late > p_animation->late_max_us)
+      {
+         p_animation->late_max_us = tmp_late;
+      }
+
+      uint32_t tmp_period_ms = p_animation->step(p_animation);
+      p_animation->frame++;
+
+      if(GUI_ANIMATION_DONE == tmp_period_ms)
+      {
+         gui_animation_stop(p_animation);
+         gui_animation_report(p_animation);
+         continue;
+      }
+
+      p_animation->due_us += tmp_period_ms * 1000;
+
+      if(0x80000000 > (tmp_now - p_animation->due_us))
+      {
+         p_animation->due_us = tmp_now;
+      }
+   }
+}
+
+
+/*!
+* @brief Check whether an animation is still playing
+* @param[in] tmp_animation
+* @return 1 until its last frame has been drawn or it is stopped
+*/
+uint8_t
+gui_animation_is_running(const t_gui_animation *tmp_animation)
+{
+   return(tmp_animation->running);
+}
+
+
+/*!
+* @brief Check whether a playing animation has the whole screen to itself
+* @param[in] NONE
+* @return 1 if the status bar and footer must not be drawn
+*/
+uint8_t
+gui_animation_owns_screen(void)
+{
+   for(uint8_t current_slot = 0; current_slot < GUI_ANIMATION_MAX_RUNNING; current_slot++)
+   {
+      if((NULL != running_animations[current_slot]) && running_animations[current_slot]->owns_screen)
+      {
+         return(1);
+      }
+   }
+
+   return(0);
+}
+
+
+
+
+/*
+****************************************************
+********** Private Function Definitions ************
+****************************************************
+*/
+
+/*!
+* @brief Take an animation out of the running list if it is in it
+* @param[in] tmp_animation
+* @return NONE
+*/
+void
+gui_animation_remove(t_gui_animation *tmp_animation)
+{
+   for(uint8_t current_slot = 0; current_slot < GUI_ANIMATION_MAX_RUNNING; current_slot++)
+   {
+      if(tmp_animation == running_animations[current_slot])
+      {
+         running_animations[current_slot] = NULL;
+      }
+   }
+}
+
+
+/*!
+* @brief Send the frame count and how late the frames were over UART
+* @param[in] tmp_animation
+* @return NONE
+*/
+void
+gui_animation_report(const t_gui_animation *tmp_animation)
+{
+   char tmp_number[11] = {0};
+
+   gui_animation_print("\n\r ");
+   gui_animation_print(tmp_animation->name);
+   gui_animation_print(": ");
+   gui_animation_print(gui_animation_number_to_string(tmp_animation->frame, tmp_number));
+   gui_animation_print(" frames, late by ");
+   gui_animation_print(gui_animation_number_to_string(tmp_animation->late_total_us / tmp_animation->frame, tmp_number));
+   gui_animation_print("us on average, ");
+   gui_animation_print(gui_animation_number_to_string(tmp_animation->late_max_us, tmp_number));
+   gui_animation_print("us at most \n\r");
+}
+
+
+/*!
+* @brief Send a string over UART, waiting for every byte
+* @param[in] tmp_string
+* @return NONE
+*
+* @note uart1_printf() gives up on a byte after a short timeout, which drops characters at 115200 baud
+*/
+void
+gui_animation_print(const char *tmp_string)
+{
+   for(size_t current_char = 0; '\0' != tmp_string[current_char]; current_char++)
+   {
+      uart1_send_byte(tmp_string[current_char]);
+   }
+}
+
+
+/*!
+* @brief Convert a number to a string without leading zeros
+* @param[in] tmp_number
+* @param[in] p_tmp_string Room for 11 characters
+* @return The first digit inside p_tmp_string
+*/
+const char *
+gui_animation_number_to_string(uint32_t tmp_number, char *p_tmp_string)
+{
+   uint8_t first_digit = 0;
+
+   pft_uint32_to_string(tmp_number, p_tmp_string);
+
+   while((9 > first_digit) && ('0' == p_tmp_string[first_digit]))
+   {
+      first_digit++;
+   }
+
+   return(&p_tmp_string[first_digit]);
+}
+
+
+/* end of file */
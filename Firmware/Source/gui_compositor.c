@@ -0,0 +1,334 @@
+/** @file gui_compositor.c
+*
+* @brief  This file tracks which parts of the status bar and footer are out of date and
+*         redraws only those widgets once per pass of the main loop. Rectangles invalidated
+*         during a pass are merged when they overlap, the panel background is only repainted
+*         where it was asked for, and each widget touching a dirty rectangle is drawn once.
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#include "gui_compositor.h"
+
+
+/*
+****************************************************
+***** Private Types and Structure Definitions ******
+****************************************************
+*/
+
+
+/*
+****************************************************
+************* File-Static Variables ****************
+****************************************************
+*/
+static t_gui_panel *panels[GUI_COMPOSITOR_MAX_PANELS] = {0};
+static uint8_t panel_count = 0;
+
+//Rectangles invalidated since the last flush. A set background flag means the panel
+//background under the rectangle must be repainted before the widgets are drawn
+static t_gui_rect dirty_rects[GUI_COMPOSITOR_MAX_DIRTY_RECTS] = {0};
+static uint8_t dirty_background_flags[GUI_COMPOSITOR_MAX_DIRTY_RECTS] = {0};
+static uint8_t dirty_rect_count = 0;
+
+static uint32_t frame_start_pixels = 0;
+static uint32_t frame_pixels = 0;
+
+
+/*
+****************************************************
+********** Private Function Prototypes *************
+****************************************************
+*/
+uint8_t gui_compositor_rects_overlap(const t_gui_rect *tmp_first, const t_gui_rect *tmp_second);
+void gui_compositor_rect_union(t_gui_rect *tmp_destination, const t_gui_rect *tmp_source);
+
+
+/*
+****************************************************
+********** Public Function Definitions *************
+****************************************************
+*/
+
+/*!
+* @brief Register a panel so gui_compositor_flush() repaints it. Adding a panel twice has no effect
+* @param[in] tmp_panel Must stay valid for as long as the system runs
+* @return NONE
+*/
+void
+gui_compositor_add_panel(t_gui_panel *tmp_panel)
+{
+   for(uint8_t current_panel = 0; current_panel < panel_count; current_panel++)
+   {
+      if(tmp_panel == panels[current_panel])
+      {
+         return;
+      }
+   }
+
+   if(GUI_COMPOSITOR_MAX_PANELS > panel_count)
+   {
+      panels[panel_count] = tmp_panel;
+      panel_count++;
+   }
+}
+
+
+/*!
+* @brief Mark part of the screen as out of date. The rectangle is merged with every
+*        rectangle it overlaps so no pixel is drawn twice in the same flush
+* @param[in] tmp_rect
+* @param[in] background_flag 1 if the panel background under the rectangle must be repainted,
+*                            0 if the widgets inside it cover every pixel they changed
+* @return NONE
+*/
+void
+gui_compositor_invalidate(const t_gui_rect *tmp_rect, uint8_t background_flag)
+{
+   t_gui_rect merged_rect = *tmp_rect;
+   uint8_t current_rect = 0;
+
+   if((merged_rect.x_final <= merged_rect.x_initial) || (merged_rect.y_final <= merged_rect.y_initial))
+   {
+      return;
+   }
+
+   while(current_rect < dirty_rect_count)
+   {
+      if(gui_compositor_rects_overlap(&merged_rect, &dirty_rects[current_rect]))
+      {
+         gui_compositor_rect_union(&merged_rect, &dirty_rects[current_rect]);
+         background_flag |= dirty_background_flags[current_rect];
+
+         //Remove the absorbed rectangle, then start over since the union may now reach earlier ones
+         dirty_rect_count--;
+         dirty_rects[current_rect] = dirty_rects[dirty_rect_count];
+         dirty_background_flags[current_rect] = dirty_background_flags[dirty_rect_count];
+         current_rect = 0;
+      }
+
+      else
+      {
+         current_rect++;
+      }
+   }
+
+   //Out of room, grow the last rectangle instead. This only costs overdraw
+   if(GUI_COMPOSITOR_MAX_DIRTY_RECTS == dirty_rect_count)
+   {
+      gui_compositor_rect_union(&dirty_rects[dirty_rect_count - 1], &merged_rect);
+      dirty_background_flags[dirty_rect_count - 1] |= background_flag;
+      return;
+   }
+
+   dirty_rects[dirty_rect_count] = merged_rect;
+   dirty_background_flags[dirty_rect_count] = background_flag;
+   dirty_rect_count++;
+}
+
+
+/*!
+* @brief Mark a whole panel, background included, as out of date. Used when its color
+*        changes or a menu has drawn over it
+* @param[in] tmp_panel
+* @return NONE
+*/
+void
+gui_compositor_invalidate_panel(t_gui_panel *tmp_panel)
+{
+   //Every widget is about to be drawn, so its current inputs become the reference
+   for(uint8_t current_widget = 0; current_widget < tmp_panel->widget_count; current_widget++)
+   {
+      t_gui_widget *p_widget = &tmp_panel->widgets[current_widget];
+
+      if(NULL != p_widget->get_state)
+      {
+         p_widget->state = p_widget->get_state();
+      }
+   }
+
+   gui_compositor_invalidate(&tmp_panel->area, 1);
+}
+
+
+/*!
+* @brief Invalidate every widget of a panel whose inputs changed since it was last drawn
+* @param[in] tmp_panel
+* @return NONE
+*/
+void
+gui_compositor_update_panel(t_gui_panel *tmp_panel)
+{
+   for(uint8_t current_widget = 0; current_widget < tmp_panel->widget_count; current_widget++)
+   {
+      t_gui_widget *p_widget = &tmp_panel->widgets[current_widget];
+
+      if(NULL == p_widget->get_state)
+      {
+         continue;
+      }
+
+      uint32_t current_state = p_widget->get_state();
+
+      if(current_state != p_widget->state)
+      {
+         p_widget->state = current_state;
+         gui_compositor_invalidate(&p_widget->area, 0);
+      }
+   }
+}
+
+
+/*!
+* @brief Draw everything invalidated since the last call, then close the frame for
+*        gui_compositor_get_frame_pixels(). Called once per pass of the main loop
+* @param[in] NONE
+* @return NONE
+*
+* @note Backgrounds are painted first and widgets after, so widgets may be drawn in any order
+*       as long as their areas do not overlap.
+*/
+void
+gui_compositor_flush(void)
+{
+   //Repaint the backgrounds that were asked for, clipped to each panel
+   for(uint8_t current_rect = 0; current_rect < dirty_rect_count; current_rect++)
+   {
+      if(0 == dirty_background_flags[current_rect])
+      {
+         continue;
+      }
+
+      for(uint8_t current_panel = 0; current_panel < panel_count; current_panel++)
+      {
+         const t_gui_rect *p_area = &panels[current_panel]->area;
+         const t_gui_rect *p_dirty = &dirty_rects[current_rect];
+
+         if(gui_compositor_rects_overlap(p_area, p_dirty))
+         {
+            lcd_draw_rectangle(panels[current_panel]->get_background_color(),
+                               (p_dirty->x_initial > p_area->x_initial) ? p_dirty->x_initial : p_area->x_initial,
+                               (p_dirty->y_initial > p_area->y_initial) ? p_dirty->y_initial : p_area->y_initial,
+                               (p_dirty->x_final < p_area->x_final) ? p_dirty->x_final : p_area->x_final,
+                               (p_dirty->y_final < p_area->y_final) ? p_dirty->y_final : p_area->y_final);
+         }
+      }
+   }
+
+   //Draw each widget touching a dirty rectangle once
+   for(uint8_t current_panel = 0; (current_panel < panel_count) && (0 < dirty_rect_count); current_panel++)
+   {
+      t_gui_panel *p_panel = panels[current_panel];
+      uint16_t background_color = p_panel->get_background_color();
+
+      for(uint8_t current_widget = 0; current_widget < p_panel->widget_count; current_widget++)
+      {
+         const t_gui_widget *p_widget = &p_panel->widgets[current_widget];
+
+         for(uint8_t current_rect = 0; current_rect < dirty_rect_count; current_rect++)
+         {
+            if(gui_compositor_rects_overlap(&p_widget->area, &dirty_rects[current_rect]))
+            {
+               p_widget->draw(p_widget, background_color);
+               break;
+            }
+         }
+      }
+   }
+
+   dirty_rect_count = 0;
+
+   uint32_t current_pixels = lcd_get_pixels_pushed();
+   frame_pixels = current_pixels - frame_start_pixels;
+   frame_start_pixels = current_pixels;
+}
+
+
+/*!
+* @brief Pixels written to the LCD during the last full frame, from one gui_compositor_flush()
+*        to the next. This includes menus drawn by the state machine as well as the compositor
+* @param[in] NONE
+* @return frame_pixels
+*/
+uint32_t
+gui_compositor_get_frame_pixels(void)
+{
+   return(frame_pixels);
+}
+
+
+
+
+/*
+****************************************************
+********** Private Function Definitions ************
+****************************************************
+*/
+
+/*!
+* @brief Check if two rectangles share at least one pixel
+* @param[in] tmp_first
+* @param[in] tmp_second
+* @return 1 if they overlap
+*/
+uint8_t
+gui_compositor_rects_overlap(const t_gui_rect *tmp_first, const t_gui_rect *tmp_second)
+{
+   return((tmp_first->x_initial < tmp_second->x_final) && (tmp_second->x_initial < tmp_first->x_final) &&
+          (tmp_first->y_initial < tmp_second->y_final) && (tmp_second->y_initial < tmp_first->y_final));
+}
+
+
+/*!
+* @brief Grow a rectangle to the bounding box of itself and another
+* @param[in] tmp_destination
+* @param[in] tmp_source
+* @return NONE
+*/
+void
+gui_compositor_rect_union(t_gui_rect *tmp_destination, const t_gui_rect *tmp_source)
+{
+   if(tmp_source->x_initial < tmp_destination->x_initial)
+   {
+      tmp_destination->x_initial = tmp_source->x_initial;
+   }
+
+   if(tmp_source->y_initial < tmp_destination->y_initial)
+   {
+      tmp_destination->y_initial = tmp_source->y_initial;
+   }
+
+   if(tmp_source->x_final > tmp_destination->x_final)
+   {
+      tmp_destination->x_final = tmp_source->x_final;
+   }
+
+   if(tmp_source->y_final > tmp_destination->y_final)
+   {
+      tmp_destination->y_final = tmp_source->y_final;
+   }
+}
+
+
+/* end of file */
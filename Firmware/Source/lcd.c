@@ -29,6 +29,7 @@
 */
 
 #include "lcd.h"
+#include "lcd_glyph_cache.h"
 
 #pragma GCC push_options
 //#pragma GCC optimize ("O3")
@@ -37,20 +38,45 @@
 
 /*
 ****************************************************
-************* File-Static Variables ****************
+***** Private Types and Structure Definitions ******
 ****************************************************
 */
-static const uint8_t color_table_map[193] =
+//Area held by lcd_save_under(), in screen positions
+typedef struct t_lcd_save_under_tag
 {
-      0, 1, 2, 3, 1, 0, 0, 0, 2, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0,
-      0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-      3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0,
-      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-      0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3
-};
+   uint16_t x_initial;
+   uint16_t y_initial;
+   uint16_t x_final;
+   uint16_t y_final;
+   const uint8_t *data; //Lent by the glyph cache while is_saved is set
+   uint16_t bytes;
+   uint8_t is_saved;
+
+} t_lcd_save_under;
+
+
+/*
+****************************************************
+************* File-Static Variables ****************
+****************************************************
+*/
+//Two ready-to-send RGB565 pixels for every 2bpp nibble, leftmost pixel first.
+//Rebuilt by lcd_load_expansion_table() only when the palette changes
+static uint16_t expansion_table[16][2] = {0};
+static uint16_t expansion_font_color = 0;
+static uint16_t expansion_background_color = 0;
+static uint8_t expansion_table_loaded = 0;
+
+//Running total of pixels written to GRAM, read by the GUI compositor once per frame
+static uint32_t pixels_pushed = 0;
+
+//Hardware vertical scroll, see lcd_scroll_define(). Power up values leave the panel unscrolled
+static uint16_t scroll_top_rows = 0;
+static uint16_t scroll_rows = LCD_HEIGHT;
+static uint16_t scroll_offset = 0; //Lines the content of the scroll area has moved up
+
+//Pixels under a popup, see lcd_save_under()
+static t_lcd_save_under save_under = {0};
 
 
 /*
@@ -58,10 +84,8 @@ static const uint8_t color_table_map[193] =
 ********** Private Function Prototypes *************
 ****************************************************
 */
-void lcd_write_to_bus(uint8_t tmp_byte);
 void lcd_send_command(uint8_t tmp_command);
 void lcd_send_data(uint8_t tmp_data);
-void lcd_set_window_address(uint16_t x_initial,uint16_t y_initial,uint16_t x_final,uint16_t y_final);
 void lcd_reset(void);
 void lcd_color_correction_set(void);
 void lcd_power_mode_set(void);
@@ -74,9 +98,9 @@ void lcd_memory_access_control_set(void);
 void lcd_pixel_format_set(void);
 void lcd_gpio_init(void);
 uint16_t lcd_decode_bmp_pixel(uint8_t red, uint8_t green, uint8_t blue);
-uint8_t lcd_skip_bmp_header(void);
-void lcd_get_font_color_table(uint16_t *tmp_table, uint16_t tmp_font_color, uint16_t tmp_background_color);
-void lcd_parse_local_bitmap(const uint8_t *tmp_bitmap, uint16_t *tmp_dimensions);
+uint8_t lcd_read_from_bus(void);
+void lcd_print_string_line(const char *tmp_string, uint16_t x, uint16_t y, const uint8_t *tmp_font,
+                           uint8_t glyph_height, const t_font_glyph_metrics *tmp_metrics);
 
 
 /*
@@ -95,9 +119,14 @@ lcd_init(void)
 {
    //Initialize control and data lines
    lcd_gpio_init();
+
+   if(LCD_DMA_ENABLED)
+   {
+      lcd_dma_init();
+   }
    
    lcd_reset();
-   gpio_clear(LCD_CS); //Enable LCD
+   lcd_select(); //Enable LCD
   
    //Setup base LCD register values
    //many of these are present in vendor startup code
@@ -134,9 +163,9 @@ lcd_init(void)
 void
 lcd_invert_screen_on(void)
 {
-   gpio_clear(LCD_CS);
+   lcd_select();
    lcd_send_command(LCD_CMD_DISPLAY_INVERSION_ON);
-   gpio_set(LCD_CS);
+   gpio_pin_set(LCD_CS);
 }
 
 
@@ -150,9 +179,9 @@ lcd_invert_screen_on(void)
 void
 lcd_invert_screen_off(void)
 {
-   gpio_clear(LCD_CS);
+   lcd_select();
    lcd_send_command(LCD_CMD_DISPLAY_INVERSION_OFF);
-   gpio_set(LCD_CS);
+   gpio_pin_set(LCD_CS);
 }
 
 
@@ -168,384 +197,659 @@ lcd_invert_screen_off(void)
 void
 lcd_draw_rectangle(uint16_t color,uint16_t x_in ,uint16_t y_in,uint16_t x_fin ,uint16_t y_fin)
 { 
+   //Record instead of drawing while a display list is open
+   if(lcd_display_list_add_rectangle(color, x_in, y_in, x_fin, y_fin))
+   {
+      return;
+   }
+
+   uint32_t total_pixels = (uint32_t)(x_fin - x_in) * (y_fin - y_in);
 
    //Select LCD
-   gpio_clear(LCD_CS);
+   lcd_select();
 
    //Define the window the of the LCD to be written to
    lcd_set_window_address(x_in, y_in, x_fin-1, y_fin-1);
+   lcd_add_pixels_pushed(total_pixels);
 
    //Put LCD in data mode
-   gpio_set(LCD_RS);
-   
+   gpio_pin_set(LCD_RS);
+
    //Loop through each row and column, filling each pixel with color
    for(uint32_t row = y_in; row < y_fin; row++)
    {
       for(uint32_t column = x_in; column < x_fin; column++)
       {
-         GPIOB->BSRR = 0xFFFF0000; //Clear the LCD data bus
-         GPIOB->BSRR = (color >> 8); //write most significant byte
-         GPIOA->BSRR = 0x00000100; //Set LCD_WR, clocking the bus data into the LCD
-         GPIOA->BSRR = 0x01000000; //Clear LCD_WR
-
-         GPIOB->BSRR = 0xFFFF0000; //Clear the LCD data bus
-         GPIOB->BSRR = (color & 0x00FF); //write least significant byte
-         GPIOA->BSRR = 0x00000100; //Set LCD_WR, clocking the bus data into the LCD
-         GPIOA->BSRR = 0x01000000; //Clear LCD_WR
+         lcd_bus_write(color >> 8); //write most significant byte
+         lcd_bus_write(color & 0x00FF); //write least significant byte
       }
    }
     
-  gpio_set(LCD_CS);
+  gpio_pin_set(LCD_CS);
     
 }
 
 
 /*!
-* @brief Sends image from SD card to LCD 
-* @param[in] x_in Initial X position
-* @param[in] y_in Initial Y position
-* @param[in] x_fin Final X position
-* @param[in] y_fin Final Y position
-* @param[in] memory_starting_address Memory block location of the image on the SD card
+* @brief Displays a simple background of small squares to the LCD
+* @param[in] NONE
 * @return NONE
-*
-* @note This function appears long and unruly due to the fact that many intermediate
-*       functions were unrolled and optimization for speed was performed
 */
 void
-lcd_image_from_sd(uint16_t x_in ,uint16_t y_in,uint16_t x_fin ,uint16_t y_fin, uint32_t memory_starting_address)
+lcd_background_squares(void)
 {
-   uint32_t total_blocks = 0, total_bytes = 0;
-   
-   //Formula: total-bytes = ((total-pixels) x (3 bytes-per-pixel))
-   total_bytes = ((x_fin - x_in) * (y_fin - y_in) * 3);
+   //Init square color
+   uint16_t square_color = 0x07E0;
    
-   //512 bytes-per-block
-   total_blocks = (total_bytes / 512);
+   //Put squares all over screen. Each band of rows is one display list, so the black under
+   //the squares is never sent and the band goes out through a single window
+   for(uint16_t row = 0; row < 480; row += 15)
+   {
+      square_color -= 1;
 
-   //Select LCD
-   gpio_clear(LCD_CS);
-   
-   //Set upper left corner of image as starting address
-   lcd_set_window_address(x_in, y_in, x_fin - 1, y_fin - 1);
+      lcd_display_list_begin();
 
-   //Put LCD in data mode
-   gpio_set(LCD_RS); //LCD_RS=1;
-   
-   //Start reading the image from the SD card
-   sd_read_multiple_block(memory_starting_address);
-   
-   //Burn through the header to get to the image, starts at 0x36 offset 
-   uint32_t current_byte = 512;
-   current_byte -= lcd_skip_bmp_header();
+      //blank background
+      lcd_draw_rectangle(0x0000, 0, row, 320, (row + 15));
+      
+      for(uint16_t column = 0; column < 320; column += 15)
+      {
+         lcd_draw_rectangle(square_color, column, row, (column + 10), (row + 10));
+      }
 
-   uint32_t color_buffer[6] = {0}; // blue green red blue green red
-   uint32_t color_number = 0;
-   
+      lcd_display_list_end();
+   }
+}
 
-   for(uint32_t block_number = total_blocks; block_number != 0; --block_number)
-   {
 
-      while(0 != current_byte)
-      {
-         /* This is just spi_receive_byte(0xFF) unrolled */
-         //Send dummy byte byte
-         SPI2->DR = 0xFF;
+/*!
+* @brief Display a given string from a 2-bit bitmap font
+* @param[in] tmp_string Message to be displayed
+* @param[in] x
+* @param[in] y
+* @param[in] font_color
+* @param[in] background_color
+* @return NONE
+*
+* @note This is specifically for medium font
+*/
+void
+lcd_print_string(char *tmp_string, uint16_t x, uint16_t y, uint16_t font_color, uint16_t background_color)
+{
+   //Record instead of drawing while a display list is open
+   if(lcd_display_list_add_text(lcd_primitive_string, tmp_string, x, y, font_color, background_color, 0))
+   {
+      return;
+   }
 
-         // Wait for the receive register to fill
-         while(!(SPI2->SR & SPI_SR_RXNE)){}
+   //Four-color palette for anti-aliased font
+   lcd_load_expansion_table(font_color, background_color);
 
-         color_buffer[color_number] = (SPI2->DR);
-         color_number++;
-         
-         if(6 == color_number)
-         {
-            //First Pixel
-            GPIOB->BSRR = 0xFFFF0000; //Clear data bus
-            GPIOB->BSRR = ((color_buffer[2] & 0xF8) | (color_buffer[1] >> 5)); //byte_high;
-            GPIOA->BSRR = 0x00000100;//Set LCD_WR
-            GPIOA->BSRR = 0x01000000; //Clear LCD_WR
-
-            GPIOB->BSRR = 0xFFFF0000; //Clear data bus
-            GPIOB->BSRR = (((color_buffer[1] & 0x1C) << 3) | (color_buffer[0] >> 3)); //byte_low;
-            GPIOA->BSRR = 0x00000100;//Set LCD_WR
-            GPIOA->BSRR = 0x01000000; //Clear LCD_WR
-
-            //Second Pixel
-            GPIOB->BSRR = 0xFFFF0000; //Clear data bus
-            GPIOB->BSRR = ((color_buffer[5] & 0xF8) | (color_buffer[4] >> 5)); //byte_high;
-            GPIOA->BSRR = 0x00000100;//Set LCD_WR
-            GPIOA->BSRR = 0x01000000; ////Clear LCD_WR
-
-            GPIOB->BSRR = 0xFFFF0000; //Clear data bus
-            GPIOB->BSRR = (((color_buffer[4] & 0x1C) << 3) | (color_buffer[3] >> 3)); //byte_low;
-            GPIOA->BSRR = 0x00000100;//Set LCD_WR
-            GPIOA->BSRR = 0x01000000; ////Clear LCD_WR
-
-            color_number = 0;
-         }
-         
-         current_byte--;
+   //Select LCD
+   lcd_select();
 
-      }
+   lcd_print_string_line(tmp_string, x, y, &jet_font[0][0], LCD_FONT_HEIGHT, jet_font_metrics);
 
-      current_byte = 512;
+   //Deselect LCD
+   gpio_pin_set(LCD_CS);
+}
 
-      //Burn through the CRC bits and wait until SD card sends data valid token
-      spi_receive_byte(0xFF);
-      spi_receive_byte(0xFF);
 
-      while(SD_CMD17_TOKEN != spi_receive_byte(0xFF)) {} //CMD17 token is the same as CMD18, 0xFE
+/*!
+* @brief Display a given string from a 2-bit bitmap
+* @param[in] tmp_string Message to be displayed
+* @param[in] x
+* @param[in] y
+* @param[in] font_color
+* @param[in] background_color
+* @return NONE
+*
+* @note This is specifically for small font
+*/
+void
+lcd_print_string_small(char *tmp_string, uint16_t x, uint16_t y, uint16_t font_color, uint16_t background_color)
+{
+   //Record instead of drawing while a display list is open
+   if(lcd_display_list_add_text(lcd_primitive_string_small, tmp_string, x, y, font_color, background_color, 0))
+   {
+      return;
    }
-   
-   //The sd card must return an entire block. Flush the unused bytes from the last block
-   sd_stop_transmission();
+
+   //Four-color palette for anti-aliased font
+   lcd_load_expansion_table(font_color, background_color);
+
+   //Select LCD
+   lcd_select();
+
+   lcd_print_string_line(tmp_string, x, y, &jet_font_small[0][0], LCD_FONT_SMALL_HEIGHT, jet_font_small_metrics);
+
+   //Deselect LCD
+   gpio_pin_set(LCD_CS);
 }
 
 
 /*!
-* @brief Displays a simple background of small squares to the LCD
-* @param[in] NONE
+* @brief Display a string without a background. Anti-aliased edges are blended with whatever
+*        is under each pixel, e.g. a caption over a photo
+* @param[in] tmp_string Message to be displayed
+* @param[in] x
+* @param[in] y
+* @param[in] font_color
 * @return NONE
+*
+* @note This is specifically for medium font
+* @note Inside a display list, an SD image recorded before the string is composited with it row
+*       by row and each pixel is sent once, see lcd_display_list_flush(). Pixels the list does
+*       not cover are read back from GRAM first
 */
 void
-lcd_background_squares(void)
+lcd_print_string_over(char *tmp_string, uint16_t x, uint16_t y, uint16_t font_color)
 {
-   //blank blue screen
-   lcd_draw_rectangle(0x0000, 0, 0, 320, 480);
-   
-   //Init square color
-   uint16_t square_color = 0x07E0;
-   
-   //Put squares all over screen
-   for(uint16_t row = 0; row < 470; row += 15)
-   {
-      square_color -= 1;
-      
-      for(uint16_t column = 0; column < 320; column += 15)
-      {
-         lcd_draw_rectangle(square_color, column, row, (column + 10), (row + 10));
-      }
-   }
+   lcd_display_list_begin();
+   lcd_display_list_add_text(lcd_primitive_string, tmp_string, x, y, font_color, 0, 1);
+   lcd_display_list_end();
 }
 
 
 /*!
-* @brief Display a given string from a 2-bit bitmap font
+* @brief Display a string without a background, see lcd_print_string_over()
 * @param[in] tmp_string Message to be displayed
 * @param[in] x
 * @param[in] y
 * @param[in] font_color
+* @return NONE
+*
+* @note This is specifically for small font
+*/
+void
+lcd_print_string_small_over(char *tmp_string, uint16_t x, uint16_t y, uint16_t font_color)
+{
+   lcd_display_list_begin();
+   lcd_display_list_add_text(lcd_primitive_string_small, tmp_string, x, y, font_color, 0, 1);
+   lcd_display_list_end();
+}
+
+
+/*!
+* @brief Display a given string from a 2-bit bitmap
+* @param[in] tmp_bmp A 2-bit bitmap stored on internal FLASH
+* @param[in] x
+* @param[in] y
+* @param[in] main_color
 * @param[in] background_color
 * @return NONE
 *
-* @note This is specifically for medium font
 */
 void
-lcd_print_string(char *tmp_string, uint16_t x, uint16_t y, uint16_t font_color, uint16_t background_color)
+lcd_send_bitmap(const uint8_t *tmp_bmp, uint16_t x, uint16_t y, uint16_t main_color, uint16_t background_color)
 {
-   uint8_t bit_mask_table[4] = {0xC0, 0x30, 0x0C, 0x03};
-   uint16_t pixel_value = 0;
-   uint16_t color_table[4] = {0};
+   //Record instead of drawing while a display list is open
+   if(lcd_display_list_add_bitmap(tmp_bmp, x, y, main_color, background_color))
+   {
+      return;
+   }
 
-   //Create a four-color color palette for anti-aliased font
-   lcd_get_font_color_table(color_table, font_color, background_color);
+   //Four-color palette for anti-aliased bitmap
+   lcd_load_expansion_table(main_color, background_color);
 
    //Select LCD
-   gpio_clear(LCD_CS);
+   lcd_select();
+
+   //Put LCD in command mode
+   gpio_pin_clear(LCD_RS);
+
+   uint16_t bitmap_dimensions[2] = {0};
 
-   //Loop through string one char at a time
-   for(uint8_t current_char = 0; current_char < strlen(tmp_string); current_char++)
+   //Only print a bitmap if a bitmap was initialized
+   if(NULL != tmp_bmp)
    {
-      //Put LCD in command mode
-      gpio_clear(LCD_RS); //LCD_RS=0;
+      lcd_parse_local_bitmap(tmp_bmp, bitmap_dimensions);
 
       //Set starting screen address
-      lcd_set_window_address(x, y, x + 15, y + 20);
+      lcd_set_window_address(x, y, (x + bitmap_dimensions[0] - 1), y + bitmap_dimensions[1]);
+      lcd_add_pixels_pushed((uint32_t)bitmap_dimensions[0] * bitmap_dimensions[1]);
 
       //Put LCD in data mode
-      gpio_set(LCD_RS); //LCD_RS=1;
+      gpio_pin_set(LCD_RS);
 
-      //Loop through bitmap. @note Font is two bits per pixel
-      for(uint8_t current_byte = 0; current_byte < ((16*20*2) / 8); current_byte++)    //width = 16, height = 20, 2 bits/pixel, 8 bits/byte
+      //FORMULA: ((Length x Width x 2 bits_per_pixel) / 8bits_per_byte) + offset
+      uint16_t bitmap_size = ((((bitmap_dimensions[0]*bitmap_dimensions[1])*2) / 8) + BITMAPS_LOCAL_BMP_OFFSET);
+
+      uint16_t pixel_buffer[LCD_EXPANSION_CHUNK_BYTES * 4];
+
+      //Expand the bitmap a chunk at a time. @note Bitmap is two bits per pixel
+      for(uint16_t current_byte = BITMAPS_LOCAL_BMP_OFFSET; current_byte < bitmap_size; current_byte += LCD_EXPANSION_CHUNK_BYTES)
       {
-         for(uint8_t current_pixel = 0; current_pixel < 4; current_pixel++)
+         uint16_t chunk_bytes = bitmap_size - current_byte;
+
+         if(LCD_EXPANSION_CHUNK_BYTES < chunk_bytes)
+         {
+            chunk_bytes = LCD_EXPANSION_CHUNK_BYTES;
+         }
+
+         lcd_expand_2bpp(&tmp_bmp[current_byte], chunk_bytes, pixel_buffer);
+
+         for(uint16_t current_pixel = 0; current_pixel < (chunk_bytes * 4); current_pixel++)
          {
-            pixel_value = color_table[color_table_map[((jet_font[tmp_string[current_char] - 32][current_byte]) & bit_mask_table[current_pixel])]];
+            uint16_t pixel_value = pixel_buffer[current_pixel];
 
             //Send pixel to LCD
-            GPIOB->BSRR = 0xFFFF0000; //Clear data bus
-            GPIOB->BSRR = (uint8_t)(pixel_value >> 8);
-            GPIOA->BSRR = 0x00000100;//Set LCD_WR
-            GPIOA->BSRR = 0x01000000; //Clear LCD_WR
-            GPIOB->BSRR = 0xFFFF0000; //Clear data bus
-            GPIOB->BSRR = (uint8_t)(pixel_value & 0xFF);
-            GPIOA->BSRR = 0x00000100;//Set LCD_WR
-            GPIOA->BSRR = 0x01000000; //Clear LCD_WR
+            lcd_bus_write(pixel_value >> 8);
+            lcd_bus_write(pixel_value & 0xFF);
          }
       }
+   }
 
-      //Move to next character position and leave space in between each character
-      if(tmp_string[current_char] == '\'')
-      {
-         x += 7;
-      }
+   //Deselect LCD
+   gpio_pin_set(LCD_CS);
+}
 
-      else
-      {
-        x += 13;
-      }
 
-    }
+/*!
+* @brief Builds the 2bpp to RGB565 expansion table for a font/background pair
+* @param[in] font_color Main color, drawn for pixel code 0
+* @param[in] background_color Drawn for pixel code 1. Codes 2 and 3 are the anti-aliased blends
+* @return NONE
+*
+* @note The table is kept until the colors change, so repeated calls with the same
+*       pair cost one comparison. Each nibble entry holds two pixels so a full rebuild
+*       is only 16 entries.
+*/
+void
+lcd_load_expansion_table(uint16_t font_color, uint16_t background_color)
+{
+   if(expansion_table_loaded && (font_color == expansion_font_color) && (background_color == expansion_background_color))
+   {
+      return;
+   }
+
+   uint16_t color_table[4] = {0};
+
+   //Create a four-color color palette for anti-aliased font
+   lcd_get_font_color_table(color_table, font_color, background_color);
+
+   for(uint8_t nibble = 0; nibble < 16; nibble++)
+   {
+      expansion_table[nibble][0] = color_table[nibble >> 2];
+      expansion_table[nibble][1] = color_table[nibble & 0x03];
+   }
+
+   expansion_font_color = font_color;
+   expansion_background_color = background_color;
+   expansion_table_loaded = 1;
+}
+
+
+/*!
+* @brief Expands 2bpp source bytes into RGB565 pixels with the current expansion table
+* @param[in] tmp_source 2bpp data, leftmost pixel in the two most significant bits
+* @param[in] source_bytes
+* @param[in] tmp_pixels Receives four pixels per source byte
+* @return NONE
+*
+* @warning lcd_load_expansion_table() must be called first
+*/
+void
+lcd_expand_2bpp(const uint8_t *tmp_source, uint16_t source_bytes, uint16_t *tmp_pixels)
+{
+   for(uint16_t current_byte = 0; current_byte < source_bytes; current_byte++)
+   {
+      const uint16_t *high_pixels = expansion_table[tmp_source[current_byte] >> 4];
+      const uint16_t *low_pixels = expansion_table[tmp_source[current_byte] & 0x0F];
+
+      tmp_pixels[0] = high_pixels[0];
+      tmp_pixels[1] = high_pixels[1];
+      tmp_pixels[2] = low_pixels[0];
+      tmp_pixels[3] = low_pixels[1];
+      tmp_pixels += 4;
+   }
+}
+
+
+/*!
+* @brief Width of a string in the small font, as drawn by lcd_print_string_small()
+* @param[in] tmp_string
+* @return Width in pixels, not clipped to the screen
+*/
+uint16_t
+lcd_get_string_width_small(const char *tmp_string)
+{
+   return(lcd_get_string_width(tmp_string, jet_font_small_metrics));
+}
+
+
+/*!
+* @brief Number of pixels written to the LCD since power up
+* @param[in] NONE
+* @return pixels_pushed
+*
+* @note Wraps after 2^32 pixels, take differences between two reads
+*/
+uint32_t
+lcd_get_pixels_pushed(void)
+{
+   return(pixels_pushed);
+}
+
+
+/*!
+* @brief Count pixels written to GRAM by drawing code outside this file
+* @param[in] tmp_pixels
+* @return NONE
+*/
+void
+lcd_add_pixels_pushed(uint32_t tmp_pixels)
+{
+   pixels_pushed += tmp_pixels;
+}
+
+
+/*!
+* @brief Split the screen into a fixed top area, a scroll area and a fixed bottom area, and
+*        put the scroll area back at its first line
+* @param[in] top_fixed_rows Rows above the scroll area
+* @param[in] tmp_scroll_rows Height of the scroll area, the rest of the screen is the bottom area
+* @return NONE
+*
+* @note The panel only changes which GRAM line it shows at the top of the scroll area, nothing
+*       is redrawn. Since the scroll area starts unscrolled, the screen does not change either.
+*/
+void
+lcd_scroll_define(uint16_t top_fixed_rows, uint16_t tmp_scroll_rows)
+{
+   if((0 == tmp_scroll_rows) || (LCD_HEIGHT < (top_fixed_rows + tmp_scroll_rows)))
+   {
+      return;
+   }
+
+   uint16_t bottom_fixed_rows = LCD_HEIGHT - top_fixed_rows - tmp_scroll_rows;
+
+   scroll_top_rows = top_fixed_rows;
+   scroll_rows = tmp_scroll_rows;
+   scroll_offset = 0;
+
+   //Select LCD
+   lcd_select();
+
+   lcd_send_command(LCD_CMD_VERTICAL_SCROLL_DEFINITION);
+   lcd_send_data(top_fixed_rows >> 8);
+   lcd_send_data(top_fixed_rows & 0xFF);
+   lcd_send_data(tmp_scroll_rows >> 8);
+   lcd_send_data(tmp_scroll_rows & 0xFF);
+   lcd_send_data(bottom_fixed_rows >> 8);
+   lcd_send_data(bottom_fixed_rows & 0xFF);
+
+   lcd_send_command(LCD_CMD_VERTICAL_SCROLL_START_ADDRESS);
+   lcd_send_data(top_fixed_rows >> 8);
+   lcd_send_data(top_fixed_rows & 0xFF);
 
    //Deselect LCD
-   gpio_set(LCD_CS);
+   gpio_pin_set(LCD_CS);
 }
 
 
+/*!
+* @brief Move everything in the scroll area up or down. Lines that leave one edge come back in
+*        at the other, the caller redraws that strip
+* @param[in] tmp_lines Positive moves the content up and exposes a strip at the bottom,
+*                      negative moves it down and exposes a strip at the top
+* @return NONE
+*
+* @warning Only display lists know where a screen row of the scroll area sits in GRAM. While the
+*          area is scrolled, draw into it between lcd_display_list_begin() and lcd_display_list_end()
+*/
+void
+lcd_scroll_lines(int16_t tmp_lines)
+{
+   int32_t new_offset = ((int32_t)scroll_offset + tmp_lines) % (int32_t)scroll_rows;
+
+   if(0 > new_offset)
+   {
+      new_offset += scroll_rows;
+   }
+
+   scroll_offset = (uint16_t)new_offset;
+
+   //The panel takes the GRAM line shown at the top of the scroll area
+   uint16_t start_line = scroll_top_rows + scroll_offset;
+
+   //Select LCD
+   lcd_select();
+
+   lcd_send_command(LCD_CMD_VERTICAL_SCROLL_START_ADDRESS);
+   lcd_send_data(start_line >> 8);
+   lcd_send_data(start_line & 0xFF);
+
+   //Deselect LCD
+   gpio_pin_set(LCD_CS);
+}
+
 
 /*!
-* @brief Display a given string from a 2-bit bitmap
-* @param[in] tmp_string Message to be displayed
-* @param[in] x
-* @param[in] y
-* @param[in] font_color
-* @param[in] background_color
+* @brief Make the whole screen one unscrolled area again, which is how the rest of the GUI
+*        expects to find the panel
+* @param[in] NONE
 * @return NONE
 *
-* @note This is specifically for small font
+* @note The scrolled content jumps back to where it sits in GRAM, so redraw it afterwards
+*/
+void
+lcd_scroll_reset(void)
+{
+   //Nothing to send if the panel is not scrolled
+   if((0 == scroll_top_rows) && (LCD_HEIGHT == scroll_rows) && (0 == scroll_offset))
+   {
+      return;
+   }
+
+   lcd_scroll_define(0, LCD_HEIGHT);
+}
+
+
+/*!
+* @brief Read a rectangle of GRAM back from the LCD
+* @param[in] x_in Initial X position
+* @param[in] y_in Initial Y position
+* @param[in] x_fin Final X position
+* @param[in] y_fin Final Y position
+* @param[out] tmp_pixels Room for (x_fin - x_in) * (y_fin - y_in) RGB565 pixels, row by row
+* @return NONE
+*
+* @note Positions are GRAM addresses, as for drawing outside a display list
+*/
+void
+lcd_read_region(uint16_t x_in, uint16_t y_in, uint16_t x_fin, uint16_t y_fin, uint16_t *tmp_pixels)
+{
+   //Select LCD
+   lcd_select();
+
+   lcd_read_start(x_in, y_in, x_fin, y_fin);
+   lcd_read_pixels(tmp_pixels, (uint32_t)(x_fin - x_in) * (y_fin - y_in));
+   lcd_read_end();
+
+   //Deselect LCD
+   gpio_pin_set(LCD_CS);
+}
+
+
+/*!
+* @brief Keep the pixels a popup is about to cover so lcd_restore_under() can put them back
+*        without going to the SD card
+* @param[in] x_in Initial X position
+* @param[in] y_in Initial Y position
+* @param[in] x_fin Final X position
+* @param[in] y_fin Final Y position
+* @param[in] tmp_bytes Encoded size the caller knows the area to take. Nothing is read back when
+*                      it is over LCD_SAVE_UNDER_BYTES
+* @return 1 if they were saved, 0 if they did not fit in LCD_SAVE_UNDER_BYTES. Nothing is held then
+*
+* @note Pixels are compressed with the ops of compressed SD images as they are read, so UI art
+*       and photos with smooth gradients take a fraction of their raw size. Only one area is
+*       held, saving another replaces it.
+* @note They are kept in the glyph cache's RAM, so text is expanded glyph by glyph until they
+*       are put back or discarded
 */
-void
-lcd_print_string_small(char *tmp_string, uint16_t x, uint16_t y, uint16_t font_color, uint16_t background_color)
+uint8_t
+lcd_save_under(uint16_t x_in, uint16_t y_in, uint16_t x_fin, uint16_t y_fin, uint16_t tmp_bytes)
 {
-   uint8_t bit_mask_table[4] = {0xC0, 0x30, 0x0C, 0x03};
-   uint16_t color_table[4] = {0};
+   t_lcd_rgb565q_encoder encoder;
+   uint16_t read_pixels[LCD_READ_CHUNK_PIXELS];
+   uint16_t width = x_fin - x_in;
+   uint16_t row = y_in;
 
-   //Create a four-color color palette for anti-aliased font
-   lcd_get_font_color_table(color_table, font_color, background_color);
+   //Reading back an area that cannot fit costs more than the redraw it was meant to spare
+   if(LCD_SAVE_UNDER_BYTES < tmp_bytes)
+   {
+      lcd_discard_under();
+      return(0);
+   }
 
-   //Select LCD
-   gpio_clear(LCD_CS);
+   //Anything still in a display list is not in GRAM yet
+   lcd_display_list_flush();
 
-   //Loop through string one char at a time
-   for(uint8_t current_char = 0; current_char < strlen(tmp_string); current_char++)
-   {
-      //Put LCD in command mode
-      gpio_clear(LCD_RS); //LCD_RS=0;
+   memset(&encoder, 0, sizeof(encoder));
+   encoder.data = lcd_glyph_cache_lend();
+   encoder.capacity = LCD_SAVE_UNDER_BYTES;
+   save_under.is_saved = 0;
 
-      //Set starting screen address
-      lcd_set_window_address(x, y, x + 15, y + 20);
+   //Select LCD
+   lcd_select();
 
-      //Put LCD in data mode
-      gpio_set(LCD_RS); //LCD_RS=1;
+   while((row < y_fin) && !encoder.is_full)
+   {
+      //Rows of a scrolled area are not where they appear on the screen
+      uint16_t chunk_rows = y_fin - row;
+      uint16_t gram_row = lcd_scroll_map_row(row, &chunk_rows);
 
-      //Loop through bitmap. @note Font is two bits per pixel
-      for(uint8_t current_byte = 0; current_byte < ((16*16*2)/8);current_byte++) //width = 16, height = 16, 2 bits/pixel, 8 bits/byte
-      {
-         for(uint8_t current_pixel = 0; current_pixel < 4; current_pixel++)
-         {
-            uint16_t pixel_value = color_table[color_table_map[((jet_font_small[tmp_string[current_char] - 32][current_byte]) & bit_mask_table[current_pixel])]];
+      uint32_t pixels_left = (uint32_t)width * chunk_rows;
 
-            //Send pixel to LCD
-            GPIOB->BSRR = 0xFFFF0000; //Clear data bus
-            GPIOB->BSRR = (uint8_t)(pixel_value >> 8);
-            GPIOA->BSRR = 0x00000100;//Set LCD_WR
-            GPIOA->BSRR = 0x01000000; //Clear LCD_WR
-            GPIOB->BSRR = 0xFFFF0000; //Clear data bus
-            GPIOB->BSRR = (uint8_t)(pixel_value & 0xFF);
-            GPIOA->BSRR = 0x00000100;//Set LCD_WR
-            GPIOA->BSRR = 0x01000000; //Clear LCD_WR
-         }
-      }
+      lcd_read_start(x_in, gram_row, x_fin, gram_row + chunk_rows);
 
-      //Move to next character position and leave space in between each character
-      if((tmp_string[current_char] == '\'') || (tmp_string[current_char] == '.'))
+      //Stop reading as soon as the buffer is full
+      while((0 < pixels_left) && !encoder.is_full)
       {
-         x += 5;
-      }
+         uint16_t read_count = (LCD_READ_CHUNK_PIXELS < pixels_left) ? LCD_READ_CHUNK_PIXELS : pixels_left;
 
-      else if(tmp_string[current_char] == ':')
-      {
-         x += 8;
+         lcd_read_pixels(read_pixels, read_count);
+         lcd_encode_rgb565q(read_pixels, read_count, &encoder);
+         pixels_left -= read_count;
       }
 
-      else
-      {
-        x += 11;
-      }
+      lcd_read_end();
 
-    }
+      //lcd_restore_under() sets a new window here, the last run must not carry over
+      lcd_encode_rgb565q_end(&encoder);
+      row += chunk_rows;
+   }
 
    //Deselect LCD
-   gpio_set(LCD_CS);
-}
+   gpio_pin_set(LCD_CS);
 
+   if(encoder.is_full)
+   {
+      lcd_glyph_cache_reclaim();
+      return(0);
+   }
 
+   save_under.x_initial = x_in;
+   save_under.y_initial = y_in;
+   save_under.x_final = x_fin;
+   save_under.y_final = y_fin;
+   save_under.data = encoder.data;
+   save_under.bytes = encoder.bytes;
+   save_under.is_saved = 1;
+
+   return(1);
+}
 
 
 /*!
-* @brief Display a given string from a 2-bit bitmap
-* @param[in] tmp_bmp A 2-bit bitmap stored on internal FLASH
-* @param[in] x
-* @param[in] y
-* @param[in] main_color
-* @param[in] background_color
-* @return NONE
+* @brief Put back the pixels kept by lcd_save_under() and let them go
+* @param[in] NONE
+* @return 1 if they were put back, 0 if nothing was held
 *
+* @warning The panel must not have been scrolled since they were saved
 */
-void
-lcd_send_bitmap(const uint8_t *tmp_bmp, uint16_t x, uint16_t y, uint16_t main_color, uint16_t background_color)
+uint8_t
+lcd_restore_under(void)
 {
-   uint16_t color_table[4] = {0};
+   t_lcd_rgb565q_decoder decoder;
+   uint16_t width = save_under.x_final - save_under.x_initial;
+   uint16_t row = save_under.y_initial;
+   uint16_t data_offset = 0;
 
-   //Create a four-color color palette for anti-aliased font
-   lcd_get_font_color_table(color_table, main_color, background_color);
+   if(!save_under.is_saved)
+   {
+      return(0);
+   }
 
-   //Select LCD
-   gpio_clear(LCD_CS);
+   //Keep the drawing order of anything recorded before
+   lcd_display_list_flush();
 
-   //Put LCD in command mode
-   gpio_clear(LCD_RS);
+   memset(&decoder, 0, sizeof(decoder));
+   decoder.image_width = width;
+   decoder.column_final = width;
 
-   uint16_t bitmap_dimensions[2] = {0};
-   lcd_parse_local_bitmap(tmp_bmp, bitmap_dimensions);
+   //Select LCD
+   lcd_select();
 
-   //Only print a bitmap if a bitmap was initialized
-   if(NULL != tmp_bmp)
+   while(row < save_under.y_final)
    {
-      //Set starting screen address
-      lcd_set_window_address(x, y, (x + bitmap_dimensions[0] - 1), y + bitmap_dimensions[1]);
+      uint16_t chunk_rows = save_under.y_final - row;
+      uint16_t gram_row = lcd_scroll_map_row(row, &chunk_rows);
 
-      //Put LCD in data mode
-      gpio_set(LCD_RS);
+      lcd_set_window_address(save_under.x_initial, gram_row, save_under.x_final - 1, gram_row + chunk_rows - 1);
+      gpio_pin_set(LCD_RS);
 
-      //FORMULA: ((Length x Width x 2 bits_per_pixel) / 8bits_per_byte) + offset
-      uint16_t bitmap_size = ((((bitmap_dimensions[0]*bitmap_dimensions[1])*2) / 8) + BITMAPS_LOCAL_BMP_OFFSET);
+      decoder.pixels_left = (uint32_t)width * chunk_rows;
+      lcd_add_pixels_pushed(decoder.pixels_left);
+      data_offset += lcd_drain_rgb565q(&save_under.data[data_offset], save_under.bytes - data_offset, &decoder);
+      row += chunk_rows;
+   }
 
-      uint8_t bit_mask_table[4] = {0xC0, 0x30, 0x0C, 0x03};
+   //Deselect LCD
+   gpio_pin_set(LCD_CS);
 
-      //Loop through bitmap. @note Bitmap is two bits per pixel
-      for(uint16_t current_byte = BITMAPS_LOCAL_BMP_OFFSET; current_byte < bitmap_size; current_byte++)
-      {
-         for(uint8_t current_pixel = 0; current_pixel < 4; current_pixel++)
-         {
-            uint16_t pixel_value = color_table[color_table_map[(tmp_bmp[current_byte]) & bit_mask_table[current_pixel]]];
+   save_under.is_saved = 0;
+   lcd_glyph_cache_reclaim();
 
-            //Send pixel to LCD
-            GPIOB->BSRR = 0xFFFF0000; //Clear data bus
-            GPIOB->BSRR = (uint8_t)(pixel_value >> 8);
-            GPIOA->BSRR = 0x00000100;//Set LCD_WR
-            GPIOA->BSRR = 0x01000000; //Clear LCD_WR
-            GPIOB->BSRR = 0xFFFF0000; //Clear data bus
-            GPIOB->BSRR = (uint8_t)(pixel_value & 0xFF);
-            GPIOA->BSRR = 0x00000100;//Set LCD_WR
-            GPIOA->BSRR = 0x01000000; //Clear LCD_WR
-         }
-      }
+   return(1);
+}
+
+
+/*!
+* @brief Forget the pixels kept by lcd_save_under(), e.g. once the screen under them is redrawn
+* @param[in] NONE
+* @return NONE
+*/
+void
+lcd_discard_under(void)
+{
+   if(save_under.is_saved)
+   {
+      save_under.is_saved = 0;
+      lcd_glyph_cache_reclaim();
    }
+}
 
-   //Deselect LCD
-   gpio_set(LCD_CS);
+
+/*!
+* @brief Parse the LOCAL bitmap for width and height
+* @param[in] tmp_bitmap Bitmap to be read
+* @param[in] tmp_size Two member array for holding width and height values
+* @return  NONE
+*
+* @warning This is meant only for bitmaps stored on local FLASH, it
+*          is not intended for actual .BMPs on the SD card
+*/
+void
+lcd_parse_local_bitmap(const uint8_t *tmp_bitmap, uint16_t *tmp_dimensions)
+{
+   tmp_dimensions[0] = tmp_bitmap[0];  //Width high byte
+   tmp_dimensions[0] |= tmp_bitmap[1]; //      low byte
+
+   tmp_dimensions[1] = tmp_bitmap[2];  //Height high byte
+   tmp_dimensions[1] |= tmp_bitmap[3]; //       low byte
 }
 
 
@@ -567,10 +871,10 @@ void
 lcd_send_command(uint8_t tmp_command)
 {
    //Set LCD to command mode, RS = 0
-   gpio_clear(LCD_RS);
+   gpio_pin_clear(LCD_RS);
    
    //Set data bus to command byte
-   lcd_write_to_bus(tmp_command);
+   lcd_bus_write(tmp_command);
 }
 
 
@@ -584,28 +888,10 @@ void
 lcd_send_data(uint8_t tmp_data)
 {
    //Set LCD to command mode, RS = 1
-   gpio_set(LCD_RS);
+   gpio_pin_set(LCD_RS);
    
    //Set data bus to command byte
-   lcd_write_to_bus(tmp_data);
-}
-
-
-/*!
-* @brief Sets the bus to the desired byte and clocks it into the LCD
-* @param[in] tmp_byte
-* @return NONE
-*/
-void
-lcd_write_to_bus(uint8_t tmp_byte)
-{
-   GPIOB->BSRR = (0xFFFF << 16); //Clear lcd data bus
-   
-   GPIOB->BSRR = (tmp_byte); //write selected byte to DB0 - DB7
-   
-   //Give WR line a clock pulse. This can be replaced with GPIOx->BSRR for faster toggle rate
-   GPIOA->BSRR = 0x0100;
-   GPIOA->BSRR = 0x01000000;
+   lcd_bus_write(tmp_data);
 }
 
 
@@ -651,11 +937,11 @@ void
 lcd_reset(void)
 {
    //Reset LCD. The delays are necessary 
-   gpio_set(LCD_REST);
+   gpio_pin_set(LCD_REST);
    timers_delay(50); 
-   gpio_clear(LCD_REST);
+   gpio_pin_clear(LCD_REST);
    timers_delay(150);
-   gpio_set(LCD_REST);
+   gpio_pin_set(LCD_REST);
    timers_delay(150);
 }
 
@@ -914,67 +1200,296 @@ lcd_gpio_init(void)
   lcd_backlight_disable(); //Turn off screen so it doesn't display garbage while initializing
 
   //Set all control lines to high initially
-  gpio_set(LCD_REST);
-  gpio_set(LCD_CS);
-  gpio_set(LCD_RS);
-  gpio_set(LCD_WR);
-  gpio_set(LCD_RD);
+  gpio_pin_set(LCD_REST);
+  gpio_pin_set(LCD_CS);
+  gpio_pin_set(LCD_RS);
+  gpio_pin_set(LCD_WR);
+  gpio_pin_set(LCD_RD);
+}
+
+
+/*!
+* @brief Set the window to read, send the memory read command and hand the data bus to the LCD
+* @param[in] x_in Initial X position
+* @param[in] y_in Initial Y position
+* @param[in] x_fin Final X position
+* @param[in] y_fin Final Y position
+* @return NONE
+*
+* @warning LCD must be selected. lcd_read_end() gives the bus back
+*/
+void
+lcd_read_start(uint16_t x_in, uint16_t y_in, uint16_t x_fin, uint16_t y_fin)
+{
+   lcd_set_window_address(x_in, y_in, x_fin - 1, y_fin - 1);
+   lcd_send_command(LCD_CMD_MEMORY_READ);
+
+   //Put LCD in data mode and stop driving DB0-DB7
+   gpio_pin_set(LCD_RS);
+   GPIOB->MODER &= ~LCD_DATA_BUS_MODER_MASK;
+
+   lcd_read_from_bus(); //Dummy byte
+}
+
+
+/*!
+* @brief Read the next pixels of a memory read started by lcd_read_start()
+* @param[out] tmp_pixels RGB565
+* @param[in] tmp_count
+* @return NONE
+*/
+void
+lcd_read_pixels(uint16_t *tmp_pixels, uint32_t tmp_count)
+{
+   for(uint32_t current_pixel = 0; current_pixel < tmp_count; current_pixel++)
+   {
+      uint8_t red = lcd_read_from_bus();
+      uint8_t green = lcd_read_from_bus();
+      uint8_t blue = lcd_read_from_bus();
+
+      tmp_pixels[current_pixel] = ((red & 0xF8) << 8) | ((green & 0xFC) << 3) | (blue >> 3);
+   }
 }
 
 
+/*!
+* @brief Drive the data bus from the MCU again after a memory read
+* @param[in] NONE
+* @return NONE
+*/
+void
+lcd_read_end(void)
+{
+   GPIOB->MODER |= LCD_DATA_BUS_MODER_OUTPUT;
+}
+
 
 /*!
-* @brief Parse the .BMP file for offset and skip to image
+* @brief Strobe LCD_RD and read one byte off the data bus
 * @param[in] NONE
-* @return  current_byte Count so the main program can keep track of how many bytes have been
-*                       sent since the file began
+* @return Byte driven by the LCD
 *
-* @note This assumes the sd card has been given the read_multiple_blocks command
-*       and has subsequently returned a data valid token (0xFE).
-*       It should be called right before the first byte of the BMP file is received
-*       
+* @warning LCD_RD low only drives the bus while DB0-DB7 are inputs, see lcd_read_start()
 */
 uint8_t
-lcd_skip_bmp_header(void)
+lcd_read_from_bus(void)
 {
-   uint8_t offset_value = 0 ; //The first byte after the header ends and the real image data begins
-   uint8_t current_byte = 0;
-   
-   //Ignore the first 10 bytes. Offset byte is at location 0x0A
-   for(current_byte = 0; current_byte < LCD_BMP_OFFSET_LOCATION; current_byte++)
+   gpio_pin_clear(LCD_RD); //The LCD starts driving the bus
+   timers_delay_mini(LCD_GRAM_READ_DELAY);
+
+   uint8_t tmp_byte = GPIOB->IDR & 0xFF;
+
+   gpio_pin_set(LCD_RD);
+
+   return(tmp_byte);
+}
+
+
+/*!
+* @brief Lays out a whole string and streams it through a single LCD window, one row at a time
+* @param[in] tmp_string Message to be displayed
+* @param[in] x
+* @param[in] y
+* @param[in] tmp_font First glyph of the font. Glyphs are LCD_FONT_CELL_WIDTH pixels wide,
+*                     2 bits per pixel, starting at ' '
+* @param[in] glyph_height Rows per glyph
+* @param[in] tmp_metrics Glyph metrics of the font, see font_metrics.c
+* @return NONE
+*
+* @note Glyph cells are wider than the character spacing, so neighbouring cells overlap and the
+*       later character covers the tail of the earlier one. Only the first "advance" columns of
+*       each character are visible, except for the last character which shows its full cell.
+*       Each row starts out as background and only the ink box of each glyph is written over it,
+*       rows without ink in any glyph are sent as background straight away.
+* @warning LCD_CS must already be low and lcd_load_expansion_table() must hold the palette
+*/
+void
+lcd_print_string_line(const char *tmp_string, uint16_t x, uint16_t y, const uint8_t *tmp_font,
+                      uint8_t glyph_height, const t_font_glyph_metrics *tmp_metrics)
+{
+   size_t string_length = strlen(tmp_string);
+   uint16_t glyph_bytes = glyph_height * (LCD_FONT_CELL_WIDTH / 4); //4 pixels per byte
+   uint16_t line_buffer[LCD_WIDTH];
+
+   if((0 == string_length) || (LCD_WIDTH <= x))
+   {
+      return;
+   }
+
+   //Total width of the string, clipped to the right edge of the screen
+   uint16_t string_width = lcd_get_string_width(tmp_string, tmp_metrics);
+
+   if(string_width > (LCD_WIDTH - x))
+   {
+      string_width = LCD_WIDTH - x;
+   }
+
+   //Put LCD in command mode
+   gpio_pin_clear(LCD_RS);
+
+   //One window for the whole string
+   lcd_set_window_address(x, y, x + string_width - 1, y + glyph_height - 1);
+   lcd_add_pixels_pushed((uint32_t)string_width * glyph_height);
+
+   //Put LCD in data mode
+   gpio_pin_set(LCD_RS);
+
+   //Lay out every visible character once, not once per row. The narrowest advance is 5 pixels
+   uint16_t color_table[4] = {0};
+   const uint16_t *glyph_pixels[LCD_WIDTH / 4] = {0};
+   uint16_t glyph_columns[LCD_WIDTH / 4] = {0};
+   uint8_t glyph_column_finals[LCD_WIDTH / 4] = {0};
+   size_t visible_chars = 0;
+   uint16_t column = 0;
+   uint8_t ink_y_initial = glyph_height;
+   uint8_t ink_y_final = 0;
+
+   lcd_get_font_color_table(color_table, expansion_font_color, expansion_background_color);
+   lcd_glyph_cache_start_pass();
+
+   while((visible_chars < string_length) && (column < string_width))
    {
-      offset_value = spi_receive_byte(0xFF); //spi_receive_byte(0xFF);
+      const t_font_glyph_metrics *p_metrics = &tmp_metrics[tmp_string[visible_chars] - 32];
+      uint16_t column_final = LCD_FONT_CELL_WIDTH;
+
+      if(visible_chars < (string_length - 1))
+      {
+         column_final = p_metrics->advance;
+      }
+
+      if(column_final > (string_width - column))
+      {
+         column_final = string_width - column;
+      }
 
+      //Blank glyphs only need the background
+      if(0 != p_metrics->ink_x_final)
+      {
+         glyph_pixels[visible_chars] = lcd_glyph_cache_get(tmp_font, glyph_height, tmp_string[visible_chars], p_metrics, color_table);
+         ink_y_initial = (p_metrics->ink_y_initial < ink_y_initial) ? p_metrics->ink_y_initial : ink_y_initial;
+         ink_y_final = (p_metrics->ink_y_final > ink_y_final) ? p_metrics->ink_y_final : ink_y_final;
+      }
+
+      glyph_columns[visible_chars] = column;
+      glyph_column_finals[visible_chars] = column_final;
+      column += p_metrics->advance;
+      visible_chars++;
    }
 
-   //Jump to the first image byte. Watch out, we are now at byte 0x0A after reaching the offset byte
-   while(current_byte < offset_value)
+   for(uint8_t row = 0; row < glyph_height; row++)
    {
-      spi_receive_byte(0xFF);
-      current_byte++;
+      //Start from the background, then write the ink of every character crossing this row
+      for(column = 0; column < string_width; column++)
+      {
+         line_buffer[column] = color_table[1];
+      }
+
+      for(size_t current_char = 0; (row >= ink_y_initial) && (row < ink_y_final) && (current_char < visible_chars); current_char++)
+      {
+         char current_glyph = tmp_string[current_char] - 32;
+
+         lcd_raster_glyph_row(&line_buffer[glyph_columns[current_char]], tmp_font + (current_glyph * glyph_bytes),
+                              glyph_pixels[current_char], &tmp_metrics[(uint8_t)current_glyph], row,
+                              glyph_column_finals[current_char], color_table);
+      }
+
+      //Stream the row to the LCD
+      for(column = 0; column < string_width; column++)
+      {
+         uint16_t pixel_value = line_buffer[column];
+
+         lcd_bus_write(pixel_value >> 8);
+         lcd_bus_write(pixel_value & 0xFF);
+      }
    }
-   
-   return(current_byte);
 }
 
 
 /*!
-* @brief Parse the LOCAL bitmap for width and height
-* @param[in] tmp_bitmap Bitmap to be read
-* @param[in] tmp_size Two member array for holding width and height values
-* @return  NONE
-*
-* @warning This is meant only for bitmaps stored on local FLASH, it
-*          is not intended for actual .BMPs on the SD card
+* @brief Width of a string, every character advances the next except the last, which ends at
+*        its advance or at its last column of ink, whichever is further
+* @param[in] tmp_string
+* @param[in] tmp_metrics Glyph metrics of the font, see font_metrics.c
+* @return Width in pixels, 0 for an empty string
+*/
+uint16_t
+lcd_get_string_width(const char *tmp_string, const t_font_glyph_metrics *tmp_metrics)
+{
+   size_t string_length = strlen(tmp_string);
+   uint16_t string_width = 0;
+
+   if(0 == string_length)
+   {
+      return(0);
+   }
+
+   for(size_t current_char = 0; current_char < (string_length - 1); current_char++)
+   {
+      string_width += tmp_metrics[tmp_string[current_char] - 32].advance;
+   }
+
+   const t_font_glyph_metrics *p_last = &tmp_metrics[tmp_string[string_length - 1] - 32];
+   string_width += (p_last->ink_x_final > p_last->advance) ? p_last->ink_x_final : p_last->advance;
+
+   return(string_width);
+}
+
+
+/*!
+* @brief Write the ink of one glyph row into a line that already holds the background color
+* @param[in] tmp_line Column 0 of the glyph cell
+* @param[in] tmp_glyph 2bpp cell of the glyph in the font
+* @param[in] tmp_glyph_pixels Ink box of the glyph expanded by the glyph cache, NULL to decode tmp_glyph
+* @param[in] tmp_metrics Metrics of the glyph
+* @param[in] row Row of the cell
+* @param[in] column_final Columns from here on belong to the next character or are clipped
+* @param[in] tmp_palette
+* @return NONE
 */
 void
-lcd_parse_local_bitmap(const uint8_t *tmp_bitmap, uint16_t *tmp_dimensions)
+lcd_raster_glyph_row(uint16_t *tmp_line, const uint8_t *tmp_glyph, const uint16_t *tmp_glyph_pixels,
+                     const t_font_glyph_metrics *tmp_metrics, uint8_t row, uint8_t column_final,
+                     const uint16_t *tmp_palette)
 {
-   tmp_dimensions[0] = tmp_bitmap[0];  //Width high byte
-   tmp_dimensions[0] |= tmp_bitmap[1]; //      low byte
+   uint8_t column = tmp_metrics->ink_x_initial;
 
-   tmp_dimensions[1] = tmp_bitmap[2];  //Height high byte
-   tmp_dimensions[1] |= tmp_bitmap[3]; //       low byte
+   if((row < tmp_metrics->ink_y_initial) || (row >= tmp_metrics->ink_y_final))
+   {
+      return;
+   }
+
+   if(column_final > tmp_metrics->ink_x_final)
+   {
+      column_final = tmp_metrics->ink_x_final;
+   }
+
+   if(column >= column_final)
+   {
+      return;
+   }
+
+   if(NULL != tmp_glyph_pixels)
+   {
+      uint8_t ink_width = tmp_metrics->ink_x_final - column;
+
+      //Ink rows are a handful of pixels, too short for a call to memcpy() to pay off
+      const uint16_t *p_pixels = &tmp_glyph_pixels[(row - tmp_metrics->ink_y_initial) * ink_width];
+
+      for(; column < column_final; column++)
+      {
+         tmp_line[column] = p_pixels[column - tmp_metrics->ink_x_initial];
+      }
+
+      return;
+   }
+
+   //Leftmost pixel in the top bits
+   const uint8_t *glyph_row = tmp_glyph + (row * (LCD_FONT_CELL_WIDTH / 4));
+
+   for(; column < column_final; column++)
+   {
+      tmp_line[column] = tmp_palette[(glyph_row[column >> 2] >> (6 - ((column & 0x03) << 1))) & 0x03];
+   }
 }
 
 
@@ -1029,7 +1544,41 @@ lcd_get_font_color_table(uint16_t *tmp_table, uint16_t tmp_font_color, uint16_t
    }
 }
 
+
+/*!
+* @brief Find the GRAM row shown at a screen row, taking the hardware scroll into account
+* @param[in] row Screen row
+* @param[in,out] tmp_rows Rows needed from row down. Reduced to the rows that stay in
+*                consecutive GRAM rows, since a scrolled area wraps around in GRAM
+* @return GRAM row
+*/
+uint16_t
+lcd_scroll_map_row(uint16_t row, uint16_t *tmp_rows)
+{
+   uint16_t scroll_end = scroll_top_rows + scroll_rows;
+   uint16_t contiguous_rows = 0;
+
+   if((row < scroll_top_rows) || (row >= scroll_end))
+   {
+      //Fixed areas are not moved. Stop where the next area starts
+      contiguous_rows = ((row < scroll_top_rows) ? scroll_top_rows : LCD_HEIGHT) - row;
+   }
+
+   else
+   {
+      row = scroll_top_rows + ((row - scroll_top_rows + scroll_offset) % scroll_rows);
+      contiguous_rows = scroll_end - row;
+   }
+
+   if(*tmp_rows > contiguous_rows)
+   {
+      *tmp_rows = contiguous_rows;
+   }
+
+   return(row);
+}
+
+
 #pragma GCC pop_options
 
 /* end of file */
-
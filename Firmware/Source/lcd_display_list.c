@@ -0,0 +1,1007 @@
+/** @file lcd_display_list.c
+*
+* @brief  This file records rectangles, bitmaps, strings and SD images instead of drawing them,
+*         then sends each pixel of the recorded screen area to the LCD once
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#include "lcd_display_list.h"
+#include "lcd_glyph_cache.h"
+
+
+/*
+****************************************************
+***** Private Types and Structure Definitions ******
+****************************************************
+*/
+typedef struct t_lcd_primitive_tag
+{
+   e_lcd_primitive type;
+   uint16_t x_initial; //Visible area clipped to the screen, final values are exclusive
+   uint16_t y_initial;
+   uint16_t x_final;
+   uint16_t y_final;
+   uint16_t palette[4]; //2bpp palette, rectangles only use [0]
+   uint8_t is_transparent; //Strings only. Pixel code 1 keeps what is under it, see lcd_print_string_over()
+
+   union
+   {
+      const uint8_t *bitmap;
+      uint16_t text_offset; //Into display_list_text
+      struct
+      {
+         uint32_t address;
+         uint16_t column; //Part of the image drawn, see lcd_stream_image_from_sd()
+         uint16_t row;
+         uint16_t width;
+      } sd_image;
+   } source;
+
+} t_lcd_primitive;
+
+
+//What is on top at each pixel of the row being built, see lcd_display_list_send_row()
+typedef enum e_lcd_coverage_tag
+{
+   lcd_coverage_none,       //Nothing recorded
+   lcd_coverage_list,       //Rectangle, bitmap or string, sent by lcd_display_list_send_rows()
+   lcd_coverage_image,      //SD image, sent by lcd_stream_image_from_sd() or in another image's pass
+   lcd_coverage_composited  //The SD image being composited, or text over it
+
+} e_lcd_coverage;
+
+
+//Window the display list rows are being written to
+typedef struct t_lcd_display_list_window_tag
+{
+   uint16_t x_initial;
+   uint16_t x_final;   //Exclusive
+   uint16_t next_row;  //GRAM row the LCD write pointer is at, LCD_HEIGHT if unknown
+   uint16_t last_row;
+
+} t_lcd_display_list_window;
+
+
+//SD image rows collected one at a time for lcd_display_list_composite_image()
+typedef struct t_lcd_composite_tag
+{
+   const t_lcd_primitive *image; //NULL while decoded pixels go to the LCD bus
+   uint16_t row;                 //Screen row being collected
+   uint16_t column;              //Pixels of it collected so far
+   uint8_t high_byte;            //First byte of an RGB565 pixel split across blocks
+   uint8_t has_high_byte;
+
+} t_lcd_composite;
+
+
+/*
+****************************************************
+************* File-Static Variables ****************
+****************************************************
+*/
+//Retained display list, see lcd_display_list_begin()
+static t_lcd_primitive display_list[LCD_DISPLAY_LIST_LENGTH] = {{lcd_primitive_rectangle}};
+static char display_list_text[LCD_DISPLAY_LIST_TEXT_BYTES] = {0};
+static uint8_t display_list_length = 0;
+static uint16_t display_list_text_length = 0;
+static uint8_t display_list_depth = 0; //Drawing calls are recorded while this is above 0
+
+//One screen row of the list being flushed, and what covers each of its pixels
+static uint16_t display_list_line[LCD_WIDTH] = {0};
+static uint8_t display_list_coverage[LCD_WIDTH] = {0};
+static uint8_t display_list_bus_bytes[LCD_WIDTH * 2] = {0}; //A run of display_list_line, high byte first, for lcd_dma_send()
+static t_lcd_display_list_window display_list_window = {0};
+
+//One row of the SD image under text, see lcd_display_list_composite_image()
+static uint16_t composite_line[LCD_WIDTH] = {0};
+static t_lcd_composite composite = {0};
+
+//Anti-aliasing palette of the last transparent text pixel, [0] font and [1] the pixel under it
+static uint16_t blend_table[4] = {0};
+
+
+/*
+****************************************************
+********** Private Function Prototypes *************
+****************************************************
+*/
+void lcd_blend_glyph_row(uint16_t *tmp_line, const uint8_t *tmp_glyph, const t_font_glyph_metrics *tmp_metrics,
+                         uint8_t row, uint8_t column_final, uint16_t font_color);
+t_lcd_primitive *lcd_display_list_add(e_lcd_primitive tmp_type, uint16_t x_initial, uint16_t y_initial,
+                                      uint16_t x_final, uint16_t y_final, uint16_t text_bytes);
+uint8_t lcd_display_list_is_covered(uint8_t tmp_image);
+void lcd_display_list_composite_image(const t_lcd_primitive *tmp_image);
+void lcd_display_list_send_rows(uint16_t first_row, uint16_t last_row);
+void lcd_display_list_send_row(uint16_t row, uint16_t last_row, e_lcd_coverage tmp_pass);
+void lcd_display_list_read_under(uint16_t x_initial, uint16_t x_final, uint16_t gram_row);
+void lcd_display_list_raster_row(const t_lcd_primitive *tmp_primitive, uint16_t row);
+
+
+/*
+****************************************************
+********** Public Function Definitions *************
+****************************************************
+*/
+
+/*!
+* @brief Start recording a display list. Until the matching lcd_display_list_end(), rectangles,
+*        bitmaps, strings and SD images are kept instead of drawn
+* @param[in] NONE
+* @return NONE
+*
+* @note Calls may be nested, the list is only sent by the outermost lcd_display_list_end()
+* @warning Nothing recorded reaches the LCD before the list ends, so do not wait on the user or
+*          on a timer in between
+*/
+void
+lcd_display_list_begin(void)
+{
+   display_list_depth++;
+}
+
+
+/*!
+* @brief Stop recording and send the display list. Pixels hidden under later primitives are
+*        never sent, so each pixel of the recorded rectangles, bitmaps and strings is written once
+* @param[in] NONE
+* @return NONE
+*
+* @note SD images are streamed whole before anything else. Local primitives recorded on top of
+*       them are sent afterwards, everything recorded underneath them is dropped.
+*/
+void
+lcd_display_list_end(void)
+{
+   if(0 == display_list_depth)
+   {
+      return;
+   }
+
+   display_list_depth--;
+
+   if(0 == display_list_depth)
+   {
+      lcd_display_list_flush();
+   }
+}
+
+
+/*!
+* @brief Send the display list to the LCD and empty it
+* @param[in] NONE
+* @return NONE
+*
+* @note SD images with nothing recorded over them are streamed first, whole. The rectangles,
+*       bitmaps and strings are sent next, then each SD image that something was recorded over
+*       is composited with it one row at a time, see lcd_display_list_composite_image(). Every
+*       pixel goes to the LCD once, in one of the three.
+* @note The SD images are read as one batch, see lcd_images_from_sd()
+*/
+void
+lcd_display_list_flush(void)
+{
+   uint8_t tmp_depth = display_list_depth;
+   uint16_t first_row = LCD_HEIGHT;
+   uint16_t last_row = 0;
+
+   if(0 == display_list_length)
+   {
+      return;
+   }
+
+   //Draw for real from here on
+   display_list_depth = 0;
+
+   //Glyphs are looked up once per row, keep the ones this list uses for the whole flush
+   lcd_glyph_cache_start_pass();
+
+   //Nothing else uses the card until the end of the flush, so its images can share a read
+   lcd_sd_batch_begin();
+
+   //Uncovered SD images go first. Find the rows the rest of the list touches on the way
+   for(uint8_t current_primitive = 0; current_primitive < display_list_length; current_primitive++)
+   {
+      const t_lcd_primitive *p_primitive = &display_list[current_primitive];
+
+      if(lcd_primitive_sd_image == p_primitive->type)
+      {
+         if(lcd_display_list_is_covered(current_primitive))
+         {
+            continue;
+         }
+
+         //Images are streamed top to bottom, so one that wraps in a scrolled area loses its bottom rows
+         uint16_t image_rows = p_primitive->y_final - p_primitive->y_initial;
+         uint16_t gram_row = lcd_scroll_map_row(p_primitive->y_initial, &image_rows);
+
+         lcd_stream_image_from_sd(p_primitive->x_initial, gram_row, p_primitive->x_final, gram_row + image_rows,
+                                  p_primitive->source.sd_image.column, p_primitive->source.sd_image.row,
+                                  p_primitive->source.sd_image.width, p_primitive->source.sd_image.address);
+         continue;
+      }
+
+      if(p_primitive->y_initial < first_row)
+      {
+         first_row = p_primitive->y_initial;
+      }
+
+      if(p_primitive->y_final > last_row)
+      {
+         last_row = p_primitive->y_final;
+      }
+   }
+
+   //Everything else is sent row by row
+   if(first_row < last_row)
+   {
+      lcd_display_list_send_rows(first_row, last_row);
+   }
+
+   //Then the images under it, with what covers them
+   for(uint8_t current_primitive = 0; current_primitive < display_list_length; current_primitive++)
+   {
+      if((lcd_primitive_sd_image == display_list[current_primitive].type) && lcd_display_list_is_covered(current_primitive))
+      {
+         lcd_display_list_composite_image(&display_list[current_primitive]);
+      }
+   }
+
+   lcd_sd_batch_end();
+
+   display_list_length = 0;
+   display_list_text_length = 0;
+   display_list_depth = tmp_depth;
+}
+
+
+/*!
+* @brief Record a rectangle if a display list is open
+* @param[in] color A 16-bit 5-6-5 RGB color
+* @param[in] x_in Initial X position
+* @param[in] y_in Initial Y position
+* @param[in] x_fin Final X position
+* @param[in] y_fin Final Y position
+* @return 1 if the rectangle was recorded or is entirely off the screen, 0 if it must be drawn now
+*/
+uint8_t
+lcd_display_list_add_rectangle(uint16_t color, uint16_t x_in, uint16_t y_in, uint16_t x_fin, uint16_t y_fin)
+{
+   if(0 == display_list_depth)
+   {
+      return(0);
+   }
+
+   t_lcd_primitive *p_primitive = lcd_display_list_add(lcd_primitive_rectangle, x_in, y_in, x_fin, y_fin, 0);
+
+   if(NULL != p_primitive)
+   {
+      p_primitive->palette[0] = color;
+   }
+
+   return(1);
+}
+
+
+/*!
+* @brief Record a 2-bit bitmap if a display list is open
+* @param[in] tmp_bmp A 2-bit bitmap stored on internal FLASH
+* @param[in] x
+* @param[in] y
+* @param[in] main_color
+* @param[in] background_color
+* @return 1 if the bitmap was recorded or is entirely off the screen, 0 if it must be drawn now
+*/
+uint8_t
+lcd_display_list_add_bitmap(const uint8_t *tmp_bmp, uint16_t x, uint16_t y, uint16_t main_color, uint16_t background_color)
+{
+   uint16_t bitmap_dimensions[2] = {0};
+   t_lcd_primitive *p_primitive = NULL;
+
+   if(0 == display_list_depth)
+   {
+      return(0);
+   }
+
+   if(NULL != tmp_bmp)
+   {
+      lcd_parse_local_bitmap(tmp_bmp, bitmap_dimensions);
+      p_primitive = lcd_display_list_add(lcd_primitive_bitmap, x, y, x + bitmap_dimensions[0], y + bitmap_dimensions[1], 0);
+   }
+
+   if(NULL != p_primitive)
+   {
+      lcd_get_font_color_table(p_primitive->palette, main_color, background_color);
+      p_primitive->source.bitmap = tmp_bmp;
+   }
+
+   return(1);
+}
+
+
+/*!
+* @brief Record a string if a display list is open. The string is copied, callers often pass
+*        buffers that are gone by the time the list is sent
+* @param[in] tmp_type lcd_primitive_string or lcd_primitive_string_small
+* @param[in] tmp_string
+* @param[in] x
+* @param[in] y
+* @param[in] font_color
+* @param[in] background_color Not used for transparent strings
+* @param[in] is_transparent 1 to blend the string with what is under it
+* @return 1 if the string was recorded or is entirely off the screen, 0 if it must be drawn now
+*/
+uint8_t
+lcd_display_list_add_text(e_lcd_primitive tmp_type, const char *tmp_string, uint16_t x, uint16_t y,
+                          uint16_t font_color, uint16_t background_color, uint8_t is_transparent)
+{
+   uint16_t text_bytes = strlen(tmp_string) + 1;
+   uint16_t string_width = 0;
+   uint8_t glyph_height = LCD_FONT_SMALL_HEIGHT;
+
+   //Too long for the text buffer, draw it straight away
+   if((0 == display_list_depth) || (LCD_DISPLAY_LIST_TEXT_BYTES < text_bytes))
+   {
+      return(0);
+   }
+
+   if(lcd_primitive_string == tmp_type)
+   {
+      string_width = lcd_get_string_width(tmp_string, jet_font_metrics);
+      glyph_height = LCD_FONT_HEIGHT;
+   }
+
+   else
+   {
+      string_width = lcd_get_string_width(tmp_string, jet_font_small_metrics);
+   }
+
+   t_lcd_primitive *p_primitive = lcd_display_list_add(tmp_type, x, y, x + string_width, y + glyph_height, text_bytes);
+
+   if(NULL != p_primitive)
+   {
+      lcd_get_font_color_table(p_primitive->palette, font_color, background_color);
+      p_primitive->is_transparent = is_transparent;
+      p_primitive->source.text_offset = display_list_text_length;
+      memcpy(&display_list_text[display_list_text_length], tmp_string, text_bytes);
+      display_list_text_length += text_bytes;
+   }
+
+   return(1);
+}
+
+
+/*!
+* @brief Record a rectangle of an SD card image if a display list is open
+* @param[in] x_in Initial X position
+* @param[in] y_in Initial Y position
+* @param[in] x_fin Final X position
+* @param[in] y_fin Final Y position
+* @param[in] image_column Column of the image drawn at x_in
+* @param[in] image_row Row of the image drawn at y_in
+* @param[in] image_width Pixels in each image row, 0 to take it from the header
+* @param[in] memory_starting_address Memory block location of the image on the SD card
+* @return 1 if the image was recorded or is entirely off the screen, 0 if it must be drawn now
+*/
+uint8_t
+lcd_display_list_add_sd_image(uint16_t x_in, uint16_t y_in, uint16_t x_fin, uint16_t y_fin, uint16_t image_column,
+                              uint16_t image_row, uint16_t image_width, uint32_t memory_starting_address)
+{
+   if(0 == display_list_depth)
+   {
+      return(0);
+   }
+
+   t_lcd_primitive *p_primitive = lcd_display_list_add(lcd_primitive_sd_image, x_in, y_in, x_fin, y_fin, 0);
+
+   if(NULL != p_primitive)
+   {
+      p_primitive->source.sd_image.address = memory_starting_address;
+      p_primitive->source.sd_image.column = image_column;
+      p_primitive->source.sd_image.row = image_row;
+      p_primitive->source.sd_image.width = image_width;
+   }
+
+   return(1);
+}
+
+
+/*!
+* @brief Tells SD image decoders where their pixels go
+* @param[in] NONE
+* @return 1 while an image is being composited, see lcd_display_list_composite_pixels(). 0 while
+*         decoded pixels go to the LCD bus
+*/
+uint8_t
+lcd_display_list_is_compositing(void)
+{
+   return(NULL != composite.image);
+}
+
+
+/*!
+* @brief Start collecting a new row of the image being composited
+* @param[in] row Screen row the next pixels belong to
+* @return NONE
+*
+* @note For images whose rows are not stored in screen order, see lcd_stream_interlaced_image()
+*/
+void
+lcd_display_list_composite_row(uint16_t row)
+{
+   composite.row = row;
+   composite.column = 0;
+   composite.has_high_byte = 0;
+}
+
+
+/*!
+* @brief Collect RGB565 bytes of the image being composited
+* @param[in] tmp_data High byte of the first pixel first
+* @param[in] tmp_bytes
+* @return NONE
+*
+* @warning LCD must be selected, see lcd_display_list_composite_image()
+*/
+void
+lcd_display_list_composite_bytes(const uint8_t *tmp_data, uint16_t tmp_bytes)
+{
+   //Pixels may be split across blocks, the high byte waits for the low one
+   for(uint16_t current_byte = 0; current_byte < tmp_bytes; current_byte++)
+   {
+      if(composite.has_high_byte)
+      {
+         lcd_display_list_composite_pixels((composite.high_byte << 8) | tmp_data[current_byte], 1);
+      }
+
+      composite.high_byte = tmp_data[current_byte];
+      composite.has_high_byte ^= 1;
+   }
+}
+
+
+/*!
+* @brief Collect decoded pixels of the image being composited. Each row is built and sent
+*        as soon as it is complete
+* @param[in] pixel_value
+* @param[in] repeat
+* @return  NONE
+*
+* @warning LCD must be selected, see lcd_display_list_composite_image()
+*/
+void
+lcd_display_list_composite_pixels(uint16_t pixel_value, uint32_t repeat)
+{
+   const t_lcd_primitive *p_image = composite.image;
+   uint16_t width = p_image->x_final - p_image->x_initial;
+
+   while((0 < repeat) && (composite.row < p_image->y_final))
+   {
+      uint16_t *p_line = &composite_line[p_image->x_initial + composite.column];
+      uint16_t span = width - composite.column;
+
+      if(span > repeat)
+      {
+         span = repeat;
+      }
+
+      for(uint16_t current_pixel = 0; current_pixel < span; current_pixel++)
+      {
+         p_line[current_pixel] = pixel_value;
+      }
+
+      repeat -= span;
+      composite.column += span;
+
+      if(width == composite.column)
+      {
+         lcd_display_list_send_row(composite.row, p_image->y_final, lcd_coverage_composited);
+         composite.row++;
+         composite.column = 0;
+      }
+   }
+}
+
+
+
+
+/*
+****************************************************
+********** Private Function Definitions ************
+****************************************************
+*/
+
+/*!
+* @brief Reserve the next display list entry, flushing the list first if it is full
+* @param[in] tmp_type
+* @param[in] x_initial
+* @param[in] y_initial
+* @param[in] x_final Exclusive
+* @param[in] y_final Exclusive
+* @param[in] text_bytes Room needed in display_list_text, 0 for anything but strings
+* @return The entry with its type and area filled in, or NULL if nothing of it is on the screen
+*/
+t_lcd_primitive *
+lcd_display_list_add(e_lcd_primitive tmp_type, uint16_t x_initial, uint16_t y_initial,
+                     uint16_t x_final, uint16_t y_final, uint16_t text_bytes)
+{
+   if(LCD_WIDTH < x_final)
+   {
+      x_final = LCD_WIDTH;
+   }
+
+   if(LCD_HEIGHT < y_final)
+   {
+      y_final = LCD_HEIGHT;
+   }
+
+   if((x_final <= x_initial) || (y_final <= y_initial))
+   {
+      return(NULL);
+   }
+
+   //Out of room. Sending what is there keeps the drawing order, it only loses the culling across the split
+   if((LCD_DISPLAY_LIST_LENGTH == display_list_length) || (LCD_DISPLAY_LIST_TEXT_BYTES < (display_list_text_length + text_bytes)))
+   {
+      lcd_display_list_flush();
+   }
+
+   t_lcd_primitive *p_primitive = &display_list[display_list_length];
+   display_list_length++;
+
+   p_primitive->type = tmp_type;
+   p_primitive->x_initial = x_initial;
+   p_primitive->y_initial = y_initial;
+   p_primitive->x_final = x_final;
+   p_primitive->y_final = y_final;
+   p_primitive->is_transparent = 0;
+
+   return(p_primitive);
+}
+
+
+/*!
+* @brief Check whether a rectangle, bitmap or string was recorded over part of an SD image
+* @param[in] tmp_image Index of the image in display_list
+* @return 1 if one was
+*/
+uint8_t
+lcd_display_list_is_covered(uint8_t tmp_image)
+{
+   const t_lcd_primitive *p_image = &display_list[tmp_image];
+
+   for(uint8_t current_primitive = tmp_image + 1; current_primitive < display_list_length; current_primitive++)
+   {
+      const t_lcd_primitive *p_primitive = &display_list[current_primitive];
+
+      if((lcd_primitive_sd_image != p_primitive->type) &&
+         (p_primitive->x_initial < p_image->x_final) && (p_primitive->x_final > p_image->x_initial) &&
+         (p_primitive->y_initial < p_image->y_final) && (p_primitive->y_final > p_image->y_initial))
+      {
+         return(1);
+      }
+   }
+
+   return(0);
+}
+
+
+/*!
+* @brief Send an SD image together with everything recorded over it, one row at a time
+* @param[in] tmp_image
+* @return NONE
+*
+* @note The image is read as usual, but its decoded pixels are collected in composite_line
+*       instead of going to the LCD bus. Each finished row is built and sent by
+*       lcd_display_list_send_row(), so text over the image is blended with the image pixels
+*       and the pixels under a rectangle or bitmap are never sent at all. The next SD block
+*       is still clocked in while the row is built.
+*/
+void
+lcd_display_list_composite_image(const t_lcd_primitive *tmp_image)
+{
+   composite.image = tmp_image;
+   composite.row = tmp_image->y_initial;
+   composite.column = 0;
+   composite.has_high_byte = 0;
+
+   //Rows are sent through their own windows
+   display_list_window.next_row = LCD_HEIGHT;
+
+   lcd_stream_image_from_sd(tmp_image->x_initial, tmp_image->y_initial, tmp_image->x_final, tmp_image->y_final,
+                            tmp_image->source.sd_image.column, tmp_image->source.sd_image.row,
+                            tmp_image->source.sd_image.width, tmp_image->source.sd_image.address);
+
+   composite.image = NULL;
+
+   //Deselect LCD once the last run is out
+   lcd_dma_wait();
+   gpio_pin_set(LCD_CS);
+}
+
+
+/*!
+* @brief Send the rectangles, bitmaps and strings of the display list that cross a range of rows
+* @param[in] first_row
+* @param[in] last_row Exclusive
+* @return NONE
+*/
+void
+lcd_display_list_send_rows(uint16_t first_row, uint16_t last_row)
+{
+   //Select LCD
+   lcd_select();
+
+   display_list_window.next_row = LCD_HEIGHT;
+
+   for(uint16_t row = first_row; row < last_row; row++)
+   {
+      lcd_display_list_send_row(row, last_row, lcd_coverage_list);
+   }
+
+   //Deselect LCD once the last run is out
+   lcd_dma_wait();
+   gpio_pin_set(LCD_CS);
+}
+
+
+/*!
+* @brief Build one screen row of the display list in display_list_line and send part of it
+* @param[in] row
+* @param[in] last_row Exclusive, the window is kept this tall
+* @param[in] tmp_pass lcd_coverage_list to send the pixels with a rectangle, bitmap or string on
+*                     top, lcd_coverage_composited for the ones of the image being composited
+* @return NONE
+*
+* @note The row is built by rasterizing every primitive that crosses it in recording order, so
+*       later primitives overwrite earlier ones. A window is only set when a run of pixels does
+*       not continue where the previous one left off.
+* @note With LCD_DMA_ENABLED, long runs go out through lcd_dma_send() so the next row is
+*       rasterized while the last one is still on the bus.
+* @warning LCD must be selected
+*/
+void
+lcd_display_list_send_row(uint16_t row, uint16_t last_row, e_lcd_coverage tmp_pass)
+{
+   t_lcd_display_list_window *p_window = &display_list_window;
+
+   //Rows of a scrolled area are not where they appear on the screen
+   uint16_t window_rows = last_row - row;
+   uint16_t gram_row = lcd_scroll_map_row(row, &window_rows);
+
+   memset(display_list_coverage, lcd_coverage_none, sizeof(display_list_coverage));
+
+   for(uint8_t current_primitive = 0; current_primitive < display_list_length; current_primitive++)
+   {
+      const t_lcd_primitive *p_primitive = &display_list[current_primitive];
+      e_lcd_coverage primitive_coverage = lcd_coverage_list;
+
+      if((row < p_primitive->y_initial) || (row >= p_primitive->y_final))
+      {
+         continue;
+      }
+
+      if(lcd_primitive_sd_image == p_primitive->type)
+      {
+         primitive_coverage = (p_primitive == composite.image) ? lcd_coverage_composited : lcd_coverage_image;
+      }
+
+      //Transparent text belongs to whatever it is over. Over nothing, that is what GRAM holds
+      if(p_primitive->is_transparent)
+      {
+         if(lcd_coverage_list == tmp_pass)
+         {
+            lcd_display_list_read_under(p_primitive->x_initial, p_primitive->x_final, gram_row);
+         }
+      }
+
+      else
+      {
+         memset(&display_list_coverage[p_primitive->x_initial], primitive_coverage,
+                p_primitive->x_final - p_primitive->x_initial);
+      }
+
+      lcd_display_list_raster_row(p_primitive, row);
+   }
+
+   //Send each run of pixels that belongs to this pass
+   uint16_t column = 0;
+
+   while(column < LCD_WIDTH)
+   {
+      if(tmp_pass != display_list_coverage[column])
+      {
+         column++;
+         continue;
+      }
+
+      uint16_t run_start = column;
+
+      while((column < LCD_WIDTH) && (tmp_pass == display_list_coverage[column]))
+      {
+         column++;
+      }
+
+      //The window is kept as tall as the list allows, so a run in the same columns as the last one just continues
+      if((run_start != p_window->x_initial) || (column != p_window->x_final) || (gram_row != p_window->next_row) ||
+         (gram_row > p_window->last_row))
+      {
+         lcd_dma_wait();
+         lcd_set_window_address(run_start, gram_row, column - 1, gram_row + window_rows - 1);
+         gpio_pin_set(LCD_RS);
+         p_window->x_initial = run_start;
+         p_window->x_final = column;
+         p_window->last_row = gram_row + window_rows - 1;
+      }
+
+      p_window->next_row = gram_row + 1;
+      lcd_add_pixels_pushed(column - run_start);
+
+      uint16_t run_bytes = (column - run_start) * 2;
+
+      //The previous run is done with the bus and display_list_bus_bytes after this
+      lcd_dma_wait();
+
+      //Long runs are sent in the background while the next row is built
+      if(LCD_DMA_ENABLED && (LCD_DMA_MIN_BYTES <= run_bytes))
+      {
+         for(uint16_t current_pixel = run_start; current_pixel < column; current_pixel++)
+         {
+            uint16_t pixel_value = display_list_line[current_pixel];
+
+            display_list_bus_bytes[(current_pixel - run_start) * 2] = pixel_value >> 8;
+            display_list_bus_bytes[((current_pixel - run_start) * 2) + 1] = pixel_value & 0xFF;
+         }
+
+         lcd_dma_send(display_list_bus_bytes, run_bytes, 0);
+         continue;
+      }
+
+      for(uint16_t current_pixel = run_start; current_pixel < column; current_pixel++)
+      {
+         uint16_t pixel_value = display_list_line[current_pixel];
+
+         lcd_bus_write(pixel_value >> 8);
+         lcd_bus_write(pixel_value & 0xFF);
+      }
+   }
+}
+
+
+/*!
+* @brief Read the pixels nothing recorded covers back from GRAM, so transparent text over them
+*        has something to blend with
+* @param[in] x_initial
+* @param[in] x_final Exclusive
+* @param[in] gram_row
+* @return NONE
+*
+* @warning LCD must be selected. The write window is lost, the next run sets it again
+*/
+void
+lcd_display_list_read_under(uint16_t x_initial, uint16_t x_final, uint16_t gram_row)
+{
+   uint16_t column = x_initial;
+
+   while(column < x_final)
+   {
+      if(lcd_coverage_none != display_list_coverage[column])
+      {
+         column++;
+         continue;
+      }
+
+      uint16_t run_start = column;
+
+      while((column < x_final) && (lcd_coverage_none == display_list_coverage[column]))
+      {
+         display_list_coverage[column] = lcd_coverage_list;
+         column++;
+      }
+
+      //The bus is turned around, the last run must be out
+      lcd_dma_wait();
+      lcd_read_start(run_start, gram_row, column, gram_row + 1);
+      lcd_read_pixels(&display_list_line[run_start], column - run_start);
+      lcd_read_end();
+
+      display_list_window.next_row = LCD_HEIGHT;
+   }
+}
+
+
+/*!
+* @brief Write one screen row of a recorded primitive into display_list_line
+* @param[in] tmp_primitive
+* @param[in] row Screen row, must be inside the primitive
+* @return NONE
+*
+* @note Produces the same pixels as lcd_draw_rectangle(), lcd_send_bitmap() and
+*       lcd_print_string_line() would for that row. SD images only have pixels while they are
+*       being composited
+*/
+void
+lcd_display_list_raster_row(const t_lcd_primitive *tmp_primitive, uint16_t row)
+{
+   uint16_t *p_line = &display_list_line[tmp_primitive->x_initial];
+   uint16_t width = tmp_primitive->x_final - tmp_primitive->x_initial;
+   const uint16_t *p_palette = tmp_primitive->palette;
+
+   switch(tmp_primitive->type)
+   {
+   case lcd_primitive_rectangle:
+   {
+      for(uint16_t column = 0; column < width; column++)
+      {
+         p_line[column] = p_palette[0];
+      }
+
+      break;
+   }
+
+   case lcd_primitive_bitmap:
+   {
+      //2bpp pixels run on from one row to the next without padding, leftmost pixel in the top bits
+      uint16_t bitmap_dimensions[2] = {0};
+      lcd_parse_local_bitmap(tmp_primitive->source.bitmap, bitmap_dimensions);
+
+      const uint8_t *p_data = &tmp_primitive->source.bitmap[BITMAPS_LOCAL_BMP_OFFSET];
+      uint32_t pixel_index = (uint32_t)(row - tmp_primitive->y_initial) * bitmap_dimensions[0];
+
+      for(uint16_t column = 0; column < width; column++, pixel_index++)
+      {
+         p_line[column] = p_palette[(p_data[pixel_index >> 2] >> (6 - ((pixel_index & 0x03) << 1))) & 0x03];
+      }
+
+      break;
+   }
+
+   case lcd_primitive_string:
+   case lcd_primitive_string_small:
+   {
+      const char *p_text = &display_list_text[tmp_primitive->source.text_offset];
+      const uint8_t *p_font = &jet_font_small[0][0];
+      const t_font_glyph_metrics *p_font_metrics = jet_font_small_metrics;
+      uint8_t glyph_height = LCD_FONT_SMALL_HEIGHT;
+
+      if(lcd_primitive_string == tmp_primitive->type)
+      {
+         p_font = &jet_font[0][0];
+         p_font_metrics = jet_font_metrics;
+         glyph_height = LCD_FONT_HEIGHT;
+      }
+
+      uint16_t glyph_bytes = glyph_height * (LCD_FONT_CELL_WIDTH / 4); //4 pixels per byte
+      uint8_t glyph_row_index = row - tmp_primitive->y_initial;
+      uint16_t column = 0;
+
+      //Transparent text is written over what the line already holds
+      for(column = 0; (column < width) && !tmp_primitive->is_transparent; column++)
+      {
+         p_line[column] = p_palette[1];
+      }
+
+      //Characters in order, each one ends where the next begins except the last
+      column = 0;
+
+      for(size_t current_char = 0; ('\0' != p_text[current_char]) && (column < width); current_char++)
+      {
+         uint8_t current_glyph = p_text[current_char] - 32;
+         const t_font_glyph_metrics *p_metrics = &p_font_metrics[current_glyph];
+         uint16_t column_final = ('\0' != p_text[current_char + 1]) ? p_metrics->advance : LCD_FONT_CELL_WIDTH;
+
+         if(column_final > (width - column))
+         {
+            column_final = width - column;
+         }
+
+         //Blends depend on every pixel under the glyph, the cache cannot hold them
+         if(tmp_primitive->is_transparent)
+         {
+            lcd_blend_glyph_row(&p_line[column], p_font + (current_glyph * glyph_bytes), p_metrics, glyph_row_index,
+                                column_final, p_palette[0]);
+         }
+
+         //Only glyphs with ink on this row take a cache lookup
+         else if((glyph_row_index >= p_metrics->ink_y_initial) && (glyph_row_index < p_metrics->ink_y_final))
+         {
+            lcd_raster_glyph_row(&p_line[column], p_font + (current_glyph * glyph_bytes),
+                                 lcd_glyph_cache_get(p_font, glyph_height, p_text[current_char], p_metrics, p_palette),
+                                 p_metrics, glyph_row_index, column_final, p_palette);
+         }
+
+         column += p_metrics->advance;
+      }
+
+      break;
+   }
+
+   case lcd_primitive_sd_image:
+   {
+      if(tmp_primitive == composite.image)
+      {
+         memcpy(p_line, &composite_line[tmp_primitive->x_initial], width * 2);
+      }
+
+      break;
+   }
+
+   default:
+      break;
+   }
+}
+
+
+/*!
+* @brief Write the ink of one glyph row over the pixels already in a line, blending the
+*        anti-aliased edges with each of them
+* @param[in] tmp_line Column 0 of the glyph cell
+* @param[in] tmp_glyph 2bpp cell of the glyph in the font
+* @param[in] tmp_metrics Metrics of the glyph
+* @param[in] row Row of the cell
+* @param[in] column_final Columns from here on belong to the next character or are clipped
+* @param[in] font_color
+* @return NONE
+*
+* @note The blends are the ones lcd_get_font_color_table() picks for that pixel as background.
+*       Neighbouring pixels of a photo are often the same, so the last palette is kept
+*/
+void
+lcd_blend_glyph_row(uint16_t *tmp_line, const uint8_t *tmp_glyph, const t_font_glyph_metrics *tmp_metrics,
+                    uint8_t row, uint8_t column_final, uint16_t font_color)
+{
+   uint8_t column = tmp_metrics->ink_x_initial;
+
+   if((row < tmp_metrics->ink_y_initial) || (row >= tmp_metrics->ink_y_final))
+   {
+      return;
+   }
+
+   if(column_final > tmp_metrics->ink_x_final)
+   {
+      column_final = tmp_metrics->ink_x_final;
+   }
+
+   //Leftmost pixel in the top bits
+   const uint8_t *glyph_row = tmp_glyph + (row * (LCD_FONT_CELL_WIDTH / 4));
+
+   for(; column < column_final; column++)
+   {
+      uint8_t pixel_code = (glyph_row[column >> 2] >> (6 - ((column & 0x03) << 1))) & 0x03;
+
+      //Code 1 is the background, it stays as it is
+      if(1 == pixel_code)
+      {
+         continue;
+      }
+
+      if((font_color != blend_table[0]) || (tmp_line[column] != blend_table[1]))
+      {
+         lcd_get_font_color_table(blend_table, font_color, tmp_line[column]);
+      }
+
+      tmp_line[column] = blend_table[pixel_code];
+   }
+}
+
+/* end of file */
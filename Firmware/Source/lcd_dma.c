@@ -0,0 +1,282 @@
+/** @file lcd_dma.c
+*
+* @brief  This file clocks bytes out on the LCD bus without the CPU. TIM1 channel 1 drives LCD_WR
+*         and each channel 2 compare match, after the strobe, has DMA2 stream 2 write the next byte
+*         to the low byte of GPIOB->ODR. The timer runs in one pulse mode with a repetition count, so it stops
+*         on its own after exactly the requested number of strobes and its update interrupt
+*         starts the next chunk or ends the transfer.
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#include "lcd_dma.h"
+
+
+/*
+****************************************************
+************* File-Static Variables ****************
+****************************************************
+*/
+static volatile uint8_t lcd_dma_active = 0;
+static volatile uint32_t lcd_dma_strobes_left = 0; //Strobes not yet handed to TIM1
+static uint8_t lcd_dma_release = 0; //Deselect the LCD when the last byte is clocked
+static uint8_t lcd_dma_owns_wr = 0; //LCD_WR is in alternate function mode
+static uint8_t lcd_dma_fill_bytes[2] = {0}; //Low then high byte of the fill color, sent in a loop
+
+
+/*
+****************************************************
+********** Private Function Prototypes *************
+****************************************************
+*/
+void lcd_dma_start(uint32_t tmp_strobes, uint8_t release_lcd);
+void lcd_dma_start_chunk(void);
+
+
+/*
+****************************************************
+********** Public Function Definitions *************
+****************************************************
+*/
+
+/*!
+* @brief Sets up TIM1 channel 1 to strobe LCD_WR and channel 2 to have DMA2 stream 2 feed the data bus
+* @param[in] NONE
+* @return NONE
+*
+* @warning lcd_gpio_init() must have run. LCD_WR stays a general output until a transfer starts
+*/
+void
+lcd_dma_init(void)
+{
+   RCC->APB2ENR |= RCC_APB2ENR_TIM1EN;
+   RCC->AHB1ENR |= RCC_AHB1ENR_DMA2EN;
+
+   //Route TIM1_CH1 to PA8 for when LCD_WR is handed over
+   GPIOA->AFR[1] &= ~(0x0F << 0); //Clear AFRH8[3:0]
+   GPIOA->AFR[1] |= (LCD_DMA_WR_AF << 0);
+
+   //Stopped, one pulse mode, only counter overflows raise the update interrupt
+   TIM1->CR1 = (TIM_CR1_URS | TIM_CR1_OPM);
+   TIM1->PSC = 0;
+   TIM1->ARR = LCD_DMA_PERIOD_CYCLES - 1;
+   TIM1->CCR1 = LCD_DMA_STROBE_CYCLES;
+   TIM1->CCR2 = LCD_DMA_REQUEST_CYCLES; //Only its DMA request is used, the output stays off
+
+   //PWM mode 2 without preload: low below CCR1, so the output idles low like LCD_WR does
+   TIM1->CCMR1 = (TIM_CCMR1_OC1M_2 | TIM_CCMR1_OC1M_1 | TIM_CCMR1_OC1M_0);
+   TIM1->CCER = TIM_CCER_CC1E;
+   TIM1->BDTR = TIM_BDTR_MOE;
+   TIM1->DIER = (TIM_DIER_UIE | TIM_DIER_CC2DE);
+
+   //Chunks must follow each other quickly, the bus is idle in between
+   NVIC_SetPriority(TIM1_UP_IRQn, 1);
+   NVIC_EnableIRQ(TIM1_UP_IRQn);
+}
+
+
+/*!
+* @brief Starts sending one color to the LCD in the background
+* @param[in] color A 16-bit 5-6-5 RGB color
+* @param[in] pixels
+* @param[in] release_lcd 1 to deselect the LCD once the last pixel is sent
+* @return NONE
+*
+* @warning The LCD must be selected, in data mode and have its window set
+*/
+void
+lcd_dma_fill(uint16_t color, uint32_t pixels, uint8_t release_lcd)
+{
+   //Wait for the stream without giving LCD_WR back, it is needed again straight away
+   while(lcd_dma_active) {}
+
+   //The CPU puts the high byte of the first pixel on the bus, the stream loops over the rest
+   lcd_dma_fill_bytes[0] = color & 0x00FF;
+   lcd_dma_fill_bytes[1] = color >> 8;
+   gpio_bus_write_byte(LCD_DATA_BUS, lcd_dma_fill_bytes[1]);
+
+   LCD_DMA_STREAM->CR = 0;
+   DMA2->LIFCR = LCD_DMA_FLAGS;
+   LCD_DMA_STREAM->PAR = (uint32_t)(uintptr_t)&(GPIOB->ODR);
+   LCD_DMA_STREAM->M0AR = (uint32_t)(uintptr_t)lcd_dma_fill_bytes;
+   LCD_DMA_STREAM->NDTR = 2;
+   LCD_DMA_STREAM->CR = ((LCD_DMA_CHANNEL << DMA_SxCR_CHSEL_Pos) | DMA_SxCR_MINC | DMA_SxCR_CIRC | DMA_SxCR_DIR_0 | DMA_SxCR_EN);
+
+   lcd_dma_start(pixels * 2, release_lcd);
+}
+
+
+/*!
+* @brief Starts sending a run of bytes to the LCD in the background
+* @param[in] tmp_data Must stay untouched until lcd_dma_wait() returns
+* @param[in] tmp_bytes 1 to 65536
+* @param[in] release_lcd 1 to deselect the LCD once the last byte is sent
+* @return NONE
+*
+* @warning The LCD must be selected and in the mode the bytes are meant for
+*/
+void
+lcd_dma_send(const uint8_t *tmp_data, uint32_t tmp_bytes, uint8_t release_lcd)
+{
+   //Wait for the stream without giving LCD_WR back, it is needed again straight away
+   while(lcd_dma_active) {}
+
+   //The CPU puts the first byte on the bus, the stream writes each following one after a strobe
+   gpio_bus_write_byte(LCD_DATA_BUS, tmp_data[0]);
+
+   LCD_DMA_STREAM->CR = 0;
+   DMA2->LIFCR = LCD_DMA_FLAGS;
+
+   if(1 < tmp_bytes)
+   {
+      LCD_DMA_STREAM->PAR = (uint32_t)(uintptr_t)&(GPIOB->ODR);
+      LCD_DMA_STREAM->M0AR = (uint32_t)(uintptr_t)&tmp_data[1];
+      LCD_DMA_STREAM->NDTR = tmp_bytes - 1;
+      LCD_DMA_STREAM->CR = ((LCD_DMA_CHANNEL << DMA_SxCR_CHSEL_Pos) | DMA_SxCR_MINC | DMA_SxCR_DIR_0 | DMA_SxCR_EN);
+   }
+
+   lcd_dma_start(tmp_bytes, release_lcd);
+}
+
+
+/*!
+* @brief Waits for the background transfer to finish and gives LCD_WR back to the CPU.
+*        Everything that drives the LCD pins must call this first, lcd_select() does
+* @param[in] NONE
+* @return NONE
+*/
+void
+lcd_dma_wait(void)
+{
+   while(lcd_dma_active) {}
+
+   if(lcd_dma_owns_wr)
+   {
+      gpio_func_init(LCD_WR, GPIO_MODER_GENERAL_OUTPUT); //ODR holds it low, the same level TIM1 left it at
+      lcd_dma_owns_wr = 0;
+   }
+}
+
+
+/*!
+* @brief Check for a background transfer
+* @param[in] NONE
+* @return 1 while bytes are still being clocked out
+*/
+uint8_t
+lcd_dma_busy(void)
+{
+   return(lcd_dma_active);
+}
+
+
+/*!
+* @brief TIM1 update interrupt, raised when a chunk of strobes is done. Starts the next chunk
+*        or ends the transfer
+* @param[in] NONE
+* @return NONE
+*/
+void
+TIM1_UP_IRQHandler(void)
+{
+   TIM1->SR = ~TIM_SR_UIF; //Status flags are cleared by writing 0
+
+   if(0 < lcd_dma_strobes_left)
+   {
+      lcd_dma_start_chunk();
+      return;
+   }
+
+   //Last byte latched. A fill stream is still looping, a send stream is already done
+   LCD_DMA_STREAM->CR = 0;
+   DMA2->LIFCR = LCD_DMA_FLAGS;
+
+   if(lcd_dma_release)
+   {
+      gpio_pin_set(LCD_CS);
+   }
+
+   lcd_dma_active = 0;
+}
+
+
+
+
+/*
+****************************************************
+********** Private Function Definitions ************
+****************************************************
+*/
+
+/*!
+* @brief Hands LCD_WR to TIM1 and starts the first chunk of strobes
+* @param[in] tmp_strobes
+* @param[in] release_lcd
+* @return NONE
+*
+* @warning The stream must be enabled and the first byte on the bus
+*/
+void
+lcd_dma_start(uint32_t tmp_strobes, uint8_t release_lcd)
+{
+   lcd_dma_release = release_lcd;
+   lcd_dma_strobes_left = tmp_strobes;
+   lcd_dma_active = 1;
+
+   //LCD_WR is low in both modes, handing it over makes no edge
+   if(!lcd_dma_owns_wr)
+   {
+      gpio_func_init(LCD_WR, GPIO_MODER_ALTERNATE_FUNCTION);
+      lcd_dma_owns_wr = 1;
+   }
+
+   lcd_dma_start_chunk();
+}
+
+
+/*!
+* @brief Runs TIM1 for up to LCD_DMA_CHUNK_BYTES more strobes. It stops by itself at the update
+*        event after the last one
+* @param[in] NONE
+* @return NONE
+*/
+void
+lcd_dma_start_chunk(void)
+{
+   uint32_t tmp_strobes = lcd_dma_strobes_left;
+
+   if(LCD_DMA_CHUNK_BYTES < tmp_strobes)
+   {
+      tmp_strobes = LCD_DMA_CHUNK_BYTES;
+   }
+
+   lcd_dma_strobes_left -= tmp_strobes;
+
+   //UG loads the repetition counter and clears the counter. URS keeps it from raising UIF
+   TIM1->RCR = tmp_strobes - 1;
+   TIM1->EGR = TIM_EGR_UG;
+   TIM1->CR1 = (TIM_CR1_URS | TIM_CR1_OPM | TIM_CR1_CEN);
+}
+
+
+/* end of file */
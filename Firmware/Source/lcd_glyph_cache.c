@@ -0,0 +1,337 @@
+/** @file lcd_glyph_cache.c
+*
+* @brief  This file keeps recently drawn font glyphs expanded to RGB565 in a fixed amount of RAM.
+*         Glyphs are looked up by font, character, font color and background color. Only the ink
+*         box of a glyph is kept, the rest of its cell is background. Ink boxes are packed one
+*         after the other and replaced in the order they were expanded.
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#include "lcd_glyph_cache.h"
+
+
+/*
+****************************************************
+***** Private Types and Structure Definitions ******
+****************************************************
+*/
+typedef struct t_lcd_glyph_cache_entry_tag
+{
+   const uint8_t *font; //NULL while the entry is empty
+   uint32_t last_pass; //Pass the glyph was last used in, see lcd_glyph_cache_start_pass()
+   uint16_t first_pixel; //Ink box in glyph_cache_pixels
+   uint16_t pixels;
+   uint16_t font_color;
+   uint16_t background_color;
+   char glyph;
+
+} t_lcd_glyph_cache_entry;
+
+
+/*
+****************************************************
+************* File-Static Variables ****************
+****************************************************
+*/
+static uint16_t glyph_cache_pixels[LCD_GLYPH_CACHE_PIXELS] = {0};
+static t_lcd_glyph_cache_entry glyph_cache_entries[LCD_GLYPH_CACHE_ENTRIES] = {0};
+static uint8_t glyph_cache_hints[91] = {0}; //Entry each character was last found in, checked before the others
+static uint16_t glyph_cache_next_pixel = 0; //The next ink box goes here, or at 0 if it does not fit
+static uint32_t glyph_cache_pass = 1;
+static uint8_t glyph_cache_is_lent = 0; //See lcd_glyph_cache_lend()
+
+static uint32_t glyph_cache_hits = 0;
+static uint32_t glyph_cache_misses = 0;
+static uint32_t glyph_cache_bypasses = 0;
+static uint32_t glyph_cache_evictions = 0;
+
+_Static_assert((sizeof(glyph_cache_pixels) + sizeof(glyph_cache_entries) + sizeof(glyph_cache_hints)) <= LCD_GLYPH_CACHE_BYTES, "Glyph cache is over LCD_GLYPH_CACHE_BYTES");
+
+
+/*
+****************************************************
+********** Private Function Prototypes *************
+****************************************************
+*/
+uint8_t lcd_glyph_cache_make_room(uint16_t first_pixel, uint16_t tmp_pixels);
+void lcd_glyph_cache_expand(uint16_t *tmp_pixels, const uint8_t *tmp_glyph, const t_font_glyph_metrics *tmp_metrics,
+                            uint8_t ink_y_final, const uint16_t *tmp_palette);
+
+
+/*
+****************************************************
+********** Public Function Definitions *************
+****************************************************
+*/
+
+/*!
+* @brief Start a new pass. Glyphs used during a pass are never replaced during that same pass,
+*        so a string, or a display list, cannot push out glyphs it still has to draw
+* @param[in] NONE
+* @return NONE
+*/
+void
+lcd_glyph_cache_start_pass(void)
+{
+   glyph_cache_pass++;
+}
+
+
+/*!
+* @brief Find the ink box of a glyph expanded with a palette, expanding it into the cache if it
+*        is not there
+* @param[in] tmp_font First glyph of the font, see lcd_print_string_line()
+* @param[in] glyph_height Rows per glyph, at most LCD_FONT_HEIGHT
+* @param[in] tmp_char
+* @param[in] tmp_metrics Metrics of tmp_char, its ink box must not be empty
+* @param[in] tmp_palette Four colors from lcd_get_font_color_table(). The first two, font and
+*                        background color, are the key since the others are derived from them
+* @return Ink box pixels row by row, from ink_x_initial to ink_x_final and from ink_y_initial to
+*         ink_y_final or glyph_height. NULL if the room it needs holds glyphs of the current pass,
+*         or the pixels are lent out, in which case the caller expands the glyph itself
+*
+* @note The pointer is valid until the next pass starts
+*/
+const uint16_t *
+lcd_glyph_cache_get(const uint8_t *tmp_font, uint8_t glyph_height, char tmp_char,
+                    const t_font_glyph_metrics *tmp_metrics, const uint16_t *tmp_palette)
+{
+   uint8_t free_entry = LCD_GLYPH_CACHE_ENTRIES;
+
+   if(glyph_cache_is_lent)
+   {
+      glyph_cache_bypasses++;
+      return(NULL);
+   }
+
+   //Text is drawn a row at a time, so the same glyph is asked for again and again
+   uint8_t *p_hint = &glyph_cache_hints[tmp_char - 32];
+
+   for(uint8_t current_entry = 0; current_entry <= LCD_GLYPH_CACHE_ENTRIES; current_entry++)
+   {
+      uint8_t tmp_entry = (0 == current_entry) ? *p_hint : (current_entry - 1);
+      t_lcd_glyph_cache_entry *p_entry = &glyph_cache_entries[tmp_entry];
+
+      if((tmp_font == p_entry->font) && (tmp_char == p_entry->glyph) &&
+         (tmp_palette[0] == p_entry->font_color) && (tmp_palette[1] == p_entry->background_color))
+      {
+         p_entry->last_pass = glyph_cache_pass;
+         *p_hint = tmp_entry;
+         glyph_cache_hits++;
+
+         return(&glyph_cache_pixels[p_entry->first_pixel]);
+      }
+   }
+
+   uint8_t ink_y_final = (tmp_metrics->ink_y_final < glyph_height) ? tmp_metrics->ink_y_final : glyph_height;
+   uint16_t ink_pixels = (tmp_metrics->ink_x_final - tmp_metrics->ink_x_initial) * (ink_y_final - tmp_metrics->ink_y_initial);
+   uint16_t first_pixel = glyph_cache_next_pixel;
+
+   //Ink boxes are never split, start over from the front when this one does not fit at the back
+   if((LCD_GLYPH_CACHE_PIXELS - first_pixel) < ink_pixels)
+   {
+      first_pixel = 0;
+   }
+
+   if(!lcd_glyph_cache_make_room(first_pixel, ink_pixels))
+   {
+      glyph_cache_bypasses++;
+      return(NULL);
+   }
+
+   //An empty entry, or else the oldest one outside the current pass
+   uint32_t oldest_pass = glyph_cache_pass;
+
+   for(uint8_t current_entry = 0; current_entry < LCD_GLYPH_CACHE_ENTRIES; current_entry++)
+   {
+      if(NULL == glyph_cache_entries[current_entry].font)
+      {
+         free_entry = current_entry;
+         break;
+      }
+
+      if(glyph_cache_entries[current_entry].last_pass < oldest_pass)
+      {
+         oldest_pass = glyph_cache_entries[current_entry].last_pass;
+         free_entry = current_entry;
+      }
+   }
+
+   if(LCD_GLYPH_CACHE_ENTRIES == free_entry)
+   {
+      glyph_cache_bypasses++;
+      return(NULL);
+   }
+
+   glyph_cache_evictions += (NULL != glyph_cache_entries[free_entry].font);
+   glyph_cache_misses++;
+
+   t_lcd_glyph_cache_entry *p_entry = &glyph_cache_entries[free_entry];
+
+   p_entry->font = tmp_font;
+   p_entry->glyph = tmp_char;
+   p_entry->font_color = tmp_palette[0];
+   p_entry->background_color = tmp_palette[1];
+   p_entry->last_pass = glyph_cache_pass;
+   p_entry->first_pixel = first_pixel;
+   p_entry->pixels = ink_pixels;
+   *p_hint = free_entry;
+   glyph_cache_next_pixel = first_pixel + ink_pixels;
+
+   uint16_t glyph_bytes = glyph_height * (LCD_FONT_CELL_WIDTH / 4); //4 pixels per byte
+   lcd_glyph_cache_expand(&glyph_cache_pixels[first_pixel], tmp_font + ((tmp_char - 32) * glyph_bytes), tmp_metrics,
+                          ink_y_final, tmp_palette);
+
+   return(&glyph_cache_pixels[first_pixel]);
+}
+
+
+/*!
+* @brief Copy the cache counters
+* @param[in] tmp_stats Receives the counters since power up
+* @return NONE
+*/
+void
+lcd_glyph_cache_get_stats(t_lcd_glyph_cache_stats *tmp_stats)
+{
+   uint16_t glyphs = 0;
+
+   for(uint8_t current_entry = 0; current_entry < LCD_GLYPH_CACHE_ENTRIES; current_entry++)
+   {
+      glyphs += (NULL != glyph_cache_entries[current_entry].font);
+   }
+
+   tmp_stats->hits = glyph_cache_hits;
+   tmp_stats->misses = glyph_cache_misses;
+   tmp_stats->bypasses = glyph_cache_bypasses;
+   tmp_stats->evictions = glyph_cache_evictions;
+   tmp_stats->glyphs = glyphs;
+   tmp_stats->bytes = sizeof(glyph_cache_pixels);
+}
+
+
+/*!
+* @brief Lend the glyph pixels out as scratch RAM, e.g. to lcd_save_under(). Every glyph is
+*        dropped and lookups are turned away until lcd_glyph_cache_reclaim()
+* @param[in] NONE
+* @return LCD_GLYPH_CACHE_PIXEL_BYTES bytes
+*
+* @warning Pointers returned by lcd_glyph_cache_get() are lost with the glyphs. Only lend
+*          between passes
+*/
+uint8_t *
+lcd_glyph_cache_lend(void)
+{
+   memset(glyph_cache_entries, 0, sizeof(glyph_cache_entries));
+   glyph_cache_next_pixel = 0;
+   glyph_cache_is_lent = 1;
+
+   return((uint8_t *)glyph_cache_pixels);
+}
+
+
+/*!
+* @brief Take the pixels back from lcd_glyph_cache_lend(). The cache starts out empty
+* @param[in] NONE
+* @return NONE
+*/
+void
+lcd_glyph_cache_reclaim(void)
+{
+   glyph_cache_is_lent = 0;
+}
+
+
+
+
+/*
+****************************************************
+********** Private Function Definitions ************
+****************************************************
+*/
+
+/*!
+* @brief Drop the glyphs whose ink boxes overlap the pixels a new one is about to take
+* @param[in] first_pixel
+* @param[in] tmp_pixels
+* @return 1 if the pixels are free now, 0 if a glyph of the current pass holds some of them.
+*         Nothing is dropped then
+*/
+uint8_t
+lcd_glyph_cache_make_room(uint16_t first_pixel, uint16_t tmp_pixels)
+{
+   for(uint8_t current_entry = 0; current_entry < LCD_GLYPH_CACHE_ENTRIES; current_entry++)
+   {
+      const t_lcd_glyph_cache_entry *p_entry = &glyph_cache_entries[current_entry];
+
+      if((NULL != p_entry->font) && (glyph_cache_pass == p_entry->last_pass) &&
+         (p_entry->first_pixel < (first_pixel + tmp_pixels)) && (first_pixel < (p_entry->first_pixel + p_entry->pixels)))
+      {
+         return(0);
+      }
+   }
+
+   for(uint8_t current_entry = 0; current_entry < LCD_GLYPH_CACHE_ENTRIES; current_entry++)
+   {
+      t_lcd_glyph_cache_entry *p_entry = &glyph_cache_entries[current_entry];
+
+      if((NULL != p_entry->font) &&
+         (p_entry->first_pixel < (first_pixel + tmp_pixels)) && (first_pixel < (p_entry->first_pixel + p_entry->pixels)))
+      {
+         p_entry->font = NULL;
+         glyph_cache_evictions++;
+      }
+   }
+
+   return(1);
+}
+
+
+/*!
+* @brief Expand the ink box of a 2bpp glyph cell into RGB565
+* @param[in] tmp_pixels Receives the ink box row by row
+* @param[in] tmp_glyph
+* @param[in] tmp_metrics
+* @param[in] ink_y_final Last ink row of the glyph plus one, clipped to the rows of the font
+* @param[in] tmp_palette
+* @return NONE
+*/
+void
+lcd_glyph_cache_expand(uint16_t *tmp_pixels, const uint8_t *tmp_glyph, const t_font_glyph_metrics *tmp_metrics,
+                       uint8_t ink_y_final, const uint16_t *tmp_palette)
+{
+   for(uint8_t row = tmp_metrics->ink_y_initial; row < ink_y_final; row++)
+   {
+      //Leftmost pixel in the top bits
+      const uint8_t *glyph_row = tmp_glyph + (row * (LCD_FONT_CELL_WIDTH / 4));
+
+      for(uint8_t column = tmp_metrics->ink_x_initial; column < tmp_metrics->ink_x_final; column++)
+      {
+         *tmp_pixels++ = tmp_palette[(glyph_row[column >> 2] >> (6 - ((column & 0x03) << 1))) & 0x03];
+      }
+   }
+}
+
+
+/* end of file */
@@ -0,0 +1,356 @@
+/** @file lcd_rgb565q.c
+*
+* @brief  This file decodes compressed RGB565 images onto the LCD bus and encodes pixels with
+*         the same ops. See LCD_RGB565Q_* in lcd_rgb565q.h for the format
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#include "lcd_rgb565q.h"
+
+
+/*
+****************************************************
+********** Private Function Prototypes *************
+****************************************************
+*/
+void lcd_send_rgb565q_pixels(uint16_t pixel_value, uint32_t repeat);
+void lcd_encode_rgb565q_op(const uint8_t *tmp_op, uint8_t op_length, t_lcd_rgb565q_encoder *tmp_encoder);
+
+
+/*
+****************************************************
+********** Public Function Definitions *************
+****************************************************
+*/
+
+/*!
+* @brief Decodes compressed RGB565 bytes and sends the pixels to the LCD bus
+* @param[in] tmp_data
+* @param[in] tmp_bytes
+* @param[in] tmp_decoder State carried from one block to the next, set up by lcd_stream_image_from_sd()
+* @return  Bytes used, fewer than tmp_bytes if the window filled up
+*
+* @warning LCD must be in data mode with the window set
+*/
+uint16_t
+lcd_drain_rgb565q(const uint8_t *tmp_data, uint16_t tmp_bytes, t_lcd_rgb565q_decoder *tmp_decoder)
+{
+   uint16_t current_byte = 0;
+
+   for(; (current_byte < tmp_bytes) && (0 < tmp_decoder->pixels_left); current_byte++)
+   {
+      uint8_t *p_op = tmp_decoder->op;
+      uint8_t op_length = 1;
+
+      p_op[tmp_decoder->op_bytes] = tmp_data[current_byte];
+      tmp_decoder->op_bytes++;
+
+      if(LCD_RGB565Q_OP_PIXEL == p_op[0])
+      {
+         op_length = 3;
+      }
+
+      else if(LCD_RGB565Q_OP_LUMA == (p_op[0] & LCD_RGB565Q_OP_MASK))
+      {
+         op_length = 2;
+      }
+
+      //Rest of the op is in the next block
+      if(tmp_decoder->op_bytes < op_length)
+      {
+         continue;
+      }
+
+      tmp_decoder->op_bytes = 0;
+
+      uint16_t pixel_value = tmp_decoder->pixel;
+      uint8_t red = pixel_value >> 11;
+      uint8_t green = (pixel_value >> 5) & 0x3F;
+      uint8_t blue = pixel_value & 0x1F;
+      uint32_t repeat = 1;
+
+      if(LCD_RGB565Q_OP_PIXEL == p_op[0])
+      {
+         pixel_value = (p_op[1] << 8) | p_op[2];
+      }
+
+      else
+      {
+         switch(p_op[0] & LCD_RGB565Q_OP_MASK)
+         {
+         case LCD_RGB565Q_OP_INDEX:
+            pixel_value = tmp_decoder->index[p_op[0] & 0x3F];
+            break;
+
+         case LCD_RGB565Q_OP_DIFF:
+            red = (red + ((p_op[0] >> 4) & 0x03) - 2) & 0x1F;
+            green = (green + ((p_op[0] >> 2) & 0x03) - 2) & 0x3F;
+            blue = (blue + (p_op[0] & 0x03) - 2) & 0x1F;
+            pixel_value = (red << 11) | (green << 5) | blue;
+            break;
+
+         case LCD_RGB565Q_OP_LUMA:
+         {
+            int8_t green_diff = (p_op[0] & 0x3F) - 32;
+            int8_t green_half = ((green_diff + 32) / 2) - 16; //Rounds down for negative steps too
+
+            red = (red + green_half + (p_op[1] >> 4) - 8) & 0x1F;
+            green = (green + green_diff) & 0x3F;
+            blue = (blue + green_half + (p_op[1] & 0x0F) - 8) & 0x1F;
+            pixel_value = (red << 11) | (green << 5) | blue;
+            break;
+         }
+
+         default: //LCD_RGB565Q_OP_RUN
+            repeat = (p_op[0] & 0x3F) + 1;
+            break;
+         }
+      }
+
+      red = pixel_value >> 11;
+      green = (pixel_value >> 5) & 0x3F;
+      blue = pixel_value & 0x1F;
+      tmp_decoder->index[((red * 3) + (green * 5) + (blue * 7)) % LCD_RGB565Q_INDEX_LENGTH] = pixel_value;
+      tmp_decoder->pixel = pixel_value;
+
+      //Whole image rows from here on, every pixel goes to the window
+      if((0 == tmp_decoder->rows_to_skip) && (0 == tmp_decoder->column_initial) &&
+         (tmp_decoder->image_width == tmp_decoder->column_final))
+      {
+         if(repeat > tmp_decoder->pixels_left)
+         {
+            repeat = tmp_decoder->pixels_left;
+         }
+
+         tmp_decoder->pixels_left -= repeat;
+         lcd_send_rgb565q_pixels(pixel_value, repeat);
+         continue;
+      }
+
+      //Walk the pixels along the image rows, only the ones inside the window are sent
+      while((0 < repeat) && (0 < tmp_decoder->pixels_left))
+      {
+         uint16_t column = tmp_decoder->column;
+         uint32_t span = tmp_decoder->image_width - column; //Pixels left in this image row
+         uint8_t is_visible = 0;
+
+         if(0 == tmp_decoder->rows_to_skip)
+         {
+            if(column < tmp_decoder->column_initial)
+            {
+               span = tmp_decoder->column_initial - column;
+            }
+
+            else if(column < tmp_decoder->column_final)
+            {
+               span = tmp_decoder->column_final - column;
+               is_visible = 1;
+            }
+         }
+
+         if(span > repeat)
+         {
+            span = repeat;
+         }
+
+         repeat -= span;
+         column += span;
+
+         if(tmp_decoder->image_width == column)
+         {
+            column = 0;
+
+            if(0 < tmp_decoder->rows_to_skip)
+            {
+               tmp_decoder->rows_to_skip--;
+            }
+         }
+
+         tmp_decoder->column = column;
+
+         if(!is_visible)
+         {
+            continue;
+         }
+
+         tmp_decoder->pixels_left -= span;
+         lcd_send_rgb565q_pixels(pixel_value, span);
+      }
+   }
+
+   return(current_byte);
+}
+
+
+/*!
+* @brief Compresses pixels with the ops of compressed SD images, see LCD_RGB565Q_* in lcd_rgb565q.h
+* @param[in] tmp_pixels
+* @param[in] tmp_count
+* @param[in] tmp_encoder State carried from one call to the next, zeroed before the first
+*                        apart from data and capacity
+* @return NONE
+*
+* @note The last run is held back in case the next call continues it, see lcd_encode_rgb565q_end()
+*/
+void
+lcd_encode_rgb565q(const uint16_t *tmp_pixels, uint16_t tmp_count, t_lcd_rgb565q_encoder *tmp_encoder)
+{
+   for(uint16_t current_pixel = 0; current_pixel < tmp_count; current_pixel++)
+   {
+      uint16_t pixel_value = tmp_pixels[current_pixel];
+      uint16_t previous = tmp_encoder->previous;
+
+      if(pixel_value == previous)
+      {
+         tmp_encoder->run++;
+
+         if(LCD_RGB565Q_MAX_RUN == tmp_encoder->run)
+         {
+            lcd_encode_rgb565q_end(tmp_encoder);
+         }
+
+         continue;
+      }
+
+      lcd_encode_rgb565q_end(tmp_encoder);
+
+      uint8_t red = pixel_value >> 11;
+      uint8_t green = (pixel_value >> 5) & 0x3F;
+      uint8_t blue = pixel_value & 0x1F;
+      uint8_t slot = ((red * 3) + (green * 5) + (blue * 7)) % LCD_RGB565Q_INDEX_LENGTH;
+
+      //Channel steps from the previous pixel, wrapping around like the decoder does
+      int8_t red_diff = ((red - (previous >> 11) + 16) & 0x1F) - 16;
+      int8_t green_diff = ((green - ((previous >> 5) & 0x3F) + 32) & 0x3F) - 32;
+      int8_t blue_diff = ((blue - (previous & 0x1F) + 16) & 0x1F) - 16;
+      int8_t green_half = ((green_diff + 32) / 2) - 16;
+      uint8_t op[3] = {0};
+      uint8_t op_length = 1;
+
+      if(pixel_value == tmp_encoder->index[slot])
+      {
+         op[0] = LCD_RGB565Q_OP_INDEX | slot;
+      }
+
+      else if((-2 <= red_diff) && (1 >= red_diff) && (-2 <= green_diff) && (1 >= green_diff) &&
+              (-2 <= blue_diff) && (1 >= blue_diff))
+      {
+         op[0] = LCD_RGB565Q_OP_DIFF | ((red_diff + 2) << 4) | ((green_diff + 2) << 2) | (blue_diff + 2);
+      }
+
+      else if((-8 <= (red_diff - green_half)) && (7 >= (red_diff - green_half)) &&
+              (-8 <= (blue_diff - green_half)) && (7 >= (blue_diff - green_half)))
+      {
+         op[0] = LCD_RGB565Q_OP_LUMA | (green_diff + 32);
+         op[1] = ((red_diff - green_half + 8) << 4) | (blue_diff - green_half + 8);
+         op_length = 2;
+      }
+
+      else
+      {
+         op[0] = LCD_RGB565Q_OP_PIXEL;
+         op[1] = pixel_value >> 8;
+         op[2] = pixel_value & 0xFF;
+         op_length = 3;
+      }
+
+      lcd_encode_rgb565q_op(op, op_length, tmp_encoder);
+      tmp_encoder->index[slot] = pixel_value;
+      tmp_encoder->previous = pixel_value;
+   }
+}
+
+
+/*!
+* @brief Writes out the run held back by lcd_encode_rgb565q(), if there is one
+* @param[in] tmp_encoder
+* @return NONE
+*/
+void
+lcd_encode_rgb565q_end(t_lcd_rgb565q_encoder *tmp_encoder)
+{
+   if(0 < tmp_encoder->run)
+   {
+      uint8_t op = LCD_RGB565Q_OP_RUN | (tmp_encoder->run - 1);
+
+      lcd_encode_rgb565q_op(&op, 1, tmp_encoder);
+      tmp_encoder->run = 0;
+   }
+}
+
+
+
+
+/*
+****************************************************
+********** Private Function Definitions ************
+****************************************************
+*/
+
+/*!
+* @brief Sends the same pixel to the LCD bus a number of times
+* @param[in] pixel_value
+* @param[in] repeat
+* @return  NONE
+*
+* @warning LCD must be in data mode with the window set, unless an image is being composited
+*/
+void
+lcd_send_rgb565q_pixels(uint16_t pixel_value, uint32_t repeat)
+{
+   if(lcd_display_list_is_compositing())
+   {
+      lcd_display_list_composite_pixels(pixel_value, repeat);
+      return;
+   }
+
+   for(; 0 < repeat; repeat--)
+   {
+      lcd_bus_write(pixel_value >> 8);
+      lcd_bus_write(pixel_value & 0xFF);
+   }
+}
+
+
+/*!
+* @brief Appends one op to the encoded data
+* @param[in] tmp_op
+* @param[in] op_length
+* @param[in] tmp_encoder is_full is set instead once data is out of room
+* @return NONE
+*/
+void
+lcd_encode_rgb565q_op(const uint8_t *tmp_op, uint8_t op_length, t_lcd_rgb565q_encoder *tmp_encoder)
+{
+   if(tmp_encoder->capacity < (tmp_encoder->bytes + op_length))
+   {
+      tmp_encoder->is_full = 1;
+      return;
+   }
+
+   memcpy(&tmp_encoder->data[tmp_encoder->bytes], tmp_op, op_length);
+   tmp_encoder->bytes += op_length;
+}
+
+/* end of file */
@@ -0,0 +1,1029 @@
+/** @file lcd_sd_stream.c
+*
+* @brief  This file streams images and animations from the SD card to the LCD. Blocks are
+*         read by DMA while the ones before them are sent
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#include "lcd_sd_stream.h"
+
+
+/*
+****************************************************
+***** Private Types and Structure Definitions ******
+****************************************************
+*/
+//Place in a multiple block read of an animation entry or interlaced image, see lcd_sd_reader_start()
+typedef struct t_lcd_sd_reader_tag
+{
+   uint32_t block_number;  //Block of the file in image_block_buffers[current_buffer]
+   uint32_t last_block;
+   uint16_t position;      //Next byte of that block
+   uint8_t current_buffer;
+   uint8_t is_failed;      //1 once the card missed a data token, nothing more is read
+
+} t_lcd_sd_reader;
+
+
+//Multiple block read left running between the images of lcd_images_from_sd()
+typedef struct t_lcd_sd_batch_tag
+{
+   uint8_t is_open;     //Images are being drawn as a batch
+   uint8_t is_reading;  //The read of the last image is still running
+   uint32_t next_block; //Card address of the block it sends next, its token not yet received
+
+} t_lcd_sd_batch;
+
+
+/*
+****************************************************
+************* File-Static Variables ****************
+****************************************************
+*/
+//SD blocks for lcd_image_from_sd(). DMA fills one while the other is sent to the LCD
+static uint8_t image_block_buffers[2][LCD_SD_BLOCK_DMA_BYTES] = {0};
+static t_lcd_sd_batch sd_batch = {0};
+
+//Passes of an interlaced image: first row, rows between two of the pass and rows each one is drawn over
+static const uint8_t interlace_first_row[LCD_INTERLACE_PASSES] = {0, 4, 2, 1};
+static const uint8_t interlace_row_step[LCD_INTERLACE_PASSES] = {8, 8, 4, 2};
+static const uint8_t interlace_row_height[LCD_INTERLACE_PASSES] = {8, 4, 2, 1};
+static uint8_t interlace_line[LCD_WIDTH * 2] = {0}; //One row of an interlaced image, sent once for each row it covers
+
+
+/*
+****************************************************
+********** Private Function Prototypes *************
+****************************************************
+*/
+void lcd_stream_interlaced_image(uint16_t x_in, uint16_t y_in, uint16_t x_fin, uint16_t y_fin, uint16_t image_column,
+                                 uint16_t image_row, uint16_t image_width, uint32_t memory_starting_address, uint8_t is_reading);
+void lcd_drain_rgb565(const uint8_t *tmp_data, uint16_t tmp_bytes);
+void lcd_drain_bmp(const uint8_t *tmp_data, uint16_t tmp_bytes, uint8_t *tmp_color_buffer, uint8_t *tmp_color_number);
+void lcd_sd_reader_start(t_lcd_sd_reader *tmp_reader, uint32_t memory_starting_address, uint32_t first_byte, uint32_t last_byte);
+void lcd_sd_reader_prefetch(t_lcd_sd_reader *tmp_reader);
+void lcd_sd_reader_next_block(t_lcd_sd_reader *tmp_reader);
+void lcd_sd_reader_copy(t_lcd_sd_reader *tmp_reader, uint8_t *tmp_data, uint16_t tmp_bytes);
+void lcd_sd_reader_send(t_lcd_sd_reader *tmp_reader, uint32_t tmp_bytes);
+void lcd_sd_reader_skip(t_lcd_sd_reader *tmp_reader, uint32_t tmp_bytes);
+void lcd_sd_reader_stop(void);
+uint8_t lcd_sd_batch_seek(uint32_t memory_starting_address);
+void lcd_sd_batch_stop(void);
+
+
+/*
+****************************************************
+********** Public Function Definitions *************
+****************************************************
+*/
+
+/*!
+* @brief Sends image from SD card to LCD 
+* @param[in] x_in Initial X position
+* @param[in] y_in Initial Y position
+* @param[in] x_fin Final X position
+* @param[in] y_fin Final Y position
+* @param[in] memory_starting_address Memory block location of the image on the SD card
+* @return NONE
+*
+* @note Images pre-converted to the RGB565 container (see lcd.h) are copied straight to
+*       the LCD, compressed ones are decoded block by block as they arrive. Anything else is
+*       treated as a 24-bit .BMP and converted on the fly.
+*/
+void
+lcd_image_from_sd(uint16_t x_in ,uint16_t y_in,uint16_t x_fin ,uint16_t y_fin, uint32_t memory_starting_address)
+{
+   //The window is the whole image, so image rows are as wide as the window
+   lcd_stream_image_from_sd(x_in, y_in, x_fin, y_fin, 0, 0, x_fin - x_in, memory_starting_address);
+}
+
+
+/*!
+* @brief Sends part of an image from the SD card to the LCD, e.g. what a popup was covering
+* @param[in] x_in Initial X position of the part
+* @param[in] y_in Initial Y position of the part
+* @param[in] x_fin Final X position of the part
+* @param[in] y_fin Final Y position of the part
+* @param[in] image_x X position the whole image is drawn at
+* @param[in] image_y Y position the whole image is drawn at
+* @param[in] memory_starting_address Memory block location of the image on the SD card
+* @return NONE
+*
+* @note Only the blocks holding rows of the part are read, so the cost follows the area
+*       drawn instead of the size of the image. Compressed images can only be decoded from
+*       the start, they stop after the last row of the part.
+* @warning The part must lie inside the image
+*/
+void
+lcd_image_region_from_sd(uint16_t x_in, uint16_t y_in, uint16_t x_fin, uint16_t y_fin,
+                         uint16_t image_x, uint16_t image_y, uint32_t memory_starting_address)
+{
+   lcd_stream_image_from_sd(x_in, y_in, x_fin, y_fin, x_in - image_x, y_in - image_y, 0, memory_starting_address);
+}
+
+
+/*!
+* @brief Sends several images from the SD card to the LCD, e.g. the icons of a menu
+* @param[in] tmp_images Drawn in this order
+* @param[in] image_count
+* @return NONE
+*
+* @note Each image leaves its multiple block read running. When the next one starts at the
+*       block after it, or at most LCD_SD_BATCH_GAP_BLOCKS further on, the read carries on
+*       into it instead of being stopped and started again, so images stored one after the
+*       other on the card cost one command and one read latency between them. List them in
+*       card order to get the most out of it.
+*/
+void
+lcd_images_from_sd(const t_lcd_image_blit *tmp_images, uint8_t image_count)
+{
+   lcd_sd_batch_begin();
+
+   for(uint8_t current_image = 0; current_image < image_count; current_image++)
+   {
+      const t_lcd_image_blit *p_image = &tmp_images[current_image];
+
+      lcd_image_from_sd(p_image->x_initial, p_image->y_initial, p_image->x_final, p_image->y_final, p_image->address);
+   }
+
+   lcd_sd_batch_end();
+}
+
+
+/*!
+* @brief Reads the entry table of a delta animation so its frames can be drawn
+* @param[out] tmp_animation Playback state, passed to lcd_animation_draw_next()
+* @param[in] x X position of the top left corner of the animation
+* @param[in] y Y position of the top left corner of the animation
+* @param[in] memory_starting_address Memory block location of the animation on the SD card
+* @return Number of pictures, 0 if there is no delta animation at that address
+*
+* @note See LCD_ANIMATION_* in lcd_sd_stream.h for the format
+*/
+uint8_t
+lcd_animation_open(t_lcd_animation *tmp_animation, uint16_t x, uint16_t y, uint32_t memory_starting_address)
+{
+   const uint8_t *p_header = image_block_buffers[0];
+
+   memset(tmp_animation, 0, sizeof(*tmp_animation));
+
+   //Cards written before the file was added have no address for it
+   if(0 == memory_starting_address)
+   {
+      return(0);
+   }
+
+   sd_read_block(image_block_buffers[0], memory_starting_address);
+
+   uint8_t pictures = p_header[LCD_BMP_COMPRESSION_LOCATION];
+   uint32_t data_offset = p_header[LCD_BMP_OFFSET_LOCATION - 1]; //Low byte is enough
+
+   if((LCD_ANIMATION_SIGNATURE_0 != p_header[0]) || (LCD_ANIMATION_SIGNATURE_1 != p_header[1]) ||
+      (0 == pictures) || (LCD_ANIMATION_MAX_PICTURES < pictures))
+   {
+      return(0);
+   }
+
+   //One entry per picture, one more to loop back to the first and the end of the data
+   for(uint8_t current_entry = 0; current_entry < (pictures + 2); current_entry++)
+   {
+      const uint8_t *p_offset = &p_header[data_offset + (current_entry * 4)];
+
+      tmp_animation->entry_offsets[current_entry] = (uint32_t)p_offset[0] | ((uint32_t)p_offset[1] << 8) |
+                                                    ((uint32_t)p_offset[2] << 16) | ((uint32_t)p_offset[3] << 24);
+   }
+
+   tmp_animation->address = memory_starting_address;
+   tmp_animation->x = x;
+   tmp_animation->y = y;
+   tmp_animation->pictures = pictures;
+
+   return(pictures);
+}
+
+
+/*!
+* @brief Draws the next frame of a delta animation. The first call draws the first picture
+*        whole, every following one only the rectangles that changed since the previous frame.
+*        After the last picture it starts over at the first
+* @param[in] tmp_animation Opened by lcd_animation_open()
+* @return Picture on the screen now, 0 for the first
+*
+* @warning The animation must be the only thing drawn in its area between frames. It is always
+*          drawn straight away, even while a display list is open
+*/
+uint8_t
+lcd_animation_draw_next(t_lcd_animation *tmp_animation)
+{
+   uint8_t current_entry = tmp_animation->next_entry;
+   uint8_t rectangle[LCD_ANIMATION_RECTANGLE_BYTES] = {0};
+   t_lcd_sd_reader reader;
+
+   lcd_sd_reader_start(&reader, tmp_animation->address, tmp_animation->entry_offsets[current_entry],
+                       tmp_animation->entry_offsets[current_entry + 1]);
+
+   lcd_sd_reader_copy(&reader, rectangle, 2);
+   uint16_t rectangles = rectangle[0] | (rectangle[1] << 8);
+
+   //Select LCD
+   lcd_select();
+
+   for(uint16_t current_rectangle = 0; (current_rectangle < rectangles) && !reader.is_failed; current_rectangle++)
+   {
+      lcd_sd_reader_copy(&reader, rectangle, LCD_ANIMATION_RECTANGLE_BYTES);
+
+      if(reader.is_failed)
+      {
+         break;
+      }
+
+      uint16_t x = tmp_animation->x + (rectangle[0] | (rectangle[1] << 8));
+      uint16_t y = tmp_animation->y + (rectangle[2] | (rectangle[3] << 8));
+      uint16_t width = rectangle[4] | (rectangle[5] << 8);
+      uint16_t height = rectangle[6] | (rectangle[7] << 8);
+
+      //The pixels of the previous rectangle may still be going out
+      lcd_dma_wait();
+      lcd_set_window_address(x, y, x + width - 1, y + height - 1);
+      gpio_pin_set(LCD_RS);
+
+      lcd_add_pixels_pushed((uint32_t)width * height);
+      lcd_sd_reader_send(&reader, (uint32_t)width * height * 2);
+   }
+
+   lcd_sd_reader_stop();
+
+   //Deselect LCD
+   gpio_pin_set(LCD_CS);
+
+   //The entry after the last picture leads back to the first, the loop goes on from there
+   tmp_animation->next_entry = (current_entry < tmp_animation->pictures) ? (current_entry + 1) : 1;
+
+   return((current_entry < tmp_animation->pictures) ? current_entry : 0);
+}
+
+
+/*!
+* @brief Streams a rectangle of an SD card image to the LCD
+* @param[in] x_in Initial X position
+* @param[in] y_in Initial Y position
+* @param[in] x_fin Final X position
+* @param[in] y_fin Final Y position
+* @param[in] image_column Column of the image drawn at x_in
+* @param[in] image_row Row of the image drawn at y_in
+* @param[in] image_width Pixels in each image row, 0 to take it from the header
+* @param[in] memory_starting_address Memory block location of the image on the SD card
+* @return NONE
+*
+* @note Blocks are received by DMA into two ping-pong buffers. While one block is being
+*       clocked in, the previous one is drained to the LCD bus, so the image takes about as
+*       long as the slower of the two transfers instead of their sum. With LCD_DMA_ENABLED,
+*       RGB565 rows go out through lcd_dma_send(), otherwise every format is sent by the CPU.
+* @note Raw images are read from the block holding the first pixel of the rectangle to the
+*       one holding its last, and only the bytes of its rows are sent. The gaps between rows
+*       are read rather than skipped, stopping and restarting a multiple block read costs
+*       about a block and the gap between two rows of a 320 pixel wide image is smaller.
+*/
+void
+lcd_stream_image_from_sd(uint16_t x_in, uint16_t y_in, uint16_t x_fin, uint16_t y_fin, uint16_t image_column,
+                         uint16_t image_row, uint16_t image_width, uint32_t memory_starting_address)
+{
+   uint16_t window_width = x_fin - x_in;
+   uint16_t rows_left = y_fin - y_in;
+   uint32_t total_pixels = ((uint32_t)window_width * rows_left);
+   uint8_t current_buffer = 0;
+
+   //Record instead of drawing while a display list is open
+   if(lcd_display_list_add_sd_image(x_in, y_in, x_fin, y_fin, image_column, image_row, image_width, memory_starting_address))
+   {
+      return;
+   }
+
+   //Block 0 holds the header, it must arrive before anything can be drawn. From the top of the
+   //image it is the start of the read, further down it is read on its own
+   uint8_t is_reading = (0 == image_row);
+   uint8_t is_token_received = 0; //The multiple block read was started for the next block
+
+   if(is_reading)
+   {
+      //Carry on with the read left running by the image before it in a batch
+      if(!lcd_sd_batch_seek(memory_starting_address))
+      {
+         sd_read_multiple_block(memory_starting_address);
+      }
+
+      spi_dma_receive_start(image_block_buffers[0], LCD_SD_BLOCK_DMA_BYTES);
+      spi_dma_receive_wait();
+   }
+
+   else
+   {
+      lcd_sd_batch_stop();
+      sd_read_block(image_block_buffers[0], memory_starting_address);
+   }
+
+   //Interlaced rows are not in screen order, they are placed one at a time
+   if((LCD_RGB565I_SIGNATURE_0 == image_block_buffers[0][0]) && (LCD_RGB565I_SIGNATURE_1 == image_block_buffers[0][1]))
+   {
+      lcd_stream_interlaced_image(x_in, y_in, x_fin, y_fin, image_column, image_row, image_width, memory_starting_address, is_reading);
+      return;
+   }
+
+   //The LCD is only needed from here on, so the header is read while a fill sent in the
+   //background finishes
+   lcd_select();
+
+   //Pixels of an image being composited are collected a row at a time, see lcd_display_list_composite_pixels()
+   if(!lcd_display_list_is_compositing())
+   {
+      //Set upper left corner of image as starting address
+      lcd_set_window_address(x_in, y_in, x_fin - 1, y_fin - 1);
+      lcd_add_pixels_pushed(total_pixels);
+
+      //Put LCD in data mode
+      gpio_pin_set(LCD_RS); //LCD_RS=1;
+   }
+
+   const uint8_t *p_header = image_block_buffers[0];
+   uint8_t is_rgb565 = ((LCD_RGB565_SIGNATURE_0 == p_header[0]) && (LCD_RGB565_SIGNATURE_1 == p_header[1]));
+   uint8_t is_rgb565q = ((LCD_RGB565Q_SIGNATURE_0 == p_header[0]) && (LCD_RGB565Q_SIGNATURE_1 == p_header[1]));
+   uint8_t pixel_bytes = (is_rgb565 ? 2 : 3);
+   uint32_t data_offset = p_header[LCD_BMP_OFFSET_LOCATION - 1]; //First image byte, low byte is enough
+
+   if(0 == image_width)
+   {
+      image_width = p_header[LCD_BMP_WIDTH_LOCATION] | (p_header[LCD_BMP_WIDTH_LOCATION + 1] << 8);
+   }
+
+   //Byte positions in the file. Each image row of the rectangle is row_bytes long and starts
+   //row_stride after the one above it
+   uint32_t row_stride = (uint32_t)image_width * pixel_bytes;
+   uint32_t row_bytes = (uint32_t)window_width * pixel_bytes;
+   uint32_t row_start = data_offset + ((uint32_t)image_row * row_stride) + ((uint32_t)image_column * pixel_bytes);
+   uint32_t span_start = row_start;
+   uint32_t last_byte = row_start + ((uint32_t)(rows_left - 1) * row_stride) + row_bytes;
+
+   t_lcd_rgb565q_decoder decoder;
+
+   //Compressed images are decoded from the first pixel, skipping what is outside the window.
+   //They carry their size, the window may also be filled before the data runs out
+   if(is_rgb565q)
+   {
+      const uint8_t *p_size = &p_header[LCD_BMP_IMAGE_SIZE_LOCATION];
+
+      memset(&decoder, 0, sizeof(decoder));
+      decoder.pixels_left = total_pixels;
+      decoder.image_width = image_width;
+      decoder.column_initial = image_column;
+      decoder.column_final = image_column + window_width;
+      decoder.rows_to_skip = image_row;
+
+      span_start = data_offset;
+      last_byte = data_offset + ((uint32_t)p_size[0] | ((uint32_t)p_size[1] << 8) | ((uint32_t)p_size[2] << 16) | ((uint32_t)p_size[3] << 24));
+   }
+
+   uint32_t block_number = is_reading ? 0 : (span_start / LCD_SD_BLOCK_BYTES); //Block in image_block_buffers[current_buffer]
+   uint32_t last_block = (last_byte - 1) / LCD_SD_BLOCK_BYTES;
+
+   //Block 0 is already here if the rectangle starts in it, otherwise start reading where it does
+   if(!is_reading && ((0 < block_number) || (block_number < last_block)))
+   {
+      if(0 == block_number)
+      {
+         sd_read_multiple_block(memory_starting_address + 1);
+         is_token_received = 1;
+      }
+
+      else
+      {
+         sd_read_multiple_block(memory_starting_address + block_number);
+         spi_dma_receive_start(image_block_buffers[0], LCD_SD_BLOCK_DMA_BYTES);
+         spi_dma_receive_wait();
+      }
+
+      is_reading = 1;
+   }
+
+   uint8_t color_buffer[3] = {0}; // blue green red
+   uint8_t color_number = 0;
+   uint8_t is_failed = 0;
+
+   while(1)
+   {
+      //Start clocking the next block into the other buffer
+      if(block_number < last_block)
+      {
+         //Burn through the CRC bits and wait until SD card sends data valid token. Without it the
+         //rest of the image is not drawn
+         if(!is_token_received && !sd_wait_read_token())
+         {
+            is_failed = 1;
+            break;
+         }
+
+         is_token_received = 0;
+
+         //The other buffer may still be going out to the LCD
+         lcd_dma_wait();
+
+         spi_dma_receive_start(image_block_buffers[current_buffer ^ 1], LCD_SD_BLOCK_DMA_BYTES);
+      }
+
+      //Drain the block that already arrived, one span of a row at a time
+      const uint8_t *p_block = image_block_buffers[current_buffer];
+      uint32_t block_start = block_number * LCD_SD_BLOCK_BYTES;
+      uint32_t block_end = block_start + LCD_SD_BLOCK_BYTES;
+
+      if(is_rgb565q)
+      {
+         if(block_end > last_byte)
+         {
+            block_end = last_byte;
+         }
+
+         lcd_drain_rgb565q(&p_block[span_start - block_start], block_end - span_start, &decoder);
+         span_start = block_end;
+      }
+
+      while(!is_rgb565q && (0 < rows_left) && (span_start < block_end))
+      {
+         uint32_t span_end = row_start + row_bytes;
+         uint32_t drain_end = (span_end < block_end) ? span_end : block_end;
+
+         if(is_rgb565)
+         {
+            lcd_drain_rgb565(&p_block[span_start - block_start], drain_end - span_start);
+         }
+
+         else
+         {
+            lcd_drain_bmp(&p_block[span_start - block_start], drain_end - span_start, color_buffer, &color_number);
+         }
+
+         span_start = drain_end;
+
+         if(drain_end == span_end)
+         {
+            rows_left--;
+            row_start += row_stride;
+            span_start = row_start;
+         }
+      }
+
+      if(block_number == last_block)
+      {
+         break;
+      }
+
+      spi_dma_receive_wait();
+      current_buffer ^= 1;
+      block_number++;
+
+      //Window full, the rest of the compressed data is not needed
+      if(is_rgb565q && (0 == decoder.pixels_left))
+      {
+         break;
+      }
+   }
+   
+   //The sd card must return an entire block. Flush the unused bytes from the last block, unless
+   //the next image of a batch may pick the read up
+   if(is_reading && sd_batch.is_open && !is_failed)
+   {
+      sd_batch.is_reading = 1;
+      sd_batch.next_block = memory_starting_address + block_number + 1;
+   }
+
+   else if(is_reading)
+   {
+      sd_stop_transmission();
+   }
+
+   //The last span is long done by now. The buffers are free for the next image
+   lcd_dma_wait();
+}
+
+
+/*!
+* @brief Lets the images drawn until lcd_sd_batch_end() share one multiple block read
+* @param[in] NONE
+* @return NONE
+*/
+void
+lcd_sd_batch_begin(void)
+{
+   sd_batch.is_open = 1;
+   sd_batch.is_reading = 0;
+}
+
+
+/*!
+* @brief Ends the batch, images are read on their own again
+* @param[in] NONE
+* @return NONE
+*/
+void
+lcd_sd_batch_end(void)
+{
+   lcd_sd_batch_stop();
+   sd_batch.is_open = 0;
+}
+
+
+
+
+/*
+****************************************************
+********** Private Function Definitions ************
+****************************************************
+*/
+
+/*!
+* @brief Streams a rectangle of an interlaced SD card image to the LCD, see LCD_RGB565I_* in lcd_sd_stream.h
+* @param[in] x_in Initial X position
+* @param[in] y_in Initial Y position
+* @param[in] x_fin Final X position
+* @param[in] y_fin Final Y position
+* @param[in] image_column Column of the image drawn at x_in
+* @param[in] image_row Row of the image drawn at y_in
+* @param[in] image_width Pixels in each image row, 0 to take it from the header
+* @param[in] memory_starting_address Memory block location of the image on the SD card
+* @param[in] is_reading 1 if a multiple block read of the image is running with block 0 in
+*                       image_block_buffers[0], 0 if block 0 was read on its own
+* @return NONE
+*
+* @note The file is read in order up to the last row of the rectangle. Each row gets a window
+*       as tall as the rows it stands in for, and is sent that many times from interlace_line,
+*       so the first pass covers the rectangle and the later ones sharpen it. Rows of an image
+*       being composited are only sent once, to their own row.
+*/
+void
+lcd_stream_interlaced_image(uint16_t x_in, uint16_t y_in, uint16_t x_fin, uint16_t y_fin, uint16_t image_column,
+                            uint16_t image_row, uint16_t image_width, uint32_t memory_starting_address, uint8_t is_reading)
+{
+   const uint8_t *p_header = image_block_buffers[0];
+   uint16_t window_width = x_fin - x_in;
+   uint16_t row_final = image_row + (y_fin - y_in); //Image row below the rectangle
+   uint16_t image_height = p_header[LCD_BMP_HEIGHT_LOCATION] | (p_header[LCD_BMP_HEIGHT_LOCATION + 1] << 8);
+   uint32_t data_offset = p_header[LCD_BMP_OFFSET_LOCATION - 1]; //First image byte, low byte is enough
+
+   if(0 == image_width)
+   {
+      image_width = p_header[LCD_BMP_WIDTH_LOCATION] | (p_header[LCD_BMP_WIDTH_LOCATION + 1] << 8);
+   }
+
+   if(row_final > image_height)
+   {
+      row_final = image_height;
+   }
+
+   uint32_t row_stride = (uint32_t)image_width * 2;
+   uint32_t row_bytes = (uint32_t)window_width * 2;
+   uint32_t column_offset = (uint32_t)image_column * 2;
+
+   //Rows are numbered in file order. The read ends with the last one of the rectangle
+   uint16_t file_row = 0;
+   uint16_t last_file_row = 0;
+
+   for(uint8_t pass = 0; pass < LCD_INTERLACE_PASSES; pass++)
+   {
+      for(uint16_t row = interlace_first_row[pass]; row < image_height; row += interlace_row_step[pass])
+      {
+         if((row >= image_row) && (row < row_final))
+         {
+            last_file_row = file_row;
+         }
+
+         file_row++;
+      }
+   }
+
+   uint32_t last_byte = data_offset + ((uint32_t)last_file_row * row_stride) + column_offset + row_bytes;
+   t_lcd_sd_reader reader;
+
+   //From the top of the image the read is already running, take it over
+   if(is_reading)
+   {
+      reader.block_number = 0;
+      reader.last_block = (last_byte - 1) / LCD_SD_BLOCK_BYTES;
+      reader.position = data_offset;
+      reader.current_buffer = 0;
+      reader.is_failed = 0;
+
+      lcd_sd_reader_prefetch(&reader);
+   }
+
+   else
+   {
+      lcd_sd_reader_start(&reader, memory_starting_address, data_offset, last_byte);
+   }
+
+   lcd_select();
+   file_row = 0;
+
+   //A card fault leaves the rest of the image undrawn
+   for(uint8_t pass = 0; (pass < LCD_INTERLACE_PASSES) && !reader.is_failed; pass++)
+   {
+      for(uint16_t row = interlace_first_row[pass]; (row < image_height) && (file_row <= last_file_row) && !reader.is_failed; row += interlace_row_step[pass], file_row++)
+      {
+         if((row < image_row) || (row >= row_final))
+         {
+            continue;
+         }
+
+         //Move up to the first pixel of the rectangle in this row
+         uint32_t read_bytes = (reader.block_number * LCD_SD_BLOCK_BYTES) + reader.position;
+         lcd_sd_reader_skip(&reader, data_offset + ((uint32_t)file_row * row_stride) + column_offset - read_bytes);
+
+         if(reader.is_failed)
+         {
+            break;
+         }
+
+         uint16_t y = y_in + (row - image_row);
+
+         if(lcd_display_list_is_compositing())
+         {
+            lcd_display_list_composite_row(y);
+            lcd_sd_reader_send(&reader, row_bytes);
+            continue;
+         }
+
+         uint16_t row_height = interlace_row_height[pass];
+
+         if((row + row_height) > row_final)
+         {
+            row_height = row_final - row;
+         }
+
+         //The last copy of the row before it may still be going out
+         lcd_dma_wait();
+         lcd_sd_reader_copy(&reader, interlace_line, row_bytes);
+
+         lcd_set_window_address(x_in, y, x_fin - 1, y + row_height - 1);
+         gpio_pin_set(LCD_RS);
+         lcd_add_pixels_pushed((uint32_t)window_width * row_height);
+
+         for(uint16_t current_copy = 0; current_copy < row_height; current_copy++)
+         {
+            lcd_drain_rgb565(interlace_line, row_bytes);
+         }
+      }
+   }
+
+   //Ends the read and waits for the last row to go out
+   lcd_sd_reader_stop();
+}
+
+
+/*!
+* @brief Starts a multiple block read of the bytes first_byte to last_byte of a file. Blocks
+*        arrive in image_block_buffers[] by DMA, the next one while the current one is used
+* @param[out] tmp_reader
+* @param[in] memory_starting_address Memory block location of the file on the SD card
+* @param[in] first_byte
+* @param[in] last_byte Exclusive
+* @return NONE
+*
+* @warning Nothing else may use the SD card until lcd_sd_reader_stop()
+*/
+void
+lcd_sd_reader_start(t_lcd_sd_reader *tmp_reader, uint32_t memory_starting_address, uint32_t first_byte, uint32_t last_byte)
+{
+   tmp_reader->block_number = first_byte / LCD_SD_BLOCK_BYTES;
+   tmp_reader->last_block = (last_byte - 1) / LCD_SD_BLOCK_BYTES;
+   tmp_reader->position = first_byte % LCD_SD_BLOCK_BYTES;
+   tmp_reader->current_buffer = 0;
+   tmp_reader->is_failed = 0;
+
+   sd_read_multiple_block(memory_starting_address + tmp_reader->block_number);
+   spi_dma_receive_start(image_block_buffers[0], LCD_SD_BLOCK_DMA_BYTES);
+   spi_dma_receive_wait();
+
+   lcd_sd_reader_prefetch(tmp_reader);
+}
+
+
+/*!
+* @brief Starts clocking the block after the current one into the other buffer, if it is needed
+* @param[in] tmp_reader is_failed is set if the card does not send the block
+* @return NONE
+*/
+void
+lcd_sd_reader_prefetch(t_lcd_sd_reader *tmp_reader)
+{
+   if(tmp_reader->block_number < tmp_reader->last_block)
+   {
+      //Burn through the CRC bits and wait until SD card sends data valid token
+      if(!sd_wait_read_token())
+      {
+         tmp_reader->is_failed = 1;
+         return;
+      }
+
+      //The other buffer may still be going out to the LCD
+      lcd_dma_wait();
+      spi_dma_receive_start(image_block_buffers[tmp_reader->current_buffer ^ 1], LCD_SD_BLOCK_DMA_BYTES);
+   }
+}
+
+
+/*!
+* @brief Moves on to the block being clocked in
+* @param[in] tmp_reader
+* @return NONE
+*/
+void
+lcd_sd_reader_next_block(t_lcd_sd_reader *tmp_reader)
+{
+   //No block is on its way
+   if(tmp_reader->is_failed)
+   {
+      return;
+   }
+
+   spi_dma_receive_wait();
+   tmp_reader->current_buffer ^= 1;
+   tmp_reader->block_number++;
+   tmp_reader->position = 0;
+
+   lcd_sd_reader_prefetch(tmp_reader);
+}
+
+
+/*!
+* @brief Copies the next bytes of the file, e.g. a header that may be split across blocks
+* @param[in] tmp_reader
+* @param[out] tmp_data
+* @param[in] tmp_bytes
+* @return NONE
+*/
+void
+lcd_sd_reader_copy(t_lcd_sd_reader *tmp_reader, uint8_t *tmp_data, uint16_t tmp_bytes)
+{
+   for(uint16_t current_byte = 0; current_byte < tmp_bytes; current_byte++)
+   {
+      if(LCD_SD_BLOCK_BYTES == tmp_reader->position)
+      {
+         lcd_sd_reader_next_block(tmp_reader);
+
+         if(tmp_reader->is_failed)
+         {
+            return;
+         }
+      }
+
+      tmp_data[current_byte] = image_block_buffers[tmp_reader->current_buffer][tmp_reader->position];
+      tmp_reader->position++;
+   }
+}
+
+
+/*!
+* @brief Sends the next bytes of the file to the LCD as RGB565 pixels
+* @param[in] tmp_reader
+* @param[in] tmp_bytes
+* @return NONE
+*
+* @warning LCD must be in data mode with the window set
+*/
+void
+lcd_sd_reader_send(t_lcd_sd_reader *tmp_reader, uint32_t tmp_bytes)
+{
+   while(0 < tmp_bytes)
+   {
+      if(LCD_SD_BLOCK_BYTES == tmp_reader->position)
+      {
+         lcd_sd_reader_next_block(tmp_reader);
+
+         if(tmp_reader->is_failed)
+         {
+            return;
+         }
+      }
+
+      uint16_t span_bytes = LCD_SD_BLOCK_BYTES - tmp_reader->position;
+
+      if(tmp_bytes < span_bytes)
+      {
+         span_bytes = tmp_bytes;
+      }
+
+      lcd_drain_rgb565(&image_block_buffers[tmp_reader->current_buffer][tmp_reader->position], span_bytes);
+      tmp_reader->position += span_bytes;
+      tmp_bytes -= span_bytes;
+   }
+}
+
+
+/*!
+* @brief Moves past bytes of the file without using them
+* @param[in] tmp_reader
+* @param[in] tmp_bytes
+* @return NONE
+*/
+void
+lcd_sd_reader_skip(t_lcd_sd_reader *tmp_reader, uint32_t tmp_bytes)
+{
+   while(0 < tmp_bytes)
+   {
+      if(LCD_SD_BLOCK_BYTES == tmp_reader->position)
+      {
+         lcd_sd_reader_next_block(tmp_reader);
+
+         if(tmp_reader->is_failed)
+         {
+            return;
+         }
+      }
+
+      uint16_t span_bytes = LCD_SD_BLOCK_BYTES - tmp_reader->position;
+
+      if(tmp_bytes < span_bytes)
+      {
+         span_bytes = tmp_bytes;
+      }
+
+      tmp_reader->position += span_bytes;
+      tmp_bytes -= span_bytes;
+   }
+}
+
+
+/*!
+* @brief Ends the multiple block read once the last block has arrived
+* @param[in] NONE
+* @return NONE
+*/
+void
+lcd_sd_reader_stop(void)
+{
+   //The sd card must return an entire block. Flush the unused bytes from the last block
+   sd_stop_transmission();
+
+   //The buffers are free for the next image once the last span is out
+   lcd_dma_wait();
+}
+
+
+/*!
+* @brief Moves the read left running by the last image of the batch on to the first block of
+*        the next one, receiving and dropping the blocks in between
+* @param[in] memory_starting_address Memory block location of the next image on the SD card
+* @return 1 if its data token has been received, 0 if it must be read from scratch
+*/
+uint8_t
+lcd_sd_batch_seek(uint32_t memory_starting_address)
+{
+   if(!sd_batch.is_reading)
+   {
+      return(0);
+   }
+
+   //The card only reads forward, and far ahead a new command is quicker
+   if((memory_starting_address < sd_batch.next_block) ||
+      ((memory_starting_address - sd_batch.next_block) > LCD_SD_BATCH_GAP_BLOCKS))
+   {
+      lcd_sd_batch_stop();
+      return(0);
+   }
+
+   while(1)
+   {
+      //Burn through the CRC bits and wait until SD card sends data valid token. Without it the
+      //image is read from scratch
+      if(!sd_wait_read_token())
+      {
+         lcd_sd_batch_stop();
+         return(0);
+      }
+
+      if(memory_starting_address == sd_batch.next_block)
+      {
+         break;
+      }
+
+      spi_dma_receive_start(image_block_buffers[0], LCD_SD_BLOCK_DMA_BYTES);
+      spi_dma_receive_wait();
+      sd_batch.next_block++;
+   }
+
+   //The image owns the read now
+   sd_batch.is_reading = 0;
+
+   return(1);
+}
+
+
+/*!
+* @brief Ends the read left running by the last image of the batch, if there is one
+* @param[in] NONE
+* @return NONE
+*/
+void
+lcd_sd_batch_stop(void)
+{
+   if(sd_batch.is_reading)
+   {
+      //The sd card must return an entire block. Flush the unused bytes from the last block
+      sd_stop_transmission();
+      sd_batch.is_reading = 0;
+   }
+}
+
+
+/*!
+* @brief Copies pre-converted RGB565 bytes to the LCD bus
+* @param[in] tmp_data High byte of the first pixel first
+* @param[in] tmp_bytes
+* @return  NONE
+*
+* @warning LCD must be in data mode with the window set, unless an image is being composited
+*/
+void
+lcd_drain_rgb565(const uint8_t *tmp_data, uint16_t tmp_bytes)
+{
+   if(lcd_display_list_is_compositing())
+   {
+      lcd_display_list_composite_bytes(tmp_data, tmp_bytes);
+      return;
+   }
+
+   //Long spans go out in the background while the next block is clocked in from the SD card
+   if(LCD_DMA_ENABLED && (LCD_DMA_MIN_BYTES <= tmp_bytes))
+   {
+      lcd_dma_send(tmp_data, tmp_bytes, 0);
+      return;
+   }
+
+   //Short ones by the CPU, after any span still being sent
+   lcd_dma_wait();
+
+   for(uint16_t current_byte = 0; current_byte < tmp_bytes; current_byte++)
+   {
+      lcd_bus_write(tmp_data[current_byte]);
+   }
+}
+
+
+/*!
+* @brief Converts 24-bit .BMP bytes to RGB565 and sends them to the LCD bus
+* @param[in] tmp_data Blue, green, red bytes
+* @param[in] tmp_bytes
+* @param[in] tmp_color_buffer Three member array holding a pixel split across blocks
+* @param[in] tmp_color_number Bytes of that pixel received so far
+* @return  NONE
+*
+* @warning LCD must be in data mode with the window set, unless an image is being composited
+*/
+void
+lcd_drain_bmp(const uint8_t *tmp_data, uint16_t tmp_bytes, uint8_t *tmp_color_buffer, uint8_t *tmp_color_number)
+{
+   for(uint16_t current_byte = 0; current_byte < tmp_bytes; current_byte++)
+   {
+      tmp_color_buffer[*tmp_color_number] = tmp_data[current_byte];
+      (*tmp_color_number)++;
+
+      if(3 == *tmp_color_number)
+      {
+         uint8_t byte_high = (tmp_color_buffer[2] & 0xF8) | (tmp_color_buffer[1] >> 5);
+         uint8_t byte_low = ((tmp_color_buffer[1] & 0x1C) << 3) | (tmp_color_buffer[0] >> 3);
+
+         if(lcd_display_list_is_compositing())
+         {
+            lcd_display_list_composite_pixels((byte_high << 8) | byte_low, 1);
+         }
+
+         else
+         {
+            lcd_bus_write(byte_high);
+            lcd_bus_write(byte_low);
+         }
+
+         *tmp_color_number = 0;
+      }
+   }
+}
+
+/* end of file */
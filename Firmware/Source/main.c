@@ -28,12 +28,25 @@
 
 #include "main.h"
 
+/*
+****************************************************
+******************* RAM Budget *********************
+****************************************************
+*/
+//The STM32F410 has 32 KB of SRAM and nothing is allocated at run time. The linker script ends the
+//static variables at _ebss and starts the stack at _estack, growing down towards them
+extern uint8_t _ebss;
+extern uint8_t _estack;
+
+#define MAIN_STACK_BYTES 4096 //Audio playback and the startup file search each go about 2.5 KB deep
+
 /*
 ****************************************************
 ********** Private Function Prototypes *************
 ****************************************************
 */
 void main_peripherals_init(void);
+void main_check_stack_room(void);
 
 
 
@@ -67,11 +80,21 @@ main(void)
       //Poll for any LCD touch detections, and update positions if needed
       touch_update_position();
 
-      //See if any status bar icons have changed value, or if the background needs to be redrawn
-      gui_update_status_bar();
+      //Draw the next frame of any animation that is due, e.g. the boot or shutdown animation
+      gui_animation_update();
 
-      //See if the background color of the footer has changed, and if it needs to be redrawn
-      states_update_footer();
+      //The boot and shutdown animations cover the status bar and footer while they play
+      if(!gui_animation_owns_screen())
+      {
+         //See if any status bar icons have changed value, or if the background needs to be redrawn
+         gui_update_status_bar();
+
+         //See if the background color of the footer has changed, and if it needs to be redrawn
+         states_update_footer();
+
+         //Redraw the parts of the status bar and footer that were invalidated above
+         gui_compositor_flush();
+      }
 
       //Get the current main system event and transition to the appropriate main state accordingly
       states_update_main_event();
@@ -97,6 +120,9 @@ main_peripherals_init(void)
    //Init UART for the UART to USB for serial communication
    uart1_init(BR_PRESCALER_115200); //Set UART1 to 115200 baud rate. For alternatives see uart.h
 
+   //Stop here if the static buffers have grown into the stack
+   main_check_stack_room();
+
    //Init SPI2 for communication with SD card and do an initial handshake with the card
    spi_spi2_init();
    microsd_init();
@@ -130,4 +156,23 @@ main_peripherals_init(void)
    spi_set_clk_high_speed();
 }
 
+/*!
+* @brief Checks the room the linker left between the static variables and the top of the stack
+* @param[in] NONE
+* @return NONE
+*
+* @warning Hangs after reporting over UART if it is under MAIN_STACK_BYTES. The stack would
+*          otherwise run over the end of .bss and corrupt buffers without a trace
+*/
+void
+main_check_stack_room(void)
+{
+   if(((uint32_t)(uintptr_t)&_estack - (uint32_t)(uintptr_t)&_ebss) < MAIN_STACK_BYTES)
+   {
+      uart1_printf("Static variables leave the stack less than MAIN_STACK_BYTES \n\r\0");
+
+      while(1) {}
+   }
+}
+
 /*** end of file ***/
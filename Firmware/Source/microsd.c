@@ -47,12 +47,26 @@ typedef enum e_sd_file_type
 typedef struct t_sd_file
 {
    const e_sd_file_type type;
+   const char *name; //In SD_ASSET_DIRECTORY
    const uint8_t identifier[5];
    uint32_t address;
    uint32_t size;
 
 } t_sd_file;
 
+//The cheat sheet fields are laid out for a fixed number of files, adding files must not let
+//them run into each other. The table is 1023 bytes, its second block starts at byte 511
+_Static_assert((SD_ADDRESS_LIST_OFFSET + (max_total_addresses * 4)) <= SD_ADDRESS_FORMAT_OFFSET,
+               "File addresses overlap SD_ADDRESS_FORMAT_TAG");
+_Static_assert((SD_ADDRESS_SIZE_OFFSET + (max_total_addresses * 2)) <= SD_ADDRESS_TYPE_OFFSET,
+               "WAV sizes overlap the file types");
+_Static_assert((SD_ADDRESS_TYPE_OFFSET + max_total_addresses) <= 1023,
+               "File types do not fit in the two cheat sheet blocks");
+
+//sd_scan_file_addresses() keeps file + 1 in a uint8_t hash slot
+_Static_assert(max_total_addresses < SD_SEARCH_SLOT_FOUND, "Too many files for the search hash slots");
+_Static_assert((max_total_addresses * 2) <= SD_SEARCH_HASH_SLOTS, "SD_SEARCH_HASH_SLOTS is under twice the file count");
+
 /*
 ****************************************************
 ************* File-Static Variables ****************
@@ -63,158 +77,160 @@ typedef struct t_sd_file
 //@warning The file order must match with the list in enum_sd_file_list.h
 static t_sd_file file_list[max_total_addresses] =
 {
-      {.type = bmp_file, .identifier = {0x00, 0x00, 0x00, 0x00, 0x00}, .address = 0}, //null_address
+      {.type = bmp_file, .name = NULL, .identifier = {0x00, 0x00, 0x00, 0x00, 0x00}, .address = 0},
 
       /*** App Company ***/
-      {.type = wav_file, .identifier = {0x25, 0x78, 0x99, 0x1B, 0x65}, .address = 0}, //company_audio
-      {.type = bmp_file, .identifier = {0x25, 0x78, 0x99, 0x1B, 0x66}, .address = 0}, //company_image
+      {.type = wav_file, .name = "company_audio.wav", .identifier = {0x25, 0x78, 0x99, 0x1B, 0x65}, .address = 0},
+      {.type = bmp_file, .name = "company_image.bmp", .identifier = {0x25, 0x78, 0x99, 0x1B, 0x66}, .address = 0},
 
       /*** Core System Files ***/
-      {.type = wav_file, .identifier = {0x42, 0x7A, 0x97, 0x8D, 0x99}, .address = 0}, //menu_button_audio
-      {.type = bmp_file, .identifier = {0x11, 0x03, 0x35, 0xBD, 0xF8}, .address = 0}, //homescreen_picture
-      {.type = bmp_file, .identifier = {0x58, 0x48, 0xD0, 0x5F, 0x00}, .address = 0}, //startup_animation_0
-      {.type = bmp_file, .identifier = {0x58, 0x48, 0xD0, 0x5F, 0x01}, .address = 0}, //startup_animation_1
-      {.type = bmp_file, .identifier = {0x58, 0x48, 0xD0, 0x5F, 0x02}, .address = 0}, //startup_animation_2
-      {.type = bmp_file, .identifier = {0x58, 0x48, 0xD0, 0x5F, 0x03}, .address = 0}, //startup_animation_3
-      {.type = bmp_file, .identifier = {0x58, 0x48, 0xD0, 0x5F, 0x04}, .address = 0}, //startup_animation_4
-      {.type = bmp_file, .identifier = {0x58, 0x48, 0xD0, 0x5F, 0x05}, .address = 0}, //startup_animation_5
-      {.type = bmp_file, .identifier = {0x58, 0x48, 0xD0, 0x5F, 0x06}, .address = 0}, //startup_animation_6
-      {.type = bmp_file, .identifier = {0x58, 0x48, 0xD0, 0x5F, 0x07}, .address = 0}, //startup_animation_7
-      {.type = bmp_file, .identifier = {0x58, 0x48, 0xD0, 0x5F, 0x08}, .address = 0}, //startup_animation_8
-      {.type = bmp_file, .identifier = {0x58, 0x48, 0xD0, 0x5F, 0x09}, .address = 0}, //startup_animation_9
-      {.type = bmp_file, .identifier = {0x58, 0x48, 0xD0, 0x5F, 0x0A}, .address = 0}, //startup_animation_10
-      {.type = bmp_file, .identifier = {0x58, 0x48, 0xD0, 0x5F, 0x0B}, .address = 0}, //startup_animation_11
-      {.type = bmp_file, .identifier = {0x58, 0x48, 0xD0, 0x5F, 0x0C}, .address = 0}, //startup_animation_12 This is the startup title
+      {.type = wav_file, .name = "menu_button_audio.wav", .identifier = {0x42, 0x7A, 0x97, 0x8D, 0x99}, .address = 0},
+      {.type = bmp_file, .name = "homescreen_picture.bmp", .identifier = {0x11, 0x03, 0x35, 0xBD, 0xF8}, .address = 0},
+      {.type = bmp_file, .name = "startup_animation_0.bmp", .identifier = {0x58, 0x48, 0xD0, 0x5F, 0x00}, .address = 0},
+      {.type = bmp_file, .name = "startup_animation_1.bmp", .identifier = {0x58, 0x48, 0xD0, 0x5F, 0x01}, .address = 0},
+      {.type = bmp_file, .name = "startup_animation_2.bmp", .identifier = {0x58, 0x48, 0xD0, 0x5F, 0x02}, .address = 0},
+      {.type = bmp_file, .name = "startup_animation_3.bmp", .identifier = {0x58, 0x48, 0xD0, 0x5F, 0x03}, .address = 0},
+      {.type = bmp_file, .name = "startup_animation_4.bmp", .identifier = {0x58, 0x48, 0xD0, 0x5F, 0x04}, .address = 0},
+      {.type = bmp_file, .name = "startup_animation_5.bmp", .identifier = {0x58, 0x48, 0xD0, 0x5F, 0x05}, .address = 0},
+      {.type = bmp_file, .name = "startup_animation_6.bmp", .identifier = {0x58, 0x48, 0xD0, 0x5F, 0x06}, .address = 0},
+      {.type = bmp_file, .name = "startup_animation_7.bmp", .identifier = {0x58, 0x48, 0xD0, 0x5F, 0x07}, .address = 0},
+      {.type = bmp_file, .name = "startup_animation_8.bmp", .identifier = {0x58, 0x48, 0xD0, 0x5F, 0x08}, .address = 0},
+      {.type = bmp_file, .name = "startup_animation_9.bmp", .identifier = {0x58, 0x48, 0xD0, 0x5F, 0x09}, .address = 0},
+      {.type = bmp_file, .name = "startup_animation_10.bmp", .identifier = {0x58, 0x48, 0xD0, 0x5F, 0x0A}, .address = 0},
+      {.type = bmp_file, .name = "startup_animation_11.bmp", .identifier = {0x58, 0x48, 0xD0, 0x5F, 0x0B}, .address = 0},
+      {.type = bmp_file, .name = "startup_animation_12.bmp", .identifier = {0x58, 0x48, 0xD0, 0x5F, 0x0C}, .address = 0}, //This is the startup title
 
       /*** App References ***/
-      {.type = bmp_file, .identifier = {0x15, 0x75, 0x26, 0x54, 0xC4}, .address = 0}, // person1_large
-      {.type = bmp_file, .identifier = {0x18, 0x91, 0xBA, 0xDC, 0x00}, .address = 0}, // person1_small_pressed
-      {.type = bmp_file, .identifier = {0x25, 0x51, 0x22, 0xDF, 0xD6}, .address = 0}, // person1_small_not_pressed
-      {.type = bmp_file, .identifier = {0x55, 0x68, 0x79, 0x53, 0x25}, .address = 0}, // person3_large
-      {.type = bmp_file, .identifier = {0x89, 0x28, 0xCD, 0xF9, 0x33}, .address = 0}, // person3_small_pressed
-      {.type = bmp_file, .identifier = {0x78, 0x98, 0xD9, 0x6B, 0x58}, .address = 0}, // person3_small_not_pressed
-      {.type = bmp_file, .identifier = {0xDF, 0x34, 0x97, 0xAC, 0x00}, .address = 0}, // person2_large
-      {.type = bmp_file, .identifier = {0xEA, 0xCB, 0x59, 0x56, 0x25}, .address = 0}, // person2_small_pressed
-      {.type = bmp_file, .identifier = {0xBE, 0x52, 0x32, 0x87, 0x62}, .address = 0}, // person2_small_not_pressed
-      {.type = bmp_file, .identifier = {0x62, 0x55, 0x20, 0x99, 0x01}, .address = 0}, //person4_large
-      {.type = bmp_file, .identifier = {0x62, 0x55, 0x20, 0x99, 0x02}, .address = 0}, //person4_small_pressed
-      {.type = bmp_file, .identifier = {0x62, 0x55, 0x20, 0x99, 0x03}, .address = 0}, //person4_small_not_pressed
+      {.type = bmp_file, .name = "person1_large.bmp", .identifier = {0x15, 0x75, 0x26, 0x54, 0xC4}, .address = 0},
+      {.type = bmp_file, .name = "person1_small_pressed.bmp", .identifier = {0x18, 0x91, 0xBA, 0xDC, 0x00}, .address = 0},
+      {.type = bmp_file, .name = "person1_small_not_pressed.bmp", .identifier = {0x25, 0x51, 0x22, 0xDF, 0xD6}, .address = 0},
+      {.type = bmp_file, .name = "person3_large.bmp", .identifier = {0x55, 0x68, 0x79, 0x53, 0x25}, .address = 0},
+      {.type = bmp_file, .name = "person3_small_pressed.bmp", .identifier = {0x89, 0x28, 0xCD, 0xF9, 0x33}, .address = 0},
+      {.type = bmp_file, .name = "person3_small_not_pressed.bmp", .identifier = {0x78, 0x98, 0xD9, 0x6B, 0x58}, .address = 0},
+      {.type = bmp_file, .name = "person2_large.bmp", .identifier = {0xDF, 0x34, 0x97, 0xAC, 0x00}, .address = 0},
+      {.type = bmp_file, .name = "person2_small_pressed.bmp", .identifier = {0xEA, 0xCB, 0x59, 0x56, 0x25}, .address = 0},
+      {.type = bmp_file, .name = "person2_small_not_pressed.bmp", .identifier = {0xBE, 0x52, 0x32, 0x87, 0x62}, .address = 0},
+      {.type = bmp_file, .name = "person4_large.bmp", .identifier = {0x62, 0x55, 0x20, 0x99, 0x01}, .address = 0},
+      {.type = bmp_file, .name = "person4_small_pressed.bmp", .identifier = {0x62, 0x55, 0x20, 0x99, 0x02}, .address = 0},
+      {.type = bmp_file, .name = "person4_small_not_pressed.bmp", .identifier = {0x62, 0x55, 0x20, 0x99, 0x03}, .address = 0},
 
       /*** App Contact ***/
-      {.type = bmp_file, .identifier = {0x54, 0x99, 0x98, 0x75, 0x00}, .address = 0}, // aaron_large
-      {.type = bmp_file, .identifier = {0xDF, 0xA3, 0x77, 0x86, 0x51}, .address = 0}, //github_logo_light
+      {.type = bmp_file, .name = "aaron_large.bmp", .identifier = {0x54, 0x99, 0x98, 0x75, 0x00}, .address = 0},
+      {.type = bmp_file, .name = "github_logo_light.bmp", .identifier = {0xDF, 0xA3, 0x77, 0x86, 0x51}, .address = 0},
 
       /*** App Skills ***/
-      {.type = bmp_file, .identifier = {0xDF, 0xA3, 0x77, 0x86, 0x50}, .address = 0}, // github_logo
-      {.type = bmp_file, .identifier = {0x65, 0x4D, 0x6F, 0x45, 0x80}, .address = 0}, // linkedin_logo
-      {.type = bmp_file, .identifier = {0xDA, 0x52, 0x55, 0x96, 0xD0}, .address = 0}, // skills_arm
-      {.type = bmp_file, .identifier = {0x65, 0x20, 0x02, 0x02, 0x98}, .address = 0}, // skills_circuit
-      {.type = bmp_file, .identifier = {0x58, 0xAD, 0xFD, 0xFC, 0x54}, .address = 0}, // skills_c
-      {.type = bmp_file, .identifier = {0xEC, 0x89, 0x81, 0x16, 0x51}, .address = 0}, // skills_equipment
-      {.type = bmp_file, .identifier = {0x65, 0x18, 0x9D, 0xAF, 0x10}, .address = 0}, // skills_pcb
-      {.type = bmp_file, .identifier = {0x55, 0x5D, 0x5A, 0xF5, 0x15}, .address = 0}, // skills_solder
+      {.type = bmp_file, .name = "github_logo.bmp", .identifier = {0xDF, 0xA3, 0x77, 0x86, 0x50}, .address = 0},
+      {.type = bmp_file, .name = "linkedin_logo.bmp", .identifier = {0x65, 0x4D, 0x6F, 0x45, 0x80}, .address = 0},
+      {.type = bmp_file, .name = "skills_arm.bmp", .identifier = {0xDA, 0x52, 0x55, 0x96, 0xD0}, .address = 0},
+      {.type = bmp_file, .name = "skills_circuit.bmp", .identifier = {0x65, 0x20, 0x02, 0x02, 0x98}, .address = 0},
+      {.type = bmp_file, .name = "skills_c.bmp", .identifier = {0x58, 0xAD, 0xFD, 0xFC, 0x54}, .address = 0},
+      {.type = bmp_file, .name = "skills_equipment.bmp", .identifier = {0xEC, 0x89, 0x81, 0x16, 0x51}, .address = 0},
+      {.type = bmp_file, .name = "skills_pcb.bmp", .identifier = {0x65, 0x18, 0x9D, 0xAF, 0x10}, .address = 0},
+      {.type = bmp_file, .name = "skills_solder.bmp", .identifier = {0x55, 0x5D, 0x5A, 0xF5, 0x15}, .address = 0},
 
       /*** App Portfolio ***/
-      {.type = bmp_file, .identifier = {0x56, 0x72, 0x93, 0x05, 0xDF}, .address = 0}, //slide_portfolio_acq_adc
-      {.type = bmp_file, .identifier = {0xAB, 0x99, 0x8B, 0xE0, 0x00}, .address = 0}, //slide_portfolio_acq_bode
-      {.type = bmp_file, .identifier = {0xBE, 0xA0, 0x92, 0x34, 0x80}, .address = 0}, //slide_portfolio_acq_breadboard
-      {.type = bmp_file, .identifier = {0x98, 0x45, 0x60, 0x98, 0x45}, .address = 0}, //slide_portfolio_acq_gui
-      {.type = bmp_file, .identifier = {0x00, 0x78, 0x50, 0x65, 0x40}, .address = 0}, //slide_portfolio_acq_filter
-      {.type = bmp_file, .identifier = {0x21, 0x54, 0x55, 0x41, 0x25}, .address = 0}, //slide_portfolio_acq_memory
-      {.type = bmp_file, .identifier = {0x65, 0x74, 0x88, 0x77, 0x45}, .address = 0}, //slide_portfolio_fobo_code
-      {.type = bmp_file, .identifier = {0x20, 0x50, 0x40, 0x55, 0x01}, .address = 0}, //slide_portfolio_fobo_standing
-      {.type = bmp_file, .identifier = {0xEE, 0x65, 0x94, 0xE5, 0x00}, .address = 0}, //slide_portfolio_fobo_fritzing
-      {.type = bmp_file, .identifier = {0x01, 0x10, 0x25, 0x80, 0xFF}, .address = 0}, //slide_portfolio_fobo_leg
-      {.type = bmp_file, .identifier = {0x76, 0x45, 0x65, 0x4E, 0x0F}, .address = 0}, //slide_portfolio_tamogatchi_code
-      {.type = bmp_file, .identifier = {0x31, 0x25, 0x61, 0x10, 0x01}, .address = 0}, //slide_portfolio_tamogatchi_case
-      {.type = bmp_file, .identifier = {0x98, 0x45, 0x25, 0x20, 0x00}, .address = 0}, //slide_portfolio_tamogatchi_pcb3D
-      {.type = bmp_file, .identifier = {0x87, 0x95, 0x22, 0x54, 0x20}, .address = 0}, //slide_portfolio_tamogatchi_pcbactual
-      {.type = bmp_file, .identifier = {0xAA, 0xBE, 0xF1, 0x58, 0x50}, .address = 0}, //slide_portfolio_tamogatchi_perf
-      {.type = bmp_file, .identifier = {0xBA, 0xC0, 0x09, 0x82, 0x80}, .address = 0}, //slide_portfolio_other_candy_main
-      {.type = bmp_file, .identifier = {0x04, 0x05, 0x50, 0x56, 0x44}, .address = 0}, //slide_portfolio_other_candy_minor
-      {.type = bmp_file, .identifier = {0x00, 0x07, 0x8B, 0xEF, 0xA0}, .address = 0}, //slide_portfolio_other_workshop
-      {.type = bmp_file, .identifier = {0x51, 0x56, 0x16, 0x51, 0x21}, .address = 0}, //slide_portfolio_other_UA741
-      {.type = bmp_file, .identifier = {0x65, 0x1F, 0xCA, 0x58, 0x00}, .address = 0}, //slide_portfolio_other_recorder
+      {.type = bmp_file, .name = "slide_portfolio_acq_adc.bmp", .identifier = {0x56, 0x72, 0x93, 0x05, 0xDF}, .address = 0},
+      {.type = bmp_file, .name = "slide_portfolio_acq_bode.bmp", .identifier = {0xAB, 0x99, 0x8B, 0xE0, 0x00}, .address = 0},
+      {.type = bmp_file, .name = "slide_portfolio_acq_breadboard.bmp", .identifier = {0xBE, 0xA0, 0x92, 0x34, 0x80}, .address = 0},
+      {.type = bmp_file, .name = "slide_portfolio_acq_gui.bmp", .identifier = {0x98, 0x45, 0x60, 0x98, 0x45}, .address = 0},
+      {.type = bmp_file, .name = "slide_portfolio_acq_filter.bmp", .identifier = {0x00, 0x78, 0x50, 0x65, 0x40}, .address = 0},
+      {.type = bmp_file, .name = "slide_portfolio_acq_memory.bmp", .identifier = {0x21, 0x54, 0x55, 0x41, 0x25}, .address = 0},
+      {.type = bmp_file, .name = "slide_portfolio_fobo_code.bmp", .identifier = {0x65, 0x74, 0x88, 0x77, 0x45}, .address = 0},
+      {.type = bmp_file, .name = "slide_portfolio_fobo_standing.bmp", .identifier = {0x20, 0x50, 0x40, 0x55, 0x01}, .address = 0},
+      {.type = bmp_file, .name = "slide_portfolio_fobo_fritzing.bmp", .identifier = {0xEE, 0x65, 0x94, 0xE5, 0x00}, .address = 0},
+      {.type = bmp_file, .name = "slide_portfolio_fobo_leg.bmp", .identifier = {0x01, 0x10, 0x25, 0x80, 0xFF}, .address = 0},
+      {.type = bmp_file, .name = "slide_portfolio_tamogatchi_code.bmp", .identifier = {0x76, 0x45, 0x65, 0x4E, 0x0F}, .address = 0},
+      {.type = bmp_file, .name = "slide_portfolio_tamogatchi_case.bmp", .identifier = {0x31, 0x25, 0x61, 0x10, 0x01}, .address = 0},
+      {.type = bmp_file, .name = "slide_portfolio_tamogatchi_pcb3D.bmp", .identifier = {0x98, 0x45, 0x25, 0x20, 0x00}, .address = 0},
+      {.type = bmp_file, .name = "slide_portfolio_tamogatchi_pcbactual.bmp", .identifier = {0x87, 0x95, 0x22, 0x54, 0x20}, .address = 0},
+      {.type = bmp_file, .name = "slide_portfolio_tamogatchi_perf.bmp", .identifier = {0xAA, 0xBE, 0xF1, 0x58, 0x50}, .address = 0},
+      {.type = bmp_file, .name = "slide_portfolio_other_candy_main.bmp", .identifier = {0xBA, 0xC0, 0x09, 0x82, 0x80}, .address = 0},
+      {.type = bmp_file, .name = "slide_portfolio_other_candy_minor.bmp", .identifier = {0x04, 0x05, 0x50, 0x56, 0x44}, .address = 0},
+      {.type = bmp_file, .name = "slide_portfolio_other_workshop.bmp", .identifier = {0x00, 0x07, 0x8B, 0xEF, 0xA0}, .address = 0},
+      {.type = bmp_file, .name = "slide_portfolio_other_UA741.bmp", .identifier = {0x51, 0x56, 0x16, 0x51, 0x21}, .address = 0},
+      {.type = bmp_file, .name = "slide_portfolio_other_recorder.bmp", .identifier = {0x65, 0x1F, 0xCA, 0x58, 0x00}, .address = 0},
 
       /*** App Portfolio Audio ***/
-      {.type = wav_file, .identifier = {0x63, 0x49, 0x53, 0x83, 0x63}, .address = 0}, //portfolio_fobo1_audio
-      {.type = wav_file, .identifier = {0x42, 0x41, 0x48, 0x50, 0x47}, .address = 0}, //portfolio_fobo2_audio
-      {.type = wav_file, .identifier = {0x37, 0x47, 0x57, 0x69, 0x96}, .address = 0}, //portfolio_fobo3_audio
-      {.type = wav_file, .identifier = {0x71, 0x70, 0x84, 0x78, 0x99}, .address = 0}, //portfolio_fobo4_audio
-      {.type = wav_file, .identifier = {0x39, 0x38, 0x75, 0x80, 0x35}, .address = 0}, //portfolio_gameboard1_audio
-      {.type = wav_file, .identifier = {0x45, 0x54, 0x64, 0x46, 0x97}, .address = 0}, //portfolio_gameboard2_audio
-      {.type = wav_file, .identifier = {0x55, 0x53, 0x72, 0x32, 0x23}, .address = 0}, //portfolio_gameboard3_audio
-      {.type = wav_file, .identifier = {0x82, 0x28, 0xA6, 0x4F, 0x76}, .address = 0}, //portfolio_gameboard4_audio
-      {.type = wav_file, .identifier = {0x67, 0x54, 0x25, 0x9B, 0x4B}, .address = 0}, //portfolio_gameboard5_audio
-      {.type = wav_file, .identifier = {0x76, 0x72, 0x65, 0x89, 0x91}, .address = 0}, //portfolio_data1_audio
-      {.type = wav_file, .identifier = {0x72, 0x66, 0x59, 0x45, 0x77}, .address = 0}, //portfolio_data2_audio
-      {.type = wav_file, .identifier = {0x88, 0x78, 0x56, 0x6E, 0x6F}, .address = 0}, //portfolio_data3_audio
-      {.type = wav_file, .identifier = {0x55, 0x80, 0x90, 0x91, 0x85}, .address = 0}, //portfolio_data4_audio
-      {.type = wav_file, .identifier = {0x69, 0x77, 0x88, 0x99, 0x40}, .address = 0}, //portfolio_data5_audio
-      {.type = wav_file, .identifier = {0x46, 0x49, 0x88, 0x59, 0x95}, .address = 0}, //portfolio_data6_audio
-      {.type = wav_file, .identifier = {0x7D, 0x80, 0x7B, 0x76, 0x79}, .address = 0}, //portfolio_candymain_audio
-      {.type = wav_file, .identifier = {0x80, 0x7B, 0x76, 0x81, 0x7D}, .address = 0}, //portfolio_candy3D_audio
-      {.type = wav_file, .identifier = {0x81, 0x75, 0x7B, 0x72, 0x73}, .address = 0}, //portfolio_workshop_audio
-      {.type = wav_file, .identifier = {0x72, 0x70, 0x82, 0x70, 0x73}, .address = 0}, //portfolio_ua741_audio
-      {.type = wav_file, .identifier = {0x71, 0x72, 0x78, 0x74, 0x84}, .address = 0}, //portfolio_voice_audio
+      {.type = wav_file, .name = "portfolio_fobo1_audio.wav", .identifier = {0x63, 0x49, 0x53, 0x83, 0x63}, .address = 0},
+      {.type = wav_file, .name = "portfolio_fobo2_audio.wav", .identifier = {0x42, 0x41, 0x48, 0x50, 0x47}, .address = 0},
+      {.type = wav_file, .name = "portfolio_fobo3_audio.wav", .identifier = {0x37, 0x47, 0x57, 0x69, 0x96}, .address = 0},
+      {.type = wav_file, .name = "portfolio_fobo4_audio.wav", .identifier = {0x71, 0x70, 0x84, 0x78, 0x99}, .address = 0},
+      {.type = wav_file, .name = "portfolio_gameboard1_audio.wav", .identifier = {0x39, 0x38, 0x75, 0x80, 0x35}, .address = 0},
+      {.type = wav_file, .name = "portfolio_gameboard2_audio.wav", .identifier = {0x45, 0x54, 0x64, 0x46, 0x97}, .address = 0},
+      {.type = wav_file, .name = "portfolio_gameboard3_audio.wav", .identifier = {0x55, 0x53, 0x72, 0x32, 0x23}, .address = 0},
+      {.type = wav_file, .name = "portfolio_gameboard4_audio.wav", .identifier = {0x82, 0x28, 0xA6, 0x4F, 0x76}, .address = 0},
+      {.type = wav_file, .name = "portfolio_gameboard5_audio.wav", .identifier = {0x67, 0x54, 0x25, 0x9B, 0x4B}, .address = 0},
+      {.type = wav_file, .name = "portfolio_data1_audio.wav", .identifier = {0x76, 0x72, 0x65, 0x89, 0x91}, .address = 0},
+      {.type = wav_file, .name = "portfolio_data2_audio.wav", .identifier = {0x72, 0x66, 0x59, 0x45, 0x77}, .address = 0},
+      {.type = wav_file, .name = "portfolio_data3_audio.wav", .identifier = {0x88, 0x78, 0x56, 0x6E, 0x6F}, .address = 0},
+      {.type = wav_file, .name = "portfolio_data4_audio.wav", .identifier = {0x55, 0x80, 0x90, 0x91, 0x85}, .address = 0},
+      {.type = wav_file, .name = "portfolio_data5_audio.wav", .identifier = {0x69, 0x77, 0x88, 0x99, 0x40}, .address = 0},
+      {.type = wav_file, .name = "portfolio_data6_audio.wav", .identifier = {0x46, 0x49, 0x88, 0x59, 0x95}, .address = 0},
+      {.type = wav_file, .name = "portfolio_candymain_audio.wav", .identifier = {0x7D, 0x80, 0x7B, 0x76, 0x79}, .address = 0},
+      {.type = wav_file, .name = "portfolio_candy3D_audio.wav", .identifier = {0x80, 0x7B, 0x76, 0x81, 0x7D}, .address = 0},
+      {.type = wav_file, .name = "portfolio_workshop_audio.wav", .identifier = {0x81, 0x75, 0x7B, 0x72, 0x73}, .address = 0},
+      {.type = wav_file, .name = "portfolio_ua741_audio.wav", .identifier = {0x72, 0x70, 0x82, 0x70, 0x73}, .address = 0},
+      {.type = wav_file, .name = "portfolio_voice_audio.wav", .identifier = {0x71, 0x72, 0x78, 0x74, 0x84}, .address = 0},
 
       /*** App Languages ****/
-      {.type = bmp_file, .identifier = {0xEC, 0xB3, 0x51, 0x65, 0x50}, .address = 0}, //languages_main_screen
-      {.type = wav_file, .identifier = {0x01, 0x28, 0x15, 0x72, 0x02}, .address = 0}, //german_audio
-      {.type = wav_file, .identifier = {0x01, 0x28, 0x15, 0x72, 0x03}, .address = 0}, //spanish_audio
-      {.type = bmp_file, .identifier = {0x01, 0x28, 0x15, 0x72, 0x04}, .address = 0}, //german_image
-      {.type = bmp_file, .identifier = {0x01, 0x28, 0x15, 0x72, 0x05}, .address = 0}, //spanish_image
+      {.type = bmp_file, .name = "languages_main_screen.bmp", .identifier = {0xEC, 0xB3, 0x51, 0x65, 0x50}, .address = 0},
+      {.type = wav_file, .name = "german_audio.wav", .identifier = {0x01, 0x28, 0x15, 0x72, 0x02}, .address = 0},
+      {.type = wav_file, .name = "spanish_audio.wav", .identifier = {0x01, 0x28, 0x15, 0x72, 0x03}, .address = 0},
+      {.type = bmp_file, .name = "german_image.bmp", .identifier = {0x01, 0x28, 0x15, 0x72, 0x04}, .address = 0},
+      {.type = bmp_file, .name = "spanish_image.bmp", .identifier = {0x01, 0x28, 0x15, 0x72, 0x05}, .address = 0},
 
       /*** App About Me ***/
-      {.type = bmp_file, .identifier = {0x58, 0x45, 0x56, 0x45, 0x22}, .address = 0}, //about_me_main_menu
-      {.type = bmp_file, .identifier = {0x68, 0x55, 0x98, 0x45, 0x00}, .address = 0}, //about_me_main_education
-      {.type = bmp_file, .identifier = {0xAD, 0x5A, 0x20, 0x10, 0x30}, .address = 0}, //about_me_main_goals
-      {.type = bmp_file, .identifier = {0x50, 0x90, 0x19, 0x68, 0xB0}, .address = 0}, //about_me_main_hobbies
-      {.type = bmp_file, .identifier = {0x90, 0x08, 0x55, 0x46, 0xBC}, .address = 0}, //about_me_main_interests
-      {.type = bmp_file, .identifier = {0xBD, 0xEF, 0x25, 0x45, 0x50}, .address = 0}, //about_me_main_experience
-      {.type = bmp_file, .identifier = {0x48, 0x51, 0x1B, 0x56, 0x56}, .address = 0}, //about_me_sub_education
-      {.type = bmp_file, .identifier = {0x05, 0x78, 0xB0, 0x66, 0x30}, .address = 0}, //about_me_sub_goals
-      {.type = bmp_file, .identifier = {0xCD, 0x0B, 0xE5, 0x98, 0x80}, .address = 0}, //about_me_sub_hobbies
-      {.type = bmp_file, .identifier = {0x56, 0x89, 0x5A, 0x55, 0xD8}, .address = 0}, //about_me_sub_interests
-      {.type = bmp_file, .identifier = {0x01, 0xA0, 0xB0, 0xD5, 0x4D}, .address = 0}, //about_me_sub_experience
+      {.type = bmp_file, .name = "about_me_main_menu.bmp", .identifier = {0x58, 0x45, 0x56, 0x45, 0x22}, .address = 0},
+      {.type = bmp_file, .name = "about_me_main_education.bmp", .identifier = {0x68, 0x55, 0x98, 0x45, 0x00}, .address = 0},
+      {.type = bmp_file, .name = "about_me_main_goals.bmp", .identifier = {0xAD, 0x5A, 0x20, 0x10, 0x30}, .address = 0},
+      {.type = bmp_file, .name = "about_me_main_hobbies.bmp", .identifier = {0x50, 0x90, 0x19, 0x68, 0xB0}, .address = 0},
+      {.type = bmp_file, .name = "about_me_main_interests.bmp", .identifier = {0x90, 0x08, 0x55, 0x46, 0xBC}, .address = 0},
+      {.type = bmp_file, .name = "about_me_main_experience.bmp", .identifier = {0xBD, 0xEF, 0x25, 0x45, 0x50}, .address = 0},
+      {.type = bmp_file, .name = "about_me_sub_education.bmp", .identifier = {0x48, 0x51, 0x1B, 0x56, 0x56}, .address = 0},
+      {.type = bmp_file, .name = "about_me_sub_goals.bmp", .identifier = {0x05, 0x78, 0xB0, 0x66, 0x30}, .address = 0},
+      {.type = bmp_file, .name = "about_me_sub_hobbies.bmp", .identifier = {0xCD, 0x0B, 0xE5, 0x98, 0x80}, .address = 0},
+      {.type = bmp_file, .name = "about_me_sub_interests.bmp", .identifier = {0x56, 0x89, 0x5A, 0x55, 0xD8}, .address = 0},
+      {.type = bmp_file, .name = "about_me_sub_experience.bmp", .identifier = {0x01, 0xA0, 0xB0, 0xD5, 0x4D}, .address = 0},
 
       /*** App Device Images ***/
-      {.type = bmp_file, .identifier = {0x85, 0x71, 0x52, 0x33, 0x00}, .address = 0}, //slide_device_intro_drawing
-      {.type = bmp_file, .identifier = {0x85, 0x71, 0x52, 0x33, 0x01}, .address = 0}, //slide_device_intro_model
-      {.type = bmp_file, .identifier = {0x85, 0x71, 0x52, 0x33, 0x02}, .address = 0}, //slide_device_mechanical_prototype
-      {.type = bmp_file, .identifier = {0x85, 0x71, 0x52, 0x33, 0x03}, .address = 0}, //slide_device_mechanical_final
-      {.type = bmp_file, .identifier = {0x85, 0x71, 0x52, 0x33, 0x0E}, .address = 0}, //slide_device_mechanical_processing
-      {.type = bmp_file, .identifier = {0x85, 0x71, 0x52, 0x33, 0x04}, .address = 0}, //slide_device_hardware_schematic
-      {.type = bmp_file, .identifier = {0x85, 0x71, 0x52, 0x33, 0x05}, .address = 0}, //slide_device_hardware_layout
-      {.type = bmp_file, .identifier = {0x85, 0x71, 0x52, 0x33, 0x06}, .address = 0}, //slide_device_hardware_PCB
-      {.type = bmp_file, .identifier = {0x85, 0x71, 0x52, 0x33, 0x07}, .address = 0}, //slide_device_hardware_solder
-      {.type = bmp_file, .identifier = {0x85, 0x71, 0x52, 0x33, 0x08}, .address = 0}, //slide_device_hardware_firmware
-      {.type = bmp_file, .identifier = {0x85, 0x71, 0x52, 0x33, 0x09}, .address = 0}, //slide_device_hardware_jig
-      {.type = bmp_file, .identifier = {0x85, 0x71, 0x52, 0x33, 0x0A}, .address = 0}, //slide_device_product_photo
-      {.type = bmp_file, .identifier = {0x85, 0x71, 0x52, 0x33, 0x0B}, .address = 0}, //slide_device_product_box
-      {.type = bmp_file, .identifier = {0x85, 0x71, 0x52, 0x33, 0x0C}, .address = 0}, //slide_device_product_foam
-      {.type = bmp_file, .identifier = {0x85, 0x71, 0x52, 0x33, 0x0D}, .address = 0}, //slide_device_product_manual
+      {.type = bmp_file, .name = "slide_device_intro_drawing.bmp", .identifier = {0x85, 0x71, 0x52, 0x33, 0x00}, .address = 0},
+      {.type = bmp_file, .name = "slide_device_intro_model.bmp", .identifier = {0x85, 0x71, 0x52, 0x33, 0x01}, .address = 0},
+      {.type = bmp_file, .name = "slide_device_mechanical_prototype.bmp", .identifier = {0x85, 0x71, 0x52, 0x33, 0x02}, .address = 0},
+      {.type = bmp_file, .name = "slide_device_mechanical_final.bmp", .identifier = {0x85, 0x71, 0x52, 0x33, 0x03}, .address = 0},
+      {.type = bmp_file, .name = "slide_device_mechanical_processing.bmp", .identifier = {0x85, 0x71, 0x52, 0x33, 0x0E}, .address = 0},
+      {.type = bmp_file, .name = "slide_device_hardware_schematic.bmp", .identifier = {0x85, 0x71, 0x52, 0x33, 0x04}, .address = 0},
+      {.type = bmp_file, .name = "slide_device_hardware_layout.bmp", .identifier = {0x85, 0x71, 0x52, 0x33, 0x05}, .address = 0},
+      {.type = bmp_file, .name = "slide_device_hardware_PCB.bmp", .identifier = {0x85, 0x71, 0x52, 0x33, 0x06}, .address = 0},
+      {.type = bmp_file, .name = "slide_device_hardware_solder.bmp", .identifier = {0x85, 0x71, 0x52, 0x33, 0x07}, .address = 0},
+      {.type = bmp_file, .name = "slide_device_hardware_firmware.bmp", .identifier = {0x85, 0x71, 0x52, 0x33, 0x08}, .address = 0},
+      {.type = bmp_file, .name = "slide_device_hardware_jig.bmp", .identifier = {0x85, 0x71, 0x52, 0x33, 0x09}, .address = 0},
+      {.type = bmp_file, .name = "slide_device_product_photo.bmp", .identifier = {0x85, 0x71, 0x52, 0x33, 0x0A}, .address = 0},
+      {.type = bmp_file, .name = "slide_device_product_box.bmp", .identifier = {0x85, 0x71, 0x52, 0x33, 0x0B}, .address = 0},
+      {.type = bmp_file, .name = "slide_device_product_foam.bmp", .identifier = {0x85, 0x71, 0x52, 0x33, 0x0C}, .address = 0},
+      {.type = bmp_file, .name = "slide_device_product_manual.bmp", .identifier = {0x85, 0x71, 0x52, 0x33, 0x0D}, .address = 0},
 
       /*** App Device Audio ***/
-      {.type = wav_file, .identifier = {0x66, 0x25, 0x91, 0x88, 0x00}, .address = 0}, //device_start1_audio
-      {.type = wav_file, .identifier = {0x66, 0x25, 0x91, 0x88, 0x01}, .address = 0}, //device_start2_audio
-      {.type = wav_file, .identifier = {0x66, 0x25, 0x91, 0x88, 0x02}, .address = 0}, //device_mechanical1_audio
-      {.type = wav_file, .identifier = {0x66, 0x25, 0x91, 0x88, 0x03}, .address = 0}, //device_mechanical2_audio
-      {.type = wav_file, .identifier = {0x66, 0x25, 0x91, 0x88, 0x04}, .address = 0}, //device_mechanical3_audio
-      {.type = wav_file, .identifier = {0x66, 0x25, 0x91, 0x88, 0x05}, .address = 0}, //device_hwfw1_audio
-      {.type = wav_file, .identifier = {0x66, 0x25, 0x91, 0x88, 0x06}, .address = 0}, //device_hwfw2_audio
-      {.type = wav_file, .identifier = {0x66, 0x25, 0x91, 0x88, 0x07}, .address = 0}, //device_hwfw3_audio
-      {.type = wav_file, .identifier = {0x66, 0x25, 0x91, 0x88, 0x08}, .address = 0}, //device_hwfw4_audio
-      {.type = wav_file, .identifier = {0x66, 0x25, 0x91, 0x88, 0x09}, .address = 0}, //device_hwfw5_audio
-      {.type = wav_file, .identifier = {0x66, 0x25, 0x91, 0x88, 0x0A}, .address = 0}, //device_hwfw6_audio
-      {.type = wav_file, .identifier = {0x66, 0x25, 0x91, 0x88, 0x0B}, .address = 0}, //device_product1_audio
-      {.type = wav_file, .identifier = {0x66, 0x25, 0x91, 0x88, 0x0C}, .address = 0}, //device_product2_audio
-      {.type = wav_file, .identifier = {0x66, 0x25, 0x91, 0x88, 0x0D}, .address = 0}, //device_product3_audio
-      {.type = wav_file, .identifier = {0x66, 0x25, 0x91, 0x88, 0x0E}, .address = 0}, //device_product4_audio
+      {.type = wav_file, .name = "device_start1_audio.wav", .identifier = {0x66, 0x25, 0x91, 0x88, 0x00}, .address = 0},
+      {.type = wav_file, .name = "device_start2_audio.wav", .identifier = {0x66, 0x25, 0x91, 0x88, 0x01}, .address = 0},
+      {.type = wav_file, .name = "device_mechanical1_audio.wav", .identifier = {0x66, 0x25, 0x91, 0x88, 0x02}, .address = 0},
+      {.type = wav_file, .name = "device_mechanical2_audio.wav", .identifier = {0x66, 0x25, 0x91, 0x88, 0x03}, .address = 0},
+      {.type = wav_file, .name = "device_mechanical3_audio.wav", .identifier = {0x66, 0x25, 0x91, 0x88, 0x04}, .address = 0},
+      {.type = wav_file, .name = "device_hwfw1_audio.wav", .identifier = {0x66, 0x25, 0x91, 0x88, 0x05}, .address = 0},
+      {.type = wav_file, .name = "device_hwfw2_audio.wav", .identifier = {0x66, 0x25, 0x91, 0x88, 0x06}, .address = 0},
+      {.type = wav_file, .name = "device_hwfw3_audio.wav", .identifier = {0x66, 0x25, 0x91, 0x88, 0x07}, .address = 0},
+      {.type = wav_file, .name = "device_hwfw4_audio.wav", .identifier = {0x66, 0x25, 0x91, 0x88, 0x08}, .address = 0},
+      {.type = wav_file, .name = "device_hwfw5_audio.wav", .identifier = {0x66, 0x25, 0x91, 0x88, 0x09}, .address = 0},
+      {.type = wav_file, .name = "device_hwfw6_audio.wav", .identifier = {0x66, 0x25, 0x91, 0x88, 0x0A}, .address = 0},
+      {.type = wav_file, .name = "device_product1_audio.wav", .identifier = {0x66, 0x25, 0x91, 0x88, 0x0B}, .address = 0},
+      {.type = wav_file, .name = "device_product2_audio.wav", .identifier = {0x66, 0x25, 0x91, 0x88, 0x0C}, .address = 0},
+      {.type = wav_file, .name = "device_product3_audio.wav", .identifier = {0x66, 0x25, 0x91, 0x88, 0x0D}, .address = 0},
+      {.type = wav_file, .name = "device_product4_audio.wav", .identifier = {0x66, 0x25, 0x91, 0x88, 0x0E}, .address = 0},
 
       /*** App Intro ***/
-      {.type = wav_file, .identifier = {0x01, 0x28, 0x15, 0x72, 0x01}, .address = 0}, //intro_audio
+      {.type = wav_file, .name = "intro_audio.wav", .identifier = {0x01, 0x28, 0x15, 0x72, 0x01}, .address = 0},
 
+      /*** Boot Animation. Listed last so sd_append_file_addresses() can add it to existing cards ***/
+      {.type = bmp_file, .name = "startup_animation_delta.r565a", .identifier = {0x58, 0x48, 0xD0, 0x5F, 0x0D}, .address = 0},
 
 };
 
@@ -234,8 +250,19 @@ uint8_t sd_interface_condition_sequence(void);
 uint8_t sd_read_ocr(void);
 uint8_t sd_send_operating_condition(void);
 void sd_cmd24_termination_sequence(void);
+uint8_t sd_wait_data_response(void);
+uint8_t sd_wait_while_busy(void);
+void sd_write_file_table(uint8_t *tmp_table);
 void sd_import_file_addresses(void);
+uint16_t sd_open_file_addresses(void);
 uint32_t sd_parse_wav_header(uint32_t tmp_address);
+uint16_t sd_scan_file_addresses(e_sd_address start_address, e_sd_address stop_address);
+uint8_t sd_search_hash(uint32_t tmp_window);
+uint8_t sd_file_table_byte(const uint8_t *tmp_first_block, const uint8_t *tmp_second_block, uint16_t tmp_offset);
+uint32_t sd_file_table_address(const uint8_t *tmp_first_block, const uint8_t *tmp_second_block, uint8_t tmp_file);
+uint8_t sd_file_table_is_complete(const uint8_t *tmp_first_block, const uint8_t *tmp_second_block);
+void sd_pack_file_entry(uint8_t *tmp_table, uint8_t tmp_file);
+void sd_format_file_table(uint8_t *tmp_table);
 
 
 /*
@@ -289,6 +316,9 @@ microsd_init(void)
 
    //Check OCR to see if card is high capacity
    init_success = sd_read_ocr();
+
+   //Blocks cached from a card read before may not be on this one
+   sd_block_cache_invalidate_all();
    
    //Read the file address lookup table and send them to their corresponding structures
    sd_import_file_addresses();
@@ -313,7 +343,7 @@ sd_read_block(uint8_t *p_read_buffer, uint32_t block_address)
 {
    //Wrap CS transition in dummy bytes to make sure SD card acknowledges it
    spi_send_byte(0xFF);
-   gpio_clear(SPI2_CS);
+   gpio_pin_clear(SPI2_CS);
    spi_send_byte(0xFF);
    
    //Send CMD17, aka READ_SINGLE_BLOCK
@@ -342,7 +372,7 @@ sd_read_block(uint8_t *p_read_buffer, uint32_t block_address)
    
    //Wrap CS transition in dummy bytes to make sure SD card acknowledges it
    spi_send_byte(0xFF);
-   gpio_set(SPI2_CS);
+   gpio_pin_set(SPI2_CS);
    spi_send_byte(0xFF);
 }
 
@@ -353,14 +383,17 @@ sd_read_block(uint8_t *p_read_buffer, uint32_t block_address)
 * @param[in] tmp_write_buffer Data that will be written to the sd card
 * @param[in] block_address Address of desired block.
 * @return  NONE
+*
+* @note A cached copy of the block is dropped, use sd_block_cache_write() to keep it
 */
 void
 sd_write_block(uint8_t *tmp_write_buffer, uint32_t block_address)
 {
+   sd_block_cache_invalidate(block_address, 1);
 
    //Wrap CS transition in dummy bytes to make sure SD card acknowledges it
    spi_send_byte(0xFF);
-   gpio_clear(SPI2_CS);
+   gpio_pin_clear(SPI2_CS);
    spi_send_byte(0xFF);
 
    //Send CMD24, aka WRITE_SINGLE_BLOCK
@@ -385,10 +418,124 @@ sd_write_block(uint8_t *tmp_write_buffer, uint32_t block_address)
 
    //Wrap CS transition in dummy bytes to make sure SD card acknowledges it
    spi_send_byte(0xFF);
-   gpio_set(SPI2_CS);
+   gpio_pin_set(SPI2_CS);
    spi_send_byte(0xFF);
 }
 
+
+/*!
+* @brief Writes consecutive blocks with one CMD25, so the card programs them as a stream
+*        instead of finishing each block before the next command
+* @param[in] tmp_write_buffer tmp_blocks * 512 bytes
+* @param[in] block_address First block written
+* @param[in] tmp_blocks Number of blocks
+* @param[in] tmp_pre_erase 1 = announce the count with ACMD23 first, so the card can erase
+*                          them ahead of the data, 0 = skip it
+* @return 1 if the card accepted and programmed every block, otherwise 0
+*
+* @note A rejected block ends the write, the blocks after it are not sent
+*/
+uint8_t
+sd_write_multiple_block(const uint8_t *tmp_write_buffer, uint32_t block_address, uint32_t tmp_blocks, uint8_t tmp_pre_erase)
+{
+   uint8_t write_success = 1;
+
+   sd_block_cache_invalidate(block_address, tmp_blocks);
+
+   if(tmp_pre_erase)
+   {
+      //Tell SD card to expect an application command
+      sd_send_app_command();
+      spi_send_byte(0xFF);
+
+      //Send ACMD23, aka SET_WR_BLK_ERASE_COUNT, data = number of blocks, CRC = dummy
+      gpio_pin_clear(SPI2_CS);
+      sd_send_command(23, tmp_blocks);
+      spi_send_byte(SD_DUMMY_CRC);
+
+      //Receive R1 response
+      spi_receive_byte(0xFF); //dummy byte. SD card responds only after 8 clocks
+      sd_receive_r1_response();
+      sd_receive_r1_response();
+
+      //Wrap CS transition in dummy bytes to make sure SD card acknowledges it
+      spi_send_byte(0xFF);
+      gpio_pin_set(SPI2_CS);
+      spi_send_byte(0xFF);
+   }
+
+   //Wrap CS transition in dummy bytes to make sure SD card acknowledges it
+   spi_send_byte(0xFF);
+   gpio_pin_clear(SPI2_CS);
+   spi_send_byte(0xFF);
+
+   //Send CMD25, aka WRITE_MULTIPLE_BLOCK
+   sd_send_command(25, block_address);
+   spi_send_byte(SD_DUMMY_CRC);
+
+   //Receive R1 response
+   spi_receive_byte(0xFF); //dummy byte. SD card responds only after 8 clocks
+   sd_receive_r1_response();
+
+   if(0x00 != sd_receive_r1_response())
+   {
+      uart1_printf("CMD25 command failed \n \r\0");
+      write_success = 0;
+      tmp_blocks = 0;
+   }
+
+   for(uint32_t current_block = 0; current_block < tmp_blocks; current_block++)
+   {
+      const uint8_t *p_block = &tmp_write_buffer[current_block * 512];
+
+      //One byte gap, then the block
+      spi_send_byte(0xFF);
+      spi_send_byte(SD_CMD25_TOKEN);
+
+      for(uint16_t current_byte = 0; current_byte < 512; current_byte++)
+      {
+         spi_send_byte(p_block[current_byte]);
+      }
+
+      //CRC, not checked in SPI mode
+      spi_send_byte(0xFF);
+      spi_send_byte(0xFF);
+
+      //The data response is the byte after the CRC, so nothing may be left over from sending
+      spi_receive_flush();
+
+      if(SD_DATA_ACCEPTED != sd_wait_data_response())
+      {
+         uart1_printf("SD card rejected a block \n \r\0");
+         write_success = 0;
+         break;
+      }
+
+      if(!sd_wait_while_busy())
+      {
+         write_success = 0;
+         break;
+      }
+   }
+
+   //The stop token is needed even after a rejected block, the card is still in the write
+   spi_send_byte(0xFF);
+   spi_send_byte(SD_STOP_TRAN_TOKEN);
+   spi_send_byte(0xFF); //Busy starts one byte after the token
+
+   if(!sd_wait_while_busy())
+   {
+      write_success = 0;
+   }
+
+   //Wrap CS transition in dummy bytes to make sure SD card acknowledges it
+   spi_send_byte(0xFF);
+   gpio_pin_set(SPI2_CS);
+   spi_send_byte(0xFF);
+
+   return(write_success);
+}
+
 /*!
 * @brief Read a single block (512bytes for SDHC) from the SD card and send it over uart
 * @param[in] block_address Address of desired block. 
@@ -406,7 +553,7 @@ sd_print_block(uint64_t block_address)
    
    //Wrap CS transition in dummy bytes to make sure SD card acknowledges it
    spi_send_byte(0xFF);
-   gpio_clear(SPI2_CS);
+   gpio_pin_clear(SPI2_CS);
    spi_send_byte(0xFF);
    
    //Send CMD17, aka READ_SINGLE_BLOCK
@@ -439,7 +586,7 @@ sd_print_block(uint64_t block_address)
    
    //Wrap CS transition in dummy bytes to make sure SD card acknowledges it
    spi_send_byte(0xFF);
-   gpio_set(SPI2_CS);
+   gpio_pin_set(SPI2_CS);
    spi_send_byte(0xFF);
 }
 
@@ -456,11 +603,9 @@ sd_print_block(uint64_t block_address)
 void
 sd_read_multiple_block(uint32_t start_address)
 {
-   uint16_t response_timeout = 0;
-   
    //Wrap CS transition in dummy bytes to make sure SD card acknowledges it
    spi_send_byte(0xFF);
-   gpio_clear(SPI2_CS);
+   gpio_pin_clear(SPI2_CS);
    spi_send_byte(0xFF);
    
    //Send CMD18, aka READ_MULTIPLE_BLOCK
@@ -473,15 +618,37 @@ sd_read_multiple_block(uint32_t start_address)
    sd_receive_r1_response();
    
    //Wait for the correct token 0xFE
-   while((spi_receive_byte(0xFF) != SD_CMD17_TOKEN)) //CMD17 token is the same for CMD18
+   sd_wait_read_token();
+}
+
+
+/*!
+* @brief Waits for the data token in front of the next block of a read, for at most
+*        SD_READ_TOKEN_TIMEOUT bytes
+* @param[in] NONE
+* @return 1 once the token has arrived, 0 if the card sent a data error token or nothing at all
+*
+* @note A multiple block read that runs past the end of the card ends with an error token
+*/
+uint8_t
+sd_wait_read_token(void)
+{
+   for(uint16_t response_timeout = 0; response_timeout < SD_READ_TOKEN_TIMEOUT; response_timeout++)
    {
-      response_timeout++;
+      uint8_t response = spi_receive_byte(0xFF);
 
-      if(response_timeout > 6000)
+      if(SD_CMD17_TOKEN == response) //CMD17 token is the same for CMD18
       {
-         break;
+         return(1);
+      }
+
+      if((0x00 != response) && (0 == (response & SD_DATA_ERROR_MASK)))
+      {
+         return(0);
       }
    }
+
+   return(0);
 }
 
 
@@ -500,7 +667,7 @@ sd_find_file_address(const uint8_t *file_identifier)
    uint8_t success = 0; 
    uint32_t file_address = 0;
    
-   for(uint64_t current_block = 15000; current_block < 4294967294; current_block++) //Largest uint32_t: 4,294,967,294
+   for(uint64_t current_block = SD_SEARCH_FIRST_BLOCK; current_block < 4294967294; current_block++) //Largest uint32_t: 4,294,967,294
    {
       uint8_t buffer[512] = {0};
       //Read the entire next block (512 bytes)
@@ -537,78 +704,53 @@ sd_find_file_address(const uint8_t *file_identifier)
 
 
 /*!
-* @brief This does a brute force procedural search of the SD card looking for file identifiers.
+* @brief This searches the SD card for the identifier of every file in one pass.
 *        It then copies the start addresses of each file to a lookup table in the SD card itself
 *        at a memory block very far outside of the scope that the FAT32 file system should ever
 *        manipulate for this system.
 * @param[in] NONE
 * @return  NONE
-* @note This is very slow yet more maintainable. The function only ever runs once before flashing the main
-*       binary just to put the addresses in the sd card. It doesn't even get included in the main binary,
-*       so speed is not a great concern.
+* @note The function only ever runs once before flashing the main binary just to put the
+*       addresses in the sd card. It doesn't even get included in the main binary.
+* @note Cards with the files in SD_ASSET_DIRECTORY of a FAT32 volume do not need it, see
+*       sd_import_file_addresses()
 *
 */
 void
 sd_search_file_addresses(void)
 {
-   uint16_t total_files = max_total_addresses;
-
    lcd_draw_rectangle(0x00, 0, 0, 320, 480);
 
-   //Do a brute force search to find each file starting address
-   for(uint8_t current_file = 0; current_file < total_files; current_file++)
-   {
-      char tmp_string[10] = {0};
-
-      //Send file information to PC console
-      pft_uint32_to_string(current_file, tmp_string);
-      uart1_printf("Current file number:  ");
-      uart1_printf(tmp_string);
-      uart1_printf(" \n \r");
-
-      //Display file information on LCD
-      lcd_print_string("Current file number: ", 50, 100, 0x03E0, 0x0000);
-      lcd_print_string(tmp_string, 50, 120, 0x03E0, 0x0000);
-
-      //Search for current file address
-      file_list[current_file].address = sd_find_file_address(file_list[current_file].identifier);
-
-   }
+   sd_scan_file_addresses(null_address, max_total_addresses);
 
    uint8_t address_buffer[1024] = {0}; //Buffer to be written to the SD card file address cheat sheet block
+   sd_format_file_table(address_buffer);
 
-   total_files = (max_total_addresses)*4; // Four bytes per uint32
-
-   //Split each uint32 address into four bytes and store them in the array
+   //Store each address with the file's size and type, so startup does not have to read any file
    for(uint8_t current_file = 0; current_file < max_total_addresses; current_file ++)
    {
-      address_buffer[(current_file*4) + SD_ADDRESS_LIST_OFFSET] = (file_list[current_file].address >> 24);
-      address_buffer[(current_file*4) + SD_ADDRESS_LIST_OFFSET + 1] = (file_list[current_file].address >> 16);
-      address_buffer[(current_file*4) + SD_ADDRESS_LIST_OFFSET + 2] = (file_list[current_file].address >> 8);
-      address_buffer[(current_file*4) + SD_ADDRESS_LIST_OFFSET + 3] = (file_list[current_file].address & 0xFF);
+      sd_pack_file_entry(address_buffer, current_file);
    }
 
    //Transfer the file addresses to the cheat sheet inside the SD Card
-   sd_write_block(address_buffer, SD_ADDRESS_CHEAT_SHEET);\
-   sd_write_block((address_buffer + 511), (SD_ADDRESS_CHEAT_SHEET + 1));
+   sd_write_file_table(address_buffer);
    uart1_printf("\n\r File search complete \n \r");
    lcd_print_string("File search complete",  100, 50, 0x03E0, 0x0000);
 }
 
 
 /*!
-* @brief This does a brute force procedural search of the SD card looking for file identifiers.
+* @brief This searches the SD card for the identifiers of some of the files in one pass.
 *        It then copies the start addresses of each file and appends them to the end of the
 *        lookup table in the SD card itself, starting at the input file number
 *        at a memory block very far outside of the scope that the FAT32 file system should ever
 *        manipulate for this system.
 * @param[in] start_address The address of the first file you wish to append in the SD card's lookup table
-* @param[in] stop_address The address of the last file you wish to append in the SD card's lookup table
+* @param[in] stop_address The address after the last file you wish to append in the SD card's lookup table
 * @return  NONE
 *
-* @note This is very slow yet more maintainable. The function only ever runs once before flashing the main
-*       binary just to put the addresses in the sd card. It doesn't even get included in the main binary,
-*       so speed is not a great concern.
+* @note The function only ever runs once before flashing the main binary just to put the
+*       addresses in the sd card. It doesn't even get included in the main binary.
 *
 */
 void
@@ -616,38 +758,25 @@ sd_append_file_addresses(e_sd_address start_address, e_sd_address stop_address)
 {
    lcd_draw_rectangle(0x00, 0, 0, 320, 480);
 
-   //Do a brute force search to find each file starting address
-   for(e_sd_address current_file = start_address; current_file < stop_address; current_file++)
-   {
-      char tmp_string[10] = {0};
-      pft_uint32_to_string(current_file, tmp_string);
-      uart1_printf("Current file number:  ");
-      uart1_printf(tmp_string);
-      uart1_printf(" \n \r");
-
-      lcd_print_string("Current file number: ", 50, 100, 0x03E0, 0x0000);
-      lcd_print_string(tmp_string, 50, 120, 0x03E0, 0x0000);
+   sd_scan_file_addresses(start_address, stop_address);
 
-      //Search for current file address
-      file_list[current_file].address = sd_find_file_address(file_list[current_file].identifier);
+   uint8_t address_buffer[1024] = {0}; //Buffer to be written to the SD card file address cheat sheet block
+   sd_block_cache_read(address_buffer, SD_ADDRESS_CHEAT_SHEET, 0, 512); //Fill buffer with current addresses
+   sd_block_cache_read((address_buffer + 511), (SD_ADDRESS_CHEAT_SHEET + 1), 0, 512);
 
+   //Tables written before sizes and types were stored only hold addresses
+   if(0 != memcmp(&address_buffer[SD_ADDRESS_FORMAT_OFFSET], SD_ADDRESS_FORMAT_TAG, 4))
+   {
+      sd_format_file_table(address_buffer);
    }
 
-   uint8_t address_buffer[1024] = {0}; //Buffer to be written to the SD card file address cheat sheet block
-   sd_read_block(address_buffer, SD_ADDRESS_CHEAT_SHEET); //Fill buffer with current addresses
-   sd_read_block((address_buffer + 511), (SD_ADDRESS_CHEAT_SHEET + 1));
-
-   //Split each uint32 address into four bytes and append to the end of the array
+   //Append each address with the file's size and type
    for(uint8_t current_file = start_address; current_file < stop_address; current_file ++)
    {
-      address_buffer[(current_file*4) + SD_ADDRESS_LIST_OFFSET] = (file_list[current_file].address >> 24);
-      address_buffer[(current_file*4) + SD_ADDRESS_LIST_OFFSET + 1] = (file_list[current_file].address >> 16);
-      address_buffer[(current_file*4) + SD_ADDRESS_LIST_OFFSET + 2] = (file_list[current_file].address >> 8);
-      address_buffer[(current_file*4) + SD_ADDRESS_LIST_OFFSET + 3] = (file_list[current_file].address & 0xFF);
+      sd_pack_file_entry(address_buffer, current_file);
    }
 
-   sd_write_block(address_buffer, SD_ADDRESS_CHEAT_SHEET);
-   sd_write_block((address_buffer + 511), (SD_ADDRESS_CHEAT_SHEET + 1));
+   sd_write_file_table(address_buffer);
    uart1_printf("\n\r File search complete \n \r");
    lcd_print_string("File search complete",  100, 50, 0x03E0, 0x0000);
 }
@@ -666,7 +795,7 @@ sd_append_file_addresses(e_sd_address start_address, e_sd_address stop_address)
 void
 sd_get_file_addresses(uint32_t *tmp_file_list)
 {
-   for(e_sd_address current_file = 0; current_file < max_total_addresses; current_file++)
+   for(e_sd_address current_file = null_address; current_file < max_total_addresses; current_file++)
    {
       tmp_file_list[current_file] = file_list[current_file].address;
    }
@@ -782,7 +911,7 @@ sd_idle_sequence(void)
 {
    //Wrap CS transition in dummy bytes to make sure SD card acknowledges it
    spi_send_byte(0xFF);
-   gpio_clear(SPI2_CS);
+   gpio_pin_clear(SPI2_CS);
    spi_send_byte(0xFF);
    
    //set clock to below 400kHz
@@ -790,7 +919,7 @@ sd_idle_sequence(void)
    spi_set_clk_low_speed();
    
    //Disable CS
-   gpio_set(SPI2_CS);
+   gpio_pin_set(SPI2_CS);
    
    //Delay at least 1ms
    timers_delay(2);
@@ -804,7 +933,7 @@ sd_idle_sequence(void)
    //Enable CS
    //Wrap CS transition in dummy bytes to make sure SD card acknowledges it
    spi_send_byte(0xFF);
-   gpio_clear(SPI2_CS);
+   gpio_pin_clear(SPI2_CS);
    spi_send_byte(0xFF);
    
    //Send CMD0, data = 0, CRC = 0x95
@@ -819,7 +948,7 @@ sd_idle_sequence(void)
    
    //Wrap CS transition in dummy bytes to make sure SD card acknowledges it
    spi_send_byte(0xFF);
-   gpio_set(SPI2_CS);
+   gpio_pin_set(SPI2_CS);
    spi_send_byte(0xFF);
    
    uint8_t command0_success = 1;
@@ -852,7 +981,7 @@ sd_interface_condition_sequence(void)
 {
    //Wrap CS transition in dummy bytes to make sure SD card acknowledges it
    spi_send_byte(0xFF);
-   gpio_clear(SPI2_CS);
+   gpio_pin_clear(SPI2_CS);
    spi_send_byte(0xFF);
 
    //Send CMD8, CRC = 0x95
@@ -867,7 +996,7 @@ sd_interface_condition_sequence(void)
    
    //Wrap CS transition in dummy bytes to make sure SD card acknowledges it
    spi_send_byte(0xFF);
-   gpio_set(SPI2_CS);
+   gpio_pin_set(SPI2_CS);
    spi_send_byte(0xFF);
    
    uint8_t command8_success = 1;
@@ -897,7 +1026,7 @@ sd_read_ocr(void)
 {
    //Wrap CS transition in dummy bytes to make sure SD card acknowledges it
    spi_send_byte(0xFF);
-   gpio_clear(SPI2_CS);
+   gpio_pin_clear(SPI2_CS);
    spi_send_byte(0xFF);
 
    //Send CMD58, data = 0, CRC = dummy
@@ -912,7 +1041,7 @@ sd_read_ocr(void)
 
    //Wrap CS transition in dummy bytes to make sure SD card acknowledges it
    spi_send_byte(0xFF);
-   gpio_set(SPI2_CS);
+   gpio_pin_set(SPI2_CS);
    spi_send_byte(0xFF);
    
    uint8_t command58_success = 1;
@@ -945,7 +1074,7 @@ sd_send_app_command(void)
 {
    //Wrap CS transition in dummy bytes to make sure SD card acknowledges it
    spi_send_byte(0xFF);
-   gpio_clear(SPI2_CS);
+   gpio_pin_clear(SPI2_CS);
    spi_send_byte(0xFF);
    
    //Send CMD55, data = 0, CRC = dummy
@@ -957,7 +1086,7 @@ sd_send_app_command(void)
 
    //Wrap CS transition in dummy bytes to make sure SD card acknowledges it
    spi_send_byte(0xFF);
-   gpio_set(SPI2_CS);
+   gpio_pin_set(SPI2_CS);
    spi_send_byte(0xFF);
 }
 
@@ -976,7 +1105,7 @@ sd_send_operating_condition(void)
    spi_send_byte(0xFF);
 
    //Send ACMD41, data = 0, CRC = dummy
-   gpio_clear(SPI2_CS);
+   gpio_pin_clear(SPI2_CS);
    sd_send_command(41, SD_ACMD41_DATA);
    spi_send_byte(0x77); //crc
    
@@ -988,7 +1117,7 @@ sd_send_operating_condition(void)
 
    //Wrap CS transition in dummy bytes to make sure SD card acknowledges it
    spi_send_byte(0xFF);
-   gpio_set(SPI2_CS);
+   gpio_pin_set(SPI2_CS);
    spi_send_byte(0xFF);
    
    uint8_t command41_success = 1;
@@ -1018,7 +1147,7 @@ sd_stop_transmission(void)
 {
    //Wrap CS transition in dummy bytes to make sure SD card acknowledges it
    spi_send_byte(0xFF);
-   gpio_clear(SPI2_CS);
+   gpio_pin_clear(SPI2_CS);
    spi_send_byte(0xFF);
    
    //Send CMD12 akak STOP_TRANSMISSION, data = 0, CRC = dummy
@@ -1033,7 +1162,7 @@ sd_stop_transmission(void)
    
    //Wrap CS transition in dummy bytes to make sure SD card acknowledges it
    spi_send_byte(0xFF);
-   gpio_set(SPI2_CS);
+   gpio_pin_set(SPI2_CS);
    spi_send_byte(0xFF);
 }
 
@@ -1073,6 +1202,50 @@ sd_cmd24_termination_sequence(void)
 }
 
 
+/*!
+* @brief Waits for the data response token sent after each written block
+* @param[in] NONE
+* @return SD_DATA_ACCEPTED, 0x0B for a CRC error, 0x0D for a write error, 0xFF on timeout
+*/
+uint8_t
+sd_wait_data_response(void)
+{
+   for(uint32_t timeout = 0; timeout < SD_WRITE_TIMEOUT; timeout++)
+   {
+      uint8_t tmp_response = spi_receive_byte(0xFF);
+
+      if(0xFF != tmp_response)
+      {
+         return(tmp_response & SD_DATA_RESPONSE_MASK);
+      }
+   }
+
+   uart1_printf("Timeout error writing to SD\0");
+   return(0xFF);
+}
+
+
+/*!
+* @brief Waits while the SD card holds MISO low to program what it was sent
+* @param[in] NONE
+* @return 1 once the card is ready, 0 on timeout
+*/
+uint8_t
+sd_wait_while_busy(void)
+{
+   for(uint32_t timeout = 0; timeout < SD_WRITE_TIMEOUT; timeout++)
+   {
+      if(0x00 != spi_receive_byte(0xFF))
+      {
+         return(1);
+      }
+   }
+
+   uart1_printf("Timeout error writing to SD\0");
+   return(0);
+}
+
+
 /*!
 * @brief Read the header, contained in the first block, of a WAV file and
 *        return its file size in blocks
@@ -1083,25 +1256,18 @@ sd_cmd24_termination_sequence(void)
 uint32_t
 sd_parse_wav_header(uint32_t tmp_address)
 {
-   //Start reading the WAV file from the SD card
-   sd_read_multiple_block(tmp_address);
+   uint8_t size_bytes[4] = {0};
 
-   //Jump to file size section of header.
-   spi_receive_byte(0xFF);
-   spi_receive_byte(0xFF);
-   spi_receive_byte(0xFF);
-   spi_receive_byte(0xFF);
+   //File size section of the header, through the cache since the same header may be asked for again
+   sd_block_cache_read(size_bytes, tmp_address, 4, 4);
 
    uint32_t file_size = 0; //Size of WAV in blocks
 
    //Read file size from header. Warning, file size is little endian in WAV header
-   file_size = (uint32_t)(spi_receive_byte(0xFF));
-   file_size |= (((uint32_t)(spi_receive_byte(0xFF))) << 8);
-   file_size |= (((uint32_t)(spi_receive_byte(0xFF))) << 16);
-   file_size |= (((uint32_t)(spi_receive_byte(0xFF))) << 24);
-
-   //Stop the transmission, since we already have the file size info
-   sd_stop_transmission();
+   file_size = (uint32_t)size_bytes[0];
+   file_size |= (((uint32_t)size_bytes[1]) << 8);
+   file_size |= (((uint32_t)size_bytes[2]) << 16);
+   file_size |= (((uint32_t)size_bytes[3]) << 24);
 
    //512 bytes-per-block
    return(file_size / 512);
@@ -1109,8 +1275,170 @@ sd_parse_wav_header(uint32_t tmp_address)
 
 
 /*!
-* @brief This reads the file address lookup table from the SD card generated by
-*        sd_search_file_addresses() and stores each address in  its corresponding t_sd_file structure
+* @brief Streams the card from SD_SEARCH_FIRST_BLOCK with one CMD18 and looks for the identifiers
+*        of files start_address to stop_address - 1 at every byte at once, until all of them are
+*        found. Each file gets the first block its identifier starts in. The identifiers sit in a
+*        hash table keyed by their first 4 bytes, so each byte costs a lookup instead of a compare
+*        per file, and the next block is clocked in by DMA while the current one is searched
+* @param[in] start_address First file to look for
+* @param[in] stop_address The file after the last one to look for
+* @return Number of files found, which is only short of the count if the end of the card was reached
+*
+* @note Like sd_find_file_address(), a file whose identifier is nowhere on the card keeps the
+*       search going to the end of the card, where the card stops sending blocks or sends an
+*       error token
+*/
+uint16_t
+sd_scan_file_addresses(e_sd_address start_address, e_sd_address stop_address)
+{
+   uint8_t hash_slots[SD_SEARCH_HASH_SLOTS] = {SD_SEARCH_SLOT_EMPTY}; //File number + 1 in each slot
+   uint8_t block_buffers[2][LCD_SD_BLOCK_DMA_BYTES];
+   uint16_t files_left = 0;
+   uint16_t files_found = 0;
+
+   //Put each identifier in the first free slot from its hash on
+   for(uint8_t current_file = start_address; current_file < stop_address; current_file++)
+   {
+      const uint8_t *p_identifier = file_list[current_file].identifier;
+      uint32_t tmp_window = ((uint32_t)p_identifier[0] << 24) | ((uint32_t)p_identifier[1] << 16) |
+                            ((uint32_t)p_identifier[2] << 8) | (uint32_t)p_identifier[3];
+      uint8_t slot = sd_search_hash(tmp_window);
+
+      while(SD_SEARCH_SLOT_EMPTY != hash_slots[slot])
+      {
+         slot = (slot + 1) & (SD_SEARCH_HASH_SLOTS - 1);
+      }
+
+      hash_slots[slot] = current_file + 1;
+      file_list[current_file].address = 0;
+      files_left++;
+   }
+
+   uint32_t start_ms = timers_get_ms();
+   uint32_t current_block = SD_SEARCH_FIRST_BLOCK;
+   uint32_t tmp_window = 0;     //The 4 bytes before the current one, oldest in the top byte
+   uint8_t window_bytes = 0;    //Bytes in tmp_window so far
+   uint8_t current_buffer = 0;
+
+   sd_read_multiple_block(current_block);
+   spi_dma_receive_start(block_buffers[0], LCD_SD_BLOCK_DMA_BYTES);
+   spi_dma_receive_wait();
+
+   while(files_left)
+   {
+      //Past the last block the card sends an error token instead, this one is then the last
+      uint8_t more_blocks = (0xFFFFFFFF != current_block) && sd_wait_read_token();
+
+      //Clock the next block in while this one is searched
+      if(more_blocks)
+      {
+         spi_dma_receive_start(block_buffers[current_buffer ^ 1], LCD_SD_BLOCK_DMA_BYTES);
+      }
+
+      const uint8_t *p_block = block_buffers[current_buffer];
+
+      for(uint16_t current_byte = 0; current_byte < 512; current_byte++)
+      {
+         if(4 <= window_bytes)
+         {
+            uint8_t slot = sd_search_hash(tmp_window);
+
+            //Every file with the same hash is further along, up to the first empty slot
+            while(SD_SEARCH_SLOT_EMPTY != hash_slots[slot])
+            {
+               if(SD_SEARCH_SLOT_FOUND != hash_slots[slot])
+               {
+                  uint8_t current_file = hash_slots[slot] - 1;
+                  const uint8_t *p_identifier = file_list[current_file].identifier;
+
+                  if((p_identifier[4] == p_block[current_byte]) &&
+                     (p_identifier[0] == (uint8_t)(tmp_window >> 24)) && (p_identifier[1] == (uint8_t)(tmp_window >> 16)) &&
+                     (p_identifier[2] == (uint8_t)(tmp_window >> 8)) && (p_identifier[3] == (uint8_t)tmp_window))
+                  {
+                     //The identifier may have started in the block before
+                     file_list[current_file].address = (4 <= current_byte) ? current_block : (current_block - 1);
+                     hash_slots[slot] = SD_SEARCH_SLOT_FOUND;
+                     files_left--;
+                     files_found++;
+
+                     char tmp_string[11] = {0}; //pft_uint32_to_string() writes 10 digits and the terminator
+                     pft_uint32_to_string(files_found, tmp_string);
+                     lcd_print_string("Files found: ", 50, 100, 0x03E0, 0x0000);
+                     lcd_print_string(tmp_string, 50, 120, 0x03E0, 0x0000);
+                  }
+               }
+
+               slot = (slot + 1) & (SD_SEARCH_HASH_SLOTS - 1);
+            }
+         }
+
+         else
+         {
+            window_bytes++;
+         }
+
+         tmp_window = (tmp_window << 8) | p_block[current_byte];
+      }
+
+      if(!more_blocks)
+      {
+         break;
+      }
+
+      spi_dma_receive_wait();
+      current_buffer ^= 1;
+      current_block++;
+   }
+
+   sd_stop_transmission();
+
+   //Sizes go in the table with the addresses
+   for(uint8_t current_file = start_address; current_file < stop_address; current_file++)
+   {
+      if((wav_file == file_list[current_file].type) && (0 != file_list[current_file].address))
+      {
+         file_list[current_file].size = sd_parse_wav_header(file_list[current_file].address);
+      }
+   }
+
+   //Report how fast the card was read
+   uint32_t blocks_read = current_block - SD_SEARCH_FIRST_BLOCK + 1;
+   uint32_t elapsed_ms = timers_get_ms() - start_ms;
+   char tmp_string[11] = {0};
+
+   uart1_printf("\n\r Blocks searched: ");
+   pft_uint32_to_string(blocks_read, tmp_string);
+   uart1_printf(tmp_string);
+   uart1_printf(" in ms: ");
+   pft_uint32_to_string(elapsed_ms, tmp_string);
+   uart1_printf(tmp_string);
+   uart1_printf(", blocks/s: ");
+   pft_uint32_to_string((uint32_t)(((uint64_t)blocks_read * 1000) / ((0 != elapsed_ms) ? elapsed_ms : 1)), tmp_string);
+   uart1_printf(tmp_string);
+   uart1_printf(" \n\r");
+
+   return(files_found);
+}
+
+
+/*!
+* @brief Hash table slot an identifier starting with the 4 bytes in tmp_window belongs in
+*/
+uint8_t
+sd_search_hash(uint32_t tmp_window)
+{
+   //Fibonacci hashing, the top bits of the product mix all 4 bytes
+   return((uint8_t)((tmp_window * 2654435761u) >> 24));
+}
+
+
+/*!
+* @brief This finds every file on the SD card and stores its address in its corresponding t_sd_file
+*        structure. They are read from the file address lookup table generated by
+*        sd_search_file_addresses(), along with the sizes of the WAVs. Only when the table does
+*        not give every file an address are files looked up by name in SD_ASSET_DIRECTORY of the
+*        card's FAT32 volume, the rest still coming from the table. Only tables written before
+*        sizes were stored make it read each WAV header
 * @param[in] NONE
 * @return  NONE
 *
@@ -1119,32 +1447,271 @@ sd_parse_wav_header(uint32_t tmp_address)
 void
 sd_import_file_addresses(void)
 {
-   uint8_t tmp_read_buffer[1024] = {0};
+   uint16_t files_found = 0;
 
-   //Read the sd card address lookup table and store it in a buffer
-   sd_read_block(tmp_read_buffer, SD_ADDRESS_CHEAT_SHEET);
-   sd_read_block((tmp_read_buffer + 511), (SD_ADDRESS_CHEAT_SHEET + 1));
+   //Forget the card read before, if any
+   for(uint8_t current_file = 0; current_file < max_total_addresses; current_file++)
+   {
+      file_list[current_file].address = 0;
+   }
+
+   //A complete table is two blocks, walking the FAT32 directory and cluster chains is far more
+   const uint8_t *p_first_block = sd_block_cache_pin(SD_ADDRESS_CHEAT_SHEET);
+   const uint8_t *p_second_block = sd_block_cache_pin(SD_ADDRESS_CHEAT_SHEET + 1);
+   uint8_t table_is_complete = sd_file_table_is_complete(p_first_block, p_second_block);
+
+   //fat32.c needs the whole cache for the walk
+   sd_block_cache_unpin(SD_ADDRESS_CHEAT_SHEET);
+   sd_block_cache_unpin(SD_ADDRESS_CHEAT_SHEET + 1);
+
+   if(!table_is_complete && fat32_mount())
+   {
+      files_found = sd_open_file_addresses();
+   }
+
+   //Every entry but null_address
+   if((max_total_addresses - 1) == files_found)
+   {
+      return;
+   }
+
+   //Keep the sd card address lookup table cached while WAV headers are read through the cache
+   p_first_block = sd_block_cache_pin(SD_ADDRESS_CHEAT_SHEET);
+   p_second_block = sd_block_cache_pin(SD_ADDRESS_CHEAT_SHEET + 1);
+
+   //Older tables only hold addresses
+   uint8_t has_sizes = (0 == memcmp(&p_second_block[SD_ADDRESS_FORMAT_OFFSET - 511], SD_ADDRESS_FORMAT_TAG, 4));
 
-   //This is slower yet more maintainable. The function only runs once upon startup, so speed is not a great concern.
    for(uint8_t current_file = 0; current_file < max_total_addresses; current_file ++)
    {
-      uint32_t tmp_address = 0;
-      tmp_address = 0;
+      //Already found in the file system
+      if(0 != file_list[current_file].address)
+      {
+         continue;
+      }
+
+      file_list[current_file].address = sd_file_table_address(p_first_block, p_second_block, current_file);
 
-      for(uint8_t current_byte = 0; current_byte < 4; current_byte++)
+      if(wav_file != file_list[current_file].type)
       {
-        tmp_address |= (tmp_read_buffer[(current_file*4) + SD_ADDRESS_LIST_OFFSET + current_byte] << (24 - (8*current_byte)));
+         continue;
       }
 
-      file_list[current_file].address = tmp_address;
+      uint16_t file_size = 0;
+
+      //Trust the stored size only if the entry was written for the same kind of file
+      if(has_sizes && (wav_file == sd_file_table_byte(p_first_block, p_second_block, SD_ADDRESS_TYPE_OFFSET + current_file)))
+      {
+         file_size = ((uint16_t)sd_file_table_byte(p_first_block, p_second_block, SD_ADDRESS_SIZE_OFFSET + (current_file * 2)) << 8) |
+                     sd_file_table_byte(p_first_block, p_second_block, SD_ADDRESS_SIZE_OFFSET + (current_file * 2) + 1);
+      }
+
+      //Otherwise parse the header for file size
+      file_list[current_file].size = (0 != file_size) ? file_size : sd_parse_wav_header(file_list[current_file].address);
+   }
+
+   sd_block_cache_unpin(SD_ADDRESS_CHEAT_SHEET);
+   sd_block_cache_unpin(SD_ADDRESS_CHEAT_SHEET + 1);
+}
+
+
+/*!
+* @brief Reads a byte of the file address table from its two blocks as they are on the card
+* @param[in] tmp_first_block SD_ADDRESS_CHEAT_SHEET
+* @param[in] tmp_second_block SD_ADDRESS_CHEAT_SHEET + 1
+* @param[in] tmp_offset Byte of the table laid out as in sd_search_file_addresses(), where the
+*                       second block starts at byte 511
+* @return The byte
+*/
+uint8_t
+sd_file_table_byte(const uint8_t *tmp_first_block, const uint8_t *tmp_second_block, uint16_t tmp_offset)
+{
+   return((511 > tmp_offset) ? tmp_first_block[tmp_offset] : tmp_second_block[tmp_offset - 511]);
+}
+
+
+/*!
+* @brief Reads the address of a file from the file address table
+* @param[in] tmp_first_block SD_ADDRESS_CHEAT_SHEET
+* @param[in] tmp_second_block SD_ADDRESS_CHEAT_SHEET + 1
+* @param[in] tmp_file Entry of file_list
+* @return The file's first block
+*/
+uint32_t
+sd_file_table_address(const uint8_t *tmp_first_block, const uint8_t *tmp_second_block, uint8_t tmp_file)
+{
+   uint32_t tmp_address = 0;
+
+   for(uint8_t current_byte = 0; current_byte < 4; current_byte++)
+   {
+     tmp_address |= ((uint32_t)sd_file_table_byte(tmp_first_block, tmp_second_block, (tmp_file*4) + SD_ADDRESS_LIST_OFFSET + current_byte) << (24 - (8*current_byte)));
+   }
+
+   return(tmp_address);
+}
+
 
-      //If current file is a WAV, parse the header for file size
+/*!
+* @brief Checks that the file address table can stand in for the FAT32 lookup
+* @param[in] tmp_first_block SD_ADDRESS_CHEAT_SHEET
+* @param[in] tmp_second_block SD_ADDRESS_CHEAT_SHEET + 1
+* @return 1 if every file has an address, written for the same kind of file where the table
+*         holds types. 0 for a card that was never indexed or only partly appended to
+*/
+uint8_t
+sd_file_table_is_complete(const uint8_t *tmp_first_block, const uint8_t *tmp_second_block)
+{
+   uint8_t has_types = (0 == memcmp(&tmp_second_block[SD_ADDRESS_FORMAT_OFFSET - 511], SD_ADDRESS_FORMAT_TAG, 4));
+
+   //Skip null_address
+   for(uint8_t current_file = 1; current_file < max_total_addresses; current_file++)
+   {
+      uint32_t tmp_address = sd_file_table_address(tmp_first_block, tmp_second_block, current_file);
+
+      //Erased blocks read as all zeros or all ones
+      if((0 == tmp_address) || (0xFFFFFFFF == tmp_address))
+      {
+         return(0);
+      }
+
+      if(has_types && (file_list[current_file].type != sd_file_table_byte(tmp_first_block, tmp_second_block, SD_ADDRESS_TYPE_OFFSET + current_file)))
+      {
+         return(0);
+      }
+   }
+
+   return(1);
+}
+
+
+/*!
+* @brief Marks a file address table as holding sizes and types, none of them known yet
+* @param[in] tmp_table Cheat sheet laid out as in sd_search_file_addresses()
+* @return NONE
+*/
+void
+sd_format_file_table(uint8_t *tmp_table)
+{
+   memcpy(&tmp_table[SD_ADDRESS_FORMAT_OFFSET], SD_ADDRESS_FORMAT_TAG, 4);
+   memset(&tmp_table[SD_ADDRESS_SIZE_OFFSET], 0, max_total_addresses * 2);
+   memset(&tmp_table[SD_ADDRESS_TYPE_OFFSET], SD_ADDRESS_TYPE_UNKNOWN, max_total_addresses);
+}
+
+
+/*!
+* @brief Stores the address, size and type of a file in the file address table
+* @param[in] tmp_table Cheat sheet laid out as in sd_search_file_addresses()
+* @param[in] tmp_file Entry of file_list
+* @return NONE
+*
+* @note Sizes that do not fit in 16 bits are stored as 0, startup then reads them from the file
+*/
+void
+sd_pack_file_entry(uint8_t *tmp_table, uint8_t tmp_file)
+{
+   uint32_t tmp_address = file_list[tmp_file].address;
+   uint16_t tmp_size = (0xFFFF >= file_list[tmp_file].size) ? file_list[tmp_file].size : 0;
+
+   //Split each uint32 address into four bytes
+   tmp_table[(tmp_file*4) + SD_ADDRESS_LIST_OFFSET] = (tmp_address >> 24);
+   tmp_table[(tmp_file*4) + SD_ADDRESS_LIST_OFFSET + 1] = (tmp_address >> 16);
+   tmp_table[(tmp_file*4) + SD_ADDRESS_LIST_OFFSET + 2] = (tmp_address >> 8);
+   tmp_table[(tmp_file*4) + SD_ADDRESS_LIST_OFFSET + 3] = (tmp_address & 0xFF);
+
+   tmp_table[SD_ADDRESS_SIZE_OFFSET + (tmp_file * 2)] = (tmp_size >> 8);
+   tmp_table[SD_ADDRESS_SIZE_OFFSET + (tmp_file * 2) + 1] = (tmp_size & 0xFF);
+   tmp_table[SD_ADDRESS_TYPE_OFFSET + tmp_file] = file_list[tmp_file].type;
+}
+
+
+/*!
+* @brief Writes the file address table to the cheat sheet with one multiple block write
+* @param[in] tmp_table 1024 bytes, the cheat sheet laid out as in sd_search_file_addresses(), the
+*                      second block starting at byte 511. Shifted in place to where the card
+*                      has it, so it no longer has that layout afterwards
+* @return NONE
+*/
+void
+sd_write_file_table(uint8_t *tmp_table)
+{
+   //Byte 511 stays in the first block as well, like the two reads put it there
+   memmove(&tmp_table[512], &tmp_table[511], 512);
+
+   if(!sd_write_multiple_block(tmp_table, SD_ADDRESS_CHEAT_SHEET, 2, 1))
+   {
+      uart1_printf("File address table was not written \n \r\0");
+   }
+}
+
+
+/*!
+* @brief Read SD_ASSET_DIRECTORY once and take the address of each file in file_list from it
+* @param[in] NONE
+* @return  files_found Number of files given an address
+*
+* @note The drivers stream each file from its first block with CMD18, so a file only counts if
+*       it is one run of blocks. Copying the files to a freshly formatted card does that
+*/
+uint16_t
+sd_open_file_addresses(void)
+{
+   t_fat32_file tmp_directory;
+   t_fat32_directory tmp_iterator;
+   t_fat32_file tmp_file;
+   uint16_t files_found = 0;
+
+   if(!fat32_open(SD_ASSET_DIRECTORY, &tmp_directory) || !tmp_directory.is_directory)
+   {
+      uart1_printf("No asset directory on the SD card \n\r\0");
+      return(0);
+   }
+
+   fat32_open_directory(&tmp_directory, &tmp_iterator);
+
+   while(fat32_read_directory(&tmp_iterator, &tmp_file))
+   {
+      if(tmp_file.is_directory)
+      {
+         continue;
+      }
+
+      //Which file it is
+      uint8_t current_file = 1; //Skip null_address
+
+      while((current_file < max_total_addresses) &&
+            !fat32_names_match(tmp_iterator.name, file_list[current_file].name, strlen(tmp_iterator.name)))
+      {
+         current_file++;
+      }
+
+      if((max_total_addresses == current_file) || (0 != file_list[current_file].address))
+      {
+         continue;
+      }
+
+      uint32_t extent_address = 0;
+      uint32_t extent_blocks = 0;
+
+      if(!fat32_next_extent(&tmp_file, &extent_address, &extent_blocks) || (0 != tmp_file.blocks_left))
+      {
+         uart1_printf("File is not in one piece: ");
+         uart1_printf(tmp_iterator.name);
+         uart1_printf(" \n\r\0");
+         continue;
+      }
+
+      file_list[current_file].address = extent_address;
+
+      //The RIFF size in the header is the file size less its first 8 bytes
       if(wav_file == file_list[current_file].type)
       {
-         uint32_t file_size = sd_parse_wav_header(file_list[current_file].address);
-         file_list[current_file].size = file_size;
+         file_list[current_file].size = (tmp_file.size - 8) / 512;
       }
+
+      files_found++;
    }
+
+   return(files_found);
 }
 
 #pragma GCC pop_options
@@ -0,0 +1,333 @@
+/** @file sd_block_cache.c
+*
+* @brief  This file keeps recently read SD card blocks in a fixed number of 512-byte slots of RAM.
+*         When every slot is taken, the block used longest ago is replaced, unless it is pinned.
+*         Writes go to the card straight away, so the card never holds older data than the cache.
+* @author Aaron Vorse
+* @date   10/17/2026
+* @contact aaron.vorse@embeddedresume.com
+*
+* @LICENSE:
+*
+*  Licensed to the Apache Software Foundation (ASF) under one
+*  or more contributor license agreements.  See the NOTICE file
+*  distributed with this work for additional information
+*  regarding copyright ownership.  The ASF licenses this file
+*  to you under the Apache License, Version 2.0 (the
+*  "License"); you may not use this file except in compliance
+*  with the License.  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing,
+*  software distributed under the License is distributed on an
+*  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+*  KIND, either express or implied.  See the License for the
+*  specific language governing permissions and limitations
+*  under the License.
+*/
+
+#include "sd_block_cache.h"
+
+
+/*
+****************************************************
+***** Private Types and Structure Definitions ******
+****************************************************
+*/
+typedef struct t_sd_block_cache_entry_tag
+{
+   uint32_t block_address; //Only meaningful while the block is valid or pinned
+   uint32_t last_use;      //Value of block_cache_clock when the block was last read
+   uint8_t pins;           //Pins held on the block, it is never evicted while above 0
+   uint8_t is_valid;       //0 if the data has to be read again, a pinned slot keeps its block
+
+} t_sd_block_cache_entry;
+
+
+/*
+****************************************************
+************* File-Static Variables ****************
+****************************************************
+*/
+static uint8_t block_cache_data[SD_BLOCK_CACHE_SLOTS][SD_BLOCK_CACHE_BLOCK_BYTES] = {0};
+static t_sd_block_cache_entry block_cache_entries[SD_BLOCK_CACHE_SLOTS] = {0};
+static uint32_t block_cache_clock = 0;
+
+static uint32_t block_cache_hits = 0;
+static uint32_t block_cache_misses = 0;
+static uint32_t block_cache_evictions = 0;
+static uint32_t block_cache_invalidations = 0;
+
+
+/*
+****************************************************
+********** Private Function Prototypes *************
+****************************************************
+*/
+uint8_t sd_block_cache_find(uint32_t block_address);
+uint8_t sd_block_cache_load(uint32_t block_address);
+
+
+/*
+****************************************************
+********** Public Function Definitions *************
+****************************************************
+*/
+
+/*!
+* @brief Find a block in the cache, reading it from the card if it is not there
+* @param[in] block_address
+* @return The 512 bytes of the block
+*
+* @note The pointer is valid until SD_BLOCK_CACHE_SLOTS other blocks have been read, or the block
+*       is written. Pin the block to keep it longer
+*/
+const uint8_t *
+sd_block_cache_get(uint32_t block_address)
+{
+   return(block_cache_data[sd_block_cache_load(block_address)]);
+}
+
+
+/*!
+* @brief Copy part of a block, reading it from the card only if it is not cached
+* @param[in] tmp_buffer Receives tmp_bytes bytes
+* @param[in] block_address
+* @param[in] tmp_offset First byte of the block copied
+* @param[in] tmp_bytes tmp_offset + tmp_bytes must be at most 512
+* @return NONE
+*/
+void
+sd_block_cache_read(uint8_t *tmp_buffer, uint32_t block_address, uint16_t tmp_offset, uint16_t tmp_bytes)
+{
+   memcpy(tmp_buffer, &block_cache_data[sd_block_cache_load(block_address)][tmp_offset], tmp_bytes);
+}
+
+
+/*!
+* @brief Write a block to the card and keep the cached copy, if there is one, up to date
+* @param[in] tmp_write_buffer 512 bytes
+* @param[in] block_address
+* @return NONE
+*
+* @note Blocks that are not cached are not added, writes alone do not make a block worth a slot
+*/
+void
+sd_block_cache_write(const uint8_t *tmp_write_buffer, uint32_t block_address)
+{
+   uint8_t current_slot = sd_block_cache_find(block_address);
+
+   //Drops the cached copy, the block is held in the slot again below
+   sd_write_block((uint8_t *)tmp_write_buffer, block_address);
+
+   if(SD_BLOCK_CACHE_SLOTS != current_slot)
+   {
+      t_sd_block_cache_entry *p_entry = &block_cache_entries[current_slot];
+
+      memcpy(block_cache_data[current_slot], tmp_write_buffer, SD_BLOCK_CACHE_BLOCK_BYTES);
+      p_entry->block_address = block_address;
+      p_entry->is_valid = 1;
+   }
+}
+
+
+/*!
+* @brief Keep a block in the cache until it is unpinned. A block may be pinned more than once,
+*        it then needs as many unpins
+* @param[in] block_address
+* @return The 512 bytes of the block, valid until it is unpinned. NULL if pinning it would leave
+*         no slot for other blocks, in which case nothing is pinned
+*/
+const uint8_t *
+sd_block_cache_pin(uint32_t block_address)
+{
+   uint8_t pinned_slots = 0;
+   uint8_t current_slot = sd_block_cache_find(block_address);
+
+   for(uint8_t tmp_slot = 0; tmp_slot < SD_BLOCK_CACHE_SLOTS; tmp_slot++)
+   {
+      pinned_slots += (0 != block_cache_entries[tmp_slot].pins);
+   }
+
+   //One slot is always left over, so a read can never find every slot pinned
+   if(((SD_BLOCK_CACHE_SLOTS == current_slot) || (0 == block_cache_entries[current_slot].pins)) &&
+      ((SD_BLOCK_CACHE_SLOTS - 1) <= pinned_slots))
+   {
+      return(NULL);
+   }
+
+   current_slot = sd_block_cache_load(block_address);
+   block_cache_entries[current_slot].pins++;
+
+   return(block_cache_data[current_slot]);
+}
+
+
+/*!
+* @brief Let a pinned block be evicted again
+* @param[in] block_address
+* @return NONE
+*/
+void
+sd_block_cache_unpin(uint32_t block_address)
+{
+   uint8_t current_slot = sd_block_cache_find(block_address);
+
+   if((SD_BLOCK_CACHE_SLOTS != current_slot) && (0 < block_cache_entries[current_slot].pins))
+   {
+      block_cache_entries[current_slot].pins--;
+   }
+}
+
+
+/*!
+* @brief Drop the cached copies of blocks written without the cache. Pinned blocks keep their
+*        slot and are read again on their next use
+* @param[in] block_address First block written
+* @param[in] tmp_blocks Number of blocks
+* @return NONE
+*/
+void
+sd_block_cache_invalidate(uint32_t block_address, uint32_t tmp_blocks)
+{
+   for(uint8_t current_slot = 0; current_slot < SD_BLOCK_CACHE_SLOTS; current_slot++)
+   {
+      t_sd_block_cache_entry *p_entry = &block_cache_entries[current_slot];
+
+      //Unsigned difference, so blocks ahead of the range wrap around and fail the compare
+      if(p_entry->is_valid && ((p_entry->block_address - block_address) < tmp_blocks))
+      {
+         p_entry->is_valid = 0;
+         block_cache_invalidations++;
+      }
+   }
+}
+
+
+/*!
+* @brief Drop every cached block, for when the card may have been swapped
+* @param[in] NONE
+* @return NONE
+*/
+void
+sd_block_cache_invalidate_all(void)
+{
+   sd_block_cache_invalidate(0, 0xFFFFFFFF);
+}
+
+
+/*!
+* @brief Copy the cache counters
+* @param[in] tmp_stats Receives the counters since power up
+* @return NONE
+*/
+void
+sd_block_cache_get_stats(t_sd_block_cache_stats *tmp_stats)
+{
+   uint16_t blocks = 0;
+   uint16_t pinned = 0;
+
+   for(uint8_t current_slot = 0; current_slot < SD_BLOCK_CACHE_SLOTS; current_slot++)
+   {
+      blocks += block_cache_entries[current_slot].is_valid;
+      pinned += (0 != block_cache_entries[current_slot].pins);
+   }
+
+   tmp_stats->hits = block_cache_hits;
+   tmp_stats->misses = block_cache_misses;
+   tmp_stats->evictions = block_cache_evictions;
+   tmp_stats->invalidations = block_cache_invalidations;
+   tmp_stats->blocks = blocks;
+   tmp_stats->pinned = pinned;
+   tmp_stats->bytes = sizeof(block_cache_data);
+}
+
+
+
+
+/*
+****************************************************
+********** Private Function Definitions ************
+****************************************************
+*/
+
+/*!
+* @brief Find the slot given to a block, whether its data is valid or not
+* @param[in] block_address
+* @return Slot number, SD_BLOCK_CACHE_SLOTS if the block has none
+*/
+uint8_t
+sd_block_cache_find(uint32_t block_address)
+{
+   for(uint8_t current_slot = 0; current_slot < SD_BLOCK_CACHE_SLOTS; current_slot++)
+   {
+      t_sd_block_cache_entry *p_entry = &block_cache_entries[current_slot];
+
+      if((block_address == p_entry->block_address) && (p_entry->is_valid || (0 != p_entry->pins)))
+      {
+         return(current_slot);
+      }
+   }
+
+   return(SD_BLOCK_CACHE_SLOTS);
+}
+
+
+/*!
+* @brief Make sure a block is cached, reading it into the slot used longest ago if it is not
+* @param[in] block_address
+* @return Slot holding the block
+*/
+uint8_t
+sd_block_cache_load(uint32_t block_address)
+{
+   uint8_t current_slot = sd_block_cache_find(block_address);
+
+   block_cache_clock++;
+
+   if((SD_BLOCK_CACHE_SLOTS != current_slot) && block_cache_entries[current_slot].is_valid)
+   {
+      block_cache_entries[current_slot].last_use = block_cache_clock;
+      block_cache_hits++;
+
+      return(current_slot);
+   }
+
+   //Not cached, and not a pinned slot waiting to be read again
+   if(SD_BLOCK_CACHE_SLOTS == current_slot)
+   {
+      uint32_t oldest_use = 0xFFFFFFFF;
+
+      for(uint8_t tmp_slot = 0; tmp_slot < SD_BLOCK_CACHE_SLOTS; tmp_slot++)
+      {
+         t_sd_block_cache_entry *p_entry = &block_cache_entries[tmp_slot];
+
+         //Free slots count as the oldest of all
+         if((0 == p_entry->pins) && (!p_entry->is_valid || (p_entry->last_use < oldest_use)))
+         {
+            oldest_use = p_entry->is_valid ? p_entry->last_use : 0;
+            current_slot = tmp_slot;
+
+            if(!p_entry->is_valid)
+            {
+               break;
+            }
+         }
+      }
+
+      block_cache_evictions += block_cache_entries[current_slot].is_valid;
+   }
+
+   t_sd_block_cache_entry *p_entry = &block_cache_entries[current_slot];
+
+   block_cache_misses++;
+   sd_read_block(block_cache_data[current_slot], block_address);
+   p_entry->block_address = block_address;
+   p_entry->last_use = block_cache_clock;
+   p_entry->is_valid = 1;
+
+   return(current_slot);
+}
+
+/* end of file */
@@ -136,6 +136,92 @@ spi_receive_byte(uint8_t dummy_byte)
    return((uint8_t)(SPI2->DR));
 }
 
+
+/*!
+* @brief Starts receiving a run of bytes from SPI2 MISO by DMA. DMA1 stream 4 clocks out
+*        0xFF dummy bytes and DMA1 stream 3 stores what comes back, so the CPU is free
+*        until spi_dma_receive_wait() is called.
+* @param[in] tmp_buffer Destination, must hold tmp_bytes
+* @param[in] tmp_bytes
+* @return  NONE
+* @note CS line must be managed outside of this function
+*/
+void
+spi_dma_receive_start(uint8_t *tmp_buffer, uint16_t tmp_bytes)
+{
+   static const uint8_t dummy_byte = 0xFF;
+
+   //Enable main DMA clock
+   RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+
+   //Wait until the SPI bus is not in use. A byte already in DR is the first one of the run: the
+   //token poll before this returns each byte one call late after spi_send_byte() left RXNE set
+   while(SPI2->SR & SPI_SR_BSY);
+
+   //Clear every stream 3 and stream 4 flag
+   DMA1->LIFCR = SPI_DMA_RX_FLAGS;
+   DMA1->HIFCR = SPI_DMA_TX_FLAGS;
+
+   //Stream 3 channel 0 is SPI2_RX: peripheral to memory, increment memory, 8-bit
+   DMA1_Stream3->CR = 0;
+   DMA1_Stream3->PAR = (uint32_t)(uintptr_t)&(SPI2->DR);
+   DMA1_Stream3->M0AR = (uint32_t)(uintptr_t)tmp_buffer;
+   DMA1_Stream3->NDTR = tmp_bytes;
+   DMA1_Stream3->CR = (DMA_SxCR_MINC | DMA_SxCR_EN);
+
+   //Stream 4 channel 0 is SPI2_TX: memory to peripheral, same dummy byte every time
+   DMA1_Stream4->CR = 0;
+   DMA1_Stream4->PAR = (uint32_t)(uintptr_t)&(SPI2->DR);
+   DMA1_Stream4->M0AR = (uint32_t)(uintptr_t)&dummy_byte;
+   DMA1_Stream4->NDTR = tmp_bytes;
+   DMA1_Stream4->CR = (DMA_SxCR_DIR_0 | DMA_SxCR_EN);
+
+   //RX must be ready before the first byte is clocked out
+   SPI2->CR2 |= SPI_CR2_RXDMAEN;
+   SPI2->CR2 |= SPI_CR2_TXDMAEN;
+}
+
+
+/*!
+* @brief Waits for spi_dma_receive_start() to finish and hands SPI2 back to the CPU
+* @param[in] NONE
+* @return  NONE
+*/
+void
+spi_dma_receive_wait(void)
+{
+   //The receive stream finishes last
+   while(!(DMA1->LISR & DMA_LISR_TCIF3)) {}
+
+   SPI2->CR2 &= ~(SPI_CR2_TXDMAEN | SPI_CR2_RXDMAEN);
+
+   //Drop a byte still coming in after the stream
+   spi_receive_flush();
+
+   DMA1->LIFCR = SPI_DMA_RX_FLAGS;
+   DMA1->HIFCR = SPI_DMA_TX_FLAGS;
+}
+
+
+/*!
+* @brief Waits for the byte being sent and drops what it clocked in
+* @param[in] NONE
+* @return  NONE
+* @note spi_send_byte() leaves the byte received in DR. Left there, it puts spi_receive_byte()
+*       one byte behind the card, and an interrupt between two of its calls then overruns the next one
+*/
+void
+spi_receive_flush(void)
+{
+   while(SPI2->SR & SPI_SR_BSY);
+
+   if(SPI2->SR & SPI_SR_RXNE)
+   {
+      uint8_t leftover_byte = SPI2->DR;
+      (void)leftover_byte;
+   }
+}
+
 /*
 ****************************************************
 ********** Private Function Definitions ************
@@ -164,6 +164,8 @@ static uint32_t current_audio = null_address;
 static e_audio_state current_audio_state = audio_idle_state;
 static e_audio_event current_audio_event = audio_no_event;
 static uint8_t current_slide_number = 0;
+static t_gui_animation boot_animation = {0};
+static t_gui_animation shutdown_animation = {0};
 
 static t_button main_home_buttons[9] =
 {
@@ -178,6 +180,18 @@ static t_button main_home_buttons[9] =
       {.width = 75, .height = 75,  .x_position = 220, .y_position = 252}//intro
 };
 
+//Footer user buttons, areas and draw functions are filled in on the first footer update
+static t_gui_widget footer_widgets[3] = {0};
+static uint8_t footer_active_button = NO_BUTTON_PRESS;
+
+static t_gui_panel footer_panel =
+{
+   .area = {.x_initial = 0, .y_initial = FOOTER_OFFSET, .x_final = LCD_WIDTH, .y_final = LCD_HEIGHT},
+   .get_background_color = gui_get_footer_color,
+   .widgets = footer_widgets,
+   .widget_count = (sizeof(footer_widgets) / sizeof(*footer_widgets))
+};
+
 
 /*
 ****************************************************
@@ -240,6 +254,9 @@ void states_settings_menu(void);
 void states_settings_main_button_handler(void);
 void states_settings_time_button_handler(void);
 void states_previous_context(uint8_t action_select);
+void states_popup_save_under(void);
+uint8_t states_popup_uses_save_under(e_state_main tmp_state);
+uint16_t states_popup_save_under_bytes(e_state_main tmp_state);
 
 void states_semi_sleep(void);
 void states_sleep(void);
@@ -247,6 +264,8 @@ void states_mcu_to_deepsleep(void);
 uint8_t states_read_startup_flag(void);
 void states_write_startup_flag(uint8_t startup_flag_status);
 void states_menu3_general_button_handler(uint32_t tmp_total_slides);
+void states_footer_init(void);
+void states_draw_footer_button(const t_gui_widget *tmp_widget, uint16_t background_color);
 
 
 /************Audio State Machine Functions*********/
@@ -389,10 +408,10 @@ states_update_main_state(void)
       {states_semi_sleep,        states_semi_sleep,          states_semi_sleep,      states_semi_sleep,      states_semi_sleep,     states_semi_sleep,
        states_semi_sleep,        states_semi_sleep,          states_semi_sleep,      states_semi_sleep,      states_semi_sleep,     states_semi_sleep,
        states_semi_sleep,        states_semi_sleep,          states_semi_sleep,      states_semi_sleep,      states_semi_sleep,     states_sleep,  },
-      //Sleep
+      //Sleep, nothing leaves it while the shutdown animation plays
       {states_sleep,             states_sleep,               states_sleep,           states_sleep,           states_sleep,          states_sleep,
        states_sleep,             states_sleep,               states_sleep,           states_sleep,           states_sleep,          states_sleep,
-       states_sleep,             states_sleep,               states_app_home,        states_sleep,           states_sleep,          states_sleep,  },
+       states_sleep,             states_sleep,               states_sleep,           states_sleep,           states_sleep,          states_sleep,  },
    };
 
 
@@ -412,10 +431,25 @@ states_update_main_state(void)
 
    e_state_main tmp_current_state = states_get_main_state();
 
+   //A popup closing puts back the pixels it covered, so the menu under it has nothing to redraw
+   if((restore_context_call == tmp_current_event) && states_popup_uses_save_under(tmp_current_state) && lcd_restore_under())
+   {
+      tmp_current_event = no_main_event;
+      states_set_main_event(no_main_event);
+   }
+
    //Bounds check on table indices
    if((tmp_current_state < max_main_state) && (tmp_current_event < max_main_event))
    {
-      main_state_table[tmp_current_state][tmp_current_event]();
+      void (*p_state_function)(void) = main_state_table[tmp_current_state][tmp_current_event];
+
+      //Only the skills list scrolls the LCD. Whatever is drawn next expects an unscrolled screen
+      if((skills_state == tmp_current_state) && (states_app_skills != p_state_function))
+      {
+         lcd_scroll_reset();
+      }
+
+      p_state_function();
    }
 
    //Reset event, so the same event does not trigger a transition more than once
@@ -424,50 +458,36 @@ states_update_main_state(void)
 
 
 /*!
-* @brief Redraw the footer in order to match the current menu
+* @brief Queue a redraw of the footer in order to match the current menu. The drawing itself
+*        happens in gui_compositor_flush()
 * @param[in] NONE
 * @return  NONE
+*
+* @note Menus are drawn over the footer on every state change, so the whole footer is
+*       invalidated rather than only the buttons that changed color
 */
 void
 states_update_footer(void)
 {
+   static uint8_t first_entry_flag = 1;
    static e_state_main previous_main_state = home_screen;
    static e_substate previous_substate = substate0;
    static uint16_t previous_footer_color = 0;
 
-   uint16_t current_footer_color = gui_get_footer_color();
+   if(first_entry_flag)
+   {
+      states_footer_init();
+      first_entry_flag = 0;
+   }
 
    //Check to see if the footer color has changed or there was a state change and the footer needs to be updated
    if((states_get_main_state() != previous_main_state) ||
       (states_get_substate() != previous_substate) ||
       (gui_get_footer_color() != previous_footer_color))
    {
-      lcd_draw_rectangle(current_footer_color, 0, FOOTER_OFFSET, 320, 480);
-      uint8_t length = (sizeof(user_button_template) / sizeof(*user_button_template)); //This should always be 3 for user buttons
-      uint8_t active_button = NO_BUTTON_PRESS;
-      active_button = buttons_status(user_button_template,length);
-
-      //If the current button is active, draw it with a darker color
-      for(uint8_t current_button = 0; current_button < length; current_button++)
-      {
-         uint16_t button_color = THEME_NEAR_WHITE;
-
-         if(current_button == active_button)
-         {
-            button_color = GRAY_MEDIUM;
-         }
-
-         else
-         {
-            button_color = THEME_NEAR_WHITE;
-         }
-
-         uint16_t x = user_button_template[current_button].x_position;
-         uint16_t y = user_button_template[current_button].y_position;
-         const uint8_t *p_bmp = user_button_template[current_button].bmp;
-
-         lcd_send_bitmap(p_bmp, x, y, button_color, gui_get_footer_color());
-      }
+      //If a button is active when the footer is redrawn, it is drawn with a darker color
+      footer_active_button = buttons_status(user_button_template, footer_panel.widget_count);
+      gui_compositor_invalidate_panel(&footer_panel);
    }
 
    previous_substate = states_get_substate();
@@ -596,20 +616,34 @@ states_set_current_audio(uint32_t audio_address)
 * @param[in] NONE
 * @return NONE
 *
+* @note Called on every pass of the main loop until the animation ends. The main loop draws
+*       the frames, so touch, audio and the power button are serviced in the meantime
 */
 void
 states_system_init(void)
 {
-   uint32_t animation_frames[13] =
-    {
-          address_buffer[startup_animation_0], address_buffer[startup_animation_1], address_buffer[startup_animation_2],
-          address_buffer[startup_animation_3], address_buffer[startup_animation_4], address_buffer[startup_animation_5],
-          address_buffer[startup_animation_6], address_buffer[startup_animation_7], address_buffer[startup_animation_8],
-          address_buffer[startup_animation_9], address_buffer[startup_animation_10], address_buffer[startup_animation_11],
-          address_buffer[startup_animation_12]
-    };
+   static uint8_t first_entry_flag = 1;
+
+   if(first_entry_flag)
+   {
+      uint32_t animation_frames[13] =
+       {
+             address_buffer[startup_animation_0], address_buffer[startup_animation_1], address_buffer[startup_animation_2],
+             address_buffer[startup_animation_3], address_buffer[startup_animation_4], address_buffer[startup_animation_5],
+             address_buffer[startup_animation_6], address_buffer[startup_animation_7], address_buffer[startup_animation_8],
+             address_buffer[startup_animation_9], address_buffer[startup_animation_10], address_buffer[startup_animation_11],
+             address_buffer[startup_animation_12]
+       };
+
+      gui_boot_animation(&boot_animation, animation_frames, (sizeof(animation_frames)) / (sizeof(*animation_frames)),
+                         address_buffer[startup_animation_delta]);
+      first_entry_flag = 0;
+   }
 
-   gui_boot_animation(animation_frames, (sizeof(animation_frames)) / (sizeof(*animation_frames)));
+   if(gui_animation_is_running(&boot_animation))
+   {
+      return;
+   }
 
    //Display the home menu as a backdrop to the intro popup menu in case the system opens intro first
    gui_set_status_bar_color(GRAY_DARK);
@@ -640,7 +674,7 @@ states_main_event_homescreen(void)
       //If a user has clicked on an app in the homescreen, set the main event to that app call
       if(TOTAL_APPS > pressed_button)
       {
-         e_app_number app_event_table[TOTAL_APPS] =  //There are 9 total apps on the homescreen
+         e_event_main app_event_table[TOTAL_APPS] =  //There are 9 total apps on the homescreen
          {references_call, portfolio_call, skills_call, contact_call, about_me_call,
           device_story_call, language_call, why_company_call, intro_call
          };
@@ -810,6 +844,7 @@ states_main_event_main_power_button(void)
          //If the system is in a popup window (ie settings or battery handler) pop the context
          //before going to semi sleep, or context will not be correctly restored when exiting semi sleep.
          states_previous_context(CONTEXT_POP);
+         //Fall through
 
       default:
          //Any state other than sleep or semi-sleep
@@ -846,10 +881,20 @@ states_app_home(void)
 
    e_state_main tmp_main_state = states_get_main_state();
 
-   if((tmp_main_state != home_screen)  ||  (restore_context_call == states_get_main_event()))
+   //Popups are only ever opened over the homescreen from here or from system init, which draws it
+   //as the backdrop. Closing one only has to put back what the popup covered
+   if((intro_state == tmp_main_state) || ((home_screen == tmp_main_state) && (restore_context_call == states_get_main_event())))
+   {
+      gui_set_status_bar_color(GRAY_DARK);
+      lcd_image_region_from_sd(10, MENU_WARNING_BACKGROUND_OFFSET, 310, MENU_WARNING_BACKGROUND_HEIGHT,
+                               0, SB_OFFSET, address_buffer[homescreen_bmp]);
+   }
+
+   else if(tmp_main_state != home_screen)
    {
       gui_set_status_bar_color(GRAY_DARK);
       lcd_image_from_sd(0, SB_OFFSET, 320, FOOTER_OFFSET+1, address_buffer[homescreen_bmp]);
+      lcd_discard_under(); //A popup left with the home button, what it saved is covered now
    }
 
    states_set_main_state(home_screen);
@@ -1217,26 +1262,54 @@ states_app_skills(void)
 {
    if(skills_state != states_get_main_state() || (restore_context_call == states_get_main_event()))
    {
-
-      const t_light_button menu_skills_template[7] =
+      //Static since the menu keeps the list to scroll it
+      static t_light_button menu_skills_template[7] =
        {
-             {.major_text = "Arm Microcontrollers\0",  .minor_text = "Cortex M,STM32\0", .image[0] = address_buffer[skills_arm]},    //Arm
+             {.major_text = "Arm Microcontrollers\0",  .minor_text = "Cortex M,STM32\0"},    //Arm
 
-             {.major_text = "Circuit Design\0", .minor_text = "Analog,Digital\0", .image[0] = address_buffer[skills_circuit] },      //Circuit Design
+             {.major_text = "Circuit Design\0", .minor_text = "Analog,Digital\0"},           //Circuit Design
 
-             {.major_text = "Embedded C\0", .minor_text = "Keil,Eclipse IDEs\0", .image[0] = address_buffer[skills_c]},              //Embedded C
+             {.major_text = "Embedded C\0", .minor_text = "Keil,Eclipse IDEs\0"},            //Embedded C
 
-             {.major_text = "Lab Equipment\0", .minor_text = "Oscope,DMM,DLA etc.\0", .image[0] = address_buffer[skills_equipment]}, //Equipment                                    //Equipment
+             {.major_text = "Lab Equipment\0", .minor_text = "Oscope,DMM,DLA etc.\0"},       //Equipment
 
-             {.major_text = "PCB Design\0", .minor_text = "DFM,high speed\0", .image[0] = address_buffer[skills_pcb]},               //PCB Design
+             {.major_text = "PCB Design\0", .minor_text = "DFM,high speed\0"},               //PCB Design
 
-             {.major_text = "SMD/THT Soldering\0", .minor_text = "Rework,fine-pitch\0", .image[0] = address_buffer[skills_solder]},   //Solder
+             {.major_text = "SMD/THT Soldering\0", .minor_text = "Rework,fine-pitch\0"},     //Solder
 
-             {.major_text = "Version Control\0", .minor_text = "Git/GitHub\0", .image[0] = address_buffer[github_logo]},           //Github
+             {.major_text = "Version Control\0", .minor_text = "Git/GitHub\0"},              //Github
        };
 
-         gui_create_menu_skills(menu_skills_template, (sizeof(menu_skills_template) / sizeof(*menu_skills_template)));
-         states_set_main_state(skills_state);
+      //Image addresses are only known once the SD card has been searched
+      const e_sd_address menu_skills_images[7] =
+      {
+            skills_arm, skills_circuit, skills_c, skills_equipment, skills_pcb, skills_solder, github_logo
+      };
+
+      for(uint8_t current_skill = 0; current_skill < 7; current_skill++)
+      {
+         menu_skills_template[current_skill].image[0] = address_buffer[menu_skills_images[current_skill]];
+      }
+
+      gui_create_menu_skills(menu_skills_template, (sizeof(menu_skills_template) / sizeof(*menu_skills_template)));
+      states_set_main_state(skills_state);
+   }
+
+   else
+   {
+      //Tapping near the bottom of the list shows the next row, near the top the previous one
+      uint16_t touch_position[2] = {0};
+      touch_get_position(touch_position);
+
+      if(((FOOTER_OFFSET - MENU_SKILLS_SCROLL_ZONE_HEIGHT) <= touch_position[1]) && (FOOTER_OFFSET > touch_position[1]))
+      {
+         gui_scroll_menu_skills(1);
+      }
+
+      else if((HEADER_OFFSET <= touch_position[1]) && ((HEADER_OFFSET + MENU_SKILLS_SCROLL_ZONE_HEIGHT) > touch_position[1]))
+      {
+         gui_scroll_menu_skills(-1);
+      }
    }
 }
 
@@ -1939,6 +2012,7 @@ states_battery_handler(void)
 
    if(battery_handler_state != states_get_main_state())
    {
+       states_popup_save_under();
        gui_create_warning_menu(button_list, menu_text);
        states_set_current_audio_event(audio_end_of_clip_event);
        states_previous_context(CONTEXT_PUSH);
@@ -1961,6 +2035,7 @@ states_settings_menu(void)
    if(settings_state != states_get_main_state())
    {
       //Create the pop-up settings menu and save/end the system context for reentrancy
+      states_popup_save_under();
       gui_create_settings_menu();
       states_set_current_audio_event(audio_end_of_clip_event);
       states_previous_context(CONTEXT_PUSH);
@@ -2217,13 +2292,16 @@ states_sleep(void)
       lcd_draw_rectangle(BLACK, 0, SB_OFFSET, 320, FOOTER_OFFSET);
       lcd_print_string("Shutting Down",75,200,WHITE_PURE, BLACK);
       lcd_backlight_enable(); //Turn the screen on in case the system is in semi sleep
-      gui_loading_circle_animation(150, 300);
+      gui_loading_circle_animation(&shutdown_animation, 150, 300);
+      states_set_main_state(sleep_state);
+   }
 
+   //The sleep state keeps calling this, power down once the loading circle has finished
+   else if(!gui_animation_is_running(&shutdown_animation))
+   {
       lcd_backlight_disable(); //Shut off the lcd
       states_set_current_audio_event(audio_end_of_clip_event); //Cut off any audio that may be playing
       dac_disable_audio(); //Put external audio amplifier IC to sleep
-
-      states_set_main_state(sleep_state);
       states_mcu_to_deepsleep(); //Put the processor to sleep
    }
 
@@ -2639,6 +2717,80 @@ states_previous_context(uint8_t action_select)
 
 
 
+/*!
+* @brief Keep what a popup is about to cover, so closing it does not redraw the menu under it
+* @param[in] NONE
+* @return NONE
+*/
+void
+states_popup_save_under(void)
+{
+   if(states_popup_uses_save_under(states_get_main_state()))
+   {
+      lcd_save_under(10, MENU_WARNING_BACKGROUND_OFFSET, 310, MENU_WARNING_BACKGROUND_HEIGHT,
+                     states_popup_save_under_bytes(states_get_main_state()));
+   }
+
+   else
+   {
+      lcd_discard_under();
+   }
+}
+
+
+/*!
+* @brief Check if a popup opened in a state saves the pixels under it, and closing it puts them back
+* @param[in] tmp_state
+* @return 1 if it does
+*
+* @note Only menus whose popup area fits in LCD_SAVE_UNDER_BYTES save it, reading back one that
+*       does not is wasted on top of the redraw
+*/
+uint8_t
+states_popup_uses_save_under(e_state_main tmp_state)
+{
+   uint16_t tmp_bytes = states_popup_save_under_bytes(tmp_state);
+
+   return((0 != tmp_bytes) && (LCD_SAVE_UNDER_BYTES >= tmp_bytes));
+}
+
+
+/*!
+* @brief Bytes lcd_save_under() takes for the area a popup covers in a state
+* @param[in] tmp_state
+* @return Encoded size, 0 for states that always redraw
+*
+* @note Sizes are of the art each main menu shows there, as encoded in the simulator. Only menus
+*       drawn from the SD card are listed. Portfolio and This Device fit, but they are drawn from
+*       flash in under 20 ms and reading their area back takes about 100 ms.
+*       Slides restart their clip and clock on a restore and the skills list has its scroll reset
+*       under the popup, so those still go through their own restore. The homescreen puts back the
+*       popup area from the SD card, which is quicker than reading it back from the LCD. A popup
+*       opened over another popup saves nothing, the first one redraws itself when the second closes
+*/
+uint16_t
+states_popup_save_under_bytes(e_state_main tmp_state)
+{
+   switch(tmp_state)
+   {
+   case references_state:
+      return(STATES_UNDER_REFERENCES_BYTES);
+
+   case contact_state:
+      return(STATES_UNDER_CONTACT_BYTES);
+
+   case about_me_state:
+      return(STATES_UNDER_ABOUT_ME_BYTES);
+
+   case language_state:
+      return((substate0 == states_get_substate()) ? STATES_UNDER_LANGUAGE_BYTES : 0);
+
+   default:
+      return(0);
+   }
+}
+
+
 /*!
 * @brief Puts the MCU into a deep sleep (standby mode) to reduce power consumption
 * @param[in] NONE
@@ -2672,18 +2824,14 @@ states_mcu_to_deepsleep(void)
 /*!
 * @brief Reads a flag from the SD card indicating whether to display the introduction popup at startup
 * @param[in] NONE
-* @return  tmp_buffer[0] This is the first byte of the SD card block and indicates the flag's status
+* @return  The first byte of the SD card block, which indicates the flag's status
 *
-* @note This function is slow and puts a large array on the stack. These aren't a concern for this
-*       system, but should not be used where latency or RAM usage is a problem.
+* @note The block is read through the SD block cache, so only the first call goes to the card
 */
 uint8_t
 states_read_startup_flag(void)
 {
-   uint8_t tmp_buffer[512] = {0};
-   sd_read_block(tmp_buffer, STATES_ADDRESS_STARTUP_FLAG);
-
-   return(tmp_buffer[0]);
+   return(sd_block_cache_get(STATES_ADDRESS_STARTUP_FLAG)[0]);
 }
 
 
@@ -2702,12 +2850,61 @@ states_write_startup_flag(uint8_t startup_flag_status)
    if(STATES_STARTUP_FLAG_SET >= startup_flag_status)
    {
       uint8_t tmp_buffer[512] = {startup_flag_status};
-      sd_write_block(tmp_buffer, STATES_ADDRESS_STARTUP_FLAG);
+      sd_block_cache_write(tmp_buffer, STATES_ADDRESS_STARTUP_FLAG);
+   }
+
+}
+
+
+
+/*!
+* @brief Give each footer widget the area of its user button and register the footer with the compositor
+* @param[in] NONE
+* @return  NONE
+*/
+void
+states_footer_init(void)
+{
+   for(uint8_t current_button = 0; current_button < footer_panel.widget_count; current_button++)
+   {
+      uint16_t bitmap_dimensions[2] = {0};
+      t_gui_widget *p_widget = &footer_widgets[current_button];
+
+      lcd_parse_local_bitmap(user_button_template[current_button].bmp, bitmap_dimensions);
+
+      p_widget->area.x_initial = user_button_template[current_button].x_position;
+      p_widget->area.y_initial = user_button_template[current_button].y_position;
+      p_widget->area.x_final = p_widget->area.x_initial + bitmap_dimensions[0];
+      p_widget->area.y_final = p_widget->area.y_initial + bitmap_dimensions[1];
+      p_widget->get_state = NULL; //Only redrawn with the rest of the footer
+      p_widget->draw = states_draw_footer_button;
+      p_widget->id = current_button;
    }
 
+   gui_compositor_add_panel(&footer_panel);
 }
 
 
+/*!
+* @brief Draw one of the user buttons in the footer
+* @param[in] tmp_widget
+* @param[in] background_color
+* @return  NONE
+*/
+void
+states_draw_footer_button(const t_gui_widget *tmp_widget, uint16_t background_color)
+{
+   uint16_t button_color = THEME_NEAR_WHITE;
+
+   if(tmp_widget->id == footer_active_button)
+   {
+      button_color = GRAY_MEDIUM;
+   }
+
+   lcd_send_bitmap(user_button_template[tmp_widget->id].bmp, tmp_widget->area.x_initial, tmp_widget->area.y_initial,
+                   button_color, background_color);
+}
+
 
 #pragma GCC pop_options
 
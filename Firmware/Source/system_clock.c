@@ -233,7 +233,7 @@ apb_prescaler_init(void)
 
 
 /*!
-* @brief Set system tick to 1ms
+* @brief Set system tick to 1ms. Its interrupt keeps the millisecond count in timers.c
 * @param[in] NONE
 * @return NONE
 * @warning This assumes SYSTEMCLOCK_FREQUENCY is 100MHz
@@ -244,7 +244,7 @@ system_tick_init(uint32_t num_ticks)
    uint32_t temp_load_val = ((SYSTEM_CLOCK_FREQUENCY / num_ticks) - 1UL);
    SysTick->LOAD = temp_load_val;
    SysTick->VAL = 0UL;
-   SysTick->CTRL  = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;     
+   SysTick->CTRL  = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk;
    
 }
 
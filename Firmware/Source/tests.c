@@ -334,7 +334,7 @@ tests_production_touch_single_result(uint8_t target_number)
    uart1_printf("\n\r  Target");
 
    //Convert the target number to a string that "uart1_printf()" will accept
-   char target_as_string[3] = {" 0\0"};
+   char target_as_string[3] = {" 0"};
    target_as_string[1] += target_number;
 
    //Send the target number
@@ -31,6 +31,7 @@
 /* File-Static Variables */
 static uint8_t timer11_interrupt_flag = 0;
 static uint16_t current_audio_clock = 0; //Seconds counter used to keep track the elapsed time an audio has been playing
+static volatile uint32_t system_milliseconds = 0; //SysTick interrupts since system_clock_init()
 
 /*
 ****************************************************
@@ -183,7 +184,7 @@ timers_uint16_to_time(uint16_t tmp_counter_value, char *converted_time)
       '0', '1', '2', '3', '4', '5', '6', '7', '8', '9'
    };
 
-   static const char seconds_lookup_table[60][2] =
+   static const char seconds_lookup_table[60][3] =
    {
       "00", "01", "02", "03", "04", "05", "06", "07", "08", "09",
       "10", "11", "12", "13", "14", "15", "16", "17", "18", "19",
@@ -259,6 +260,43 @@ timers_timer11_output_disable(void)
 }
 
 
+/*!
+* @brief Read the time since startup
+* @param[in] NONE
+* @return  Milliseconds counted by SysTick. Wraps after about 49 days
+*/
+uint32_t
+timers_get_ms(void)
+{
+   return(system_milliseconds);
+}
+
+
+/*!
+* @brief Read the time since startup with the SysTick counter added in
+* @param[in] NONE
+* @return  Microseconds. Wraps after about 71 minutes, so only compare differences
+*/
+uint32_t
+timers_get_us(void)
+{
+   uint32_t tmp_milliseconds = 0;
+   uint32_t tmp_count = 0;
+
+   //Read again if the tick interrupt ran in between, the count has started over
+   do
+   {
+      tmp_milliseconds = system_milliseconds;
+      tmp_count = SysTick->VAL;
+   }
+   while(tmp_milliseconds != system_milliseconds);
+
+   uint32_t tmp_period = SysTick->LOAD + 1;
+
+   return((tmp_milliseconds * 1000) + (((tmp_period - 1 - tmp_count) * 1000) / tmp_period));
+}
+
+
 /*!
 * @brief Bad delay that locks the processor
 * @param[in] NONE
@@ -363,5 +401,17 @@ TIM1_TRG_COM_TIM11_IRQHandler(void)
 }
 
 
+/*!
+* @brief SysTick interrupt handler, once per millisecond
+* @param[in] NONE
+* @return  NONE
+*/
+void
+SysTick_Handler(void)
+{
+   system_milliseconds++;
+}
+
+
 
 /* end of file */
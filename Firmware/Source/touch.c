@@ -144,8 +144,8 @@ touch_read_x_position(void)
    gpio_gen_output_init(TOUCH_X_PLUS);
    gpio_gen_output_init(TOUCH_X_MINUS);
    gpio_gen_input_init(TOUCH_Y_MINUS); //high z
-   gpio_set(TOUCH_X_PLUS); //X+ = 3.3v
-   gpio_clear(TOUCH_X_MINUS); //X- = 0v
+   gpio_pin_set(TOUCH_X_PLUS); //X+ = 3.3v
+   gpio_pin_clear(TOUCH_X_MINUS); //X- = 0v
   
    //Enable ADC after settings change
    adc_enable();
@@ -196,8 +196,8 @@ touch_read_y_position(void)
    gpio_gen_output_init(TOUCH_Y_PLUS);
    gpio_gen_output_init(TOUCH_Y_MINUS);
    gpio_gen_input_init(TOUCH_X_MINUS); //high z
-   gpio_set(TOUCH_Y_PLUS); //X+ = 3.3v
-   gpio_clear(TOUCH_Y_MINUS); //X- = 0v
+   gpio_pin_set(TOUCH_Y_PLUS); //X+ = 3.3v
+   gpio_pin_clear(TOUCH_Y_MINUS); //X- = 0v
    
    //Enable ADC after settings change
    adc_enable();
@@ -306,8 +306,8 @@ touch_idle_state(void)
 	EXTI -> IMR |= EXTI_IMR_IM1; //Unmask interrupt pin 1
 
    //Set pins to logic state
-   gpio_clear(TOUCH_Y_MINUS);
-   gpio_set(TOUCH_X_MINUS);
+   gpio_pin_clear(TOUCH_Y_MINUS);
+   gpio_pin_set(TOUCH_X_MINUS);
 }
 
 
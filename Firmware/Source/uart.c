@@ -87,7 +87,7 @@ void uart1_init(uint32_t baud_rate)
 * @return NONE
 */
 void
-uart1_printf(char print_statement[])
+uart1_printf(const char print_statement[])
 {
    //Send message one char at a time
    for(uint8_t current_char = 0; current_char < strlen(print_statement); current_char++)